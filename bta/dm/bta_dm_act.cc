@@ -1021,6 +1021,9 @@ void bta_dm_remove_device(tBTA_DM_MSG* p_data) {
 
   RawAddress other_address = p_dev->bd_addr;
   RawAddress peer_id_addr = p_dev->bd_addr;
+
+  /* the bond is gone, so are the services found on the peer */
+  bta_dm_sdp_cache_remove(p_dev->bd_addr);
 #ifdef ADV_AUDIO_FEATURE
   RawAddress map_addr = btif_get_map_address(p_dev->bd_addr);
 #endif
@@ -1225,6 +1228,8 @@ void bta_dm_close_acl(tBTA_DM_MSG* p_data) {
     BTA_GATTC_CancelOpen(0, p_remove_acl->bd_addr, false);
     /* remove all cached GATT information */
     BTA_GATTC_Refresh(p_remove_acl->bd_addr);
+    /* remove the cached SDP results */
+    bta_dm_sdp_cache_remove(p_remove_acl->bd_addr);
   }
   /* otherwise, no action needed */
 }
@@ -2029,6 +2034,95 @@ void bta_dm_store_di_info(tSDP_DISC_REC* sdp_rec, uint16_t vendor_id,
    btif_config_save();
 }
 
+/* FNV-1a, keys only need to change when the peer does */
+static uint32_t bta_dm_sdp_hash(uint32_t hash, const void* data, size_t len) {
+  const uint8_t* p = (const uint8_t*)data;
+  if (hash == 0) hash = 2166136261u;
+  while (len--) {
+    hash ^= *p++;
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+/*******************************************************************************
+ *
+ * Function         bta_dm_sdp_di_hash
+ *
+ * Description      Hashes the primary DI record of the peer found in the
+ *                  discovery database.
+ *
+ * Returns          the hash, 0 if the peer has no DI record
+ *
+ ******************************************************************************/
+static uint32_t bta_dm_sdp_di_hash(tSDP_DISCOVERY_DB* p_db) {
+  tSDP_DI_GET_RECORD di_rec;
+  uint8_t num_di = SDP_GetNumDiRecords(p_db);
+
+  if (num_di == 0 || SDP_GetDiRecord(1, &di_rec, p_db) != SDP_SUCCESS)
+    return 0;
+
+  uint16_t fields[] = {num_di,
+                       di_rec.spec_id,
+                       di_rec.rec.vendor,
+                       di_rec.rec.vendor_id_source,
+                       di_rec.rec.product,
+                       di_rec.rec.version};
+  uint32_t hash = bta_dm_sdp_hash(0, fields, sizeof(fields));
+  return hash ? hash : 1;
+}
+
+/*******************************************************************************
+ *
+ * Function         bta_dm_sdp_eir_hash
+ *
+ * Description      Hashes the service UUIDs the peer has put in its EIR, if it
+ *                  is in the inquiry database.
+ *
+ * Returns          the hash, 0 if no EIR service UUID is known
+ *
+ ******************************************************************************/
+static uint32_t bta_dm_sdp_eir_hash(const RawAddress& bd_addr) {
+  tBTM_INQ_INFO* p_inq_info = BTM_InqDbRead(bd_addr);
+  if (p_inq_info == NULL) return 0;
+
+  uint32_t* eir_uuid = p_inq_info->results.eir_uuid;
+  bool has_uuid = false;
+  for (size_t i = 0; i < BTM_EIR_SERVICE_ARRAY_SIZE; i++) {
+    if (eir_uuid[i] != 0) has_uuid = true;
+  }
+  if (!has_uuid) return 0;
+
+  uint32_t hash =
+      bta_dm_sdp_hash(0, eir_uuid, sizeof(p_inq_info->results.eir_uuid));
+  return hash ? hash : 1;
+}
+
+/*******************************************************************************
+ *
+ * Function         bta_dm_sdp_query_services
+ *
+ * Description      Returns the services left to search which a single query
+ *                  for the L2CAP protocol UUID finds, as it matches the
+ *                  records of every BR/EDR service.
+ *
+ * Returns          tBTA_SERVICE_MASK
+ *
+ ******************************************************************************/
+static tBTA_SERVICE_MASK bta_dm_sdp_query_services(void) {
+  tBTA_SERVICE_MASK services = 0;
+
+  /* the DI record may have no protocol descriptor, GATT and user services are
+   * reported on their own */
+  for (int id = BTA_RES_SERVICE_ID + 1; id < BTA_BLE_SERVICE_ID; id++) {
+    uint16_t uuid = bta_service_id_to_uuid_lkup_tbl[id];
+    if (uuid == 0 || uuid == UUID_PROTOCOL_ATT) continue;
+    tBTA_SERVICE_MASK mask = BTA_SERVICE_ID_TO_SERVICE_MASK(id);
+    if (bta_dm_search_cb.services_to_search & mask) services |= mask;
+  }
+  return services;
+}
+
 /*******************************************************************************
  *
  * Function         bta_dm_sdp_result
@@ -2040,6 +2134,7 @@ void bta_dm_store_di_info(tSDP_DISC_REC* sdp_rec, uint16_t vendor_id,
  ******************************************************************************/
 void bta_dm_sdp_result(tBTA_DM_MSG* p_data) {
   tSDP_DISC_REC* p_sdp_rec = NULL;
+  tSDP_DISC_REC* first_rec[BTA_MAX_SERVICE_ID];
   tBTA_DM_MSG* p_msg;
   bool scn_found = false;
   uint16_t service = 0xFFFF;
@@ -2055,96 +2150,118 @@ void bta_dm_sdp_result(tBTA_DM_MSG* p_data) {
       (p_data->sdp_event.sdp_result == SDP_NO_RECS_MATCH) ||
       (p_data->sdp_event.sdp_result == SDP_DB_FULL)) {
     APPL_TRACE_DEBUG("sdp_result::0x%x", p_data->sdp_event.sdp_result);
-    do {
-      p_sdp_rec = NULL;
-      if (bta_dm_search_cb.service_index == (BTA_USER_SERVICE_ID + 1)) {
-        p_sdp_rec = SDP_FindServiceUUIDInDb(bta_dm_search_cb.p_sdp_db,
-                                            bta_dm_search_cb.uuid, p_sdp_rec);
-
-        if (p_sdp_rec && SDP_FindProtocolListElemInRec(
-                             p_sdp_rec, UUID_PROTOCOL_RFCOMM, &pe)) {
-          bta_dm_search_cb.peer_scn = (uint8_t)pe.params[0];
-          scn_found = true;
-        }
-      } else {
-        service =
-            bta_service_id_to_uuid_lkup_tbl[bta_dm_search_cb.service_index - 1];
-        p_sdp_rec =
-            SDP_FindServiceInDb(bta_dm_search_cb.p_sdp_db, service, p_sdp_rec);
-        if (service == UUID_SERVCLASS_PNP_INFORMATION) {
-          APPL_TRACE_DEBUG(" Store DI info to conf file " );
-          if (SDP_GetNumDiRecords(bta_dm_search_cb.p_sdp_db) != 0) {
-            /* always update information with primary DI record */
-            if (SDP_GetDiRecord(1, &di_rec, bta_dm_search_cb.p_sdp_db) == SDP_SUCCESS) {
-               bta_dm_store_di_info(p_sdp_rec, di_rec.rec.vendor, di_rec.rec.product,
-                                  di_rec.rec.version);
+    if (p_data->sdp_event.sdp_result != SDP_SUCCESS)
+      bta_dm_search_cb.sdp_all_success = false;
+    bta_dm_sdp_find_services_in_db(bta_dm_search_cb.p_sdp_db, first_rec);
+
+    if (bta_dm_search_cb.services_in_query) {
+      /* services searched by a single L2CAP query: only the records found
+       * count, even if the database got full */
+      for (int id = 0; id < BTA_MAX_SERVICE_ID; id++) {
+        tBTA_SERVICE_MASK mask = BTA_SERVICE_ID_TO_SERVICE_MASK(id);
+        if (!(bta_dm_search_cb.services_in_query & mask) || !first_rec[id])
+          continue;
+        bta_dm_search_cb.services_found |= mask;
+        uuid_list.push_back(
+            Uuid::From16Bit(bta_service_id_to_uuid_lkup_tbl[id]));
+      }
+      bta_dm_search_cb.services_in_query = 0;
+    } else {
+      do {
+        p_sdp_rec = NULL;
+        if (bta_dm_search_cb.service_index == (BTA_USER_SERVICE_ID + 1)) {
+          p_sdp_rec = SDP_FindServiceUUIDInDb(bta_dm_search_cb.p_sdp_db,
+                                              bta_dm_search_cb.uuid, p_sdp_rec);
+
+          if (p_sdp_rec && SDP_FindProtocolListElemInRec(
+                               p_sdp_rec, UUID_PROTOCOL_RFCOMM, &pe)) {
+            bta_dm_search_cb.peer_scn = (uint8_t)pe.params[0];
+            scn_found = true;
+          }
+        } else {
+          service = bta_service_id_to_uuid_lkup_tbl
+              [bta_dm_search_cb.service_index - 1];
+          p_sdp_rec = first_rec[bta_dm_search_cb.service_index - 1];
+          if (service == UUID_SERVCLASS_PNP_INFORMATION) {
+            APPL_TRACE_DEBUG(" Store DI info to conf file " );
+            if (SDP_GetNumDiRecords(bta_dm_search_cb.p_sdp_db) != 0) {
+              /* always update information with primary DI record */
+              if (SDP_GetDiRecord(1, &di_rec, bta_dm_search_cb.p_sdp_db) ==
+                  SDP_SUCCESS) {
+                bta_dm_store_di_info(p_sdp_rec, di_rec.rec.vendor,
+                                     di_rec.rec.product, di_rec.rec.version);
+              }
             }
+            bta_dm_search_cb.sdp_di_hash =
+                bta_dm_sdp_di_hash(bta_dm_search_cb.p_sdp_db);
+            bta_dm_search_cb.sdp_eir_hash =
+                bta_dm_sdp_eir_hash(bta_dm_search_cb.peer_bdaddr);
           }
         }
-      }
 
-      /* finished with BR/EDR services, now we check the result for GATT based
-       * service UUID */
-      if (bta_dm_search_cb.service_index == BTA_MAX_SERVICE_ID) {
-        if (bta_dm_search_cb.uuid_to_search != 0 && p_uuid != NULL) {
-          p_uuid +=
-              (bta_dm_search_cb.num_uuid - bta_dm_search_cb.uuid_to_search);
-          /* only support 16 bits UUID for now */
-          service = p_uuid->As16Bit();
-        }
-        /* all GATT based services */
-        do {
-          /* find a service record, report it */
-          p_sdp_rec =
-              SDP_FindServiceInDb(bta_dm_search_cb.p_sdp_db, 0, p_sdp_rec);
-          if (p_sdp_rec) {
-            Uuid service_uuid;
-            if (SDP_FindServiceUUIDInRec(p_sdp_rec, &service_uuid)) {
-              /* send result back to app now, one by one */
-              result.disc_ble_res.bd_addr = bta_dm_search_cb.peer_bdaddr;
-              strlcpy((char*)result.disc_ble_res.bd_name, bta_dm_get_remname(),
-                      BD_NAME_LEN + 1);
-
-              result.disc_ble_res.service = service_uuid;
-              bta_dm_search_cb.p_search_cback(BTA_DM_DISC_BLE_RES_EVT, &result);
-            }
+        /* finished with BR/EDR services, now we check the result for GATT based
+         * service UUID */
+        if (bta_dm_search_cb.service_index == BTA_MAX_SERVICE_ID) {
+          if (bta_dm_search_cb.uuid_to_search != 0 && p_uuid != NULL) {
+            p_uuid +=
+                (bta_dm_search_cb.num_uuid - bta_dm_search_cb.uuid_to_search);
+            /* only support 16 bits UUID for now */
+            service = p_uuid->As16Bit();
           }
+          /* all GATT based services */
+          do {
+            /* find a service record, report it */
+            p_sdp_rec =
+                SDP_FindServiceInDb(bta_dm_search_cb.p_sdp_db, 0, p_sdp_rec);
+            if (p_sdp_rec) {
+              Uuid service_uuid;
+              if (SDP_FindServiceUUIDInRec(p_sdp_rec, &service_uuid)) {
+                /* send result back to app now, one by one */
+                result.disc_ble_res.bd_addr = bta_dm_search_cb.peer_bdaddr;
+                strlcpy((char*)result.disc_ble_res.bd_name,
+                        bta_dm_get_remname(), BD_NAME_LEN + 1);
+
+                result.disc_ble_res.service = service_uuid;
+                bta_dm_search_cb.p_search_cback(BTA_DM_DISC_BLE_RES_EVT,
+                                                &result);
+              }
+            }
 
-          if (bta_dm_search_cb.uuid_to_search > 0) break;
+            if (bta_dm_search_cb.uuid_to_search > 0) break;
 
-        } while (p_sdp_rec);
-      } else {
-        /* SDP_DB_FULL means some records with the
-           required attributes were received */
-        if (((p_data->sdp_event.sdp_result == SDP_DB_FULL) &&
-             bta_dm_search_cb.services != BTA_ALL_SERVICE_MASK) ||
-            (p_sdp_rec != NULL)) {
-          if (service != UUID_SERVCLASS_PNP_INFORMATION) {
-            bta_dm_search_cb.services_found |=
-                (tBTA_SERVICE_MASK)(BTA_SERVICE_ID_TO_SERVICE_MASK(
-                    bta_dm_search_cb.service_index - 1));
-            uint16_t tmp_svc =
-                bta_service_id_to_uuid_lkup_tbl[bta_dm_search_cb.service_index -
-                                                1];
-            /* Add to the list of UUIDs */
-            uuid_list.push_back(Uuid::From16Bit(tmp_svc));
+          } while (p_sdp_rec);
+        } else {
+          /* SDP_DB_FULL means some records with the
+             required attributes were received */
+          if (((p_data->sdp_event.sdp_result == SDP_DB_FULL) &&
+               bta_dm_search_cb.services != BTA_ALL_SERVICE_MASK) ||
+              (p_sdp_rec != NULL)) {
+            if (service != UUID_SERVCLASS_PNP_INFORMATION) {
+              bta_dm_search_cb.services_found |=
+                  (tBTA_SERVICE_MASK)(BTA_SERVICE_ID_TO_SERVICE_MASK(
+                      bta_dm_search_cb.service_index - 1));
+              uint16_t tmp_svc = bta_service_id_to_uuid_lkup_tbl
+                  [bta_dm_search_cb.service_index - 1];
+              /* Add to the list of UUIDs */
+              uuid_list.push_back(Uuid::From16Bit(tmp_svc));
+            }
           }
         }
-      }
 
-      if (bta_dm_search_cb.services == BTA_ALL_SERVICE_MASK &&
-          bta_dm_search_cb.services_to_search == 0) {
-        if (bta_dm_search_cb.service_index == BTA_BLE_SERVICE_ID &&
-            bta_dm_search_cb.uuid_to_search > 0)
-          bta_dm_search_cb.uuid_to_search--;
+        if (bta_dm_search_cb.services == BTA_ALL_SERVICE_MASK &&
+            bta_dm_search_cb.services_to_search == 0) {
+          if (bta_dm_search_cb.service_index == BTA_BLE_SERVICE_ID &&
+              bta_dm_search_cb.uuid_to_search > 0)
+            bta_dm_search_cb.uuid_to_search--;
 
-        if (bta_dm_search_cb.uuid_to_search == 0 ||
-            bta_dm_search_cb.service_index != BTA_BLE_SERVICE_ID)
-          bta_dm_search_cb.service_index++;
-      } else /* regular one service per search or PNP search */
-        break;
+          if (bta_dm_search_cb.uuid_to_search == 0 ||
+              bta_dm_search_cb.service_index != BTA_BLE_SERVICE_ID)
+            bta_dm_search_cb.service_index++;
+        } else /* regular one service per search or PNP search */
+          break;
 
-    } while (bta_dm_search_cb.service_index <= BTA_MAX_SERVICE_ID);
+      } while (bta_dm_search_cb.service_index <= BTA_MAX_SERVICE_ID);
+    }
 
     APPL_TRACE_DEBUG("%s services_found = %04x", __func__,
                      bta_dm_search_cb.services_found);
@@ -2169,6 +2286,30 @@ void bta_dm_sdp_result(tBTA_DM_MSG* p_data) {
          bta_dm_store_profiles_version();
 
     }
+
+    /* The DI record is searched first. If the peer did not change since its
+     * last full discovery, finish with the results of that one instead of
+     * querying all its records again. */
+    if (bta_dm_search_cb.services == BTA_ALL_SERVICE_MASK &&
+        bta_dm_search_cb.services_to_search != 0 &&
+        bta_dm_search_cb.p_sdp_db != NULL &&
+        bta_dm_search_cb.p_sdp_db->raw_data != NULL) {
+      tBTA_DM_SDP_CACHE* p_cache = bta_dm_sdp_cache_lookup(
+          bta_dm_search_cb.peer_bdaddr, bta_dm_search_cb.sdp_di_hash,
+          bta_dm_search_cb.sdp_eir_hash);
+      if (p_cache != NULL) {
+        APPL_TRACE_DEBUG("%s using cached SDP results of %s", __func__,
+                         bta_dm_search_cb.peer_bdaddr.ToString().c_str());
+        bta_dm_search_cb.services_to_search = 0;
+        bta_dm_search_cb.services_found |= p_cache->services_found;
+        uuid_list = p_cache->uuid_list;
+        if (!p_cache->raw_data.empty())
+          memcpy(bta_dm_search_cb.p_sdp_db->raw_data, p_cache->raw_data.data(),
+                 p_cache->raw_data.size());
+        bta_dm_search_cb.p_sdp_db->raw_used = p_cache->raw_data.size();
+      }
+    }
+
     /* if there are more services to search for */
     if (bta_dm_search_cb.services_to_search) {
       /* Free up the p_sdp_db before checking the next one */
@@ -2225,6 +2366,16 @@ void bta_dm_sdp_result(tBTA_DM_MSG* p_data) {
       p_msg->disc_result.result.disc_res.services =
           bta_dm_search_cb.services_found;
 
+      /* Keep the results of a complete discovery of all the services */
+      if (bta_dm_search_cb.services == BTA_ALL_SERVICE_MASK &&
+          bta_dm_search_cb.sdp_all_success) {
+        bta_dm_sdp_cache_store(
+            bta_dm_search_cb.peer_bdaddr, bta_dm_search_cb.sdp_di_hash,
+            bta_dm_search_cb.sdp_eir_hash, bta_dm_search_cb.services_found,
+            uuid_list, p_msg->disc_result.result.disc_res.p_raw_data,
+            p_msg->disc_result.result.disc_res.raw_data_size);
+      }
+
       // Piggy back the SCN over result field
       if (scn_found &&
          (bta_dm_search_cb.services == BTA_USER_SERVICE_MASK)) {
@@ -2569,11 +2720,24 @@ static void bta_dm_find_services(const RawAddress& bd_addr) {
                     bta_dm_search_cb.service_index)));
 
         } else {
-          /* remove the service from services to be searched  */
-          bta_dm_search_cb.services_to_search &= (tBTA_SERVICE_MASK)(~(
-              BTA_SERVICE_ID_TO_SERVICE_MASK(bta_dm_search_cb.service_index)));
-          uuid = Uuid::From16Bit(
-              bta_service_id_to_uuid_lkup_tbl[bta_dm_search_cb.service_index]);
+          tBTA_SERVICE_MASK query_services = bta_dm_sdp_query_services();
+          if ((query_services & BTA_SERVICE_ID_TO_SERVICE_MASK(
+                                    bta_dm_search_cb.service_index)) &&
+              (query_services & (query_services - 1))) {
+            /* A search pattern with several service UUIDs only matches the
+             * records having them all, so search the BR/EDR services left by
+             * the L2CAP UUID and sort the records out in a single pass. */
+            bta_dm_search_cb.services_in_query = query_services;
+            bta_dm_search_cb.services_to_search &= ~query_services;
+            uuid = Uuid::From16Bit(UUID_PROTOCOL_L2CAP);
+          } else {
+            /* remove the service from services to be searched  */
+            bta_dm_search_cb.services_to_search &=
+                (tBTA_SERVICE_MASK)(~(BTA_SERVICE_ID_TO_SERVICE_MASK(
+                    bta_dm_search_cb.service_index)));
+            uuid = Uuid::From16Bit(bta_service_id_to_uuid_lkup_tbl
+                                       [bta_dm_search_cb.service_index]);
+          }
         }
       }
 
@@ -2599,9 +2763,11 @@ static void bta_dm_find_services(const RawAddress& bd_addr) {
          */
         osi_free_and_reset((void**)&bta_dm_search_cb.p_sdp_db);
         bta_dm_search_cb.service_index = BTA_MAX_SERVICE_ID;
+        bta_dm_search_cb.services_in_query = 0;
 
       } else {
-        if (uuid == Uuid::From16Bit(UUID_PROTOCOL_L2CAP)) {
+        if (uuid == Uuid::From16Bit(UUID_PROTOCOL_L2CAP) &&
+            bta_dm_search_cb.services_in_query == 0) {
           if (sdpu_is_pbap_0102_enabled() && !is_sdp_pbap_pce_disabled(bd_addr)) {
             LOG_DEBUG(LOG_TAG, "%s SDP search for PBAP Client ", __func__);
             BTA_SdpSearch(bd_addr, Uuid::From16Bit(UUID_SERVCLASS_PBAP_PCE));
@@ -2738,6 +2904,10 @@ static void bta_dm_discover_device(const RawAddress& remote_bd_addr) {
     bta_dm_search_cb.services_found = 0;
     bta_dm_search_cb.services_to_search = bta_dm_search_cb.services;
     bta_dm_search_cb.uuid_to_search = bta_dm_search_cb.num_uuid;
+    bta_dm_search_cb.services_in_query = 0;
+    bta_dm_search_cb.sdp_di_hash = 0;
+    bta_dm_search_cb.sdp_eir_hash = 0;
+    bta_dm_search_cb.sdp_all_success = true;
     if ((bta_dm_search_cb.p_btm_inq_info != NULL) &&
         bta_dm_search_cb.services != BTA_USER_SERVICE_MASK &&
         (bta_dm_search_cb.sdp_search == false)) {
@@ -3969,6 +4139,8 @@ void bta_dm_acl_change(tBTA_DM_MSG* p_data) {
       BTA_GATTC_CancelOpen(0, p_bda, false);
       /* remove all cached GATT information */
       BTA_GATTC_Refresh(p_bda);
+      /* remove the cached SDP results */
+      bta_dm_sdp_cache_remove(p_bda);
     }
 
     conn.link_down.bd_addr = p_bda;
@@ -4191,6 +4363,8 @@ static void bta_dm_remove_sec_dev_entry(const RawAddress& remote_bd_addr) {
     BTA_GATTC_CancelOpen(0, addr_copy, false);
     /* remove all cached GATT information */
     BTA_GATTC_Refresh(addr_copy);
+    /* remove the cached SDP results */
+    bta_dm_sdp_cache_remove(addr_copy);
   }
 }
 
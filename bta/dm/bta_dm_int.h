@@ -60,6 +60,7 @@
 
 #include <memory>
 #include <map>
+#include <vector>
 #include "bt_target.h"
 #include "bta_sys.h"
 
@@ -795,6 +796,10 @@ typedef struct {
   BD_NAME peer_name;
   alarm_t* search_timer;
   uint8_t service_index;
+  tBTA_SERVICE_MASK services_in_query; /* services searched by one query */
+  uint32_t sdp_di_hash;                /* keys of the SDP result cache */
+  uint32_t sdp_eir_hash;
+  bool sdp_all_success;                /* no query of the discovery failed */
   tBTA_DM_MSG* p_search_queue; /* search or discover commands during search
                                   cancel stored here */
   bool wait_disc;
@@ -913,6 +918,18 @@ typedef struct {
   bool is_lea_device = false;
 } tBTA_DM_LE_GATT_INFO;
 
+/* Per-device cache of the results of a full service discovery */
+typedef struct {
+  bool in_use;
+  RawAddress bd_addr;
+  uint32_t di_hash;  /* hash of the primary DI record of the peer */
+  uint32_t eir_hash; /* hash of the EIR service UUIDs, 0 if none were known */
+  uint32_t last_used;
+  tBTA_SERVICE_MASK services_found;
+  std::vector<bluetooth::Uuid> uuid_list;
+  std::vector<uint8_t> raw_data;
+} tBTA_DM_SDP_CACHE;
+
 extern const uint16_t bta_service_id_to_uuid_lkup_tbl[];
 
 extern tBTA_DM_PM_CFG* p_bta_dm_pm_cfg;
@@ -1016,6 +1033,17 @@ extern void bta_dm_search_cancel_cmpl(tBTA_DM_MSG* p_data);
 extern void bta_dm_search_cancel_notify(tBTA_DM_MSG* p_data);
 extern void bta_dm_search_cancel_transac_cmpl(tBTA_DM_MSG* p_data);
 extern void bta_dm_disc_rmt_name(tBTA_DM_MSG* p_data);
+extern tBTA_DM_SDP_CACHE* bta_dm_sdp_cache_lookup(const RawAddress& bd_addr,
+                                                  uint32_t di_hash,
+                                                  uint32_t eir_hash);
+extern void bta_dm_sdp_cache_store(
+    const RawAddress& bd_addr, uint32_t di_hash, uint32_t eir_hash,
+    tBTA_SERVICE_MASK services_found,
+    const std::vector<bluetooth::Uuid>& uuid_list, const uint8_t* p_raw_data,
+    uint32_t raw_data_size);
+extern void bta_dm_sdp_cache_remove(const RawAddress& bd_addr);
+extern void bta_dm_sdp_find_services_in_db(
+    tSDP_DISCOVERY_DB* p_db, tSDP_DISC_REC* first_rec[BTA_MAX_SERVICE_ID]);
 extern tBTA_DM_PEER_DEVICE* bta_dm_find_peer_device(
     const RawAddress& peer_addr);
 
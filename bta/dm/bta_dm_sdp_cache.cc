@@ -0,0 +1,213 @@
+/******************************************************************************
+ * Copyright (c) 2026 Qualcomm Innovation Center, Inc. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ *
+ *******************************************************************************/
+
+/******************************************************************************
+ *
+ *  This file contains the cache of the service discovery results of the
+ *  device manager, and the matching of the discovered records to the BTA
+ *  services.
+ *
+ ******************************************************************************/
+
+#include <string.h>
+
+#include <vector>
+
+#include "bt_common.h"
+#include "bt_target.h"
+#include "bta_api.h"
+#include "bta_dm_int.h"
+#include "sdp_api.h"
+#include "sdpdefs.h"
+
+using bluetooth::Uuid;
+
+static tBTA_DM_SDP_CACHE bta_dm_sdp_cache[BTA_DM_SDP_CACHE_SIZE];
+static uint32_t bta_dm_sdp_cache_clock;
+
+static tBTA_DM_SDP_CACHE* bta_dm_sdp_cache_find(const RawAddress& bd_addr) {
+  for (int i = 0; i < BTA_DM_SDP_CACHE_SIZE; i++) {
+    if (bta_dm_sdp_cache[i].in_use && bta_dm_sdp_cache[i].bd_addr == bd_addr)
+      return &bta_dm_sdp_cache[i];
+  }
+  return NULL;
+}
+
+/*******************************************************************************
+ *
+ * Function         bta_dm_sdp_cache_lookup
+ *
+ * Description      Looks for the results of an earlier discovery of the peer
+ *                  which are still valid: the peer must have the same DI
+ *                  record, and the same EIR service UUIDs if they are known
+ *                  both then and now.
+ *
+ * Returns          the cache entry, NULL if none is valid
+ *
+ ******************************************************************************/
+tBTA_DM_SDP_CACHE* bta_dm_sdp_cache_lookup(const RawAddress& bd_addr,
+                                           uint32_t di_hash,
+                                           uint32_t eir_hash) {
+  if (di_hash == 0) return NULL;
+
+  tBTA_DM_SDP_CACHE* p_cache = bta_dm_sdp_cache_find(bd_addr);
+  if (p_cache == NULL) return NULL;
+
+  if (p_cache->di_hash != di_hash ||
+      (p_cache->eir_hash != 0 && eir_hash != 0 &&
+       p_cache->eir_hash != eir_hash)) {
+    APPL_TRACE_DEBUG("%s peer %s changed, dropping its SDP results", __func__,
+                     bd_addr.ToString().c_str());
+    p_cache->in_use = false;
+    return NULL;
+  }
+
+  p_cache->last_used = ++bta_dm_sdp_cache_clock;
+  return p_cache;
+}
+
+/*******************************************************************************
+ *
+ * Function         bta_dm_sdp_cache_store
+ *
+ * Description      Keeps the results of a full service discovery of the peer,
+ *                  replacing the least recently used entry if the cache is
+ *                  full. Results without any record are not kept.
+ *
+ * Returns          void
+ *
+ ******************************************************************************/
+void bta_dm_sdp_cache_store(const RawAddress& bd_addr, uint32_t di_hash,
+                            uint32_t eir_hash, tBTA_SERVICE_MASK services_found,
+                            const std::vector<Uuid>& uuid_list,
+                            const uint8_t* p_raw_data, uint32_t raw_data_size) {
+  /* a peer without records is queried again, in case it was not ready */
+  if (di_hash == 0 || uuid_list.empty() || raw_data_size == 0) return;
+
+  tBTA_DM_SDP_CACHE* p_cache = bta_dm_sdp_cache_find(bd_addr);
+  if (p_cache == NULL) {
+    p_cache = &bta_dm_sdp_cache[0];
+    for (int i = 0; i < BTA_DM_SDP_CACHE_SIZE; i++) {
+      if (!bta_dm_sdp_cache[i].in_use) {
+        p_cache = &bta_dm_sdp_cache[i];
+        break;
+      }
+      if (bta_dm_sdp_cache[i].last_used < p_cache->last_used)
+        p_cache = &bta_dm_sdp_cache[i];
+    }
+  }
+
+  p_cache->in_use = true;
+  p_cache->bd_addr = bd_addr;
+  p_cache->di_hash = di_hash;
+  p_cache->eir_hash = eir_hash;
+  p_cache->last_used = ++bta_dm_sdp_cache_clock;
+  p_cache->services_found = services_found;
+  p_cache->uuid_list = uuid_list;
+  p_cache->raw_data.assign(p_raw_data, p_raw_data + raw_data_size);
+}
+
+/*******************************************************************************
+ *
+ * Function         bta_dm_sdp_cache_remove
+ *
+ * Description      Drops the cached service discovery results of the peer.
+ *
+ * Returns          void
+ *
+ ******************************************************************************/
+void bta_dm_sdp_cache_remove(const RawAddress& bd_addr) {
+  tBTA_DM_SDP_CACHE* p_cache = bta_dm_sdp_cache_find(bd_addr);
+  if (p_cache == NULL) return;
+
+  p_cache->in_use = false;
+  p_cache->uuid_list.clear();
+  p_cache->raw_data.clear();
+}
+
+/*******************************************************************************
+ *
+ * Function         bta_dm_sdp_find_services_in_db
+ *
+ * Description      Finds, in a single pass over the discovery database, the
+ *                  first record of every service of
+ *                  bta_service_id_to_uuid_lkup_tbl. Matches the records the
+ *                  same way as SDP_FindServiceInDb().
+ *
+ * Returns          void
+ *
+ ******************************************************************************/
+void bta_dm_sdp_find_services_in_db(
+    tSDP_DISCOVERY_DB* p_db, tSDP_DISC_REC* first_rec[BTA_MAX_SERVICE_ID]) {
+  uint8_t num_left = BTA_MAX_SERVICE_ID;
+
+  memset(first_rec, 0, sizeof(tSDP_DISC_REC*) * BTA_MAX_SERVICE_ID);
+  if (p_db == NULL) return;
+
+  for (tSDP_DISC_REC* p_rec = p_db->p_first_rec; p_rec && num_left;
+       p_rec = p_rec->p_next_rec) {
+    uint64_t matched = 0; /* bit per service ID */
+    bool any_uuid = false;
+    bool hdp = false;
+
+    /* Marks the services of a 16 bits UUID of the record */
+    auto match_uuid = [&matched](uint16_t uuid) {
+      for (int id = 0; id < BTA_MAX_SERVICE_ID; id++) {
+        if (bta_service_id_to_uuid_lkup_tbl[id] == uuid && uuid != 0)
+          matched |= (uint64_t)1 << id;
+      }
+    };
+
+    for (tSDP_DISC_ATTR* p_attr = p_rec->p_first_attr; p_attr;
+         p_attr = p_attr->p_next_attr) {
+      if (p_attr->attr_id == ATTR_ID_SERVICE_CLASS_ID_LIST &&
+          SDP_DISC_ATTR_TYPE(p_attr->attr_len_type) == DATA_ELE_SEQ_DESC_TYPE) {
+        for (tSDP_DISC_ATTR* p_sattr = p_attr->attr_value.v.p_sub_attr; p_sattr;
+             p_sattr = p_sattr->p_next_attr) {
+          uint8_t type = SDP_DISC_ATTR_TYPE(p_sattr->attr_len_type);
+          uint32_t len = SDP_DISC_ATTR_LEN(p_sattr->attr_len_type);
+          if (type == UUID_DESC_TYPE) {
+            any_uuid = true;
+            if (len == 2) {
+              match_uuid(p_sattr->attr_value.v.u16);
+              if (p_sattr->attr_value.v.u16 == UUID_SERVCLASS_HDP_SOURCE ||
+                  p_sattr->attr_value.v.u16 == UUID_SERVCLASS_HDP_SINK)
+                hdp = true;
+            }
+          } else if (type == DATA_ELE_SEQ_DESC_TYPE) {
+            /* same extra sequence as handled by SDP_FindServiceInDb() */
+            for (tSDP_DISC_ATTR* p_extra = p_sattr->attr_value.v.p_sub_attr;
+                 p_extra; p_extra = p_extra->p_next_attr) {
+              if (SDP_DISC_ATTR_TYPE(p_extra->attr_len_type) ==
+                      UUID_DESC_TYPE &&
+                  SDP_DISC_ATTR_LEN(p_extra->attr_len_type) == 2) {
+                any_uuid = true;
+                match_uuid(p_extra->attr_value.v.u16);
+              }
+            }
+          }
+        }
+        break;
+      } else if (p_attr->attr_id == ATTR_ID_SERVICE_ID &&
+                 SDP_DISC_ATTR_TYPE(p_attr->attr_len_type) == UUID_DESC_TYPE &&
+                 SDP_DISC_ATTR_LEN(p_attr->attr_len_type) == 2) {
+        any_uuid = true;
+        match_uuid(p_attr->attr_value.v.u16);
+      }
+    }
+
+    for (int id = 0; id < BTA_MAX_SERVICE_ID; id++) {
+      if (first_rec[id] != NULL) continue;
+
+      uint16_t uuid = bta_service_id_to_uuid_lkup_tbl[id];
+      if ((uuid == 0 && any_uuid) || (matched & ((uint64_t)1 << id)) ||
+          (uuid == UUID_SERVCLASS_HDP_PROFILE && hdp)) {
+        first_rec[id] = p_rec;
+        num_left--;
+      }
+    }
+  }
+}
@@ -132,16 +132,6 @@ void bta_gattc_init_cache(tBTA_GATTC_SERV* p_srvc_cb) {
   p_srvc_cb->pending_discovery.Clear();
 }
 
-const Service* bta_gattc_find_matching_service(
-    const std::vector<Service>& services, uint16_t handle) {
-  for (const Service& service : services) {
-    if (handle >= service.handle && handle <= service.end_handle)
-      return &service;
-  }
-
-  return nullptr;
-}
-
 /// Whether the peer device uses robust caching
 RobustCachingSupport GetRobustCachingSupport(const tBTA_GATTC_CLCB* p_clcb,
                                              const gatt::Database& db) {
@@ -158,11 +148,9 @@ RobustCachingSupport GetRobustCachingSupport(const tBTA_GATTC_CLCB* p_clcb,
   // we can't infer anything from that
   if (!db.IsEmpty()) {
     // Here, we can simply check whether the database hash is present
-    for (const auto& service : db.Services()) {
-      if (service.uuid.As16Bit() != UUID_SERVCLASS_GATT_SERVER) {
-        continue;
-      }
-      for (const auto& characteristic : service.characteristics) {
+    for (const Service* service :
+         db.ServicesWithUuid(Uuid::From16Bit(UUID_SERVCLASS_GATT_SERVER))) {
+      for (const auto& characteristic : service->characteristics) {
         if (characteristic.uuid.As16Bit() == GATT_UUID_DATABASE_HASH) {
           // the hash was found, so we should read it
           LOG_DEBUG(LOG_TAG,"database hash characteristic found, so SUPPORTED");
@@ -638,19 +626,20 @@ const std::vector<Service>* bta_gattc_get_services(uint16_t conn_id) {
   return bta_gattc_get_services_srcb(p_srcb);
 }
 
+/* Unlike bta_gattc_get_services_srcb(), this only loads the attributes of the
+ * service containing |handle| when the database was read from the cache. */
 const Service* bta_gattc_get_service_for_handle_srcb(tBTA_GATTC_SERV* p_srcb,
                                                      uint16_t handle) {
-  const std::vector<Service>* services = bta_gattc_get_services_srcb(p_srcb);
-  if (services == NULL) return NULL;
-  return bta_gattc_find_matching_service(*services, handle);
+  if (!p_srcb) return NULL;
+  return p_srcb->gatt_database.ServiceForHandle(handle);
 }
 
 const Service* bta_gattc_get_service_for_handle(uint16_t conn_id,
                                                 uint16_t handle) {
-  const std::vector<Service>* services = bta_gattc_get_services(conn_id);
-  if (services == NULL) return NULL;
+  tBTA_GATTC_CLCB* p_clcb = bta_gattc_find_clcb_by_conn_id(conn_id);
+  if (p_clcb == NULL) return NULL;
 
-  return bta_gattc_find_matching_service(*services, handle);
+  return bta_gattc_get_service_for_handle_srcb(p_clcb->p_srcb, handle);
 }
 
 const Characteristic* bta_gattc_get_characteristic_srcb(tBTA_GATTC_SERV* p_srcb,
@@ -21,25 +21,32 @@
 #include <base/logging.h>
 #include <base/strings/string_number_conversions.h>
 #include <dirent.h>
+#include <fcntl.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
+#include <unistd.h>
 
+#include <map>
+#include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "bta/gatt/bta_gattc_int.h"
 #include "osi/include/log.h"
 
-using gatt::StoredAttribute;
+using gatt::StoredDatabase;
 using std::string;
 using std::vector;
 
 #define GATT_CACHE_PREFIX "/data/misc/bluetooth/gatt_cache_"
-#define GATT_CACHE_VERSION 6
+#define GATT_CACHE_VERSION 7
 
 #define GATT_HASH_MAX_SIZE 30
 #define GATT_HASH_PATH_PREFIX "/data/misc/bluetooth/gatt_hash_"
 #define GATT_HASH_PATH "/data/misc/bluetooth"
 #define GATT_HASH_FILE_PREFIX "gatt_hash_"
+#define GATT_CACHE_FILE_PREFIX "gatt_cache_"
 
 // Default expired time is 7 days
 #define GATT_HASH_EXPIRED_TIME 604800
@@ -61,62 +68,118 @@ static void bta_gattc_generate_hash_file_name(char* buffer, size_t buffer_len,
 
 static gatt::Database EMPTY_DB;
 
+/* Cache files are laid out as a uint16_t GATT_CACHE_VERSION, two bytes of
+ * padding, and the output of gatt::Database::SerializeToStorage(). */
+#define GATT_CACHE_HEADER_SIZE 4
+
+/* Mapped cache files by device and inode. Address files are hard links to hash
+ * files, so all devices with the same database share one mapping. */
+static std::map<std::pair<dev_t, ino_t>, std::weak_ptr<const StoredDatabase>>
+    mapped_dbs;
+
 /*******************************************************************************
  *
- * Function         bta_gattc_load_db
+ * Function         bta_gattc_map_db
  *
- * Description      Load GATT database from storage.
+ * Description      Map GATT database file in memory, or return the existing
+ *                  mapping of the same file.
  *
  * Parameter        fname: input file name
  *
- * Returns          non-empty GATT database on success, empty GATT database
- *                  otherwise
+ * Returns          the mapped database, or nullptr on failure
  *
  ******************************************************************************/
-static gatt::Database bta_gattc_load_db(const char* fname) {
-  FILE* fd = fopen(fname, "rb");
-  if (!fd) {
+static std::shared_ptr<const StoredDatabase> bta_gattc_map_db(
+    const char* fname) {
+  int fd = open(fname, O_RDONLY | O_CLOEXEC);
+  if (fd == -1) {
     LOG(ERROR) << __func__ << ": can't open GATT cache file " << fname
                << " for reading, error: " << strerror(errno);
-    return EMPTY_DB;
+    return nullptr;
   }
 
-  uint16_t cache_ver = 0;
-  uint16_t num_attr = 0;
+  struct stat st;
+  if (fstat(fd, &st) == -1) {
+    LOG(ERROR) << __func__ << ": can't stat GATT cache file " << fname;
+    close(fd);
+    return nullptr;
+  }
+
+  auto key = std::make_pair(st.st_dev, st.st_ino);
+  auto it = mapped_dbs.find(key);
+  if (it != mapped_dbs.end()) {
+    std::shared_ptr<const StoredDatabase> stored = it->second.lock();
+    if (stored) {
+      close(fd);
+      return stored;
+    }
+    mapped_dbs.erase(it);
+  }
 
-  if (fread(&cache_ver, sizeof(uint16_t), 1, fd) != 1) {
-    LOG(ERROR) << __func__ << ": can't read GATT cache version from: " << fname;
-    goto done;
+  size_t size = st.st_size;
+  if (size < GATT_CACHE_HEADER_SIZE) {
+    LOG(ERROR) << __func__ << ": GATT cache file too short: " << fname;
+    close(fd);
+    return nullptr;
   }
 
+  // Files are replaced with rename() and never written in place, so the
+  // mapping stays valid until it is unmapped.
+  void* addr = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (addr == MAP_FAILED) {
+    LOG(ERROR) << __func__ << ": can't map GATT cache file " << fname
+               << ", error: " << strerror(errno);
+    return nullptr;
+  }
+
+  const uint8_t* data = static_cast<const uint8_t*>(addr);
+  uint16_t cache_ver;
+  memcpy(&cache_ver, data, sizeof(cache_ver));
   if (cache_ver != GATT_CACHE_VERSION) {
     LOG(ERROR) << __func__ << ": wrong GATT cache version: " << fname;
-    goto done;
+    munmap(addr, size);
+    return nullptr;
   }
 
-  if (fread(&num_attr, sizeof(uint16_t), 1, fd) != 1) {
-    LOG(ERROR) << __func__
-               << ": can't read number of GATT attributes: " << fname;
-    goto done;
+  StoredDatabase* stored = new StoredDatabase();
+  if (!stored->Map(data + GATT_CACHE_HEADER_SIZE,
+                   size - GATT_CACHE_HEADER_SIZE)) {
+    LOG(ERROR) << __func__ << ": malformed GATT cache file: " << fname;
+    delete stored;
+    munmap(addr, size);
+    return nullptr;
   }
 
-  {
-    std::vector<StoredAttribute> attr(num_attr);
-
-    if (fread(attr.data(), sizeof(StoredAttribute), num_attr, fd) != num_attr) {
-      LOG(ERROR) << __func__ << ": can't read GATT attributes: " << fname;
-      goto done;
-    }
+  std::shared_ptr<const StoredDatabase> result(
+      stored, [addr, size](const StoredDatabase* stored) {
+        munmap(addr, size);
+        delete stored;
+      });
+  mapped_dbs[key] = result;
+  return result;
+}
 
-    fclose(fd);
-    bool success = false;
-    gatt::Database result = gatt::Database::Deserialize(attr, &success);
-    return success ? result : EMPTY_DB;
-  }
+/*******************************************************************************
+ *
+ * Function         bta_gattc_load_db
+ *
+ * Description      Load GATT database from storage.
+ *
+ * Parameter        fname: input file name
+ *
+ * Returns          non-empty GATT database on success, empty GATT database
+ *                  otherwise
+ *
+ ******************************************************************************/
+static gatt::Database bta_gattc_load_db(const char* fname) {
+  std::shared_ptr<const StoredDatabase> stored = bta_gattc_map_db(fname);
+  if (!stored) return EMPTY_DB;
 
-done:
-  fclose(fd);
-  return EMPTY_DB;
+  bool success = false;
+  gatt::Database result = gatt::Database::FromStorage(std::move(stored),
+                                                      &success);
+  return success ? result : EMPTY_DB;
 }
 
 /*******************************************************************************
@@ -155,6 +218,44 @@ gatt::Database bta_gattc_hash_load(const Octet16& hash) {
   return bta_gattc_load_db(fname);
 }
 
+/*******************************************************************************
+ *
+ * Function         bta_gattc_find_cache_links
+ *
+ * Description      Find the address files that are hard links to a file.
+ *
+ * Parameter        fname: hash file name
+ *
+ * Returns          the paths of the address files linked to fname
+ *
+ ******************************************************************************/
+static vector<string> bta_gattc_find_cache_links(const char* fname) {
+  vector<string> links;
+  struct stat st;
+  if (stat(fname, &st) == -1 || st.st_nlink == 1) return links;
+
+  std::unique_ptr<DIR, decltype(&closedir)> dirp(opendir(GATT_HASH_PATH),
+                                                 &closedir);
+  if (dirp == nullptr) {
+    LOG_ERROR(LOG_TAG, "open dir error, dir=%s", GATT_HASH_PATH);
+    return links;
+  }
+
+  size_t prefix_len = strlen(GATT_CACHE_FILE_PREFIX);
+  dirent* dp;
+  while ((dp = readdir(dirp.get())) != nullptr) {
+    if (strncmp(dp->d_name, GATT_CACHE_FILE_PREFIX, prefix_len) != 0) continue;
+
+    string path = string(GATT_HASH_PATH) + "/" + dp->d_name;
+    struct stat link_st;
+    if (lstat(path.c_str(), &link_st) == 0 && link_st.st_dev == st.st_dev &&
+        link_st.st_ino == st.st_ino) {
+      links.push_back(path);
+    }
+  }
+  return links;
+}
+
 /*******************************************************************************
  *
  * Function         bta_gattc_store_db
@@ -162,42 +263,56 @@ gatt::Database bta_gattc_hash_load(const Octet16& hash) {
  * Description      Storess GATT db.
  *
  * Parameter        fname: output file name
- *                  attr: attributes to save.
+ *                  database: database to save.
  *
  * Returns          true on success, false otherwise
  *
  ******************************************************************************/
 static bool bta_gattc_store_db(const char* fname,
-                               const std::vector<StoredAttribute>& attr) {
-  FILE* fd = fopen(fname, "wb");
+                               const gatt::Database& database) {
+  // The file may be mapped by bta_gattc_map_db(), so a new file is written
+  // and renamed over it instead of truncating it.
+  string tmp_fname = string(fname) + ".tmp";
+  FILE* fd = fopen(tmp_fname.c_str(), "wb");
   if (!fd) {
     LOG(ERROR) << __func__
-               << ": can't open GATT cache file for writing: " << fname;
+               << ": can't open GATT cache file for writing: " << tmp_fname;
     return false;
   }
 
-  uint16_t cache_ver = GATT_CACHE_VERSION;
-  if (fwrite(&cache_ver, sizeof(uint16_t), 1, fd) != 1) {
+  uint16_t cache_header[GATT_CACHE_HEADER_SIZE / sizeof(uint16_t)] = {
+      GATT_CACHE_VERSION};
+  if (fwrite(cache_header, GATT_CACHE_HEADER_SIZE, 1, fd) != 1) {
     LOG(ERROR) << __func__ << ": can't write GATT cache version: " << fname;
     fclose(fd);
+    unlink(tmp_fname.c_str());
     return false;
   }
 
-  uint16_t num_attr = attr.size();
-  if (fwrite(&num_attr, sizeof(uint16_t), 1, fd) != 1) {
-    LOG(ERROR) << __func__
-               << ": can't write GATT cache attribute count: " << fname;
+  std::vector<uint8_t> data = database.SerializeToStorage();
+  if (fwrite(data.data(), 1, data.size(), fd) != data.size()) {
+    LOG(ERROR) << __func__ << ": can't write GATT cache attributes: " << fname;
     fclose(fd);
+    unlink(tmp_fname.c_str());
     return false;
   }
 
-  if (fwrite(attr.data(), sizeof(StoredAttribute), num_attr, fd) != num_attr) {
-    LOG(ERROR) << __func__ << ": can't write GATT cache attributes: " << fname;
-    fclose(fd);
+  // The renamed file is a new inode, so the address files linked to the old
+  // one are linked again to keep the file out of the LRU eviction.
+  vector<string> links = bta_gattc_find_cache_links(fname);
+  if (fclose(fd) != 0 || rename(tmp_fname.c_str(), fname) == -1) {
+    LOG(ERROR) << __func__ << ": can't commit GATT cache file: " << fname;
+    unlink(tmp_fname.c_str());
     return false;
   }
 
-  fclose(fd);
+  for (const string& link_name : links) {
+    unlink(link_name.c_str());
+    if (link(fname, link_name.c_str()) == -1) {
+      LOG_ERROR(LOG_TAG, "link %s to %s, errno=%d", link_name.c_str(), fname,
+                errno);
+    }
+  }
   return true;
 }
 
@@ -271,7 +386,7 @@ bool bta_gattc_hash_write(const Octet16& hash, const gatt::Database& database) {
   char fname[255] = {0};
   bta_gattc_generate_hash_file_name(fname, sizeof(fname), hash);
   bta_gattc_hash_remove_least_recently_used_if_possible();
-  return bta_gattc_store_db(fname, database.Serialize());
+  return bta_gattc_store_db(fname, database);
 }
 
 /*******************************************************************************
@@ -22,6 +22,8 @@
 #include "stack/include/gattdefs.h"
 
 #include <base/logging.h>
+#include <string.h>
+#include <algorithm>
 #include <memory>
 #include <sstream>
 
@@ -40,8 +42,71 @@ const Uuid CHARACTERISTIC_EXTENDED_PROPERTIES =
 bool HandleInRange(const Service& svc, uint16_t handle) {
   return handle >= svc.handle && handle <= svc.end_handle;
 }
+
+/* Add the included service, characteristic or descriptor |attr| to |service|,
+ * one of |services| */
+bool AddAttribute(std::vector<Service>& services, Service& service,
+                  const StoredAttribute& attr) {
+  if (attr.type == INCLUDE) {
+    Service* included_service =
+        FindService(services, attr.value.included_service.handle);
+    if (!included_service) {
+      LOG(ERROR) << __func__ << ": Non-existing included service!";
+      return false;
+    }
+    service.included_services.push_back(IncludedService{
+        .handle = attr.handle,
+        .uuid = attr.value.included_service.uuid,
+        .start_handle = attr.value.included_service.handle,
+        .end_handle = attr.value.included_service.end_handle,
+    });
+  } else if (attr.type == CHARACTERISTIC) {
+    service.characteristics.emplace_back(
+        Characteristic{.declaration_handle = attr.handle,
+                       .value_handle = attr.value.characteristic.value_handle,
+                       .properties = attr.value.characteristic.properties,
+                       .uuid = attr.value.characteristic.uuid});
+
+  } else {
+    if (service.characteristics.empty()) {
+      LOG(ERROR) << __func__ << ": Descriptor outside of a characteristic!";
+      return false;
+    }
+    if (attr.type == CHARACTERISTIC_EXTENDED_PROPERTIES) {
+      service.characteristics.back().descriptors.emplace_back(
+          Descriptor{.handle = attr.handle,
+                     .uuid = attr.type,
+                     .characteristic_extended_properties =
+                         attr.value.characteristic_extended_properties});
+
+    } else {
+      service.characteristics.back().descriptors.emplace_back(
+          Descriptor{.handle = attr.handle, .uuid = attr.type});
+    }
+  }
+  return true;
+}
 }  // namespace
 
+static_assert(alignof(StoredServiceRange) <= sizeof(StoredDatabaseHeader) &&
+                  alignof(StoredAttribute) <= sizeof(StoredServiceRange),
+              "stored database records would be misaligned");
+
+bool StoredDatabase::Map(const uint8_t* data, size_t size) {
+  if (size < sizeof(StoredDatabaseHeader)) return false;
+  header = reinterpret_cast<const StoredDatabaseHeader*>(data);
+  size_t services_size = header->num_services * sizeof(StoredServiceRange);
+  size_t attributes_size = header->num_attr * sizeof(StoredAttribute);
+  if (size != sizeof(StoredDatabaseHeader) + services_size + attributes_size)
+    return false;
+
+  services = reinterpret_cast<const StoredServiceRange*>(
+      data + sizeof(StoredDatabaseHeader));
+  attributes = reinterpret_cast<const StoredAttribute*>(
+      data + sizeof(StoredDatabaseHeader) + services_size);
+  return true;
+}
+
 static size_t UuidSize(const Uuid& uuid) {
   size_t len = uuid.GetShortestRepresentationSize();
   return (len == Uuid::kNumBytes32) ? Uuid::kNumBytes128 : len;
@@ -56,10 +121,59 @@ Service* FindService(std::vector<Service>& services, uint16_t handle) {
   return nullptr;
 }
 
+const std::vector<Service>& Database::Services() const {
+  if (stored) {
+    for (size_t i = 0; i < services.size(); i++) LoadService(i);
+  }
+  return services;
+}
+
+const Service* Database::ServiceForHandle(uint16_t handle) const {
+  if (!stored) {
+    for (const Service& service : services) {
+      if (HandleInRange(service, handle)) return &service;
+    }
+    return nullptr;
+  }
+
+  // FromStorage() made sure the stored services are sorted and disjoint
+  auto it = std::upper_bound(services.begin(), services.end(), handle,
+                             [](uint16_t handle, const Service& service) {
+                               return handle < service.handle;
+                             });
+  if (it == services.begin()) return nullptr;
+  --it;
+  if (!HandleInRange(*it, handle)) return nullptr;
+
+  LoadService(it - services.begin());
+  return &*it;
+}
+
+std::vector<const Service*> Database::ServicesWithUuid(const Uuid& uuid) const {
+  std::vector<const Service*> result;
+  for (size_t i = 0; i < services.size(); i++) {
+    if (services[i].uuid != uuid) continue;
+    LoadService(i);
+    result.push_back(&services[i]);
+  }
+  return result;
+}
+
+void Database::LoadService(size_t index) const {
+  if (!stored || loaded[index]) return;
+  loaded[index] = true;
+
+  const StoredServiceRange& range = stored->services[index];
+  for (uint16_t i = 0; i < range.num_attr; i++) {
+    AddAttribute(services, services[index],
+                 stored->attributes[range.first_attr + i]);
+  }
+}
+
 std::string Database::ToString() const {
   std::stringstream tmp;
 
-  for (const Service& service : services) {
+  for (const Service& service : Services()) {
     tmp << "Service: handle=" << loghex(service.handle)
         << ", end_handle=" << loghex(service.end_handle)
         << ", uuid=" << service.uuid << "\n";
@@ -91,6 +205,11 @@ std::vector<StoredAttribute> Database::Serialize() const {
 
   if (services.empty()) return std::vector<StoredAttribute>();
 
+  if (stored) {
+    return std::vector<StoredAttribute>(
+        stored->attributes, stored->attributes + stored->header->num_attr);
+  }
+
   for (const Service& service : services) {
     // TODO: add constructor to NV_ATTR, use emplace_back
     nv_attr.push_back({service.handle,
@@ -167,46 +286,121 @@ Database Database::Deserialize(const std::vector<StoredAttribute>& nv_attr,
       return result;
     }
 
-    if (attr.type == INCLUDE) {
-      Service* included_service =
-          FindService(result.services, attr.value.included_service.handle);
-      if (!included_service) {
-        LOG(ERROR) << __func__ << ": Non-existing included service!";
-        *success = false;
-        return result;
-      }
-      current_service_it->included_services.push_back(IncludedService{
-          .handle = attr.handle,
-          .uuid = attr.value.included_service.uuid,
-          .start_handle = attr.value.included_service.handle,
-          .end_handle = attr.value.included_service.end_handle,
-      });
-    } else if (attr.type == CHARACTERISTIC) {
-      current_service_it->characteristics.emplace_back(
-          Characteristic{.declaration_handle = attr.handle,
-                         .value_handle = attr.value.characteristic.value_handle,
-                         .properties = attr.value.characteristic.properties,
-                         .uuid = attr.value.characteristic.uuid});
+    if (!AddAttribute(result.services, *current_service_it, attr)) {
+      *success = false;
+      return result;
+    }
+  }
+  *success = true;
+  return result;
+}
 
-    } else {
-      if (attr.type == CHARACTERISTIC_EXTENDED_PROPERTIES) {
-        current_service_it->characteristics.back().descriptors.emplace_back(
-            Descriptor{.handle = attr.handle,
-                       .uuid = attr.type,
-                       .characteristic_extended_properties =
-                           attr.value.characteristic_extended_properties});
+std::vector<uint8_t> Database::SerializeToStorage() const {
+  std::vector<StoredAttribute> nv_attr = Serialize();
+  const std::vector<Service>& all_services = Services();
+
+  // Serialize() puts the attributes of each service together, after all the
+  // service declarations
+  std::vector<StoredServiceRange> ranges;
+  ranges.reserve(all_services.size());
+  uint16_t first_attr = all_services.size();
+  for (const Service& service : all_services) {
+    uint16_t num_attr = service.included_services.size();
+    for (const Characteristic& c : service.characteristics)
+      num_attr += 1 + c.descriptors.size();
+
+    ranges.push_back(StoredServiceRange{.handle = service.handle,
+                                        .end_handle = service.end_handle,
+                                        .first_attr = first_attr,
+                                        .num_attr = num_attr});
+    first_attr += num_attr;
+  }
+
+  StoredDatabaseHeader header = {
+      .num_attr = static_cast<uint16_t>(nv_attr.size()),
+      .num_services = static_cast<uint16_t>(ranges.size()),
+      .hash = Hash(),
+  };
+
+  size_t ranges_size = ranges.size() * sizeof(StoredServiceRange);
+  size_t attributes_size = nv_attr.size() * sizeof(StoredAttribute);
+  std::vector<uint8_t> result(sizeof(header) + ranges_size + attributes_size);
+  uint8_t* p = result.data();
+  memcpy(p, &header, sizeof(header));
+  p += sizeof(header);
+  if (ranges_size) memcpy(p, ranges.data(), ranges_size);
+  p += ranges_size;
+  if (attributes_size) memcpy(p, nv_attr.data(), attributes_size);
+  return result;
+}
+
+Database Database::FromStorage(std::shared_ptr<const StoredDatabase> stored,
+                               bool* success) {
+  Database result;
+  const StoredDatabaseHeader& header = *stored->header;
+  *success = false;
 
+  if (header.num_services > header.num_attr) {
+    LOG(ERROR) << __func__ << ": more services than attributes";
+    return result;
+  }
+
+  result.services.reserve(header.num_services);
+  for (uint16_t i = 0; i < header.num_services; i++) {
+    const StoredAttribute& attr = stored->attributes[i];
+    const StoredServiceRange& range = stored->services[i];
+    if ((attr.type != PRIMARY_SERVICE && attr.type != SECONDARY_SERVICE) ||
+        attr.handle != range.handle ||
+        attr.value.service.end_handle != range.end_handle ||
+        range.handle > range.end_handle ||
+        (i > 0 && range.handle <= stored->services[i - 1].end_handle) ||
+        range.first_attr < header.num_services ||
+        range.first_attr + range.num_attr > header.num_attr) {
+      LOG(ERROR) << __func__ << ": malformed service with handle "
+                 << loghex(range.handle);
+      return Database();
+    }
+    result.services.emplace_back(
+        Service{.handle = attr.handle,
+                .end_handle = attr.value.service.end_handle,
+                .is_primary = (attr.type == PRIMARY_SERVICE),
+                .uuid = attr.value.service.uuid});
+  }
+
+  // Check every attribute the way LoadService() will add it, so that it can
+  // not fail later on
+  for (uint16_t i = 0; i < header.num_services; i++) {
+    const StoredServiceRange& range = stored->services[i];
+    bool in_characteristic = false;
+    for (uint16_t j = 0; j < range.num_attr; j++) {
+      const StoredAttribute& attr = stored->attributes[range.first_attr + j];
+      bool valid = HandleInRange(result.services[i], attr.handle);
+      if (attr.type == INCLUDE) {
+        valid = valid && FindService(result.services,
+                                     attr.value.included_service.handle);
+      } else if (attr.type == CHARACTERISTIC) {
+        in_characteristic = true;
       } else {
-        current_service_it->characteristics.back().descriptors.emplace_back(
-            Descriptor{.handle = attr.handle, .uuid = attr.type});
+        valid = valid && in_characteristic;
+      }
+
+      if (!valid) {
+        LOG(ERROR) << __func__ << ": malformed attribute with handle "
+                   << loghex(attr.handle);
+        return Database();
       }
     }
   }
+
+  result.loaded.assign(result.services.size(), false);
+  result.stored = std::move(stored);
   *success = true;
   return result;
 }
 
 Octet16 Database::Hash() const {
+  if (stored) return stored->header->hash;
+
   int len = 0;
   // Compute how much space we need to actually hold the data.
   for (const Service& service : services) {
@@ -18,6 +18,7 @@
 
 #pragma once
 
+#include <memory>
 #include <set>
 #include <string>
 #include <utility>
@@ -62,6 +63,38 @@ struct StoredAttribute {
   } value;
 };
 
+/* Layout of a stored database: a StoredDatabaseHeader, |num_services|
+ * StoredServiceRange sorted by handle, and the |num_attr| attributes returned
+ * by Database::Serialize(). It is read in place, so the records keep their
+ * natural alignment. */
+struct StoredDatabaseHeader {
+  uint16_t num_attr;
+  uint16_t num_services;
+  Octet16 hash; /* Database::Hash() of the stored database */
+};
+
+/* The attributes of the service declared at |handle|, other than its
+ * declaration, are attributes[first_attr] to attributes[first_attr + num_attr
+ * - 1]. */
+struct StoredServiceRange {
+  uint16_t handle;
+  uint16_t end_handle;
+  uint16_t first_attr;
+  uint16_t num_attr;
+};
+
+/* A stored database mapped in memory. It is never written to, so the same
+ * mapping can back the databases of all devices that share it. */
+struct StoredDatabase {
+  const StoredDatabaseHeader* header;
+  const StoredServiceRange* services;
+  const StoredAttribute* attributes;
+
+  /* Point the members into the |size| bytes at |data|. Returns false if
+   * |size| does not match the counts in the header. */
+  bool Map(const uint8_t* data, size_t size);
+};
+
 struct IncludedService;
 struct Characteristic;
 struct Descriptor;
@@ -106,10 +139,24 @@ class Database {
 
   /* Clear the GATT database. This method forces relocation to ensure no extra
    * space is used unnecesarly */
-  void Clear() { std::vector<Service>().swap(services); }
+  void Clear() {
+    std::vector<Service>().swap(services);
+    std::vector<bool>().swap(loaded);
+    stored.reset();
+  }
+
+  /* Return list of services available in this database. A database built by
+   * FromStorage() reads the attributes of every service it has not read yet. */
+  const std::vector<Service>& Services() const;
 
-  /* Return list of services available in this database */
-  const std::vector<Service>& Services() const { return services; }
+  /* Return the service containing |handle|, or nullptr. Only the attributes
+   * of that service are read from storage. */
+  const Service* ServiceForHandle(uint16_t handle) const;
+
+  /* Return the services with the given |uuid|, reading only their
+   * attributes from storage. */
+  std::vector<const Service*> ServicesWithUuid(
+      const bluetooth::Uuid& uuid) const;
 
   std::string ToString() const;
 
@@ -118,13 +165,31 @@ class Database {
   static Database Deserialize(const std::vector<gatt::StoredAttribute>& nv_attr,
                               bool* success);
 
+  /* Return this database in the StoredDatabase layout */
+  std::vector<uint8_t> SerializeToStorage() const;
+
+  /* Return a database that only reads the service declarations from |stored|
+   * up front, and the attributes of each service the first time the service
+   * is looked up. |stored| is fully validated, so later reads can not fail. */
+  static Database FromStorage(std::shared_ptr<const StoredDatabase> stored,
+                              bool* success);
+
   /* Return 128 bit unique identifier of this GATT database */
   Octet16 Hash() const;
 
   friend class DatabaseBuilder;
 
  private:
-  std::vector<Service> services;
+  void LoadService(size_t index) const;
+
+  /* The services are filled in lazily by const methods when |stored| is set;
+   * like the rest of BTA GATT this is only used from the BTA thread. */
+  mutable std::vector<Service> services;
+
+  /* Storage backing |services|, |loaded[i]| is set once the attributes of
+   * services[i] have been read from it */
+  std::shared_ptr<const StoredDatabase> stored;
+  mutable std::vector<bool> loaded;
 };
 
 /* Find a service that should contain handle. Helper method for internal use
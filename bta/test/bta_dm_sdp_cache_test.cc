@@ -0,0 +1,263 @@
+/******************************************************************************
+ * Copyright (c) 2026 Qualcomm Innovation Center, Inc. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ *
+ *******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <deque>
+#include <vector>
+
+#include "bta/dm/bta_dm_int.h"
+#include "stack/include/sdp_api.h"
+#include "stack/include/sdpdefs.h"
+
+using bluetooth::Uuid;
+
+/* Below is what bta_dm_act.cc defines, as it can't be linked without the
+ * whole stack. */
+const uint16_t bta_service_id_to_uuid_lkup_tbl[BTA_MAX_SERVICE_ID] = {
+    UUID_SERVCLASS_PNP_INFORMATION,       UUID_SERVCLASS_SERIAL_PORT,
+    UUID_SERVCLASS_DIALUP_NETWORKING,     UUID_SERVCLASS_AUDIO_SOURCE,
+    UUID_SERVCLASS_LAN_ACCESS_USING_PPP,  UUID_SERVCLASS_HEADSET,
+    UUID_SERVCLASS_HF_HANDSFREE,          UUID_SERVCLASS_OBEX_OBJECT_PUSH,
+    UUID_SERVCLASS_OBEX_FILE_TRANSFER,    UUID_SERVCLASS_CORDLESS_TELEPHONY,
+    UUID_SERVCLASS_INTERCOM,              UUID_SERVCLASS_IRMC_SYNC,
+    UUID_SERVCLASS_DIRECT_PRINTING,       UUID_SERVCLASS_IMAGING_RESPONDER,
+    UUID_SERVCLASS_PANU,                  UUID_SERVCLASS_NAP,
+    UUID_SERVCLASS_GN,                    UUID_SERVCLASS_SAP,
+    UUID_SERVCLASS_AUDIO_SINK,            UUID_SERVCLASS_AV_REMOTE_CONTROL,
+    UUID_SERVCLASS_HUMAN_INTERFACE,       UUID_SERVCLASS_VIDEO_SINK,
+    UUID_SERVCLASS_PBAP_PSE,              UUID_SERVCLASS_HEADSET_AUDIO_GATEWAY,
+    UUID_SERVCLASS_AG_HANDSFREE,          UUID_SERVCLASS_MESSAGE_ACCESS,
+    UUID_SERVCLASS_MESSAGE_NOTIFICATION,  UUID_SERVCLASS_HDP_PROFILE,
+    UUID_SERVCLASS_PBAP_PCE,              UUID_PROTOCOL_ATT};
+
+namespace {
+const RawAddress bdaddr({0x11, 0x22, 0x33, 0x44, 0x55, 0x66});
+const RawAddress bdaddr2({0x66, 0x55, 0x44, 0x33, 0x22, 0x11});
+const uint32_t di_hash = 0x1234;
+const uint32_t eir_hash = 0x5678;
+const tBTA_SERVICE_MASK services_found = BTA_HFP_SERVICE_MASK;
+const std::vector<Uuid> uuid_list = {
+    Uuid::From16Bit(UUID_SERVCLASS_AG_HANDSFREE)};
+const uint8_t raw_data[] = {0x35, 0x03, 0x19, 0x11, 0x1F};
+}  // namespace
+
+// A discovery database of records with the service class IDs and service ID
+// they are given.
+class BtaDmSdpMatchTest : public ::testing::Test {
+ protected:
+  void SetUp() override { memset(&db_, 0, sizeof(db_)); }
+
+  tSDP_DISC_ATTR* NewAttr(uint16_t attr_id, uint16_t attr_len_type) {
+    attrs_.emplace_back();
+    tSDP_DISC_ATTR* p_attr = &attrs_.back();
+    memset(p_attr, 0, sizeof(*p_attr));
+    p_attr->attr_id = attr_id;
+    p_attr->attr_len_type = attr_len_type;
+    return p_attr;
+  }
+
+  tSDP_DISC_ATTR* Uuid16(uint16_t uuid) {
+    tSDP_DISC_ATTR* p_attr = NewAttr(0, (UUID_DESC_TYPE << 12) | 2);
+    p_attr->attr_value.v.u16 = uuid;
+    return p_attr;
+  }
+
+  tSDP_DISC_ATTR* Uuid128() {
+    return NewAttr(0, (UUID_DESC_TYPE << 12) | 16);
+  }
+
+  tSDP_DISC_ATTR* Sequence(uint16_t attr_id,
+                           std::vector<tSDP_DISC_ATTR*> sub_attrs) {
+    tSDP_DISC_ATTR* p_attr =
+        NewAttr(attr_id, (DATA_ELE_SEQ_DESC_TYPE << 12) | 0);
+    Link(sub_attrs);
+    p_attr->attr_value.v.p_sub_attr = sub_attrs.empty() ? NULL : sub_attrs[0];
+    return p_attr;
+  }
+
+  tSDP_DISC_ATTR* ServiceId(uint16_t uuid) {
+    tSDP_DISC_ATTR* p_attr = Uuid16(uuid);
+    p_attr->attr_id = ATTR_ID_SERVICE_ID;
+    return p_attr;
+  }
+
+  // Adds a record of the attributes, after the ones added before
+  tSDP_DISC_REC* AddRecord(std::vector<tSDP_DISC_ATTR*> rec_attrs) {
+    recs_.emplace_back();
+    tSDP_DISC_REC* p_rec = &recs_.back();
+    memset(p_rec, 0, sizeof(*p_rec));
+    Link(rec_attrs);
+    p_rec->p_first_attr = rec_attrs.empty() ? NULL : rec_attrs[0];
+    if (recs_.size() == 1)
+      db_.p_first_rec = p_rec;
+    else
+      recs_[recs_.size() - 2].p_next_rec = p_rec;
+    return p_rec;
+  }
+
+  static void Link(const std::vector<tSDP_DISC_ATTR*>& attrs) {
+    for (size_t i = 1; i < attrs.size(); i++)
+      attrs[i - 1]->p_next_attr = attrs[i];
+  }
+
+  tSDP_DISCOVERY_DB db_;
+  std::deque<tSDP_DISC_ATTR> attrs_;
+  std::deque<tSDP_DISC_REC> recs_;
+};
+
+// The first record of every service is the one SDP_FindServiceInDb() finds
+// for the UUID of the service.
+TEST_F(BtaDmSdpMatchTest, test_find_services_in_db) {
+  tSDP_DISC_REC* p_handsfree = AddRecord({Sequence(
+      ATTR_ID_SERVICE_CLASS_ID_LIST,
+      {Uuid16(UUID_SERVCLASS_HF_HANDSFREE),
+       Uuid16(UUID_SERVCLASS_GENERIC_AUDIO)})});
+  tSDP_DISC_REC* p_sink = AddRecord(
+      {Sequence(ATTR_ID_SERVICE_CLASS_ID_LIST,
+                {Uuid16(UUID_SERVCLASS_AUDIO_SINK)})});
+  AddRecord({Sequence(ATTR_ID_SERVICE_CLASS_ID_LIST,
+                      {Uuid16(UUID_SERVCLASS_HF_HANDSFREE)})});
+  // The UUID in an extra sequence, as some car kits put it
+  tSDP_DISC_REC* p_spp = AddRecord(
+      {Sequence(ATTR_ID_SERVICE_CLASS_ID_LIST,
+                {Sequence(0, {Uuid16(UUID_SERVCLASS_SERIAL_PORT)})})});
+  tSDP_DISC_REC* p_hdp = AddRecord(
+      {Sequence(ATTR_ID_SERVICE_CLASS_ID_LIST,
+                {Uuid16(UUID_SERVCLASS_HDP_SINK)})});
+  AddRecord({Sequence(ATTR_ID_SERVICE_CLASS_ID_LIST, {Uuid128()})});
+  tSDP_DISC_REC* p_opp =
+      AddRecord({ServiceId(UUID_SERVCLASS_OBEX_OBJECT_PUSH)});
+  // The service ID is not looked at after the service class ID list
+  AddRecord({Sequence(ATTR_ID_SERVICE_CLASS_ID_LIST,
+                      {Uuid16(UUID_SERVCLASS_IMAGING_RESPONDER)}),
+             ServiceId(UUID_SERVCLASS_NAP)});
+  tSDP_DISC_REC* p_panu = AddRecord(
+      {Sequence(ATTR_ID_PROTOCOL_DESC_LIST, {Uuid16(UUID_PROTOCOL_L2CAP)}),
+       Sequence(ATTR_ID_SERVICE_CLASS_ID_LIST,
+                {Uuid16(UUID_SERVCLASS_PANU)})});
+
+  tSDP_DISC_REC* first_rec[BTA_MAX_SERVICE_ID];
+  bta_dm_sdp_find_services_in_db(&db_, first_rec);
+
+  for (int id = 0; id < BTA_MAX_SERVICE_ID; id++) {
+    SCOPED_TRACE(testing::Message() << "service id " << id);
+    EXPECT_EQ(first_rec[id],
+              SDP_FindServiceInDb(&db_, bta_service_id_to_uuid_lkup_tbl[id],
+                                  NULL));
+  }
+  EXPECT_EQ(first_rec[BTA_HFP_SERVICE_ID], p_handsfree);
+  EXPECT_EQ(first_rec[BTA_A2DP_SINK_SERVICE_ID], p_sink);
+  EXPECT_EQ(first_rec[BTA_SPP_SERVICE_ID], p_spp);
+  EXPECT_EQ(first_rec[BTA_HDP_SERVICE_ID], p_hdp);
+  EXPECT_EQ(first_rec[BTA_OPP_SERVICE_ID], p_opp);
+  EXPECT_EQ(first_rec[BTA_PANU_SERVICE_ID], p_panu);
+  EXPECT_EQ(first_rec[BTA_NAP_SERVICE_ID], nullptr);
+  EXPECT_EQ(first_rec[BTA_HSP_SERVICE_ID], nullptr);
+  // The services without UUID are found in any record with one
+  EXPECT_EQ(first_rec[BTA_HIDD_SERVICE_ID], p_handsfree);
+}
+
+TEST_F(BtaDmSdpMatchTest, test_find_services_in_empty_db) {
+  tSDP_DISC_REC* first_rec[BTA_MAX_SERVICE_ID];
+
+  bta_dm_sdp_find_services_in_db(&db_, first_rec);
+  for (int id = 0; id < BTA_MAX_SERVICE_ID; id++)
+    EXPECT_EQ(first_rec[id], nullptr);
+
+  bta_dm_sdp_find_services_in_db(NULL, first_rec);
+  for (int id = 0; id < BTA_MAX_SERVICE_ID; id++)
+    EXPECT_EQ(first_rec[id], nullptr);
+}
+
+class BtaDmSdpCacheTest : public ::testing::Test {
+ protected:
+  void TearDown() override {
+    bta_dm_sdp_cache_remove(bdaddr);
+    bta_dm_sdp_cache_remove(bdaddr2);
+    for (uint8_t i = 0; i <= BTA_DM_SDP_CACHE_SIZE; i++)
+      bta_dm_sdp_cache_remove(PeerAddr(i));
+  }
+
+  static RawAddress PeerAddr(uint8_t i) {
+    return RawAddress({0x00, 0x11, 0x22, 0x33, 0x44, i});
+  }
+
+  static void Store(const RawAddress& addr, uint32_t di, uint32_t eir) {
+    bta_dm_sdp_cache_store(addr, di, eir, services_found, uuid_list, raw_data,
+                           sizeof(raw_data));
+  }
+};
+
+TEST_F(BtaDmSdpCacheTest, test_cache_hit) {
+  Store(bdaddr, di_hash, eir_hash);
+
+  tBTA_DM_SDP_CACHE* p_cache = bta_dm_sdp_cache_lookup(bdaddr, di_hash,
+                                                       eir_hash);
+  ASSERT_NE(p_cache, nullptr);
+  EXPECT_EQ(p_cache->services_found, services_found);
+  EXPECT_EQ(p_cache->uuid_list, uuid_list);
+  ASSERT_EQ(p_cache->raw_data.size(), sizeof(raw_data));
+  EXPECT_EQ(0, memcmp(p_cache->raw_data.data(), raw_data, sizeof(raw_data)));
+
+  // The EIR of the peer is not always known
+  EXPECT_NE(bta_dm_sdp_cache_lookup(bdaddr, di_hash, 0), nullptr);
+  Store(bdaddr2, di_hash, 0);
+  EXPECT_NE(bta_dm_sdp_cache_lookup(bdaddr2, di_hash, eir_hash), nullptr);
+}
+
+TEST_F(BtaDmSdpCacheTest, test_cache_miss) {
+  Store(bdaddr, di_hash, eir_hash);
+
+  EXPECT_EQ(bta_dm_sdp_cache_lookup(bdaddr2, di_hash, eir_hash), nullptr);
+  // A peer without DI record can't be told from its next version
+  EXPECT_EQ(bta_dm_sdp_cache_lookup(bdaddr, 0, eir_hash), nullptr);
+  Store(bdaddr2, 0, eir_hash);
+  EXPECT_EQ(bta_dm_sdp_cache_lookup(bdaddr2, 0, eir_hash), nullptr);
+}
+
+// A discovery that found no record is not kept
+TEST_F(BtaDmSdpCacheTest, test_results_without_records_not_cached) {
+  bta_dm_sdp_cache_store(bdaddr, di_hash, eir_hash, 0, {}, raw_data,
+                         sizeof(raw_data));
+  EXPECT_EQ(bta_dm_sdp_cache_lookup(bdaddr, di_hash, eir_hash), nullptr);
+
+  bta_dm_sdp_cache_store(bdaddr, di_hash, eir_hash, services_found, uuid_list,
+                         NULL, 0);
+  EXPECT_EQ(bta_dm_sdp_cache_lookup(bdaddr, di_hash, eir_hash), nullptr);
+}
+
+// The results are dropped when the DI record or the EIR of the peer changed,
+// or when the peer is removed.
+TEST_F(BtaDmSdpCacheTest, test_cache_invalidation) {
+  Store(bdaddr, di_hash, eir_hash);
+  EXPECT_EQ(bta_dm_sdp_cache_lookup(bdaddr, di_hash + 1, eir_hash), nullptr);
+  EXPECT_EQ(bta_dm_sdp_cache_lookup(bdaddr, di_hash, eir_hash), nullptr);
+
+  Store(bdaddr, di_hash, eir_hash);
+  EXPECT_EQ(bta_dm_sdp_cache_lookup(bdaddr, di_hash, eir_hash + 1), nullptr);
+  EXPECT_EQ(bta_dm_sdp_cache_lookup(bdaddr, di_hash, eir_hash), nullptr);
+
+  Store(bdaddr, di_hash, eir_hash);
+  Store(bdaddr2, di_hash, eir_hash);
+  bta_dm_sdp_cache_remove(bdaddr);
+  EXPECT_EQ(bta_dm_sdp_cache_lookup(bdaddr, di_hash, eir_hash), nullptr);
+  EXPECT_NE(bta_dm_sdp_cache_lookup(bdaddr2, di_hash, eir_hash), nullptr);
+}
+
+// A new peer replaces the least recently used one when the cache is full
+TEST_F(BtaDmSdpCacheTest, test_cache_lru_replacement) {
+  for (uint8_t i = 0; i < BTA_DM_SDP_CACHE_SIZE; i++)
+    Store(PeerAddr(i), di_hash, eir_hash);
+  ASSERT_NE(bta_dm_sdp_cache_lookup(PeerAddr(0), di_hash, eir_hash), nullptr);
+
+  Store(PeerAddr(BTA_DM_SDP_CACHE_SIZE), di_hash, eir_hash);
+  EXPECT_EQ(bta_dm_sdp_cache_lookup(PeerAddr(1), di_hash, eir_hash), nullptr);
+  for (uint8_t i = 0; i <= BTA_DM_SDP_CACHE_SIZE; i++) {
+    if (i == 1) continue;
+    EXPECT_NE(bta_dm_sdp_cache_lookup(PeerAddr(i), di_hash, eir_hash), nullptr);
+  }
+}
@@ -283,4 +283,84 @@ TEST(GattCacheTest,
   // LOG(ERROR) << " " << base::HexEncode(&attr, len);
   EXPECT_EQ(memcmp(binary_form, &attr, len), 0);
 }
+
+namespace {
+Database BuildStorageTestDatabase() {
+  DatabaseBuilder builder;
+  builder.AddService(0x0001, 0x000f, SERVICE_1_UUID, true);
+  builder.AddService(0x0010, 0x001f, SERVICE_2_UUID, false);
+  builder.AddIncludedService(0x0002, SERVICE_2_UUID, 0x0010, 0x001f);
+  builder.AddCharacteristic(0x0003, 0x0004, SERVICE_1_CHAR_1_UUID, 0x02);
+  builder.AddDescriptor(0x0005, SERVICE_1_CHAR_1_DESC_1_UUID);
+  builder.AddCharacteristic(0x0011, 0x0012, SERVICE_1_CHAR_1_UUID, 0x10);
+  builder.AddDescriptor(0x0013, SERVICE_1_CHAR_1_DESC_1_UUID);
+  return builder.Build();
+}
+
+std::shared_ptr<const StoredDatabase> MapStorage(
+    const std::vector<uint8_t>& data) {
+  auto stored = std::make_shared<StoredDatabase>();
+  if (!stored->Map(data.data(), data.size())) return nullptr;
+  return stored;
+}
+}  // namespace
+
+/* This test makes sure that a database read from storage is the same as the
+ * stored one, and that looking up one handle only reads its own service */
+TEST(GattDatabaseTest, storage_lazy_load_test) {
+  Database db = BuildStorageTestDatabase();
+  std::vector<uint8_t> data = db.SerializeToStorage();
+
+  std::shared_ptr<const StoredDatabase> stored = MapStorage(data);
+  ASSERT_NE(stored, nullptr);
+  EXPECT_EQ(stored->header->num_services, 2);
+  EXPECT_EQ(stored->header->num_attr, 7);
+
+  bool success = false;
+  Database loaded = Database::FromStorage(stored, &success);
+  ASSERT_TRUE(success);
+  EXPECT_EQ(loaded.Hash(), db.Hash());
+
+  const Service* service = loaded.ServiceForHandle(0x0012);
+  ASSERT_NE(service, nullptr);
+  EXPECT_EQ(service->handle, 0x0010);
+  ASSERT_EQ(service->characteristics.size(), 1u);
+  EXPECT_EQ(service->characteristics[0].value_handle, 0x0012);
+  EXPECT_EQ(service->characteristics[0].descriptors[0].handle, 0x0013);
+
+  // The first service has not been looked up yet
+  EXPECT_TRUE(loaded.ServiceForHandle(0x0012) == service);
+  EXPECT_EQ(loaded.ServiceForHandle(0x0020), nullptr);
+
+  EXPECT_EQ(loaded.ToString(), db.ToString());
+  EXPECT_EQ(loaded.Services()[1].characteristics.size(), 1u);
+  EXPECT_EQ(loaded.Services()[0].included_services.size(), 1u);
+  EXPECT_EQ(loaded.Serialize().size(), db.Serialize().size());
+}
+
+TEST(GattDatabaseTest, storage_malformed_test) {
+  std::vector<uint8_t> data = BuildStorageTestDatabase().SerializeToStorage();
+
+  // Truncated
+  std::vector<uint8_t> truncated(data.begin(), data.end() - 1);
+  EXPECT_EQ(MapStorage(truncated), nullptr);
+
+  // Second service range starting inside the first one
+  std::vector<uint8_t> overlapping = data;
+  StoredServiceRange* ranges = reinterpret_cast<StoredServiceRange*>(
+      overlapping.data() + sizeof(StoredDatabaseHeader));
+  ranges[1].handle = 0x000f;
+  bool success = true;
+  Database::FromStorage(MapStorage(overlapping), &success);
+  EXPECT_FALSE(success);
+
+  // Attribute range of the first service past the end
+  std::vector<uint8_t> out_of_range = data;
+  ranges = reinterpret_cast<StoredServiceRange*>(out_of_range.data() +
+                                                 sizeof(StoredDatabaseHeader));
+  ranges[0].num_attr = 10;
+  success = true;
+  Database::FromStorage(MapStorage(out_of_range), &success);
+  EXPECT_FALSE(success);
+}
 }  // namespace gatt
@@ -95,6 +95,8 @@
 #include "stack_manager.h"
 #include "stack_interface.h"
 #include "stack/include/btm_api.h"
+#include "stack/include/gatt_api.h"
+#include "stack/include/l2c_api.h"
 
 using base::Bind;
 using bluetooth::hearing_aid::HearingAidInterface;
@@ -433,6 +435,8 @@ static void dump(int fd, const char** arguments) {
   alarm_debug_dump(fd);
   HearingAid::DebugDump(fd);
   connection_manager::dump(fd);
+  gatt_dump(fd);
+  L2CA_Dump(fd);
   bluetooth::bqr::DebugDump(fd);
 #if (BTSNOOP_MEM == TRUE)
   btif_debug_btsnoop_dump(fd);
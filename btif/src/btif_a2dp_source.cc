@@ -84,6 +84,12 @@ using system_bt_osi::A2dpSessionMetrics;
  * layers we might need to temporarily buffer up data.
  */
 #define MAX_OUTPUT_A2DP_FRAME_QUEUE_SZ (MAX_PCM_FRAME_NUM_PER_TICK * 2)
+/**
+ * Capacity of the tx queue ring. The overflow check before each enqueue keeps
+ * the queue within the (uint8_t) dynamic audio buffer size, so the ring never
+ * fills up and the media thread never blocks on it.
+ */
+#define MAX_TX_AUDIO_QUEUE_SZ 256
 #define BTIF_UNBLOCK_AUDIO_START_TOUT 3000
 #define BTIF_REMOTE_START_TOUT 3000
 enum {
@@ -278,7 +284,8 @@ bool btif_a2dp_source_startup(void) {
     return false;
   }
 
-  btif_a2dp_source_cb.tx_audio_queue = fixed_queue_new(SIZE_MAX);
+  btif_a2dp_source_cb.tx_audio_queue =
+      fixed_queue_new(MAX_TX_AUDIO_QUEUE_SZ, FIXED_QUEUE_MODE_RING);
 
   btif_a2dp_source_cb.cmd_msg_queue = fixed_queue_new(SIZE_MAX);
   fixed_queue_register_dequeue(
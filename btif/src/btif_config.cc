@@ -30,12 +30,14 @@
 
 #include <base/logging.h>
 #include <ctype.h>
+#include <inttypes.h>
 #include <openssl/rand.h>
 #include <openssl/sha.h>
 #include <stdio.h>
 #include <string.h>
 #include <time.h>
 #include <unistd.h>
+#include <algorithm>
 #include <mutex>
 #include <sstream>
 #include <string>
@@ -57,6 +59,8 @@
 #include "osi/include/log.h"
 #include "osi/include/osi.h"
 #include "osi/include/properties.h"
+#include "osi/include/thread.h"
+#include "osi/include/time.h"
 
 #define BT_CONFIG_SOURCE_TAG_NUM 1010001
 #define TEMPORARY_SECTION_CAPACITY 10000
@@ -88,7 +92,8 @@ static const char* CONFIG_LEGACY_FILE_PATH =
 static const period_ms_t CONFIG_SETTLE_PERIOD_MS = 3000;
 
 static void timer_config_save_cb(void* data);
-static void btif_config_write(uint16_t event, char* p_param);
+static void config_writer_cb(void* context);
+static bool btif_config_write(bool backup);
 static bool is_factory_reset(void);
 static void delete_config_files(void);
 static void btif_config_remove_unpaired(config_t* config);
@@ -199,6 +204,34 @@ static void read_or_set_metrics_salt() {
 static std::recursive_mutex config_lock;  // protects operations on |config|.
 static alarm_t* config_timer;
 
+// The config file is written on |config_writer_thread| from a snapshot of the
+// persistent sections, so |config_lock| is only held while copying them.
+// |config_write_lock| serializes the writers so that an older snapshot never
+// replaces a newer one; it is always taken before |config_lock|.
+static thread_t* config_writer_thread;
+static std::mutex config_write_lock;
+
+// Bumped on every change to |btif_config_cache|. A save is skipped when the
+// file already holds |config_generation|, and a write is only queued once
+// however many times the settle timer fires before it runs. All three are
+// protected by |config_lock|.
+static uint64_t config_generation;
+static uint64_t config_saved_generation;
+static bool config_write_pending;
+
+// Statistics of the save path for btif_debug_config_dump(), protected by
+// |config_lock|.
+static struct {
+  size_t saves;
+  size_t skipped;
+  size_t failures;
+  uint64_t last_save_us;
+  uint64_t total_save_us;
+  uint64_t max_save_us;
+  uint64_t total_lock_us;
+  uint64_t max_lock_us;
+} config_stats;
+
 // limited btif config cache capacity
 static BtifConfigCache btif_config_cache(TEMPORARY_SECTION_CAPACITY);
 
@@ -243,9 +276,14 @@ static future_t* init(void) {
 
   // move persistent config data from btif_config file to btif config cache
   btif_config_cache.Init(std::move(config));
+  config_generation = 0;
+  config_saved_generation = 0;
+  config_write_pending = false;
+  memset(&config_stats, 0, sizeof(config_stats));
 
   if (!file_source.empty()) {
     btif_config_cache.SetString(INFO_SECTION, FILE_SOURCE, file_source);
+    config_generation++;
   }
 
   //btif_config_remove_unpaired(config.get());
@@ -255,6 +293,7 @@ static future_t* init(void) {
   // Cleanup temporary pairings if we have left guest mode
   if (!is_restricted_mode()) {
     btif_config_cache.RemovePersistentSectionsWithKey("Restricted");
+    config_generation++;
   }
 
   // Read or set config file creation timestamp
@@ -268,6 +307,7 @@ static future_t* init(void) {
                    TIME_STRING_FORMAT, time_created)) {
         btif_config_cache.SetString(INFO_SECTION, FILE_TIMESTAMP,
                                      btif_config_time_created);
+        config_generation++;
       }
     } else {
       strlcpy(btif_config_time_created, time_str->c_str(), TIME_STRING_LENGTH);
@@ -286,6 +326,12 @@ static future_t* init(void) {
     goto error;
   }
 
+  config_writer_thread = thread_new("btif.config_writer");
+  if (!config_writer_thread) {
+    LOG_ERROR(LOG_TAG, "%s unable to create writer thread.", __func__);
+    goto error;
+  }
+
   LOG_EVENT_INT(BT_CONFIG_SOURCE_TAG_NUM, btif_config_source);
 
   return future_new_immediate(FUTURE_SUCCESS);
@@ -323,6 +369,8 @@ static future_t* clean_up(void) {
 
   alarm_free(config_timer);
   config_timer = NULL;
+  thread_free(config_writer_thread);
+  config_writer_thread = NULL;
 
   std::unique_lock<std::recursive_mutex> lock(config_lock);
   btif_config_cache.Clear();
@@ -393,6 +441,7 @@ bool btif_config_set_int(const std::string& section, const std::string& key, int
 
   std::unique_lock<std::recursive_mutex> lock(config_lock);
   btif_config_cache.SetInt(section, key, value);
+  config_generation++;
 
   return true;
 }
@@ -401,6 +450,7 @@ bool btif_config_set_uint16(const std::string& section, const std::string& key,
 
   std::unique_lock<std::recursive_mutex> lock(config_lock);
   btif_config_cache.SetUint16(section, key, value);
+  config_generation++;
 
   return true;
 }
@@ -412,6 +462,7 @@ bool btif_config_set_uint64(const char* section, const char* key,
 
   std::unique_lock<std::recursive_mutex> lock(config_lock);
   btif_config_cache.SetUint64(section, key, value);
+  config_generation++;
 
   return true;
 }
@@ -441,6 +492,7 @@ bool btif_config_set_str(const char* section, const char* key,
 
   std::unique_lock<std::recursive_mutex> lock(config_lock);
   btif_config_cache.SetString(section, key, value);
+  config_generation++;
   return true;
 }
 
@@ -449,6 +501,7 @@ bool btif_config_set_str(const std::string& section, const std::string& key,
 
   std::unique_lock<std::recursive_mutex> lock(config_lock);
   btif_config_cache.SetString(section, key, value);
+  config_generation++;
   return true;
 }
 
@@ -539,10 +592,12 @@ bool btif_config_get_bin(const std::string& section, const std::string& key, uin
       get_bluetooth_keystore_interface()->set_encrypt_key_or_remove_key(
           section + std::string("-") + key, *value_str_from_config);
       btif_config_cache.SetString(section, key, ENCRYPTED_STR);
+      config_generation++;
     }
   } else {
     if (in_encrypt_key_name_list && is_key_encrypted) {
       btif_config_cache.SetString(section, key, *value_str);
+      config_generation++;
     }
   }
 
@@ -584,6 +639,7 @@ bool btif_config_set_bin(const std::string& section, const std::string& key,
   {
     std::unique_lock<std::recursive_mutex> lock(config_lock);
     btif_config_cache.SetString(section, key, value_str);
+    config_generation++;
   }
 
   osi_free(str);
@@ -596,6 +652,7 @@ bool btif_config_remove(const std::string& section, const std::string& key) {
         section + std::string("-") + key, "");
   }
   std::unique_lock<std::recursive_mutex> lock(config_lock);
+  config_generation++;
   return btif_config_cache.RemoveKey(section, key);
 }
 
@@ -622,6 +679,11 @@ std::vector<RawAddress> btif_config_get_paired_devices() {
 void btif_config_save(void) {
   CHECK(config_timer != NULL);
 
+  {
+    std::unique_lock<std::recursive_mutex> lock(config_lock);
+    if (config_generation == config_saved_generation) return;
+  }
+
   alarm_set(config_timer, CONFIG_SETTLE_PERIOD_MS, timer_config_save_cb, NULL);
 }
 
@@ -629,7 +691,7 @@ void btif_config_flush(void) {
   CHECK(config_timer != NULL);
 
   alarm_cancel(config_timer);
-  btif_config_write(0, NULL);
+  btif_config_write(true);
 }
 
 bool btif_config_clear(void) {
@@ -637,36 +699,76 @@ bool btif_config_clear(void) {
 
   alarm_cancel(config_timer);
 
-  std::unique_lock<std::recursive_mutex> lock(config_lock);
-
-  btif_config_cache.Clear();
-  bool ret = config_save(
-    btif_config_cache.PersistentSectionCopy(), CONFIG_FILE_PATH);
-  btif_config_source = RESET;
+  {
+    std::unique_lock<std::recursive_mutex> lock(config_lock);
+    btif_config_cache.Clear();
+    config_generation++;
+    btif_config_source = RESET;
+  }
 
-  return ret;
+  return btif_config_write(false);
 }
 
 static void timer_config_save_cb(UNUSED_ATTR void* data) {
-  // Moving file I/O to btif context instead of timer callback because
-  // it usually takes a lot of time to be completed, introducing
+  // File I/O is done on the writer thread instead of the timer callback
+  // because it usually takes a lot of time to be completed, introducing
   // delays during A2DP playback causing blips or choppiness.
-  btif_transfer_context(btif_config_write, 0, NULL, 0, NULL);
+  std::unique_lock<std::recursive_mutex> lock(config_lock);
+  if (config_write_pending) return;
+  config_write_pending = true;
+  thread_post(config_writer_thread, config_writer_cb, NULL);
 }
 
-static void btif_config_write(UNUSED_ATTR uint16_t event,
-                              UNUSED_ATTR char* p_param) {
-  CHECK(config_timer != NULL);
+static void config_writer_cb(UNUSED_ATTR void* context) {
+  btif_config_write(true);
+}
 
-  std::unique_lock<std::recursive_mutex> lock(config_lock);
-  rename(CONFIG_FILE_PATH, CONFIG_BACKUP_PATH);
+// Writes the persistent sections to CONFIG_FILE_PATH, moving the current file
+// to CONFIG_BACKUP_PATH first if |backup| is true. Only the copy of the
+// sections is made under |config_lock|. Returns true if the file is up to
+// date.
+static bool btif_config_write(bool backup) {
+  std::lock_guard<std::mutex> write_lock(config_write_lock);
+  config_t snapshot;
+  uint64_t generation;
+
+  {
+    std::unique_lock<std::recursive_mutex> lock(config_lock);
+    uint64_t lock_start_us = time_get_os_boottime_us();
+    config_write_pending = false;
+    if (config_generation == config_saved_generation) {
+      config_stats.skipped++;
+      return true;
+    }
+    generation = config_generation;
+    snapshot = btif_config_cache.PersistentSectionCopy();
+
+    uint64_t lock_us = time_get_os_boottime_us() - lock_start_us;
+    config_stats.total_lock_us += lock_us;
+    config_stats.max_lock_us = std::max(config_stats.max_lock_us, lock_us);
+  }
 
-    config_save(btif_config_cache.PersistentSectionCopy(), CONFIG_FILE_PATH);
+  uint64_t save_start_us = time_get_os_boottime_us();
+  if (backup) rename(CONFIG_FILE_PATH, CONFIG_BACKUP_PATH);
+  bool ret = config_save(snapshot, CONFIG_FILE_PATH);
 
   if (is_common_criteria_mode()) {
     get_bluetooth_keystore_interface()->set_encrypt_key_or_remove_key(
         CONFIG_FILE_PREFIX, CONFIG_FILE_HASH);
   }
+  uint64_t save_us = time_get_os_boottime_us() - save_start_us;
+
+  std::unique_lock<std::recursive_mutex> lock(config_lock);
+  if (ret) {
+    config_saved_generation = generation;
+  } else {
+    config_stats.failures++;
+  }
+  config_stats.saves++;
+  config_stats.last_save_us = save_us;
+  config_stats.total_save_us += save_us;
+  config_stats.max_save_us = std::max(config_stats.max_save_us, save_us);
+  return ret;
 }
 
 void btif_debug_config_dump(int fd) {
@@ -694,6 +796,7 @@ void btif_debug_config_dump(int fd) {
       break;
   }
 
+  std::unique_lock<std::recursive_mutex> lock(config_lock);
   auto file_source = btif_config_cache.GetString(INFO_SECTION, FILE_SOURCE);
   if (!file_source) {
     file_source.emplace("Original");
@@ -703,6 +806,20 @@ void btif_debug_config_dump(int fd) {
   dprintf(fd, "  Devices loaded: %zu\n", devices.size());
   dprintf(fd, "  File created/tagged: %s\n", btif_config_time_created);
   dprintf(fd, "  File source: %s\n", file_source->c_str());
+
+  size_t saves = config_stats.saves;
+  dprintf(fd, "  Generation: %" PRIu64 " (saved: %" PRIu64 ")\n",
+          config_generation, config_saved_generation);
+  dprintf(fd, "  Saves: %zu (failed: %zu, skipped as unchanged: %zu)\n",
+          saves, config_stats.failures, config_stats.skipped);
+  if (saves == 0) return;
+  dprintf(fd,
+          "  Save latency: last %" PRIu64 " us, avg %" PRIu64
+          " us, max %" PRIu64 " us\n",
+          config_stats.last_save_us, config_stats.total_save_us / saves,
+          config_stats.max_save_us);
+  dprintf(fd, "  Lock hold time: avg %" PRIu64 " us, max %" PRIu64 " us\n",
+          config_stats.total_lock_us / saves, config_stats.max_lock_us);
 }
 
 static bool is_factory_reset(void) {
@@ -71,7 +71,7 @@ BtifConfigCache::~BtifConfigCache() { Clear(); }
 
 void BtifConfigCache::Clear() {
   unpaired_devices_cache_.Clear();
-  paired_devices_list_.sections.clear();
+  paired_devices_list_.Clear();
 }
 
 void BtifConfigCache::Init(std::unique_ptr<config_t> source) {
@@ -111,7 +111,7 @@ void BtifConfigCache::RemovePersistentSectionsWithKey(const std::string& key) {
   for (auto it = paired_devices_list_.sections.begin();
        it != paired_devices_list_.sections.end();) {
     if (it->Has(key)) {
-      it = paired_devices_list_.sections.erase(it);
+      it = paired_devices_list_.Erase(it);
       continue;
     }
     it++;
@@ -127,7 +127,7 @@ bool BtifConfigCache::RemoveKey(const std::string& section_name,
     if (entry_iter == section->entries.end()) {
       return false;
     }
-    section->entries.erase(entry_iter);
+    section->Erase(entry_iter);
     if (section->entries.empty()) {
       unpaired_devices_cache_.Remove(section_name);
     }
@@ -141,13 +141,13 @@ bool BtifConfigCache::RemoveKey(const std::string& section_name,
     if (entry_iter == section_iter->entries.end()) {
       return false;
     }
-    section_iter->entries.erase(entry_iter);
+    section_iter->Erase(entry_iter);
     if (section_iter->entries.empty()) {
-      paired_devices_list_.sections.erase(section_iter);
+      paired_devices_list_.Erase(section_iter);
     } else if (!has_link_key_in_section(*section_iter)) {
       // if no link key in section after removal, move it to unpaired section
       auto moved_section = std::move(*section_iter);
-      paired_devices_list_.sections.erase(section_iter);
+      paired_devices_list_.Remove(section_name);
       unpaired_devices_cache_.Put(section_name, std::move(moved_section));
     }
     return true;
@@ -202,7 +202,7 @@ void BtifConfigCache::SetString(std::string section_name, std::string key,
       }
       // when a unpaired section got the LinkKey, move this section to the
       // paired devices list
-      paired_devices_list_.sections.emplace_back(std::move(section));
+      paired_devices_list_.Append(std::move(section));
     } else {
       // update to the unpaired devices cache
       unpaired_devices_cache_.Put(section_name, section);
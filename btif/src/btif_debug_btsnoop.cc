@@ -16,17 +16,22 @@
  *
  ******************************************************************************/
 
+#include <algorithm>
+#include <deque>
 #include <mutex>
+#include <vector>
 
 #include <base/logging.h>
 #include <resolv.h>
+#include <string.h>
 #include <zlib.h>
 
 #include "btif/include/btif_debug.h"
 #include "btif/include/btif_debug_btsnoop.h"
 #include "hci/include/btsnoop_mem.h"
 #include "internal_include/bt_target.h"
-#include "osi/include/ringbuffer.h"
+#include "osi/include/osi.h"
+#include "osi/include/thread.h"
 #include "osi/include/time.h"
 
 #define REDUCE_HCI_TYPE_TO_SIGNIFICANT_BITS(type) ((type) >> 8)
@@ -36,19 +41,45 @@
 static const size_t BTSNOOP_MEM_BUFFER_SIZE = (256 * 1024);
 #endif
 
-// Block size for copying buffers (for compression/encoding etc.)
+// Packets are gathered in blocks of BLOCK_SIZE bytes. A full block is handed
+// to |seal_thread|, which compresses it on its own so that capturing never
+// waits for the compression. The oldest blocks are dropped to keep the
+// compressed blocks, the blocks waiting for compression and the open block
+// within BTSNOOP_MEM_BUFFER_SIZE.
 static const size_t BLOCK_SIZE = 16384;
 
+// Window of the compression of a block, which a whole block fits in
+static const int BLOCK_WINDOW_BITS = 14;
+
 // Maximum line length in bugreport (should be multiple of 4 for base64 output)
 static const uint8_t MAX_LINE_LENGTH = 128;
 
+// A block compressed as raw deflate data. It ends on a byte boundary and
+// without the final block flag, so that the dump can join blocks into a
+// single zlib stream.
+typedef struct {
+  std::vector<uint8_t> data;
+  uint32_t adler;         // Adler-32 of the packets of the block
+  size_t packets_length;  // Bytes of packets before compression
+} compressed_block_t;
+
 static std::mutex buffer_mutex;
-static ringbuffer_t* buffer = NULL;
+static std::deque<compressed_block_t> sealed_blocks;
+static size_t sealed_size = 0;
+// Full blocks, oldest first, not compressed yet
+static std::deque<std::vector<uint8_t>> pending_blocks;
+static size_t pending_size = 0;
+static bool seal_posted = false;
+static uint8_t open_block[BLOCK_SIZE];
+static size_t open_block_length = 0;
 static uint64_t last_timestamp_ms = 0;
 
+static thread_t* seal_thread = NULL;
+
 static size_t btsnoop_calculate_packet_length(uint16_t type,
                                               const uint8_t* data,
                                               size_t length);
+static void btsnoop_close_block();
 
 __attribute__((no_sanitize("integer")))
 static void btsnoop_cb(const uint16_t type, const uint8_t* data,
@@ -58,15 +89,14 @@ static void btsnoop_cb(const uint16_t type, const uint8_t* data,
   size_t included_length = btsnoop_calculate_packet_length(type, data, length);
   if (included_length == 0) return;
 
+  const size_t record_length = sizeof(btsnooz_header_t) + included_length;
+  if (record_length > BLOCK_SIZE) return;
+
   std::lock_guard<std::mutex> lock(buffer_mutex);
 
-  // Make room in the ring buffer
+  // Make room in the open block
 
-  while (ringbuffer_available(buffer) <
-         (included_length + sizeof(btsnooz_header_t))) {
-    ringbuffer_pop(buffer, (uint8_t*)&header, sizeof(btsnooz_header_t));
-    ringbuffer_delete(buffer, header.length - 1);
-  }
+  if (open_block_length + record_length > BLOCK_SIZE) btsnoop_close_block();
 
   // Insert data
   header.type = REDUCE_HCI_TYPE_TO_SIGNIFICANT_BITS(type);
@@ -76,8 +106,10 @@ static void btsnoop_cb(const uint16_t type, const uint8_t* data,
       last_timestamp_ms ? timestamp_us - last_timestamp_ms : 0;
   last_timestamp_ms = timestamp_us;
 
-  ringbuffer_insert(buffer, (uint8_t*)&header, sizeof(btsnooz_header_t));
-  ringbuffer_insert(buffer, data, included_length);
+  memcpy(open_block + open_block_length, &header, sizeof(btsnooz_header_t));
+  memcpy(open_block + open_block_length + sizeof(btsnooz_header_t), data,
+         included_length);
+  open_block_length += record_length;
 }
 
 static size_t btsnoop_calculate_packet_length(uint16_t type,
@@ -132,101 +164,165 @@ static size_t btsnoop_calculate_packet_length(uint16_t type,
   }
 }
 
-static bool btsnoop_compress(ringbuffer_t* rb_dst, ringbuffer_t* rb_src) {
-  CHECK(rb_dst != NULL);
-  CHECK(rb_src != NULL);
+static bool btsnoop_compress_block(const uint8_t* packets, size_t length,
+                                   compressed_block_t* block) {
+  CHECK(block != NULL);
 
   z_stream zs;
   zs.zalloc = Z_NULL;
   zs.zfree = Z_NULL;
   zs.opaque = Z_NULL;
 
-  if (deflateInit(&zs, Z_DEFAULT_COMPRESSION) != Z_OK) return false;
-
-  bool rc = true;
-  uint8_t block_src[BLOCK_SIZE];
-  uint8_t block_dst[BLOCK_SIZE];
+  if (deflateInit2(&zs, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -BLOCK_WINDOW_BITS,
+                   8, Z_DEFAULT_STRATEGY) != Z_OK)
+    return false;
+
+  // A full flush ends the data on a byte boundary without finishing the
+  // stream; the margin is for the empty stored block it adds.
+  std::vector<uint8_t> compressed(deflateBound(&zs, length) + 16);
+  zs.next_in = (Bytef*)packets;
+  zs.avail_in = length;
+  zs.next_out = compressed.data();
+  zs.avail_out = compressed.size();
+
+  int err = deflate(&zs, Z_FULL_FLUSH);
+  bool rc = (err == Z_OK && zs.avail_in == 0 && zs.avail_out != 0);
+  if (rc) {
+    block->data.assign(compressed.begin(), compressed.begin() + zs.total_out);
+    block->adler = adler32(adler32(0L, Z_NULL, 0), packets, length);
+    block->packets_length = length;
+  }
 
-  const size_t num_blocks =
-      (ringbuffer_size(rb_src) + BLOCK_SIZE - 1) / BLOCK_SIZE;
-  for (size_t i = 0; i < num_blocks; ++i) {
-    zs.avail_in =
-        ringbuffer_peek(rb_src, i * BLOCK_SIZE, block_src, BLOCK_SIZE);
-    zs.next_in = block_src;
+  deflateEnd(&zs);
+  return rc;
+}
 
-    do {
-      zs.avail_out = BLOCK_SIZE;
-      zs.next_out = block_dst;
+// Compresses the pending blocks, oldest first, on |seal_thread|.
+static void btsnoop_seal_blocks(UNUSED_ATTR void* context) {
+  std::unique_lock<std::mutex> lock(buffer_mutex);
+
+  while (!pending_blocks.empty()) {
+    // Only this thread removes pending blocks, so the oldest one stays in
+    // place while it is compressed without the lock.
+    const std::vector<uint8_t>& packets = pending_blocks.front();
+    lock.unlock();
+    compressed_block_t block;
+    bool rc = btsnoop_compress_block(packets.data(), packets.size(), &block);
+    lock.lock();
+
+    pending_size -= packets.size();
+    pending_blocks.pop_front();
+    if (!rc) {
+      LOG(ERROR) << __func__ << ": block compression failed";
+      continue;
+    }
 
-      int err = deflate(&zs, (i == num_blocks - 1) ? Z_FINISH : Z_NO_FLUSH);
-      if (err == Z_STREAM_ERROR) {
-        rc = false;
-        break;
-      }
+    while (!sealed_blocks.empty() &&
+           sealed_size + block.data.size() + pending_size >
+               BTSNOOP_MEM_BUFFER_SIZE - BLOCK_SIZE) {
+      sealed_size -= sealed_blocks.front().data.size();
+      sealed_blocks.pop_front();
+    }
 
-      const size_t length = BLOCK_SIZE - zs.avail_out;
-      ringbuffer_insert(rb_dst, block_dst, length);
-    } while (zs.avail_out == 0);
+    sealed_size += block.data.size();
+    sealed_blocks.push_back(std::move(block));
   }
 
-  deflateEnd(&zs);
-  return rc;
+  seal_posted = false;
+}
+
+// Hands the open block to |seal_thread|. Called with |buffer_mutex| held.
+static void btsnoop_close_block() {
+  if (open_block_length == 0) return;
+
+  pending_blocks.emplace_back(open_block, open_block + open_block_length);
+  pending_size += open_block_length;
+  open_block_length = 0;
+
+  // A single post at a time, the seal thread takes all the pending blocks
+  if (!seal_posted) {
+    seal_posted = thread_post(seal_thread, btsnoop_seal_blocks, NULL);
+  }
 }
 
 void btif_debug_btsnoop_init(void) {
-  if (buffer == NULL) buffer = ringbuffer_init(BTSNOOP_MEM_BUFFER_SIZE);
+  if (seal_thread == NULL) {
+    seal_thread = thread_new("btsnoop_seal");
+    if (seal_thread == NULL) {
+      LOG(ERROR) << __func__ << ": unable to create the seal thread";
+      return;
+    }
+  }
   btsnoop_mem_set_callback(btsnoop_cb);
 }
 
 void btif_debug_btsnoop_dump(int fd) {
-  ringbuffer_t* ringbuffer = ringbuffer_init(BTSNOOP_MEM_BUFFER_SIZE);
-  if (ringbuffer == NULL) {
-    dprintf(fd, "%s Unable to allocate memory for compression", __func__);
-    return;
-  }
-
-  // Prepend preamble
+  // Preamble, then a single zlib stream joining the compressed blocks
 
+  std::deque<compressed_block_t> blocks;
+  std::vector<std::vector<uint8_t>> packet_blocks;
   btsnooz_preamble_t preamble;
   preamble.version = BTSNOOZ_CURRENT_VERSION;
-  preamble.last_timestamp_ms = last_timestamp_ms;
-  ringbuffer_insert(ringbuffer, (uint8_t*)&preamble,
-                    sizeof(btsnooz_preamble_t));
-
-  // Compress data
-
-  uint8_t b64_in[3] = {0};
-  char b64_out[5] = {0};
-
-  size_t line_length = 0;
 
-  bool rc;
   {
     std::lock_guard<std::mutex> lock(buffer_mutex);
-    dprintf(fd, "--- BEGIN:BTSNOOP_LOG_SUMMARY (%zu bytes in) ---\n",
-            ringbuffer_size(buffer));
-    rc = btsnoop_compress(ringbuffer, buffer);
+    blocks = sealed_blocks;
+    packet_blocks.assign(pending_blocks.begin(), pending_blocks.end());
+    if (open_block_length != 0)
+      packet_blocks.emplace_back(open_block, open_block + open_block_length);
+    preamble.last_timestamp_ms = last_timestamp_ms;
   }
 
-  if (rc == false) {
-    dprintf(fd, "%s Log compression failed", __func__);
-    goto error;
+  // The blocks not compressed yet are compressed here, without the lock
+  for (const std::vector<uint8_t>& packets : packet_blocks) {
+    compressed_block_t block;
+    if (!btsnoop_compress_block(packets.data(), packets.size(), &block)) {
+      dprintf(fd, "%s Log compression failed", __func__);
+      return;
+    }
+    blocks.push_back(std::move(block));
   }
 
-  // Base64 encode & output
+  std::vector<uint8_t> snooz;
+  size_t packets_length = 0;
+  uint32_t adler = adler32(0L, Z_NULL, 0);
+  size_t blocks_size = 0;
+  for (const compressed_block_t& block : blocks)
+    blocks_size += block.data.size();
+
+  snooz.reserve(sizeof(btsnooz_preamble_t) + 2 + blocks_size + 6);
+  snooz.insert(snooz.end(), (uint8_t*)&preamble,
+               (uint8_t*)&preamble + sizeof(btsnooz_preamble_t));
+
+  // zlib header: deflate with a 32K window, default compression
+  snooz.push_back(0x78);
+  snooz.push_back(0x9c);
+
+  for (const compressed_block_t& block : blocks) {
+    snooz.insert(snooz.end(), block.data.begin(), block.data.end());
+    adler = adler32_combine(adler, block.adler, block.packets_length);
+    packets_length += block.packets_length;
+  }
 
-  while (ringbuffer_size(ringbuffer) > 0) {
-    size_t read = ringbuffer_pop(ringbuffer, b64_in, 3);
-    if (line_length >= MAX_LINE_LENGTH) {
-      dprintf(fd, "\n");
-      line_length = 0;
-    }
-    line_length += b64_ntop(b64_in, read, b64_out, 5);
-    dprintf(fd, "%s", b64_out);
+  // Final empty block, then the Adler-32 of all the packets
+  snooz.push_back(0x03);
+  snooz.push_back(0x00);
+  for (int shift = 24; shift >= 0; shift -= 8) {
+    snooz.push_back((adler >> shift) & 0xff);
   }
 
-  dprintf(fd, "\n--- END:BTSNOOP_LOG_SUMMARY ---\n");
+  dprintf(fd, "--- BEGIN:BTSNOOP_LOG_SUMMARY (%zu bytes in) ---\n",
+          packets_length);
 
-error:
-  ringbuffer_free(ringbuffer);
+  // Base64 encode & output, a line at a time
+
+  const size_t line_in = MAX_LINE_LENGTH / 4 * 3;
+  char line_out[MAX_LINE_LENGTH + 1];
+  for (size_t offset = 0; offset < snooz.size(); offset += line_in) {
+    size_t length = std::min(line_in, snooz.size() - offset);
+    b64_ntop(snooz.data() + offset, length, line_out, sizeof(line_out));
+    dprintf(fd, "%s%s", offset ? "\n" : "", line_out);
+  }
+
+  dprintf(fd, "\n--- END:BTSNOOP_LOG_SUMMARY ---\n");
 }
@@ -209,6 +209,14 @@ typedef struct {
   bool is_rsp_pending;
 } btif_rc_cmd_ctxt_t;
 
+/* Get Folder Items command waiting for the player, whose items are cached */
+typedef struct {
+  bool valid;
+  uint8_t scope;
+  uint32_t start_item;
+  uint32_t attr_key;
+} btif_rc_get_items_req_t;
+
 /* 2 second timeout to get interim response */
 #define BTIF_TIMEOUT_RC_INTERIM_RSP_MS (2 * 1000)
 #define BTIF_TIMEOUT_RC_STATUS_CMD_MS (2 * 1000)
@@ -289,6 +297,8 @@ typedef struct {
   uint8_t tws_earbud_state;
 #endif
   bool rc_element_attr_app_req;  /* flag to track get_element_attr req */
+  tAVRC_ITEM_CACHE* rc_item_cache;  /* folder items given by the player */
+  btif_rc_get_items_req_t rc_get_items_req;
 
 } btif_rc_device_cb_t;
 
@@ -446,6 +456,7 @@ static void btif_rc_upstreams_rsp_evt(uint16_t event,
                                       btif_rc_device_cb_t* p_dev);
 
 static void rc_start_play_status_timer(btif_rc_device_cb_t* p_dev);
+static void invalidate_item_cache(btif_rc_device_cb_t* p_dev, uint8_t scope);
 static bool absolute_volume_disabled(void);
 static bt_status_t set_volume(uint8_t volume, RawAddress*bd_addr);
 /*****************************************************************************
@@ -981,6 +992,8 @@ void handle_rc_disconnect(tBTA_AV_RC_CLOSE* p_rc_close) {
   p_dev->rc_features_processed = false;
   p_dev->rc_procedure_complete = false;
   rc_stop_play_status_timer(p_dev);
+  /* the cache stays allocated as responses from the player may still use it */
+  invalidate_item_cache(p_dev, AVRC_ITEM_CACHE_ALL_SCOPES);
   /* Check and clear the notification event list */
   if (p_dev->rc_supported_event_list != NULL) {
     list_clear(p_dev->rc_supported_event_list);
@@ -1497,6 +1510,9 @@ void btif_rc_handler(tBTA_AV_EVT event, tBTA_AV* p_data) {
       }
 
       if (btif_rc_cb.rc_multi_cb != NULL) {
+        for (int idx = 0; idx < btif_max_rc_clients; idx++) {
+          AVRC_ItemCacheFree(btif_rc_cb.rc_multi_cb[idx].rc_item_cache);
+        }
         osi_free(btif_rc_cb.rc_multi_cb);
         btif_rc_cb.rc_multi_cb = NULL;
       }
@@ -2232,6 +2248,33 @@ static void btif_rc_upstreams_evt(uint16_t event, tAVRC_COMMAND* pavrc_cmd,
                sizeof(uint32_t) * num_attr);
       }
 
+      /* Serve the items from those the player gave for earlier commands, if
+       * no other Get Folder Items command is waiting for the player. The
+       * player list is not cached as the play status of the players is part
+       * of it. */
+      uint8_t scope = pavrc_cmd->get_items.scope;
+      uint32_t attr_key = AVRC_ItemCacheAttrKey(num_attr, attr_ids);
+      bool cacheable =
+          (scope != AVRC_SCOPE_PLAYER_LIST &&
+           p_dev->rc_pdu_info[IDX_GET_FOLDER_ITEMS_RSP].size == 0);
+      if (cacheable) {
+        BT_HDR* p_msg = NULL;
+        if (AVRC_ItemCacheBldRsp(p_dev->rc_item_cache, p_dev->rc_handle, scope,
+                                 attr_key, pavrc_cmd->get_items.start_item,
+                                 pavrc_cmd->get_items.end_item, &p_msg)) {
+          BTA_AvMetaRsp(p_dev->rc_handle, label,
+                        get_rsp_type_code(AVRC_STS_NO_ERROR, ctype), p_msg);
+          return;
+        }
+        if (p_dev->rc_item_cache == NULL)
+          p_dev->rc_item_cache = AVRC_ItemCacheNew();
+      }
+
+      p_dev->rc_get_items_req.valid = cacheable;
+      p_dev->rc_get_items_req.scope = scope;
+      p_dev->rc_get_items_req.start_item = pavrc_cmd->get_items.start_item;
+      p_dev->rc_get_items_req.attr_key = attr_key;
+
       fill_pdu_queue(IDX_GET_FOLDER_ITEMS_RSP, ctype, label, true, p_dev, pavrc_cmd->pdu);
       HAL_CBACK(bt_rc_callbacks, get_folder_items_cb,
                 pavrc_cmd->get_items.scope, pavrc_cmd->get_items.start_item,
@@ -2239,12 +2282,14 @@ static void btif_rc_upstreams_evt(uint16_t event, tAVRC_COMMAND* pavrc_cmd,
     } break;
 
     case AVRC_PDU_SET_ADDRESSED_PLAYER: {
+      invalidate_item_cache(p_dev, AVRC_ITEM_CACHE_ALL_SCOPES);
       fill_pdu_queue(IDX_SET_ADDR_PLAYER_RSP, ctype, label, true, p_dev, pavrc_cmd->pdu);
       HAL_CBACK(bt_rc_callbacks, set_addressed_player_cb,
                 pavrc_cmd->addr_player.player_id, &rc_addr);
     } break;
 
     case AVRC_PDU_SET_BROWSED_PLAYER: {
+      invalidate_item_cache(p_dev, AVRC_ITEM_CACHE_ALL_SCOPES);
       fill_pdu_queue(IDX_SET_BROWSED_PLAYER_RSP, ctype, label, true, p_dev, pavrc_cmd->pdu);
       HAL_CBACK(bt_rc_callbacks, set_browsed_player_cb,
                 pavrc_cmd->br_player.player_id, &rc_addr);
@@ -2281,12 +2326,14 @@ static void btif_rc_upstreams_evt(uint16_t event, tAVRC_COMMAND* pavrc_cmd,
     } break;
 
     case AVRC_PDU_CHANGE_PATH: {
+      invalidate_item_cache(p_dev, AVRC_SCOPE_FILE_SYSTEM);
       fill_pdu_queue(IDX_CHG_PATH_RSP, ctype, label, true, p_dev, pavrc_cmd->pdu);
       HAL_CBACK(bt_rc_callbacks, change_path_cb, pavrc_cmd->chg_path.direction,
                 pavrc_cmd->chg_path.folder_uid, &rc_addr);
     } break;
 
     case AVRC_PDU_SEARCH: {
+      invalidate_item_cache(p_dev, AVRC_SCOPE_SEARCH);
       fill_pdu_queue(IDX_SEARCH_RSP, ctype, label, true, p_dev, pavrc_cmd->pdu);
       HAL_CBACK(bt_rc_callbacks, search_cb, pavrc_cmd->search.string.charset_id,
                 pavrc_cmd->search.string.str_len,
@@ -2963,6 +3010,56 @@ static bt_status_t get_element_attr_rsp(RawAddress* bd_addr, uint8_t num_attr,
   return BT_STATUS_SUCCESS;
 }
 
+/***************************************************************************
+ *
+ * Function         invalidate_item_cache
+ *
+ * Description      Drop the folder items cached for scope, or for all scopes,
+ *                  of a device. The items the player gives for a pending Get
+ *                  Folder Items command of that scope are not cached either,
+ *                  as they may have been listed before the change.
+ *
+ * Returns          void
+ *
+ **************************************************************************/
+static void invalidate_item_cache(btif_rc_device_cb_t* p_dev, uint8_t scope) {
+  AVRC_ItemCacheInvalidate(p_dev->rc_item_cache, scope);
+  if (scope == AVRC_ITEM_CACHE_ALL_SCOPES ||
+      scope == p_dev->rc_get_items_req.scope)
+    p_dev->rc_get_items_req.valid = false;
+}
+
+/***************************************************************************
+ *
+ * Function         invalidate_item_caches
+ *
+ * Description      Drop the folder items cached for the devices when the
+ *                  player notifies a change of them.
+ *
+ * Returns          void
+ *
+ **************************************************************************/
+static void invalidate_item_caches(btrc_event_id_t event_id) {
+  uint8_t scope;
+
+  switch (event_id) {
+    case BTRC_EVT_NOW_PLAYING_CONTENT_CHANGED:
+      scope = AVRC_SCOPE_NOW_PLAYING;
+      break;
+    case BTRC_EVT_UIDS_CHANGED:
+    case BTRC_EVT_ADDR_PLAYER_CHANGE:
+      scope = AVRC_ITEM_CACHE_ALL_SCOPES;
+      break;
+    default:
+      return;
+  }
+
+  std::unique_lock<std::mutex> lock(btif_rc_cb.lock);
+  if (btif_rc_cb.rc_multi_cb == NULL) return;
+  for (int idx = 0; idx < btif_max_rc_clients; idx++)
+    invalidate_item_cache(&btif_rc_cb.rc_multi_cb[idx], scope);
+}
+
 /***************************************************************************
  *
  * Function         register_notification_rsp_sho_mcast
@@ -3111,6 +3208,7 @@ static bt_status_t register_notification_rsp(
 
   BTIF_TRACE_IMP("%s: isShoMcastEnabled: %d", __func__, isShoMcastEnabled);
 
+  invalidate_item_caches(event_id);
   if (isShoMcastEnabled == true) {
     return(register_notification_rsp_sho_mcast(event_id,
                                                type,
@@ -3261,6 +3359,8 @@ static bt_status_t get_folder_items_list_rsp(RawAddress* bd_addr,
   btif_rc_device_cb_t* p_dev = btif_rc_get_device_by_bda(bd_addr);
   btrc_folder_items_t* cur_item = NULL;
   int rsp_index = IDX_GET_FOLDER_ITEMS_RSP;
+  bool cache_items = false;
+  bool rsp_full = false;
   if (p_dev == NULL) {
     BTIF_TRACE_ERROR("%s: p_dev is NULL", __func__);
     return BT_STATUS_FAIL;
@@ -3293,6 +3393,9 @@ static bt_status_t get_folder_items_list_rsp(RawAddress* bd_addr,
   } else {
     avrc_rsp.get_items.uid_counter = uid_counter;
     avrc_rsp.get_items.item_count = 1;
+    /* Only the items of database aware players are cached: their UID
+     * counter changes along with the items */
+    cache_items = p_dev->rc_get_items_req.valid && uid_counter != 0;
 
     /* create single item and build response iteratively for all num_items */
     for (item_cnt = 0; item_cnt < num_items; item_cnt++) {
@@ -3360,10 +3463,21 @@ static bt_status_t get_folder_items_list_rsp(RawAddress* bd_addr,
        */
       if (status != AVRC_STS_NO_ERROR) {
         /* Reject response due to error occured for unknown item_type, break the
-         * loop */
+         * loop. The response is sent as is if it was full before the item. */
+        if (rsp_full) status = AVRC_STS_NO_ERROR;
         break;
       }
 
+      if (cache_items) {
+        AVRC_ItemCacheStore(p_dev->rc_item_cache,
+                            p_dev->rc_get_items_req.scope,
+                            p_dev->rc_get_items_req.attr_key, uid_counter,
+                            p_dev->rc_get_items_req.start_item + item_cnt,
+                            &item);
+      }
+      /* the response is full, the rest of the items are only cached */
+      if (rsp_full) continue;
+
       int len_before = p_msg ? p_msg->len : 0;
       BTIF_TRACE_DEBUG("%s: item_cnt: %d len: %d", __func__, item_cnt,
                        len_before);
@@ -3371,11 +3485,15 @@ static bt_status_t get_folder_items_list_rsp(RawAddress* bd_addr,
       BTIF_TRACE_DEBUG("%s: Build rsp status: %d len: %d", __func__, status,
                        (p_msg ? p_msg->len : 0));
       int len_after = p_msg ? p_msg->len : 0;
-      if (status != AVRC_STS_NO_ERROR || len_before == len_after) {
-        /* Error occured in build response or we ran out of buffer so break the
-         * loop */
+      if (status != AVRC_STS_NO_ERROR) {
+        /* Error occured in build response so break the loop */
         break;
       }
+      if (len_before == len_after) {
+        /* We ran out of buffer, keep going only to cache the other items */
+        if (!cache_items) break;
+        rsp_full = true;
+      }
     }
 
     /* setting the error status */
@@ -3403,6 +3521,7 @@ static bt_status_t get_folder_items_list_rsp(RawAddress* bd_addr,
   p_dev->rc_pdu_info[rsp_index].label[front_index] = 0;
   if (p_dev->rc_pdu_info[rsp_index].size == 0)
     p_dev->rc_pdu_info[rsp_index].is_rsp_pending = false;
+  p_dev->rc_get_items_req.valid = false;
 
   return status == AVRC_STS_NO_ERROR ? BT_STATUS_SUCCESS : BT_STATUS_FAIL;
 }
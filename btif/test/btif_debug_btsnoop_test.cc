@@ -0,0 +1,248 @@
+/******************************************************************************
+ * Copyright (c) 2026 Qualcomm Innovation Center, Inc. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ *
+ *******************************************************************************/
+
+#include <gtest/gtest.h>
+#include <stdio.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <string>
+#include <thread>
+
+#include "btif/src/btif_debug_btsnoop.cc"
+
+/* Below are methods that must be implemented if we don't want to compile the
+ * whole stack. */
+void btsnoop_mem_set_callback(btsnoop_data_cb cb) {}
+
+namespace {
+
+// What the dump gives: the bytes in it reports and the decoded snooz data
+struct Dump {
+  size_t packets_length;
+  std::vector<uint8_t> snooz;
+};
+
+// The records the dump should hold, in the order they were captured
+std::vector<uint8_t> records;
+uint64_t last_capture_us;
+
+}  // namespace
+
+class BtifDebugBtsnoopTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    btif_debug_btsnoop_init();
+    WaitSealed();
+
+    std::lock_guard<std::mutex> lock(buffer_mutex);
+    sealed_blocks.clear();
+    sealed_size = 0;
+    open_block_length = 0;
+    last_timestamp_ms = 0;
+    records.clear();
+    last_capture_us = 0;
+  }
+
+  // Captures |count| HCI events of varying length and content, the way
+  // btsnoop_mem_capture() gives them.
+  static void Capture(int count) {
+    for (int i = 0; i < count; i++) {
+      uint8_t event[64];
+      size_t length = 3 + rand() % (sizeof(event) - 3);
+      event[0] = 0x0e;
+      event[1] = length - 2;
+      for (size_t j = 2; j < length; j++)
+        event[j] = (rand() % 4 == 0) ? rand() : (uint8_t)j;
+      uint64_t timestamp_us = last_capture_us + rand() % 5000;
+
+      btsnooz_header_t header;
+      header.type = REDUCE_HCI_TYPE_TO_SIGNIFICANT_BITS(BT_EVT_TO_BTU_HCI_EVT);
+      header.length = length + 1;
+      header.packet_length = length + 1;
+      header.delta_time_ms =
+          last_capture_us ? timestamp_us - last_capture_us : 0;
+      records.insert(records.end(), (uint8_t*)&header,
+                     (uint8_t*)&header + sizeof(header));
+      records.insert(records.end(), event, event + length);
+
+      btsnoop_cb(BT_EVT_TO_BTU_HCI_EVT, event, length, timestamp_us);
+      last_capture_us = timestamp_us;
+    }
+  }
+
+  static void WaitSealed() {
+    for (;;) {
+      {
+        std::lock_guard<std::mutex> lock(buffer_mutex);
+        if (pending_blocks.empty() && !seal_posted) return;
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+  }
+
+  static size_t PendingBlocks() {
+    std::lock_guard<std::mutex> lock(buffer_mutex);
+    return pending_blocks.size();
+  }
+
+  // Dumps the log and decodes the base64 lines of the dump
+  static Dump DumpLog() {
+    Dump dump = {0, {}};
+    FILE* file = tmpfile();
+    EXPECT_NE(file, nullptr);
+    btif_debug_btsnoop_dump(fileno(file));
+    rewind(file);
+
+    char line[256];
+    std::string encoded;
+    EXPECT_NE(fgets(line, sizeof(line), file), nullptr);
+    EXPECT_EQ(1,
+              sscanf(line, "--- BEGIN:BTSNOOP_LOG_SUMMARY (%zu bytes in) ---",
+                     &dump.packets_length));
+    while (fgets(line, sizeof(line), file) != nullptr) {
+      if (strncmp(line, "--- END:", 8) == 0) break;
+      encoded.append(line, strcspn(line, "\n"));
+    }
+    fclose(file);
+
+    dump.snooz.resize(encoded.size());
+    int length =
+        b64_pton(encoded.c_str(), dump.snooz.data(), dump.snooz.size());
+    EXPECT_GE(length, 0);
+    dump.snooz.resize(length < 0 ? 0 : length);
+    return dump;
+  }
+
+  // Inflates the zlib stream of the dump, which inflate() only ends if the
+  // Adler-32 at its end matches the inflated data.
+  static std::vector<uint8_t> Inflate(const Dump& dump) {
+    std::vector<uint8_t> packets;
+    const size_t preamble_size = sizeof(btsnooz_preamble_t);
+    EXPECT_GE(dump.snooz.size(), preamble_size + 2 + 6);
+    if (dump.snooz.size() < preamble_size + 2 + 6) return packets;
+
+    const btsnooz_preamble_t* preamble =
+        (const btsnooz_preamble_t*)dump.snooz.data();
+    EXPECT_EQ(preamble->version, BTSNOOZ_CURRENT_VERSION);
+    EXPECT_EQ(preamble->last_timestamp_ms, last_capture_us);
+
+    z_stream zs;
+    memset(&zs, 0, sizeof(zs));
+    EXPECT_EQ(inflateInit(&zs), Z_OK);
+    zs.next_in = (Bytef*)dump.snooz.data() + preamble_size;
+    zs.avail_in = dump.snooz.size() - preamble_size;
+
+    int err;
+    do {
+      uint8_t out[4096];
+      zs.next_out = out;
+      zs.avail_out = sizeof(out);
+      err = inflate(&zs, Z_NO_FLUSH);
+      packets.insert(packets.end(), out, out + sizeof(out) - zs.avail_out);
+    } while (err == Z_OK);
+    EXPECT_EQ(err, Z_STREAM_END) << zs.msg;
+    EXPECT_EQ(zs.avail_in, 0u);
+    inflateEnd(&zs);
+    return packets;
+  }
+
+  // Checks that the stream ends with the final empty block and the Adler-32
+  // combined from the blocks, and that nothing before ends it.
+  static void ExpectStreamEnd(const Dump& dump,
+                              const std::vector<uint8_t>& packets) {
+    const std::vector<uint8_t>& snooz = dump.snooz;
+    ASSERT_GE(snooz.size(), sizeof(btsnooz_preamble_t) + 2 + 6);
+    const uint8_t* end = snooz.data() + snooz.size() - 6;
+    EXPECT_EQ(end[0], 0x03);
+    EXPECT_EQ(end[1], 0x00);
+
+    uint32_t adler = adler32(adler32(0L, Z_NULL, 0), packets.data(),
+                             packets.size());
+    EXPECT_EQ(end[2], (adler >> 24) & 0xff);
+    EXPECT_EQ(end[3], (adler >> 16) & 0xff);
+    EXPECT_EQ(end[4], (adler >> 8) & 0xff);
+    EXPECT_EQ(end[5], adler & 0xff);
+
+    z_stream zs;
+    memset(&zs, 0, sizeof(zs));
+    ASSERT_EQ(inflateInit(&zs), Z_OK);
+    zs.next_in = (Bytef*)snooz.data() + sizeof(btsnooz_preamble_t);
+    zs.avail_in = end - zs.next_in;
+    int err;
+    do {
+      uint8_t out[4096];
+      zs.next_out = out;
+      zs.avail_out = sizeof(out);
+      err = inflate(&zs, Z_NO_FLUSH);
+    } while (err == Z_OK && zs.avail_in != 0);
+    EXPECT_TRUE(err == Z_OK || err == Z_BUF_ERROR);
+    inflateEnd(&zs);
+  }
+};
+
+TEST_F(BtifDebugBtsnoopTest, test_dump_empty_log) {
+  Dump dump = DumpLog();
+  std::vector<uint8_t> packets = Inflate(dump);
+
+  EXPECT_EQ(dump.packets_length, 0u);
+  EXPECT_TRUE(packets.empty());
+  ExpectStreamEnd(dump, packets);
+}
+
+TEST_F(BtifDebugBtsnoopTest, test_dump_open_block) {
+  Capture(50);
+  ASSERT_EQ(PendingBlocks(), 0u);
+
+  Dump dump = DumpLog();
+  std::vector<uint8_t> packets = Inflate(dump);
+
+  EXPECT_EQ(dump.packets_length, records.size());
+  EXPECT_EQ(packets, records);
+  ExpectStreamEnd(dump, packets);
+}
+
+// The blocks are joined in order whether they were compressed by the seal
+// thread or, when it has not got to them yet, by the dump.
+TEST_F(BtifDebugBtsnoopTest, test_dump_joins_blocks) {
+  Capture(3000);
+
+  Dump dump = DumpLog();
+  std::vector<uint8_t> packets = Inflate(dump);
+  EXPECT_GT(records.size(), 4 * BLOCK_SIZE);
+  EXPECT_EQ(dump.packets_length, records.size());
+  EXPECT_EQ(packets, records);
+  ExpectStreamEnd(dump, packets);
+
+  WaitSealed();
+  Dump sealed_dump = DumpLog();
+  EXPECT_EQ(Inflate(sealed_dump), records);
+  ExpectStreamEnd(sealed_dump, records);
+}
+
+// The oldest blocks are dropped, and the dump starts at the first packet of
+// the oldest block kept.
+TEST_F(BtifDebugBtsnoopTest, test_oldest_blocks_dropped) {
+  for (int i = 0; i < 100; i++) {
+    Capture(1000);
+    WaitSealed();
+  }
+
+  Dump dump = DumpLog();
+  std::vector<uint8_t> packets = Inflate(dump);
+  ASSERT_LT(packets.size(), records.size());
+  EXPECT_GT(packets.size(), BTSNOOP_MEM_BUFFER_SIZE);
+  EXPECT_LE(dump.snooz.size(), BTSNOOP_MEM_BUFFER_SIZE);
+  EXPECT_EQ(dump.packets_length, packets.size());
+  EXPECT_TRUE(std::equal(packets.begin(), packets.end(),
+                         records.end() - packets.size()));
+  ExpectStreamEnd(dump, packets);
+
+  const btsnooz_header_t* first = (const btsnooz_header_t*)packets.data();
+  EXPECT_EQ(first->type,
+            REDUCE_HCI_TYPE_TO_SIGNIFICANT_BITS(BT_EVT_TO_BTU_HCI_EVT));
+  EXPECT_EQ(packets[sizeof(btsnooz_header_t)], 0x0e);
+}
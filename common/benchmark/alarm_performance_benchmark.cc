@@ -0,0 +1,115 @@
+/******************************************************************************
+ * Copyright (c) 2026 Qualcomm Innovation Center, Inc. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ *
+ *******************************************************************************/
+
+#include <base/logging.h>
+#include <base/message_loop/message_loop.h>
+#include <benchmark/benchmark.h>
+#include <string>
+#include <vector>
+
+#include "osi/include/alarm.h"
+#include "osi/include/osi.h"
+
+using ::benchmark::State;
+
+// Long enough that none of the armed alarms fire while the benchmark runs,
+// and that no wakelock is taken for them.
+#define BASE_INTERVAL_MS 600000
+#define INTERVAL_SPREAD_MS 60000
+
+base::MessageLoop* get_message_loop() { return nullptr; }
+
+static void never_called_cb(UNUSED_ATTR void* data) {
+  LOG(FATAL) << "alarm fired during benchmark";
+}
+
+// Keeps |state.range(1)| alarms armed with scattered deadlines using the
+// pending alarms backend given by |state.range(0)|.
+class BM_Alarm : public ::benchmark::Fixture {
+ protected:
+  void SetUp(State& st) override {
+    benchmark::Fixture::SetUp(st);
+    alarm_set_backend(static_cast<alarm_backend_t>(st.range(0)));
+    for (int64_t i = 0; i < st.range(1); i++) {
+      alarms_.push_back(
+          alarm_new(("alarm_benchmark[" + std::to_string(i) + "]").c_str()));
+      alarm_set(alarms_.back(), next_interval_ms(), never_called_cb, nullptr);
+    }
+  }
+
+  void TearDown(State& st) override {
+    for (alarm_t* alarm : alarms_) alarm_free(alarm);
+    alarms_.clear();
+    alarm_cleanup();
+    alarm_set_backend(ALARM_BACKEND_HEAP);
+    benchmark::Fixture::TearDown(st);
+  }
+
+  // Cheap deterministic pseudo-random spread of deadlines.
+  period_ms_t next_interval_ms() {
+    seed_ = seed_ * 1103515245 + 12345;
+    return BASE_INTERVAL_MS + (seed_ >> 16) % INTERVAL_SPREAD_MS;
+  }
+
+  std::vector<alarm_t*> alarms_;
+  uint32_t seed_ = 1;
+};
+
+// Re-arming an already armed alarm: a cancel plus an insert of the pending
+// alarm, which is what L2CAP/GATT/AVDTP timers do on every packet.
+BENCHMARK_DEFINE_F(BM_Alarm, rearm)(State& state) {
+  size_t next = 0;
+  for (auto _ : state) {
+    alarm_set(alarms_[next], next_interval_ms(), never_called_cb, nullptr);
+    next = (next + 1) % alarms_.size();
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+// Canceling an armed alarm and arming it again.
+BENCHMARK_DEFINE_F(BM_Alarm, cancel_and_set)(State& state) {
+  size_t next = 0;
+  for (auto _ : state) {
+    alarm_cancel(alarms_[next]);
+    alarm_set(alarms_[next], next_interval_ms(), never_called_cb, nullptr);
+    next = (next + 1) % alarms_.size();
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+// Arms a fresh alarm on top of the already armed ones, then cancels it.
+BENCHMARK_DEFINE_F(BM_Alarm, set_and_cancel_extra)(State& state) {
+  alarm_t* extra = alarm_new("alarm_benchmark.extra");
+  for (auto _ : state) {
+    alarm_set(extra, next_interval_ms(), never_called_cb, nullptr);
+    alarm_cancel(extra);
+  }
+  alarm_free(extra);
+  state.SetItemsProcessed(state.iterations());
+}
+
+#define ALARM_BENCHMARK_ARGS(name)                                   \
+  BENCHMARK_REGISTER_F(BM_Alarm, name)                               \
+      ->Args({ALARM_BACKEND_SORTED_LIST, 100})                       \
+      ->Args({ALARM_BACKEND_HEAP, 100})                              \
+      ->Args({ALARM_BACKEND_SORTED_LIST, 10000})                     \
+      ->Args({ALARM_BACKEND_HEAP, 10000})
+
+ALARM_BENCHMARK_ARGS(rearm);
+ALARM_BENCHMARK_ARGS(cancel_and_set);
+ALARM_BENCHMARK_ARGS(set_and_cancel_extra);
+
+int main(int argc, char** argv) {
+  // Disable LOG() output from libchrome
+  logging::LoggingSettings log_settings;
+  log_settings.logging_dest = logging::LoggingDestination::LOG_NONE;
+  CHECK(logging::InitLogging(log_settings)) << "Failed to set up logging";
+  ::benchmark::Initialize(&argc, argv);
+  if (::benchmark::ReportUnrecognizedArguments(argc, argv)) {
+    return 1;
+  }
+  ::benchmark::RunSpecifiedBenchmarks();
+}
@@ -0,0 +1,119 @@
+/******************************************************************************
+ * Copyright (c) 2026 Qualcomm Innovation Center, Inc. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ *
+ *******************************************************************************/
+
+#include <base/logging.h>
+#include <benchmark/benchmark.h>
+#include <string.h>
+#include <thread>
+
+#include "osi/include/allocator.h"
+#include "osi/include/buffer_pool.h"
+#include "osi/include/fixed_queue.h"
+
+using ::benchmark::State;
+
+enum { BUFFER_SOURCE_HEAP = 0, BUFFER_SOURCE_POOL = 1 };
+
+// Sizes of an HCI event, a command buffer, a DH5 ACL fragment and a
+// BT_DEFAULT_BUFFER_SIZE buffer, each including the BT_HDR header.
+#define EVENT_BUFFER_SIZE 265
+#define SMALL_BUFFER_SIZE 660
+#define ACL_BUFFER_SIZE 1036
+#define DEFAULT_BUFFER_SIZE 4112
+
+// Number of buffers held at once by the burst benchmark, roughly one full
+// controller ACL buffer window.
+#define BURST_SIZE 64
+#define QUEUE_CAPACITY 256
+
+// Mirrors the classes set up by hci/src/buffer_allocator.cc.
+static const buffer_pool_class_t benchmark_classes[] = {
+    {EVENT_BUFFER_SIZE, 64},
+    {SMALL_BUFFER_SIZE, 64},
+    {ACL_BUFFER_SIZE, 128},
+    {DEFAULT_BUFFER_SIZE, 32},
+};
+
+static void* buffer_get(int64_t source, size_t size) {
+  void* buffer = (source == BUFFER_SOURCE_POOL) ? osi_pool_malloc(size)
+                                                : osi_malloc(size);
+  // Touch the header like the HCI layer does when filling in a BT_HDR.
+  memset(buffer, 0, 8);
+  return buffer;
+}
+
+// Allocates and frees one buffer of |state.range(1)| octets per iteration.
+static void BM_AllocFree(State& state) {
+  int64_t source = state.range(0);
+  size_t size = state.range(1);
+  for (auto _ : state) {
+    void* buffer = buffer_get(source, size);
+    benchmark::DoNotOptimize(buffer);
+    osi_free(buffer);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+// Holds a burst of buffers before releasing them, as happens while a window
+// of ACL packets is in flight.
+static void BM_AllocFreeBurst(State& state) {
+  int64_t source = state.range(0);
+  size_t size = state.range(1);
+  void* buffers[BURST_SIZE];
+  for (auto _ : state) {
+    for (size_t i = 0; i < BURST_SIZE; i++) buffers[i] = buffer_get(source, size);
+    for (size_t i = 0; i < BURST_SIZE; i++) osi_free(buffers[i]);
+  }
+  state.SetItemsProcessed(state.iterations() * BURST_SIZE);
+}
+
+// Buffers allocated on one thread and freed on another, like HCI reader to
+// stack thread hand-off.
+static void BM_CrossThread(State& state) {
+  int64_t source = state.range(0);
+  size_t size = state.range(1);
+  fixed_queue_t* queue = fixed_queue_new(QUEUE_CAPACITY, FIXED_QUEUE_MODE_RING);
+
+  for (auto _ : state) {
+    std::thread consumer([queue]() {
+      for (size_t i = 0; i < QUEUE_CAPACITY * 16; i++)
+        osi_free(fixed_queue_dequeue(queue));
+    });
+    for (size_t i = 0; i < QUEUE_CAPACITY * 16; i++)
+      fixed_queue_enqueue(queue, buffer_get(source, size));
+    consumer.join();
+  }
+
+  fixed_queue_free(queue, osi_free);
+  state.SetItemsProcessed(state.iterations() * QUEUE_CAPACITY * 16);
+}
+
+#define BUFFER_BENCHMARK_ARGS(name)                      \
+  BENCHMARK(name)                                        \
+      ->Args({BUFFER_SOURCE_HEAP, EVENT_BUFFER_SIZE})    \
+      ->Args({BUFFER_SOURCE_POOL, EVENT_BUFFER_SIZE})    \
+      ->Args({BUFFER_SOURCE_HEAP, ACL_BUFFER_SIZE})      \
+      ->Args({BUFFER_SOURCE_POOL, ACL_BUFFER_SIZE})      \
+      ->Args({BUFFER_SOURCE_HEAP, DEFAULT_BUFFER_SIZE})  \
+      ->Args({BUFFER_SOURCE_POOL, DEFAULT_BUFFER_SIZE})
+
+BUFFER_BENCHMARK_ARGS(BM_AllocFree);
+BUFFER_BENCHMARK_ARGS(BM_AllocFreeBurst);
+BUFFER_BENCHMARK_ARGS(BM_CrossThread)->UseRealTime();
+
+int main(int argc, char** argv) {
+  // Disable LOG() output from libchrome
+  logging::LoggingSettings log_settings;
+  log_settings.logging_dest = logging::LoggingDestination::LOG_NONE;
+  CHECK(logging::InitLogging(log_settings)) << "Failed to set up logging";
+  CHECK(buffer_pool_init(benchmark_classes, sizeof(benchmark_classes) /
+                                                sizeof(benchmark_classes[0])));
+  ::benchmark::Initialize(&argc, argv);
+  if (::benchmark::ReportUnrecognizedArguments(argc, argv)) {
+    return 1;
+  }
+  ::benchmark::RunSpecifiedBenchmarks();
+}
@@ -21,6 +21,7 @@
 #include <benchmark/benchmark.h>
 #include <memory>
 #include <thread>
+#include <vector>
 
 #include "common/execution_barrier.h"
 #include "common/message_loop_thread.h"
@@ -32,6 +33,7 @@ using bluetooth::common::ExecutionBarrier;
 using bluetooth::common::MessageLoopThread;
 
 #define NUM_MESSAGES_TO_SEND 100000
+#define RING_QUEUE_CAPACITY 1024
 
 volatile static int g_counter = 0;
 static std::unique_ptr<ExecutionBarrier> g_counter_barrier = nullptr;
@@ -308,6 +310,95 @@ BENCHMARK_F(BM_OsiReactorThread, sequential_execution_using_reactor)
   }
 };
 
+// Same as BM_OsiReactorThread, but the work queue is a lock-free ring that
+// only signals its dequeue fd on the empty -> non-empty transition.
+class BM_OsiReactorThreadRingQueue : public BM_OsiReactorThread {
+ protected:
+  void SetUp(State& st) override {
+    BM_OsiReactorThread::SetUp(st);
+    fixed_queue_free(bt_msg_queue_, nullptr);
+    bt_msg_queue_ = fixed_queue_new(RING_QUEUE_CAPACITY, FIXED_QUEUE_MODE_RING);
+  }
+};
+
+BENCHMARK_F(BM_OsiReactorThreadRingQueue, batch_enque_dequeue_using_reactor)
+(State& state) {
+  fixed_queue_register_dequeue(bt_msg_queue_, thread_get_reactor(thread_),
+                               callback_batch, nullptr);
+  for (auto _ : state) {
+    g_counter = 0;
+    g_counter_barrier = std::make_unique<ExecutionBarrier>();
+    for (int i = 0; i < NUM_MESSAGES_TO_SEND; i++) {
+      fixed_queue_enqueue(bt_msg_queue_, (void*)&g_counter);
+    }
+    g_counter_barrier->WaitForExecution();
+  }
+  state.SetItemsProcessed(state.iterations() * NUM_MESSAGES_TO_SEND);
+};
+
+BENCHMARK_F(BM_OsiReactorThreadRingQueue, sequential_execution_using_reactor)
+(State& state) {
+  fixed_queue_register_dequeue(bt_msg_queue_, thread_get_reactor(thread_),
+                               callback_sequential_queue, nullptr);
+  for (auto _ : state) {
+    for (int i = 0; i < NUM_MESSAGES_TO_SEND; i++) {
+      g_counter_barrier = std::make_unique<ExecutionBarrier>();
+      fixed_queue_enqueue(bt_msg_queue_, (void*)&g_counter);
+      g_counter_barrier->WaitForExecution();
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * NUM_MESSAGES_TO_SEND);
+};
+
+// Raw enqueue/dequeue throughput of a single fixed_queue_t, without any
+// thread hand-off. The benchmark argument is the fixed_queue_mode_t.
+static void BM_FixedQueueEnqueueDequeue(State& state) {
+  fixed_queue_t* queue = fixed_queue_new(
+      RING_QUEUE_CAPACITY, static_cast<fixed_queue_mode_t>(state.range(0)));
+  for (auto _ : state) {
+    for (int i = 0; i < RING_QUEUE_CAPACITY; i++) {
+      fixed_queue_enqueue(queue, (void*)&g_counter);
+    }
+    for (int i = 0; i < RING_QUEUE_CAPACITY; i++) {
+      benchmark::DoNotOptimize(fixed_queue_dequeue(queue));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * RING_QUEUE_CAPACITY);
+  fixed_queue_free(queue, nullptr);
+}
+BENCHMARK(BM_FixedQueueEnqueueDequeue)
+    ->Arg(FIXED_QUEUE_MODE_LIST)
+    ->Arg(FIXED_QUEUE_MODE_RING);
+
+// Several producers feeding one consumer through a fixed_queue_t, which is
+// how thread_post() and the A2DP tx queue use it. The benchmark argument is
+// the fixed_queue_mode_t.
+static void BM_FixedQueueMultiProducer(State& state) {
+  static const int kNumProducers = 4;
+  fixed_queue_t* queue = fixed_queue_new(
+      RING_QUEUE_CAPACITY, static_cast<fixed_queue_mode_t>(state.range(0)));
+  for (auto _ : state) {
+    std::vector<std::thread> producers;
+    for (int i = 0; i < kNumProducers; i++) {
+      producers.emplace_back([queue]() {
+        for (int j = 0; j < NUM_MESSAGES_TO_SEND / kNumProducers; j++) {
+          fixed_queue_enqueue(queue, (void*)&g_counter);
+        }
+      });
+    }
+    for (int i = 0; i < NUM_MESSAGES_TO_SEND; i++) {
+      benchmark::DoNotOptimize(fixed_queue_dequeue(queue));
+    }
+    for (auto& producer : producers) producer.join();
+  }
+  state.SetItemsProcessed(state.iterations() * NUM_MESSAGES_TO_SEND);
+  fixed_queue_free(queue, nullptr);
+}
+BENCHMARK(BM_FixedQueueMultiProducer)
+    ->Arg(FIXED_QUEUE_MODE_LIST)
+    ->Arg(FIXED_QUEUE_MODE_RING)
+    ->UseRealTime();
+
 class BM_MessageLooopThread : public BM_ThreadPerformance {
  protected:
   void SetUp(State& st) override {
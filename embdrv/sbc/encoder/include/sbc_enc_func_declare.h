@@ -48,6 +48,38 @@ extern void SbcAnalysisFilter8(SBC_ENC_PARAMS* strEncParams, int16_t* input);
 extern void SBC_FastIDCT8(int32_t* pInVect, int32_t* pOutVect);
 extern void SBC_FastIDCT4(int32_t* x0, int32_t* pOutVect);
 
+/* The analysis filter runs its windowing and its DCT through these kernels
+ * in the configuration SBC_SIMD_OPT applies to */
+#if (SBC_SIMD_OPT == TRUE && SBC_ARM_ASM_OPT == FALSE &&  \
+     SBC_IPAQ_OPT == TRUE && SBC_FAST_DCT == TRUE &&       \
+     SBC_IS_64_MULT_IN_WINDOW_ACCU == FALSE && SBC_IS_64_MULT_IN_IDCT == FALSE)
+#define SBC_ANALYSIS_KERNELS TRUE
+#else
+#define SBC_ANALYSIS_KERNELS FALSE
+#endif
+
+#if (SBC_ANALYSIS_KERNELS == TRUE)
+typedef struct {
+  /* Compute the 2 * M DCT inputs of one block of one channel from the 10 * M
+   * samples at |x|, M being the number of subbands */
+  void (*window4)(const int16_t* x, int32_t* y);
+  void (*window8)(const int16_t* x, int32_t* y);
+  /* Compute the M outputs of |count| DCTs whose 2 * M inputs follow each
+   * other at |y| */
+  void (*dct4)(const int32_t* y, int32_t* out, int32_t count);
+  void (*dct8)(const int32_t* y, int32_t* out, int32_t count);
+} tSBC_ANALYSIS_KERNELS;
+
+/* Window coefficients as 5 rows: the DCT input i is the sum over the rows k
+ * of coefficient [k][i] times x[2 * M * k + i] */
+extern const int16_t gas16WindowCoeff4[5][8];
+extern const int16_t gas16WindowCoeff8[5][16];
+
+extern const tSBC_ANALYSIS_KERNELS sbc_analysis_kernels_c;
+extern const tSBC_ANALYSIS_KERNELS* SbcAnalysisSimdKernels(
+    tSBC_ANALYSIS_IMPL impl);
+#endif
+
 extern uint32_t EncPacking(SBC_ENC_PARAMS* strEncParams, uint8_t* output);
 extern void EncQuantizer(SBC_ENC_PARAMS*);
 #if (SBC_DSP_OPT == TRUE)
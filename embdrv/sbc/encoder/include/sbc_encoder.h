@@ -138,6 +138,15 @@
 #define SBC_FAST_DCT TRUE
 #endif /*SBC_FAST_DCT */
 
+/* Set SBC_SIMD_OPT to TRUE to run the windowing and the fast DCT of the
+ * analysis filter with SSE2, AVX2 or NEON code chosen at run time. The output
+ * is bit exact with the C code. It only applies with SBC_IPAQ_OPT set to TRUE
+ * and 32 bit multiplications in the windowing and the DCT.
+ */
+#ifndef SBC_SIMD_OPT
+#define SBC_SIMD_OPT TRUE
+#endif /* SBC_SIMD_OPT */
+
 /* In case we do not use joint stereo mode the flag save some RAM and ROM in
  * case it is set to FALSE */
 #ifndef SBC_JOINT_STE_INCLUDED
@@ -191,6 +200,14 @@ typedef struct SBC_ENC_PARAMS_TAG {
 
 } SBC_ENC_PARAMS;
 
+/* Implementations of the analysis filter */
+typedef enum {
+  SBC_ANALYSIS_C,
+  SBC_ANALYSIS_SSE2,
+  SBC_ANALYSIS_AVX2,
+  SBC_ANALYSIS_NEON,
+} tSBC_ANALYSIS_IMPL;
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -201,6 +218,11 @@ extern uint32_t SBC_Encode(SBC_ENC_PARAMS* strEncParams, int16_t* input,
                            uint8_t* output);
 extern void SBC_Encoder_Init(SBC_ENC_PARAMS* strEncParams);
 
+/* Select the implementation of the analysis filter used by SBC_Encode(). The
+ * fastest one supported by the CPU is used by default. Return false if |impl|
+ * is not supported by the CPU or by this build. */
+extern bool SBC_SetAnalysisImpl(tSBC_ANALYSIS_IMPL impl);
+
 #ifdef __cplusplus
 }
 #endif
@@ -200,7 +200,13 @@
 #if (SBC_USE_ARM_PRAGMA == TRUE)
 #pragma arm section zidata = "sbc_s32_analysis_section"
 #endif
+#if (SBC_ANALYSIS_KERNELS == TRUE)
+/* DCT inputs of all the blocks and channels of a frame */
+static int32_t s32DCTY[SBC_MAX_NUM_OF_BLOCKS * SBC_MAX_NUM_OF_CHANNELS * 16] = {
+    0};
+#else
 static int32_t s32DCTY[16] = {0};
+#endif
 static int32_t s32X[ENC_VX_BUFFER_SIZE / 2];
 static int16_t* s16X =
     (int16_t*)s32X; /* s16X must be 32 bits aligned cf  SHIFTUP_X8_2*/
@@ -1185,6 +1191,100 @@ static int16_t* s16X =
 #endif
 #endif
 
+#if (SBC_ANALYSIS_KERNELS == TRUE)
+const int16_t gas16WindowCoeff4[5][8] = {
+    {0, WIND_4_SUBBANDS_1_0, WIND_4_SUBBANDS_2_0, WIND_4_SUBBANDS_3_0,
+     WIND_4_SUBBANDS_4_0, WIND_4_SUBBANDS_3_4, WIND_4_SUBBANDS_2_4,
+     WIND_4_SUBBANDS_1_4},
+    {WIND_4_SUBBANDS_0_1, WIND_4_SUBBANDS_1_1, WIND_4_SUBBANDS_2_1,
+     WIND_4_SUBBANDS_3_1, WIND_4_SUBBANDS_4_1, WIND_4_SUBBANDS_3_3,
+     WIND_4_SUBBANDS_2_3, WIND_4_SUBBANDS_1_3},
+    {WIND_4_SUBBANDS_0_2, WIND_4_SUBBANDS_1_2, WIND_4_SUBBANDS_2_2,
+     WIND_4_SUBBANDS_3_2, WIND_4_SUBBANDS_4_2, WIND_4_SUBBANDS_3_2,
+     WIND_4_SUBBANDS_2_2, WIND_4_SUBBANDS_1_2},
+    {-WIND_4_SUBBANDS_0_2, WIND_4_SUBBANDS_1_3, WIND_4_SUBBANDS_2_3,
+     WIND_4_SUBBANDS_3_3, WIND_4_SUBBANDS_4_1, WIND_4_SUBBANDS_3_1,
+     WIND_4_SUBBANDS_2_1, WIND_4_SUBBANDS_1_1},
+    {-WIND_4_SUBBANDS_0_1, WIND_4_SUBBANDS_1_4, WIND_4_SUBBANDS_2_4,
+     WIND_4_SUBBANDS_3_4, WIND_4_SUBBANDS_4_0, WIND_4_SUBBANDS_3_0,
+     WIND_4_SUBBANDS_2_0, WIND_4_SUBBANDS_1_0}};
+
+const int16_t gas16WindowCoeff8[5][16] = {
+    {0, WIND_8_SUBBANDS_1_0, WIND_8_SUBBANDS_2_0, WIND_8_SUBBANDS_3_0,
+     WIND_8_SUBBANDS_4_0, WIND_8_SUBBANDS_5_0, WIND_8_SUBBANDS_6_0,
+     WIND_8_SUBBANDS_7_0, WIND_8_SUBBANDS_8_0, WIND_8_SUBBANDS_7_4,
+     WIND_8_SUBBANDS_6_4, WIND_8_SUBBANDS_5_4, WIND_8_SUBBANDS_4_4,
+     WIND_8_SUBBANDS_3_4, WIND_8_SUBBANDS_2_4, WIND_8_SUBBANDS_1_4},
+    {WIND_8_SUBBANDS_0_1, WIND_8_SUBBANDS_1_1, WIND_8_SUBBANDS_2_1,
+     WIND_8_SUBBANDS_3_1, WIND_8_SUBBANDS_4_1, WIND_8_SUBBANDS_5_1,
+     WIND_8_SUBBANDS_6_1, WIND_8_SUBBANDS_7_1, WIND_8_SUBBANDS_8_1,
+     WIND_8_SUBBANDS_7_3, WIND_8_SUBBANDS_6_3, WIND_8_SUBBANDS_5_3,
+     WIND_8_SUBBANDS_4_3, WIND_8_SUBBANDS_3_3, WIND_8_SUBBANDS_2_3,
+     WIND_8_SUBBANDS_1_3},
+    {WIND_8_SUBBANDS_0_2, WIND_8_SUBBANDS_1_2, WIND_8_SUBBANDS_2_2,
+     WIND_8_SUBBANDS_3_2, WIND_8_SUBBANDS_4_2, WIND_8_SUBBANDS_5_2,
+     WIND_8_SUBBANDS_6_2, WIND_8_SUBBANDS_7_2, WIND_8_SUBBANDS_8_2,
+     WIND_8_SUBBANDS_7_2, WIND_8_SUBBANDS_6_2, WIND_8_SUBBANDS_5_2,
+     WIND_8_SUBBANDS_4_2, WIND_8_SUBBANDS_3_2, WIND_8_SUBBANDS_2_2,
+     WIND_8_SUBBANDS_1_2},
+    {-WIND_8_SUBBANDS_0_2, WIND_8_SUBBANDS_1_3, WIND_8_SUBBANDS_2_3,
+     WIND_8_SUBBANDS_3_3, WIND_8_SUBBANDS_4_3, WIND_8_SUBBANDS_5_3,
+     WIND_8_SUBBANDS_6_3, WIND_8_SUBBANDS_7_3, WIND_8_SUBBANDS_8_1,
+     WIND_8_SUBBANDS_7_1, WIND_8_SUBBANDS_6_1, WIND_8_SUBBANDS_5_1,
+     WIND_8_SUBBANDS_4_1, WIND_8_SUBBANDS_3_1, WIND_8_SUBBANDS_2_1,
+     WIND_8_SUBBANDS_1_1},
+    {-WIND_8_SUBBANDS_0_1, WIND_8_SUBBANDS_1_4, WIND_8_SUBBANDS_2_4,
+     WIND_8_SUBBANDS_3_4, WIND_8_SUBBANDS_4_4, WIND_8_SUBBANDS_5_4,
+     WIND_8_SUBBANDS_6_4, WIND_8_SUBBANDS_7_4, WIND_8_SUBBANDS_8_0,
+     WIND_8_SUBBANDS_7_0, WIND_8_SUBBANDS_6_0, WIND_8_SUBBANDS_5_0,
+     WIND_8_SUBBANDS_4_0, WIND_8_SUBBANDS_3_0, WIND_8_SUBBANDS_2_0,
+     WIND_8_SUBBANDS_1_0}};
+
+/* The WINDOW_PARTIAL macros read s16X[ChOffset + i] and write s32DCTY[i] */
+static void SbcWindow4(const int16_t* s16X, int32_t* s32DCTY) {
+  const int32_t ChOffset = 0;
+  register int32_t s32Temp, s32Temp2;
+
+  WINDOW_PARTIAL_4
+}
+
+static void SbcWindow8(const int16_t* s16X, int32_t* s32DCTY) {
+  const int32_t ChOffset = 0;
+  register int32_t s32Temp, s32Temp2;
+
+  WINDOW_PARTIAL_8
+}
+
+static void SbcDct4(const int32_t* y, int32_t* out, int32_t count) {
+  for (; count > 0; count--, y += 8, out += SUB_BANDS_4)
+    SBC_FastIDCT4((int32_t*)y, out);
+}
+
+static void SbcDct8(const int32_t* y, int32_t* out, int32_t count) {
+  for (; count > 0; count--, y += 16, out += SUB_BANDS_8)
+    SBC_FastIDCT8((int32_t*)y, out);
+}
+
+const tSBC_ANALYSIS_KERNELS sbc_analysis_kernels_c = {SbcWindow4, SbcWindow8,
+                                                      SbcDct4, SbcDct8};
+
+static const tSBC_ANALYSIS_KERNELS* p_kernels = NULL;
+
+bool SBC_SetAnalysisImpl(tSBC_ANALYSIS_IMPL impl) {
+  const tSBC_ANALYSIS_KERNELS* kernels = (impl == SBC_ANALYSIS_C)
+                                             ? &sbc_analysis_kernels_c
+                                             : SbcAnalysisSimdKernels(impl);
+  if (kernels == NULL) return false;
+
+  p_kernels = kernels;
+  return true;
+}
+#else
+bool SBC_SetAnalysisImpl(tSBC_ANALYSIS_IMPL impl) {
+  return impl == SBC_ANALYSIS_C;
+}
+#endif
+
 static int16_t ShiftCounter = 0;
 extern int16_t EncMaxShiftCounter;
 /****************************************************************************
@@ -1199,7 +1299,9 @@ void SbcAnalysisFilter4(SBC_ENC_PARAMS* pstrEncParams, int16_t* input) {
   int32_t s32NumOfChannels, s32NumOfBlocks;
   int32_t i, *ps32X, *ps32X2;
   int32_t Offset, Offset2, ChOffset;
-#if (SBC_ARM_ASM_OPT == TRUE)
+#if (SBC_ANALYSIS_KERNELS == TRUE)
+  int32_t* ps32DCTY = s32DCTY;
+#elif (SBC_ARM_ASM_OPT == TRUE)
   register int32_t s32Hi, s32Hi2;
 #else
 #if (SBC_IPAQ_OPT == TRUE)
@@ -1257,11 +1359,16 @@ void SbcAnalysisFilter4(SBC_ENC_PARAMS* pstrEncParams, int16_t* input) {
     for (s32Ch = 0; s32Ch < s32NumOfChannels; s32Ch++) {
       ChOffset = s32Ch * Offset2 + Offset;
 
+#if (SBC_ANALYSIS_KERNELS == TRUE)
+      p_kernels->window4(s16X + ChOffset, ps32DCTY);
+      ps32DCTY += 2 * SUB_BANDS_4;
+#else
       WINDOW_PARTIAL_4
 
       SBC_FastIDCT4(s32DCTY, ps32SbBuf);
 
       ps32SbBuf += SUB_BANDS_4;
+#endif
     }
     if (s32NumOfChannels == 1) {
       if (ShiftCounter >= EncMaxShiftCounter) {
@@ -1279,6 +1386,9 @@ void SbcAnalysisFilter4(SBC_ENC_PARAMS* pstrEncParams, int16_t* input) {
       }
     }
   }
+#if (SBC_ANALYSIS_KERNELS == TRUE)
+  p_kernels->dct4(s32DCTY, ps32SbBuf, s32NumOfBlocks * s32NumOfChannels);
+#endif
 }
 
 /* ////////////////////////////////////////////////////////////////////////// */
@@ -1290,7 +1400,9 @@ void SbcAnalysisFilter8(SBC_ENC_PARAMS* pstrEncParams, int16_t* input) {
   int32_t s32NumOfChannels, s32NumOfBlocks;
   int32_t i, *ps32X, *ps32X2;
   int32_t ChOffset;
-#if (SBC_ARM_ASM_OPT == TRUE)
+#if (SBC_ANALYSIS_KERNELS == TRUE)
+  int32_t* ps32DCTY = s32DCTY;
+#elif (SBC_ARM_ASM_OPT == TRUE)
   register int32_t s32Hi, s32Hi2;
 #else
 #if (SBC_IPAQ_OPT == TRUE)
@@ -1370,11 +1482,16 @@ void SbcAnalysisFilter8(SBC_ENC_PARAMS* pstrEncParams, int16_t* input) {
     for (s32Ch = 0; s32Ch < s32NumOfChannels; s32Ch++) {
       ChOffset = s32Ch * Offset2 + Offset;
 
+#if (SBC_ANALYSIS_KERNELS == TRUE)
+      p_kernels->window8(s16X + ChOffset, ps32DCTY);
+      ps32DCTY += 2 * SUB_BANDS_8;
+#else
       WINDOW_PARTIAL_8
 
       SBC_FastIDCT8(s32DCTY, ps32SbBuf);
 
       ps32SbBuf += SUB_BANDS_8;
+#endif
     }
     if (s32NumOfChannels == 1) {
       if (ShiftCounter >= EncMaxShiftCounter) {
@@ -1392,9 +1509,19 @@ void SbcAnalysisFilter8(SBC_ENC_PARAMS* pstrEncParams, int16_t* input) {
       }
     }
   }
+#if (SBC_ANALYSIS_KERNELS == TRUE)
+  p_kernels->dct8(s32DCTY, ps32SbBuf, s32NumOfBlocks * s32NumOfChannels);
+#endif
 }
 
 void SbcAnalysisInit(void) {
   memset(s16X, 0, ENC_VX_BUFFER_SIZE * sizeof(int16_t));
   ShiftCounter = 0;
+#if (SBC_ANALYSIS_KERNELS == TRUE)
+  if (p_kernels == NULL &&
+      !SBC_SetAnalysisImpl(SBC_ANALYSIS_NEON) &&
+      !SBC_SetAnalysisImpl(SBC_ANALYSIS_AVX2) &&
+      !SBC_SetAnalysisImpl(SBC_ANALYSIS_SSE2))
+    SBC_SetAnalysisImpl(SBC_ANALYSIS_C);
+#endif
 }
@@ -0,0 +1,437 @@
+/******************************************************************************
+ * Copyright (c) 2026 Qualcomm Innovation Center, Inc. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ *
+ *******************************************************************************/
+
+/******************************************************************************
+ *
+ *  SSE2, AVX2 and NEON versions of the windowing and of the fast DCT of the
+ *  analysis filter. The windowing computes each DCT input of a block as 5
+ *  products of 16 bit samples and coefficients summed in 32 bits, the DCTs
+ *  of all the blocks and channels of a frame are computed side by side in
+ *  the lanes of the vectors. Both are bit exact with the C code.
+ *
+ ******************************************************************************/
+
+#include "sbc_dct.h"
+#include "sbc_enc_func_declare.h"
+#include "sbc_encoder.h"
+
+#if (SBC_ANALYSIS_KERNELS == TRUE)
+
+#if defined(__i386__) || defined(__x86_64__)
+#define SBC_SIMD_X86 TRUE
+#include <immintrin.h>
+#else
+#define SBC_SIMD_X86 FALSE
+#endif
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define SBC_SIMD_NEON TRUE
+#include <arm_neon.h>
+#else
+#define SBC_SIMD_NEON FALSE
+#endif
+
+#if (SBC_SIMD_X86 == TRUE)
+#define SBC_TARGET_SSE2 __attribute__((target("sse2")))
+#define SBC_TARGET_AVX2 __attribute__((target("avx2")))
+
+/* The window coefficients of the rows 2p and 2p+1 interleaved so that
+ * _mm_madd_epi16() sums both products at once, row 5 being all zeros */
+static int16_t as16Coeff4Sse2[3][16] __attribute__((aligned(16)));
+static int16_t as16Coeff8Sse2[3][32] __attribute__((aligned(16)));
+/* Same as as16Coeff8Sse2 with the columns 4 to 7 and 8 to 11 swapped, to
+ * match the 128 bit lanes of _mm256_unpacklo_epi16() */
+static int16_t as16Coeff8Avx2[3][32] __attribute__((aligned(32)));
+
+static void SbcInitCoeffsX86(void) {
+  static const int sse2_chunk[4] = {0, 2, 1, 3};
+  int32_t p, i, j;
+
+  for (p = 0; p < 3; p++) {
+    for (i = 0; i < 8; i++) {
+      as16Coeff4Sse2[p][2 * i] = gas16WindowCoeff4[2 * p][i];
+      as16Coeff4Sse2[p][2 * i + 1] =
+          (p < 2) ? gas16WindowCoeff4[2 * p + 1][i] : 0;
+    }
+    for (i = 0; i < 16; i++) {
+      as16Coeff8Sse2[p][2 * i] = gas16WindowCoeff8[2 * p][i];
+      as16Coeff8Sse2[p][2 * i + 1] =
+          (p < 2) ? gas16WindowCoeff8[2 * p + 1][i] : 0;
+    }
+    for (i = 0; i < 4; i++)
+      for (j = 0; j < 8; j++)
+        as16Coeff8Avx2[p][8 * i + j] =
+            as16Coeff8Sse2[p][8 * sse2_chunk[i] + j];
+  }
+}
+
+/* Accumulate the rows 2p and 2p+1 (or only the last one) of 8 columns */
+#define SBC_WINDOW_ACCU_SSE2(lo, hi, x0, x1, c)                              \
+  {                                                                         \
+    __m128i a = _mm_loadu_si128((const __m128i*)(x0));                      \
+    __m128i b = (x1) ? _mm_loadu_si128((const __m128i*)(x1))                \
+                     : _mm_setzero_si128();                                 \
+    lo = _mm_add_epi32(lo, _mm_madd_epi16(_mm_unpacklo_epi16(a, b), (c)[0])); \
+    hi = _mm_add_epi32(hi, _mm_madd_epi16(_mm_unpackhi_epi16(a, b), (c)[1])); \
+  }
+
+static SBC_TARGET_SSE2 void SbcWindow4Sse2(const int16_t* x, int32_t* y) {
+  const __m128i* c = (const __m128i*)as16Coeff4Sse2;
+  __m128i lo = _mm_setzero_si128(), hi = _mm_setzero_si128();
+
+  SBC_WINDOW_ACCU_SSE2(lo, hi, x, x + 8, c);
+  SBC_WINDOW_ACCU_SSE2(lo, hi, x + 16, x + 24, c + 2);
+  SBC_WINDOW_ACCU_SSE2(lo, hi, x + 32, NULL, c + 4);
+  _mm_storeu_si128((__m128i*)y, lo);
+  _mm_storeu_si128((__m128i*)(y + 4), hi);
+}
+
+static SBC_TARGET_SSE2 void SbcWindow8Sse2(const int16_t* x, int32_t* y) {
+  const __m128i* c = (const __m128i*)as16Coeff8Sse2;
+  __m128i lo0 = _mm_setzero_si128(), hi0 = _mm_setzero_si128();
+  __m128i lo1 = _mm_setzero_si128(), hi1 = _mm_setzero_si128();
+
+  SBC_WINDOW_ACCU_SSE2(lo0, hi0, x, x + 16, c);
+  SBC_WINDOW_ACCU_SSE2(lo1, hi1, x + 8, x + 24, c + 2);
+  SBC_WINDOW_ACCU_SSE2(lo0, hi0, x + 32, x + 48, c + 4);
+  SBC_WINDOW_ACCU_SSE2(lo1, hi1, x + 40, x + 56, c + 6);
+  SBC_WINDOW_ACCU_SSE2(lo0, hi0, x + 64, NULL, c + 8);
+  SBC_WINDOW_ACCU_SSE2(lo1, hi1, x + 72, NULL, c + 10);
+  _mm_storeu_si128((__m128i*)y, lo0);
+  _mm_storeu_si128((__m128i*)(y + 4), hi0);
+  _mm_storeu_si128((__m128i*)(y + 8), lo1);
+  _mm_storeu_si128((__m128i*)(y + 12), hi1);
+}
+
+static SBC_TARGET_AVX2 void SbcWindow8Avx2(const int16_t* x, int32_t* y) {
+  const __m256i* c = (const __m256i*)as16Coeff8Avx2;
+  __m256i a0 = _mm256_loadu_si256((const __m256i*)x);
+  __m256i a1 = _mm256_loadu_si256((const __m256i*)(x + 16));
+  __m256i a2 = _mm256_loadu_si256((const __m256i*)(x + 32));
+  __m256i a3 = _mm256_loadu_si256((const __m256i*)(x + 48));
+  __m256i a4 = _mm256_loadu_si256((const __m256i*)(x + 64));
+  __m256i zero = _mm256_setzero_si256();
+  __m256i lo, hi;
+
+  lo = _mm256_add_epi32(
+      _mm256_madd_epi16(_mm256_unpacklo_epi16(a0, a1), c[0]),
+      _mm256_madd_epi16(_mm256_unpacklo_epi16(a2, a3), c[2]));
+  lo = _mm256_add_epi32(
+      lo, _mm256_madd_epi16(_mm256_unpacklo_epi16(a4, zero), c[4]));
+  hi = _mm256_add_epi32(
+      _mm256_madd_epi16(_mm256_unpackhi_epi16(a0, a1), c[1]),
+      _mm256_madd_epi16(_mm256_unpackhi_epi16(a2, a3), c[3]));
+  hi = _mm256_add_epi32(
+      hi, _mm256_madd_epi16(_mm256_unpackhi_epi16(a4, zero), c[5]));
+  /* lo holds the columns 0 to 3 and 8 to 11, hi the columns 4 to 7 and 12 to
+   * 15 */
+  _mm256_storeu_si256((__m256i*)y, _mm256_permute2x128_si256(lo, hi, 0x20));
+  _mm256_storeu_si256((__m256i*)(y + 8),
+                      _mm256_permute2x128_si256(lo, hi, 0x31));
+}
+
+/* Transpose the 4x4 matrix whose rows are r[0] to r[3] */
+static inline SBC_TARGET_SSE2 void SbcTranspose4x4Sse2(__m128i* r) {
+  __m128i t0 = _mm_unpacklo_epi32(r[0], r[1]);
+  __m128i t1 = _mm_unpacklo_epi32(r[2], r[3]);
+  __m128i t2 = _mm_unpackhi_epi32(r[0], r[1]);
+  __m128i t3 = _mm_unpackhi_epi32(r[2], r[3]);
+  r[0] = _mm_unpacklo_epi64(t0, t1);
+  r[1] = _mm_unpackhi_epi64(t0, t1);
+  r[2] = _mm_unpacklo_epi64(t2, t3);
+  r[3] = _mm_unpackhi_epi64(t2, t3);
+}
+
+/* Load the 4 columns of 4 rows |s| apart at |p| */
+static inline SBC_TARGET_SSE2 void SbcLoad4x4Sse2(__m128i* v, const int32_t* p,
+                                                 int32_t s) {
+  v[0] = _mm_loadu_si128((const __m128i*)p);
+  v[1] = _mm_loadu_si128((const __m128i*)(p + s));
+  v[2] = _mm_loadu_si128((const __m128i*)(p + 2 * s));
+  v[3] = _mm_loadu_si128((const __m128i*)(p + 3 * s));
+  SbcTranspose4x4Sse2(v);
+}
+
+static inline SBC_TARGET_SSE2 void SbcStore4x4Sse2(int32_t* p, int32_t s,
+                                                  __m128i* v) {
+  SbcTranspose4x4Sse2(v);
+  _mm_storeu_si128((__m128i*)p, v[0]);
+  _mm_storeu_si128((__m128i*)(p + s), v[1]);
+  _mm_storeu_si128((__m128i*)(p + 2 * s), v[2]);
+  _mm_storeu_si128((__m128i*)(p + 3 * s), v[3]);
+}
+
+/* |m| is 4, 8 or 16 */
+static inline SBC_TARGET_SSE2 void SbcLoadTSse2(__m128i* v, const int32_t* p,
+                                               int32_t s, int32_t m) {
+  SbcLoad4x4Sse2(v, p, s);
+  if (m > 4) SbcLoad4x4Sse2(v + 4, p + 4, s);
+  if (m > 8) {
+    SbcLoad4x4Sse2(v + 8, p + 8, s);
+    SbcLoad4x4Sse2(v + 12, p + 12, s);
+  }
+}
+
+/* |m| is 4 or 8 */
+static inline SBC_TARGET_SSE2 void SbcStoreTSse2(int32_t* p, int32_t s,
+                                                __m128i* v, int32_t m) {
+  SbcStore4x4Sse2(p, s, v);
+  if (m > 4) SbcStore4x4Sse2(p + 4, s, v + 4);
+}
+
+/* Transpose the 8x8 matrix whose rows are r[0] to r[7] */
+static inline SBC_TARGET_AVX2 void SbcTranspose8x8Avx2(__m256i* r) {
+  __m256i t0 = _mm256_unpacklo_epi32(r[0], r[1]);
+  __m256i t1 = _mm256_unpackhi_epi32(r[0], r[1]);
+  __m256i t2 = _mm256_unpacklo_epi32(r[2], r[3]);
+  __m256i t3 = _mm256_unpackhi_epi32(r[2], r[3]);
+  __m256i t4 = _mm256_unpacklo_epi32(r[4], r[5]);
+  __m256i t5 = _mm256_unpackhi_epi32(r[4], r[5]);
+  __m256i t6 = _mm256_unpacklo_epi32(r[6], r[7]);
+  __m256i t7 = _mm256_unpackhi_epi32(r[6], r[7]);
+  __m256i u0 = _mm256_unpacklo_epi64(t0, t2);
+  __m256i u1 = _mm256_unpackhi_epi64(t0, t2);
+  __m256i u2 = _mm256_unpacklo_epi64(t1, t3);
+  __m256i u3 = _mm256_unpackhi_epi64(t1, t3);
+  __m256i u4 = _mm256_unpacklo_epi64(t4, t6);
+  __m256i u5 = _mm256_unpackhi_epi64(t4, t6);
+  __m256i u6 = _mm256_unpacklo_epi64(t5, t7);
+  __m256i u7 = _mm256_unpackhi_epi64(t5, t7);
+  r[0] = _mm256_permute2x128_si256(u0, u4, 0x20);
+  r[1] = _mm256_permute2x128_si256(u1, u5, 0x20);
+  r[2] = _mm256_permute2x128_si256(u2, u6, 0x20);
+  r[3] = _mm256_permute2x128_si256(u3, u7, 0x20);
+  r[4] = _mm256_permute2x128_si256(u0, u4, 0x31);
+  r[5] = _mm256_permute2x128_si256(u1, u5, 0x31);
+  r[6] = _mm256_permute2x128_si256(u2, u6, 0x31);
+  r[7] = _mm256_permute2x128_si256(u3, u7, 0x31);
+}
+
+/* Load the 8 columns of 8 rows |s| apart at |p| */
+static inline SBC_TARGET_AVX2 void SbcLoad8x8Avx2(__m256i* v, const int32_t* p,
+                                                 int32_t s) {
+  v[0] = _mm256_loadu_si256((const __m256i*)p);
+  v[1] = _mm256_loadu_si256((const __m256i*)(p + s));
+  v[2] = _mm256_loadu_si256((const __m256i*)(p + 2 * s));
+  v[3] = _mm256_loadu_si256((const __m256i*)(p + 3 * s));
+  v[4] = _mm256_loadu_si256((const __m256i*)(p + 4 * s));
+  v[5] = _mm256_loadu_si256((const __m256i*)(p + 5 * s));
+  v[6] = _mm256_loadu_si256((const __m256i*)(p + 6 * s));
+  v[7] = _mm256_loadu_si256((const __m256i*)(p + 7 * s));
+  SbcTranspose8x8Avx2(v);
+}
+
+/* |m| is 8 or 16 */
+static inline SBC_TARGET_AVX2 void SbcLoadTAvx2(__m256i* v, const int32_t* p,
+                                               int32_t s, int32_t m) {
+  SbcLoad8x8Avx2(v, p, s);
+  if (m > 8) SbcLoad8x8Avx2(v + 8, p + 8, s);
+}
+
+/* |m| is 4 or 8, the rows of 4 values are stored from the low 128 bits */
+static inline SBC_TARGET_AVX2 void SbcStoreTAvx2(int32_t* p, int32_t s,
+                                                const __m256i* v, int32_t m) {
+  __m256i r[8];
+  int32_t l;
+
+  r[0] = v[0];
+  r[1] = v[1];
+  r[2] = v[2];
+  r[3] = v[3];
+  r[4] = (m > 4) ? v[4] : _mm256_setzero_si256();
+  r[5] = (m > 4) ? v[5] : _mm256_setzero_si256();
+  r[6] = (m > 4) ? v[6] : _mm256_setzero_si256();
+  r[7] = (m > 4) ? v[7] : _mm256_setzero_si256();
+  SbcTranspose8x8Avx2(r);
+  for (l = 0; l < 8; l++) {
+    if (m > 4)
+      _mm256_storeu_si256((__m256i*)(p + l * s), r[l]);
+    else
+      _mm_storeu_si128((__m128i*)(p + l * s), _mm256_castsi256_si128(r[l]));
+  }
+}
+
+/* With a = ah * 2^16 + al, al taken as signed 16 bits and b the sign bit of al,
+ * (c * a) >> 15 is 2 * c * (ah + b) + ((c * al) >> 15) where both products
+ * are done by _mm_madd_epi16() */
+static inline SBC_TARGET_SSE2 __m128i SbcMulcSse2(int32_t c, __m128i a) {
+  const __m128i c_hi = _mm_set1_epi32(c << 16);
+  const __m128i c_lo = _mm_set1_epi32(c);
+  __m128i b = _mm_and_si128(_mm_srai_epi32(_mm_slli_epi32(a, 16), 31), c_lo);
+  __m128i hi = _mm_slli_epi32(_mm_add_epi32(_mm_madd_epi16(a, c_hi), b), 1);
+  return _mm_add_epi32(hi, _mm_srai_epi32(_mm_madd_epi16(a, c_lo), 15));
+}
+
+static inline SBC_TARGET_AVX2 __m256i SbcMulcAvx2(int32_t c, __m256i a) {
+  const __m256i vc = _mm256_set1_epi32(c);
+  __m256i even = _mm256_srli_epi64(_mm256_mul_epi32(a, vc), 15);
+  __m256i odd =
+      _mm256_slli_epi64(_mm256_mul_epi32(_mm256_srli_epi64(a, 32), vc), 17);
+  return _mm256_blend_epi32(even, odd, 0xAA);
+}
+
+#define SBC_SIMD_ATTR SBC_TARGET_SSE2
+#define SBC_SIMD_LANES 4
+#define SBC_SIMD_DCT4 SbcDct4Sse2
+#define SBC_SIMD_DCT8 SbcDct8Sse2
+#define V __m128i
+#define V_LOAD_T(v, p, s, m) SbcLoadTSse2(v, p, s, m)
+#define V_STORE_T(p, s, v, m) SbcStoreTSse2(p, s, v, m)
+#define V_ADD(a, b) _mm_add_epi32(a, b)
+#define V_SUB(a, b) _mm_sub_epi32(a, b)
+#define V_SRA(a, n) _mm_srai_epi32(a, n)
+#define V_SLL(a, n) _mm_slli_epi32(a, n)
+#define V_MULC(c, a) SbcMulcSse2(c, a)
+#include "sbc_dct_simd.inc"
+
+#define SBC_SIMD_ATTR SBC_TARGET_AVX2
+#define SBC_SIMD_LANES 8
+#define SBC_SIMD_DCT4 SbcDct4Avx2
+#define SBC_SIMD_DCT8 SbcDct8Avx2
+#define V __m256i
+#define V_LOAD_T(v, p, s, m) SbcLoadTAvx2(v, p, s, m)
+#define V_STORE_T(p, s, v, m) SbcStoreTAvx2(p, s, v, m)
+#define V_ADD(a, b) _mm256_add_epi32(a, b)
+#define V_SUB(a, b) _mm256_sub_epi32(a, b)
+#define V_SRA(a, n) _mm256_srai_epi32(a, n)
+#define V_SLL(a, n) _mm256_slli_epi32(a, n)
+#define V_MULC(c, a) SbcMulcAvx2(c, a)
+#include "sbc_dct_simd.inc"
+
+static const tSBC_ANALYSIS_KERNELS sbc_analysis_kernels_sse2 = {
+    SbcWindow4Sse2, SbcWindow8Sse2, SbcDct4Sse2, SbcDct8Sse2};
+
+/* The 4 subbands windowing is 8 columns wide and stays on SSE2 */
+static const tSBC_ANALYSIS_KERNELS sbc_analysis_kernels_avx2 = {
+    SbcWindow4Sse2, SbcWindow8Avx2, SbcDct4Avx2, SbcDct8Avx2};
+#endif /* SBC_SIMD_X86 */
+
+#if (SBC_SIMD_NEON == TRUE)
+static void SbcWindow4Neon(const int16_t* x, int32_t* y) {
+  int32x4_t acc;
+  int32_t i, k;
+
+  for (i = 0; i < 8; i += 4) {
+    acc = vmull_s16(vld1_s16(&gas16WindowCoeff4[0][i]), vld1_s16(x + i));
+    for (k = 1; k < 5; k++)
+      acc = vmlal_s16(acc, vld1_s16(&gas16WindowCoeff4[k][i]),
+                      vld1_s16(x + 8 * k + i));
+    vst1q_s32(y + i, acc);
+  }
+}
+
+static void SbcWindow8Neon(const int16_t* x, int32_t* y) {
+  int32x4_t acc;
+  int32_t i, k;
+
+  for (i = 0; i < 16; i += 4) {
+    acc = vmull_s16(vld1_s16(&gas16WindowCoeff8[0][i]), vld1_s16(x + i));
+    for (k = 1; k < 5; k++)
+      acc = vmlal_s16(acc, vld1_s16(&gas16WindowCoeff8[k][i]),
+                      vld1_s16(x + 16 * k + i));
+    vst1q_s32(y + i, acc);
+  }
+}
+
+/* Transpose the 4x4 matrix whose rows are r[0] to r[3] */
+static inline void SbcTranspose4x4Neon(int32x4_t* r) {
+  int32x4x2_t t01 = vtrnq_s32(r[0], r[1]);
+  int32x4x2_t t23 = vtrnq_s32(r[2], r[3]);
+  r[0] = vcombine_s32(vget_low_s32(t01.val[0]), vget_low_s32(t23.val[0]));
+  r[1] = vcombine_s32(vget_low_s32(t01.val[1]), vget_low_s32(t23.val[1]));
+  r[2] = vcombine_s32(vget_high_s32(t01.val[0]), vget_high_s32(t23.val[0]));
+  r[3] = vcombine_s32(vget_high_s32(t01.val[1]), vget_high_s32(t23.val[1]));
+}
+
+/* Load the 4 columns of 4 rows |s| apart at |p| */
+static inline void SbcLoad4x4Neon(int32x4_t* v, const int32_t* p, int32_t s) {
+  v[0] = vld1q_s32(p);
+  v[1] = vld1q_s32(p + s);
+  v[2] = vld1q_s32(p + 2 * s);
+  v[3] = vld1q_s32(p + 3 * s);
+  SbcTranspose4x4Neon(v);
+}
+
+static inline void SbcStore4x4Neon(int32_t* p, int32_t s, int32x4_t* v) {
+  SbcTranspose4x4Neon(v);
+  vst1q_s32(p, v[0]);
+  vst1q_s32(p + s, v[1]);
+  vst1q_s32(p + 2 * s, v[2]);
+  vst1q_s32(p + 3 * s, v[3]);
+}
+
+/* |m| is 4, 8 or 16 */
+static inline void SbcLoadTNeon(int32x4_t* v, const int32_t* p, int32_t s,
+                                int32_t m) {
+  SbcLoad4x4Neon(v, p, s);
+  if (m > 4) SbcLoad4x4Neon(v + 4, p + 4, s);
+  if (m > 8) {
+    SbcLoad4x4Neon(v + 8, p + 8, s);
+    SbcLoad4x4Neon(v + 12, p + 12, s);
+  }
+}
+
+/* |m| is 4 or 8 */
+static inline void SbcStoreTNeon(int32_t* p, int32_t s, int32x4_t* v,
+                                 int32_t m) {
+  SbcStore4x4Neon(p, s, v);
+  if (m > 4) SbcStore4x4Neon(p + 4, s, v + 4);
+}
+
+static inline int32x4_t SbcMulcNeon(int32_t c, int32x4_t a) {
+  const int32x2_t vc = vdup_n_s32(c);
+  return vcombine_s32(vshrn_n_s64(vmull_s32(vget_low_s32(a), vc), 15),
+                      vshrn_n_s64(vmull_s32(vget_high_s32(a), vc), 15));
+}
+
+#define SBC_SIMD_ATTR
+#define SBC_SIMD_LANES 4
+#define SBC_SIMD_DCT4 SbcDct4Neon
+#define SBC_SIMD_DCT8 SbcDct8Neon
+#define V int32x4_t
+#define V_LOAD_T(v, p, s, m) SbcLoadTNeon(v, p, s, m)
+#define V_STORE_T(p, s, v, m) SbcStoreTNeon(p, s, v, m)
+#define V_ADD(a, b) vaddq_s32(a, b)
+#define V_SUB(a, b) vsubq_s32(a, b)
+#define V_SRA(a, n) vshrq_n_s32(a, n)
+#define V_SLL(a, n) vshlq_n_s32(a, n)
+#define V_MULC(c, a) SbcMulcNeon(c, a)
+#include "sbc_dct_simd.inc"
+
+static const tSBC_ANALYSIS_KERNELS sbc_analysis_kernels_neon = {
+    SbcWindow4Neon, SbcWindow8Neon, SbcDct4Neon, SbcDct8Neon};
+#endif /* SBC_SIMD_NEON */
+
+/*******************************************************************************
+ *
+ * Function         SbcAnalysisSimdKernels
+ *
+ * Description      Return the kernels of |impl|, or NULL if they are not
+ *                  built in or not supported by the CPU.
+ *
+ ******************************************************************************/
+const tSBC_ANALYSIS_KERNELS* SbcAnalysisSimdKernels(tSBC_ANALYSIS_IMPL impl) {
+  switch (impl) {
+#if (SBC_SIMD_X86 == TRUE)
+    case SBC_ANALYSIS_SSE2:
+      if (!__builtin_cpu_supports("sse2")) return NULL;
+      SbcInitCoeffsX86();
+      return &sbc_analysis_kernels_sse2;
+    case SBC_ANALYSIS_AVX2:
+      if (!__builtin_cpu_supports("avx2")) return NULL;
+      SbcInitCoeffsX86();
+      return &sbc_analysis_kernels_avx2;
+#endif
+#if (SBC_SIMD_NEON == TRUE)
+    case SBC_ANALYSIS_NEON:
+      return &sbc_analysis_kernels_neon;
+#endif
+    default:
+      return NULL;
+  }
+}
+
+#endif /* SBC_ANALYSIS_KERNELS */
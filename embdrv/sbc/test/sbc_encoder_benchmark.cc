@@ -0,0 +1,65 @@
+/******************************************************************************
+ * Copyright (c) 2026 Qualcomm Innovation Center, Inc. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ *
+ *******************************************************************************/
+
+#include <benchmark/benchmark.h>
+#include <string.h>
+#include <random>
+#include <string>
+
+#include "sbc_encoder.h"
+
+using ::benchmark::State;
+
+static const char* const kImplNames[] = {"c", "sse2", "avx2", "neon"};
+static const char* const kModeNames[] = {"mono", "dual", "stereo", "joint"};
+
+// Encodes frames of noise at the A2DP high quality bitrate. The arguments
+// are the analysis filter implementation, the number of subbands, the number
+// of blocks and the channel mode; the items processed are frames.
+static void BM_SbcEncode(State& state) {
+  tSBC_ANALYSIS_IMPL impl = static_cast<tSBC_ANALYSIS_IMPL>(state.range(0));
+  if (!SBC_SetAnalysisImpl(impl)) {
+    state.SkipWithError("analysis filter not supported");
+    return;
+  }
+
+  SBC_ENC_PARAMS params;
+  memset(&params, 0, sizeof(params));
+  params.s16SamplingFreq = SBC_sf44100;
+  params.s16NumOfSubBands = state.range(1);
+  params.s16NumOfBlocks = state.range(2);
+  params.s16ChannelMode = state.range(3);
+  params.s16AllocationMethod = SBC_LOUDNESS;
+  params.u16BitRate = 328;
+  SBC_Encoder_Init(&params);
+
+  int16_t pcm[SBC_MAX_NUM_OF_CHANNELS * SBC_MAX_NUM_OF_SUBBANDS *
+              SBC_MAX_NUM_OF_BLOCKS];
+  uint8_t frame[1024];
+  std::mt19937 generator(0x5bc);
+  for (auto& sample : pcm) sample = generator();
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(SBC_Encode(&params, pcm, frame));
+  }
+  state.SetItemsProcessed(state.iterations());
+  state.SetLabel(std::string(kImplNames[impl]) + "/" +
+                 kModeNames[params.s16ChannelMode]);
+}
+
+static void SbcEncodeArgs(benchmark::internal::Benchmark* b) {
+  for (int impl = SBC_ANALYSIS_C; impl <= SBC_ANALYSIS_NEON; impl++)
+    for (int subbands : {SUB_BANDS_4, SUB_BANDS_8})
+      for (int blocks : {SBC_BLOCK_0, SBC_BLOCK_1, SBC_BLOCK_2, SBC_BLOCK_3})
+        for (int mode = SBC_MONO; mode <= SBC_JOINT_STEREO; mode++)
+          b->Args({impl, subbands, blocks, mode});
+}
+
+BENCHMARK(BM_SbcEncode)
+    ->ArgNames({"impl", "subbands", "blocks", "mode"})
+    ->Apply(SbcEncodeArgs);
+
+BENCHMARK_MAIN();
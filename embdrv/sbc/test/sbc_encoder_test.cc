@@ -0,0 +1,171 @@
+/******************************************************************************
+ * Copyright (c) 2026 Qualcomm Innovation Center, Inc. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ *
+ *******************************************************************************/
+
+#include <gtest/gtest.h>
+#include <string.h>
+#include <random>
+#include <vector>
+
+#include "sbc_encoder.h"
+extern "C" {
+#include "sbc_enc_func_declare.h"
+}
+
+static const tSBC_ANALYSIS_IMPL kSimdImpls[] = {
+    SBC_ANALYSIS_SSE2, SBC_ANALYSIS_AVX2, SBC_ANALYSIS_NEON};
+
+// Samples of noise, with full scale values mixed in to reach the extremes of
+// the sums.
+static void fill_samples(std::mt19937& generator, int16_t* samples,
+                         size_t count) {
+  for (size_t i = 0; i < count; i++) {
+    switch (generator() % 8) {
+      case 0:
+        samples[i] = INT16_MAX;
+        break;
+      case 1:
+        samples[i] = INT16_MIN;
+        break;
+      default:
+        samples[i] = generator();
+        break;
+    }
+  }
+}
+
+class SbcEncoderTest : public ::testing::Test {
+ protected:
+  void TearDown() override { SBC_SetAnalysisImpl(SBC_ANALYSIS_C); }
+};
+
+TEST_F(SbcEncoderTest, test_window_kernels_bit_exact) {
+  const tSBC_ANALYSIS_KERNELS* c = &sbc_analysis_kernels_c;
+  std::mt19937 generator(0x5bc);
+
+  for (tSBC_ANALYSIS_IMPL impl : kSimdImpls) {
+    const tSBC_ANALYSIS_KERNELS* simd = SbcAnalysisSimdKernels(impl);
+    if (simd == NULL) continue;
+
+    for (int i = 0; i < 1000; i++) {
+      int16_t x[10 * SUB_BANDS_8];
+      int32_t expected[2 * SUB_BANDS_8], actual[2 * SUB_BANDS_8];
+      fill_samples(generator, x, 10 * SUB_BANDS_8);
+
+      c->window4(x, expected);
+      simd->window4(x, actual);
+      ASSERT_EQ(0, memcmp(expected, actual, 2 * SUB_BANDS_4 * sizeof(int32_t)))
+          << "impl " << impl;
+
+      c->window8(x, expected);
+      simd->window8(x, actual);
+      ASSERT_EQ(0, memcmp(expected, actual, 2 * SUB_BANDS_8 * sizeof(int32_t)))
+          << "impl " << impl;
+    }
+  }
+}
+
+// Every count of DCTs is checked, as the kernels compute several side by side
+// and finish the ones left one vector at a time.
+TEST_F(SbcEncoderTest, test_dct_kernels_bit_exact) {
+  const int kMaxCount = SBC_MAX_NUM_OF_BLOCKS * SBC_MAX_NUM_OF_CHANNELS;
+  const tSBC_ANALYSIS_KERNELS* c = &sbc_analysis_kernels_c;
+  std::mt19937 generator(0x5bc);
+
+  // The inputs of the DCTs are outputs of the windowing
+  int16_t x[10 * SUB_BANDS_8];
+  std::vector<int32_t> y4(kMaxCount * 2 * SUB_BANDS_4);
+  std::vector<int32_t> y8(kMaxCount * 2 * SUB_BANDS_8);
+  for (int i = 0; i < kMaxCount; i++) {
+    fill_samples(generator, x, 10 * SUB_BANDS_8);
+    c->window4(x, &y4[i * 2 * SUB_BANDS_4]);
+    c->window8(x, &y8[i * 2 * SUB_BANDS_8]);
+  }
+
+  for (tSBC_ANALYSIS_IMPL impl : kSimdImpls) {
+    const tSBC_ANALYSIS_KERNELS* simd = SbcAnalysisSimdKernels(impl);
+    if (simd == NULL) continue;
+
+    for (int count = 1; count <= kMaxCount; count++) {
+      std::vector<int32_t> expected(count * SUB_BANDS_8);
+      std::vector<int32_t> actual(count * SUB_BANDS_8);
+
+      c->dct4(y4.data(), expected.data(), count);
+      simd->dct4(y4.data(), actual.data(), count);
+      ASSERT_EQ(0, memcmp(expected.data(), actual.data(),
+                          count * SUB_BANDS_4 * sizeof(int32_t)))
+          << "impl " << impl << " count " << count;
+
+      c->dct8(y8.data(), expected.data(), count);
+      simd->dct8(y8.data(), actual.data(), count);
+      ASSERT_EQ(0, memcmp(expected.data(), actual.data(),
+                          count * SUB_BANDS_8 * sizeof(int32_t)))
+          << "impl " << impl << " count " << count;
+    }
+  }
+}
+
+// Encodes the same audio with the C analysis filter and with |impl|, and
+// checks that the subband samples and the frames are the same.
+static void expect_encoder_bit_exact(tSBC_ANALYSIS_IMPL impl, int16_t subbands,
+                                     int16_t blocks, int16_t mode,
+                                     int16_t allocation) {
+  const int kFrames = 50;
+  const size_t kSamples =
+      SBC_MAX_NUM_OF_CHANNELS * SBC_MAX_NUM_OF_SUBBANDS * SBC_MAX_NUM_OF_BLOCKS;
+  std::vector<int16_t> pcm(kFrames * kSamples);
+  std::mt19937 generator(subbands * 1000 + blocks * 10 + mode);
+  fill_samples(generator, pcm.data(), pcm.size());
+
+  SBC_ENC_PARAMS params[2];
+  const tSBC_ANALYSIS_IMPL impls[2] = {SBC_ANALYSIS_C, impl};
+  uint8_t frames[2][kFrames][1024];
+  uint32_t lengths[2][kFrames];
+  int32_t sb_samples[2][kFrames][sizeof(params[0].s32SbBuffer) /
+                                 sizeof(int32_t)];
+
+  for (int i = 0; i < 2; i++) {
+    ASSERT_TRUE(SBC_SetAnalysisImpl(impls[i]));
+    memset(&params[i], 0, sizeof(params[i]));
+    params[i].s16SamplingFreq = SBC_sf44100;
+    params[i].s16NumOfSubBands = subbands;
+    params[i].s16NumOfBlocks = blocks;
+    params[i].s16ChannelMode = mode;
+    params[i].s16AllocationMethod = allocation;
+    params[i].u16BitRate = 328;
+    SBC_Encoder_Init(&params[i]);
+
+    for (int f = 0; f < kFrames; f++) {
+      lengths[i][f] =
+          SBC_Encode(&params[i], &pcm[f * kSamples], frames[i][f]);
+      memcpy(sb_samples[i][f], params[i].s32SbBuffer,
+             sizeof(sb_samples[i][f]));
+    }
+  }
+
+  for (int f = 0; f < kFrames; f++) {
+    SCOPED_TRACE(testing::Message() << "impl " << impl << " subbands "
+                                    << subbands << " blocks " << blocks
+                                    << " mode " << mode << " frame " << f);
+    ASSERT_EQ(0, memcmp(sb_samples[0][f], sb_samples[1][f],
+                        sizeof(sb_samples[0][f])));
+    ASSERT_EQ(lengths[0][f], lengths[1][f]);
+    ASSERT_EQ(0, memcmp(frames[0][f], frames[1][f], lengths[0][f]));
+  }
+}
+
+TEST_F(SbcEncoderTest, test_encoder_bit_exact) {
+  for (tSBC_ANALYSIS_IMPL impl : kSimdImpls) {
+    if (SbcAnalysisSimdKernels(impl) == NULL) continue;
+
+    for (int16_t subbands : {SUB_BANDS_4, SUB_BANDS_8})
+      for (int16_t blocks :
+           {SBC_BLOCK_0, SBC_BLOCK_1, SBC_BLOCK_2, SBC_BLOCK_3})
+        for (int16_t mode = SBC_MONO; mode <= SBC_JOINT_STEREO; mode++)
+          for (int16_t allocation : {SBC_LOUDNESS, SBC_SNR})
+            expect_encoder_bit_exact(impl, subbands, blocks, mode,
+                                     allocation);
+  }
+}
@@ -0,0 +1,72 @@
+/******************************************************************************
+ * Copyright (c) 2026 Qualcomm Innovation Center, Inc. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ *
+ *******************************************************************************/
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Ring of captured HCI packets, between the thread capturing them and the
+// btsnoop writer thread.
+//
+// Producer and consumer do not lock each other out: a packet is copied in
+// place and published by a single atomic store. Producers are serialized by a
+// spin lock, which is never contended as long as each ring is fed by a single
+// thread. When the ring is full the packet is dropped and counted.
+
+// A captured packet, followed by |length| bytes of data (and the spare room
+// asked for in |btsnoop_ring_push|).
+typedef struct {
+  uint64_t timestamp_us;
+  // Packets dropped by the ring before this one was pushed
+  uint32_t dropped_packets;
+  uint32_t length;
+  // Bytes of room for the data, |length| and the spare room
+  uint32_t room;
+  uint16_t event;
+  bool is_received;
+} btsnoop_record_t;
+
+typedef struct btsnoop_ring_t btsnoop_ring_t;
+
+// Returns a new ring of |size| bytes, which must be a multiple of 8. The
+// caller frees it with |btsnoop_ring_free|.
+btsnoop_ring_t* btsnoop_ring_new(size_t size);
+
+void btsnoop_ring_free(btsnoop_ring_t* ring);
+
+// Copies the |length| bytes at |data| into a new record, with |spare| more
+// bytes of room after them. Returns false, and counts the packet as dropped,
+// if the ring has no room for it.
+bool btsnoop_ring_push(btsnoop_ring_t* ring, uint64_t timestamp_us,
+                       uint16_t event, bool is_received, const uint8_t* data,
+                       size_t length, size_t spare);
+
+// Returns the data of |record|, which the consumer may modify.
+static inline uint8_t* btsnoop_record_data(btsnoop_record_t* record) {
+  return (uint8_t*)(record + 1);
+}
+
+// Position of the oldest record of the ring, for the consumer.
+uint64_t btsnoop_ring_begin(const btsnoop_ring_t* ring);
+
+// Returns the record at |*position| and moves |*position| past it, or returns
+// NULL if no record has been pushed there yet. Records stay valid until they
+// are released.
+btsnoop_record_t* btsnoop_ring_next(btsnoop_ring_t* ring, uint64_t* position);
+
+// Gives the room of all the records before |position| back to producers.
+void btsnoop_ring_release(btsnoop_ring_t* ring, uint64_t position);
+
+// Bytes in use, including the room lost to wrapping.
+size_t btsnoop_ring_used(const btsnoop_ring_t* ring);
+
+size_t btsnoop_ring_size(const btsnoop_ring_t* ring);
+
+// Packets and bytes dropped since the ring was created.
+uint32_t btsnoop_ring_dropped_packets(const btsnoop_ring_t* ring);
+uint64_t btsnoop_ring_dropped_bytes(const btsnoop_ring_t* ring);
@@ -46,6 +46,8 @@ typedef enum {
 /* Message event ID passed from Host/Controller lib to stack */
 #define MSG_HC_TO_STACK_HCI_ERR 0x1300      /* eq. BT_EVT_TO_BTU_HCIT_ERR */
 #define MSG_HC_TO_STACK_HCI_ACL 0x1100      /* eq. BT_EVT_TO_BTU_HCI_ACL */
+/* eq. BT_EVT_TO_BTU_HCI_ACL_CHAINED */
+#define MSG_HC_TO_STACK_HCI_ACL_CHAINED (0x0001 | MSG_HC_TO_STACK_HCI_ACL)
 #define MSG_HC_TO_STACK_HCI_SCO 0x1200      /* eq. BT_EVT_TO_BTU_HCI_SCO */
 #define MSG_HC_TO_STACK_HCI_EVT 0x1000      /* eq. BT_EVT_TO_BTU_HCI_EVT */
 #define MSG_HC_TO_STACK_L2C_SEG_XMIT 0x1900 /* BT_EVT_TO_BTU_L2C_SEG_XMIT */
@@ -39,6 +39,16 @@ typedef struct {
   transmit_finished_cb transmit_finished;
 } packet_fragmenter_callbacks_t;
 
+typedef enum {
+  // A buffer for the full packet is allocated when the start fragment
+  // arrives and every continuation fragment is copied into it on arrival.
+  PACKET_FRAGMENTER_REASSEMBLY_COPY,
+  // Fragments are chained as they arrive and the packet is handed up as a
+  // MSG_HC_TO_STACK_HCI_ACL_CHAINED buffer, left for L2CAP to copy into a
+  // single buffer when it needs one.
+  PACKET_FRAGMENTER_REASSEMBLY_CHAIN,
+} packet_fragmenter_reassembly_mode_t;
+
 typedef struct packet_fragmenter_t {
   // Initialize the fragmenter, specifying the |result_callbacks|.
   void (*init)(const packet_fragmenter_callbacks_t* result_callbacks);
@@ -53,7 +63,8 @@ typedef struct packet_fragmenter_t {
   // Otherwise
   // holds onto it until all fragments arrive, at which point the reassembled
   // callback is called
-  // with the reassembled data.
+  // with the reassembled data. In chain mode, a packet received in several
+  // fragments is handed up as a chain of them.
   void (*reassemble_and_dispatch)(BT_HDR* packet);
 } packet_fragmenter_t;
 
@@ -62,3 +73,10 @@ const packet_fragmenter_t* packet_fragmenter_get_interface();
 const packet_fragmenter_t* packet_fragmenter_get_test_interface(
     const controller_t* controller_interface,
     const allocator_t* buffer_allocator_interface);
+
+// Selects how ACL packets are reassembled. Must not be called while a packet
+// is partially reassembled, i.e. only before |init| or after |cleanup|. If not
+// called, the mode is read from the "persist.bluetooth.acl_reassembly"
+// property ("copy" or "chain") on |init|, defaulting to chaining.
+void packet_fragmenter_set_reassembly_mode(
+    packet_fragmenter_reassembly_mode_t mode);
@@ -27,6 +27,7 @@
 #include <inttypes.h>
 #include <limits.h>
 #include <netinet/in.h>
+#include <pthread.h>
 #include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -35,6 +36,8 @@
 #include <sys/time.h>
 #include <sys/uio.h>
 #include <unistd.h>
+#include <atomic>
+#include <condition_variable>
 #include <mutex>
 #include <unordered_map>
 #include <unordered_set>
@@ -42,6 +45,7 @@
 #include "bt_types.h"
 #include "hci/include/btsnoop.h"
 #include "hci/include/btsnoop_mem.h"
+#include "hci/include/btsnoop_ring.h"
 #include "hci_layer.h"
 #include "internal_include/bt_trace.h"
 #include "osi/include/log.h"
@@ -86,6 +90,16 @@
   #define DEFAULT_BTSNOOP_PATH "btsnoop_hci.log"
 #endif  //OFF_TARGET_TEST_ENABLED
 #define BTSNOOP_MAX_PACKETS_PROPERTY "persist.bluetooth.btsnoopsize"
+#define BTSNOOP_ASYNC_PROPERTY "persist.bluetooth.btsnoopasync"
+
+// Bytes of captured packets each direction can hold for the writer thread.
+// Packets captured while it is full are dropped.
+#define BTSNOOP_RING_SIZE (256 * 1024)
+// Longest time captured packets wait for the writer thread, which is also
+// woken up early once a ring is half full.
+#define BTSNOOP_FLUSH_INTERVAL_MS 20
+// Most packets written by a single writev()
+#define BTSNOOP_WRITE_BATCH 64
 
 typedef enum {
   kCommandPacket = 1,
@@ -360,6 +374,20 @@ static bool is_btsnoop_enabled;
 static bool is_btsnoop_filtered;
 bool is_vndbtsnoop_enabled = false;
 
+// Packets captured on each side of the HCI, indexed by |is_received|, while
+// the writer thread writes them to the logs. When it is not running packets
+// are written as they are captured.
+static btsnoop_ring_t* capture_rings[2];
+static std::atomic<bool> async_capture(false);
+
+static pthread_t writer_thread;
+static bool writer_thread_valid = false;
+static std::atomic<bool> writer_running(false);
+static std::atomic<bool> writer_woken(false);
+static std::mutex writer_mutex;
+static std::condition_variable writer_cv;
+static uint32_t logged_dropped_packets;
+
 // TODO(zachoverflow): merge btsnoop and btsnoop_net together
 void btsnoop_net_open();
 void btsnoop_net_close();
@@ -371,7 +399,15 @@ static std::string get_btsnoop_log_path(bool filtered);
 static std::string get_btsnoop_last_log_path(std::string log_path);
 static void open_next_snoop_file();
 static void btsnoop_write_packet(packet_type_t type, uint8_t* packet,
-                                 bool is_received, uint64_t timestamp_us);
+                                 bool is_received, uint64_t timestamp_us,
+                                 uint32_t dropped_packets, bool batched);
+static void write_captured_packet(uint16_t event, uint8_t* packet,
+                                  bool is_received, uint64_t timestamp_us,
+                                  uint32_t dropped_packets, bool batched);
+static void start_writer_thread();
+static void stop_writer_thread();
+static void flush_capture_rings();
+static void request_capture_flush();
 
 // Module lifecycle functions
 
@@ -496,6 +532,10 @@ static future_t* start_up() {
                                               DEFAULT_BTSNOOP_SIZE);
     btsnoop_net_open();
     START_SNOOP_LOGGING();
+
+    if (osi_property_get_bool(BTSNOOP_ASYNC_PROPERTY, true)) {
+      start_writer_thread();
+    }
   }
   LOG_DEBUG(LOG_TAG, "%s: vendor_logging_level values is %d ", __func__, vendor_logging_level);
 
@@ -503,7 +543,11 @@ static future_t* start_up() {
 }
 
 static future_t* shut_down(void) {
+  // Write what the writer thread left behind
+  stop_writer_thread();
+
   std::lock_guard<std::mutex> lock(btsnoop_mutex);
+
 #if (OFF_TARGET_TEST_ENABLED == FALSE)
   if (is_btsnoop_enabled) {
     if (is_btsnoop_filtered) {
@@ -535,9 +579,46 @@ EXPORT_SYMBOL extern const module_t btsnoop_module = {
     .dependencies = {STACK_CONFIG_MODULE, NULL}};
 
 // Interface functions
+static uint64_t btsnoop_timestamp_us() {
+  struct timespec ts_now = {};
+  clock_gettime(CLOCK_REALTIME, &ts_now);
+  uint64_t timestamp_us =
+      ((uint64_t)ts_now.tv_sec * 1000000L) + ((uint64_t)ts_now.tv_nsec / 1000);
+
+  if (gmt_offset >= 0) {
+    timestamp_us  += ((uint64_t) gmt_offset * 1000000LL);
+  } else {
+    /* when gmt_offset negative, adding offset to timestamp leads to
+     * integer overflow , we need to subtract positive offset to avoid overflow
+     */
+    timestamp_us -= ((uint64_t) tmp_gmt_offset * 1000000LL);
+  }
+  return timestamp_us;
+}
+
+static void wake_writer() {
+  // A wake up racing with the start of the wait is only late by one interval
+  if (!writer_woken.exchange(true)) writer_cv.notify_one();
+}
+
 static void capture(const BT_HDR* buffer, bool is_received) {
   uint8_t *p = 0;
 
+  if (async_capture) {
+    uint64_t timestamp_us = btsnoop_timestamp_us();
+    btsnoop_mem_capture(buffer, timestamp_us);
+
+    // The copy is filtered by the writer thread, with room for the magic
+    // string written by the profile filter.
+    size_t spare =
+        (vendor_logging_level & HCI_SNOOP_LOG_PROFILEFILTER) ? EXTRA_BUF_SIZE : 0;
+    btsnoop_ring_t* ring = capture_rings[is_received];
+    btsnoop_ring_push(ring, timestamp_us, buffer->event, is_received,
+                      buffer->data + buffer->offset, buffer->len, spare);
+    if (btsnoop_ring_used(ring) > btsnoop_ring_size(ring) / 2) wake_writer();
+    return;
+  }
+
   if (vendor_logging_level & HCI_SNOOP_LOG_PROFILEFILTER &&
         (profile_filter_mode == FILTER_MODE_MAGIC ||
           profile_filter_mode == FILTER_MODE_HEADER)) {
@@ -560,46 +641,44 @@ static void capture(const BT_HDR* buffer, bool is_received) {
 
   std::lock_guard<std::mutex> lock(btsnoop_mutex);
 
-  struct timespec ts_now = {};
-  clock_gettime(CLOCK_REALTIME, &ts_now);
-  uint64_t timestamp_us =
-      ((uint64_t)ts_now.tv_sec * 1000000L) + ((uint64_t)ts_now.tv_nsec / 1000);
-
-  if (gmt_offset >= 0) {
-    timestamp_us  += ((uint64_t) gmt_offset * 1000000LL);
-  } else {
-    /* when gmt_offset negative, adding offset to timestamp leads to
-     * integer overflow , we need to subtract positive offset to avoid overflow
-     */
-    timestamp_us -= ((uint64_t) tmp_gmt_offset * 1000000LL);
-  }
+  uint64_t timestamp_us = btsnoop_timestamp_us();
 
   btsnoop_mem_capture(buffer, timestamp_us);
 
   if (logfile_fd == INVALID_FD) return;
 
-  switch (buffer->event & MSG_EVT_MASK) {
+  write_captured_packet(buffer->event, p, is_received, timestamp_us, 0, false);
+
+  if (vendor_logging_level & HCI_SNOOP_LOG_PROFILEFILTER &&
+          (profile_filter_mode == FILTER_MODE_MAGIC ||
+            profile_filter_mode == FILTER_MODE_HEADER) && p != packet) {
+    buffer_allocator_get_interface()->free(p);
+  }
+}
+
+static void write_captured_packet(uint16_t event, uint8_t* p,
+                                  bool is_received, uint64_t timestamp_us,
+                                  uint32_t dropped_packets, bool batched) {
+  switch (event & MSG_EVT_MASK) {
     case MSG_HC_TO_STACK_HCI_EVT:
-      btsnoop_write_packet(kEventPacket, p, false, timestamp_us);
+      btsnoop_write_packet(kEventPacket, p, false, timestamp_us,
+                           dropped_packets, batched);
       break;
     case MSG_HC_TO_STACK_HCI_ACL:
     case MSG_STACK_TO_HC_HCI_ACL:
-      btsnoop_write_packet(kAclPacket, p, is_received, timestamp_us);
+      btsnoop_write_packet(kAclPacket, p, is_received, timestamp_us,
+                           dropped_packets, batched);
       break;
     case MSG_HC_TO_STACK_HCI_SCO:
     case MSG_STACK_TO_HC_HCI_SCO:
-      btsnoop_write_packet(kScoPacket, p, is_received, timestamp_us);
+      btsnoop_write_packet(kScoPacket, p, is_received, timestamp_us,
+                           dropped_packets, batched);
       break;
     case MSG_STACK_TO_HC_HCI_CMD:
-      btsnoop_write_packet(kCommandPacket, p, true, timestamp_us);
+      btsnoop_write_packet(kCommandPacket, p, true, timestamp_us,
+                           dropped_packets, batched);
       break;
   }
-
-  if (vendor_logging_level & HCI_SNOOP_LOG_PROFILEFILTER &&
-          (profile_filter_mode == FILTER_MODE_MAGIC ||
-            profile_filter_mode == FILTER_MODE_HEADER) && p != packet) {
-    buffer_allocator_get_interface()->free(p);
-  }
 }
 
 static void whitelist_l2c_channel(uint16_t conn_handle, uint16_t local_cid,
@@ -607,6 +686,9 @@ static void whitelist_l2c_channel(uint16_t conn_handle, uint16_t local_cid,
   LOG(INFO) << __func__
             << ": Whitelisting l2cap channel. conn_handle=" << conn_handle
             << " cid=" << local_cid << ":" << remote_cid;
+
+  request_capture_flush();
+
 #if (OFF_TARGET_TEST_ENABLED == FALSE)
   std::lock_guard lock(filter_list_mutex);
 #else
@@ -622,6 +704,9 @@ static void whitelist_rfc_dlci(uint16_t local_cid, uint8_t dlci) {
   LOG(INFO) << __func__
             << ": Whitelisting rfcomm channel. L2CAP CID=" << local_cid
             << " DLCI=" << dlci;
+
+  request_capture_flush();
+
 #if (OFF_TARGET_TEST_ENABLED == FALSE)
   std::lock_guard lock(filter_list_mutex);
 #else
@@ -640,6 +725,9 @@ static void add_rfc_l2c_channel(uint16_t conn_handle, uint16_t local_cid,
             << ": rfcomm data going over l2cap channel. conn_handle="
             << conn_handle << " cid=" << local_cid << ":"
             << remote_cid;
+
+  request_capture_flush();
+
 #if (OFF_TARGET_TEST_ENABLED == FALSE)
   std::lock_guard lock(filter_list_mutex);
 #else
@@ -656,6 +744,8 @@ static void clear_l2cap_whitelist(uint16_t conn_handle, uint16_t local_cid,
             << ": Clearing whitelist from l2cap channel. conn_handle="
             << conn_handle << " cid=" << local_cid << ":" << remote_cid;
 
+  request_capture_flush();
+
 #if (OFF_TARGET_TEST_ENABLED == FALSE)
   std::lock_guard lock(filter_list_mutex);
 #else
@@ -785,6 +875,8 @@ static void set_rfc_port_open(uint16_t handle, uint16_t local_cid,
   if (!(vendor_logging_level & HCI_SNOOP_LOG_PROFILEFILTER))
     return;
 
+  request_capture_flush();
+
   profile_type_t profile = FILTER_PROFILE_NONE;
 #if (OFF_TARGET_TEST_ENABLED == FALSE)
   std::lock_guard lock(profiles_filter_mutex);
@@ -819,6 +911,8 @@ static void set_rfc_port_close(uint16_t handle, uint16_t local_cid,
   if (!(vendor_logging_level & HCI_SNOOP_LOG_PROFILEFILTER))
     return;
 
+  request_capture_flush();
+
 #if (OFF_TARGET_TEST_ENABLED == FALSE)
   std::lock_guard lock(profiles_filter_mutex);
 #else
@@ -838,6 +932,8 @@ static void set_l2cap_channel_open(uint16_t handle, uint16_t local_cid,
   if (!(vendor_logging_level & HCI_SNOOP_LOG_PROFILEFILTER))
     return;
 
+  request_capture_flush();
+
   profile_type_t profile = FILTER_PROFILE_NONE;
 #if (OFF_TARGET_TEST_ENABLED == FALSE)
   std::lock_guard lock(profiles_filter_mutex);
@@ -870,6 +966,8 @@ static void set_l2cap_channel_close(uint16_t handle, uint16_t local_cid, uint16_
   if (!(vendor_logging_level & HCI_SNOOP_LOG_PROFILEFILTER))
     return;
 
+  request_capture_flush();
+
 #if (OFF_TARGET_TEST_ENABLED == FALSE)
   std::lock_guard lock(profiles_filter_mutex);
 #else
@@ -1036,11 +1134,62 @@ static bool should_filter_log(bool is_received, uint8_t* packet) {
   return false;
 }
 
+// Packets waiting for a single writev() to the log file, only accessed with
+// |btsnoop_mutex| held.
+static struct {
+  btsnoop_header_t headers[BTSNOOP_WRITE_BATCH];
+  iovec iov[2 * BTSNOOP_WRITE_BATCH];
+  size_t count;
+} write_batch;
+
+static void btsnoop_writev(iovec* iov, int iovcnt) {
+  struct pollfd fds;
+  fds.fd = logfile_fd;
+  fds.events = POLLOUT;
+
+  int status = poll(&fds, 1, 0);
+  if (status == 0) {
+    LOG_WARN(LOG_TAG, "%s poll() timeout", __func__);
+    return;
+  } else if (status == -1) {
+    LOG_ERROR(LOG_TAG, "%s poll failed errno %d (%s)",
+                  __func__, errno, strerror(errno));
+    return;
+  } else if (!(fds.revents & POLLOUT)) {
+    return;
+  }
+
+  // A socket may take part of a batch only, the rest must follow so that
+  // records are not cut
+  while (iovcnt > 0) {
+    ssize_t written = TEMP_FAILURE_RETRY(writev(logfile_fd, iov, iovcnt));
+    if (written <= 0) return;
+
+    while (iovcnt > 0 && (size_t)written >= iov->iov_len) {
+      written -= iov->iov_len;
+      iov++;
+      iovcnt--;
+    }
+    if (iovcnt > 0) {
+      iov->iov_base = (uint8_t*)iov->iov_base + written;
+      iov->iov_len -= written;
+    }
+  }
+}
+
+static void btsnoop_write_batch() {
+  if (write_batch.count == 0) return;
+
+  if (logfile_fd != INVALID_FD)
+    btsnoop_writev(write_batch.iov, 2 * write_batch.count);
+  write_batch.count = 0;
+}
+
 static void btsnoop_write_packet(packet_type_t type, uint8_t* packet,
-                                 bool is_received, uint64_t timestamp_us) {
+                                 bool is_received, uint64_t timestamp_us,
+                                 uint32_t dropped_packets, bool batched) {
   uint32_t length_he = 0;
   uint32_t flags = 0;
-  int status = 0;
 
   switch (type) {
     case kCommandPacket:
@@ -1076,7 +1225,7 @@ static void btsnoop_write_packet(packet_type_t type, uint8_t* packet,
       blacklisted ? htonl(L2C_HEADER_SIZE) : header.length_original;
   if (blacklisted) length_he = L2C_HEADER_SIZE;
   header.flags = htonl(flags);
-  header.dropped_packets = 0;
+  header.dropped_packets = htonl(dropped_packets);
   header.timestamp = htonll(timestamp_us + BTSNOOP_EPOCH_DELTA);
   header.type = type;
 
@@ -1086,27 +1235,147 @@ static void btsnoop_write_packet(packet_type_t type, uint8_t* packet,
   if (logfile_fd != INVALID_FD) {
     packet_counter++;
     if (!sock_snoop_active && packet_counter > packets_per_file) {
+      // Packets batched so far belong to the previous file
+      btsnoop_write_batch();
       open_next_snoop_file();
     }
 
-    struct pollfd fds;
-    fds.fd = logfile_fd;
-    fds.events = POLLOUT;
+    if (batched) {
+      size_t i = write_batch.count++;
+      write_batch.headers[i] = header;
+      write_batch.iov[2 * i] = {&write_batch.headers[i],
+                                sizeof(btsnoop_header_t)};
+      write_batch.iov[2 * i + 1] = {reinterpret_cast<void*>(packet),
+                                    length_he - 1};
+      if (write_batch.count == BTSNOOP_WRITE_BATCH) btsnoop_write_batch();
+      return;
+    }
+
     iovec iov[] = {{&header, sizeof(btsnoop_header_t)},
                    {reinterpret_cast<void*>(packet), length_he - 1}};
+    btsnoop_writev(iov, 2);
+  }
+}
+
+// Writes the packets of the capture rings to the logs, oldest first. Called
+// with |btsnoop_mutex| held, by a single thread at a time.
+static void flush_capture_rings() {
+  if (!capture_rings[0] || !capture_rings[1]) return;
+
+  uint64_t position[2], written[2];
+  btsnoop_record_t* head[2];
+  for (int i = 0; i < 2; i++) {
+    position[i] = btsnoop_ring_begin(capture_rings[i]);
+    written[i] = position[i];
+    head[i] = btsnoop_ring_next(capture_rings[i], &position[i]);
+  }
 
-    status = poll(&fds, 1, 0);
-    if(status > 0 && fds.revents & POLLOUT) {
-      TEMP_FAILURE_RETRY(writev(logfile_fd, iov, 2));
-    } else if (status == 0) {
-      LOG_WARN(LOG_TAG, "%s poll() timeout", __func__);
-    } else if (status == -1) {
-      LOG_ERROR(LOG_TAG, "%s poll failed errno %d (%s)",
-                    __func__, errno, strerror(errno));
+  while (head[0] || head[1]) {
+    int i;
+    if (!head[0]) {
+      i = 1;
+    } else if (!head[1]) {
+      i = 0;
+    } else {
+      i = (head[1]->timestamp_us < head[0]->timestamp_us) ? 1 : 0;
     }
+
+    btsnoop_record_t* record = head[i];
+    write_captured_packet(record->event, btsnoop_record_data(record),
+                          record->is_received, record->timestamp_us,
+                          record->dropped_packets, true);
+    written[i] = position[i];
+    head[i] = btsnoop_ring_next(capture_rings[i], &position[i]);
+
+    // Records can be reused once their batch has been written
+    if (write_batch.count == 0) {
+      btsnoop_ring_release(capture_rings[0], written[0]);
+      btsnoop_ring_release(capture_rings[1], written[1]);
+    }
+  }
+
+  btsnoop_write_batch();
+  btsnoop_ring_release(capture_rings[0], written[0]);
+  btsnoop_ring_release(capture_rings[1], written[1]);
+
+  uint32_t dropped = btsnoop_ring_dropped_packets(capture_rings[0]) +
+                     btsnoop_ring_dropped_packets(capture_rings[1]);
+  if (dropped != logged_dropped_packets) {
+    LOG_WARN(LOG_TAG,
+             "%s: %u packets dropped, %" PRIu64 " tx and %" PRIu64
+             " rx bytes",
+             __func__, dropped, btsnoop_ring_dropped_bytes(capture_rings[0]),
+             btsnoop_ring_dropped_bytes(capture_rings[1]));
+    logged_dropped_packets = dropped;
   }
 }
 
+// Called before the filters change, so that the writer thread writes the
+// packets captured so far without waiting for the next interval. It is not
+// waited for: the filters are set from the stack threads, which must not block
+// on log I/O, so packets captured just before a change may be filtered by it.
+static void request_capture_flush() {
+  if (async_capture) wake_writer();
+}
+
+static void* writer_fn(UNUSED_ATTR void* context) {
+  while (writer_running) {
+    {
+      std::unique_lock<std::mutex> lock(writer_mutex);
+      writer_cv.wait_for(lock,
+                         std::chrono::milliseconds(BTSNOOP_FLUSH_INTERVAL_MS),
+                         [] { return writer_woken.load(); });
+      writer_woken = false;
+    }
+
+    std::lock_guard<std::mutex> lock(btsnoop_mutex);
+    flush_capture_rings();
+  }
+  return NULL;
+}
+
+static void start_writer_thread() {
+  for (auto& ring : capture_rings) {
+    if (!ring) ring = btsnoop_ring_new(BTSNOOP_RING_SIZE);
+
+    // Drop what was captured after the last shut down
+    uint64_t position = btsnoop_ring_begin(ring);
+    while (btsnoop_ring_next(ring, &position) != NULL) continue;
+    btsnoop_ring_release(ring, position);
+  }
+  logged_dropped_packets = btsnoop_ring_dropped_packets(capture_rings[0]) +
+                           btsnoop_ring_dropped_packets(capture_rings[1]);
+
+  writer_running = true;
+  int error = pthread_create(&writer_thread, NULL, writer_fn, NULL);
+  writer_thread_valid = (error == 0);
+  if (!writer_thread_valid) {
+    LOG_ERROR(LOG_TAG, "%s pthread_create failed: %s, writing synchronously",
+              __func__, strerror(error));
+    writer_running = false;
+    return;
+  }
+  async_capture = true;
+}
+
+static void stop_writer_thread() {
+  if (writer_thread_valid) {
+    writer_running = false;
+    wake_writer();
+    pthread_join(writer_thread, NULL);
+    writer_thread_valid = false;
+  }
+
+  // Packets keep going to the rings until they are drained, so that none is
+  // written ahead of older ones. Once |async_capture| is cleared, captures
+  // wait for |btsnoop_mutex| and are written after the packets of the rings,
+  // which are drained again for the captures that were pushing to them then.
+  std::lock_guard<std::mutex> lock(btsnoop_mutex);
+  flush_capture_rings();
+  async_capture = false;
+  flush_capture_rings();
+}
+
 void update_snoop_fd(int snoop_fd) {
   std::lock_guard<std::mutex> lock(btSnoopFd_mutex);
   LOG_INFO(LOG_TAG, "%s Now writing to server socket", __func__);
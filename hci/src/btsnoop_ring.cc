@@ -0,0 +1,176 @@
+/******************************************************************************
+ * Copyright (c) 2026 Qualcomm Innovation Center, Inc. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ *
+ *******************************************************************************/
+
+#include "hci/include/btsnoop_ring.h"
+
+#include <base/logging.h>
+#include <sched.h>
+#include <string.h>
+
+#include <atomic>
+
+#include "osi/include/allocator.h"
+
+// |room| of the record marking that the next record is at the start of the
+// buffer.
+#define WRAP_MARKER UINT32_MAX
+
+struct btsnoop_ring_t {
+  size_t size;
+  uint8_t* buffer;
+
+  // Positions only grow, the offset in |buffer| is the position modulo
+  // |size|. |write_pos| is published by the producers, |read_pos| by the
+  // consumer.
+  std::atomic<uint64_t> write_pos;
+  std::atomic<uint64_t> read_pos;
+
+  std::atomic_flag producer_lock;
+  std::atomic<uint32_t> dropped_packets;
+  std::atomic<uint64_t> dropped_bytes;
+};
+
+static size_t record_size(size_t room) {
+  return (sizeof(btsnoop_record_t) + room + 7) & ~(size_t)7;
+}
+
+btsnoop_ring_t* btsnoop_ring_new(size_t size) {
+  CHECK(size >= sizeof(btsnoop_record_t));
+  CHECK(size % 8 == 0);
+
+  btsnoop_ring_t* ring = new btsnoop_ring_t;
+  ring->size = size;
+  ring->buffer = (uint8_t*)osi_malloc(size);
+  ring->write_pos = 0;
+  ring->read_pos = 0;
+  ring->producer_lock.clear();
+  ring->dropped_packets = 0;
+  ring->dropped_bytes = 0;
+  return ring;
+}
+
+void btsnoop_ring_free(btsnoop_ring_t* ring) {
+  if (!ring) return;
+
+  osi_free(ring->buffer);
+  delete ring;
+}
+
+static void drop(btsnoop_ring_t* ring, size_t length) {
+  ring->dropped_packets.fetch_add(1, std::memory_order_relaxed);
+  ring->dropped_bytes.fetch_add(length, std::memory_order_relaxed);
+}
+
+bool btsnoop_ring_push(btsnoop_ring_t* ring, uint64_t timestamp_us,
+                       uint16_t event, bool is_received, const uint8_t* data,
+                       size_t length, size_t spare) {
+  CHECK(ring != NULL);
+
+  size_t needed = record_size(length + spare);
+  if (needed > ring->size) {
+    drop(ring, length);
+    return false;
+  }
+
+  while (ring->producer_lock.test_and_set(std::memory_order_acquire))
+    sched_yield();
+
+  uint64_t write = ring->write_pos.load(std::memory_order_relaxed);
+  uint64_t read = ring->read_pos.load(std::memory_order_acquire);
+  size_t offset = write % ring->size;
+  size_t tail_room = ring->size - offset;
+
+  // A record never wraps, the end of the buffer is skipped instead
+  size_t skip = (tail_room < needed) ? tail_room : 0;
+  if (write + skip + needed - read > ring->size) {
+    ring->producer_lock.clear(std::memory_order_release);
+    drop(ring, length);
+    return false;
+  }
+
+  if (skip != 0) {
+    // Too little room for a marker is skipped by the consumer all the same
+    if (tail_room >= sizeof(btsnoop_record_t)) {
+      btsnoop_record_t* marker = (btsnoop_record_t*)(ring->buffer + offset);
+      marker->room = WRAP_MARKER;
+    }
+    write += skip;
+    offset = 0;
+  }
+
+  btsnoop_record_t* record = (btsnoop_record_t*)(ring->buffer + offset);
+  record->timestamp_us = timestamp_us;
+  record->dropped_packets =
+      ring->dropped_packets.load(std::memory_order_relaxed);
+  record->length = length;
+  record->room = length + spare;
+  record->event = event;
+  record->is_received = is_received;
+  memcpy(btsnoop_record_data(record), data, length);
+
+  ring->write_pos.store(write + needed, std::memory_order_release);
+  ring->producer_lock.clear(std::memory_order_release);
+  return true;
+}
+
+uint64_t btsnoop_ring_begin(const btsnoop_ring_t* ring) {
+  CHECK(ring != NULL);
+
+  return ring->read_pos.load(std::memory_order_relaxed);
+}
+
+btsnoop_record_t* btsnoop_ring_next(btsnoop_ring_t* ring, uint64_t* position) {
+  CHECK(ring != NULL);
+  CHECK(position != NULL);
+
+  uint64_t write = ring->write_pos.load(std::memory_order_acquire);
+  while (*position != write) {
+    size_t offset = *position % ring->size;
+    size_t tail_room = ring->size - offset;
+    btsnoop_record_t* record = (btsnoop_record_t*)(ring->buffer + offset);
+
+    if (tail_room < sizeof(btsnoop_record_t) || record->room == WRAP_MARKER) {
+      *position += tail_room;
+      continue;
+    }
+
+    *position += record_size(record->room);
+    return record;
+  }
+
+  return NULL;
+}
+
+void btsnoop_ring_release(btsnoop_ring_t* ring, uint64_t position) {
+  CHECK(ring != NULL);
+
+  ring->read_pos.store(position, std::memory_order_release);
+}
+
+size_t btsnoop_ring_used(const btsnoop_ring_t* ring) {
+  CHECK(ring != NULL);
+
+  return ring->write_pos.load(std::memory_order_acquire) -
+         ring->read_pos.load(std::memory_order_acquire);
+}
+
+size_t btsnoop_ring_size(const btsnoop_ring_t* ring) {
+  CHECK(ring != NULL);
+
+  return ring->size;
+}
+
+uint32_t btsnoop_ring_dropped_packets(const btsnoop_ring_t* ring) {
+  CHECK(ring != NULL);
+
+  return ring->dropped_packets.load(std::memory_order_relaxed);
+}
+
+uint64_t btsnoop_ring_dropped_bytes(const btsnoop_ring_t* ring) {
+  CHECK(ring != NULL);
+
+  return ring->dropped_bytes.load(std::memory_order_relaxed);
+}
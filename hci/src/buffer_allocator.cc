@@ -17,13 +17,37 @@
  ******************************************************************************/
 
 #include <base/logging.h>
+#include <mutex>
 
 #include "bt_common.h"
+#include "bt_hci_bdroid.h"
 #include "buffer_allocator.h"
+#include "hci_internals.h"
+#include "osi/include/buffer_pool.h"
+
+// Size classes backing the HCI buffer allocator. Counts are sized for a
+// few full controller buffer windows in flight; anything beyond that falls
+// back to the regular heap and is reported as a miss in the allocator dump.
+static const buffer_pool_class_t buffer_classes[] = {
+    // Complete HCI events.
+    {BT_HDR_SIZE + HCI_EVENT_PREAMBLE_SIZE + 255, 64},
+    // Commands and small control buffers.
+    {BT_SMALL_BUFFER_SIZE, 64},
+    // Single ACL fragments up to the largest (DH5/3-DH5) baseband packet.
+    {BT_HDR_SIZE + HCI_MAX_FRAME_SIZE, 128},
+    // Reassembled L2CAP SDUs up to L2CAP_MTU_SIZE and other large buffers.
+    {BT_DEFAULT_BUFFER_SIZE, 32},
+};
+
+static std::once_flag pool_init_flag;
 
 static void* buffer_alloc(size_t size) {
   CHECK(size <= BT_DEFAULT_BUFFER_SIZE);
-  return osi_malloc(size);
+  std::call_once(pool_init_flag, []() {
+    buffer_pool_init(buffer_classes,
+                     sizeof(buffer_classes) / sizeof(buffer_classes[0]));
+  });
+  return osi_pool_malloc(size);
 }
 
 static const allocator_t interface = {buffer_alloc, osi_free};
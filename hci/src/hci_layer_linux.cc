@@ -29,11 +29,14 @@
 #include <stdlib.h>
 #include <string.h>
 #include <algorithm>
+#include <vector>
 
 #include <sys/ioctl.h>
 #include <sys/socket.h>
+#include <sys/uio.h>
 #include <sys/un.h>
 
+#include "bt_target.h"
 #include "buffer_allocator.h"
 #include "hci_internals.h"
 #include "hci_layer.h"
@@ -65,6 +68,12 @@ using base::Thread;
 #define BT_EVT_HDR_SIZE 2
 #define BT_CMD_HDR_SIZE 3
 
+// Size of the buffer the STREAM socket reader parses H4 packets out of. It
+// must hold at least one packet of the largest size the stack accepts.
+#define HCI_READ_BUFFER_SIZE 16384
+// Maximum number of received packets handed up in one batch.
+#define HCI_READ_BATCH_SIZE 32
+
 struct sockaddr_hci {
   sa_family_t hci_family;
   unsigned short hci_dev;
@@ -114,166 +123,199 @@ static int rfkill_en;
 int reader_thread_ctrl_fd = -1;
 Thread* reader_thread = NULL;
 
-void monitor_socket_packet(int ctrl_fd, int fd) {
-  const allocator_t* buffer_allocator = buffer_allocator_get_interface();
-  const size_t buf_size = 2000;
-  uint8_t buf[buf_size];
-  ssize_t len = read(fd, buf, buf_size);
+// Wraps |len| octets of an HCI packet received from the controller in a
+// BT_HDR for |event|.
+static BT_HDR* wrap_packet_and_copy(const allocator_t* buffer_allocator,
+                                    uint16_t event, const uint8_t* data,
+                                    size_t len) {
+  BT_HDR* packet =
+      reinterpret_cast<BT_HDR*>(buffer_allocator->alloc(len + BT_HDR_SIZE));
+  packet->offset = 0;
+  packet->layer_specific = 0;
+  packet->len = len;
+  packet->event = event;
+  memcpy(packet->data, data, len);
+  return packet;
+}
 
-  while (len > 0) {
-    if (len == buf_size)
-      LOG(FATAL) << "This packet filled buffer, if it have continuation we "
-                    "don't know how to merge it, increase buffer size!";
-
-    uint8_t type = buf[0];
-
-    size_t packet_size = buf_size + BT_HDR_SIZE;
-    BT_HDR* packet =
-        reinterpret_cast<BT_HDR*>(buffer_allocator->alloc(packet_size));
-    packet->offset = 0;
-    packet->layer_specific = 0;
-    packet->len = len - 1;
-    memcpy(packet->data, buf + 1, len - 1);
-
-    switch (type) {
-      case HCI_PACKET_TYPE_COMMAND:
-        packet->event = MSG_HC_TO_STACK_HCI_EVT;
-        hci_event_received(FROM_HERE, packet);
-        break;
-      case HCI_PACKET_TYPE_ACL_DATA:
-        packet->event = MSG_HC_TO_STACK_HCI_ACL;
+static uint16_t event_for_packet_type(uint8_t type) {
+  switch (type) {
+    case HCI_PACKET_TYPE_COMMAND:
+      return MSG_HC_TO_STACK_HCI_EVT;
+    case HCI_PACKET_TYPE_ACL_DATA:
+      return MSG_HC_TO_STACK_HCI_ACL;
+    case HCI_PACKET_TYPE_SCO_DATA:
+      return MSG_HC_TO_STACK_HCI_SCO;
+    case HCI_PACKET_TYPE_EVENT:
+      return MSG_HC_TO_STACK_HCI_EVT;
+    default:
+      LOG(FATAL) << "Unexpected event type: " << +type;
+      return 0;
+  }
+}
+
+// Hands |count| received packets up in the order they were read, so that
+// events and data on the same connection are never reordered.
+static void dispatch_packets(BT_HDR** packets, size_t count) {
+  for (size_t i = 0; i < count; i++) {
+    BT_HDR* packet = packets[i];
+    switch (packet->event & MSG_EVT_MASK) {
+      case MSG_HC_TO_STACK_HCI_ACL:
         acl_event_received(packet);
         break;
-      case HCI_PACKET_TYPE_SCO_DATA:
-        packet->event = MSG_HC_TO_STACK_HCI_SCO;
+      case MSG_HC_TO_STACK_HCI_SCO:
         sco_data_received(packet);
         break;
-      case HCI_PACKET_TYPE_EVENT:
-        packet->event = MSG_HC_TO_STACK_HCI_EVT;
-        hci_event_received(FROM_HERE, packet);
-        break;
       default:
-        LOG(FATAL) << "Unexpected event type: " << +type;
+        hci_event_received(FROM_HERE, packet);
         break;
     }
+  }
+}
 
-    fd_set fds;
-    FD_ZERO(&fds);
-    FD_SET(ctrl_fd, &fds);
-    FD_SET(fd, &fds);
-    int res = select(std::max(fd, ctrl_fd) + 1, &fds, NULL, NULL, NULL);
-    if (res <= 0) LOG(INFO) << "Nothing more to read";
+// Blocks until |fd| has data or the reader is asked to stop through
+// |ctrl_fd|. Returns false if the reader should exit.
+static bool wait_for_data(int ctrl_fd, int fd) {
+  fd_set fds;
+  FD_ZERO(&fds);
+  FD_SET(ctrl_fd, &fds);
+  FD_SET(fd, &fds);
+  int res = select(std::max(fd, ctrl_fd) + 1, &fds, NULL, NULL, NULL);
+  if (res <= 0) LOG(INFO) << "Nothing more to read";
+
+  if (FD_ISSET(ctrl_fd, &fds)) {
+    LOG(INFO) << "exitting";
+    return false;
+  }
+  return true;
+}
 
-    if (FD_ISSET(ctrl_fd, &fds)) {
-      LOG(INFO) << "exitting";
-      return;
+// Each message on a SEQPACKET socket carries exactly one H4 packet; up to
+// HCI_READ_BATCH_SIZE of them are received with a single recvmmsg().
+void monitor_socket_packet(int ctrl_fd, int fd) {
+  const allocator_t* buffer_allocator = buffer_allocator_get_interface();
+  const size_t buf_size = 2000;
+  std::vector<uint8_t> bufs(HCI_READ_BATCH_SIZE * buf_size);
+  struct iovec iovs[HCI_READ_BATCH_SIZE];
+  struct mmsghdr msgs[HCI_READ_BATCH_SIZE];
+  BT_HDR* packets[HCI_READ_BATCH_SIZE];
+
+  memset(msgs, 0, sizeof(msgs));
+  for (size_t i = 0; i < HCI_READ_BATCH_SIZE; i++) {
+    iovs[i].iov_base = bufs.data() + i * buf_size;
+    iovs[i].iov_len = buf_size;
+    msgs[i].msg_hdr.msg_iov = &iovs[i];
+    msgs[i].msg_hdr.msg_iovlen = 1;
+  }
+
+  int count;
+  OSI_NO_INTR(count = recvmmsg(fd, msgs, HCI_READ_BATCH_SIZE, MSG_WAITFORONE,
+                               NULL));
+
+  while (count > 0) {
+    size_t packet_count = 0;
+    for (int i = 0; i < count; i++) {
+      const uint8_t* buf = static_cast<uint8_t*>(iovs[i].iov_base);
+      size_t len = msgs[i].msg_len;
+      if (len == buf_size || (msgs[i].msg_hdr.msg_flags & MSG_TRUNC))
+        LOG(FATAL) << "This packet filled buffer, if it have continuation we "
+                      "don't know how to merge it, increase buffer size!";
+      if (len == 0) continue;
+
+      packets[packet_count++] = wrap_packet_and_copy(
+          buffer_allocator, event_for_packet_type(buf[0]), buf + 1, len - 1);
     }
+    dispatch_packets(packets, packet_count);
+
+    if (!wait_for_data(ctrl_fd, fd)) return;
 
-    len = read(fd, buf, buf_size);
+    OSI_NO_INTR(count = recvmmsg(fd, msgs, HCI_READ_BATCH_SIZE,
+                                 MSG_WAITFORONE, NULL));
   }
 }
 
-static int do_read(int fd, unsigned char* buf, size_t len)
-{
-  int bytes_left = len, bytes_read = 0, read_offset = 0;
-  while(bytes_left > 0) {
-    bytes_read = read(fd, buf + read_offset, bytes_left);
-    if(bytes_read < 0) {
-       LOG(ERROR) << "read fail Error " << strerror(errno);
-      return -1;
-    } else if (bytes_read == 0) {
-      LOG(INFO) << " read returned 0, read bytes"  << (len-bytes_left) << " expected len" << len;
-      return (len - bytes_left);
-    } else {
-      if(bytes_read < bytes_left) {
-        bytes_left -= bytes_read;
-        read_offset += bytes_read;
-      } else {
-        break;
-      }
-    }
+// Returns the size of the H4 header following the packet type octet.
+static size_t h4_header_size(uint8_t type) {
+  switch (type) {
+    case HCI_PACKET_TYPE_COMMAND:
+      return BT_CMD_HDR_SIZE;
+    case HCI_PACKET_TYPE_ACL_DATA:
+      return BT_ACL_HDR_SIZE;
+    case HCI_PACKET_TYPE_SCO_DATA:
+      return BT_SCO_HDR_SIZE;
+    case HCI_PACKET_TYPE_EVENT:
+      return BT_EVT_HDR_SIZE;
+    default:
+      LOG(FATAL) << "Unexpected event type: " << +type;
+      return 0;
   }
+}
 
-  return len;
+// Returns the payload length announced by the H4 |header| of |type|.
+static size_t h4_payload_length(uint8_t type, const uint8_t* header) {
+  switch (type) {
+    case HCI_PACKET_TYPE_ACL_DATA:
+      return header[2] | (header[3] << 8);
+    case HCI_PACKET_TYPE_EVENT:
+      return header[1];
+    default:
+      // Commands and SCO data carry a one octet length after a two octet
+      // opcode or handle.
+      return header[2];
+  }
 }
 
+// Bytes read from a STREAM socket are accumulated in a buffer and every
+// complete H4 packet it holds is parsed out of it, so a single read() covers
+// as many packets as the socket has queued. A packet split across reads
+// stays at the start of the buffer until the rest of it arrives.
 void monitor_socket_stream(int ctrl_fd, int fd) {
   const allocator_t* buffer_allocator = buffer_allocator_get_interface();
-  const size_t buf_size = 2000;
-  uint8_t buf[buf_size];
-  unsigned int packet_length;
-  ssize_t len = read(fd, buf, 1);
+  std::vector<uint8_t> buf(HCI_READ_BUFFER_SIZE);
+  BT_HDR* packets[HCI_READ_BATCH_SIZE];
+  size_t end = 0;
+  ssize_t len;
+
+  OSI_NO_INTR(len = read(fd, buf.data(), buf.size()));
 
   while (len > 0) {
-    if (len == buf_size)
-      LOG(FATAL) << "This packet filled buffer, if it have continuation we "
-                    "don't know how to merge it, increase buffer size!";
-
-    uint8_t type = buf[0];
-
-    size_t packet_size = buf_size + BT_HDR_SIZE;
-    BT_HDR* packet =
-        reinterpret_cast<BT_HDR*>(buffer_allocator->alloc(packet_size));
-    packet->offset = 0;
-    packet->layer_specific = 0;
-    LOG(INFO) << "packet type:" << +type;
-    switch (type) {
-      case HCI_PACKET_TYPE_COMMAND:
-        len = do_read(fd,buf+1,BT_CMD_HDR_SIZE);
-        packet->event = MSG_HC_TO_STACK_HCI_EVT;
-        packet_length = buf[3];
-        packet->len = packet_length + BT_CMD_HDR_SIZE;
-        len = do_read(fd,buf+1,packet->len);
-        memcpy(packet->data, buf+1, packet->len);
-        hci_event_received(FROM_HERE, packet);
-        break;
-      case HCI_PACKET_TYPE_ACL_DATA:
-        len = do_read(fd,buf+1,BT_ACL_HDR_SIZE);
-        packet->event = MSG_HC_TO_STACK_HCI_ACL;
-        packet_length = (buf[4] << 8) + buf[3];
-        packet->len = packet_length + BT_ACL_HDR_SIZE;
-        LOG(INFO) << "total packet length to be read:" << packet->len;
-        LOG(INFO) << "packet_length:" << packet_length;
-        len = do_read(fd, buf+BT_ACL_HDR_SIZE+1, packet_length);
-        LOG(INFO) << "length of bytes read:" << +len;
-        memcpy(packet->data, buf+1, packet->len);
-        acl_event_received(packet);
-        break;
-      case HCI_PACKET_TYPE_SCO_DATA:
-        len = do_read(fd,buf+1,BT_SCO_HDR_SIZE);
-        packet->event = MSG_HC_TO_STACK_HCI_SCO;
-        packet_length = buf[3];
-        packet->len = packet_length + BT_CMD_HDR_SIZE;
-        len = do_read(fd,buf+1,packet->len);
-        memcpy(packet->data, buf+1, packet->len);
-        sco_data_received(packet);
-        break;
-      case HCI_PACKET_TYPE_EVENT:
-        len = do_read(fd,buf+1,BT_EVT_HDR_SIZE);
-        packet->event = MSG_HC_TO_STACK_HCI_EVT;
-        packet_length = buf[2];
-        packet->len = packet_length + BT_EVT_HDR_SIZE;
-        len = do_read(fd, buf+BT_EVT_HDR_SIZE+1, packet_length);
-        memcpy(packet->data, buf+1, packet->len);
-        hci_event_received(FROM_HERE, packet);
-        break;
-      default:
-        LOG(FATAL) << "Unexpected event type: " << +type;
-        break;
+    end += len;
+
+    size_t start = 0;
+    size_t packet_count = 0;
+    while (end - start > 0) {
+      uint8_t type = buf[start];
+      size_t header_size = h4_header_size(type);
+      if (end - start < 1 + header_size) break;
+
+      size_t packet_len =
+          header_size + h4_payload_length(type, &buf[start + 1]);
+      if (packet_len + BT_HDR_SIZE > BT_DEFAULT_BUFFER_SIZE)
+        LOG(FATAL) << "Packet of type " << +type << " too large: "
+                   << packet_len;
+      if (end - start < 1 + packet_len) break;
+
+      packets[packet_count++] =
+          wrap_packet_and_copy(buffer_allocator, event_for_packet_type(type),
+                               &buf[start + 1], packet_len);
+      start += 1 + packet_len;
+
+      if (packet_count == HCI_READ_BATCH_SIZE) {
+        dispatch_packets(packets, packet_count);
+        packet_count = 0;
+      }
     }
+    dispatch_packets(packets, packet_count);
 
-    fd_set fds;
-    FD_ZERO(&fds);
-    FD_SET(ctrl_fd, &fds);
-    FD_SET(fd, &fds);
-    int res = select(std::max(fd, ctrl_fd) + 1, &fds, NULL, NULL, NULL);
-    if (res <= 0) LOG(INFO) << "Nothing more to read";
-
-    if (FD_ISSET(ctrl_fd, &fds)) {
-      LOG(INFO) << "exitting";
-      return;
+    // Keep the incomplete tail, if any, for the next read
+    if (start > 0) {
+      memmove(buf.data(), buf.data() + start, end - start);
+      end -= start;
     }
-    len = read(fd, buf, 1);
+
+    if (!wait_for_data(ctrl_fd, fd)) return;
+
+    OSI_NO_INTR(len = read(fd, buf.data() + end, buf.size() - end));
   }
 }
 
@@ -23,6 +23,7 @@
 #include <base/logging.h>
 #include <string.h>
 #include <unordered_map>
+#include <vector>
 
 #include "bt_target.h"
 #include "buffer_allocator.h"
@@ -30,6 +31,7 @@
 #include "hci_internals.h"
 #include "osi/include/log.h"
 #include "osi/include/osi.h"
+#include "osi/include/properties.h"
 
 #define APPLY_CONTINUATION_FLAG(handle) (((handle)&0xCFFF) | 0x1000)
 #define APPLY_START_FLAG(handle) (((handle)&0xCFFF) | 0x2000)
@@ -43,6 +45,21 @@
 #define POINT_TO_POINT 0
 #define L2CAP_HEADER_SIZE 4
 
+#define REASSEMBLY_MODE_PROPERTY "persist.bluetooth.acl_reassembly"
+
+// Beyond this many fragments, a packet is copied into a single buffer instead
+// of being chained, to bound the size of the chain handed up.
+#define MAX_CHAINED_FRAGMENTS 32
+
+// Fragments of a packet being reassembled in chain mode, in the order they
+// were received. The offset and len of each one delimit its part of the
+// packet.
+typedef struct {
+  std::vector<BT_HDR*> fragments;
+  uint16_t full_length;  // Expected length including the ACL preamble.
+  uint16_t received;     // Length received so far, including the preamble.
+} fragment_chain_t;
+
 // Our interface and callbacks
 
 static const allocator_t* buffer_allocator;
@@ -50,12 +67,43 @@ static const controller_t* controller;
 static const packet_fragmenter_callbacks_t* callbacks;
 
 static std::unordered_map<uint16_t /* handle */, BT_HDR*> partial_packets;
+static std::unordered_map<uint16_t /* handle */, fragment_chain_t>
+    fragment_chains;
+
+static packet_fragmenter_reassembly_mode_t reassembly_mode =
+    PACKET_FRAGMENTER_REASSEMBLY_CHAIN;
+static bool reassembly_mode_selected = false;
+
+void packet_fragmenter_set_reassembly_mode(
+    packet_fragmenter_reassembly_mode_t mode) {
+  CHECK(partial_packets.empty() && fragment_chains.empty());
+  reassembly_mode = mode;
+  reassembly_mode_selected = true;
+}
+
+static void free_fragment_chain(fragment_chain_t* chain) {
+  for (BT_HDR* fragment : chain->fragments) buffer_allocator->free(fragment);
+  chain->fragments.clear();
+}
 
 static void init(const packet_fragmenter_callbacks_t* result_callbacks) {
   callbacks = result_callbacks;
+
+  if (!reassembly_mode_selected) {
+    char mode[PROPERTY_VALUE_MAX] = {0};
+    osi_property_get(REASSEMBLY_MODE_PROPERTY, mode, "chain");
+    reassembly_mode = strcmp(mode, "copy") == 0
+                          ? PACKET_FRAGMENTER_REASSEMBLY_COPY
+                          : PACKET_FRAGMENTER_REASSEMBLY_CHAIN;
+  }
 }
 
-static void cleanup() { partial_packets.clear(); }
+static void cleanup() {
+  for (auto& entry : partial_packets) buffer_allocator->free(entry.second);
+  partial_packets.clear();
+  for (auto& entry : fragment_chains) free_fragment_chain(&entry.second);
+  fragment_chains.clear();
+}
 
 static void fragment_and_dispatch(BT_HDR* packet) {
   CHECK(packet != NULL);
@@ -119,6 +167,72 @@ static bool check_uint16_overflow(uint16_t a, uint16_t b) {
   return (UINT16_MAX - a) < b;
 }
 
+// Hands the fragments of a complete |chain| over to a new chained packet and
+// returns it.
+static BT_HDR* make_chained_packet(fragment_chain_t* chain) {
+  size_t num_fragments = chain->fragments.size();
+  BT_HDR* packet = (BT_HDR*)buffer_allocator->alloc(
+      sizeof(BT_HDR) + sizeof(tBT_ACL_CHAIN) + num_fragments * sizeof(BT_HDR*));
+  packet->event = MSG_HC_TO_STACK_HCI_ACL_CHAINED;
+  packet->len = chain->full_length;
+  packet->offset = 0;
+  packet->layer_specific = 0;
+
+  tBT_ACL_CHAIN* p_chain = (tBT_ACL_CHAIN*)packet->data;
+  p_chain->num_fragments = num_fragments;
+  for (size_t i = 0; i < num_fragments; i++)
+    p_chain->fragments[i] = chain->fragments[i];
+
+  // The emptied chain is kept for the next packet on this handle so that its
+  // storage is reused
+  chain->fragments.clear();
+  return packet;
+}
+
+// Copies the fragments of |chain| into a partial packet of the full length,
+// as if they had been reassembled in copy mode, and releases them.
+static BT_HDR* copy_fragment_chain(fragment_chain_t* chain) {
+  BT_HDR* packet =
+      (BT_HDR*)buffer_allocator->alloc(chain->full_length + sizeof(BT_HDR));
+  packet->event = chain->fragments.front()->event;
+  packet->len = chain->full_length;
+  packet->offset = 0;
+  packet->layer_specific = 0;
+
+  for (BT_HDR* fragment : chain->fragments) {
+    memcpy(packet->data + packet->offset, fragment->data + fragment->offset,
+           fragment->len);
+    packet->offset += fragment->len;
+  }
+
+  free_fragment_chain(chain);
+  return packet;
+}
+
+static void reassemble_continuation_chained(uint16_t handle,
+                                            fragment_chain_t* chain,
+                                            BT_HDR* packet) {
+  packet->offset = HCI_ACL_PREAMBLE_SIZE;
+  packet->len -= HCI_ACL_PREAMBLE_SIZE;
+  if (packet->len > chain->full_length - chain->received) {
+    LOG_WARN(LOG_TAG,
+             "%s got packet which would exceed expected length of %d. "
+             "Truncating.",
+             __func__, chain->full_length);
+    packet->len = chain->full_length - chain->received;
+  }
+
+  chain->fragments.push_back(packet);
+  chain->received += packet->len;
+
+  if (chain->received == chain->full_length) {
+    callbacks->reassembled(make_chained_packet(chain));
+  } else if (chain->fragments.size() == MAX_CHAINED_FRAGMENTS) {
+    // The rest of the packet is copied on arrival
+    partial_packets[handle] = copy_fragment_chain(chain);
+  }
+}
+
 static void reassemble_and_dispatch(BT_HDR* packet) {
   if ((packet->event & MSG_EVT_MASK) == MSG_HC_TO_STACK_HCI_ACL) {
     uint8_t* stream = packet->data;
@@ -159,6 +273,16 @@ static void reassemble_and_dispatch(BT_HDR* packet) {
         buffer_allocator->free(hdl);
       }
 
+      auto chain_iter = fragment_chains.find(handle);
+      if (chain_iter != fragment_chains.end() &&
+          !chain_iter->second.fragments.empty()) {
+        LOG_WARN(LOG_TAG,
+                 "%s found unfinished packet for handle with start packet. "
+                 "Dropping old.",
+                 __func__);
+        free_fragment_chain(&chain_iter->second);
+      }
+
       if (acl_length < L2CAP_HEADER_SIZE) {
         LOG_WARN(LOG_TAG, "%s L2CAP packet too small (%d < %d). Dropping it.",
                  __func__, packet->len, L2CAP_HEADER_SIZE);
@@ -193,6 +317,19 @@ static void reassemble_and_dispatch(BT_HDR* packet) {
         return;
       }
 
+      if (reassembly_mode == PACKET_FRAGMENTER_REASSEMBLY_CHAIN) {
+        // Update the ACL data size to indicate the full expected length
+        stream = packet->data;
+        STREAM_SKIP_UINT16(stream);  // skip the handle
+        UINT16_TO_STREAM(stream, full_length - HCI_ACL_PREAMBLE_SIZE);
+
+        fragment_chain_t* chain = &fragment_chains[handle];
+        chain->fragments.push_back(packet);
+        chain->full_length = full_length;
+        chain->received = packet->len;
+        return;
+      }
+
       BT_HDR* partial_packet =
           (BT_HDR*)buffer_allocator->alloc(full_length + sizeof(BT_HDR));
       partial_packet->event = packet->event;
@@ -211,6 +348,13 @@ static void reassemble_and_dispatch(BT_HDR* packet) {
       // Free the old packet buffer, since we don't need it anymore
       buffer_allocator->free(packet);
     } else {
+      auto chain_iter = fragment_chains.find(handle);
+      if (chain_iter != fragment_chains.end() &&
+          !chain_iter->second.fragments.empty()) {
+        reassemble_continuation_chained(handle, &chain_iter->second, packet);
+        return;
+      }
+
       auto map_iter = partial_packets.find(handle);
       if (map_iter == partial_packets.end()) {
         LOG_WARN(LOG_TAG,
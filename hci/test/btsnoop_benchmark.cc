@@ -0,0 +1,152 @@
+/******************************************************************************
+ * Copyright (c) 2026 Qualcomm Innovation Center, Inc. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ *
+ *******************************************************************************/
+
+#include <base/logging.h>
+#include <benchmark/benchmark.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/uio.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "hci/include/btsnoop_ring.h"
+
+using ::benchmark::State;
+
+#if defined(OS_GENERIC)
+static const char kLogFile[] = "/tmp/btsnoop_benchmark.log";
+#else
+static const char kLogFile[] = "/data/local/tmp/btsnoop_benchmark.log";
+#endif
+
+// Same layout as the records of the btsnoop log
+typedef struct {
+  uint32_t length_original;
+  uint32_t length_captured;
+  uint32_t flags;
+  uint32_t dropped_packets;
+  uint64_t timestamp;
+  uint8_t type;
+} __attribute__((__packed__)) header_t;
+
+#define RING_SIZE (256 * 1024)
+#define WRITE_BATCH 64
+
+static uint64_t now_us() {
+  struct timespec ts = {};
+  clock_gettime(CLOCK_REALTIME, &ts);
+  return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+static int open_log() {
+  return open(kLogFile, O_WRONLY | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR);
+}
+
+static void close_log(int fd) {
+  close(fd);
+  unlink(kLogFile);
+}
+
+// Stands for the work the HCI thread does on a packet besides the snoop log.
+static void hci_work(const std::vector<uint8_t>& packet) {
+  benchmark::DoNotOptimize(packet.data());
+  benchmark::ClobberMemory();
+}
+
+static void BM_HciSnoopOff(State& state) {
+  std::vector<uint8_t> packet(state.range(0), 0x5a);
+  while (state.KeepRunning()) hci_work(packet);
+  state.SetItemsProcessed(state.iterations());
+  state.SetBytesProcessed(state.iterations() * packet.size());
+}
+BENCHMARK(BM_HciSnoopOff)->Arg(16)->Arg(1025);
+
+// Every packet is written as it is captured, as btsnoop did before the writer
+// thread.
+static void BM_HciSnoopSync(State& state) {
+  std::vector<uint8_t> packet(state.range(0), 0x5a);
+  int fd = open_log();
+  while (state.KeepRunning()) {
+    header_t header = {};
+    header.length_original = header.length_captured = packet.size();
+    header.timestamp = now_us();
+    iovec iov[] = {{&header, sizeof(header)}, {packet.data(), packet.size()}};
+    benchmark::DoNotOptimize(writev(fd, iov, 2));
+    hci_work(packet);
+  }
+  close_log(fd);
+  state.SetItemsProcessed(state.iterations());
+  state.SetBytesProcessed(state.iterations() * packet.size());
+}
+BENCHMARK(BM_HciSnoopSync)->Arg(16)->Arg(1025);
+
+// Packets are copied into the ring, and a writer thread takes them out in
+// batches. The writer hands them to a sink that does no I/O, so that only the
+// capture and hand-off are measured, and the producer waits while the ring is
+// more than half full, so that no packet is dropped.
+static void BM_HciSnoopAsync(State& state) {
+  std::vector<uint8_t> packet(state.range(0), 0x5a);
+  btsnoop_ring_t* ring = btsnoop_ring_new(RING_SIZE);
+  std::atomic<bool> running(true);
+  uint64_t written = 0;
+
+  std::thread writer([&] {
+    header_t headers[WRITE_BATCH];
+    iovec iov[2 * WRITE_BATCH];
+    for (;;) {
+      // Stop only once the ring is drained
+      bool last = !running;
+      uint64_t position = btsnoop_ring_begin(ring);
+      size_t count = 0;
+      btsnoop_record_t* record;
+      while (count < WRITE_BATCH &&
+             (record = btsnoop_ring_next(ring, &position)) != NULL) {
+        headers[count] = {};
+        headers[count].length_original = record->length;
+        headers[count].length_captured = record->length;
+        headers[count].dropped_packets = record->dropped_packets;
+        headers[count].timestamp = record->timestamp_us;
+        iov[2 * count] = {&headers[count], sizeof(header_t)};
+        iov[2 * count + 1] = {btsnoop_record_data(record), record->length};
+        count++;
+      }
+      if (count == 0) {
+        if (last) break;
+        std::this_thread::yield();
+        continue;
+      }
+      benchmark::DoNotOptimize(iov);
+      benchmark::ClobberMemory();
+      btsnoop_ring_release(ring, position);
+      written += count;
+    }
+  });
+
+  while (state.KeepRunning()) {
+    while (btsnoop_ring_used(ring) > RING_SIZE / 2) std::this_thread::yield();
+    btsnoop_ring_push(ring, now_us(), 0, true, packet.data(), packet.size(),
+                      0);
+    hci_work(packet);
+  }
+
+  running = false;
+  writer.join();
+  uint32_t dropped = btsnoop_ring_dropped_packets(ring);
+  CHECK(dropped == 0);
+  CHECK(written == static_cast<uint64_t>(state.iterations()));
+  btsnoop_ring_free(ring);
+  // Every iteration is a packet accepted by the ring and taken by the writer
+  state.counters["dropped"] = dropped;
+  state.SetItemsProcessed(written);
+  state.SetBytesProcessed(written * packet.size());
+}
+BENCHMARK(BM_HciSnoopAsync)->Arg(16)->Arg(1025)->UseRealTime();
+
+BENCHMARK_MAIN();
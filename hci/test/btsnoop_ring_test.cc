@@ -0,0 +1,158 @@
+/******************************************************************************
+ * Copyright (c) 2026 Qualcomm Innovation Center, Inc. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ *
+ *******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include "AllocationTestHarness.h"
+
+#include <string.h>
+#include <thread>
+#include <vector>
+
+#include "hci/include/btsnoop_ring.h"
+
+class BtsnoopRingTest : public AllocationTestHarness {
+ protected:
+  void TearDown() override {
+    btsnoop_ring_free(ring_);
+    AllocationTestHarness::TearDown();
+  }
+
+  // Pushes a packet of |length| bytes all set to |value|.
+  bool Push(uint8_t value, size_t length, size_t spare = 0) {
+    std::vector<uint8_t> data(length, value);
+    return btsnoop_ring_push(ring_, value, value, value & 1, data.data(),
+                             length, spare);
+  }
+
+  // Checks that the next record is the one pushed by |Push(value, length)|.
+  void ExpectNext(uint64_t* position, uint8_t value, size_t length) {
+    btsnoop_record_t* record = btsnoop_ring_next(ring_, position);
+    ASSERT_TRUE(record != NULL);
+    EXPECT_EQ(value, record->timestamp_us);
+    EXPECT_EQ(value, record->event);
+    EXPECT_EQ(value & 1, record->is_received);
+    ASSERT_EQ(length, record->length);
+    for (size_t i = 0; i < length; i++) {
+      ASSERT_EQ(value, btsnoop_record_data(record)[i]);
+    }
+  }
+
+  btsnoop_ring_t* ring_ = NULL;
+};
+
+TEST_F(BtsnoopRingTest, test_push_and_read_in_order) {
+  ring_ = btsnoop_ring_new(1024);
+
+  EXPECT_TRUE(Push(1, 10));
+  EXPECT_TRUE(Push(2, 0));
+  EXPECT_TRUE(Push(3, 100));
+
+  uint64_t position = btsnoop_ring_begin(ring_);
+  ExpectNext(&position, 1, 10);
+  ExpectNext(&position, 2, 0);
+  ExpectNext(&position, 3, 100);
+  EXPECT_TRUE(btsnoop_ring_next(ring_, &position) == NULL);
+
+  // Records stay until released
+  EXPECT_NE(0u, btsnoop_ring_used(ring_));
+  btsnoop_ring_release(ring_, position);
+  EXPECT_EQ(0u, btsnoop_ring_used(ring_));
+}
+
+TEST_F(BtsnoopRingTest, test_drops_when_full) {
+  ring_ = btsnoop_ring_new(256);
+
+  int pushed = 0;
+  while (Push(pushed, 40)) pushed++;
+  EXPECT_GT(pushed, 0);
+  EXPECT_EQ(1u, btsnoop_ring_dropped_packets(ring_));
+  EXPECT_EQ(40u, btsnoop_ring_dropped_bytes(ring_));
+
+  // Too large for the ring whatever its use
+  EXPECT_FALSE(Push(0, 300));
+  EXPECT_EQ(2u, btsnoop_ring_dropped_packets(ring_));
+
+  // Room is given back on release, and the next record carries the drops
+  uint64_t position = btsnoop_ring_begin(ring_);
+  ExpectNext(&position, 0, 40);
+  btsnoop_ring_release(ring_, position);
+  EXPECT_TRUE(Push(0xaa, 40));
+
+  btsnoop_record_t* record = NULL;
+  btsnoop_record_t* last = NULL;
+  while ((record = btsnoop_ring_next(ring_, &position)) != NULL) last = record;
+  ASSERT_TRUE(last != NULL);
+  EXPECT_EQ(0xaau, last->timestamp_us);
+  EXPECT_EQ(2u, last->dropped_packets);
+}
+
+TEST_F(BtsnoopRingTest, test_wraps_around) {
+  ring_ = btsnoop_ring_new(512);
+
+  // Record sizes that leave every possible gap at the end of the buffer
+  uint64_t position = btsnoop_ring_begin(ring_);
+  for (int i = 0; i < 200; i++) {
+    size_t length = (i * 37) % 150;
+    ASSERT_TRUE(Push(i, length)) << "packet " << i;
+    ExpectNext(&position, i, length);
+    btsnoop_ring_release(ring_, position);
+  }
+  EXPECT_EQ(0u, btsnoop_ring_dropped_packets(ring_));
+  EXPECT_EQ(0u, btsnoop_ring_used(ring_));
+}
+
+TEST_F(BtsnoopRingTest, test_spare_room) {
+  ring_ = btsnoop_ring_new(1024);
+
+  ASSERT_TRUE(Push(1, 4, 64));
+  ASSERT_TRUE(Push(2, 4));
+
+  uint64_t position = btsnoop_ring_begin(ring_);
+  btsnoop_record_t* record = btsnoop_ring_next(ring_, &position);
+  ASSERT_TRUE(record != NULL);
+  EXPECT_EQ(68u, record->room);
+
+  // Writing in the spare room leaves the next record alone
+  memset(btsnoop_record_data(record), 0x55, record->room);
+  ExpectNext(&position, 2, 4);
+}
+
+TEST_F(BtsnoopRingTest, test_concurrent_producer_and_consumer) {
+  ring_ = btsnoop_ring_new(4096);
+  const int kPackets = 100000;
+
+  std::thread producer([this, kPackets] {
+    for (int i = 0; i < kPackets; i++) {
+      while (!Push(i, i % 300)) std::this_thread::yield();
+    }
+  });
+
+  int received = 0;
+  int corrupted = 0;
+  uint64_t position = btsnoop_ring_begin(ring_);
+  while (received < kPackets) {
+    btsnoop_record_t* record = btsnoop_ring_next(ring_, &position);
+    if (!record) {
+      std::this_thread::yield();
+      continue;
+    }
+
+    uint8_t value = received;
+    bool intact = (record->timestamp_us == value &&
+                   record->length == (uint32_t)(received % 300));
+    for (size_t i = 0; intact && i < record->length; i++) {
+      intact = (btsnoop_record_data(record)[i] == value);
+    }
+    if (!intact) corrupted++;
+    btsnoop_ring_release(ring_, position);
+    received++;
+  }
+
+  producer.join();
+  EXPECT_EQ(0, corrupted);
+  EXPECT_EQ(0u, btsnoop_ring_used(ring_));
+}
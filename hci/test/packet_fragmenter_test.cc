@@ -21,6 +21,7 @@
 #include "AllocationTestHarness.h"
 
 #include <stdint.h>
+#include <vector>
 
 #include "device/include/controller.h"
 #include "hci_internals.h"
@@ -32,7 +33,7 @@
 DECLARE_TEST_MODES(init, set_data_sizes, no_fragmentation, fragmentation,
                    ble_no_fragmentation, ble_fragmentation,
                    non_acl_passthrough_fragmentation, no_reassembly, reassembly,
-                   non_acl_passthrough_reassembly);
+                   copy_reassembly, non_acl_passthrough_reassembly);
 
 #define LOCAL_BLE_CONTROLLER_ID 1
 
@@ -56,6 +57,7 @@ static const uint16_t test_handle_start = (0x1992 & 0xCFFF) | 0x2000;
 static const uint16_t test_handle_continuation = (0x1992 & 0xCFFF) | 0x1000;
 static int packet_index;
 static unsigned int data_size_sum;
+static BT_HDR* first_fragment;
 
 static const packet_fragmenter_t* fragmenter;
 
@@ -101,6 +103,10 @@ static void expect_packet_fragmented(uint16_t event, int max_acl_data_size,
     else
       EXPECT_EQ(test_handle_continuation, handle);
 
+    // Fragments are slices of the packet, not copies
+    if (packet_index == 0) first_fragment = packet;
+    EXPECT_EQ(first_fragment, packet);
+
     int length_remaining = strlen(expected_data) - data_size_sum;
     int packet_data_length = packet->len - HCI_ACL_PREAMBLE_SIZE;
     EXPECT_EQ(packet_data_length, length);
@@ -181,6 +187,21 @@ static void expect_packet_reassembled(uint16_t event, BT_HDR* packet,
   uint16_t expected_data_length = strlen(expected_data);
   uint8_t* data = packet->data + packet->offset;
 
+  // Gather the parts of a chained packet, which are freed with it
+  std::vector<uint8_t> gathered;
+  if (packet->event == MSG_HC_TO_STACK_HCI_ACL_CHAINED) {
+    tBT_ACL_CHAIN* chain = (tBT_ACL_CHAIN*)packet->data;
+    EXPECT_GT(chain->num_fragments, 1);
+    for (uint16_t i = 0; i < chain->num_fragments; i++) {
+      BT_HDR* fragment = chain->fragments[i];
+      uint8_t* part = fragment->data + fragment->offset;
+      gathered.insert(gathered.end(), part, part + fragment->len);
+      osi_free(fragment);
+    }
+    EXPECT_EQ(packet->len, gathered.size());
+    data = gathered.data();
+  }
+
   if (event == MSG_HC_TO_STACK_HCI_ACL) {
     uint16_t handle;
     uint16_t length;
@@ -244,6 +265,13 @@ DURING(no_reassembly) AT_CALL(0) {
 }
 
 DURING(reassembly) AT_CALL(0) {
+  EXPECT_EQ(MSG_HC_TO_STACK_HCI_ACL_CHAINED, packet->event);
+  expect_packet_reassembled(MSG_HC_TO_STACK_HCI_ACL, packet, sample_data);
+  return;
+}
+
+DURING(copy_reassembly) AT_CALL(0) {
+  EXPECT_EQ(MSG_HC_TO_STACK_HCI_ACL, packet->event);
   expect_packet_reassembled(MSG_HC_TO_STACK_HCI_ACL, packet, sample_data);
   return;
 }
@@ -298,6 +326,7 @@ class PacketFragmenterTest : public AllocationTestHarness {
 
     packet_index = 0;
     data_size_sum = 0;
+    first_fragment = NULL;
 
     callbacks.fragmented = fragmented_callback;
     callbacks.reassembled = reassembled_callback;
@@ -386,6 +415,33 @@ TEST_F(PacketFragmenterTest, test_reassembly_necessary) {
   EXPECT_CALL_COUNT(reassembled_callback, 1);
 }
 
+TEST_F(PacketFragmenterTest, test_reassembly_necessary_copy_mode) {
+  fragmenter->cleanup();
+  packet_fragmenter_set_reassembly_mode(PACKET_FRAGMENTER_REASSEMBLY_COPY);
+  fragmenter->init(&callbacks);
+
+  reset_for(copy_reassembly);
+  manufacture_packet_and_then_reassemble(MSG_HC_TO_STACK_HCI_ACL, 42,
+                                         sample_data);
+
+  EXPECT_EQ(strlen(sample_data), data_size_sum);
+  EXPECT_CALL_COUNT(reassembled_callback, 1);
+
+  fragmenter->cleanup();
+  packet_fragmenter_set_reassembly_mode(PACKET_FRAGMENTER_REASSEMBLY_CHAIN);
+  fragmenter->init(&callbacks);
+}
+
+// A packet in too many fragments to be chained is copied
+TEST_F(PacketFragmenterTest, test_reassembly_of_many_fragments) {
+  reset_for(copy_reassembly);
+  manufacture_packet_and_then_reassemble(MSG_HC_TO_STACK_HCI_ACL, 10,
+                                         sample_data);
+
+  EXPECT_EQ(strlen(sample_data), data_size_sum);
+  EXPECT_CALL_COUNT(reassembled_callback, 1);
+}
+
 TEST_F(PacketFragmenterTest, test_non_acl_passthrough_reasseembly) {
   reset_for(non_acl_passthrough_reassembly);
   manufacture_packet_and_then_reassemble(MSG_HC_TO_STACK_HCI_EVT, 42,
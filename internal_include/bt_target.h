@@ -176,6 +176,11 @@
 #define BTA_DM_SDP_DB_SIZE 20000
 #endif
 
+/* Number of peers whose service discovery results are kept */
+#ifndef BTA_DM_SDP_CACHE_SIZE
+#define BTA_DM_SDP_CACHE_SIZE 8
+#endif
+
 #ifndef HL_INCLUDED
 #define HL_INCLUDED TRUE
 #endif
@@ -374,11 +379,17 @@
 #define BTM_SCO_DATA_SIZE_MAX 240
 #endif
 
-/* The size in bytes of the BTM inquiry database. */
+/* The default number of entries in the BTM inquiry database. It can be
+ * overridden at runtime with persist.vendor.btstack.inq_db_size. */
 #ifndef BTM_INQ_DB_SIZE
 #define BTM_INQ_DB_SIZE 40
 #endif
 
+/* The largest inquiry database accepted from the system property. */
+#ifndef BTM_INQ_DB_MAX_SIZE
+#define BTM_INQ_DB_MAX_SIZE 1024
+#endif
+
 /* The default scan mode */
 #ifndef BTM_DEFAULT_SCAN_TYPE
 #define BTM_DEFAULT_SCAN_TYPE BTM_SCAN_TYPE_INTERLACED
@@ -736,6 +747,22 @@
 #define BLE_PRIVACY_SPT TRUE
 #endif
 
+/*
+ * Number of resolvable private addresses whose resolution result (the bonded
+ * device they resolve to, or none) is cached. Must be a power of two.
+ */
+#ifndef BTM_BLE_RPA_CACHE_SIZE
+#define BTM_BLE_RPA_CACHE_SIZE 1024
+#endif
+
+/*
+ * How long a cached resolution is used. Peers are expected to refresh their
+ * resolvable private address at least this often.
+ */
+#ifndef BTM_BLE_RPA_CACHE_LIFETIME_MS
+#define BTM_BLE_RPA_CACHE_LIFETIME_MS (15 * 60 * 1000)
+#endif
+
 /*
  * Enables or disables support for local privacy (ex. address rotation)
  */
@@ -1433,6 +1460,13 @@ incoming connection
 #define AVRC_ADV_CTRL_INCLUDED TRUE
 #endif
 
+/* Bytes of the pages of folder items cached per scope to answer Get Folder
+ * Items commands, room for a folder of about 12000 items. Past it the least
+ * recently used pages are dropped. */
+#ifndef AVRC_ITEM_CACHE_MAX_BYTES
+#define AVRC_ITEM_CACHE_MAX_BYTES (3 * 1024 * 1024)
+#endif
+
 #ifndef DUMP_PCM_DATA
 #define DUMP_PCM_DATA FALSE
 #endif
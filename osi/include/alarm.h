@@ -29,6 +29,15 @@ typedef struct thread_t thread_t;
 // Prototype for the alarm callback function.
 typedef void (*alarm_callback_t)(void* data);
 
+// Data structures that can hold the pending alarms.
+typedef enum {
+  // List sorted by deadline. Setting and canceling an alarm is O(n).
+  ALARM_BACKEND_SORTED_LIST,
+  // 4-ary min-heap indexed from each alarm. Setting and canceling an alarm is
+  // O(log n) and finding the next deadline is O(1).
+  ALARM_BACKEND_HEAP,
+} alarm_backend_t;
+
 // Creates a new one-time off alarm object with user-assigned
 // |name|. |name| may not be NULL, and a copy of the string will
 // be stored internally. The value of |name| has no semantic
@@ -104,6 +113,13 @@ bool alarm_is_scheduled(const alarm_t* alarm);
 // TODO: Remove this function once PM timers can be re-factored
 period_ms_t alarm_get_remaining_ms(const alarm_t* alarm);
 
+// Selects the |backend| used to hold pending alarms. The selection takes
+// effect the next time the alarm internal state is initialized, that is when
+// the first alarm is created or after |alarm_cleanup|. Without an explicit
+// selection, the backend is read from the "persist.bluetooth.alarm_backend"
+// property ("list" or "heap") and defaults to the heap.
+void alarm_set_backend(alarm_backend_t backend);
+
 // Cleanup the alarm internal state.
 // This function should be called by the OSI module cleanup during
 // graceful shutdown.
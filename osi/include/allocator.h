@@ -41,6 +41,12 @@ void* osi_malloc(size_t size);
 void* osi_calloc(size_t size);
 void osi_free(void* ptr);
 
+// Allocate |size| bytes from the buffer pool (see buffer_pool.h). If the
+// pool is not initialized, has no size class large enough or the matching
+// class is exhausted, the buffer is allocated with |osi_malloc| instead.
+// Either way the returned buffer is released with |osi_free|.
+void* osi_pool_malloc(size_t size);
+
 // Free a buffer that was previously allocated with function |osi_malloc|
 // or |osi_calloc| and reset the pointer to that buffer to NULL.
 // |p_ptr| is a pointer to the buffer pointer to be reset.
@@ -0,0 +1,53 @@
+/******************************************************************************
+ * Copyright (c) 2026 Qualcomm Innovation Center, Inc. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ *
+ *******************************************************************************/
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+
+// The buffer pool is a process-wide set of fixed-size block slabs. Blocks are
+// preallocated in one contiguous arena, handed out from the smallest size
+// class that fits a request and recycled through per-thread caches in front
+// of a locked global free list. Callers normally go through |osi_pool_malloc|
+// and |osi_free| (see allocator.h) rather than the raw functions below.
+
+// Maximum number of size classes supported by the pool.
+#define BUFFER_POOL_MAX_CLASSES 8
+
+typedef struct {
+  size_t buffer_size;   // Largest request (in octets) served by this class.
+  size_t buffer_count;  // Number of blocks preallocated for this class.
+} buffer_pool_class_t;
+
+// Initializes the pool with |count| size classes from |classes|. The classes
+// must be sorted by strictly increasing |buffer_size|, |count| must be in
+// the range [1, BUFFER_POOL_MAX_CLASSES] and every |buffer_count| must be
+// non-zero. Returns false if the pool was already initialized.
+bool buffer_pool_init(const buffer_pool_class_t* classes, size_t count);
+
+// Releases the pool arena. Every block must have been returned to the pool
+// and no other thread may be using the pool. Test function only; do not call
+// in the normal course of operations.
+void buffer_pool_cleanup(void);
+
+// Returns true if the pool has been initialized.
+bool buffer_pool_is_initialized(void);
+
+// Takes a raw block able to hold |size| octets from the smallest matching
+// size class. Returns NULL if the pool is not initialized, |size| is larger
+// than every class or the matching class is exhausted; the last case is
+// recorded as a miss. The block must be returned with |buffer_pool_put|.
+void* buffer_pool_get(size_t size);
+
+// Returns |ptr| to the pool if it is a block owned by the pool and returns
+// true. Returns false and does nothing for any other pointer, including NULL.
+bool buffer_pool_put(void* ptr);
+
+// Dump per size class pool statistics (capacity, in use, high-water mark
+// and misses) to the |fd| file descriptor.
+// The information is in user-readable text format. The |fd| must be valid.
+void buffer_pool_debug_dump(int fd);
@@ -29,6 +29,7 @@
 #include <list>
 #include <memory>
 #include <string>
+#include <unordered_map>
 
 // The default section name to use if a key/value pair is not defined within
 // a section.
@@ -42,18 +43,57 @@ typedef struct {
   std::string value;
 } entry_t;
 
-typedef struct {
+// A section keeps its entries in insertion order in |entries|, which is the
+// order |config_save| writes them in, and indexes them by key in |index| so
+// that a lookup does not have to walk the list. Entries must only be added
+// and removed through the member functions below to keep both in sync.
+struct section_t {
   std::string name;
   std::list<entry_t> entries;
+  std::unordered_map<std::string, std::list<entry_t>::iterator> index;
+
+  section_t() = default;
+  explicit section_t(std::string name);
+  section_t(const section_t& other);
+  section_t(section_t&& other) = default;
+  section_t& operator=(const section_t& other);
+  section_t& operator=(section_t&& other) = default;
+
   void Set(std::string key, std::string value);
   std::list<entry_t>::iterator Find(const std::string& key);
-  bool Has(const std::string& key);
-} section_t;
+  std::list<entry_t>::const_iterator Find(const std::string& key) const;
+  bool Has(const std::string& key) const;
+  bool Remove(const std::string& key);
+  std::list<entry_t>::iterator Erase(std::list<entry_t>::iterator entry);
 
+ private:
+  void Reindex();
+};
+
+// Same layout as |section_t|: |sections| keeps the file order and |index|
+// maps each section name to its node in |sections|.
 struct config_t {
   std::list<section_t> sections;
+  std::unordered_map<std::string, std::list<section_t>::iterator> index;
+
+  config_t() = default;
+  config_t(const config_t& other);
+  config_t(config_t&& other) = default;
+  config_t& operator=(const config_t& other);
+  config_t& operator=(config_t&& other) = default;
+
   std::list<section_t>::iterator Find(const std::string& section);
-  bool Has(const std::string& section);
+  std::list<section_t>::const_iterator Find(const std::string& section) const;
+  bool Has(const std::string& section) const;
+  // Appends |section| after the existing ones and returns it. If a section
+  // with the same name already exists it is returned unchanged instead.
+  section_t& Append(section_t section);
+  bool Remove(const std::string& section);
+  std::list<section_t>::iterator Erase(std::list<section_t>::iterator section);
+  void Clear();
+
+ private:
+  void Reindex();
 };
 
 #if (BT_IOT_LOGGING_ENABLED == TRUE)
@@ -0,0 +1,27 @@
+/******************************************************************************
+ * Copyright (c) 2026 Qualcomm Innovation Center, Inc. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ *
+ *******************************************************************************/
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Frame check sequences of the Bluetooth stack.
+//
+// Both functions continue the CRC |crc| over |length| bytes at |data|, so a
+// frame scattered over several buffers is checked by chaining the calls over
+// each of them, without copying the frame into one buffer first.
+
+// CRC-16 of the L2CAP FCS: polynomial x^16 + x^15 + x^2 + 1, least
+// significant bit first (Core Specification, Vol 3, Part A, 3.3.5). The FCS
+// of a frame is |crc16_update(0, frame, length)|. Eight bytes are processed
+// per step (slice-by-8).
+uint16_t crc16_update(uint16_t crc, const uint8_t* data, size_t length);
+
+// CRC-8 of the RFCOMM FCS: polynomial x^8 + x^2 + x + 1, least significant
+// bit first (GSM 07.10, TS 101 369). RFCOMM starts it at 0xFF and sends its
+// ones complement.
+uint8_t crc8_update(uint8_t crc, const uint8_t* data, size_t length);
@@ -30,11 +30,29 @@ typedef struct reactor_t reactor_t;
 typedef void (*fixed_queue_free_cb)(void* data);
 typedef void (*fixed_queue_cb)(fixed_queue_t* queue, void* context);
 
+typedef enum {
+  // Mutex protected list. Supports every operation in this file.
+  FIXED_QUEUE_MODE_LIST,
+  // Bounded lock-free ring intended for many producers and a single consumer.
+  // Enqueue and dequeue never take a lock and only touch the dequeue file
+  // descriptor when the queue goes from empty to non-empty (and back), so the
+  // reactor readiness semantics are unchanged. |capacity| must not exceed
+  // |FIXED_QUEUE_RING_MAX_CAPACITY|. |fixed_queue_get_list| and
+  // |fixed_queue_try_remove_from_queue| are not supported.
+  FIXED_QUEUE_MODE_RING,
+} fixed_queue_mode_t;
+
+// Largest capacity a |FIXED_QUEUE_MODE_RING| queue may be created with. The
+// ring storage is allocated up front, so this bounds its memory usage.
+#define FIXED_QUEUE_RING_MAX_CAPACITY 65536
+
 // Creates a new fixed queue with the given |capacity|. If more elements than
 // |capacity| are added to the queue, the caller is blocked until space is
-// made available in the queue. Returns NULL on failure. The caller must free
-// the returned queue with |fixed_queue_free|.
-fixed_queue_t* fixed_queue_new(size_t capacity);
+// made available in the queue. |mode| selects the queue implementation.
+// Returns NULL on failure. The caller must free the returned queue with
+// |fixed_queue_free|.
+fixed_queue_t* fixed_queue_new(size_t capacity,
+                               fixed_queue_mode_t mode = FIXED_QUEUE_MODE_LIST);
 
 // Frees a queue and (optionally) the enqueued elements.
 // |queue| is the queue to free. If the |free_cb| callback is not null,
@@ -95,11 +113,12 @@ void* fixed_queue_try_peek_last(fixed_queue_t* queue);
 // function will never block the caller. If the queue is empty or NULL, this
 // function returns NULL immediately. |data| may not be NULL. If the |data|
 // element is found in the queue, a pointer to the removed data is returned,
-// otherwise NULL.
+// otherwise NULL. |queue| may not be a |FIXED_QUEUE_MODE_RING| queue.
 void* fixed_queue_try_remove_from_queue(fixed_queue_t* queue, void* data);
 
 // Returns the iterateable list with all entries in the |queue|. This function
-// will never block the caller. |queue| may not be NULL.
+// will never block the caller. |queue| may not be NULL and may not be a
+// |FIXED_QUEUE_MODE_RING| queue.
 //
 // NOTE: The return result of this function is not thread safe: the list could
 // be modified by another thread, and the result would be unpredictable.
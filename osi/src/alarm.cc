@@ -36,13 +36,16 @@
 
 #include <hardware/bluetooth.h>
 
+#include <algorithm>
 #include <mutex>
+#include <vector>
 
 #include "osi/include/allocator.h"
 #include "osi/include/fixed_queue.h"
 #include "osi/include/list.h"
 #include "osi/include/log.h"
 #include "osi/include/osi.h"
+#include "osi/include/properties.h"
 #include "osi/include/semaphore.h"
 #include "osi/include/thread.h"
 #include "osi/include/wakelock.h"
@@ -107,6 +110,12 @@ struct alarm_t {
 
   bool for_msg_loop;  // True, if the alarm should be processed on message loop
   CancelableClosureInStruct closure;  // posted to message loop for processing
+
+  // Bookkeeping for ALARM_BACKEND_HEAP. |heap_index| is the 1-based position
+  // of the alarm in |alarm_heap|, or 0 if it is not pending. |heap_sequence|
+  // orders alarms that share the same deadline.
+  size_t heap_index;
+  uint64_t heap_sequence;
 };
 
 // If the next wakeup time is less than this threshold, we should acquire
@@ -124,9 +133,16 @@ static const clockid_t CLOCK_ID_ALARM = CLOCK_BOOTTIME_ALARM;
 
 // This mutex ensures that the |alarm_set|, |alarm_cancel|, and alarm callback
 // functions execute serially and not concurrently. As a result, this mutex
-// also protects the |alarms| list.
+// also protects the pending alarms held in |alarms| or |alarm_heap|.
 static std::mutex alarms_mutex;
-static list_t* alarms;
+static bool alarms_initialized;
+static alarm_backend_t backend;
+// Backend given to |alarm_set_backend|, applied by |lazy_initialize|
+static alarm_backend_t requested_backend;
+static bool backend_selected;
+static list_t* alarms;                     // ALARM_BACKEND_SORTED_LIST
+static std::vector<alarm_t*>* alarm_heap;  // ALARM_BACKEND_HEAP
+static uint64_t alarm_heap_sequence;
 static timer_t timer;
 static timer_t wakeup_timer;
 static bool timer_set;
@@ -148,6 +164,13 @@ static void alarm_set_internal(alarm_t* alarm, period_ms_t period,
                                fixed_queue_t* queue, bool for_msg_loop);
 static void* alarm_cancel_internal(alarm_t* alarm);
 static void remove_pending_alarm(alarm_t* alarm);
+static bool pending_alarms_new(void);
+static void pending_alarms_free(void);
+static bool pending_alarms_is_empty(void);
+static size_t pending_alarms_length(void);
+static alarm_t* pending_alarms_front(void);
+static void pending_alarms_insert(alarm_t* alarm);
+static void pending_alarms_remove(alarm_t* alarm);
 static void schedule_next_instance(alarm_t* alarm);
 static void reschedule_root_alarm(void);
 static void alarm_queue_ready(fixed_queue_t* queue, void* context);
@@ -174,8 +197,8 @@ alarm_t* alarm_new_periodic(const char* name) {
 }
 
 static alarm_t* alarm_new_internal(const char* name, bool is_periodic) {
-  // Make sure we have a list we can insert alarms into.
-  if (!alarms && !lazy_initialize()) {
+  // Make sure we have somewhere to insert alarms into.
+  if (!alarms_initialized && !lazy_initialize()) {
     CHECK(false);  // if initialization failed, we should not continue
     return NULL;
   }
@@ -236,7 +259,7 @@ void alarm_set_on_mloop(alarm_t* alarm, period_ms_t interval_ms,
 static void alarm_set_internal(alarm_t* alarm, period_ms_t period,
                                alarm_callback_t cb, void* data,
                                fixed_queue_t* queue, bool for_msg_loop) {
-  CHECK(alarms != NULL);
+  CHECK(alarms_initialized);
   CHECK(alarm != NULL);
   CHECK(cb != NULL);
 
@@ -254,7 +277,7 @@ static void alarm_set_internal(alarm_t* alarm, period_ms_t period,
 }
 
 void* alarm_cancel(alarm_t* alarm) {
-  CHECK(alarms != NULL);
+  CHECK(alarms_initialized);
   if (!alarm) return NULL;
   void* data = NULL;
 
@@ -274,8 +297,7 @@ void* alarm_cancel(alarm_t* alarm) {
 // Internal implementation of canceling an alarm.
 // The caller must hold the |alarms_mutex|
 static void* alarm_cancel_internal(alarm_t* alarm) {
-  bool needs_reschedule =
-      (!list_is_empty(alarms) && list_front(alarms) == alarm);
+  bool needs_reschedule = (pending_alarms_front() == alarm);
 
   remove_pending_alarm(alarm);
 
@@ -293,13 +315,19 @@ static void* alarm_cancel_internal(alarm_t* alarm) {
 }
 
 bool alarm_is_scheduled(const alarm_t* alarm) {
-  if ((alarms == NULL) || (alarm == NULL)) return false;
+  if (!alarms_initialized || (alarm == NULL)) return false;
   return (alarm->callback != NULL);
 }
 
+void alarm_set_backend(alarm_backend_t new_backend) {
+  std::lock_guard<std::mutex> lock(alarms_mutex);
+  requested_backend = new_backend;
+  backend_selected = true;
+}
+
 void alarm_cleanup(void) {
   // If lazy_initialize never ran there is nothing else to do
-  if (!alarms) return;
+  if (!alarms_initialized) return;
 
   dispatcher_thread_active = false;
   semaphore_post(alarm_expired);
@@ -318,12 +346,12 @@ void alarm_cleanup(void) {
   semaphore_free(alarm_expired);
   alarm_expired = NULL;
 
-  list_free(alarms);
-  alarms = NULL;
+  pending_alarms_free();
+  alarms_initialized = false;
 }
 
 static bool lazy_initialize(void) {
-  CHECK(alarms == NULL);
+  CHECK(!alarms_initialized);
 
   // timer_t doesn't have an invalid value so we must track whether
   // the |timer| variable is valid ourselves.
@@ -332,11 +360,20 @@ static bool lazy_initialize(void) {
 
   std::lock_guard<std::mutex> lock(alarms_mutex);
 
-  alarms = list_new(NULL);
-  if (!alarms) {
-    LOG_ERROR(LOG_TAG, "%s unable to allocate alarm list.", __func__);
+  if (backend_selected) {
+    backend = requested_backend;
+  } else {
+    char value[PROPERTY_VALUE_MAX] = {0};
+    osi_property_get("persist.bluetooth.alarm_backend", value, "heap");
+    backend = strcmp(value, "list") == 0 ? ALARM_BACKEND_SORTED_LIST
+                                         : ALARM_BACKEND_HEAP;
+  }
+
+  if (!pending_alarms_new()) {
+    LOG_ERROR(LOG_TAG, "%s unable to allocate pending alarms.", __func__);
     goto error;
   }
+  alarms_initialized = true;
 
   if (!timer_create_internal(CLOCK_ID, &timer)) goto error;
   timer_initialized = true;
@@ -375,6 +412,8 @@ static bool lazy_initialize(void) {
   }
   thread_set_rt_priority(dispatcher_thread, THREAD_RT_PRIORITY);
   thread_post(dispatcher_thread, callback_dispatch, NULL);
+  LOG_INFO(LOG_TAG, "%s using %s alarm backend", __func__,
+           backend == ALARM_BACKEND_HEAP ? "heap" : "sorted list");
   return true;
 
 error:
@@ -395,14 +434,14 @@ error:
 
   if (timer_initialized) timer_delete(timer);
 
-  list_free(alarms);
-  alarms = NULL;
+  pending_alarms_free();
+  alarms_initialized = false;
 
   return false;
 }
 
 static period_ms_t now(void) {
-  CHECK(alarms != NULL);
+  CHECK(alarms_initialized);
 
   struct timespec ts;
   if (clock_gettime(CLOCK_ID, &ts) == -1) {
@@ -414,10 +453,10 @@ static period_ms_t now(void) {
   return (ts.tv_sec * 1000LL) + (ts.tv_nsec / 1000000LL);
 }
 
-// Remove alarm from internal alarm list and the processing queue
+// Remove alarm from the pending alarms and the processing queue
 // The caller must hold the |alarms_mutex|
 static void remove_pending_alarm(alarm_t* alarm) {
-  list_remove(alarms, alarm);
+  pending_alarms_remove(alarm);
 
   if (alarm->for_msg_loop) {
     alarm->closure.i.Cancel();
@@ -432,10 +471,9 @@ static void remove_pending_alarm(alarm_t* alarm) {
 
 // Must be called with |alarms_mutex| held
 static void schedule_next_instance(alarm_t* alarm) {
-  // If the alarm is currently set and it's at the start of the list,
+  // If the alarm is currently set and it's the earliest pending one,
   // we'll need to re-schedule since we've adjusted the earliest deadline.
-  bool needs_reschedule =
-      (!list_is_empty(alarms) && list_front(alarms) == alarm);
+  bool needs_reschedule = (pending_alarms_front() == alarm);
   if (alarm->callback) remove_pending_alarm(alarm);
 
   // Calculate the next deadline for this alarm
@@ -445,26 +483,11 @@ static void schedule_next_instance(alarm_t* alarm) {
     ms_into_period = ((just_now - alarm->creation_time) % alarm->period);
   alarm->deadline = just_now + (alarm->period - ms_into_period);
 
-  // Add it into the timer list sorted by deadline (earliest deadline first).
-  if (list_is_empty(alarms) ||
-      ((alarm_t*)list_front(alarms))->deadline > alarm->deadline) {
-    list_prepend(alarms, alarm);
-  } else {
-    for (list_node_t* node = list_begin(alarms); node != list_end(alarms);
-         node = list_next(node)) {
-      list_node_t* next = list_next(node);
-      if (next == list_end(alarms) ||
-          ((alarm_t*)list_node(next))->deadline > alarm->deadline) {
-        list_insert_after(alarms, node, alarm);
-        break;
-      }
-    }
-  }
+  pending_alarms_insert(alarm);
 
   // If the new alarm has the earliest deadline, we need to re-evaluate our
   // schedule.
-  if (needs_reschedule ||
-      (!list_is_empty(alarms) && list_front(alarms) == alarm)) {
+  if (needs_reschedule || pending_alarms_front() == alarm) {
     reschedule_root_alarm();
   }
 }
@@ -472,7 +495,7 @@ static void schedule_next_instance(alarm_t* alarm) {
 // NOTE: must be called with |alarms_mutex| held
 __attribute__((no_sanitize("integer")))
 static void reschedule_root_alarm(void) {
-  CHECK(alarms != NULL);
+  CHECK(alarms_initialized);
 
   const bool timer_was_set = timer_set;
   alarm_t* next;
@@ -482,9 +505,9 @@ static void reschedule_root_alarm(void) {
   struct itimerspec timer_time;
   memset(&timer_time, 0, sizeof(timer_time));
 
-  if (list_is_empty(alarms)) goto done;
+  if (pending_alarms_is_empty()) goto done;
 
-  next = static_cast<alarm_t*>(list_front(alarms));
+  next = pending_alarms_front();
   next_expiration = next->deadline - now();
   if (next_expiration < TIMER_INTERVAL_FOR_WAKELOCK_IN_MS) {
     if (!timer_set) {
@@ -636,13 +659,13 @@ static void callback_dispatch(UNUSED_ATTR void* context) {
     // Take into account that the alarm may get cancelled before we get to it.
     // We're done here if there are no alarms or the alarm at the front is in
     // the future. Exit right away since there's nothing left to do.
-    if (list_is_empty(alarms) ||
-        (alarm = static_cast<alarm_t*>(list_front(alarms)))->deadline > now()) {
+    if (pending_alarms_is_empty() ||
+        (alarm = pending_alarms_front())->deadline > now()) {
       reschedule_root_alarm();
       continue;
     }
 
-    list_remove(alarms, alarm);
+    pending_alarms_remove(alarm);
 
     if (alarm->is_periodic) {
       alarm->prev_deadline = alarm->deadline;
@@ -669,6 +692,147 @@ static void callback_dispatch(UNUSED_ATTR void* context) {
   LOG_DEBUG(LOG_TAG, "%s Callback thread exited", __func__);
 }
 
+// Pending alarms storage. All of the functions below must be called with
+// |alarms_mutex| held (or before the alarm threads are started).
+
+// Returns true if |a| should fire before |b|.
+static bool alarm_heap_less(const alarm_t* a, const alarm_t* b) {
+  if (a->deadline != b->deadline) return a->deadline < b->deadline;
+  return a->heap_sequence < b->heap_sequence;
+}
+
+static void alarm_heap_place(alarm_t* alarm, size_t index) {
+  (*alarm_heap)[index] = alarm;
+  alarm->heap_index = index + 1;
+}
+
+static void alarm_heap_sift_up(size_t index) {
+  std::vector<alarm_t*>& heap = *alarm_heap;
+  alarm_t* alarm = heap[index];
+  while (index > 0) {
+    size_t parent = (index - 1) / 4;
+    if (!alarm_heap_less(alarm, heap[parent])) break;
+    alarm_heap_place(heap[parent], index);
+    index = parent;
+  }
+  alarm_heap_place(alarm, index);
+}
+
+static void alarm_heap_sift_down(size_t index) {
+  std::vector<alarm_t*>& heap = *alarm_heap;
+  alarm_t* alarm = heap[index];
+  size_t length = heap.size();
+  while (true) {
+    size_t first_child = index * 4 + 1;
+    if (first_child >= length) break;
+
+    size_t smallest = first_child;
+    size_t last_child = std::min(first_child + 4, length);
+    for (size_t child = first_child + 1; child < last_child; child++) {
+      if (alarm_heap_less(heap[child], heap[smallest])) smallest = child;
+    }
+    if (!alarm_heap_less(heap[smallest], alarm)) break;
+
+    alarm_heap_place(heap[smallest], index);
+    index = smallest;
+  }
+  alarm_heap_place(alarm, index);
+}
+
+static bool pending_alarms_new(void) {
+  if (backend == ALARM_BACKEND_HEAP) {
+    alarm_heap = new std::vector<alarm_t*>();
+    alarm_heap_sequence = 0;
+    return true;
+  }
+
+  alarms = list_new(NULL);
+  return alarms != NULL;
+}
+
+static void pending_alarms_free(void) {
+  if (alarm_heap) {
+    for (alarm_t* alarm : *alarm_heap) alarm->heap_index = 0;
+    delete alarm_heap;
+    alarm_heap = NULL;
+  }
+
+  list_free(alarms);
+  alarms = NULL;
+}
+
+static bool pending_alarms_is_empty(void) {
+  if (backend == ALARM_BACKEND_HEAP) return alarm_heap->empty();
+  return list_is_empty(alarms);
+}
+
+static size_t pending_alarms_length(void) {
+  if (backend == ALARM_BACKEND_HEAP) return alarm_heap->size();
+  return list_length(alarms);
+}
+
+// Returns the pending alarm with the earliest deadline, or NULL if there is
+// none.
+static alarm_t* pending_alarms_front(void) {
+  if (pending_alarms_is_empty()) return NULL;
+  if (backend == ALARM_BACKEND_HEAP) return alarm_heap->front();
+  return static_cast<alarm_t*>(list_front(alarms));
+}
+
+static void pending_alarms_insert(alarm_t* alarm) {
+  if (backend == ALARM_BACKEND_HEAP) {
+    alarm->heap_sequence = alarm_heap_sequence++;
+    alarm_heap->push_back(alarm);
+    alarm_heap_sift_up(alarm_heap->size() - 1);
+    return;
+  }
+
+  // Add it into the timer list sorted by deadline (earliest deadline first).
+  if (list_is_empty(alarms) ||
+      ((alarm_t*)list_front(alarms))->deadline > alarm->deadline) {
+    list_prepend(alarms, alarm);
+  } else {
+    for (list_node_t* node = list_begin(alarms); node != list_end(alarms);
+         node = list_next(node)) {
+      list_node_t* next = list_next(node);
+      if (next == list_end(alarms) ||
+          ((alarm_t*)list_node(next))->deadline > alarm->deadline) {
+        list_insert_after(alarms, node, alarm);
+        break;
+      }
+    }
+  }
+}
+
+// Removes |alarm| from the pending alarms. Does nothing if |alarm| is not
+// pending.
+static void pending_alarms_remove(alarm_t* alarm) {
+  if (backend != ALARM_BACKEND_HEAP) {
+    list_remove(alarms, alarm);
+    return;
+  }
+
+  if (alarm->heap_index == 0) return;
+
+  std::vector<alarm_t*>& heap = *alarm_heap;
+  size_t index = alarm->heap_index - 1;
+  CHECK(index < heap.size() && heap[index] == alarm);
+  alarm->heap_index = 0;
+
+  alarm_t* last = heap.back();
+  heap.pop_back();
+  if (last == alarm) return;
+
+  // Move the last alarm into the hole and restore the heap property in
+  // whichever direction it is violated.
+  alarm_heap_place(last, index);
+  if (index > 0 && alarm_heap_less(last, heap[(index - 1) / 4])) {
+    alarm_heap_sift_up(index);
+  } else {
+    alarm_heap_sift_down(index);
+  }
+}
+
 static bool timer_create_internal(const clockid_t clock_id, timer_t* timer) {
   CHECK(timer != NULL);
 
@@ -739,19 +903,30 @@ void alarm_debug_dump(int fd) {
 
   std::lock_guard<std::mutex> lock(alarms_mutex);
 
-  if (alarms == NULL) {
+  if (!alarms_initialized) {
     dprintf(fd, "  None\n");
     return;
   }
 
   period_ms_t just_now = now();
 
-  dprintf(fd, "  Total Alarms: %zu\n\n", list_length(alarms));
+  dprintf(fd, "  Backend: %s\n",
+          backend == ALARM_BACKEND_HEAP ? "heap" : "sorted list");
+  dprintf(fd, "  Total Alarms: %zu\n\n", pending_alarms_length());
+
+  // Dump info for each alarm, earliest deadline first
+  std::vector<alarm_t*> pending;
+  pending.reserve(pending_alarms_length());
+  if (backend == ALARM_BACKEND_HEAP) {
+    pending = *alarm_heap;
+    std::sort(pending.begin(), pending.end(), alarm_heap_less);
+  } else {
+    for (list_node_t* node = list_begin(alarms); node != list_end(alarms);
+         node = list_next(node))
+      pending.push_back((alarm_t*)list_node(node));
+  }
 
-  // Dump info for each alarm
-  for (list_node_t* node = list_begin(alarms); node != list_end(alarms);
-       node = list_next(node)) {
-    alarm_t* alarm = (alarm_t*)list_node(node);
+  for (alarm_t* alarm : pending) {
     alarm_stats_t* stats = &alarm->stats;
 
     dprintf(fd, "  Alarm : %s (%s)\n", stats->name,
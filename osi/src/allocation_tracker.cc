@@ -30,6 +30,7 @@
 #include <sys/types.h>
 
 #include "osi/include/allocator.h"
+#include "osi/include/buffer_pool.h"
 #include "osi/include/compat.h"
 #include "osi/include/log.h"
 #include "osi/include/osi.h"
@@ -265,4 +266,7 @@ void osi_allocator_debug_dump(int fd) {
   dprintf(fd, "  Total allocated/free/used octets : %zu / %zu / %zu\n",
           alloc_total_size, free_total_size,
           alloc_total_size - free_total_size);
+  lock.unlock();
+
+  buffer_pool_debug_dump(fd);
 }
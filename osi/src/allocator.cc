@@ -21,6 +21,7 @@
 
 #include "osi/include/allocation_tracker.h"
 #include "osi/include/allocator.h"
+#include "osi/include/buffer_pool.h"
 
 static const allocator_id_t alloc_allocator_id = 42;
 
@@ -71,8 +72,17 @@ void* osi_calloc(size_t size) {
   return allocation_tracker_notify_alloc(alloc_allocator_id, ptr, size);
 }
 
+void* osi_pool_malloc(size_t size) {
+  CHECK(static_cast<ssize_t>(size) >= 0);
+  size_t real_size = allocation_tracker_resize_for_canary(size);
+  void* ptr = buffer_pool_get(real_size);
+  if (!ptr) return osi_malloc(size);
+  return allocation_tracker_notify_alloc(alloc_allocator_id, ptr, size);
+}
+
 void osi_free(void* ptr) {
-  free(allocation_tracker_notify_free(alloc_allocator_id, ptr));
+  void* real_ptr = allocation_tracker_notify_free(alloc_allocator_id, ptr);
+  if (!buffer_pool_put(real_ptr)) free(real_ptr);
 }
 
 void osi_free_and_reset(void** p_ptr) {
@@ -0,0 +1,325 @@
+/******************************************************************************
+ * Copyright (c) 2026 Qualcomm Innovation Center, Inc. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ *
+ *******************************************************************************/
+
+#define LOG_TAG "bt_osi_buffer_pool"
+
+#include "osi/include/buffer_pool.h"
+
+#include <base/logging.h>
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <atomic>
+#include <mutex>
+
+#include "osi/include/allocation_tracker.h"
+#include "osi/include/log.h"
+
+// Blocks are aligned to this boundary within the arena.
+#define BLOCK_ALIGNMENT 16
+
+// Upper bound on the number of blocks a thread keeps cached per size class.
+// The actual limit is derived from the class capacity so that small classes
+// are not drained into a single thread's cache.
+#define THREAD_CACHE_MAX_BLOCKS 32
+
+typedef struct free_block_t {
+  struct free_block_t* next;
+} free_block_t;
+
+typedef struct {
+  size_t buffer_size;
+  size_t buffer_count;
+  size_t stride;       // Block size including any canary space.
+  uint8_t* begin;      // First block of this class in the arena.
+  uint8_t* end;        // One past the last block of this class.
+  size_t cache_limit;  // Max blocks cached per thread.
+  size_t cache_batch;  // Blocks moved between cache and global list at once.
+
+  std::mutex lock;
+  free_block_t* free_list;  // Guarded by |lock|.
+
+  std::atomic<size_t> in_use;
+  std::atomic<size_t> high_water_mark;
+  std::atomic<uint64_t> misses;
+} pool_class_t;
+
+// Per-thread block cache. |generation| ties the cache to the pool instance
+// it was filled from, so stale caches are dropped after a cleanup.
+typedef struct thread_cache_t {
+  uint64_t generation;
+  free_block_t* head[BUFFER_POOL_MAX_CLASSES];
+  size_t count[BUFFER_POOL_MAX_CLASSES];
+
+  ~thread_cache_t();
+} thread_cache_t;
+
+static pool_class_t pool_classes[BUFFER_POOL_MAX_CLASSES];
+static size_t pool_class_count;
+static uint8_t* arena;
+static std::atomic<uintptr_t> arena_begin(0);
+static std::atomic<uintptr_t> arena_end(0);
+static std::atomic<uint64_t> pool_generation(0);
+static std::atomic<uint64_t> oversized_requests(0);
+static std::mutex init_lock;
+
+static thread_local thread_cache_t thread_cache;
+
+static void cache_flush(thread_cache_t* cache, size_t class_index,
+                        size_t keep);
+
+thread_cache_t::~thread_cache_t() {
+  if (generation == 0 ||
+      generation != pool_generation.load(std::memory_order_acquire))
+    return;
+
+  for (size_t i = 0; i < pool_class_count; i++) cache_flush(this, i, 0);
+}
+
+// Returns the cache of the calling thread, dropping its contents if they
+// belong to a previous pool instance.
+static thread_cache_t* cache_get(void) {
+  thread_cache_t* cache = &thread_cache;
+  uint64_t generation = pool_generation.load(std::memory_order_acquire);
+  if (cache->generation != generation) {
+    for (size_t i = 0; i < BUFFER_POOL_MAX_CLASSES; i++) {
+      cache->head[i] = NULL;
+      cache->count[i] = 0;
+    }
+    cache->generation = generation;
+  }
+  return cache;
+}
+
+// Moves up to |cache_batch| blocks from the global free list of
+// |class_index| into |cache|.
+static void cache_refill(thread_cache_t* cache, size_t class_index) {
+  pool_class_t* pool_class = &pool_classes[class_index];
+
+  std::lock_guard<std::mutex> lock(pool_class->lock);
+  for (size_t i = 0; i < pool_class->cache_batch && pool_class->free_list;
+       i++) {
+    free_block_t* block = pool_class->free_list;
+    pool_class->free_list = block->next;
+    block->next = cache->head[class_index];
+    cache->head[class_index] = block;
+    cache->count[class_index]++;
+  }
+}
+
+// Returns cached blocks of |class_index| to the global free list until
+// only |keep| blocks remain in |cache|.
+static void cache_flush(thread_cache_t* cache, size_t class_index,
+                        size_t keep) {
+  pool_class_t* pool_class = &pool_classes[class_index];
+  if (cache->count[class_index] <= keep) return;
+
+  std::lock_guard<std::mutex> lock(pool_class->lock);
+  while (cache->count[class_index] > keep) {
+    free_block_t* block = cache->head[class_index];
+    cache->head[class_index] = block->next;
+    cache->count[class_index]--;
+    block->next = pool_class->free_list;
+    pool_class->free_list = block;
+  }
+}
+
+static void update_high_water_mark(pool_class_t* pool_class, size_t in_use) {
+  size_t high_water_mark =
+      pool_class->high_water_mark.load(std::memory_order_relaxed);
+  while (in_use > high_water_mark &&
+         !pool_class->high_water_mark.compare_exchange_weak(
+             high_water_mark, in_use, std::memory_order_relaxed)) {
+  }
+}
+
+bool buffer_pool_init(const buffer_pool_class_t* classes, size_t count) {
+  CHECK(classes != NULL);
+  CHECK(count > 0 && count <= BUFFER_POOL_MAX_CLASSES);
+
+  std::lock_guard<std::mutex> lock(init_lock);
+  if (arena) return false;
+
+  // Blocks are sized for canaries at initialization time so that pool
+  // buffers stay interchangeable with |osi_malloc| ones under the tracker.
+  size_t arena_size = 0;
+  for (size_t i = 0; i < count; i++) {
+    CHECK(classes[i].buffer_count > 0);
+    CHECK(i == 0 || classes[i].buffer_size > classes[i - 1].buffer_size);
+
+    size_t stride = allocation_tracker_resize_for_canary(classes[i].buffer_size);
+    stride = (stride + BLOCK_ALIGNMENT - 1) & ~(size_t)(BLOCK_ALIGNMENT - 1);
+    pool_classes[i].buffer_size = classes[i].buffer_size;
+    pool_classes[i].buffer_count = classes[i].buffer_count;
+    pool_classes[i].stride = stride;
+    arena_size += stride * classes[i].buffer_count;
+  }
+
+  void* memory = NULL;
+  if (posix_memalign(&memory, BLOCK_ALIGNMENT, arena_size) != 0) {
+    LOG_ERROR(LOG_TAG, "%s unable to allocate %zu octet arena", __func__,
+              arena_size);
+    return false;
+  }
+  arena = static_cast<uint8_t*>(memory);
+
+  uint8_t* next = arena;
+  for (size_t i = 0; i < count; i++) {
+    pool_class_t* pool_class = &pool_classes[i];
+
+    size_t cache_limit = pool_class->buffer_count / 8;
+    if (cache_limit > THREAD_CACHE_MAX_BLOCKS)
+      cache_limit = THREAD_CACHE_MAX_BLOCKS;
+    pool_class->cache_limit = cache_limit;
+    pool_class->cache_batch = (cache_limit + 1) / 2;
+
+    pool_class->begin = next;
+    pool_class->free_list = NULL;
+    for (size_t j = pool_class->buffer_count; j > 0; j--) {
+      free_block_t* block =
+          reinterpret_cast<free_block_t*>(next + (j - 1) * pool_class->stride);
+      block->next = pool_class->free_list;
+      pool_class->free_list = block;
+    }
+    next += pool_class->stride * pool_class->buffer_count;
+    pool_class->end = next;
+
+    pool_class->in_use = 0;
+    pool_class->high_water_mark = 0;
+    pool_class->misses = 0;
+  }
+  pool_class_count = count;
+  oversized_requests = 0;
+
+  arena_begin.store(reinterpret_cast<uintptr_t>(arena),
+                    std::memory_order_relaxed);
+  arena_end.store(reinterpret_cast<uintptr_t>(next), std::memory_order_release);
+  pool_generation.fetch_add(1, std::memory_order_release);
+
+  LOG_INFO(LOG_TAG, "%s %zu size classes in a %zu octet arena", __func__,
+           count, arena_size);
+  return true;
+}
+
+void buffer_pool_cleanup(void) {
+  std::lock_guard<std::mutex> lock(init_lock);
+  if (!arena) return;
+
+  for (size_t i = 0; i < pool_class_count; i++)
+    CHECK(pool_classes[i].in_use.load(std::memory_order_relaxed) == 0);
+
+  // Invalidate every thread cache before the arena goes away.
+  pool_generation.fetch_add(1, std::memory_order_release);
+  arena_begin.store(0, std::memory_order_relaxed);
+  arena_end.store(0, std::memory_order_relaxed);
+  pool_class_count = 0;
+
+  free(arena);
+  arena = NULL;
+}
+
+bool buffer_pool_is_initialized(void) {
+  return arena_end.load(std::memory_order_acquire) != 0;
+}
+
+void* buffer_pool_get(size_t size) {
+  if (!buffer_pool_is_initialized()) return NULL;
+
+  size_t class_index = 0;
+  while (class_index < pool_class_count &&
+         pool_classes[class_index].stride < size)
+    class_index++;
+
+  if (class_index == pool_class_count) {
+    oversized_requests.fetch_add(1, std::memory_order_relaxed);
+    return NULL;
+  }
+
+  pool_class_t* pool_class = &pool_classes[class_index];
+  free_block_t* block = NULL;
+
+  if (pool_class->cache_limit > 0) {
+    thread_cache_t* cache = cache_get();
+    if (!cache->head[class_index]) cache_refill(cache, class_index);
+    block = cache->head[class_index];
+    if (block) {
+      cache->head[class_index] = block->next;
+      cache->count[class_index]--;
+    }
+  } else {
+    std::lock_guard<std::mutex> lock(pool_class->lock);
+    block = pool_class->free_list;
+    if (block) pool_class->free_list = block->next;
+  }
+
+  if (!block) {
+    pool_class->misses.fetch_add(1, std::memory_order_relaxed);
+    return NULL;
+  }
+
+  size_t in_use =
+      pool_class->in_use.fetch_add(1, std::memory_order_relaxed) + 1;
+  update_high_water_mark(pool_class, in_use);
+  return block;
+}
+
+bool buffer_pool_put(void* ptr) {
+  uintptr_t address = reinterpret_cast<uintptr_t>(ptr);
+  if (address < arena_begin.load(std::memory_order_relaxed) ||
+      address >= arena_end.load(std::memory_order_acquire))
+    return false;
+
+  size_t class_index = 0;
+  while (pool_classes[class_index].end <= static_cast<uint8_t*>(ptr))
+    class_index++;
+
+  pool_class_t* pool_class = &pool_classes[class_index];
+  CHECK((static_cast<uint8_t*>(ptr) - pool_class->begin) % pool_class->stride ==
+        0);
+
+  free_block_t* block = static_cast<free_block_t*>(ptr);
+  pool_class->in_use.fetch_sub(1, std::memory_order_relaxed);
+
+  if (pool_class->cache_limit > 0) {
+    thread_cache_t* cache = cache_get();
+    block->next = cache->head[class_index];
+    cache->head[class_index] = block;
+    cache->count[class_index]++;
+    if (cache->count[class_index] > pool_class->cache_limit)
+      cache_flush(cache, class_index,
+                  pool_class->cache_limit - pool_class->cache_batch);
+  } else {
+    std::lock_guard<std::mutex> lock(pool_class->lock);
+    block->next = pool_class->free_list;
+    pool_class->free_list = block;
+  }
+
+  return true;
+}
+
+void buffer_pool_debug_dump(int fd) {
+  std::lock_guard<std::mutex> lock(init_lock);
+
+  dprintf(fd, "\nBluetooth Buffer Pool Statistics:\n");
+  if (!arena) {
+    dprintf(fd, "  Buffer pool not initialized\n");
+    return;
+  }
+
+  dprintf(fd, "  Requests larger than every class : %" PRIu64 "\n",
+          oversized_requests.load(std::memory_order_relaxed));
+  for (size_t i = 0; i < pool_class_count; i++) {
+    const pool_class_t* pool_class = &pool_classes[i];
+    dprintf(fd, "  Class %zu octets\n", pool_class->buffer_size);
+    dprintf(fd, "    Capacity/in use/high-water mark : %zu / %zu / %zu\n",
+            pool_class->buffer_count,
+            pool_class->in_use.load(std::memory_order_relaxed),
+            pool_class->high_water_mark.load(std::memory_order_relaxed));
+    dprintf(fd, "    Misses (served from the heap)   : %" PRIu64 "\n",
+            pool_class->misses.load(std::memory_order_relaxed));
+  }
+}
@@ -51,60 +51,145 @@ static section_t* section_new(const char* name);
 static void entry_free(void* ptr);
 
 
-// Empty definition; this type is aliased to list_node_t.
+section_t::section_t(std::string name) : name(std::move(name)) {}
+
+// The iterators in |index| point into |other.entries|, so a copy has to build
+// its own index.
+section_t::section_t(const section_t& other)
+    : name(other.name), entries(other.entries) {
+  Reindex();
+}
+
+section_t& section_t::operator=(const section_t& other) {
+  if (this != &other) {
+    name = other.name;
+    entries = other.entries;
+    Reindex();
+  }
+  return *this;
+}
+
+void section_t::Reindex() {
+  index.clear();
+  index.reserve(entries.size());
+  for (auto it = entries.begin(); it != entries.end(); ++it)
+    index.emplace(it->key, it);
+}
+
 void section_t::Set(std::string key, std::string value) {
-  for (entry_t& entry : entries) {
-    if (entry.key == key) {
-      entry.value = value;
-      return;
-    }
+  auto it = index.find(key);
+  if (it != index.end()) {
+    it->second->value = std::move(value);
+    return;
   }
   // add a new key to the section
-  entries.emplace_back(
-      entry_t{.key = std::move(key), .value = std::move(value)});
+  auto entry = entries.emplace(entries.end(),
+                               entry_t{.key = key, .value = std::move(value)});
+  index.emplace(std::move(key), entry);
 }
 
 std::list<entry_t>::iterator section_t::Find(const std::string& key) {
-  return std::find_if(
-      entries.begin(), entries.end(),
-      [&key](const entry_t& entry) { return entry.key == key; });
+  auto it = index.find(key);
+  return (it == index.end()) ? entries.end() : it->second;
+}
+
+std::list<entry_t>::const_iterator section_t::Find(
+    const std::string& key) const {
+  auto it = index.find(key);
+  return (it == index.end()) ? entries.end() : it->second;
 }
 
-bool section_t::Has(const std::string& key) {
-  return Find(key) != entries.end();
+bool section_t::Has(const std::string& key) const {
+  return index.find(key) != index.end();
+}
+
+bool section_t::Remove(const std::string& key) {
+  auto it = index.find(key);
+  if (it == index.end()) return false;
+  entries.erase(it->second);
+  index.erase(it);
+  return true;
+}
+
+std::list<entry_t>::iterator section_t::Erase(
+    std::list<entry_t>::iterator entry) {
+  index.erase(entry->key);
+  return entries.erase(entry);
+}
+
+config_t::config_t(const config_t& other) : sections(other.sections) {
+  Reindex();
+}
+
+config_t& config_t::operator=(const config_t& other) {
+  if (this != &other) {
+    sections = other.sections;
+    Reindex();
+  }
+  return *this;
+}
+
+void config_t::Reindex() {
+  index.clear();
+  index.reserve(sections.size());
+  for (auto it = sections.begin(); it != sections.end(); ++it)
+    index.emplace(it->name, it);
 }
 
 std::list<section_t>::iterator config_t::Find(const std::string& section) {
-  return std::find_if(
-      sections.begin(), sections.end(),
-      [&section](const section_t& sec) { return sec.name == section; });
+  auto it = index.find(section);
+  return (it == index.end()) ? sections.end() : it->second;
 }
 
-bool config_t::Has(const std::string& key) {
-  return Find(key) != sections.end();
+std::list<section_t>::const_iterator config_t::Find(
+    const std::string& section) const {
+  auto it = index.find(section);
+  return (it == index.end()) ? sections.end() : it->second;
 }
 
-static bool config_parse(FILE* fp, config_t* config);
+bool config_t::Has(const std::string& key) const {
+  return index.find(key) != index.end();
+}
 
-template <typename T,
-          class = typename std::enable_if<std::is_same<
-              config_t, typename std::remove_const<T>::type>::value>>
+section_t& config_t::Append(section_t section) {
+  auto it = index.find(section.name);
+  if (it != index.end()) return *it->second;
 
-static auto section_find(T& config, const std::string& section) {
-  return std::find_if(
-      config.sections.begin(), config.sections.end(),
-      [&section](const section_t& sec) { return sec.name == section; });
+  std::string name = section.name;
+  auto sec = sections.emplace(sections.end(), std::move(section));
+  index.emplace(std::move(name), sec);
+  return *sec;
 }
 
+bool config_t::Remove(const std::string& section) {
+  auto it = index.find(section);
+  if (it == index.end()) return false;
+  sections.erase(it->second);
+  index.erase(it);
+  return true;
+}
+
+std::list<section_t>::iterator config_t::Erase(
+    std::list<section_t>::iterator section) {
+  index.erase(section->name);
+  return sections.erase(section);
+}
+
+void config_t::Clear() {
+  index.clear();
+  sections.clear();
+}
+
+static bool config_parse(FILE* fp, config_t* config);
+
 static const entry_t* entry_find(const config_t& config,
                                  const std::string& section,
                                  const std::string& key) {
-  auto sec = section_find(config, section);
+  auto sec = config.Find(section);
   if (sec == config.sections.end()) return nullptr;
-  for (const entry_t& entry : sec->entries) {
-    if (entry.key == key) return &entry;
-  }
-  return nullptr;
+  auto entry = sec->Find(key);
+  if (entry == sec->entries.end()) return nullptr;
+  return &*entry;
 }
 
 std::unique_ptr<config_t> config_new_empty(void) {
@@ -163,7 +248,7 @@ std::unique_ptr<config_t> config_new_clone(const config_t& src) {
 
 
 bool config_has_section(const config_t& config, const std::string& section) {
-  return (section_find(config, section) != config.sections.end());
+  return config.Has(section);
 }
 
 bool config_has_key(const config_t& config, const std::string& section,
@@ -257,9 +342,9 @@ void config_set_string(config_t* config, const std::string& section, const std::
                        const std::string& value) {
   CHECK(config);
 
-  auto sec = section_find(*config, section);
+  auto sec = config->Find(section);
   if (sec == config->sections.end()) {
-    config->sections.emplace_back(section_t{.name = section});
+    config->Append(section_t(section));
     sec = std::prev(config->sections.end());
   }
 
@@ -273,14 +358,7 @@ void config_set_string(config_t* config, const std::string& section, const std::
     value_no_newline = value_string;
   }
 
-  for (entry_t& entry : sec->entries) {
-    if (entry.key == key) {
-      entry.value = value;
-        return;
-    }
-  }
-
-  sec->entries.emplace_back(entry_t{.key = key, .value = value});
+  sec->Set(key, value);
 }
 
 
@@ -288,28 +366,16 @@ void config_set_string(config_t* config, const std::string& section, const std::
 bool config_remove_section(config_t* config, const std::string& section) {
   CHECK(config);
 
-  auto sec = section_find(*config, section);
-  if (sec == config->sections.end()) return false;
-
-  config->sections.erase(sec);
-  return true;
+  return config->Remove(section);
 }
 
 bool config_remove_key(config_t* config, const char* section, const char* key) {
   CHECK(config);
 
-  auto sec = section_find(*config, section);
+  auto sec = config->Find(section);
   if (sec == config->sections.end()) return false;
 
-
-  for (auto entry = sec->entries.begin(); entry != sec->entries.end();
-       ++entry) {
-    if (entry->key == key) {
-      sec->entries.erase(entry);
-      return true;
-    }
-  }
-  return false;
+  return sec->Remove(key);
 }
 
 
@@ -347,7 +413,7 @@ bool config_remove_section_optimal(config_t* config,section_t* section) {
   CHECK(config != NULL);
   CHECK(section != NULL);
 
-  return list_remove(config->sections, section);
+  return config->Remove(section->name);
 }
 
 bool section_has_key(const section_t* section,
@@ -355,13 +421,7 @@ bool section_has_key(const section_t* section,
   CHECK(section != NULL);
   CHECK(key != NULL);
 
-  for (const list_node_t* node = list_begin(section->entries);
-       node != list_end(section->entries); node = list_next(node)) {
-    entry_t* entry = static_cast<entry_t*>(list_node(node));
-    if (!strcmp(entry->key.c_str(), key)) return true;
-  }
-
-  return false;
+  return section->Has(key);
 }
 
 #if (BT_IOT_LOGGING_ENABLED == TRUE)
@@ -369,37 +429,11 @@ void config_sections_sort_by_entry_key(config_t* config, compare_func comp) {
   LOG(INFO) << __func__;
   CHECK(config != NULL);
 
-  for (list_node_t* node = list_begin(config->sections);
-      node != list_end(config->sections);
-      node = list_next(node)) {
-    section_t* sec = (section_t*)list_node(node);
-    if (list_length(sec->entries) <= 1)
-      continue;
-    list_node_t* p = list_end(sec->entries);
-    list_node_t* head_next = list_next(list_begin(sec->entries));
-    bool changed = true;
-
-    while (p != head_next && changed) {
-      list_node_t* q = list_begin(sec->entries);
-      changed = false;
-      for (;list_next(q) && list_next(q) != p; q = list_next(q)) {
-        entry_t* first = (entry_t*)list_node(q);
-        entry_t* second = (entry_t*)list_node(list_next(q));
-        std::string tmp_key;
-        std::string tmp_value;
-        if (comp(first->key.c_str(), second->key.c_str()) > 0) {
-          tmp_key = first->key;
-          tmp_value = first->value;
-          first->key = second->key;
-          first->value = second->value;
-          second->key = tmp_key;
-          second->value = tmp_value;
-          changed = true;
-        }
-      }
-      p = q;
-    }
-
+  // std::list::sort() relinks the nodes, so the key index stays valid.
+  for (section_t& sec : config->sections) {
+    sec.entries.sort([comp](const entry_t& first, const entry_t& second) {
+      return comp(first.key.c_str(), second.key.c_str()) < 0;
+    });
   }
 }
 #endif
@@ -0,0 +1,78 @@
+/******************************************************************************
+ * Copyright (c) 2026 Qualcomm Innovation Center, Inc. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ *
+ *******************************************************************************/
+
+#include "osi/include/crc.h"
+
+namespace {
+
+// Reversed polynomials, for the least significant bit first CRCs.
+constexpr uint16_t kCrc16Poly = 0xa001;
+constexpr uint8_t kCrc8Poly = 0xe0;
+
+// table[0] is the usual byte table. table[k][b] is the CRC of the byte b
+// followed by k zero bytes, which lets the eight table lookups of a step be
+// independent.
+struct Crc16Tables {
+  uint16_t table[8][256];
+};
+
+constexpr Crc16Tables make_crc16_tables() {
+  Crc16Tables tables = {};
+  for (int b = 0; b < 256; b++) {
+    uint16_t crc = b;
+    for (int bit = 0; bit < 8; bit++)
+      crc = (crc & 1) ? (crc >> 1) ^ kCrc16Poly : crc >> 1;
+    tables.table[0][b] = crc;
+  }
+  for (int k = 1; k < 8; k++) {
+    for (int b = 0; b < 256; b++) {
+      uint16_t prev = tables.table[k - 1][b];
+      tables.table[k][b] = (prev >> 8) ^ tables.table[0][prev & 0xff];
+    }
+  }
+  return tables;
+}
+
+struct Crc8Table {
+  uint8_t table[256];
+};
+
+constexpr Crc8Table make_crc8_table() {
+  Crc8Table table = {};
+  for (int b = 0; b < 256; b++) {
+    uint8_t crc = b;
+    for (int bit = 0; bit < 8; bit++)
+      crc = (crc & 1) ? (crc >> 1) ^ kCrc8Poly : crc >> 1;
+    table.table[b] = crc;
+  }
+  return table;
+}
+
+constexpr Crc16Tables kCrc16 = make_crc16_tables();
+constexpr Crc8Table kCrc8 = make_crc8_table();
+
+}  // namespace
+
+uint16_t crc16_update(uint16_t crc, const uint8_t* data, size_t length) {
+  const uint16_t(*t)[256] = kCrc16.table;
+
+  // The CRC only covers the first two bytes of a step, the six others are
+  // looked up directly.
+  for (; length >= 8; length -= 8, data += 8) {
+    crc ^= data[0] | (data[1] << 8);
+    crc = t[7][crc & 0xff] ^ t[6][crc >> 8] ^ t[5][data[2]] ^ t[4][data[3]] ^
+          t[3][data[4]] ^ t[2][data[5]] ^ t[1][data[6]] ^ t[0][data[7]];
+  }
+
+  while (length--) crc = (crc >> 8) ^ t[0][(crc ^ *data++) & 0xff];
+
+  return crc;
+}
+
+uint8_t crc8_update(uint8_t crc, const uint8_t* data, size_t length) {
+  while (length--) crc = kCrc8.table[crc ^ *data++];
+  return crc;
+}
@@ -17,8 +17,12 @@
  ******************************************************************************/
 
 #include <base/logging.h>
+#include <errno.h>
+#include <poll.h>
+#include <sched.h>
 #include <string.h>
 
+#include <atomic>
 #include <mutex>
 
 #include "osi/include/allocator.h"
@@ -28,8 +32,36 @@
 #include "osi/include/reactor.h"
 #include "osi/include/semaphore.h"
 
+// A single slot of the ring. |sequence| tells whether the slot is free for
+// the producer claiming position |sequence|, or holds the element published
+// at position |sequence - 1|.
+typedef struct {
+  std::atomic<size_t> sequence;
+  void* data;
+} ring_cell_t;
+
+// Bounded multi-producer ring backing |FIXED_QUEUE_MODE_RING| queues.
+//
+// |reserved| counts elements enqueued but not yet fully dequeued and is used
+// to enforce the queue capacity. |length| counts published elements; it is
+// bumped after an element is visible and dropped after it is consumed, so it
+// may briefly go negative. Only its 0 <-> 1 transitions touch the dequeue
+// semaphore, and only the |capacity - 1| <-> |capacity| transitions of
+// |reserved| touch the enqueue semaphore. Because each counter moves by one
+// at a time, those transitions strictly alternate and every post is paired
+// with exactly one wait.
+typedef struct {
+  ring_cell_t* cells;
+  size_t mask;
+  alignas(64) std::atomic<size_t> enqueue_pos;
+  alignas(64) std::atomic<size_t> dequeue_pos;
+  alignas(64) std::atomic<size_t> reserved;
+  alignas(64) std::atomic<ssize_t> length;
+} ring_t;
+
 typedef struct fixed_queue_t {
   list_t* list;
+  ring_t* ring;
   semaphore_t* enqueue_sem;
   semaphore_t* dequeue_sem;
   std::mutex* mutex;
@@ -42,18 +74,34 @@ typedef struct fixed_queue_t {
 
 static void internal_dequeue_ready(void* context);
 
-fixed_queue_t* fixed_queue_new(size_t capacity) {
+static ring_t* ring_new(size_t capacity);
+static void ring_free(ring_t* ring);
+static bool ring_try_enqueue(fixed_queue_t* queue, void* data);
+static void* ring_try_dequeue(fixed_queue_t* queue);
+static void* ring_peek(const ring_t* ring, size_t pos);
+static void wait_fd_readable(int fd);
+
+fixed_queue_t* fixed_queue_new(size_t capacity, fixed_queue_mode_t mode) {
   fixed_queue_t* ret =
       static_cast<fixed_queue_t*>(osi_calloc(sizeof(fixed_queue_t)));
 
   ret->mutex = new std::mutex;
   ret->capacity = capacity;
 
-  ret->list = list_new(NULL);
-  if (!ret->list) goto error;
+  if (mode == FIXED_QUEUE_MODE_RING) {
+    CHECK(capacity <= FIXED_QUEUE_RING_MAX_CAPACITY);
+    ret->ring = ring_new(capacity);
+
+    // The enqueue semaphore only tracks whether the ring is full.
+    ret->enqueue_sem = semaphore_new(capacity > 0 ? 1 : 0);
+    if (!ret->enqueue_sem) goto error;
+  } else {
+    ret->list = list_new(NULL);
+    if (!ret->list) goto error;
 
-  ret->enqueue_sem = semaphore_new((unsigned int)capacity);
-  if (!ret->enqueue_sem) goto error;
+    ret->enqueue_sem = semaphore_new((unsigned int)capacity);
+    if (!ret->enqueue_sem) goto error;
+  }
 
   ret->dequeue_sem = semaphore_new(0);
   if (!ret->dequeue_sem) goto error;
@@ -70,10 +118,22 @@ void fixed_queue_free(fixed_queue_t* queue, fixed_queue_free_cb free_cb) {
 
   fixed_queue_unregister_dequeue(queue);
 
-  if (free_cb)
+  if (queue->ring) {
+    // Nobody else may touch a queue that is being freed, so walk the
+    // published cells directly instead of going through the semaphores.
+    ring_t* ring = queue->ring;
+    size_t end = ring->enqueue_pos.load(std::memory_order_acquire);
+    for (size_t pos = ring->dequeue_pos.load(std::memory_order_acquire);
+         pos != end; pos++) {
+      void* data = ring_peek(ring, pos);
+      if (free_cb && data) free_cb(data);
+    }
+    ring_free(ring);
+  } else if (free_cb) {
     for (const list_node_t* node = list_begin(queue->list);
          node != list_end(queue->list); node = list_next(node))
       free_cb(list_node(node));
+  }
 
   list_free(queue->list);
   semaphore_free(queue->enqueue_sem);
@@ -96,6 +156,8 @@ void fixed_queue_flush(fixed_queue_t* queue, fixed_queue_free_cb free_cb) {
 bool fixed_queue_is_empty(fixed_queue_t* queue) {
   if (queue == NULL) return true;
 
+  if (queue->ring) return fixed_queue_length(queue) == 0;
+
   std::lock_guard<std::mutex> lock(*queue->mutex);
   return list_is_empty(queue->list);
 }
@@ -103,6 +165,11 @@ bool fixed_queue_is_empty(fixed_queue_t* queue) {
 size_t fixed_queue_length(fixed_queue_t* queue) {
   if (queue == NULL) return 0;
 
+  if (queue->ring) {
+    ssize_t length = queue->ring->length.load(std::memory_order_acquire);
+    return length > 0 ? (size_t)length : 0;
+  }
+
   std::lock_guard<std::mutex> lock(*queue->mutex);
   return list_length(queue->list);
 }
@@ -117,6 +184,12 @@ void fixed_queue_enqueue(fixed_queue_t* queue, void* data) {
   CHECK(queue != NULL);
   CHECK(data != NULL);
 
+  if (queue->ring) {
+    while (!ring_try_enqueue(queue, data))
+      wait_fd_readable(semaphore_get_fd(queue->enqueue_sem));
+    return;
+  }
+
   semaphore_wait(queue->enqueue_sem);
 
   {
@@ -130,6 +203,13 @@ void fixed_queue_enqueue(fixed_queue_t* queue, void* data) {
 void* fixed_queue_dequeue(fixed_queue_t* queue) {
   CHECK(queue != NULL);
 
+  if (queue->ring) {
+    void* ret;
+    while ((ret = ring_try_dequeue(queue)) == NULL)
+      wait_fd_readable(semaphore_get_fd(queue->dequeue_sem));
+    return ret;
+  }
+
   semaphore_wait(queue->dequeue_sem);
 
   void* ret = NULL;
@@ -148,6 +228,8 @@ bool fixed_queue_try_enqueue(fixed_queue_t* queue, void* data) {
   CHECK(queue != NULL);
   CHECK(data != NULL);
 
+  if (queue->ring) return ring_try_enqueue(queue, data);
+
   if (!semaphore_try_wait(queue->enqueue_sem)) return false;
 
   {
@@ -162,6 +244,8 @@ bool fixed_queue_try_enqueue(fixed_queue_t* queue, void* data) {
 void* fixed_queue_try_dequeue(fixed_queue_t* queue) {
   if (queue == NULL) return NULL;
 
+  if (queue->ring) return ring_try_dequeue(queue);
+
   if (!semaphore_try_wait(queue->dequeue_sem)) return NULL;
 
   void* ret = NULL;
@@ -179,6 +263,10 @@ void* fixed_queue_try_dequeue(fixed_queue_t* queue) {
 void* fixed_queue_try_peek_first(fixed_queue_t* queue) {
   if (queue == NULL) return NULL;
 
+  if (queue->ring)
+    return ring_peek(queue->ring, queue->ring->dequeue_pos.load(
+                                      std::memory_order_acquire));
+
   std::lock_guard<std::mutex> lock(*queue->mutex);
   return list_is_empty(queue->list) ? NULL : list_front(queue->list);
 }
@@ -186,6 +274,13 @@ void* fixed_queue_try_peek_first(fixed_queue_t* queue) {
 void* fixed_queue_try_peek_last(fixed_queue_t* queue) {
   if (queue == NULL) return NULL;
 
+  if (queue->ring) {
+    ring_t* ring = queue->ring;
+    size_t first = ring->dequeue_pos.load(std::memory_order_acquire);
+    size_t end = ring->enqueue_pos.load(std::memory_order_acquire);
+    return end != first ? ring_peek(ring, end - 1) : NULL;
+  }
+
   std::lock_guard<std::mutex> lock(*queue->mutex);
   return list_is_empty(queue->list) ? NULL : list_back(queue->list);
 }
@@ -193,6 +288,8 @@ void* fixed_queue_try_peek_last(fixed_queue_t* queue) {
 void* fixed_queue_try_remove_from_queue(fixed_queue_t* queue, void* data) {
   if (queue == NULL) return NULL;
 
+  CHECK(queue->ring == NULL);
+
   bool removed = false;
   {
     std::lock_guard<std::mutex> lock(*queue->mutex);
@@ -212,6 +309,7 @@ void* fixed_queue_try_remove_from_queue(fixed_queue_t* queue, void* data) {
 
 list_t* fixed_queue_get_list(fixed_queue_t* queue) {
   CHECK(queue != NULL);
+  CHECK(queue->ring == NULL);
 
   // NOTE: Using the list in this way is not thread-safe.
   // Using this list in any context where threads can call other functions
@@ -260,3 +358,104 @@ static void internal_dequeue_ready(void* context) {
   fixed_queue_t* queue = static_cast<fixed_queue_t*>(context);
   queue->dequeue_ready(queue, queue->dequeue_context);
 }
+
+static ring_t* ring_new(size_t capacity) {
+  size_t slots = 1;
+  while (slots < capacity) slots <<= 1;
+
+  ring_t* ring = new ring_t;
+  ring->cells = new ring_cell_t[slots];
+  for (size_t i = 0; i < slots; i++) {
+    ring->cells[i].sequence.store(i, std::memory_order_relaxed);
+    ring->cells[i].data = NULL;
+  }
+  ring->mask = slots - 1;
+  ring->enqueue_pos.store(0, std::memory_order_relaxed);
+  ring->dequeue_pos.store(0, std::memory_order_relaxed);
+  ring->reserved.store(0, std::memory_order_relaxed);
+  ring->length.store(0, std::memory_order_relaxed);
+  return ring;
+}
+
+static void ring_free(ring_t* ring) {
+  if (!ring) return;
+
+  delete[] ring->cells;
+  delete ring;
+}
+
+static bool ring_try_enqueue(fixed_queue_t* queue, void* data) {
+  ring_t* ring = queue->ring;
+
+  // Reserve room first so the ring itself can never overflow.
+  size_t reserved = ring->reserved.load(std::memory_order_relaxed);
+  do {
+    if (reserved >= queue->capacity) return false;
+  } while (!ring->reserved.compare_exchange_weak(reserved, reserved + 1,
+                                                 std::memory_order_acquire,
+                                                 std::memory_order_relaxed));
+  if (reserved + 1 == queue->capacity) semaphore_wait(queue->enqueue_sem);
+
+  size_t pos = ring->enqueue_pos.fetch_add(1, std::memory_order_relaxed);
+  ring_cell_t* cell = &ring->cells[pos & ring->mask];
+  // The reservation above guarantees the consumer has released this cell;
+  // wait out the few instructions between it dropping |reserved| and
+  // releasing the cell sequence.
+  while (cell->sequence.load(std::memory_order_acquire) != pos) sched_yield();
+  cell->data = data;
+  cell->sequence.store(pos + 1, std::memory_order_release);
+
+  if (ring->length.fetch_add(1, std::memory_order_acq_rel) == 0)
+    semaphore_post(queue->dequeue_sem);
+  return true;
+}
+
+static void* ring_try_dequeue(fixed_queue_t* queue) {
+  ring_t* ring = queue->ring;
+
+  ring_cell_t* cell;
+  size_t pos = ring->dequeue_pos.load(std::memory_order_relaxed);
+  for (;;) {
+    cell = &ring->cells[pos & ring->mask];
+    size_t sequence = cell->sequence.load(std::memory_order_acquire);
+    if (sequence == pos + 1) {
+      if (ring->dequeue_pos.compare_exchange_weak(pos, pos + 1,
+                                                  std::memory_order_relaxed))
+        break;
+    } else if (pos == ring->enqueue_pos.load(std::memory_order_acquire)) {
+      return NULL;
+    } else {
+      // A producer has claimed this position but not yet published it.
+      // Elements are delivered in order, so wait for it rather than
+      // reporting a non-empty queue as empty.
+      sched_yield();
+      pos = ring->dequeue_pos.load(std::memory_order_relaxed);
+    }
+  }
+
+  void* data = cell->data;
+  cell->sequence.store(pos + ring->mask + 1, std::memory_order_release);
+
+  if (ring->length.fetch_sub(1, std::memory_order_acq_rel) == 1)
+    semaphore_wait(queue->dequeue_sem);
+  if (ring->reserved.fetch_sub(1, std::memory_order_release) ==
+      queue->capacity)
+    semaphore_post(queue->enqueue_sem);
+  return data;
+}
+
+static void* ring_peek(const ring_t* ring, size_t pos) {
+  const ring_cell_t* cell = &ring->cells[pos & ring->mask];
+  if (cell->sequence.load(std::memory_order_acquire) != pos + 1) return NULL;
+  return cell->data;
+}
+
+static void wait_fd_readable(int fd) {
+  struct pollfd pfd;
+  pfd.fd = fd;
+  pfd.events = POLLIN;
+  pfd.revents = 0;
+
+  int ret;
+  OSI_NO_INTR(ret = poll(&pfd, 1, -1));
+}
@@ -76,7 +76,12 @@ thread_t* thread_new_sized(const char* name, size_t work_queue_capacity) {
   ret->reactor = reactor_new();
   if (!ret->reactor) goto error;
 
-  ret->work_queue = fixed_queue_new(work_queue_capacity);
+  // Work items are posted from many threads and consumed only by this one,
+  // which is exactly what the lock-free ring is for.
+  ret->work_queue = fixed_queue_new(
+      work_queue_capacity, work_queue_capacity <= FIXED_QUEUE_RING_MAX_CAPACITY
+                               ? FIXED_QUEUE_MODE_RING
+                               : FIXED_QUEUE_MODE_LIST);
   if (!ret->work_queue) goto error;
 
   // Start is on the stack, but we use a semaphore, so it's safe
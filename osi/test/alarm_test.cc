@@ -72,6 +72,9 @@ class AlarmTest : public AlarmTestHarness {
   virtual void TearDown() {
     semaphore_free(semaphore);
     AlarmTestHarness::TearDown();
+    // Back to the default backend for the next test, now that no alarm is
+    // pending
+    alarm_set_backend(ALARM_BACKEND_HEAP);
   }
 };
 
@@ -87,6 +90,52 @@ static void ordered_cb(void* data) {
   semaphore_post(semaphore);
 }
 
+static int last_ordered_slot;
+
+static void increasing_slot_cb(void* data) {
+  int slot = PTR_TO_INT(data);
+  if (slot <= last_ordered_slot) cb_misordered_counter++;
+  last_ordered_slot = slot;
+  ++cb_counter;
+  semaphore_post(semaphore);
+}
+
+// Sets alarms out of deadline order, cancels a third of them, and checks that
+// the rest fire in deadline order using the given pending alarms |backend|.
+static void run_out_of_order_cancel_test(alarm_backend_t backend) {
+  static const int kNumAlarms = 60;
+  alarm_t* alarms[kNumAlarms];
+
+  alarm_set_backend(backend);
+  last_ordered_slot = -1;
+
+  for (int i = 0; i < kNumAlarms; i++) {
+    const std::string alarm_name =
+        "alarm_test.out_of_order_cancel[" + std::to_string(i) + "]";
+    alarms[i] = alarm_new(alarm_name.c_str());
+  }
+
+  // 7 and kNumAlarms are coprime, so every slot is used exactly once.
+  for (int i = 0; i < kNumAlarms; i++) {
+    int slot = (i * 7) % kNumAlarms;
+    alarm_set(alarms[i], 100 + slot * 5, increasing_slot_cb, INT_TO_PTR(slot));
+  }
+  for (int i = 0; i < kNumAlarms; i += 3) alarm_cancel(alarms[i]);
+
+  const int expected = kNumAlarms - kNumAlarms / 3;
+  for (int i = 1; i <= expected; i++) {
+    semaphore_wait(semaphore);
+    EXPECT_GE(cb_counter, i);
+  }
+  EXPECT_EQ(cb_counter, expected);
+  EXPECT_EQ(cb_misordered_counter, 0);
+
+  for (int i = 0; i < kNumAlarms; i++) {
+    EXPECT_FALSE(alarm_is_scheduled(alarms[i]));
+    alarm_free(alarms[i]);
+  }
+}
+
 TEST_F(AlarmTest, test_new_free_simple) {
   alarm_t* alarm = alarm_new("alarm_test.test_new_free_simple");
   ASSERT_TRUE(alarm != NULL);
@@ -377,3 +426,13 @@ TEST_F(AlarmTest, test_delete_during_callback) {
   }
   alarm_cleanup();
 }
+
+TEST_F(AlarmTest, test_out_of_order_cancel_sorted_list) {
+  run_out_of_order_cancel_test(ALARM_BACKEND_SORTED_LIST);
+  EXPECT_FALSE(WakeLockHeld());
+}
+
+TEST_F(AlarmTest, test_out_of_order_cancel_heap) {
+  run_out_of_order_cancel_test(ALARM_BACKEND_HEAP);
+  EXPECT_FALSE(WakeLockHeld());
+}
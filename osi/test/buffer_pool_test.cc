@@ -0,0 +1,141 @@
+#include <gtest/gtest.h>
+#include <pthread.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "AllocationTestHarness.h"
+
+#include "osi/include/allocator.h"
+#include "osi/include/buffer_pool.h"
+#include "osi/include/osi.h"
+
+static const buffer_pool_class_t test_classes[] = {
+    {64, 16},
+    {256, 16},
+    {1024, 4},
+};
+
+#define TEST_CLASS_COUNT (sizeof(test_classes) / sizeof(test_classes[0]))
+#define THREAD_BUFFER_COUNT 10000
+
+class BufferPoolTest : public AllocationTestHarness {
+ protected:
+  void SetUp() override {
+    AllocationTestHarness::SetUp();
+    ASSERT_TRUE(buffer_pool_init(test_classes, TEST_CLASS_COUNT));
+  }
+
+  void TearDown() override {
+    buffer_pool_cleanup();
+    AllocationTestHarness::TearDown();
+  }
+};
+
+static void* alloc_free_thread(UNUSED_ATTR void* context) {
+  for (size_t i = 0; i < THREAD_BUFFER_COUNT; i++) {
+    void* buffer = osi_pool_malloc(200);
+    memset(buffer, 0x5a, 200);
+    osi_free(buffer);
+  }
+  return NULL;
+}
+
+TEST_F(BufferPoolTest, test_init_twice) {
+  EXPECT_TRUE(buffer_pool_is_initialized());
+  EXPECT_FALSE(buffer_pool_init(test_classes, TEST_CLASS_COUNT));
+}
+
+TEST_F(BufferPoolTest, test_alloc_free) {
+  void* small = osi_pool_malloc(10);
+  void* medium = osi_pool_malloc(100);
+  void* large = osi_pool_malloc(1000);
+  ASSERT_TRUE(small != NULL);
+  ASSERT_TRUE(medium != NULL);
+  ASSERT_TRUE(large != NULL);
+
+  memset(small, 0x11, 10);
+  memset(medium, 0x22, 100);
+  memset(large, 0x33, 1000);
+
+  osi_free(small);
+  osi_free(medium);
+  osi_free(large);
+}
+
+TEST_F(BufferPoolTest, test_block_reuse) {
+  void* first = osi_pool_malloc(32);
+  osi_free(first);
+  void* second = osi_pool_malloc(32);
+  EXPECT_EQ(first, second);
+  osi_free(second);
+}
+
+TEST_F(BufferPoolTest, test_oversized_falls_back) {
+  EXPECT_TRUE(buffer_pool_get(4096) == NULL);
+
+  void* buffer = osi_pool_malloc(4096);
+  ASSERT_TRUE(buffer != NULL);
+  memset(buffer, 0x44, 4096);
+  osi_free(buffer);
+}
+
+TEST_F(BufferPoolTest, test_exhausted_falls_back) {
+  void* buffers[test_classes[2].buffer_count + 2];
+  for (size_t i = 0; i < sizeof(buffers) / sizeof(buffers[0]); i++) {
+    buffers[i] = osi_pool_malloc(1000);
+    ASSERT_TRUE(buffers[i] != NULL);
+  }
+
+  EXPECT_TRUE(buffer_pool_get(1000) == NULL);
+
+  for (size_t i = 0; i < sizeof(buffers) / sizeof(buffers[0]); i++)
+    osi_free(buffers[i]);
+
+  void* buffer = buffer_pool_get(1000);
+  EXPECT_TRUE(buffer != NULL);
+  EXPECT_TRUE(buffer_pool_put(buffer));
+}
+
+TEST_F(BufferPoolTest, test_put_foreign_pointer) {
+  EXPECT_FALSE(buffer_pool_put(NULL));
+
+  void* buffer = osi_malloc(64);
+  EXPECT_FALSE(buffer_pool_put(buffer));
+  osi_free(buffer);
+}
+
+TEST_F(BufferPoolTest, test_multiple_threads) {
+  const size_t thread_count = 4;
+  pthread_t threads[thread_count];
+
+  for (size_t i = 0; i < thread_count; i++)
+    ASSERT_EQ(0, pthread_create(&threads[i], NULL, alloc_free_thread, NULL));
+  for (size_t i = 0; i < thread_count; i++)
+    pthread_join(threads[i], NULL);
+
+  // Every block is back in the pool once the threads flushed their caches.
+  void* buffers[test_classes[1].buffer_count];
+  for (size_t i = 0; i < test_classes[1].buffer_count; i++) {
+    buffers[i] = buffer_pool_get(200);
+    EXPECT_TRUE(buffers[i] != NULL);
+  }
+  for (size_t i = 0; i < test_classes[1].buffer_count; i++)
+    buffer_pool_put(buffers[i]);
+}
+
+TEST_F(BufferPoolTest, test_debug_dump) {
+  void* buffer = osi_pool_malloc(64);
+
+  int fds[2];
+  ASSERT_EQ(0, pipe(fds));
+  buffer_pool_debug_dump(fds[1]);
+  close(fds[1]);
+
+  char dump[1024] = {0};
+  ASSERT_GT(read(fds[0], dump, sizeof(dump) - 1), 0);
+  close(fds[0]);
+  EXPECT_TRUE(strstr(dump, "Class 64 octets") != NULL);
+  EXPECT_TRUE(strstr(dump, "high-water mark") != NULL);
+
+  osi_free(buffer);
+}
@@ -0,0 +1,136 @@
+/******************************************************************************
+ * Copyright (c) 2026 Qualcomm Innovation Center, Inc. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ *
+ *******************************************************************************/
+
+#include <benchmark/benchmark.h>
+#include <stdio.h>
+#include <unistd.h>
+#include <string>
+#include <vector>
+
+#include "osi/include/config.h"
+
+using ::benchmark::State;
+
+#if defined(OS_GENERIC)
+static const char kConfigFile[] = "/tmp/bt_config_benchmark.conf";
+#else
+static const char kConfigFile[] = "/data/local/tmp/bt_config_benchmark.conf";
+#endif
+
+// Number of bonded devices in the generated bt_config.conf.
+#define DEVICE_COUNT 500
+
+// Keys written for every device, in the order btif stores them.
+static const char* const kDeviceKeys[] = {
+    "Name",        "DevClass",     "DevType",     "AddrType",
+    "Timestamp",   "Manufacturer", "LmpVer",      "LmpSubVer",
+    "Service",     "LinkKeyType",  "PinLength",   "LinkKey",
+    "LE_KEY_PENC", "LE_KEY_PID",   "LE_KEY_LENC", "LE_KEY_LID",
+};
+#define KEY_COUNT (sizeof(kDeviceKeys) / sizeof(kDeviceKeys[0]))
+
+static std::vector<std::string> device_names;
+
+static std::string make_device_name(int index) {
+  char name[18];
+  snprintf(name, sizeof(name), "00:1b:dc:%02x:%02x:%02x", (index >> 16) & 0xff,
+           (index >> 8) & 0xff, index & 0xff);
+  return name;
+}
+
+// Writes a config shaped like a real bt_config.conf: the Info and Adapter
+// sections followed by one section per bonded device.
+static void write_config_file() {
+  FILE* fp = fopen(kConfigFile, "wt");
+  if (!fp) return;
+
+  fprintf(fp, "[Info]\nFileSource = Empty\nTimeCreated = 2018-01-01\n\n");
+  fprintf(fp,
+          "[Adapter]\nAddress = 00:1b:dc:ff:ff:ff\nName = benchmark\n"
+          "ScanMode = 0\nDiscoveryTimeout = 120\n\n");
+  for (int i = 0; i < DEVICE_COUNT; i++) {
+    device_names.push_back(make_device_name(i));
+    fprintf(fp, "[%s]\n", device_names.back().c_str());
+    for (size_t k = 0; k < KEY_COUNT; k++)
+      fprintf(fp, "%s = %08x%08zx\n", kDeviceKeys[k], i, k);
+    fprintf(fp, "\n");
+  }
+  fclose(fp);
+}
+
+// Parses the whole file, as btif_config does at startup.
+static void BM_ConfigNew(State& state) {
+  for (auto _ : state) {
+    std::unique_ptr<config_t> config = config_new(kConfigFile);
+    benchmark::DoNotOptimize(config.get());
+  }
+  state.SetItemsProcessed(state.iterations() * DEVICE_COUNT);
+}
+BENCHMARK(BM_ConfigNew);
+
+// Looks up every key of every device; the items processed are lookups.
+static void BM_ConfigGetString(State& state) {
+  std::unique_ptr<config_t> config = config_new(kConfigFile);
+  if (!config) {
+    state.SkipWithError("unable to load config");
+    return;
+  }
+
+  for (auto _ : state) {
+    for (const std::string& name : device_names) {
+      for (const char* key : kDeviceKeys) {
+        benchmark::DoNotOptimize(
+            config_get_string(*config, name, key, nullptr));
+      }
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * DEVICE_COUNT * KEY_COUNT);
+}
+BENCHMARK(BM_ConfigGetString);
+
+// Overwrites the timestamp of every device, as done on each connection.
+static void BM_ConfigSetInt(State& state) {
+  std::unique_ptr<config_t> config = config_new(kConfigFile);
+  if (!config) {
+    state.SkipWithError("unable to load config");
+    return;
+  }
+
+  int timestamp = 0;
+  for (auto _ : state) {
+    for (const std::string& name : device_names)
+      config_set_int(config.get(), name, "Timestamp", timestamp++);
+  }
+  state.SetItemsProcessed(state.iterations() * DEVICE_COUNT);
+}
+BENCHMARK(BM_ConfigSetInt);
+
+// Removes and adds back the last bonded device.
+static void BM_ConfigRemoveSection(State& state) {
+  std::unique_ptr<config_t> config = config_new(kConfigFile);
+  if (!config) {
+    state.SkipWithError("unable to load config");
+    return;
+  }
+
+  const std::string& name = device_names.back();
+  for (auto _ : state) {
+    config_remove_section(config.get(), name);
+    config_set_string(config.get(), name, "Name", "benchmark");
+  }
+}
+BENCHMARK(BM_ConfigRemoveSection);
+
+int main(int argc, char** argv) {
+  write_config_file();
+
+  ::benchmark::Initialize(&argc, argv);
+  if (!::benchmark::ReportUnrecognizedArguments(argc, argv))
+    ::benchmark::RunSpecifiedBenchmarks();
+
+  unlink(kConfigFile);
+  return 0;
+}
@@ -0,0 +1,211 @@
+/******************************************************************************
+ * Copyright (c) 2026 Qualcomm Innovation Center, Inc. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ *
+ *******************************************************************************/
+
+#include <gtest/gtest.h>
+#include <stdio.h>
+#include <unistd.h>
+
+#include <string>
+#include <vector>
+
+#include "osi/include/config.h"
+
+namespace {
+
+std::string temp_file(const char* name) { return testing::TempDir() + name; }
+
+void write_file(const std::string& filename, const std::string& content) {
+  FILE* fp = fopen(filename.c_str(), "wt");
+  ASSERT_NE(fp, nullptr);
+  EXPECT_EQ(fwrite(content.data(), 1, content.size(), fp), content.size());
+  fclose(fp);
+}
+
+std::string read_file(const std::string& filename) {
+  std::string content;
+  FILE* fp = fopen(filename.c_str(), "rt");
+  if (fp == nullptr) return content;
+  char buffer[256];
+  size_t length;
+  while ((length = fread(buffer, 1, sizeof(buffer), fp)) > 0)
+    content.append(buffer, length);
+  fclose(fp);
+  return content;
+}
+
+// Checks that the indexes of |config| hold every section and entry in it,
+// pointing at them, and nothing else.
+void expect_index_consistent(config_t& config) {
+  EXPECT_EQ(config.index.size(), config.sections.size());
+  for (auto section = config.sections.begin(); section != config.sections.end();
+       ++section) {
+    EXPECT_TRUE(config.Find(section->name) == section) << section->name;
+    EXPECT_EQ(section->index.size(), section->entries.size()) << section->name;
+    for (auto entry = section->entries.begin(); entry != section->entries.end();
+         ++entry)
+      EXPECT_TRUE(section->Find(entry->key) == entry)
+          << section->name << " " << entry->key;
+  }
+}
+
+}  // namespace
+
+TEST(ConfigIndexTest, lookups_after_set_and_remove) {
+  std::unique_ptr<config_t> config = config_new_empty();
+  config_set_string(config.get(), "00:11:22:33:44:55", "Name", "first");
+  config_set_string(config.get(), "00:11:22:33:44:66", "Name", "second");
+  config_set_string(config.get(), "00:11:22:33:44:55", "Name", "renamed");
+  config_set_int(config.get(), "00:11:22:33:44:55", "DevType", 2);
+
+  EXPECT_EQ(*config_get_string(*config, "00:11:22:33:44:55", "Name", nullptr),
+            "renamed");
+  EXPECT_EQ(config_get_int(*config, "00:11:22:33:44:55", "DevType", 0), 2);
+
+  EXPECT_TRUE(config_remove_key(config.get(), "00:11:22:33:44:55", "Name"));
+  EXPECT_FALSE(config_has_key(*config, "00:11:22:33:44:55", "Name"));
+  EXPECT_TRUE(config_has_key(*config, "00:11:22:33:44:55", "DevType"));
+
+  EXPECT_TRUE(config_remove_section(config.get(), "00:11:22:33:44:55"));
+  EXPECT_FALSE(config_has_section(*config, "00:11:22:33:44:55"));
+  EXPECT_TRUE(config_has_section(*config, "00:11:22:33:44:66"));
+  EXPECT_FALSE(config_remove_section(config.get(), "00:11:22:33:44:55"));
+  expect_index_consistent(*config);
+}
+
+TEST(ConfigIndexTest, insertion_order_is_kept) {
+  std::unique_ptr<config_t> config = config_new_empty();
+  const char* const names[] = {"Info", "Adapter", "00:11:22:33:44:55",
+                               "00:11:22:33:44:66"};
+  for (const char* name : names) config_set_string(config.get(), name, "b", "1");
+  config_set_string(config.get(), "Adapter", "a", "2");
+  config_remove_section(config.get(), "Info");
+  config_set_string(config.get(), "Info", "b", "3");
+
+  std::vector<std::string> order;
+  for (const section_t& section : config->sections) order.push_back(section.name);
+  EXPECT_EQ(order, (std::vector<std::string>{"Adapter", "00:11:22:33:44:55",
+                                             "00:11:22:33:44:66", "Info"}));
+
+  auto adapter = config->Find("Adapter");
+  ASSERT_NE(adapter, config->sections.end());
+  EXPECT_EQ(adapter->entries.front().key, "b");
+  EXPECT_EQ(adapter->entries.back().key, "a");
+}
+
+TEST(ConfigIndexTest, copies_have_their_own_index) {
+  config_t config;
+  config_set_string(&config, "Adapter", "Name", "original");
+
+  config_t copy = config;
+  config_set_string(&copy, "Adapter", "Name", "copy");
+  config_remove_section(&config, "Adapter");
+
+  EXPECT_FALSE(config_has_section(config, "Adapter"));
+  EXPECT_EQ(*config_get_string(copy, "Adapter", "Name", nullptr), "copy");
+
+  section_t section = *copy.Find("Adapter");
+  section.Set("Name", "section");
+  EXPECT_EQ(section.Find("Name")->value, "section");
+  EXPECT_EQ(*config_get_string(copy, "Adapter", "Name", nullptr), "copy");
+}
+
+// Sections and keys are saved in the order they were first added, values
+// changed in place keep their position, and removed then added ones go last.
+TEST(ConfigIndexTest, save_keeps_insertion_order) {
+  const std::string filename = temp_file("config_index_test_save.conf");
+  std::unique_ptr<config_t> config = config_new_empty();
+  config_set_string(config.get(), "Info", "FileSource", "Empty");
+  config_set_string(config.get(), "Adapter", "Address", "00:11:22:33:44:55");
+  config_set_string(config.get(), "Adapter", "Name", "first");
+  config_set_string(config.get(), "Adapter", "ScanMode", "0");
+  config_set_string(config.get(), "00:11:22:33:44:66", "Name", "peer");
+  config_set_string(config.get(), "Adapter", "Name", "renamed");
+  config_remove_key(config.get(), "Adapter", "Address");
+  config_set_string(config.get(), "Adapter", "Address", "00:11:22:33:44:77");
+  config_remove_section(config.get(), "Info");
+  config_set_string(config.get(), "Info", "FileSource", "Legacy");
+
+  ASSERT_TRUE(config_save(*config, filename.c_str()));
+  EXPECT_EQ(read_file(filename),
+            "[Adapter]\n"
+            "Name = renamed\n"
+            "ScanMode = 0\n"
+            "Address = 00:11:22:33:44:77\n"
+            "\n"
+            "[00:11:22:33:44:66]\n"
+            "Name = peer\n"
+            "\n"
+            "[Info]\n"
+            "FileSource = Legacy\n"
+            "\n");
+
+  // What is read back is saved the same way
+  std::unique_ptr<config_t> loaded = config_new(filename.c_str());
+  ASSERT_NE(loaded, nullptr);
+  const std::string resaved = filename + ".resaved";
+  ASSERT_TRUE(config_save(*loaded, resaved.c_str()));
+  EXPECT_EQ(read_file(resaved), read_file(filename));
+
+  unlink(filename.c_str());
+  unlink(resaved.c_str());
+}
+
+// A parsed file is indexed as if it was built with config_set_string(): keys
+// before the first section go to the default section, a repeated section is
+// merged into the first one, and a repeated key keeps its first position with
+// the last value.
+TEST(ConfigIndexTest, parse_builds_consistent_index) {
+  const std::string filename = temp_file("config_index_test_parse.conf");
+  write_file(filename,
+             "first_key = value\n"
+             "# comment\n"
+             "[A]\n"
+             "one = 1\n"
+             "two = 2\n"
+             "\n"
+             "[B]\n"
+             "one = b1\n"
+             "[A]\n"
+             "three = 3\n"
+             "one = 1 again\n"
+             "[unterminated\n"
+             "skipped = 1\n"
+             "[B]\n"
+             "no separator\n");
+
+  std::unique_ptr<config_t> config = config_new(filename.c_str());
+  unlink(filename.c_str());
+  ASSERT_NE(config, nullptr);
+  expect_index_consistent(*config);
+
+  std::vector<std::string> order;
+  for (const section_t& section : config->sections) order.push_back(section.name);
+  EXPECT_EQ(order,
+            (std::vector<std::string>{CONFIG_DEFAULT_SECTION, "A", "B"}));
+
+  EXPECT_EQ(*config_get_string(*config, CONFIG_DEFAULT_SECTION, "first_key",
+                               nullptr),
+            "value");
+  auto a = config->Find("A");
+  ASSERT_NE(a, config->sections.end());
+  std::vector<std::string> keys;
+  for (const entry_t& entry : a->entries) keys.push_back(entry.key);
+  EXPECT_EQ(keys, (std::vector<std::string>{"one", "two", "three"}));
+  EXPECT_EQ(*config_get_string(*config, "A", "one", nullptr), "1 again");
+  EXPECT_EQ(config_get_int(*config, "A", "three", 0), 3);
+  EXPECT_EQ(*config_get_string(*config, "B", "one", nullptr), "b1");
+  EXPECT_FALSE(config_has_section(*config, "unterminated"));
+  EXPECT_FALSE(config_has_key(*config, "B", "skipped"));
+
+  // Changes after the parse go through the same index
+  EXPECT_TRUE(config_remove_key(config.get(), "A", "two"));
+  EXPECT_TRUE(config_remove_section(config.get(), "B"));
+  config_set_string(config.get(), "B", "one", "new");
+  config_set_string(config.get(), "A", "two", "last");
+  expect_index_consistent(*config);
+  EXPECT_EQ(config->sections.back().name, "B");
+  EXPECT_EQ(a->entries.back().key, "two");
+}
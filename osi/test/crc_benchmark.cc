@@ -0,0 +1,84 @@
+/******************************************************************************
+ * Copyright (c) 2026 Qualcomm Innovation Center, Inc. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ *
+ *******************************************************************************/
+
+#include <benchmark/benchmark.h>
+#include <stdlib.h>
+#include <vector>
+
+#include "osi/include/crc.h"
+
+using ::benchmark::State;
+
+// Byte at a time CRC-16, as L2CAP computed its FCS before slice-by-8.
+static uint16_t crc16_bytewise(uint16_t crc, const uint8_t* data,
+                               size_t length) {
+  static uint16_t table[256];
+  if (table[1] == 0) {
+    for (int b = 0; b < 256; b++) {
+      uint16_t value = b;
+      for (int bit = 0; bit < 8; bit++)
+        value = (value & 1) ? (value >> 1) ^ 0xa001 : value >> 1;
+      table[b] = value;
+    }
+  }
+
+  while (length--) crc = (crc >> 8) ^ table[(crc ^ *data++) & 0xff];
+  return crc;
+}
+
+static std::vector<uint8_t> make_frame(size_t length) {
+  std::vector<uint8_t> frame(length);
+  srand(1);
+  for (uint8_t& byte : frame) byte = rand();
+  return frame;
+}
+
+// Frame sizes: an S-frame, small and default (339 bytes) ACL payloads, the
+// default ERTM MPS and a large PDU.
+#define FRAME_SIZES Arg(6)->Arg(64)->Arg(339)->Arg(1021)->Arg(4096)
+
+static void BM_Crc16Bytewise(State& state) {
+  std::vector<uint8_t> frame = make_frame(state.range(0));
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(crc16_bytewise(0, frame.data(), frame.size()));
+  }
+  state.SetBytesProcessed(state.iterations() * frame.size());
+}
+BENCHMARK(BM_Crc16Bytewise)->FRAME_SIZES;
+
+static void BM_Crc16(State& state) {
+  std::vector<uint8_t> frame = make_frame(state.range(0));
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(crc16_update(0, frame.data(), frame.size()));
+  }
+  state.SetBytesProcessed(state.iterations() * frame.size());
+}
+BENCHMARK(BM_Crc16)->FRAME_SIZES;
+
+// A frame checked as its L2CAP header and its payload, in separate buffers.
+static void BM_Crc16Chained(State& state) {
+  std::vector<uint8_t> frame = make_frame(state.range(0));
+  size_t header_len = frame.size() < 4 ? frame.size() : 4;
+  while (state.KeepRunning()) {
+    uint16_t crc = crc16_update(0, frame.data(), header_len);
+    benchmark::DoNotOptimize(crc16_update(crc, frame.data() + header_len,
+                                          frame.size() - header_len));
+  }
+  state.SetBytesProcessed(state.iterations() * frame.size());
+}
+BENCHMARK(BM_Crc16Chained)->FRAME_SIZES;
+
+// The RFCOMM FCS covers 2 or 3 header bytes, or the whole UIH frame.
+static void BM_Crc8(State& state) {
+  std::vector<uint8_t> frame = make_frame(state.range(0));
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(crc8_update(0xff, frame.data(), frame.size()));
+  }
+  state.SetBytesProcessed(state.iterations() * frame.size());
+}
+BENCHMARK(BM_Crc8)->Arg(3)->Arg(64);
+
+BENCHMARK_MAIN();
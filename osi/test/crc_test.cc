@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+
+#include <stdlib.h>
+#include <vector>
+
+#include "osi/include/crc.h"
+
+// Bit at a time CRC-16, the definition the table driven one must match.
+static uint16_t crc16_reference(uint16_t crc, const uint8_t* data,
+                                size_t length) {
+  while (length--) {
+    crc ^= *data++;
+    for (int bit = 0; bit < 8; bit++)
+      crc = (crc & 1) ? (crc >> 1) ^ 0xa001 : crc >> 1;
+  }
+  return crc;
+}
+
+static std::vector<uint8_t> random_bytes(size_t length) {
+  std::vector<uint8_t> data(length);
+  for (uint8_t& byte : data) byte = rand();
+  return data;
+}
+
+static const uint8_t kCheckInput[] = {'1', '2', '3', '4', '5',
+                                      '6', '7', '8', '9'};
+
+TEST(CrcTest, test_crc16_check_value) {
+  EXPECT_EQ(0xbb3d, crc16_update(0, kCheckInput, sizeof(kCheckInput)));
+}
+
+TEST(CrcTest, test_crc16_empty) {
+  EXPECT_EQ(0, crc16_update(0, NULL, 0));
+  EXPECT_EQ(0x1234, crc16_update(0x1234, NULL, 0));
+}
+
+TEST(CrcTest, test_crc16_matches_reference) {
+  srand(1);
+  for (size_t length = 0; length < 100; length++) {
+    std::vector<uint8_t> data = random_bytes(length);
+    EXPECT_EQ(crc16_reference(0, data.data(), length),
+              crc16_update(0, data.data(), length))
+        << "length " << length;
+  }
+
+  std::vector<uint8_t> data = random_bytes(1021);
+  EXPECT_EQ(crc16_reference(0, data.data(), data.size()),
+            crc16_update(0, data.data(), data.size()));
+}
+
+TEST(CrcTest, test_crc16_chained) {
+  srand(2);
+  std::vector<uint8_t> data = random_bytes(64);
+  uint16_t whole = crc16_update(0, data.data(), data.size());
+
+  for (size_t split = 0; split <= data.size(); split++) {
+    uint16_t crc = crc16_update(0, data.data(), split);
+    crc = crc16_update(crc, data.data() + split, data.size() - split);
+    EXPECT_EQ(whole, crc) << "split at " << split;
+  }
+}
+
+// An L2CAP frame followed by its FCS, least significant byte first, leaves no
+// remainder.
+TEST(CrcTest, test_crc16_l2cap_fcs) {
+  uint8_t frame[] = {0x06, 0x00, 0x40, 0x00, 0x02, 0x00, 0x00, 0x00};
+  uint16_t fcs = crc16_update(0, frame, 6);
+  frame[6] = fcs & 0xff;
+  frame[7] = fcs >> 8;
+  EXPECT_EQ(0, crc16_update(0, frame, sizeof(frame)));
+}
+
+TEST(CrcTest, test_crc8_check_value) {
+  // CRC-8/ROHC, the GSM 07.10 CRC before its final inversion
+  EXPECT_EQ(0xd0, crc8_update(0xff, kCheckInput, sizeof(kCheckInput)));
+}
+
+TEST(CrcTest, test_crc8_rfcomm_fcs) {
+  // SABM on DLCI 0: address 0x03, control 0x3F, length 0x01, FCS 0x1C
+  const uint8_t sabm[] = {0x03, 0x3f, 0x01};
+  uint8_t fcs = 0xff - crc8_update(0xff, sabm, sizeof(sabm));
+  EXPECT_EQ(0x1c, fcs);
+
+  // The receiver sees 0xCF once the FCS is included
+  EXPECT_EQ(0xcf, crc8_update(crc8_update(0xff, sabm, sizeof(sabm)), &fcs, 1));
+}
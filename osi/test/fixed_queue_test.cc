@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 
+#include <pthread.h>
 #include <climits>
 
 #include "AllocationTestHarness.h"
@@ -348,3 +349,164 @@ TEST_F(FixedQueueTest, test_fixed_queue_register_dequeue) {
   thread_free(worker_thread);
   fixed_queue_free(queue, NULL);
 }
+
+TEST_F(FixedQueueTest, test_fixed_queue_ring_new_free) {
+  fixed_queue_t* queue;
+
+  // Test a corner case: queue of size 0
+  queue = fixed_queue_new(0, FIXED_QUEUE_MODE_RING);
+  ASSERT_TRUE(queue != NULL);
+  EXPECT_EQ((size_t)0, fixed_queue_capacity(queue));
+  EXPECT_FALSE(fixed_queue_try_enqueue(queue, (void*)DUMMY_DATA_STRING));
+  fixed_queue_free(queue, NULL);
+
+  // Test a corner case: queue of maximum ring size
+  queue = fixed_queue_new(FIXED_QUEUE_RING_MAX_CAPACITY, FIXED_QUEUE_MODE_RING);
+  ASSERT_TRUE(queue != NULL);
+  EXPECT_EQ((size_t)FIXED_QUEUE_RING_MAX_CAPACITY, fixed_queue_capacity(queue));
+  fixed_queue_free(queue, NULL);
+
+  // Test freeing a non-empty queue with a callback to free entries
+  test_queue_entry_free_counter = 0;
+  queue = fixed_queue_new(TEST_QUEUE_SIZE, FIXED_QUEUE_MODE_RING);
+  ASSERT_TRUE(queue != NULL);
+  fixed_queue_enqueue(queue, (void*)DUMMY_DATA_STRING1);
+  fixed_queue_enqueue(queue, (void*)DUMMY_DATA_STRING2);
+  fixed_queue_free(queue, test_queue_entry_free_cb);
+  EXPECT_EQ(2, test_queue_entry_free_counter);
+}
+
+TEST_F(FixedQueueTest, test_fixed_queue_ring_enqueue_dequeue) {
+  fixed_queue_t* queue =
+      fixed_queue_new(TEST_QUEUE_SIZE, FIXED_QUEUE_MODE_RING);
+  ASSERT_TRUE(queue != NULL);
+  EXPECT_EQ(TEST_QUEUE_SIZE, fixed_queue_capacity(queue));
+
+  // Test blocking enqueue and blocking dequeue
+  fixed_queue_enqueue(queue, (void*)DUMMY_DATA_STRING);
+  EXPECT_EQ((size_t)1, fixed_queue_length(queue));
+  EXPECT_EQ(DUMMY_DATA_STRING, fixed_queue_dequeue(queue));
+  EXPECT_TRUE(fixed_queue_is_empty(queue));
+
+  // Test ordering and peek first/last
+  fixed_queue_enqueue(queue, (void*)DUMMY_DATA_STRING1);
+  fixed_queue_enqueue(queue, (void*)DUMMY_DATA_STRING2);
+  fixed_queue_enqueue(queue, (void*)DUMMY_DATA_STRING3);
+  EXPECT_EQ(DUMMY_DATA_STRING1, fixed_queue_try_peek_first(queue));
+  EXPECT_EQ(DUMMY_DATA_STRING3, fixed_queue_try_peek_last(queue));
+  EXPECT_EQ(DUMMY_DATA_STRING1, fixed_queue_try_dequeue(queue));
+  EXPECT_EQ(DUMMY_DATA_STRING2, fixed_queue_try_dequeue(queue));
+  EXPECT_EQ(DUMMY_DATA_STRING3, fixed_queue_try_dequeue(queue));
+  EXPECT_EQ(NULL, fixed_queue_try_peek_first(queue));
+  EXPECT_EQ(NULL, fixed_queue_try_peek_last(queue));
+
+  // Test non-blocking enqueue beyond queue capacity, which is not rounded up
+  // to the ring size
+  for (size_t i = 0; i < TEST_QUEUE_SIZE; i++) {
+    EXPECT_TRUE(fixed_queue_try_enqueue(queue, (void*)DUMMY_DATA_STRING));
+  }
+  EXPECT_FALSE(fixed_queue_try_enqueue(queue, (void*)DUMMY_DATA_STRING));
+  EXPECT_EQ(TEST_QUEUE_SIZE, fixed_queue_length(queue));
+
+  // Test flushing, and that the ring wraps around afterwards
+  fixed_queue_flush(queue, NULL);
+  EXPECT_TRUE(fixed_queue_is_empty(queue));
+  for (size_t i = 0; i < 3 * TEST_QUEUE_SIZE; i++) {
+    EXPECT_TRUE(fixed_queue_try_enqueue(queue, (void*)DUMMY_DATA_STRING));
+    EXPECT_EQ(DUMMY_DATA_STRING, fixed_queue_try_dequeue(queue));
+  }
+  EXPECT_EQ(NULL, fixed_queue_try_dequeue(queue));
+
+  fixed_queue_free(queue, NULL);
+}
+
+TEST_F(FixedQueueTest, test_fixed_queue_ring_get_enqueue_dequeue_fd) {
+  fixed_queue_t* queue =
+      fixed_queue_new(TEST_QUEUE_SIZE, FIXED_QUEUE_MODE_RING);
+  ASSERT_TRUE(queue != NULL);
+
+  int enqueue_fd = fixed_queue_get_enqueue_fd(queue);
+  int dequeue_fd = fixed_queue_get_dequeue_fd(queue);
+
+  // Test the file descriptors of an empty queue
+  EXPECT_TRUE(is_fd_readable(enqueue_fd));
+  EXPECT_FALSE(is_fd_readable(dequeue_fd));
+
+  // Test the file descriptors of a non-empty queue, which stay readable until
+  // the last element is dequeued
+  fixed_queue_enqueue(queue, (void*)DUMMY_DATA_STRING1);
+  fixed_queue_enqueue(queue, (void*)DUMMY_DATA_STRING2);
+  EXPECT_TRUE(is_fd_readable(enqueue_fd));
+  EXPECT_TRUE(is_fd_readable(dequeue_fd));
+  fixed_queue_dequeue(queue);
+  EXPECT_TRUE(is_fd_readable(dequeue_fd));
+  fixed_queue_dequeue(queue);
+  EXPECT_FALSE(is_fd_readable(dequeue_fd));
+
+  // Test the file descriptors of a full queue
+  for (size_t i = 0; i < TEST_QUEUE_SIZE; i++) {
+    EXPECT_TRUE(fixed_queue_try_enqueue(queue, (void*)DUMMY_DATA_STRING));
+  }
+  EXPECT_FALSE(is_fd_readable(enqueue_fd));
+  EXPECT_TRUE(is_fd_readable(dequeue_fd));
+
+  // Test the file descriptors once space is available again
+  fixed_queue_dequeue(queue);
+  EXPECT_TRUE(is_fd_readable(enqueue_fd));
+  EXPECT_TRUE(is_fd_readable(dequeue_fd));
+
+  fixed_queue_free(queue, NULL);
+}
+
+TEST_F(FixedQueueTest, test_fixed_queue_ring_register_dequeue) {
+  fixed_queue_t* queue =
+      fixed_queue_new(TEST_QUEUE_SIZE, FIXED_QUEUE_MODE_RING);
+  ASSERT_TRUE(queue != NULL);
+
+  received_message_future = future_new();
+  ASSERT_TRUE(received_message_future != NULL);
+
+  thread_t* worker_thread = thread_new("test_fixed_queue_worker_thread");
+  ASSERT_TRUE(worker_thread != NULL);
+
+  fixed_queue_register_dequeue(queue, thread_get_reactor(worker_thread),
+                               fixed_queue_ready, NULL);
+
+  // Add a message to the queue, and expect to receive it
+  fixed_queue_enqueue(queue, (void*)DUMMY_DATA_STRING);
+  const char* msg = (const char*)future_await(received_message_future);
+  EXPECT_EQ(DUMMY_DATA_STRING, msg);
+
+  fixed_queue_unregister_dequeue(queue);
+  thread_free(worker_thread);
+  fixed_queue_free(queue, NULL);
+}
+
+static void* ring_producer(void* context) {
+  fixed_queue_t* queue = static_cast<fixed_queue_t*>(context);
+  for (size_t i = 0; i < 10000; i++)
+    fixed_queue_enqueue(queue, (void*)DUMMY_DATA_STRING);
+  return NULL;
+}
+
+TEST_F(FixedQueueTest, test_fixed_queue_ring_multiple_producers) {
+  static const size_t kProducers = 4;
+  fixed_queue_t* queue =
+      fixed_queue_new(TEST_QUEUE_SIZE, FIXED_QUEUE_MODE_RING);
+  ASSERT_TRUE(queue != NULL);
+
+  pthread_t producers[kProducers];
+  for (size_t i = 0; i < kProducers; i++)
+    pthread_create(&producers[i], NULL, ring_producer, queue);
+
+  // Producers block on the full ring until the consumer catches up
+  for (size_t i = 0; i < kProducers * 10000; i++)
+    EXPECT_EQ(DUMMY_DATA_STRING, fixed_queue_dequeue(queue));
+
+  for (size_t i = 0; i < kProducers; i++) pthread_join(producers[i], NULL);
+
+  EXPECT_TRUE(fixed_queue_is_empty(queue));
+  EXPECT_FALSE(is_fd_readable(fixed_queue_get_dequeue_fd(queue)));
+  EXPECT_TRUE(is_fd_readable(fixed_queue_get_enqueue_fd(queue)));
+  fixed_queue_free(queue, NULL);
+}
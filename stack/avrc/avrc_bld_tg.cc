@@ -36,9 +36,6 @@
    (((_p_player)->play_status <= AVRC_PLAYSTATE_REV_SEEK) || \
     ((_p_player)->play_status == AVRC_PLAYSTATE_ERROR)))
 
-/* 17 = item_type(1) + item len(2) + min item (14) */
-#define AVRC_MIN_LEN_GET_FOLDER_ITEMS_RSP 17
-
 /*******************************************************************************
  *
  * Function         avrc_bld_get_capability_rsp
@@ -1089,6 +1086,184 @@ static tAVRC_STS avrc_bld_get_folder_items_rsp(tAVRC_GET_ITEMS_RSP* p_rsp,
   return status;
 }
 
+/*******************************************************************************
+ *
+ * Function         avrc_bld_folder_item
+ *
+ * Description      This function serializes one item of a Get Folder Items
+ *                  response: item type, item length and the item with all of
+ *                  its attributes, the same way avrc_bld_get_folder_items_rsp()
+ *                  adds an item that fits.
+ *
+ * Returns          The number of bytes written to p_data.
+ *                  0, if the item or one of its attributes is not valid, or
+ *                  if the item does not fit in len_left.
+ *
+ ******************************************************************************/
+uint16_t avrc_bld_folder_item(const tAVRC_ITEM* p_item, uint8_t* p_data,
+                              uint16_t len_left) {
+  uint8_t* p_start = p_data;
+  uint8_t *p_item_len, *p_attr_count;
+  uint32_t item_len;
+  uint32_t attr_len;
+
+  if (len_left < 3) return 0;
+  UINT8_TO_BE_STREAM(p_data, p_item->item_type);
+  p_item_len = p_data;
+  p_data += 2;
+  len_left -= 3; /* item_type(1) + item len(2) */
+
+  switch (p_item->item_type) {
+    case AVRC_ITEM_PLAYER: {
+      const tAVRC_ITEM_PLAYER* p_player = &p_item->u.player;
+      item_len = AVRC_FEATURE_MASK_SIZE + p_player->name.str_len + 12;
+      if (len_left < item_len || !AVRC_ITEM_PLAYER_IS_VALID(p_player))
+        return 0;
+
+      UINT16_TO_BE_STREAM(p_data, p_player->player_id);
+      UINT8_TO_BE_STREAM(p_data, p_player->major_type);
+      UINT32_TO_BE_STREAM(p_data, p_player->sub_type);
+      UINT8_TO_BE_STREAM(p_data, p_player->play_status);
+      ARRAY_TO_BE_STREAM(p_data, p_player->features, AVRC_FEATURE_MASK_SIZE);
+      UINT16_TO_BE_STREAM(p_data, p_player->name.charset_id);
+      UINT16_TO_BE_STREAM(p_data, p_player->name.str_len);
+      ARRAY_TO_BE_STREAM(p_data, p_player->name.p_str,
+                         p_player->name.str_len);
+      break;
+    }
+
+    case AVRC_ITEM_FOLDER: {
+      const tAVRC_ITEM_FOLDER* p_folder = &p_item->u.folder;
+      item_len = AVRC_UID_SIZE + p_folder->name.str_len + 6;
+      if (len_left < item_len || !p_folder->name.p_str ||
+          p_folder->type > AVRC_FOLDER_TYPE_YEARS)
+        return 0;
+
+      ARRAY_TO_BE_STREAM(p_data, p_folder->uid, AVRC_UID_SIZE);
+      UINT8_TO_BE_STREAM(p_data, p_folder->type);
+      UINT8_TO_BE_STREAM(p_data, p_folder->playable);
+      UINT16_TO_BE_STREAM(p_data, p_folder->name.charset_id);
+      UINT16_TO_BE_STREAM(p_data, p_folder->name.str_len);
+      ARRAY_TO_BE_STREAM(p_data, p_folder->name.p_str,
+                         p_folder->name.str_len);
+      break;
+    }
+
+    case AVRC_ITEM_MEDIA: {
+      const tAVRC_ITEM_MEDIA* p_media = &p_item->u.media;
+      item_len = AVRC_UID_SIZE + p_media->name.str_len + 6;
+      if (len_left < item_len || !p_media->name.p_str ||
+          p_media->type > AVRC_MEDIA_TYPE_VIDEO)
+        return 0;
+
+      ARRAY_TO_BE_STREAM(p_data, p_media->uid, AVRC_UID_SIZE);
+      UINT8_TO_BE_STREAM(p_data, p_media->type);
+      UINT16_TO_BE_STREAM(p_data, p_media->name.charset_id);
+      UINT16_TO_BE_STREAM(p_data, p_media->name.str_len);
+      ARRAY_TO_BE_STREAM(p_data, p_media->name.p_str, p_media->name.str_len);
+      p_attr_count = p_data++;
+      *p_attr_count = 0;
+      len_left -= item_len;
+      for (uint8_t yy = 0; yy < p_media->attr_count; yy++) {
+        const tAVRC_ATTR_ENTRY* p_attr = &p_media->p_attr_list[yy];
+        /* avrc_bld_get_folder_items_rsp() skips such an attribute only if
+         * it would have fit, which depends on the room of the response */
+        if (!p_attr->name.p_str ||
+            !AVRC_IS_VALID_MEDIA_ATTRIBUTE(p_attr->attr_id))
+          return 0;
+
+        attr_len = p_attr->name.str_len + 8;
+        if (len_left < attr_len) return 0;
+
+        (*p_attr_count)++;
+        UINT32_TO_BE_STREAM(p_data, p_attr->attr_id);
+        UINT16_TO_BE_STREAM(p_data, p_attr->name.charset_id);
+        UINT16_TO_BE_STREAM(p_data, p_attr->name.str_len);
+        ARRAY_TO_BE_STREAM(p_data, p_attr->name.p_str, p_attr->name.str_len);
+        item_len += attr_len;
+        len_left -= attr_len;
+      }
+      break;
+    }
+
+    default:
+      return 0;
+  }
+
+  UINT16_TO_BE_STREAM(p_item_len, item_len);
+  return (uint16_t)(p_data - p_start);
+}
+
+/*******************************************************************************
+ *
+ * Function         avrc_bld_folder_items_rsp_init
+ *
+ * Description      This function allocates a Get Folder Items response with
+ *                  no items yet, for items serialized with
+ *                  avrc_bld_folder_item().
+ *
+ * Returns          NULL, if the response could not be built.
+ *                  Otherwise, the response. *pp_items is where the first item
+ *                  goes and *p_room is the room left for items within the
+ *                  browsing MTU of the peer.
+ *
+ ******************************************************************************/
+BT_HDR* avrc_bld_folder_items_rsp_init(uint8_t handle, uint16_t uid_counter,
+                                       uint8_t** pp_items, uint16_t* p_room) {
+  tAVRC_RESPONSE rsp;
+  BT_HDR* p_pkt = NULL;
+  uint16_t len_left, mtu;
+  uint8_t* p;
+
+  memset(&rsp, 0, sizeof(rsp));
+  rsp.get_items.pdu = AVRC_PDU_GET_FOLDER_ITEMS;
+  rsp.get_items.opcode = AVRC_OP_BROWSE;
+  rsp.get_items.status = AVRC_STS_NO_ERROR;
+  rsp.get_items.uid_counter = uid_counter;
+  if (AVRC_BldResponse(handle, &rsp, &p_pkt) != AVRC_STS_NO_ERROR) {
+    osi_free(p_pkt);
+    return NULL;
+  }
+
+  /* same room as avrc_bld_get_folder_items_rsp() gives to the items */
+  len_left = BT_DEFAULT_BUFFER_SIZE - BT_HDR_SIZE;
+  p = (uint8_t*)(p_pkt + 1);
+  BE_STREAM_TO_UINT16(mtu, p);
+  if (len_left > mtu) len_left = mtu;
+  if (len_left < p_pkt->offset + p_pkt->len) {
+    osi_free(p_pkt);
+    return NULL;
+  }
+
+  *pp_items = (uint8_t*)(p_pkt + 1) + p_pkt->offset + p_pkt->len;
+  *p_room = len_left - p_pkt->offset - p_pkt->len;
+  return p_pkt;
+}
+
+/*******************************************************************************
+ *
+ * Function         avrc_bld_folder_items_rsp_done
+ *
+ * Description      This function completes a response from
+ *                  avrc_bld_folder_items_rsp_init() once item_count items of
+ *                  items_len bytes in total have been added to it.
+ *
+ * Returns          void
+ *
+ ******************************************************************************/
+void avrc_bld_folder_items_rsp_done(BT_HDR* p_pkt, uint16_t item_count,
+                                    uint16_t items_len) {
+  uint8_t* p_start = (uint8_t*)(p_pkt + 1) + p_pkt->offset;
+  /* pdu(1), len(2), status(1), uid_counter(2), num_items(2) */
+  uint8_t* p_len = p_start + 1;
+  uint8_t* p_num = p_start + 6;
+  uint16_t len = 5 + items_len;
+
+  UINT16_TO_BE_STREAM(p_num, item_count);
+  UINT16_TO_BE_STREAM(p_len, len);
+  p_pkt->len += items_len;
+}
+
 /*******************************************************************************
  *
  * Function         avrc_bld_change_path_rsp
@@ -1331,8 +1506,10 @@ static BT_HDR* avrc_bld_init_rsp_buffer(tAVRC_RESPONSE* p_rsp) {
       break;
   }
 
-  /* allocate and initialize the buffer */
-  BT_HDR* p_pkt = (BT_HDR*)osi_calloc(BT_DEFAULT_BUFFER_SIZE);
+  /* allocate and initialize the buffer, responses are short lived so they
+   * come from the buffer pool */
+  BT_HDR* p_pkt = (BT_HDR*)osi_pool_malloc(BT_DEFAULT_BUFFER_SIZE);
+  memset(p_pkt, 0, BT_DEFAULT_BUFFER_SIZE);
   uint8_t *p_data, *p_start;
 
   p_pkt->layer_specific = chnl;
@@ -106,6 +106,20 @@
 
 #define AVRC_MAX_CTRL_DATA_LEN (AVRC_PACKET_LEN)
 
+/* 17 = item_type(1) + item len(2) + min item (14) */
+#define AVRC_MIN_LEN_GET_FOLDER_ITEMS_RSP 17
+
+/* Largest folder item that fits in a Get Folder Items response:
+ * pdu(1) + len(2) + status(1) + uid_counter(2) + num_items(2) = 8 */
+#define AVRC_MAX_FOLDER_ITEM_LEN \
+  (BT_DEFAULT_BUFFER_SIZE - BT_HDR_SIZE - AVCT_BROWSE_OFFSET - 8)
+
+/* Items in a page of the folder item cache, and room for their data: items of
+ * 256 bytes on average, media items with a few attributes of usual length.
+ * The items that don't fit in their page are not cached. */
+#define AVRC_ITEM_CACHE_PAGE_ITEMS 32
+#define AVRC_ITEM_CACHE_PAGE_SIZE (AVRC_ITEM_CACHE_PAGE_ITEMS * 256)
+
 /* Timeout for waiting for avrc command responses (in milliseconds) */
 #ifndef AVRC_CMD_TOUT_MS
 #define AVRC_CMD_TOUT_MS (2 * 1000)
@@ -172,5 +186,13 @@ extern bool avrc_is_valid_opcode(uint8_t opcode);
 extern void avrc_flush_cmd_q(uint8_t handle);
 void avrc_start_cmd_timer(uint8_t handle, uint8_t label, uint8_t msg_mask);
 void avrc_send_next_vendor_cmd(uint8_t handle);
+extern uint16_t avrc_bld_folder_item(const tAVRC_ITEM* p_item, uint8_t* p_data,
+                                     uint16_t len_left);
+extern BT_HDR* avrc_bld_folder_items_rsp_init(uint8_t handle,
+                                              uint16_t uid_counter,
+                                              uint8_t** pp_items,
+                                              uint16_t* p_room);
+extern void avrc_bld_folder_items_rsp_done(BT_HDR* p_pkt, uint16_t item_count,
+                                           uint16_t items_len);
 
 #endif /* AVRC_INT_H */
@@ -0,0 +1,297 @@
+/******************************************************************************
+ * Copyright (c) 2026 Qualcomm Innovation Center, Inc. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ *
+ *******************************************************************************/
+
+/******************************************************************************
+ *
+ *  Cache of the folder items given by the player, kept serialized so that a
+ *  Get Folder Items response is built by copying slices of it. Items are
+ *  stored in pages of AVRC_ITEM_CACHE_PAGE_ITEMS items. A page is allocated
+ *  whole when the player gives the first of its items, and the items are
+ *  serialized straight into it, so storing an item does not allocate. Paging
+ *  through a large folder only needs the pages of the items asked for. When
+ *  the pages of a scope reach AVRC_ITEM_CACHE_MAX_BYTES, the least recently
+ *  used one is dropped for the new one, and the player is asked again for its
+ *  items if they are browsed back to.
+ *
+ ******************************************************************************/
+#include <string.h>
+
+#include <map>
+#include <mutex>
+
+#include "avrc_api.h"
+#include "avrc_int.h"
+#include "bt_common.h"
+#include "osi/include/allocator.h"
+
+#if (AVRC_METADATA_INCLUDED == TRUE)
+
+#define AVRC_ITEM_CACHE_NUM_SCOPES (AVRC_SCOPE_NOW_PLAYING + 1)
+
+/* AVRC_ITEM_CACHE_PAGE_ITEMS consecutive items, back to back in data */
+typedef struct {
+  uint16_t offset[AVRC_ITEM_CACHE_PAGE_ITEMS];
+  uint16_t len[AVRC_ITEM_CACHE_PAGE_ITEMS]; /* 0 if the item is not cached */
+  uint16_t used;                            /* bytes of data in use */
+  uint32_t last_use; /* use_count of its scope when last used */
+  uint8_t data[AVRC_ITEM_CACHE_PAGE_SIZE];
+} tAVRC_ITEM_PAGE;
+
+typedef struct {
+  bool valid = false;
+  uint16_t uid_counter = 0;
+  uint32_t attr_key = 0;
+  uint32_t bytes = 0;     /* bytes of all the pages */
+  uint32_t use_count = 0; /* ticks on every use of a page */
+  std::map<uint32_t, tAVRC_ITEM_PAGE*> pages; /* by index of their first item */
+} tAVRC_ITEM_SCOPE;
+
+struct t_avrc_item_cache {
+  std::mutex lock;
+  tAVRC_ITEM_SCOPE scope[AVRC_ITEM_CACHE_NUM_SCOPES];
+};
+
+static void avrc_item_cache_clear(tAVRC_ITEM_SCOPE* p_scope) {
+  for (auto& page : p_scope->pages) osi_free(page.second);
+  p_scope->pages.clear();
+  p_scope->valid = false;
+  p_scope->bytes = 0;
+  p_scope->use_count = 0;
+}
+
+/* Drops the least recently used page of p_scope. */
+static void avrc_item_cache_evict(tAVRC_ITEM_SCOPE* p_scope) {
+  auto lru = p_scope->pages.begin();
+  for (auto it = p_scope->pages.begin(); it != p_scope->pages.end(); it++) {
+    if (it->second->last_use < lru->second->last_use) lru = it;
+  }
+  if (lru == p_scope->pages.end()) return;
+
+  AVRC_TRACE_DEBUG("%s: items %u-%u", __func__, lru->first,
+                   lru->first + AVRC_ITEM_CACHE_PAGE_ITEMS - 1);
+  osi_free(lru->second);
+  p_scope->pages.erase(lru);
+  p_scope->bytes -= sizeof(tAVRC_ITEM_PAGE);
+}
+
+/* Returns the serialized item at index and its length in *p_len, or NULL if
+ * the item is not cached. */
+static const uint8_t* avrc_item_cache_find(tAVRC_ITEM_SCOPE* p_scope,
+                                           uint32_t index, uint16_t* p_len) {
+  uint32_t slot = index % AVRC_ITEM_CACHE_PAGE_ITEMS;
+
+  auto page = p_scope->pages.find(index - slot);
+  if (page == p_scope->pages.end()) return NULL;
+  tAVRC_ITEM_PAGE* p_page = page->second;
+  if (p_page->len[slot] == 0) return NULL;
+
+  p_page->last_use = ++p_scope->use_count;
+  *p_len = p_page->len[slot];
+  return p_page->data + p_page->offset[slot];
+}
+
+/*******************************************************************************
+ *
+ * Function         AVRC_ItemCacheNew
+ *
+ * Description      Allocate an empty cache of folder items.
+ *
+ * Returns          the cache, to be released with AVRC_ItemCacheFree()
+ *
+ ******************************************************************************/
+tAVRC_ITEM_CACHE* AVRC_ItemCacheNew(void) {
+  return new tAVRC_ITEM_CACHE;
+}
+
+/*******************************************************************************
+ *
+ * Function         AVRC_ItemCacheFree
+ *
+ * Description      Release a cache from AVRC_ItemCacheNew().
+ *
+ * Returns          void
+ *
+ ******************************************************************************/
+void AVRC_ItemCacheFree(tAVRC_ITEM_CACHE* p_cache) {
+  if (p_cache == NULL) return;
+
+  for (int xx = 0; xx < AVRC_ITEM_CACHE_NUM_SCOPES; xx++)
+    avrc_item_cache_clear(&p_cache->scope[xx]);
+  delete p_cache;
+}
+
+/*******************************************************************************
+ *
+ * Function         AVRC_ItemCacheInvalidate
+ *
+ * Description      Drop the items cached for scope, or for all scopes.
+ *
+ * Returns          void
+ *
+ ******************************************************************************/
+void AVRC_ItemCacheInvalidate(tAVRC_ITEM_CACHE* p_cache, uint8_t scope) {
+  if (p_cache == NULL) return;
+
+  std::lock_guard<std::mutex> lock(p_cache->lock);
+  for (int xx = 0; xx < AVRC_ITEM_CACHE_NUM_SCOPES; xx++) {
+    if (scope == AVRC_ITEM_CACHE_ALL_SCOPES || scope == xx)
+      avrc_item_cache_clear(&p_cache->scope[xx]);
+  }
+}
+
+/*******************************************************************************
+ *
+ * Function         AVRC_ItemCacheAttrKey
+ *
+ * Description      Compute the key of the requested media attributes, a
+ *                  FNV-1a hash of the attribute count and IDs.
+ *
+ * Returns          the key
+ *
+ ******************************************************************************/
+uint32_t AVRC_ItemCacheAttrKey(uint8_t attr_count,
+                               const uint32_t* p_attr_list) {
+  uint32_t key = 2166136261u;
+
+  key = (key ^ attr_count) * 16777619u;
+  if (attr_count == 0 || attr_count == 0xFF || p_attr_list == NULL)
+    return key;
+
+  for (uint8_t xx = 0; xx < attr_count; xx++) {
+    for (int shift = 0; shift < 32; shift += 8)
+      key = (key ^ ((p_attr_list[xx] >> shift) & 0xFF)) * 16777619u;
+  }
+  return key;
+}
+
+/*******************************************************************************
+ *
+ * Function         AVRC_ItemCacheStore
+ *
+ * Description      Serialize and store the item at index item_index of scope.
+ *
+ * Returns          void
+ *
+ ******************************************************************************/
+void AVRC_ItemCacheStore(tAVRC_ITEM_CACHE* p_cache, uint8_t scope,
+                         uint32_t attr_key, uint16_t uid_counter,
+                         uint32_t item_index, const tAVRC_ITEM* p_item) {
+  uint32_t slot = item_index % AVRC_ITEM_CACHE_PAGE_ITEMS;
+  uint32_t first_item = item_index - slot;
+
+  if (p_cache == NULL || p_item == NULL || scope >= AVRC_ITEM_CACHE_NUM_SCOPES)
+    return;
+
+  std::lock_guard<std::mutex> lock(p_cache->lock);
+  tAVRC_ITEM_SCOPE* p_scope = &p_cache->scope[scope];
+  if (!p_scope->valid || p_scope->uid_counter != uid_counter ||
+      p_scope->attr_key != attr_key) {
+    avrc_item_cache_clear(p_scope);
+    p_scope->valid = true;
+    p_scope->uid_counter = uid_counter;
+    p_scope->attr_key = attr_key;
+  }
+
+  tAVRC_ITEM_PAGE* p_page;
+  auto page = p_scope->pages.find(first_item);
+  if (page != p_scope->pages.end()) {
+    p_page = page->second;
+  } else {
+    while (!p_scope->pages.empty() &&
+           p_scope->bytes + sizeof(tAVRC_ITEM_PAGE) > AVRC_ITEM_CACHE_MAX_BYTES)
+      avrc_item_cache_evict(p_scope);
+    if (sizeof(tAVRC_ITEM_PAGE) > AVRC_ITEM_CACHE_MAX_BYTES) return;
+    p_page = (tAVRC_ITEM_PAGE*)osi_calloc(sizeof(tAVRC_ITEM_PAGE));
+    p_scope->pages[first_item] = p_page;
+    p_scope->bytes += sizeof(tAVRC_ITEM_PAGE);
+  }
+  p_page->last_use = ++p_scope->use_count;
+  if (p_page->len[slot] != 0) return;
+
+  uint16_t room = AVRC_ITEM_CACHE_PAGE_SIZE - p_page->used;
+  if (room > AVRC_MAX_FOLDER_ITEM_LEN) room = AVRC_MAX_FOLDER_ITEM_LEN;
+  uint16_t len =
+      avrc_bld_folder_item(p_item, p_page->data + p_page->used, room);
+  if (len == 0) return;
+
+  p_page->offset[slot] = p_page->used;
+  p_page->len[slot] = len;
+  p_page->used += len;
+}
+
+/*******************************************************************************
+ *
+ * Function         AVRC_ItemCacheBldRsp
+ *
+ * Description      Build the Get Folder Items response for the items
+ *                  start_item to end_item of scope from the cache.
+ *
+ * Returns          true and the response in *pp_pkt if it was built,
+ *                  false if the player must be asked for the items.
+ *
+ ******************************************************************************/
+bool AVRC_ItemCacheBldRsp(tAVRC_ITEM_CACHE* p_cache, uint8_t handle,
+                          uint8_t scope, uint32_t attr_key,
+                          uint32_t start_item, uint32_t end_item,
+                          BT_HDR** pp_pkt) {
+  const uint8_t* p_item;
+  uint8_t* p_items;
+  uint16_t len, room;
+  uint16_t item_count = 0, items_len = 0;
+  bool complete = false;
+
+  if (p_cache == NULL || pp_pkt == NULL ||
+      scope >= AVRC_ITEM_CACHE_NUM_SCOPES || start_item > end_item)
+    return false;
+
+  std::lock_guard<std::mutex> lock(p_cache->lock);
+  tAVRC_ITEM_SCOPE* p_scope = &p_cache->scope[scope];
+  if (!p_scope->valid || p_scope->attr_key != attr_key ||
+      avrc_item_cache_find(p_scope, start_item, &len) == NULL)
+    return false;
+
+  BT_HDR* p_pkt = avrc_bld_folder_items_rsp_init(handle, p_scope->uid_counter,
+                                                 &p_items, &room);
+  if (p_pkt == NULL) return false;
+
+  /* Add items the way avrc_bld_get_folder_items_rsp() does until the
+   * response is full or has all the requested items. The player knows about
+   * the items that are not cached, so they end the response early. */
+  for (uint32_t index = start_item;; index++) {
+    if (room <= AVRC_MIN_LEN_GET_FOLDER_ITEMS_RSP) {
+      complete = (item_count > 0);
+      break;
+    }
+    p_item = avrc_item_cache_find(p_scope, index, &len);
+    if (p_item == NULL) break;
+    if (len > room) {
+      complete = (item_count > 0);
+      break;
+    }
+
+    memcpy(p_items + items_len, p_item, len);
+    items_len += len;
+    room -= len;
+    item_count++;
+    if (index == end_item) {
+      complete = true;
+      break;
+    }
+  }
+
+  if (!complete) {
+    osi_free(p_pkt);
+    return false;
+  }
+
+  AVRC_TRACE_DEBUG("%s: scope:%d items %u-%u, num:%d", __func__, scope,
+                   start_item, start_item + item_count - 1, item_count);
+  avrc_bld_folder_items_rsp_done(p_pkt, item_count, items_len);
+  *pp_pkt = p_pkt;
+  return true;
+}
+
+#endif /* (AVRC_METADATA_INCLUDED == TRUE) */
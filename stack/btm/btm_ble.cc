@@ -116,6 +116,7 @@ bool BTM_SecAddBleDevice(const RawAddress& bd_addr, BD_NAME bd_name,
   p_dev_rec->ble.ble_addr_type = addr_type;
 
   p_dev_rec->ble.pseudo_addr = bd_addr;
+  btm_dev_index_update(p_dev_rec);
   /* sync up with the Inq Data base*/
   tBTM_INQ_INFO* p_info = BTM_InqDbRead(bd_addr);
   if (p_info) {
@@ -1464,6 +1465,7 @@ void btm_sec_save_le_key(const RawAddress& bd_addr, tBTM_LE_KEY_TYPE key_type,
         p_rec->ble.identity_addr = p_keys->pid_key.identity_addr;
         p_rec->ble.identity_addr_type = p_keys->pid_key.identity_addr_type;
         p_rec->ble.key_type |= BTM_LE_KEY_PID;
+        btm_ble_resolve_cache_reset();
         BTM_TRACE_DEBUG(
             "%s: BTM_LE_KEY_PID key_type=0x%x save peer IRK, change bd_addr=%s "
             "to id_addr=%s id_addr_type=0x%x",
@@ -1478,6 +1480,7 @@ void btm_sec_save_le_key(const RawAddress& bd_addr, tBTM_LE_KEY_TYPE key_type,
 #endif
         /* update device record address as identity address */
         p_rec->bd_addr = p_keys->pid_key.identity_addr;
+        btm_dev_index_update(p_rec);
         /* combine DUMO device security record if needed */
         btm_consolidate_dev(p_rec);
         break;
@@ -2085,6 +2088,7 @@ void btm_ble_connected(const RawAddress& bda, uint16_t handle, uint8_t enc_mode,
   p_dev_rec->ble.ble_addr_type = addr_type;
   /* update pseudo address */
   p_dev_rec->ble.pseudo_addr = bda;
+  btm_dev_index_update(p_dev_rec);
 
   p_dev_rec->role_master = false;
   if (role == HCI_ROLE_MASTER) p_dev_rec->role_master = true;
@@ -24,6 +24,7 @@
 
 #include <base/bind.h>
 #include <string.h>
+#include <vector>
 
 #include "bt_types.h"
 #include "btm_int.h"
@@ -31,6 +32,7 @@
 #include "device/include/controller.h"
 #include "gap_api.h"
 #include "hcimsgs.h"
+#include "osi/include/time.h"
 
 #include "btm_ble_int.h"
 #include "stack/crypto_toolbox/crypto_toolbox.h"
@@ -179,6 +181,7 @@ bool btm_ble_init_pseudo_addr(tBTM_SEC_DEV_REC* p_dev_rec,
   if (p_dev_rec == NULL) return false;
   if (p_dev_rec->ble.pseudo_addr.IsEmpty()) {
     p_dev_rec->ble.pseudo_addr = new_pseudo_addr;
+    btm_dev_index_update(p_dev_rec);
     return true;
   }
 
@@ -230,33 +233,137 @@ bool btm_ble_addr_resolvable(const RawAddress& rpa,
   return false;
 }
 
-/** This function match the random address to the appointed device record,
- * starting from calculating IRK. If the record index exceeds the maximum record
- * number, matching failed and send a callback. */
-static bool btm_ble_match_random_bda(void* data, void* context) {
-  RawAddress* random_bda = (RawAddress*)context;
+namespace {
+
+/* Result of resolving a resolvable private address */
+typedef struct tBTM_BLE_RPA_CACHE_ENT {
+  RawAddress rpa;
+  tBTM_SEC_DEV_REC* p_dev_rec; /* NULL if no bonded device owns |rpa| */
+  uint64_t time_ms;            /* When |rpa| was resolved */
+
+  struct tBTM_BLE_RPA_CACHE_ENT* p_hash_next;
+  struct tBTM_BLE_RPA_CACHE_ENT* p_lru_prev; /* Less recently used */
+  struct tBTM_BLE_RPA_CACHE_ENT* p_lru_next; /* More recently used */
+} tBTM_BLE_RPA_CACHE_ENT;
+
+/* IRK of a bonded device with its AES key schedule */
+typedef struct {
+  tBTM_SEC_DEV_REC* p_dev_rec;
+  aes_context ctx;
+} tBTM_BLE_IRK_ENT;
+
+static_assert((BTM_BLE_RPA_CACHE_SIZE & (BTM_BLE_RPA_CACHE_SIZE - 1)) == 0,
+              "BTM_BLE_RPA_CACHE_SIZE must be a power of two");
+
+/* Entries [0, rpa_cache_count) are in use, hashed on the address and linked
+ * from the least to the most recently used */
+tBTM_BLE_RPA_CACHE_ENT rpa_cache[BTM_BLE_RPA_CACHE_SIZE];
+tBTM_BLE_RPA_CACHE_ENT* rpa_cache_buckets[BTM_BLE_RPA_CACHE_SIZE];
+size_t rpa_cache_count = 0;
+tBTM_BLE_RPA_CACHE_ENT* rpa_cache_lru = NULL;
+tBTM_BLE_RPA_CACHE_ENT* rpa_cache_mru = NULL;
+
+/* IRKs of the bonded devices, in the order of the security records */
+std::vector<tBTM_BLE_IRK_ENT> irk_table;
+bool irk_table_valid = false;
+
+bool rpa_resolvable_by_dev(const tBTM_SEC_DEV_REC* p_dev_rec) {
+  return (p_dev_rec->device_type & BT_DEVICE_TYPE_BLE) &&
+         (p_dev_rec->ble.key_type & BTM_LE_KEY_PID);
+}
 
-  tBTM_SEC_DEV_REC* p_dev_rec = static_cast<tBTM_SEC_DEV_REC*>(data);
+/* Expands the key schedules of the IRKs of all bonded devices, unless done
+ * since the cache was last reset */
+void irk_table_update(void) {
+  if (irk_table_valid) return;
 
+  irk_table.clear();
+  list_node_t* end = list_end(btm_cb.sec_dev_rec);
+  for (list_node_t* node = list_begin(btm_cb.sec_dev_rec); node != end;
+       node = list_next(node)) {
+    tBTM_SEC_DEV_REC* p_dev_rec =
+        static_cast<tBTM_SEC_DEV_REC*>(list_node(node));
+    if (!(p_dev_rec->ble.key_type & BTM_LE_KEY_PID)) continue;
 
-  if (!(p_dev_rec->device_type & BT_DEVICE_TYPE_BLE) ||
-      !(p_dev_rec->ble.key_type & BTM_LE_KEY_PID)) {
-    BTM_TRACE_EVENT("%s not a LE paired device ,sec_flags = %02x device_type = %d", __func__,
-                  p_dev_rec->sec_flags, p_dev_rec->device_type);
-    return true;
+    tBTM_BLE_IRK_ENT ent;
+    ent.p_dev_rec = p_dev_rec;
+    crypto_toolbox::aes_128_set_key(p_dev_rec->ble.keys.irk, &ent.ctx);
+    irk_table.push_back(ent);
   }
+  irk_table_valid = true;
 
-  if (rpa_matches_irk(*random_bda, p_dev_rec->ble.keys.irk)) {
-    BTM_TRACE_EVENT("%s match is found ,sec_flags = %02x device_type = %d", __func__,
-                  p_dev_rec->sec_flags, p_dev_rec->device_type);
-    // if it was match, finish iteration, otherwise continue
-    return false;
+  BTM_TRACE_DEBUG("%s: %zu IRKs", __func__, irk_table.size());
+}
+
+/* Returns the first bonded device whose IRK resolves |rpa|, or NULL. The
+ * hash ah(IRK, prand) of every IRK is computed with its expanded key
+ * schedule, from a single plaintext block. */
+tBTM_SEC_DEV_REC* irk_table_resolve(const RawAddress& rpa) {
+  irk_table_update();
+
+  /* prand padded to 128 bits, MSB first */
+  uint8_t plaintext[N_BLOCK] = {0};
+  plaintext[N_BLOCK - 3] = rpa.address[0];
+  plaintext[N_BLOCK - 2] = rpa.address[1];
+  plaintext[N_BLOCK - 1] = rpa.address[2];
+
+  uint8_t ciphertext[N_BLOCK];
+  for (const tBTM_BLE_IRK_ENT& ent : irk_table) {
+    if (!rpa_resolvable_by_dev(ent.p_dev_rec)) continue;
+
+    aes_encrypt(plaintext, ciphertext, &ent.ctx);
+    if (memcmp(&ciphertext[N_BLOCK - 3], &rpa.address[3], 3) == 0)
+      return ent.p_dev_rec;
   }
+  return NULL;
+}
+
+tBTM_BLE_RPA_CACHE_ENT** rpa_cache_bucket(const RawAddress& rpa) {
+  const uint8_t* a = rpa.address;
+  uint32_t h = ((uint32_t)a[0] << 24 | a[1] << 16 | a[2] << 8 | a[3]) ^
+               (a[4] << 8 | a[5]);
+  h *= 0x9E3779B1;
+  return &rpa_cache_buckets[(h >> 16) & (BTM_BLE_RPA_CACHE_SIZE - 1)];
+}
 
-  // not a match, continue iteration
-  BTM_TRACE_DEBUG("%s next iteration ,sec_flags = %02x device_type = %d", __func__,
-                  p_dev_rec->sec_flags, p_dev_rec->device_type);
-  return true;
+void rpa_cache_hash_remove(tBTM_BLE_RPA_CACHE_ENT* p_ent) {
+  tBTM_BLE_RPA_CACHE_ENT** pp = rpa_cache_bucket(p_ent->rpa);
+  while (*pp != p_ent) pp = &(*pp)->p_hash_next;
+  *pp = p_ent->p_hash_next;
+}
+
+void rpa_cache_lru_remove(tBTM_BLE_RPA_CACHE_ENT* p_ent) {
+  if (p_ent->p_lru_prev)
+    p_ent->p_lru_prev->p_lru_next = p_ent->p_lru_next;
+  else
+    rpa_cache_lru = p_ent->p_lru_next;
+  if (p_ent->p_lru_next)
+    p_ent->p_lru_next->p_lru_prev = p_ent->p_lru_prev;
+  else
+    rpa_cache_mru = p_ent->p_lru_prev;
+}
+
+void rpa_cache_lru_append(tBTM_BLE_RPA_CACHE_ENT* p_ent) {
+  p_ent->p_lru_prev = rpa_cache_mru;
+  p_ent->p_lru_next = NULL;
+  if (rpa_cache_mru)
+    rpa_cache_mru->p_lru_next = p_ent;
+  else
+    rpa_cache_lru = p_ent;
+  rpa_cache_mru = p_ent;
+}
+
+}  // namespace
+
+/** This function drops every cached address resolution. It must be called
+ * when an IRK is added or removed, or a security record is deleted. */
+void btm_ble_resolve_cache_reset(void) {
+  memset(rpa_cache_buckets, 0, sizeof(rpa_cache_buckets));
+  rpa_cache_count = 0;
+  rpa_cache_lru = NULL;
+  rpa_cache_mru = NULL;
+  irk_table.clear();
+  irk_table_valid = false;
 }
 
 /** This function is called to resolve a random address.
@@ -264,19 +371,42 @@ static bool btm_ble_match_random_bda(void* data, void* context) {
  * matched to.
  */
 tBTM_SEC_DEV_REC* btm_ble_resolve_random_addr(const RawAddress& random_bda) {
-  BTM_TRACE_EVENT("%s", __func__);
+  uint64_t now_ms = time_get_os_boottime_ms();
+  tBTM_BLE_RPA_CACHE_ENT** p_bucket = rpa_cache_bucket(random_bda);
+  tBTM_BLE_RPA_CACHE_ENT* p_ent = *p_bucket;
+  while (p_ent != NULL && p_ent->rpa != random_bda) p_ent = p_ent->p_hash_next;
+
+  if (p_ent != NULL) {
+    rpa_cache_lru_remove(p_ent);
+
+    if (now_ms - p_ent->time_ms < BTM_BLE_RPA_CACHE_LIFETIME_MS &&
+        (p_ent->p_dev_rec == NULL || rpa_resolvable_by_dev(p_ent->p_dev_rec))) {
+      rpa_cache_lru_append(p_ent);
+      return p_ent->p_dev_rec;
+    }
+    /* Expired, or the device can't resolve addresses anymore */
+  } else {
+    if (rpa_cache_count < BTM_BLE_RPA_CACHE_SIZE) {
+      p_ent = &rpa_cache[rpa_cache_count++];
+    } else {
+      p_ent = rpa_cache_lru;
+      rpa_cache_hash_remove(p_ent);
+      rpa_cache_lru_remove(p_ent);
+    }
+    p_ent->rpa = random_bda;
+    p_ent->p_hash_next = *p_bucket;
+    *p_bucket = p_ent;
+  }
 
-  /* start to resolve random address */
-  /* check for next security record */
+  BTM_TRACE_EVENT("%s", __func__);
 
-  list_node_t* n = list_foreach(btm_cb.sec_dev_rec, btm_ble_match_random_bda,
-                                (void*)&random_bda);
-  tBTM_SEC_DEV_REC* p_dev_rec = nullptr;
-  if (n != nullptr) p_dev_rec = static_cast<tBTM_SEC_DEV_REC*>(list_node(n));
+  p_ent->p_dev_rec = irk_table_resolve(random_bda);
+  p_ent->time_ms = now_ms;
+  rpa_cache_lru_append(p_ent);
 
   BTM_TRACE_EVENT("%s:  %sresolved", __func__,
-                  (p_dev_rec == nullptr ? "not " : ""));
-  return p_dev_rec;
+                  (p_ent->p_dev_rec == nullptr ? "not " : ""));
+  return p_ent->p_dev_rec;
 }
 
 /*******************************************************************************
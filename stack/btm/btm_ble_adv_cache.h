@@ -0,0 +1,109 @@
+/******************************************************************************
+ * Copyright (c) 2026 Qualcomm Innovation Center, Inc. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ *
+ *******************************************************************************/
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "raw_address.h"
+
+/* Largest advertising data of an extended advertisement, including all the
+ * chained packets */
+#define BTM_BLE_ADV_CACHE_DATA_MAX 1650
+
+/* we keep maximum 8 devices in the cache */
+#define BTM_BLE_ADV_CACHE_SIZE 8
+
+/* Devices in this cache are waiting for either scan response, or chained
+ * packets on secondary channel. The data of each device is kept in storage
+ * owned by the cache, so that storing a report never allocates memory. When
+ * the cache is full, the device added first is dropped. */
+class AdvertisingCache {
+ public:
+  /* Set the data to |data| of length |len| for device |addr_type, addr|.
+   * Returns the cached data of the device and its length in |p_len|. */
+  const uint8_t* Set(uint8_t addr_type, const RawAddress& addr,
+                     const uint8_t* data, size_t len, size_t* p_len) {
+    Item* item = Find(addr_type, addr);
+    if (item == NULL) item = Add(addr_type, addr);
+
+    item->len = 0;
+    return Store(item, data, len, p_len);
+  }
+
+  /* Append |data| of length |len| for device |addr_type, addr|. Data past
+   * BTM_BLE_ADV_CACHE_DATA_MAX octets is dropped. Returns the cached data of
+   * the device and its length in |p_len|. */
+  const uint8_t* Append(uint8_t addr_type, const RawAddress& addr,
+                        const uint8_t* data, size_t len, size_t* p_len) {
+    Item* item = Find(addr_type, addr);
+    if (item == NULL) {
+      item = Add(addr_type, addr);
+      item->len = 0;
+    }
+
+    return Store(item, data, len, p_len);
+  }
+
+  /* Clear data for device |addr_type, addr| */
+  void Clear(uint8_t addr_type, const RawAddress& addr) {
+    Item* item = Find(addr_type, addr);
+    if (item != NULL) item->in_use = false;
+  }
+
+ private:
+  struct Item {
+    bool in_use;
+    uint8_t addr_type;
+    RawAddress addr;
+    uint64_t sequence;  // Order in which the devices were added
+    size_t len;
+    uint8_t data[BTM_BLE_ADV_CACHE_DATA_MAX];
+  };
+
+  Item* Find(uint8_t addr_type, const RawAddress& addr) {
+    for (Item& item : items) {
+      if (item.in_use && item.addr_type == addr_type && item.addr == addr)
+        return &item;
+    }
+    return NULL;
+  }
+
+  /* Returns a free item for |addr_type, addr|, dropping the device added
+   * first if the cache is full */
+  Item* Add(uint8_t addr_type, const RawAddress& addr) {
+    Item* oldest = &items[0];
+    for (Item& item : items) {
+      if (!item.in_use) {
+        oldest = &item;
+        break;
+      }
+      if (item.sequence < oldest->sequence) oldest = &item;
+    }
+
+    oldest->in_use = true;
+    oldest->addr_type = addr_type;
+    oldest->addr = addr;
+    oldest->sequence = next_sequence++;
+    return oldest;
+  }
+
+  const uint8_t* Store(Item* item, const uint8_t* data, size_t len,
+                       size_t* p_len) {
+    if (len > BTM_BLE_ADV_CACHE_DATA_MAX - item->len)
+      len = BTM_BLE_ADV_CACHE_DATA_MAX - item->len;
+    if (len != 0) memcpy(item->data + item->len, data, len);
+    item->len += len;
+
+    *p_len = item->len;
+    return item->data;
+  }
+
+  Item items[BTM_BLE_ADV_CACHE_SIZE] = {};
+  uint64_t next_sequence = 0;
+};
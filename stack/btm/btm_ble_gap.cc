@@ -57,6 +57,7 @@
 #include "../../boringssl/src/crypto/fipsmodule/cipher/internal.h"
 
 #include "advertise_data_parser.h"
+#include "btm_ble_adv_cache.h"
 #include "btm_ble_int.h"
 #include "gatt_int.h"
 #include "gattdefs.h"
@@ -84,76 +85,6 @@
 
 namespace {
 
-class AdvertisingCache {
- public:
-  /* Set the data to |data| for device |addr_type, addr| */
-  const std::vector<uint8_t>& Set(uint8_t addr_type, const RawAddress& addr,
-                                  std::vector<uint8_t> data) {
-    auto it = Find(addr_type, addr);
-    if (it != items.end()) {
-      it->data = std::move(data);
-      return it->data;
-    }
-
-    if (items.size() > cache_max) {
-      items.pop_back();
-    }
-
-    items.emplace_front(addr_type, addr, std::move(data));
-    return items.front().data;
-  }
-
-  /* Append |data| for device |addr_type, addr| */
-  const std::vector<uint8_t>& Append(uint8_t addr_type, const RawAddress& addr,
-                                     std::vector<uint8_t> data) {
-    auto it = Find(addr_type, addr);
-    if (it != items.end()) {
-      it->data.insert(it->data.end(), data.begin(), data.end());
-      return it->data;
-    }
-
-    if (items.size() > cache_max) {
-      items.pop_back();
-    }
-
-    items.emplace_front(addr_type, addr, std::move(data));
-    return items.front().data;
-  }
-
-  /* Clear data for device |addr_type, addr| */
-  void Clear(uint8_t addr_type, const RawAddress& addr) {
-    auto it = Find(addr_type, addr);
-    if (it != items.end()) {
-      items.erase(it);
-    }
-  }
-
- private:
-  struct Item {
-    uint8_t addr_type;
-    RawAddress addr;
-    std::vector<uint8_t> data;
-
-    Item(uint8_t addr_type, const RawAddress& addr, std::vector<uint8_t> data)
-        : addr_type(addr_type), addr(addr), data(data) {}
-  };
-
-  std::list<Item>::iterator Find(uint8_t addr_type, const RawAddress& addr) {
-    for (auto it = items.begin(); it != items.end(); it++) {
-      if (it->addr_type == addr_type && it->addr == addr) {
-        return it;
-      }
-    }
-    return items.end();
-  }
-
-  /* we keep maximum 7 devices in the cache */
-  const size_t cache_max = 7;
-  std::list<Item> items;
-};
-
-/* Devices in this cache are waiting for eiter scan response, or chained packets
- * on secondary channel */
 AdvertisingCache cache;
 AdvertisingCache periodicCache;
 
@@ -1473,7 +1404,6 @@ void btm_ble_periodic_adv_report(uint8_t *param, uint16_t param_len) {
   uint8_t tx_power, rssi, cte_type, data_status, data_len;
   uint16_t sync_handle;
   std::vector<uint8_t> data;
-  std::vector<uint8_t> tmp;
   uint8_t periodic_data[255] = {0};
   uint8_t *p = param;
   STREAM_TO_UINT16(sync_handle, p);
@@ -1487,12 +1417,6 @@ void btm_ble_periodic_adv_report(uint8_t *param, uint16_t param_len) {
                "cte_type = %d, data_status = %d, data_len = %d", __func__,
                 sync_handle, tx_power, rssi, cte_type, data_status, data_len);
 
-  for(int i = 0;i < data_len; i++) {
-    data.push_back(periodic_data[i]);
-  }
-  if (data_len != 0) tmp.insert(tmp.begin(), data.begin(), data.end());
-
-
   int index = btm_ble_get_psync_index_from_handle(sync_handle);
   if (index == MAX_SYNC_TRANSACTION) {
     BTM_TRACE_ERROR("[PSync]%s: index not found", __func__);
@@ -1500,7 +1424,10 @@ void btm_ble_periodic_adv_report(uint8_t *param, uint16_t param_len) {
   }
   tBTM_BLE_PERIODIC_SYNC *ps = &btm_ble_pa_sync_cb.p_sync[index];
 
-  data = periodicCache.Append(ps->address_type, ps->remote_bda, std::move(tmp));
+  size_t cached_len;
+  const uint8_t* cached_data = periodicCache.Append(
+      ps->address_type, ps->remote_bda, periodic_data, data_len, &cached_len);
+  data.assign(cached_data, cached_data + cached_len);
   bool data_complete;
   if (data_status == 0x01) {
     LOG(INFO) << __func__ << " Data not complete yet, waiting for more " << ps->remote_bda;
@@ -2727,7 +2654,7 @@ static void btm_ble_update_adv_flag(uint8_t flag) {
  * condition
  */
 uint8_t btm_ble_is_discoverable(const RawAddress& bda,
-                                std::vector<uint8_t> const& adv_data) {
+                                AdvertiseDataFields const& adv_data) {
   uint8_t flag = 0, rt = 0;
   uint8_t data_len;
   tBTM_INQ_PARMS* p_cond = &btm_cb.btm_inq_vars.inqparms;
@@ -2744,8 +2671,8 @@ uint8_t btm_ble_is_discoverable(const RawAddress& bda,
   }
 
   if (!adv_data.empty()) {
-    const uint8_t* p_flag = AdvertiseDataParser::GetFieldByType(
-        adv_data, BTM_BLE_AD_TYPE_FLAG, &data_len);
+    const uint8_t* p_flag =
+        adv_data.GetFieldByType(BTM_BLE_AD_TYPE_FLAG, &data_len);
     if (p_flag != NULL && data_len != 0) {
       flag = *p_flag;
 
@@ -2943,7 +2870,7 @@ void btm_ble_update_inq_result(tINQ_DB_ENT* p_i, uint8_t addr_type,
                                uint8_t primary_phy, uint8_t secondary_phy,
                                uint8_t advertising_sid, int8_t tx_power,
                                int8_t rssi, uint16_t periodic_adv_int,
-                               std::vector<uint8_t> const& data) {
+                               AdvertiseDataFields const& data) {
   tBTM_INQ_RESULTS* p_cur = &p_i->inq_info.results;
   uint8_t len;
   tBTM_INQUIRY_VAR_ST* p_inq = &btm_cb.btm_inq_vars;
@@ -2977,8 +2904,7 @@ void btm_ble_update_inq_result(tINQ_DB_ENT* p_i, uint8_t addr_type,
   p_i->inq_count = p_inq->inq_counter; /* Mark entry for current inquiry */
 
   if (!data.empty()) {
-    const uint8_t* p_flag =
-        AdvertiseDataParser::GetFieldByType(data, BTM_BLE_AD_TYPE_FLAG, &len);
+    const uint8_t* p_flag = data.GetFieldByType(BTM_BLE_AD_TYPE_FLAG, &len);
     if (p_flag != NULL && len != 0) p_cur->flag = *p_flag;
   }
 
@@ -2992,14 +2918,13 @@ void btm_ble_update_inq_result(tINQ_DB_ENT* p_i, uint8_t addr_type,
      * Otherwise fall back to trying to infer if it is a HID device based on the
      * service class.
      */
-    const uint8_t* p_uuid16 = AdvertiseDataParser::GetFieldByType(
-        data, BTM_BLE_AD_TYPE_APPEARANCE, &len);
+    const uint8_t* p_uuid16 =
+        data.GetFieldByType(BTM_BLE_AD_TYPE_APPEARANCE, &len);
     if (p_uuid16 && len == 2) {
       btm_ble_appearance_to_cod((uint16_t)p_uuid16[0] | (p_uuid16[1] << 8),
                                 p_cur->dev_class);
     } else {
-      p_uuid16 = AdvertiseDataParser::GetFieldByType(
-          data, BTM_BLE_AD_TYPE_16SRV_CMPL, &len);
+      p_uuid16 = data.GetFieldByType(BTM_BLE_AD_TYPE_16SRV_CMPL, &len);
       if (p_uuid16 != NULL) {
         uint8_t i;
         for (i = 0; i + 2 <= len; i = i + 2) {
@@ -3073,13 +2998,13 @@ void btm_clear_all_pending_le_entry(void) {
   uint16_t xx;
   tINQ_DB_ENT* p_ent = btm_cb.btm_inq_vars.inq_db;
 
-  for (xx = 0; xx < BTM_INQ_DB_SIZE; xx++, p_ent++) {
+  for (xx = 0; xx < btm_cb.btm_inq_vars.inq_db_size; xx++, p_ent++) {
     /* mark all pending LE entry as unused if an LE only device has scan
      * response outstanding */
     if ((p_ent->in_use) &&
         (p_ent->inq_info.results.device_type == BT_DEVICE_TYPE_BLE) &&
         !p_ent->scan_rsp)
-      p_ent->in_use = false;
+      btm_inq_db_remove(p_ent);
   }
 }
 
@@ -3295,9 +3220,6 @@ static void btm_ble_process_adv_pkt_cont(
   tBTM_INQUIRY_VAR_ST* p_inq = &btm_cb.btm_inq_vars;
   bool update = true;
   VLOG(1) << __func__ << "bda:" << bda;
-  std::vector<uint8_t> tmp;
-  std::vector<uint8_t> adv_data_decrypted;
-  if (data_len != 0) tmp.insert(tmp.begin(), data, data + data_len);
 
   bool is_scannable = ble_evt_type_is_scannable(evt_type);
   bool is_scan_resp = ble_evt_type_is_scan_resp(evt_type);
@@ -3305,25 +3227,29 @@ static void btm_ble_process_adv_pkt_cont(
   bool is_start =
       ble_evt_type_is_legacy(evt_type) && is_scannable && !is_scan_resp;
 
+  size_t pkt_data_len = data_len;
   if (ble_evt_type_is_legacy(evt_type))
-    AdvertiseDataParser::RemoveTrailingZeros(tmp);
+    pkt_data_len = AdvertiseDataParser::TrimTrailingZeros(data, data_len);
 
   // We might have send scan request to this device before, but didn't get the
   // response. In such case make sure data is put at start, not appended to
   // already existing data.
-  std::vector<uint8_t> adv_data =
-        is_start ? cache.Set(addr_type, bda, std::move(tmp))
-                 : cache.Append(addr_type, bda, std::move(tmp));
+  size_t adv_data_len;
+  const uint8_t* adv_data =
+      is_start
+          ? cache.Set(addr_type, bda, data, pkt_data_len, &adv_data_len)
+          : cache.Append(addr_type, bda, data, pkt_data_len, &adv_data_len);
   bool data_complete;
   if (ble_evt_type_data_status(evt_type) == 0x01) {
-    LOG(INFO) << __func__ <<  " Data not complete yet, waiting for more " << bda;
+    VLOG(1) << __func__ << " Data not complete yet, waiting for more " << bda;
     data_complete = false;
   } else if (ble_evt_type_data_status(evt_type) == 0x10) {
-    LOG(INFO) << __func__ << " Data not complete yet, No More Data Coming " << bda;
+    VLOG(1) << __func__ << " Data not complete yet, No More Data Coming "
+            << bda;
     data_complete = false;
     cache.Clear(addr_type, bda);
   } else {
-    LOG(INFO) << __func__ << " Data Complete " << bda;
+    VLOG(1) << __func__ << " Data Complete " << bda;
     data_complete = true;
   }
   if (!data_complete) {
@@ -3344,58 +3270,65 @@ static void btm_ble_process_adv_pkt_cont(
   int len_enc_data;
   int enc_data_begin_index = 0;
   std::map<int, int> enc_adv_data_map;
-  std::map<int, std::vector<uint8_t>> decrypted_data_map;
+  std::vector<uint8_t> decrypted_data;
   VLOG(1) << __func__ << "encrypted_data:" << encrypted_data;
-  if(AdvertiseDataParser::GetFieldByType(adv_data, BTM_BLE_AD_TYPE_ED, &len1)){
-    if(!AdvertiseDataParser::IsValid(adv_data)){
+
+  // Parse the report once, every field lookup below goes through the index.
+  AdvertiseDataFields adv_fields;
+  AdvertiseDataParser::Index(adv_data, adv_data_len, &adv_fields);
+
+  if (adv_fields.GetFieldByType(BTM_BLE_AD_TYPE_ED, &len1)) {
+    if (!adv_fields.IsValid()) {
         VLOG(1) << __func__ << "Dropping bad advertisement packet: "
-                << base::HexEncode(adv_data.data(), adv_data.size());
+                << base::HexEncode(adv_data, adv_data_len);
       return;
     }
     encrypted_data = true;
     if (btm_cb.enc_adv_data_log_enabled) {
       VLOG(1) << __func__ << "FOUND ENCRYPTED DATA: "
-              << base::HexEncode(adv_data.data(), adv_data.size());
+              << base::HexEncode(adv_data, adv_data_len);
     }
 
     enc_adv_data_map =
-        AdvertiseDataParser::GetEncAdvFieldsInfo(adv_data.data(), adv_data.size());
+        AdvertiseDataParser::GetEncAdvFieldsInfo(adv_data, adv_data_len);
   }
   if (btm_cb.enc_adv_data_enabled) {
     if (encrypted_data) {
       if (btm_cb.enc_adv_data_log_enabled) {
         LOG(INFO) << " Adv data before decryption: "
-                  << base::HexEncode(adv_data.data(), adv_data.size());
+                  << base::HexEncode(adv_data, adv_data_len);
       }
 
-      std::vector<uint8_t> decrypted_data =
-          btm_ble_process_encrypted_adv(bda, adv_data, &is_decrypt_success, enc_adv_data_map);
+      decrypted_data = btm_ble_process_encrypted_adv(
+          bda, std::vector<uint8_t>(adv_data, adv_data + adv_data_len),
+          &is_decrypt_success, enc_adv_data_map);
       if (!is_decrypt_success) {
         VLOG(1) << __func__ << " Decryption NOT successful, return:";
       }
 
       if (!decrypted_data.empty()) {
         LOG(INFO) << " decrypted_data is not empty: ";
-        adv_data.clear();
-        adv_data.insert(adv_data.begin(), decrypted_data.begin(), decrypted_data.end());
+        adv_data = decrypted_data.data();
+        adv_data_len = decrypted_data.size();
+        AdvertiseDataParser::Index(adv_data, adv_data_len, &adv_fields);
       }
     }
   }
 
   if (btm_cb.enc_adv_data_log_enabled) {
     LOG(INFO) << " Adv data after decryption: "
-              << base::HexEncode(adv_data.data(), adv_data.size());
+              << base::HexEncode(adv_data, adv_data_len);
   }
 
-  if (!AdvertiseDataParser::IsValid(adv_data)) {
+  if (!adv_fields.IsValid()) {
     VLOG(1) << __func__ << "Dropping bad advertisement packet: "
-            << base::HexEncode(adv_data.data(), adv_data.size());
+            << base::HexEncode(adv_data, adv_data_len);
     return;
   }
 
   bool include_rsi = false;
   uint8_t len;
-  if (AdvertiseDataParser::GetFieldByType(adv_data, BTM_BLE_AD_TYPE_RSI, &len)) {
+  if (adv_fields.GetFieldByType(BTM_BLE_AD_TYPE_RSI, &len)) {
     include_rsi = true;
   }
 
@@ -3443,12 +3376,12 @@ static void btm_ble_process_adv_pkt_cont(
     p_inq->inq_cmpl_info.num_resp++;
   }
 
-  p_i->time_of_resp = time_get_os_boottime_ms();
+  btm_inq_db_touch(p_i);
 
   /* update the LE device information in inquiry database */
   btm_ble_update_inq_result(p_i, addr_type, bda, evt_type, primary_phy,
                             secondary_phy, advertising_sid, tx_power, rssi,
-                            periodic_adv_int, adv_data);
+                            periodic_adv_int, adv_fields);
   if (include_rsi) {
     (&p_i->inq_info.results)->include_rsi = true;
   }
@@ -3456,8 +3389,7 @@ static void btm_ble_process_adv_pkt_cont(
   if (btm_cb.is_csip_opportunistic_scan_enabled && btm_cb.p_csip_scan_cb) {
       uint8_t data_len = 0;
       const uint8_t* g_data = NULL;
-      g_data = AdvertiseDataParser::GetFieldByType(adv_data, BTM_CSIP_RSI_TYPE,
-                                                   &data_len);
+      g_data = adv_fields.GetFieldByType(BTM_CSIP_RSI_TYPE, &data_len);
       if (g_data && data_len == BTM_CSIP_RSI_LEN) {
          uint8_t gid_data[BTM_CSIP_RSI_LEN] = {};
          memcpy(gid_data, g_data, BTM_CSIP_RSI_LEN);
@@ -3465,7 +3397,7 @@ static void btm_ble_process_adv_pkt_cont(
       }
   }
 
-  uint8_t result = btm_ble_is_discoverable(bda, adv_data);
+  uint8_t result = btm_ble_is_discoverable(bda, adv_fields);
   if (result == 0) {
     cache.Clear(addr_type, bda);
     LOG_WARN(LOG_TAG,
@@ -3502,7 +3434,7 @@ static void btm_ble_process_adv_pkt_cont(
   tBTM_INQ_RESULTS_CB* p_inq_results_cb = p_inq->p_inq_results_cb;
   if (p_inq_results_cb && (result & BTM_BLE_INQ_RESULT)) {
     (p_inq_results_cb)((tBTM_INQ_RESULTS*)&p_i->inq_info.results,
-                       const_cast<uint8_t*>(adv_data.data()), adv_data.size());
+                       const_cast<uint8_t*>(adv_data), adv_data_len);
   }
 
   // Pass address up to GattService#onScanResult
@@ -3511,7 +3443,7 @@ static void btm_ble_process_adv_pkt_cont(
   tBTM_INQ_RESULTS_CB* p_obs_results_cb = btm_cb.ble_ctr_cb.p_obs_results_cb;
   if (p_obs_results_cb && (result & BTM_BLE_OBS_RESULT)) {
     (p_obs_results_cb)((tBTM_INQ_RESULTS*)&p_i->inq_info.results,
-                       const_cast<uint8_t*>(adv_data.data()), adv_data.size());
+                       const_cast<uint8_t*>(adv_data), adv_data_len);
   }
 
   cache.Clear(addr_type, bda);
@@ -67,6 +67,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <unordered_map>
 
 #include "bt_common.h"
 #include "bt_types.h"
@@ -117,6 +118,7 @@ bool BTM_SecAddDevice(const RawAddress& bd_addr, DEV_CLASS dev_class,
     p_dev_rec->bd_addr = bd_addr;
 
     p_dev_rec->hci_handle = BTM_GetHCIConnHandle(bd_addr, BT_TRANSPORT_BR_EDR);
+    btm_dev_index_update(p_dev_rec);
 
     /* use default value for background connection params */
     /* update conn params, use default value for background connection params */
@@ -345,6 +347,7 @@ tBTM_SEC_DEV_REC* btm_sec_alloc_dev(const RawAddress& bd_addr) {
 
   p_dev_rec->ble_hci_handle = BTM_GetHCIConnHandle(bd_addr, BT_TRANSPORT_LE);
   p_dev_rec->hci_handle = BTM_GetHCIConnHandle(bd_addr, BT_TRANSPORT_BR_EDR);
+  btm_dev_index_update(p_dev_rec);
 
   return (p_dev_rec);
 }
@@ -365,6 +368,7 @@ void btm_sec_free_dev(tBTM_SEC_DEV_REC* p_dev_rec) {
 
   /* Clear out any saved BLE keys */
   btm_sec_clear_ble_keys(p_dev_rec);
+  btm_dev_index_remove(p_dev_rec);
   list_remove(btm_cb.sec_dev_rec, p_dev_rec);
 }
 
@@ -416,6 +420,158 @@ bool btm_dev_support_switch(const RawAddress& bd_addr) {
   return (false);
 }
 
+/* Secondary indices over btm_cb.sec_dev_rec. Every record is indexed by its
+ * BD address, its pseudo/identity address and both of its connection handles
+ * so that the lookups below do not have to walk the whole list. The list stays
+ * the owner of the records and defines the lookup order whenever several
+ * records match the same key.
+ */
+namespace {
+
+struct RawAddressHash {
+  size_t operator()(const RawAddress& bd_addr) const {
+    uint64_t key = 0;
+    memcpy(&key, bd_addr.address, sizeof(bd_addr.address));
+    return std::hash<uint64_t>()(key);
+  }
+};
+
+/* Keys a record is currently indexed under */
+typedef struct {
+  RawAddress bd_addr;
+  RawAddress pseudo_addr;
+  uint16_t hci_handle;
+  uint16_t ble_hci_handle;
+} tBTM_DEV_INDEX_KEYS;
+
+typedef std::unordered_multimap<RawAddress, tBTM_SEC_DEV_REC*, RawAddressHash>
+    tBTM_DEV_ADDR_INDEX;
+typedef std::unordered_multimap<uint16_t, tBTM_SEC_DEV_REC*>
+    tBTM_DEV_HANDLE_INDEX;
+
+tBTM_DEV_ADDR_INDEX dev_addr_index;
+tBTM_DEV_HANDLE_INDEX dev_handle_index;
+std::unordered_map<tBTM_SEC_DEV_REC*, tBTM_DEV_INDEX_KEYS> dev_index_keys;
+
+template <typename Index, typename Key>
+void index_erase(Index& index, const Key& key, tBTM_SEC_DEV_REC* p_dev_rec) {
+  auto range = index.equal_range(key);
+  for (auto it = range.first; it != range.second; ++it) {
+    if (it->second == p_dev_rec) {
+      index.erase(it);
+      return;
+    }
+  }
+}
+
+/* Returns the only record indexed under |key|, or NULL if there is none.
+ * |*ambiguous| is set when several records share the key. */
+template <typename Index, typename Key>
+tBTM_SEC_DEV_REC* index_find_unique(const Index& index, const Key& key,
+                                    bool* ambiguous) {
+  auto it = index.find(key);
+  *ambiguous = false;
+  if (it == index.end()) return NULL;
+
+  auto next = std::next(it);
+  if (next != index.end() && next->first == key) {
+    *ambiguous = true;
+    return NULL;
+  }
+  return it->second;
+}
+
+void index_insert_keys(tBTM_SEC_DEV_REC* p_dev_rec,
+                       const tBTM_DEV_INDEX_KEYS& keys) {
+  if (!keys.bd_addr.IsEmpty()) dev_addr_index.emplace(keys.bd_addr, p_dev_rec);
+  if (!keys.pseudo_addr.IsEmpty() && keys.pseudo_addr != keys.bd_addr)
+    dev_addr_index.emplace(keys.pseudo_addr, p_dev_rec);
+
+  dev_handle_index.emplace(keys.hci_handle, p_dev_rec);
+  if (keys.ble_hci_handle != keys.hci_handle)
+    dev_handle_index.emplace(keys.ble_hci_handle, p_dev_rec);
+}
+
+void index_erase_keys(tBTM_SEC_DEV_REC* p_dev_rec,
+                      const tBTM_DEV_INDEX_KEYS& keys) {
+  if (!keys.bd_addr.IsEmpty())
+    index_erase(dev_addr_index, keys.bd_addr, p_dev_rec);
+  if (!keys.pseudo_addr.IsEmpty() && keys.pseudo_addr != keys.bd_addr)
+    index_erase(dev_addr_index, keys.pseudo_addr, p_dev_rec);
+
+  index_erase(dev_handle_index, keys.hci_handle, p_dev_rec);
+  if (keys.ble_hci_handle != keys.hci_handle)
+    index_erase(dev_handle_index, keys.ble_hci_handle, p_dev_rec);
+}
+
+}  // namespace
+
+/*******************************************************************************
+ *
+ * Function         btm_dev_index_update
+ *
+ * Description      Re-index a device record after its BD address, pseudo
+ *                  address or one of its connection handles changed. Must be
+ *                  called whenever one of these fields is written.
+ *
+ ******************************************************************************/
+void btm_dev_index_update(tBTM_SEC_DEV_REC* p_dev_rec) {
+  tBTM_DEV_INDEX_KEYS keys = {p_dev_rec->bd_addr, p_dev_rec->ble.pseudo_addr,
+                              p_dev_rec->hci_handle,
+                              p_dev_rec->ble_hci_handle};
+
+  auto it = dev_index_keys.find(p_dev_rec);
+  if (it != dev_index_keys.end()) {
+    tBTM_DEV_INDEX_KEYS& old_keys = it->second;
+    if (old_keys.bd_addr == keys.bd_addr &&
+        old_keys.pseudo_addr == keys.pseudo_addr &&
+        old_keys.hci_handle == keys.hci_handle &&
+        old_keys.ble_hci_handle == keys.ble_hci_handle)
+      return;
+
+    index_erase_keys(p_dev_rec, old_keys);
+    old_keys = keys;
+  } else {
+    dev_index_keys.emplace(p_dev_rec, keys);
+  }
+
+  index_insert_keys(p_dev_rec, keys);
+}
+
+/*******************************************************************************
+ *
+ * Function         btm_dev_index_remove
+ *
+ * Description      Drop a device record from the lookup indices and the
+ *                  random address resolution cache. Must be called before
+ *                  the record is removed from the list.
+ *
+ ******************************************************************************/
+void btm_dev_index_remove(tBTM_SEC_DEV_REC* p_dev_rec) {
+  btm_ble_resolve_cache_reset();
+
+  auto it = dev_index_keys.find(p_dev_rec);
+  if (it == dev_index_keys.end()) return;
+
+  index_erase_keys(p_dev_rec, it->second);
+  dev_index_keys.erase(it);
+}
+
+/*******************************************************************************
+ *
+ * Function         btm_dev_index_clear
+ *
+ * Description      Drop every device record from the lookup indices and the
+ *                  random address resolution cache.
+ *
+ ******************************************************************************/
+void btm_dev_index_clear(void) {
+  btm_ble_resolve_cache_reset();
+  dev_addr_index.clear();
+  dev_handle_index.clear();
+  dev_index_keys.clear();
+}
+
 bool is_handle_equal(void* data, void* context) {
   tBTM_SEC_DEV_REC* p_dev_rec = static_cast<tBTM_SEC_DEV_REC*>(data);
   uint16_t* handle = static_cast<uint16_t*>(context);
@@ -439,6 +595,16 @@ bool is_handle_equal(void* data, void* context) {
 tBTM_SEC_DEV_REC* btm_find_dev_by_handle(uint16_t handle) {
   if (btm_cb.sec_dev_rec == NULL) return NULL;
 
+  bool ambiguous;
+  tBTM_SEC_DEV_REC* p_dev_rec =
+      index_find_unique(dev_handle_index, handle, &ambiguous);
+  if (p_dev_rec &&
+      (p_dev_rec->hci_handle == handle || p_dev_rec->ble_hci_handle == handle))
+    return p_dev_rec;
+  if (!p_dev_rec && !ambiguous) return NULL;
+
+  /* Several records share the handle (e.g. unconnected records left at the
+   * same value) or the index is stale: the first one in the list wins */
   list_node_t* n = list_foreach(btm_cb.sec_dev_rec, is_handle_equal, &handle);
   if (n) return static_cast<tBTM_SEC_DEV_REC*>(list_node(n));
 
@@ -472,7 +638,19 @@ bool is_address_equal(void* data, void* context) {
  ******************************************************************************/
 tBTM_SEC_DEV_REC* btm_find_dev(const RawAddress& bd_addr) {
   if (btm_cb.sec_dev_rec == NULL) return NULL;
-
+  if (bd_addr == RawAddress::kEmpty) return NULL;
+
+  bool ambiguous;
+  tBTM_SEC_DEV_REC* p_dev_rec =
+      index_find_unique(dev_addr_index, bd_addr, &ambiguous);
+  if (p_dev_rec && (p_dev_rec->bd_addr == bd_addr ||
+                    p_dev_rec->ble.pseudo_addr == bd_addr))
+    return p_dev_rec;
+  if (!p_dev_rec && !ambiguous && !BTM_BLE_IS_RESOLVE_BDA(bd_addr))
+    return NULL;
+
+  /* An unknown resolvable private address has to be matched against the
+   * IRK of every record; duplicates and stale entries keep list order */
   list_node_t* n =
       list_foreach(btm_cb.sec_dev_rec, is_address_equal, (void*)&bd_addr);
   if (n) return static_cast<tBTM_SEC_DEV_REC*>(list_node(n));
@@ -520,6 +698,7 @@ void btm_consolidate_dev(tBTM_SEC_DEV_REC* p_target_rec) {
       p_target_rec->bond_type = temp_rec.bond_type;
 
       /* remove the combined record */
+      btm_dev_index_remove(p_dev_rec);
       list_remove(btm_cb.sec_dev_rec, p_dev_rec);
       //p_dev_rec gets freed in list_remove, we should not  access it further
       continue;
@@ -532,10 +711,14 @@ void btm_consolidate_dev(tBTM_SEC_DEV_REC* p_target_rec) {
         p_target_rec->device_type |= p_dev_rec->device_type;
 
         /* remove the combined record */
+        btm_dev_index_remove(p_dev_rec);
         list_remove(btm_cb.sec_dev_rec, p_dev_rec);
       }
     }
   }
+
+  /* the target may have taken over the handles of a combined record */
+  btm_dev_index_update(p_target_rec);
 }
 
 /*******************************************************************************
@@ -623,6 +806,7 @@ tBTM_SEC_DEV_REC* btm_sec_allocate_dev_rec(void) {
 
   if (list_length(btm_cb.sec_dev_rec) > BTM_SEC_MAX_DEVICE_RECORDS) {
     p_dev_rec = btm_find_oldest_dev_rec();
+    btm_dev_index_remove(p_dev_rec);
     list_remove(btm_cb.sec_dev_rec, p_dev_rec);
   }
 
@@ -637,6 +821,7 @@ tBTM_SEC_DEV_REC* btm_sec_allocate_dev_rec(void) {
   p_dev_rec->rmt_io_caps = BTM_IO_CAP_UNKNOWN;
   p_dev_rec->security_required = BTM_SEC_NONE;
   p_dev_rec->is_le_enc_in_progress = false;
+  btm_dev_index_update(p_dev_rec);
 
   return p_dev_rec;
 }
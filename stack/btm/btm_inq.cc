@@ -25,14 +25,18 @@
  *
  ******************************************************************************/
 
+#include <base/logging.h>
 #include <log/log.h>
 #include <stddef.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <algorithm>
+#include <vector>
 
 #include "device/include/controller.h"
 #include "osi/include/osi.h"
+#include "osi/include/properties.h"
 #include "osi/include/time.h"
 
 #include "advertise_data_parser.h"
@@ -49,6 +53,9 @@ using bluetooth::Uuid;
 /* 3 second timeout waiting for responses */
 #define BTM_INQ_REPLY_TIMEOUT_MS (3 * 1000)
 
+/* Overrides the number of inquiry database entries (BTM_INQ_DB_SIZE) */
+#define BTM_INQ_DB_SIZE_PROPERTY "persist.vendor.btstack.inq_db_size"
+
 /* TRUE to enable DEBUG traces for btm_inq */
 #ifndef BTM_INQ_DEBUG
 #define BTM_INQ_DEBUG FALSE
@@ -1064,7 +1071,7 @@ tBTM_INQ_INFO* BTM_InqDbFirst(void) {
   uint16_t xx;
   tINQ_DB_ENT* p_ent = btm_cb.btm_inq_vars.inq_db;
 
-  for (xx = 0; xx < BTM_INQ_DB_SIZE; xx++, p_ent++) {
+  for (xx = 0; xx < btm_cb.btm_inq_vars.inq_db_size; xx++, p_ent++) {
     if (p_ent->in_use) return (&p_ent->inq_info);
   }
 
@@ -1091,8 +1098,8 @@ tBTM_INQ_INFO* BTM_InqDbNext(tBTM_INQ_INFO* p_cur) {
     p_ent = (tINQ_DB_ENT*)((uint8_t*)p_cur - offsetof(tINQ_DB_ENT, inq_info));
     inx = (uint16_t)((p_ent - btm_cb.btm_inq_vars.inq_db) + 1);
 
-    for (p_ent = &btm_cb.btm_inq_vars.inq_db[inx]; inx < BTM_INQ_DB_SIZE;
-         inx++, p_ent++) {
+    for (p_ent = &btm_cb.btm_inq_vars.inq_db[inx];
+         inx < btm_cb.btm_inq_vars.inq_db_size; inx++, p_ent++) {
       if (p_ent->in_use) return (&p_ent->inq_info);
     }
 
@@ -1246,14 +1253,62 @@ void btm_inq_db_reset(void) {
  *
  ******************************************************************************/
 void btm_inq_db_init(void) {
-  alarm_free(btm_cb.btm_inq_vars.remote_name_timer);
-  btm_cb.btm_inq_vars.remote_name_timer =
-      alarm_new("btm_inq.remote_name_timer");
-  btm_cb.btm_inq_vars.no_inc_ssp = BTM_NO_SSP_ON_INQUIRY;
+  tBTM_INQUIRY_VAR_ST* p_inq = &btm_cb.btm_inq_vars;
+
+  alarm_free(p_inq->remote_name_timer);
+  p_inq->remote_name_timer = alarm_new("btm_inq.remote_name_timer");
+  p_inq->no_inc_ssp = BTM_NO_SSP_ON_INQUIRY;
+
+  int32_t size =
+      osi_property_get_int32(BTM_INQ_DB_SIZE_PROPERTY, BTM_INQ_DB_SIZE);
+  if (size < 1 || size > BTM_INQ_DB_MAX_SIZE) {
+    BTM_TRACE_WARNING("%s: invalid inquiry database size %d, using %d",
+                      __func__, size, BTM_INQ_DB_SIZE);
+    size = BTM_INQ_DB_SIZE;
+  }
+  btm_inq_db_set_size(size);
+}
+
+/*******************************************************************************
+ *
+ * Function         btm_inq_db_set_size
+ *
+ * Description      This function resizes the inquiry database to hold |size|
+ *                  entries. All entries are cleared.
+ *
+ * Returns          void
+ *
+ ******************************************************************************/
+void btm_inq_db_set_size(uint16_t size) {
+  tBTM_INQUIRY_VAR_ST* p_inq = &btm_cb.btm_inq_vars;
+
+  CHECK(size > 0 && size <= BTM_INQ_DB_MAX_SIZE);
+
+  /* Use at least two buckets per entry to keep the hash chains short */
+  uint16_t buckets = 1;
+  while (buckets < 2 * size) buckets <<= 1;
+
+  osi_free(p_inq->inq_db);
+  osi_free(p_inq->inq_db_hash);
+  p_inq->inq_db = (tINQ_DB_ENT*)osi_calloc(size * sizeof(tINQ_DB_ENT));
+  p_inq->inq_db_size = size;
+  p_inq->inq_db_hash =
+      (tINQ_DB_ENT**)osi_calloc(buckets * sizeof(tINQ_DB_ENT*));
+  p_inq->inq_db_hash_mask = buckets - 1;
+  btm_clr_inq_db(NULL);
 }
 
 void btm_inq_db_free(void) {
-  alarm_free(btm_cb.btm_inq_vars.remote_name_timer);
+  tBTM_INQUIRY_VAR_ST* p_inq = &btm_cb.btm_inq_vars;
+
+  alarm_free(p_inq->remote_name_timer);
+  osi_free_and_reset((void**)&p_inq->inq_db);
+  osi_free_and_reset((void**)&p_inq->inq_db_hash);
+  p_inq->inq_db_size = 0;
+  p_inq->inq_db_num_in_use = 0;
+  p_inq->inq_db_num_keep = 0;
+  p_inq->p_inq_db_lru_head = NULL;
+  p_inq->p_inq_db_lru_tail = NULL;
 }
 
 /*******************************************************************************
@@ -1326,13 +1381,20 @@ void btm_clr_inq_db(const RawAddress* p_bda) {
   BTM_TRACE_DEBUG("btm_clr_inq_db: inq_active:0x%x state:%d",
                   btm_cb.btm_inq_vars.inq_active, btm_cb.btm_inq_vars.state);
 #endif
-  for (xx = 0; xx < BTM_INQ_DB_SIZE; xx++, p_ent++) {
-    if (p_ent->in_use) {
-      /* If this is the specified BD_ADDR or clearing all devices */
-      if (p_bda == NULL || (p_ent->inq_info.results.remote_bd_addr == *p_bda)) {
-        p_ent->in_use = false;
-      }
-    }
+  if (p_bda != NULL) {
+    /* Clear the specified BD_ADDR */
+    while ((p_ent = btm_inq_db_find(*p_bda)) != NULL) btm_inq_db_remove(p_ent);
+  } else {
+    /* Clear all devices */
+    for (xx = 0; xx < p_inq->inq_db_size; xx++, p_ent++) p_ent->in_use = false;
+    if (p_inq->inq_db_hash)
+      memset(p_inq->inq_db_hash, 0,
+             (p_inq->inq_db_hash_mask + 1) * sizeof(tINQ_DB_ENT*));
+    p_inq->inq_db_num_in_use = 0;
+    p_inq->inq_db_num_keep = 0;
+    p_inq->inq_db_free_hint = 0;
+    p_inq->p_inq_db_lru_head = NULL;
+    p_inq->p_inq_db_lru_tail = NULL;
   }
 #if (BTM_INQ_DEBUG == TRUE)
   BTM_TRACE_DEBUG("inq_active:0x%x state:%d", btm_cb.btm_inq_vars.inq_active,
@@ -1394,6 +1456,130 @@ bool btm_inq_find_bdaddr(const RawAddress& p_bda, tBT_DEVICE_TYPE p_dev_type) {
   return (false);
 }
 
+/* Returns the hash bucket of BD address |bda| in the inquiry database. */
+static uint16_t btm_inq_db_bucket(const RawAddress& bda) {
+  const uint8_t* a = bda.address;
+  uint32_t h = ((uint32_t)a[0] << 24 | a[1] << 16 | a[2] << 8 | a[3]) ^
+               (a[4] << 8 | a[5]);
+  /* Multiplicative hashing spreads the address bits over the bucket index */
+  h *= 0x9E3779B1;
+  return (uint16_t)(h >> 16) & btm_cb.btm_inq_vars.inq_db_hash_mask;
+}
+
+/* Marks |p_ent| in use and adds it to the hash index and to the head of the
+ * LRU list, as a new entry has no response time yet. */
+static void btm_inq_db_link(tINQ_DB_ENT* p_ent) {
+  tBTM_INQUIRY_VAR_ST* p_inq = &btm_cb.btm_inq_vars;
+  uint16_t bucket = btm_inq_db_bucket(p_ent->inq_info.results.remote_bd_addr);
+
+  p_ent->in_use = true;
+  p_ent->p_hash_next = p_inq->inq_db_hash[bucket];
+  p_inq->inq_db_hash[bucket] = p_ent;
+
+  p_ent->p_lru_prev = NULL;
+  p_ent->p_lru_next = p_inq->p_inq_db_lru_head;
+  if (p_inq->p_inq_db_lru_head)
+    p_inq->p_inq_db_lru_head->p_lru_prev = p_ent;
+  else
+    p_inq->p_inq_db_lru_tail = p_ent;
+  p_inq->p_inq_db_lru_head = p_ent;
+
+  p_inq->inq_db_num_in_use++;
+  if (p_ent->keep) p_inq->inq_db_num_keep++;
+}
+
+static void btm_inq_db_lru_unlink(tINQ_DB_ENT* p_ent) {
+  tBTM_INQUIRY_VAR_ST* p_inq = &btm_cb.btm_inq_vars;
+
+  if (p_ent->p_lru_prev)
+    p_ent->p_lru_prev->p_lru_next = p_ent->p_lru_next;
+  else
+    p_inq->p_inq_db_lru_head = p_ent->p_lru_next;
+
+  if (p_ent->p_lru_next)
+    p_ent->p_lru_next->p_lru_prev = p_ent->p_lru_prev;
+  else
+    p_inq->p_inq_db_lru_tail = p_ent->p_lru_prev;
+}
+
+/*******************************************************************************
+ *
+ * Function         btm_inq_db_remove
+ *
+ * Description      This function removes an in-use entry from the inquiry
+ *                  database.
+ *
+ * Returns          void
+ *
+ ******************************************************************************/
+void btm_inq_db_remove(tINQ_DB_ENT* p_ent) {
+  tBTM_INQUIRY_VAR_ST* p_inq = &btm_cb.btm_inq_vars;
+  uint16_t bucket = btm_inq_db_bucket(p_ent->inq_info.results.remote_bd_addr);
+  tINQ_DB_ENT** pp_ent = &p_inq->inq_db_hash[bucket];
+
+  while (*pp_ent != p_ent) pp_ent = &(*pp_ent)->p_hash_next;
+  *pp_ent = p_ent->p_hash_next;
+  btm_inq_db_lru_unlink(p_ent);
+
+  p_ent->in_use = false;
+  p_inq->inq_db_num_in_use--;
+  if (p_ent->keep) p_inq->inq_db_num_keep--;
+
+  uint16_t index = (uint16_t)(p_ent - p_inq->inq_db);
+  if (index < p_inq->inq_db_free_hint) p_inq->inq_db_free_hint = index;
+}
+
+/*******************************************************************************
+ *
+ * Function         btm_inq_db_touch
+ *
+ * Description      This function records a response from the device of an
+ *                  in-use entry, making it the most recently used one.
+ *
+ * Returns          void
+ *
+ ******************************************************************************/
+void btm_inq_db_touch(tINQ_DB_ENT* p_ent) {
+  tBTM_INQUIRY_VAR_ST* p_inq = &btm_cb.btm_inq_vars;
+
+  p_ent->time_of_resp = time_get_os_boottime_ms();
+  if (p_ent == p_inq->p_inq_db_lru_tail) return;
+
+  btm_inq_db_lru_unlink(p_ent);
+  p_ent->p_lru_next = NULL;
+  p_ent->p_lru_prev = p_inq->p_inq_db_lru_tail;
+  p_inq->p_inq_db_lru_tail->p_lru_next = p_ent;
+  p_inq->p_inq_db_lru_tail = p_ent;
+}
+
+/* Rebuilds the hash index and LRU list after entries were moved around in
+ * the inquiry database. The LRU list is ordered by response time, older
+ * entries first and lower indices first among equal times. */
+static void btm_inq_db_rebuild(void) {
+  tBTM_INQUIRY_VAR_ST* p_inq = &btm_cb.btm_inq_vars;
+  std::vector<tINQ_DB_ENT*> entries;
+  uint16_t xx;
+
+  for (xx = 0; xx < p_inq->inq_db_size; xx++) {
+    if (p_inq->inq_db[xx].in_use) entries.push_back(&p_inq->inq_db[xx]);
+  }
+
+  btm_clr_inq_db(NULL);
+
+  /* Entries are linked at the head, so link the newest one first */
+  std::sort(entries.begin(), entries.end(),
+            [](const tINQ_DB_ENT* a, const tINQ_DB_ENT* b) {
+              if (a->time_of_resp != b->time_of_resp)
+                return a->time_of_resp > b->time_of_resp;
+              return a > b;
+            });
+  for (tINQ_DB_ENT* p_ent : entries) btm_inq_db_link(p_ent);
+
+  while (p_inq->inq_db_free_hint < p_inq->inq_db_size &&
+         p_inq->inq_db[p_inq->inq_db_free_hint].in_use)
+    p_inq->inq_db_free_hint++;
+}
+
 /*******************************************************************************
  *
  * Function         btm_inq_db_find
@@ -1405,12 +1591,13 @@ bool btm_inq_find_bdaddr(const RawAddress& p_bda, tBT_DEVICE_TYPE p_dev_type) {
  *
  ******************************************************************************/
 tINQ_DB_ENT* btm_inq_db_find(const RawAddress& p_bda) {
-  uint16_t xx;
-  tINQ_DB_ENT* p_ent = btm_cb.btm_inq_vars.inq_db;
+  tINQ_DB_ENT* p_ent;
+
+  if (btm_cb.btm_inq_vars.inq_db_hash == NULL) return (NULL);
 
-  for (xx = 0; xx < BTM_INQ_DB_SIZE; xx++, p_ent++) {
-    if (p_ent->in_use && p_ent->inq_info.results.remote_bd_addr == p_bda)
-      return (p_ent);
+  for (p_ent = btm_cb.btm_inq_vars.inq_db_hash[btm_inq_db_bucket(p_bda)];
+       p_ent != NULL; p_ent = p_ent->p_hash_next) {
+    if (p_ent->inq_info.results.remote_bd_addr == p_bda) return (p_ent);
   }
 
   /* If here, not found */
@@ -1422,60 +1609,39 @@ tINQ_DB_ENT* btm_inq_db_find(const RawAddress& p_bda) {
  * Function         btm_inq_db_new
  *
  * Description      This function looks through the inquiry database for an
- *                  unused entry. If no entry is free, it allocates the oldest
- *                  entry.
+ *                  unused entry. If no entry is free, it allocates the entry
+ *                  with the oldest response which is not kept.
  *
  * Returns          pointer to entry
  *
  ******************************************************************************/
 tINQ_DB_ENT* btm_inq_db_new(const RawAddress& p_bda, bool keep) {
-  uint16_t xx;
-  tINQ_DB_ENT* p_ent = btm_cb.btm_inq_vars.inq_db;
-  tINQ_DB_ENT* p_old = btm_cb.btm_inq_vars.inq_db;
-  uint32_t ot = 0xFFFFFFFF;
-  uint8_t keep_counter = 0;
-
-  for (xx = 0; xx < BTM_INQ_DB_SIZE; xx++, p_ent++) {
-    if (!p_ent->in_use) {
-      memset(p_ent, 0, sizeof(tINQ_DB_ENT));
-      p_ent->inq_info.results.remote_bd_addr = p_bda;
-      p_ent->in_use = true;
-      /* The keep flag is set as true only for the first 4 HID devices */
-      if (keep_counter < BTM_INQ_DB_HID_KEEP_MAX)
-        p_ent->keep = keep;
-      else
-        p_ent->keep = false;
-
-      return (p_ent);
-    }
-
-    if (p_ent->keep) {
-      keep_counter++;
-    }
+  tBTM_INQUIRY_VAR_ST* p_inq = &btm_cb.btm_inq_vars;
+  tINQ_DB_ENT* p_ent;
 
-    if (p_ent->time_of_resp < ot) {
-      if (p_ent->keep) {
-        LOG(INFO) << __func__ << ": keep "
-                  << p_ent->inq_info.results.remote_bd_addr;
-      } else {
-        p_old = p_ent;
-        ot = p_ent->time_of_resp;
-      }
+  if (p_inq->inq_db_num_in_use < p_inq->inq_db_size) {
+    /* Use the first unused entry */
+    p_ent = &p_inq->inq_db[p_inq->inq_db_free_hint];
+    while (p_ent->in_use) p_ent++;
+    p_inq->inq_db_free_hint = (uint16_t)(p_ent - p_inq->inq_db) + 1;
+  } else {
+    /* If here, no free entry found. Reuse the oldest. */
+    for (p_ent = p_inq->p_inq_db_lru_head; p_ent && p_ent->keep;
+         p_ent = p_ent->p_lru_next) {
+      LOG(INFO) << __func__ << ": keep "
+                << p_ent->inq_info.results.remote_bd_addr;
     }
+    if (p_ent == NULL) p_ent = p_inq->p_inq_db_lru_head;
+    btm_inq_db_remove(p_ent);
   }
 
-  /* If here, no free entry found. Return the oldest. */
-
-  memset(p_old, 0, sizeof(tINQ_DB_ENT));
-  p_old->inq_info.results.remote_bd_addr = p_bda;
-  p_old->in_use = true;
+  memset(p_ent, 0, sizeof(tINQ_DB_ENT));
+  p_ent->inq_info.results.remote_bd_addr = p_bda;
   /* The keep flag is set as true only for the first 4 HID devices */
-  if (keep_counter < BTM_INQ_DB_HID_KEEP_MAX)
-    p_old->keep = keep;
-  else
-    p_old->keep = false;
+  p_ent->keep = keep && p_inq->inq_db_num_keep < BTM_INQ_DB_HID_KEEP_MAX;
+  btm_inq_db_link(p_ent);
 
-  return (p_old);
+  return (p_ent);
 }
 
 /*******************************************************************************
@@ -1692,9 +1858,10 @@ static void btm_initiate_inquiry(tBTM_INQUIRY_VAR_ST* p_inq) {
 
   /* Make sure the number of responses doesn't overflow the database
    * configuration */
-  p_inqparms->max_resps = (uint8_t)((p_inqparms->max_resps <= BTM_INQ_DB_SIZE)
-                                        ? p_inqparms->max_resps
-                                        : BTM_INQ_DB_SIZE);
+  p_inqparms->max_resps =
+      (uint8_t)((p_inqparms->max_resps <= btm_cb.btm_inq_vars.inq_db_size)
+                    ? p_inqparms->max_resps
+                    : btm_cb.btm_inq_vars.inq_db_size);
 
   lap = (p_inq->inq_active & BTM_LIMITED_INQUIRY_ACTIVE) ? &limited_inq_lap
                                                          : &general_inq_lap;
@@ -1903,7 +2070,7 @@ void btm_process_inq_results(uint8_t* p, uint8_t hci_evt_len,
       BTM_TRACE_WARNING ("btm_process_inq_results: Dev class: %02x-%02x-%02x",
                   p_cur->dev_class[0], p_cur->dev_class[1], p_cur->dev_class[2]);
 
-      p_i->time_of_resp = time_get_os_boottime_ms();
+      btm_inq_db_touch(p_i);
 
       if (p_i->inq_count != p_inq->inq_counter)
         p_inq->inq_cmpl_info.num_resp++; /* A new response was found */
@@ -1972,9 +2139,11 @@ void btm_sort_inq_result(void) {
   int size;
   tINQ_DB_ENT* p_tmp = (tINQ_DB_ENT*)osi_malloc(sizeof(tINQ_DB_ENT));
 
-  num_resp = (btm_cb.btm_inq_vars.inq_cmpl_info.num_resp < BTM_INQ_DB_SIZE)
-                 ? btm_cb.btm_inq_vars.inq_cmpl_info.num_resp
-                 : BTM_INQ_DB_SIZE;
+  num_resp =
+      (btm_cb.btm_inq_vars.inq_cmpl_info.num_resp <
+       btm_cb.btm_inq_vars.inq_db_size)
+          ? btm_cb.btm_inq_vars.inq_cmpl_info.num_resp
+          : btm_cb.btm_inq_vars.inq_db_size;
 
   size = sizeof(tINQ_DB_ENT);
   for (xx = 0; xx < num_resp - 1; xx++, p_ent++) {
@@ -1988,6 +2157,9 @@ void btm_sort_inq_result(void) {
   }
 
   osi_free(p_tmp);
+
+  /* The swaps above moved the hash and LRU links along with the entries */
+  btm_inq_db_rebuild();
 }
 
 /*******************************************************************************
@@ -65,6 +65,7 @@ extern void btm_inq_remote_name_timer_timeout(void* data);
 /* Inquiry related functions */
 extern void btm_clr_inq_db(const RawAddress* p_bda);
 extern void btm_inq_db_init(void);
+extern void btm_inq_db_set_size(uint16_t size);
 extern void btm_inq_db_free(void);
 extern void btm_process_inq_results(uint8_t* p, uint8_t hci_evt_len,
                                     uint8_t inq_res_mode);
@@ -74,6 +75,8 @@ extern void btm_event_filter_complete(uint8_t* p);
 extern void btm_inq_stop_on_ssp(void);
 extern void btm_inq_clear_ssp(void);
 extern tINQ_DB_ENT* btm_inq_db_find(const RawAddress& p_bda);
+extern void btm_inq_db_touch(tINQ_DB_ENT* p_ent);
+extern void btm_inq_db_remove(tINQ_DB_ENT* p_ent);
 extern bool btm_inq_find_bdaddr(const RawAddress& p_bda, tBT_DEVICE_TYPE p_dev_type);
 
 /* Internal functions provided by btm_acl.cc
@@ -223,6 +226,9 @@ extern void btm_sec_free_dev(tBTM_SEC_DEV_REC* p_dev_rec);
 extern tBTM_SEC_DEV_REC* btm_find_dev(const RawAddress& bd_addr);
 extern tBTM_SEC_DEV_REC* btm_find_or_alloc_dev(const RawAddress& bd_addr);
 extern tBTM_SEC_DEV_REC* btm_find_dev_by_handle(uint16_t handle);
+extern void btm_dev_index_update(tBTM_SEC_DEV_REC* p_dev_rec);
+extern void btm_dev_index_remove(tBTM_SEC_DEV_REC* p_dev_rec);
+extern void btm_dev_index_clear(void);
 extern tBTM_BOND_TYPE btm_get_bond_type_dev(const RawAddress& bd_addr);
 extern bool btm_set_bond_type_dev(const RawAddress& bd_addr,
                                   tBTM_BOND_TYPE bond_type);
@@ -245,7 +245,7 @@ typedef struct {
   tBT_DEVICE_TYPE device_type;
 } tINQ_BDADDR;
 
-typedef struct {
+typedef struct tINQ_DB_ENT {
   uint32_t time_of_resp;
   uint32_t
       inq_count; /* "timestamps" the entry with a particular inquiry count   */
@@ -257,6 +257,11 @@ typedef struct {
   bool in_use;
   bool scan_rsp;
   bool keep; /* keep the devices in the inquriy database to get the name */
+
+  /* Links of an in-use entry, owned by btm_inq.cc */
+  struct tINQ_DB_ENT* p_hash_next; /* next entry in the same hash bucket */
+  struct tINQ_DB_ENT* p_lru_prev;  /* entry which responded before this one */
+  struct tINQ_DB_ENT* p_lru_next;  /* entry which responded after this one */
 } tINQ_DB_ENT;
 
 enum { INQ_NONE, INQ_LE_OBSERVE, INQ_GENERAL };
@@ -300,7 +305,15 @@ typedef struct {
   tINQ_BDADDR* p_bd_db;    /* Pointer to memory that holds bdaddrs */
   uint16_t num_bd_entries; /* Number of entries in database */
   uint16_t max_bd_entries; /* Maximum number of entries that can be stored */
-  tINQ_DB_ENT inq_db[BTM_INQ_DB_SIZE];
+  tINQ_DB_ENT* inq_db;         /* inq_db_size entries */
+  uint16_t inq_db_size;        /* Capacity of the inquiry database */
+  uint16_t inq_db_num_in_use;  /* Number of entries in use */
+  uint16_t inq_db_num_keep;    /* Number of in-use entries with keep set */
+  uint16_t inq_db_free_hint;   /* No unused entry below this index */
+  tINQ_DB_ENT** inq_db_hash;   /* Buckets of entries hashed by BD address */
+  uint16_t inq_db_hash_mask;   /* Number of buckets minus one */
+  tINQ_DB_ENT* p_inq_db_lru_head; /* Entry with the oldest response */
+  tINQ_DB_ENT* p_inq_db_lru_tail; /* Entry with the latest response */
   tBTM_INQ_PARMS inqparms; /* Contains the parameters for the current inquiry */
   tBTM_INQUIRY_CMPL
       inq_cmpl_info; /* Status and number of responses from the last inquiry */
@@ -101,6 +101,7 @@ void btm_free(void) {
 
   btm_inq_db_free();
 
+  btm_dev_index_clear();
   list_free(btm_cb.sec_dev_rec);
   btm_cb.sec_dev_rec = NULL;
 
@@ -2139,6 +2139,7 @@ tBTM_STATUS btm_sec_l2cap_access_req(const RawAddress& bd_addr, uint16_t psm,
   p_dev_rec = btm_find_or_alloc_dev(bd_addr);
 
   p_dev_rec->hci_handle = handle;
+  btm_dev_index_update(p_dev_rec);
 
   /* Find the service record for the PSM */
   p_serv_rec = btm_sec_find_first_serv(conn_type, psm);
@@ -4714,6 +4715,7 @@ void btm_sec_connected(const RawAddress& bda, uint16_t handle, uint8_t status,
   }
 
   p_dev_rec->hci_handle = handle;
+  btm_dev_index_update(p_dev_rec);
 
   /* role may not be correct here, it will be updated by l2cap, but we need to
    */
@@ -4897,6 +4899,7 @@ void btm_sec_disconnected(uint16_t handle, uint8_t reason) {
     if (p_dev_rec->bond_type == BOND_TYPE_TEMPORARY)
       p_dev_rec->sec_flags &= ~(BTM_SEC_LINK_KEY_KNOWN);
   }
+  btm_dev_index_update(p_dev_rec);
 
   BTM_TRACE_EVENT("%s after update sec_flags=0x%x", __func__,
                   p_dev_rec->sec_flags);
@@ -6370,6 +6373,7 @@ void btm_sec_clear_ble_keys(tBTM_SEC_DEV_REC* p_dev_rec) {
   BTM_TRACE_DEBUG("%s() Clearing BLE Keys", __func__);
   p_dev_rec->ble.key_type = BTM_LE_KEY_NONE;
   memset(&p_dev_rec->ble.keys, 0, sizeof(tBTM_SEC_BLE_KEYS));
+  btm_ble_resolve_cache_reset();
 
 #if (BLE_PRIVACY_SPT == TRUE)
   btm_ble_resolving_list_remove_dev(p_dev_rec);
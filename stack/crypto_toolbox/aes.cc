@@ -65,6 +65,12 @@
 
 #include "aes.h"
 
+/* define to use the x86 AES instructions when the CPU supports them */
+#if defined(__x86_64__) || defined(__i386__)
+#define USE_AESNI
+#include <wmmintrin.h>
+#endif
+
 #if defined(HAVE_UINT_32T)
 typedef uint32_t uint_32t;
 #endif
@@ -235,6 +241,34 @@ static const uint_8t gfmul_e[256] = mm_data(fe);
 #define gfm_d(x) gfmul_d[(x)]
 #define gfm_e(x) gfmul_e[(x)]
 
+#if defined(HAVE_UINT_32T)
+
+/* tables combining the byte substitution and mix columns steps on a column */
+/* held in a 32-bit word, row 0 in the low byte. The entries of te1, te2    */
+/* and te3 are those of te0 rotated left by 8, 16 and 24 bits               */
+
+#define USE_COLUMN_TABLES
+
+#define te0_w(x)                                                    \
+  ((uint_32t)f2(x) | ((uint_32t)(x) << 8) | ((uint_32t)(x) << 16) | \
+   ((uint_32t)f3(x) << 24))
+#define te1_w(x)                                                      \
+  ((uint_32t)f3(x) | ((uint_32t)f2(x) << 8) | ((uint_32t)(x) << 16) | \
+   ((uint_32t)(x) << 24))
+#define te2_w(x)                                                      \
+  ((uint_32t)(x) | ((uint_32t)f3(x) << 8) | ((uint_32t)f2(x) << 16) | \
+   ((uint_32t)(x) << 24))
+#define te3_w(x)                                                    \
+  ((uint_32t)(x) | ((uint_32t)(x) << 8) | ((uint_32t)f3(x) << 16) | \
+   ((uint_32t)f2(x) << 24))
+
+static const uint_32t te0[256] = sb_data(te0_w);
+static const uint_32t te1[256] = sb_data(te1_w);
+static const uint_32t te2[256] = sb_data(te2_w);
+static const uint_32t te3[256] = sb_data(te3_w);
+
+#endif
+
 #else
 
 /* this is the high bit of x right shifted by 1 */
@@ -593,30 +627,169 @@ return_type aes_set_key(const unsigned char key[], length_type keylen,
 
 #if defined(AES_ENC_PREKEYED)
 
-/*  Encrypt a single block of 16 bytes */
+/*  Encrypt a single block of 16 bytes using 8-bit operations */
 
-return_type aes_encrypt(const unsigned char in[N_BLOCK],
-                        unsigned char out[N_BLOCK], const aes_context ctx[1]) {
-  if (ctx->rnd) {
-    uint_8t s1[N_BLOCK], r;
-    copy_and_key(s1, in, ctx->ksch);
+static void encrypt_block_bytes(const unsigned char in[N_BLOCK],
+                                unsigned char out[N_BLOCK],
+                                const aes_context ctx[1]) {
+  uint_8t s1[N_BLOCK], r;
+  copy_and_key(s1, in, ctx->ksch);
 
-    for (r = 1; r < ctx->rnd; ++r)
+  for (r = 1; r < ctx->rnd; ++r)
 #if defined(VERSION_1)
-    {
-      mix_sub_columns(s1);
-      add_round_key(s1, ctx->ksch + r * N_BLOCK);
-    }
+  {
+    mix_sub_columns(s1);
+    add_round_key(s1, ctx->ksch + r * N_BLOCK);
+  }
 #else
-    {
-      uint_8t s2[N_BLOCK];
-      mix_sub_columns(s2, s1);
-      copy_and_key(s1, s2, ctx->ksch + r * N_BLOCK);
-    }
+  {
+    uint_8t s2[N_BLOCK];
+    mix_sub_columns(s2, s1);
+    copy_and_key(s1, s2, ctx->ksch + r * N_BLOCK);
+  }
 #endif
-    shift_sub_rows(s1);
-    copy_and_key(out, s1, ctx->ksch + r * N_BLOCK);
-  } else
+  shift_sub_rows(s1);
+  copy_and_key(out, s1, ctx->ksch + r * N_BLOCK);
+}
+
+#if defined(USE_COLUMN_TABLES)
+
+#define word_in(p)                                                         \
+  ((uint_32t)(p)[0] | ((uint_32t)(p)[1] << 8) | ((uint_32t)(p)[2] << 16) | \
+   ((uint_32t)(p)[3] << 24))
+#define word_out(p, w)             \
+  do {                             \
+    (p)[0] = (uint_8t)(w);         \
+    (p)[1] = (uint_8t)((w) >> 8);  \
+    (p)[2] = (uint_8t)((w) >> 16); \
+    (p)[3] = (uint_8t)((w) >> 24); \
+  } while (0)
+#define bval(w, n) ((uint_8t)((w) >> (8 * (n))))
+
+/* a round on the columns c0..c3, with the row shifts done by the byte picks */
+#define fwd_rnd(c0, c1, c2, c3, k)                          \
+  (te0[bval(c0, 0)] ^ te1[bval(c1, 1)] ^ te2[bval(c2, 2)] ^ \
+   te3[bval(c3, 3)] ^ word_in(k))
+#define fwd_lrnd(c0, c1, c2, c3, k)                                     \
+  ((uint_32t)s_box(bval(c0, 0)) ^ ((uint_32t)s_box(bval(c1, 1)) << 8) ^ \
+   ((uint_32t)s_box(bval(c2, 2)) << 16) ^                               \
+   ((uint_32t)s_box(bval(c3, 3)) << 24) ^ word_in(k))
+
+/*  Encrypt a single block of 16 bytes using 32-bit column tables */
+
+static void encrypt_block_tables(const unsigned char in[N_BLOCK],
+                                 unsigned char out[N_BLOCK],
+                                 const aes_context ctx[1]) {
+  const uint_8t* k = ctx->ksch;
+  uint_32t s0, s1, s2, s3, t0, t1, t2, t3;
+  uint_8t r;
+
+  s0 = word_in(in) ^ word_in(k);
+  s1 = word_in(in + 4) ^ word_in(k + 4);
+  s2 = word_in(in + 8) ^ word_in(k + 8);
+  s3 = word_in(in + 12) ^ word_in(k + 12);
+
+  for (r = 1; r < ctx->rnd; ++r) {
+    k += N_BLOCK;
+    t0 = fwd_rnd(s0, s1, s2, s3, k);
+    t1 = fwd_rnd(s1, s2, s3, s0, k + 4);
+    t2 = fwd_rnd(s2, s3, s0, s1, k + 8);
+    t3 = fwd_rnd(s3, s0, s1, s2, k + 12);
+    s0 = t0;
+    s1 = t1;
+    s2 = t2;
+    s3 = t3;
+  }
+
+  k += N_BLOCK;
+  t0 = fwd_lrnd(s0, s1, s2, s3, k);
+  t1 = fwd_lrnd(s1, s2, s3, s0, k + 4);
+  t2 = fwd_lrnd(s2, s3, s0, s1, k + 8);
+  t3 = fwd_lrnd(s3, s0, s1, s2, k + 12);
+  word_out(out, t0);
+  word_out(out + 4, t1);
+  word_out(out + 8, t2);
+  word_out(out + 12, t3);
+}
+
+#endif
+
+#if defined(USE_AESNI)
+
+/*  Encrypt a single block of 16 bytes using the x86 AES instructions. The
+    key schedule is laid out as these instructions expect it */
+
+__attribute__((target("aes,sse2"))) static void encrypt_block_aesni(
+    const unsigned char in[N_BLOCK], unsigned char out[N_BLOCK],
+    const aes_context ctx[1]) {
+  const __m128i* k = (const __m128i*)ctx->ksch;
+  __m128i st;
+  uint_8t r;
+
+  st = _mm_xor_si128(_mm_loadu_si128((const __m128i*)in), _mm_loadu_si128(k));
+  for (r = 1; r < ctx->rnd; ++r)
+    st = _mm_aesenc_si128(st, _mm_loadu_si128(k + r));
+  st = _mm_aesenclast_si128(st, _mm_loadu_si128(k + r));
+  _mm_storeu_si128((__m128i*)out, st);
+}
+
+#endif
+
+typedef void (*encrypt_block_fn)(const unsigned char in[N_BLOCK],
+                                 unsigned char out[N_BLOCK],
+                                 const aes_context ctx[1]);
+
+/*  Returns the block encryption function of |impl|, NULL if the CPU does
+    not support it */
+
+static encrypt_block_fn encrypt_block_of(aes_impl impl) {
+  switch (impl) {
+    case AES_IMPL_BYTES:
+      return encrypt_block_bytes;
+#if defined(USE_COLUMN_TABLES)
+    case AES_IMPL_TABLES:
+      return encrypt_block_tables;
+#endif
+#if defined(USE_AESNI)
+    case AES_IMPL_AESNI:
+      return __builtin_cpu_supports("aes") ? encrypt_block_aesni : NULL;
+#endif
+    default:
+      return NULL;
+  }
+}
+
+static aes_impl best_impl(void) {
+#if defined(USE_AESNI)
+  /* this runs before the static constructor that probes the CPU */
+  __builtin_cpu_init();
+#endif
+  if (encrypt_block_of(AES_IMPL_AESNI)) return AES_IMPL_AESNI;
+  if (encrypt_block_of(AES_IMPL_TABLES)) return AES_IMPL_TABLES;
+  return AES_IMPL_BYTES;
+}
+
+static aes_impl selected_impl = best_impl();
+static encrypt_block_fn encrypt_block = encrypt_block_of(selected_impl);
+
+return_type aes_select_impl(aes_impl impl) {
+  encrypt_block_fn fn = encrypt_block_of(impl);
+  if (fn == NULL) return (return_type)-1;
+
+  selected_impl = impl;
+  encrypt_block = fn;
+  return 0;
+}
+
+aes_impl aes_selected_impl(void) { return selected_impl; }
+
+/*  Encrypt a single block of 16 bytes */
+
+return_type aes_encrypt(const unsigned char in[N_BLOCK],
+                        unsigned char out[N_BLOCK], const aes_context ctx[1]) {
+  if (ctx->rnd)
+    encrypt_block(in, out, ctx);
+  else
     return (return_type)-1;
   return 0;
 }
@@ -86,6 +86,21 @@ return_type aes_set_key(const unsigned char key[], length_type keylen,
 
 #if defined(AES_ENC_PREKEYED)
 
+/*  Implementations of the pre-keyed block encryption. The fastest one the
+    CPU supports is used unless another one is selected with
+    aes_select_impl(), which fails if the CPU does not support it.
+*/
+
+typedef enum {
+  AES_IMPL_BYTES,  /* 8-bit byte operations on the cipher state */
+  AES_IMPL_TABLES, /* 32-bit column operations using lookup tables */
+  AES_IMPL_AESNI   /* x86 AES instructions */
+} aes_impl;
+
+return_type aes_select_impl(aes_impl impl);
+
+aes_impl aes_selected_impl(void);
+
 return_type aes_encrypt(const unsigned char in[N_BLOCK],
                         unsigned char out[N_BLOCK], const aes_context ctx[1]);
 
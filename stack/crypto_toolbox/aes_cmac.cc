@@ -58,23 +58,33 @@ static void xor_128(Octet16* a, const Octet16& b) {
 }
 }  // namespace
 
-/* This function computes AES_128(key, message) */
-Octet16 aes_128(const Octet16& key, const Octet16& message) {
+/* This function expands the key schedule of the AES-128 key |key| */
+void aes_128_set_key(const Octet16& key, aes_context* ctx) {
   Octet16 key_reversed;
+
+  std::reverse_copy(key.begin(), key.end(), key_reversed.begin());
+  aes_set_key(key_reversed.data(), key_reversed.size(), ctx);
+}
+
+/* This function computes AES_128(key, message) with the key schedule |ctx| */
+Octet16 aes_128(const aes_context& ctx, const Octet16& message) {
   Octet16 message_reversed;
   Octet16 output;
 
-  std::reverse_copy(key.begin(), key.end(), key_reversed.begin());
   std::reverse_copy(message.begin(), message.end(), message_reversed.begin());
-
-  aes_context ctx;
-  aes_set_key(key_reversed.data(), key_reversed.size(), &ctx);
   aes_encrypt(message_reversed.data(), output.data(), &ctx);
 
   std::reverse(output.begin(), output.end());
   return output;
 }
 
+/* This function computes AES_128(key, message) */
+Octet16 aes_128(const Octet16& key, const Octet16& message) {
+  aes_context ctx;
+  aes_128_set_key(key, &ctx);
+  return aes_128(ctx, message);
+}
+
 /** utility function to padding the given text to be a 128 bits data. The
  * parameter dest is input and output parameter, it must point to a
  * OCTET16_LEN memory space; where include length bytes valid data. */
@@ -99,7 +109,7 @@ static void leftshift_onebit(uint8_t* input, uint8_t* output) {
 }
 
 /** This function is the calculation of block cipher using AES-128. */
-static Octet16 cmac_aes_k_calculate(const Octet16& key) {
+static Octet16 cmac_aes_k_calculate(const aes_context& ctx) {
   Octet16 output;
   Octet16 x{0};  // zero initialized
 
@@ -110,8 +120,8 @@ static Octet16 cmac_aes_k_calculate(const Octet16& key) {
     /* Mi' := Mi (+) X  */
     xor_128((Octet16*)&cmac_cb.text[(cmac_cb.round - i) * OCTET16_LEN], x);
 
-    output = aes_128(key, &cmac_cb.text[(cmac_cb.round - i) * OCTET16_LEN],
-                     OCTET16_LEN);
+    output = aes_128(ctx, *(Octet16*)&cmac_cb.text[(cmac_cb.round - i) *
+                                                    OCTET16_LEN]);
     x = output;
     i++;
   }
@@ -143,13 +153,13 @@ static void cmac_prepare_last_block(const Octet16& k1, const Octet16& k2) {
 }
 
 /** This is the function to generate the two subkeys.
- * |key| is CMAC key, expect SRK when used by SMP.
+ * |ctx| is the key schedule of the CMAC key, expect SRK when used by SMP.
  */
-static void cmac_generate_subkey(const Octet16& key) {
+static void cmac_generate_subkey(const aes_context& ctx) {
   DVLOG(2) << __func__;
 
   Octet16 zero{};
-  Octet16 p = aes_128(key, zero.data(), OCTET16_LEN);
+  Octet16 p = aes_128(ctx, zero);
 
   Octet16 k1, k2;
   uint8_t* pp = p.data();
@@ -175,11 +185,12 @@ static void cmac_generate_subkey(const Octet16& key) {
   cmac_prepare_last_block(k1, k2);
 }
 
-/** key - CMAC key in little endian order
+/** ctx - key schedule of the CMAC key, see aes_128_set_key()
  *  input - text to be signed in little endian byte order.
  *  length - length of the input in byte.
  */
-Octet16 aes_cmac(const Octet16& key, const uint8_t* input, uint16_t length) {
+Octet16 aes_cmac(const aes_context& ctx, const uint8_t* input,
+                 uint16_t length) {
   uint32_t len;
   uint16_t diff;
   /* n is number of rounds */
@@ -204,9 +215,9 @@ Octet16 aes_cmac(const Octet16& key, const uint8_t* input, uint16_t length) {
   }
 
   /* prepare calculation for subkey s and last block of data */
-  cmac_generate_subkey(key);
+  cmac_generate_subkey(ctx);
   /* start calculation */
-  Octet16 signature = cmac_aes_k_calculate(key);
+  Octet16 signature = cmac_aes_k_calculate(ctx);
 
   /* clean up */
   memset(&cmac_cb, 0, sizeof(tCMAC_CB));
@@ -215,4 +226,14 @@ Octet16 aes_cmac(const Octet16& key, const uint8_t* input, uint16_t length) {
   return signature;
 }
 
+/** key - CMAC key in little endian order
+ *  input - text to be signed in little endian byte order.
+ *  length - length of the input in byte.
+ */
+Octet16 aes_cmac(const Octet16& key, const uint8_t* input, uint16_t length) {
+  aes_context ctx;
+  aes_128_set_key(key, &ctx);
+  return aes_cmac(ctx, input, length);
+}
+
 }  // namespace crypto_toolbox
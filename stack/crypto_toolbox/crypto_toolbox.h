@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include "stack/crypto_toolbox/aes.h"
 #include "stack/include/bt_types.h"
 
 namespace crypto_toolbox {
@@ -23,6 +24,13 @@ namespace crypto_toolbox {
 extern Octet16 aes_128(const Octet16& key, const Octet16& message);
 extern Octet16 aes_cmac(const Octet16& key, const uint8_t* message,
                         uint16_t length);
+
+/* The key schedule of an AES-128 key can be expanded once with
+ * aes_128_set_key() and kept by callers using the same key repeatedly */
+extern void aes_128_set_key(const Octet16& key, aes_context* ctx);
+extern Octet16 aes_128(const aes_context& ctx, const Octet16& message);
+extern Octet16 aes_cmac(const aes_context& ctx, const uint8_t* message,
+                        uint16_t length);
 extern Octet16 f4(uint8_t* u, uint8_t* v, const Octet16& x, uint8_t z);
 extern void f5(uint8_t* w, const Octet16& n1, const Octet16& n2, uint8_t* a1,
                uint8_t* a2, Octet16* mac_key, Octet16* ltk);
@@ -394,7 +394,7 @@ BT_HDR* attp_build_multi_ntf_cmd(uint16_t payload_size, tGATT_MULTI_NOTIF multi_
       UINT16_TO_STREAM(p, handle);
       UINT16_TO_STREAM(p, len);
       value = multi_ntf.values[i];
-      for (uint8_t j=0; j<len; j++) {
+      for (uint16_t j=0; j<len; j++) {
         *p = value[j];
         p++;
       }
@@ -148,6 +148,10 @@ bool gatt_eatt_bcb_dealloc(tGATT_TCB* p_tcb, uint16_t lcid) {
       gatt_remove_conns_by_cid(p_tcb, p_eatt_bcb->cid);
 
       if (lcid != L2CAP_ATT_CID) {
+        /* the notifications held back for this channel can't be sent any
+         * more, unlike those for the ATT bearer which stays open */
+        gatt_notif_coalesce_clear(*p_tcb, lcid);
+
         alarm_cancel(p_eatt_bcb->ind_ack_timer);
         alarm_free(p_eatt_bcb->ind_ack_timer);
         p_eatt_bcb->ind_ack_timer = NULL;
@@ -1094,12 +1098,9 @@ void gatt_move_apps(tGATT_TCB* p_tcb, uint16_t cid) {
 
     sr_handle = p_eatt_bcb_old->indicate_handle;
     if (GATT_HANDLE_IS_VALID(sr_handle)) {
-      for (auto& el : *gatt_cb.srv_list_info) {
-        if (el.s_hdl <= sr_handle && el.e_hdl >= sr_handle) {
-          sr_conn_id = GATT_CREATE_CONN_ID(p_tcb->tcb_idx, el.gatt_if);
-          break;
-        }
-      }
+      auto it = gatt_sr_find_i_rcb_by_handle(sr_handle);
+      if (it != gatt_cb.srv_list_info->end())
+        sr_conn_id = GATT_CREATE_CONN_ID(p_tcb->tcb_idx, it->gatt_if);
     }
   }
 
@@ -138,18 +138,21 @@ static bool is_gatt_attr_type(const Uuid& uuid) {
   return false;
 }
 
-/** Update the the last service info for the service list info */
+/** Update the the last service info and the handle index for the service
+ * list info */
 static void gatt_update_last_srv_info() {
   gatt_cb.last_service_handle = 0;
 
   for (tGATT_SRV_LIST_ELEM& el : *gatt_cb.srv_list_info) {
     gatt_cb.last_service_handle = el.s_hdl;
   }
+
+  gatt_sr_update_srv_index();
 }
 
-/** Update database hash and client status */
+/** Mark database hash out of date and update client status */
 static void gatt_update_for_database_change() {
-  gatt_cb.database_hash = gatts_calculate_database_hash(gatt_cb.srv_list_info);
+  gatts_invalidate_database_hash();
 
   uint8_t i = 0;
   for (i = 0; i < GATT_MAX_PHY_CHANNEL; i++) {
@@ -489,6 +492,9 @@ tGATT_STATUS GATTS_HandleValueIndication(uint16_t conn_id, uint16_t attr_handle,
 
   if (!GATT_HANDLE_IS_VALID(attr_handle)) return GATT_ILLEGAL_PARAMETER;
 
+  /* don't overtake the notifications sent before */
+  gatt_notif_coalesce_flush(*p_tcb);
+
   tGATT_VALUE indication;
   indication.conn_id = conn_id;
   indication.handle = attr_handle;
@@ -557,6 +563,159 @@ tGATT_STATUS GATTS_HandleValueIndication(uint16_t conn_id, uint16_t attr_handle,
   return cmd_status;
 }
 
+/* Sends |notif| in its own PDU, or keeps it for when the EATT channel gets
+ * credits back */
+static tGATT_STATUS gatt_send_notif(tGATT_TCB& tcb, uint16_t lcid,
+                                    tGATT_EBCB* p_eatt_bcb,
+                                    tGATT_VALUE& notif) {
+  tGATT_STATUS cmd_sent;
+  tGATT_SR_MSG gatt_sr_msg;
+  gatt_sr_msg.attr_value = notif;
+  BT_HDR* p_buf =
+      attp_build_sr_msg(tcb, lcid, GATT_HANDLE_VALUE_NOTIF, &gatt_sr_msg);
+
+  if (p_buf != NULL) {
+    cmd_sent = attp_send_sr_msg(tcb, lcid, p_buf);
+  } else
+    cmd_sent = GATT_NO_RESOURCES;
+
+  if (cmd_sent == GATT_NO_CREDITS) {
+    if (tcb.is_eatt_supported && p_eatt_bcb &&
+       (p_eatt_bcb->notif_no_credits_apps.empty()
+        || (std::find(p_eatt_bcb->notif_no_credits_apps.begin(),
+            p_eatt_bcb->notif_no_credits_apps.end(),
+            notif.conn_id) == p_eatt_bcb->notif_no_credits_apps.end()))) {
+      gatt_notif_enq(&tcb, lcid, &notif);
+      p_eatt_bcb->notif_no_credits_apps.push_back(notif.conn_id);
+      cmd_sent = GATT_CONGESTED;
+    }
+  }
+
+  return cmd_sent;
+}
+
+/* Holds |notif| back, to send it with the next notifications for the same
+ * connection in one Multiple Handle Value Notification, or at least back to
+ * back. They are sent when no more fit in one PDU, or when the latency budget
+ * of the first one runs out. */
+static tGATT_STATUS gatt_notif_coalesce(tGATT_TCB& tcb, uint16_t lcid,
+                                        tGATT_EBCB* p_eatt_bcb,
+                                        tGATT_VALUE& notif) {
+  uint16_t payload_size = gatt_get_payload_size(&tcb, lcid);
+  /* handle, length and value */
+  uint16_t entry_len = 4 + notif.len;
+
+  if (!tcb.coalesce_q.empty() && (tcb.coalesce_lcid != lcid ||
+                                  tcb.coalesce_len + entry_len > payload_size))
+    gatt_notif_coalesce_flush(tcb);
+
+  /* too long to share a PDU with another value */
+  if (1 + entry_len > payload_size)
+    return gatt_send_notif(tcb, lcid, p_eatt_bcb, notif);
+
+  if (tcb.coalesce_q.empty()) {
+    tcb.coalesce_lcid = lcid;
+    tcb.coalesce_len = 1; /* opcode */
+    alarm_set_on_mloop(tcb.coalesce_timer, gatt_cb.notif_coalesce_ms,
+                       gatt_notif_coalesce_timeout, &tcb);
+  }
+  tcb.coalesce_q.push_back(notif);
+  tcb.coalesce_len += entry_len;
+  gatt_cb.notif_stats.coalesced++;
+
+  if (tcb.coalesce_q.size() == GATT_MAX_MULTI_HANDLE_NOTIF)
+    gatt_notif_coalesce_flush(tcb);
+
+  return GATT_SUCCESS;
+}
+
+/*******************************************************************************
+ *
+ * Function         gatt_notif_coalesce_flush
+ *
+ * Description      Send the notifications held back for a connection, in a
+ *                  Multiple Handle Value Notification if the client supports
+ *                  it, otherwise back to back.
+ *
+ * Returns          void
+ *
+ ******************************************************************************/
+void gatt_notif_coalesce_flush(tGATT_TCB& tcb) {
+  if (tcb.coalesce_q.empty()) return;
+  alarm_cancel(tcb.coalesce_timer);
+
+  std::deque<tGATT_VALUE> notifs;
+  notifs.swap(tcb.coalesce_q);
+  uint16_t lcid = tcb.coalesce_lcid;
+  tGATT_EBCB* p_eatt_bcb = NULL;
+  if (tcb.is_eatt_supported) p_eatt_bcb = gatt_find_eatt_bcb_by_cid(&tcb, lcid);
+
+  VLOG(1) << __func__ << ": lcid=" << loghex(lcid)
+          << ", notifications=" << notifs.size();
+
+  uint8_t cl_supp_feat = btif_storage_get_cl_supp_feat(tcb.peer_bda);
+  if (notifs.size() > 1 &&
+      (cl_supp_feat & CL_MULTI_NOTIF_SUPPORTED) == CL_MULTI_NOTIF_SUPPORTED) {
+    tGATT_MULTI_NOTIF multi_ntf;
+    multi_ntf.auth_req = GATT_AUTH_REQ_NONE;
+    multi_ntf.conn_id = notifs.front().conn_id;
+    multi_ntf.num_attr = notifs.size();
+    for (uint8_t i = 0; i < multi_ntf.num_attr; i++) {
+      multi_ntf.handles[i] = notifs[i].handle;
+      multi_ntf.lens[i] = notifs[i].len;
+      multi_ntf.values.emplace_back(notifs[i].value,
+                                    notifs[i].value + notifs[i].len);
+    }
+
+    BT_HDR* p_buf =
+        attp_build_multi_ntf_cmd(gatt_get_payload_size(&tcb, lcid), multi_ntf);
+    tGATT_STATUS status = attp_send_sr_msg(tcb, lcid, p_buf);
+    if (status == GATT_SUCCESS || status == GATT_CONGESTED) {
+      gatt_cb.notif_stats.multi_pdus++;
+      gatt_cb.notif_stats.pdus_saved += notifs.size() - 1;
+      return;
+    }
+    LOG(WARNING) << __func__ << ": multiple handle value notification failed,"
+                 << " status=" << loghex(status);
+  }
+
+  for (tGATT_VALUE& notif : notifs) gatt_send_notif(tcb, lcid, p_eatt_bcb, notif);
+  if (notifs.size() > 1) gatt_cb.notif_stats.bursts++;
+}
+
+/*******************************************************************************
+ *
+ * Function         gatt_notif_coalesce_clear
+ *
+ * Description      Drop the notifications held back for a connection if they
+ *                  were to be sent on |lcid|, when that channel is closed.
+ *
+ * Returns          void
+ *
+ ******************************************************************************/
+void gatt_notif_coalesce_clear(tGATT_TCB& tcb, uint16_t lcid) {
+  if (tcb.coalesce_q.empty() || tcb.coalesce_lcid != lcid) return;
+
+  VLOG(1) << __func__ << ": lcid=" << loghex(lcid)
+          << ", notifications=" << tcb.coalesce_q.size();
+  alarm_cancel(tcb.coalesce_timer);
+  tcb.coalesce_q.clear();
+}
+
+/*******************************************************************************
+ *
+ * Function         gatt_notif_coalesce_timeout
+ *
+ * Description      Called when the latency budget of the notifications held
+ *                  back for a connection runs out.
+ *
+ * Returns          void
+ *
+ ******************************************************************************/
+void gatt_notif_coalesce_timeout(void* data) {
+  gatt_notif_coalesce_flush(*(tGATT_TCB*)data);
+}
+
 /*******************************************************************************
  *
  * Function         GATTS_HandleValueNotification
@@ -569,7 +728,8 @@ tGATT_STATUS GATTS_HandleValueIndication(uint16_t conn_id, uint16_t attr_handle,
  *                  val_len: Length of the indicated attribute value.
  *                  p_val: Pointer to the indicated attribute value data.
  *
- * Returns          GATT_SUCCESS if sucessfully sent; otherwise error code.
+ * Returns          GATT_SUCCESS if sucessfully sent, or held back to be
+ *                  coalesced with the next ones; otherwise error code.
  *
  ******************************************************************************/
 tGATT_STATUS GATTS_HandleValueNotification(uint16_t conn_id,
@@ -613,30 +773,10 @@ tGATT_STATUS GATTS_HandleValueNotification(uint16_t conn_id,
     }
   }
 
-  tGATT_STATUS cmd_sent;
-  tGATT_SR_MSG gatt_sr_msg;
-  gatt_sr_msg.attr_value = notif;
-  BT_HDR* p_buf =
-      attp_build_sr_msg(*p_tcb, lcid, GATT_HANDLE_VALUE_NOTIF, &gatt_sr_msg);
-
-  if (p_buf != NULL) {
-    cmd_sent = attp_send_sr_msg(*p_tcb, lcid, p_buf);
-  } else
-    cmd_sent = GATT_NO_RESOURCES;
-
-  if (cmd_sent == GATT_NO_CREDITS) {
-    if (p_tcb->is_eatt_supported && p_eatt_bcb &&
-       (p_eatt_bcb->notif_no_credits_apps.empty()
-        || (std::find(p_eatt_bcb->notif_no_credits_apps.begin(),
-            p_eatt_bcb->notif_no_credits_apps.end(),
-            conn_id) == p_eatt_bcb->notif_no_credits_apps.end()))) {
-      gatt_notif_enq(p_tcb, lcid, &notif);
-      p_eatt_bcb->notif_no_credits_apps.push_back(conn_id);
-      cmd_sent = GATT_CONGESTED;
-    }
-  }
+  if (gatt_cb.notif_coalesce_ms > 0)
+    return gatt_notif_coalesce(*p_tcb, lcid, p_eatt_bcb, notif);
 
-  return cmd_sent;
+  return gatt_send_notif(*p_tcb, lcid, p_eatt_bcb, notif);
 }
 
 /*******************************************************************************
@@ -695,6 +835,9 @@ tGATT_STATUS GATTS_MultiHandleValueNotifications(uint16_t conn_id,
   }
   multi_ntf.values = values;
 
+  /* don't overtake the notifications sent before */
+  gatt_notif_coalesce_flush(*p_tcb);
+
   lcid = p_tcb->att_lcid;
   payload_size = p_tcb->payload_size;
   if (p_tcb->is_eatt_supported && p_reg->eatt_support) {
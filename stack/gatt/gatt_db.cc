@@ -29,6 +29,7 @@
 
 #include <stdio.h>
 #include <string.h>
+#include <algorithm>
 #include "btm_int.h"
 #include "gatt_int.h"
 #include "l2c_api.h"
@@ -273,8 +274,10 @@ tGATT_STATUS gatts_db_read_attr_value_by_type(
   uint8_t* p = (uint8_t*)(p_rsp + 1) + p_rsp->len + L2CAP_MIN_OFFSET;
 
   if (p_db) {
-    for (tGATT_ATTR& attr : p_db->attr_list) {
-      if (attr.handle >= s_handle && type == attr.uuid) {
+    for (auto it = gatts_find_first_attr(*p_db, s_handle);
+         it != p_db->attr_list.end() && it->handle <= e_handle; it++) {
+      tGATT_ATTR& attr = *it;
+      if (type == attr.uuid) {
         if (*p_len <= 2) {
           status = GATT_NO_RESOURCES;
           break;
@@ -450,15 +453,81 @@ uint16_t gatts_add_char_descr(tGATT_SVC_DB& db, tGATT_PERM perm,
 /******************************************************************************/
 /* Service Attribute Database Query Utility Functions */
 /******************************************************************************/
+/**
+ * Rebuild the handle index of gatt_cb.srv_list_info. Must be called whenever a
+ * service is added to or removed from the list.
+ */
+void gatt_sr_update_srv_index() {
+  gatt_cb.srv_list_index.clear();
+  if (!gatt_cb.srv_list_info) return;
+
+  gatt_cb.srv_list_index.reserve(gatt_cb.srv_list_info->size());
+  for (auto it = gatt_cb.srv_list_info->begin();
+       it != gatt_cb.srv_list_info->end(); it++) {
+    gatt_cb.srv_list_index.push_back(it);
+  }
+}
+
+/**
+ * Search for the first service that ends at or after |handle|. Services are
+ * kept sorted by handle and never overlap, so the services with handles in a
+ * range starting at |handle| are this one and the ones following it in
+ * gatt_cb.srv_list_info.
+ *
+ * Returns gatt_cb.srv_list_info->end() if there is no such service.
+ */
+std::list<tGATT_SRV_LIST_ELEM>::iterator gatt_sr_find_first_srv(
+    uint16_t handle) {
+  auto& index = gatt_cb.srv_list_index;
+  auto it = std::lower_bound(
+      index.begin(), index.end(), handle,
+      [](const std::list<tGATT_SRV_LIST_ELEM>::iterator& el, uint16_t handle) {
+        return el->e_hdl < handle;
+      });
+
+  if (it == index.end()) return gatt_cb.srv_list_info->end();
+  return *it;
+}
+
+/*******************************************************************************
+ *
+ * Function         gatt_sr_find_i_rcb_by_handle
+ *
+ * Description      Search for a service that owns a specific handle.
+ *
+ * Returns          gatt_cb.srv_list_info->end() if not found. Otherwise the
+ *                  service.
+ *
+ ******************************************************************************/
+std::list<tGATT_SRV_LIST_ELEM>::iterator gatt_sr_find_i_rcb_by_handle(
+    uint16_t handle) {
+  auto it = gatt_sr_find_first_srv(handle);
+  if (it != gatt_cb.srv_list_info->end() && it->s_hdl > handle)
+    return gatt_cb.srv_list_info->end();
+
+  return it;
+}
+
+/**
+ * Search for the first attribute of |db| with a handle not below |handle|.
+ * Attributes are allocated with increasing handles, so attr_list is sorted.
+ */
+std::vector<tGATT_ATTR>::iterator gatts_find_first_attr(tGATT_SVC_DB& db,
+                                                        uint16_t handle) {
+  return std::lower_bound(
+      db.attr_list.begin(), db.attr_list.end(), handle,
+      [](const tGATT_ATTR& attr, uint16_t handle) {
+        return attr.handle < handle;
+      });
+}
+
 tGATT_ATTR* find_attr_by_handle(tGATT_SVC_DB* p_db, uint16_t handle) {
   if (!p_db) return nullptr;
 
-  for (auto& attr : p_db->attr_list) {
-    if (attr.handle == handle) return &attr;
-    if (attr.handle > handle) return nullptr;
-  }
+  auto it = gatts_find_first_attr(*p_db, handle);
+  if (it == p_db->attr_list.end() || it->handle != handle) return nullptr;
 
-  return nullptr;
+  return &*it;
 }
 
 /*******************************************************************************
@@ -112,6 +112,12 @@ typedef uint8_t tGATT_SEC_ACTION;
 #define GATT_WAIT_FOR_DISC_RSP_TIMEOUT_MS (5 * 1000)
 #define GATT_REQ_RETRY_LIMIT 2
 
+/* How long notifications may be held back to be sent together, in ms. 0, the
+ * default, sends every notification in its own PDU right away. */
+#define GATT_NOTIF_COALESCE_MS_PROPERTY \
+  "persist.vendor.bluetooth.gatt.notif_coalesce_ms"
+#define GATT_NOTIF_COALESCE_MAX_MS 100
+
 /* characteristic descriptor type */
 #define GATT_DESCR_EXT_DSCPTOR 1  /* Characteristic Extended Properties */
 #define GATT_DESCR_USER_DSCPTOR 2 /* Characteristic User Description    */
@@ -304,6 +310,8 @@ typedef struct {
   uint16_t e_hdl;      /* service ending handle */
   tGATT_IF gatt_if;    /* this service is belong to which application */
   bool is_primary;
+  /* database hash input for this service, reversed; built on first use */
+  std::vector<uint8_t> hash_info;
 } tGATT_SRV_LIST_ELEM;
 
 typedef struct {
@@ -331,6 +339,12 @@ typedef struct {
 
   alarm_t* conf_timer; /* peer confirm to indication timer */
 
+  /* notifications held back to be sent together, all on coalesce_lcid */
+  std::deque<tGATT_VALUE> coalesce_q;
+  uint16_t coalesce_lcid;
+  uint16_t coalesce_len;   /* size of them as one Multiple Handle Value Ntf */
+  alarm_t* coalesce_timer; /* latency budget of the oldest one */
+
   uint8_t prep_cnt[GATT_MAX_APPS];
   uint8_t ind_count;
 
@@ -486,6 +500,14 @@ typedef struct {
 #define GATT_ROBUST_CACHING_CL_SUPP_FEAT_READ        12 /*Read client supported features char */
 #define GATT_ROBUST_CACHING_CL_SUPP_FEAT_WRITE       13 /* Write client supported features char */
 
+/* Notification coalescing counters */
+typedef struct {
+  uint32_t coalesced;  /* notifications held back to be sent together */
+  uint32_t multi_pdus; /* Multiple Handle Value Notifications sent */
+  uint32_t pdus_saved; /* notification PDUs spared by them */
+  uint32_t bursts;     /* groups sent back to back, one PDU per value */
+} tGATT_NOTIF_STATS;
+
 typedef struct {
   uint16_t conn_id;
   bool in_use;
@@ -527,6 +549,8 @@ typedef struct {
   tGATT_IF gatt_if;
   std::list<tGATT_HDL_LIST_ELEM>* hdl_list_info;
   std::list<tGATT_SRV_LIST_ELEM>* srv_list_info;
+  /* srv_list_info in handle order, for binary search by handle */
+  std::vector<std::list<tGATT_SRV_LIST_ELEM>::iterator> srv_list_index;
 
   fixed_queue_t* srv_chg_clt_q; /* service change clients queue */
   tGATT_REG cl_rcb[GATT_MAX_APPS];
@@ -546,6 +570,7 @@ typedef struct {
 
   uint16_t handle_of_database_hash;
   Octet16 database_hash;
+  bool database_hash_dirty; /* database changed since database_hash was set */
 
   tGATT_APPL_INFO cb_info;
 
@@ -562,6 +587,9 @@ typedef struct {
    */
    uint8_t gatt_cl_supported_feat_mask;
    bool over_br_enabled;
+
+  uint32_t notif_coalesce_ms; /* 0 when notifications are not coalesced */
+  tGATT_NOTIF_STATS notif_stats;
 } tGATT_CB;
 
 #define GATT_SIZE_OF_SRV_CHG_HNDL_RANGE 4
@@ -680,6 +708,9 @@ extern uint32_t gatt_sr_enqueue_cmd(tGATT_TCB& tcb, uint16_t lcid, uint8_t op_co
 extern bool gatt_cancel_open(tGATT_IF gatt_if, const RawAddress& bda);
 extern void gatt_notify_phy_updated(uint8_t status, uint16_t handle,
                                     uint8_t tx_phy, uint8_t rx_phy);
+extern void gatt_notif_coalesce_flush(tGATT_TCB& tcb);
+extern void gatt_notif_coalesce_clear(tGATT_TCB& tcb, uint16_t lcid);
+extern void gatt_notif_coalesce_timeout(void* data);
 /*   */
 
 extern tGATT_REG* gatt_get_regcb(tGATT_IF gatt_if);
@@ -754,6 +785,12 @@ extern uint16_t gatts_add_char_ext_prop_descr(tGATT_SVC_DB& db,
                                               uint16_t extended_properties);
 extern uint16_t gatts_add_char_descr(tGATT_SVC_DB& db, tGATT_PERM perm,
                                      const bluetooth::Uuid& dscp_uuid);
+extern void gatt_sr_update_srv_index();
+extern std::list<tGATT_SRV_LIST_ELEM>::iterator gatt_sr_find_first_srv(
+    uint16_t handle);
+extern std::vector<tGATT_ATTR>::iterator gatts_find_first_attr(
+    tGATT_SVC_DB& db, uint16_t handle);
+extern tGATT_ATTR* find_attr_by_handle(tGATT_SVC_DB* p_db, uint16_t handle);
 extern tGATT_STATUS gatts_db_read_attr_value_by_type(
     tGATT_TCB& tcb, uint16_t lcid, tGATT_SVC_DB* p_db, uint8_t op_code, BT_HDR* p_rsp,
     uint16_t s_handle, uint16_t e_handle, const bluetooth::Uuid& type,
@@ -782,6 +819,8 @@ extern void gatt_notify_eatt_congestion(tGATT_TCB* p_tcb, uint16_t cid, bool con
 /* gatt_sr_hash.cc */
 extern Octet16 gatts_calculate_database_hash(
     std::list<tGATT_SRV_LIST_ELEM>* lst_ptr);
+extern void gatts_invalidate_database_hash();
+extern Octet16 gatts_get_database_hash();
 
 // Saves DB hash
 extern void gatt_save_cl_db_hash(tGATT_TCB tcb);
@@ -205,6 +205,11 @@ void gatt_init(void) {
 
   gatt_cb.over_br_enabled =
       osi_property_get_bool("persist.vendor.bluetooth.gatt.over_bredr.enabled", true);
+
+  int32_t coalesce_ms = osi_property_get_int32(GATT_NOTIF_COALESCE_MS_PROPERTY, 0);
+  if (coalesce_ms > GATT_NOTIF_COALESCE_MAX_MS)
+    coalesce_ms = GATT_NOTIF_COALESCE_MAX_MS;
+  gatt_cb.notif_coalesce_ms = (coalesce_ms > 0) ? coalesce_ms : 0;
   /* Now, register with L2CAP for ATT PSM over BR/EDR */
   if (gatt_cb.over_br_enabled) {
     if (!L2CA_Register(BT_PSM_ATT, (tL2CAP_APPL_INFO*)&dyn_info,
@@ -274,6 +279,10 @@ void gatt_free(void) {
     alarm_free(gatt_cb.tcb[i].ind_ack_timer);
     gatt_cb.tcb[i].ind_ack_timer = NULL;
 
+    alarm_free(gatt_cb.tcb[i].coalesce_timer);
+    gatt_cb.tcb[i].coalesce_timer = NULL;
+    gatt_cb.tcb[i].coalesce_q.clear();
+
     fixed_queue_free(gatt_cb.tcb[i].sr_cmd.multi_rsp_q, NULL);
     gatt_cb.tcb[i].sr_cmd.multi_rsp_q = NULL;
   }
@@ -300,6 +309,7 @@ void gatt_free(void) {
     gatt_cb.hdl_list_info = nullptr;
   }
 
+  gatt_cb.srv_list_index.clear();
   if (gatt_cb.srv_list_info != nullptr) {
     gatt_cb.srv_list_info->clear();
     delete(gatt_cb.srv_list_info);
@@ -307,6 +317,33 @@ void gatt_free(void) {
   }
 }
 
+/*******************************************************************************
+ *
+ * Function         gatt_dump
+ *
+ * Description      This function dumps the GATT notification coalescing
+ *                  settings and counters.
+ *
+ * Returns          void
+ *
+ ******************************************************************************/
+void gatt_dump(int fd) {
+  const tGATT_NOTIF_STATS& stats = gatt_cb.notif_stats;
+
+  dprintf(fd, "\nGATT server notifications:\n");
+  if (gatt_cb.notif_coalesce_ms == 0) {
+    dprintf(fd, "\tcoalescing disabled\n");
+    return;
+  }
+
+  dprintf(fd, "\tcoalescing latency budget: %u ms\n", gatt_cb.notif_coalesce_ms);
+  dprintf(fd, "\tnotifications coalesced: %u\n", stats.coalesced);
+  dprintf(fd, "\tmultiple handle value notifications sent: %u\n",
+          stats.multi_pdus);
+  dprintf(fd, "\tnotification PDUs saved: %u\n", stats.pdus_saved);
+  dprintf(fd, "\tbursts of single notifications sent: %u\n", stats.bursts);
+}
+
 /*******************************************************************************
  *
  * Function         gatt_connect
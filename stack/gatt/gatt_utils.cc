@@ -535,6 +535,8 @@ tGATT_TCB* gatt_allocate_tcb_by_bdaddr(const RawAddress& bda,
     p_tcb->pending_ind_q = fixed_queue_new(SIZE_MAX);
     p_tcb->conf_timer = alarm_new("gatt.conf_timer");
     p_tcb->ind_ack_timer = alarm_new("gatt.ind_ack_timer");
+    if (gatt_cb.notif_coalesce_ms > 0)
+      p_tcb->coalesce_timer = alarm_new("gatt.coalesce_timer");
     p_tcb->in_use = true;
     p_tcb->tcb_idx = i;
     p_tcb->transport = transport;
@@ -945,27 +947,6 @@ void gatt_ind_ack_eatt_timeout(void* data) {
   attp_send_cl_msg(*p_tcb, nullptr, lcid, GATT_HANDLE_VALUE_CONF, NULL);
 }
 
-/*******************************************************************************
- *
- * Description      Search for a service that owns a specific handle.
- *
- * Returns          GATT_MAX_SR_PROFILES if not found. Otherwise the index of
- *                  the service.
- *
- ******************************************************************************/
-std::list<tGATT_SRV_LIST_ELEM>::iterator gatt_sr_find_i_rcb_by_handle(
-    uint16_t handle) {
-  auto it = gatt_cb.srv_list_info->begin();
-
-  for (; it != gatt_cb.srv_list_info->end(); it++) {
-    if (it->s_hdl <= handle && it->e_hdl >= handle) {
-      return it;
-    }
-  }
-
-  return it;
-}
-
 /*******************************************************************************
  *
  * Function         gatt_sr_get_sec_info
@@ -1645,6 +1626,11 @@ void gatt_cleanup_upon_disc(const RawAddress& bda, uint16_t reason,
   alarm_cancel(p_tcb->conf_timer);
   alarm_free(p_tcb->conf_timer);
   p_tcb->conf_timer = NULL;
+
+  /* the link is gone, so are the notifications held back for it */
+  alarm_free(p_tcb->coalesce_timer);
+  p_tcb->coalesce_timer = NULL;
+  p_tcb->coalesce_q.clear();
   fixed_queue_free(p_tcb->sr_cmd.multi_rsp_q, NULL);
   p_tcb->sr_cmd.multi_rsp_q = NULL;
 
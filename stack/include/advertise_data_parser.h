@@ -22,6 +22,7 @@
 
 #pragma once
 
+#include <string.h>
 #include <array>
 #include <vector>
 #include <map>
@@ -33,15 +34,60 @@ static constexpr std::array<uint8_t, 18> trx_quirk{
     {0x14, 0x09, 0x54, 0xFF, 0xFF, 0x20, 0x42, 0x4C, 0x45, 0x05, 0x12, 0xFF,
      0x00, 0xE8, 0x03, 0x02, 0x0A, 0x00}};
 
+class AdvertiseDataParser;
+
+/**
+ * Positions of the fields of one advertising data buffer, as collected by
+ * AdvertiseDataParser::Index(). Looking a field up is constant time, which
+ * lets a report be examined for several field types after a single parse.
+ */
+class AdvertiseDataFields {
+ public:
+  const uint8_t* data() const { return ad_; }
+  size_t size() const { return ad_len_; }
+  bool empty() const { return ad_len_ == 0; }
+
+  /**
+   * Return true if the indexed data is properly formatted advertising data,
+   * with the same result as AdvertiseDataParser::IsValid().
+   */
+  bool IsValid() const { return valid_; }
+
+  /**
+   * Return a pointer inside the indexed data where the first field of |type|
+   * is located, together with its length in |p_length|, with the same result
+   * as AdvertiseDataParser::GetFieldByType().
+   */
+  const uint8_t* GetFieldByType(uint8_t type, uint8_t* p_length) const {
+    if ((present_[type >> 5] & (1u << (type & 0x1F))) == 0) {
+      *p_length = 0;
+      return NULL;
+    }
+
+    const uint8_t* field = ad_ + offset_[type];
+    *p_length = field[-2] - 1; /* minus the length of type */
+    return field;
+  }
+
+ private:
+  friend class AdvertiseDataParser;
+
+  const uint8_t* ad_ = NULL;
+  size_t ad_len_ = 0;
+  bool valid_ = true;
+  uint32_t present_[8] = {};  // Bitmap of the AD types found
+  uint16_t offset_[256];      // Offset of the first field value of each type
+};
+
 class AdvertiseDataParser {
   // Return true if the packet is malformed, but should be considered valid for
   // compatibility with already existing devices
-  static bool MalformedPacketQuirk(const std::vector<uint8_t>& ad,
+  static bool MalformedPacketQuirk(const uint8_t* ad, size_t ad_len,
                                    size_t position) {
-    auto data_start = ad.begin() + position;
+    const uint8_t* data_start = ad + position;
 
     // Traxxas - bad name length
-    if ((ad.size() - position) >= 18 &&
+    if ((ad_len - position) >= 18 &&
         std::equal(data_start, data_start + 3, trx_quirk.begin()) &&
         std::equal(data_start + 5, data_start + 11, trx_quirk.begin() + 5) &&
         std::equal(data_start + 12, data_start + 18, trx_quirk.begin() + 12)) {
@@ -52,10 +98,13 @@ class AdvertiseDataParser {
   }
 
  public:
-  static void RemoveTrailingZeros(std::vector<uint8_t>& ad) {
+  /**
+   * Return the length of the |ad| array of length |ad_len| without the zero
+   * padding some devices send at the end of the advertisement.
+   */
+  static size_t TrimTrailingZeros(const uint8_t* ad, size_t ad_len) {
     size_t position = 0;
 
-    size_t ad_len = ad.size();
     while (position < ad_len) {
       uint8_t len = ad[position];
 
@@ -64,17 +113,18 @@ class AdvertiseDataParser {
       // end of advertisement. If this is the case, cut the zero padding from
       // end of the packet. Otherwise i.e. gluing scan response to advertise
       // data will result in data with zero padding in the middle.
-      if (len == 0) {
-        ad.erase(ad.begin() + position, ad.end());
-        return;
-      }
+      if (len == 0) return position;
 
-      if (position + len >= ad_len) {
-        return;
-      }
+      if (position + len >= ad_len) return ad_len;
 
       position += len + 1;
     }
+
+    return ad_len;
+  }
+
+  static void RemoveTrailingZeros(std::vector<uint8_t>& ad) {
+    ad.resize(TrimTrailingZeros(ad.data(), ad.size()));
   }
 
   /**
@@ -100,7 +150,7 @@ class AdvertiseDataParser {
       // If the length of the current field would exceed the total data length,
       // then the data is badly formatted.
       if (position + len >= ad_len) {
-        if (MalformedPacketQuirk(ad, position)) return true;
+        if (MalformedPacketQuirk(ad.data(), ad_len, position)) return true;
 
         return false;
       }
@@ -149,6 +199,49 @@ class AdvertiseDataParser {
     return GetFieldByType(ad.data(), ad.size(), type, p_length);
   }
 
+  /**
+   * Collect the positions of the fields of the |ad| array of length |ad_len|
+   * into |fields|, walking the data only once. |ad| must outlive |fields|.
+   */
+  static void Index(const uint8_t* ad, size_t ad_len,
+                    AdvertiseDataFields* fields) {
+    size_t position = 0;
+
+    fields->ad_ = ad;
+    fields->ad_len_ = ad_len;
+    fields->valid_ = true;
+    memset(fields->present_, 0, sizeof(fields->present_));
+
+    while (position < ad_len) {
+      uint8_t len = ad[position];
+
+      // Only zero padding may follow an empty field, see IsValid().
+      if (len == 0) {
+        for (size_t i = position + 1; i < ad_len; i++) {
+          if (ad[i] != 0) {
+            fields->valid_ = false;
+            break;
+          }
+        }
+        return;
+      }
+
+      if (position + len >= ad_len) {
+        fields->valid_ = MalformedPacketQuirk(ad, ad_len, position);
+        return;
+      }
+
+      uint8_t adv_type = ad[position + 1];
+      uint32_t bit = 1u << (adv_type & 0x1F);
+      if ((fields->present_[adv_type >> 5] & bit) == 0) {
+        fields->present_[adv_type >> 5] |= bit;
+        fields->offset_[adv_type] = position + 2;
+      }
+
+      position += len + 1; /* skip the length of data */
+    }
+  }
+
   /**
   * This function returns a map<starting position of Enc AD data part in original
   * Adv data, Length of Enc AD data part (including L, T(of Enc AD type) in |p_length|>
@@ -138,6 +138,9 @@
 #define AVRC_METADATA_CMD 0x0000
 #define AVRC_METADATA_RESP 0x0001
 
+/* Scope given to AVRC_ItemCacheInvalidate() to drop the items of all scopes */
+#define AVRC_ITEM_CACHE_ALL_SCOPES 0xFF
+
 /*****************************************************************************
  *  data type definitions
  ****************************************************************************/
@@ -190,6 +193,10 @@ typedef struct {
   uint8_t msg_mask;
 } tAVRC_PARAM;
 
+/* Serialized folder items of a target, used to answer Get Folder Items
+ * commands without asking the player again. See AVRC_ItemCacheNew(). */
+typedef struct t_avrc_item_cache tAVRC_ITEM_CACHE;
+
 /*****************************************************************************
  *  external function declarations
  ****************************************************************************/
@@ -718,4 +725,95 @@ extern bool AVRC_IsValidPlayerAttr(uint8_t attr);
 *******************************************************************************/
 extern bool AVRC_CheckIncomingConn(RawAddress peer_addr);
 
+/*******************************************************************************
+ *
+ * Function         AVRC_ItemCacheNew
+ *
+ * Description      Allocate an empty cache of folder items. Items are kept
+ *                  per scope, serialized the way Get Folder Items responses
+ *                  carry them, for one UID counter and one list of media
+ *                  attributes at a time.
+ *
+ * Returns          the cache, to be released with AVRC_ItemCacheFree()
+ *
+ ******************************************************************************/
+extern tAVRC_ITEM_CACHE* AVRC_ItemCacheNew(void);
+
+/*******************************************************************************
+ *
+ * Function         AVRC_ItemCacheFree
+ *
+ * Description      Release a cache from AVRC_ItemCacheNew(). p_cache may be
+ *                  NULL.
+ *
+ * Returns          void
+ *
+ ******************************************************************************/
+extern void AVRC_ItemCacheFree(tAVRC_ITEM_CACHE* p_cache);
+
+/*******************************************************************************
+ *
+ * Function         AVRC_ItemCacheInvalidate
+ *
+ * Description      Drop the items cached for scope, or for all scopes if
+ *                  scope is AVRC_ITEM_CACHE_ALL_SCOPES.
+ *
+ * Returns          void
+ *
+ ******************************************************************************/
+extern void AVRC_ItemCacheInvalidate(tAVRC_ITEM_CACHE* p_cache, uint8_t scope);
+
+/*******************************************************************************
+ *
+ * Function         AVRC_ItemCacheAttrKey
+ *
+ * Description      Compute the key of the media attributes requested by a
+ *                  Get Folder Items command. p_attr_list may be NULL if
+ *                  attr_count is 0 or 0xFF.
+ *
+ * Returns          the key to give to AVRC_ItemCacheStore() and
+ *                  AVRC_ItemCacheBldRsp()
+ *
+ ******************************************************************************/
+extern uint32_t AVRC_ItemCacheAttrKey(uint8_t attr_count,
+                                      const uint32_t* p_attr_list);
+
+/*******************************************************************************
+ *
+ * Function         AVRC_ItemCacheStore
+ *
+ * Description      Store the item at index item_index of scope, as given by
+ *                  the player for the UID counter uid_counter and the
+ *                  attributes of attr_key. The items cached for another UID
+ *                  counter or attribute key are dropped first. Items that
+ *                  are not valid, or would not fit in a response or in the
+ *                  room left in their page of the cache, are not stored. When
+ *                  the cache of scope is full, the least recently used items
+ *                  are dropped for this one.
+ *
+ * Returns          void
+ *
+ ******************************************************************************/
+extern void AVRC_ItemCacheStore(tAVRC_ITEM_CACHE* p_cache, uint8_t scope,
+                                uint32_t attr_key, uint16_t uid_counter,
+                                uint32_t item_index, const tAVRC_ITEM* p_item);
+
+/*******************************************************************************
+ *
+ * Function         AVRC_ItemCacheBldRsp
+ *
+ * Description      Build the Get Folder Items response for the items
+ *                  start_item to end_item of scope from the cache. The
+ *                  response is served only if the cached items fill it up to
+ *                  the browsing MTU or up to end_item.
+ *
+ * Returns          true and the response in *pp_pkt if it was built,
+ *                  false if the player must be asked for the items.
+ *
+ ******************************************************************************/
+extern bool AVRC_ItemCacheBldRsp(tAVRC_ITEM_CACHE* p_cache, uint8_t handle,
+                                 uint8_t scope, uint32_t attr_key,
+                                 uint32_t start_item, uint32_t end_item,
+                                 BT_HDR** pp_pkt);
+
 #endif /* AVRC_API_H */
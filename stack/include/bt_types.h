@@ -73,6 +73,9 @@
 
 /* ACL Data from HCI                */
 #define BT_EVT_TO_BTU_HCI_ACL 0x1100
+/* ACL Data from HCI still in the fragments it was received in, see
+ * tBT_ACL_CHAIN */
+#define BT_EVT_TO_BTU_HCI_ACL_CHAINED (0x0001 | BT_EVT_TO_BTU_HCI_ACL)
 /* SCO Data from HCI                */
 #define BT_EVT_TO_BTU_HCI_SCO 0x1200
 /* HCI Transport Error              */
@@ -228,6 +231,15 @@ typedef struct {
 
 #define BT_HDR_SIZE (sizeof(BT_HDR))
 
+/* Data of a BT_EVT_TO_BTU_HCI_ACL_CHAINED buffer. The offset and len of each
+ * fragment delimit its part of the ACL packet, the first one starting with the
+ * ACL and L2CAP headers. The headers give the length of the whole packet.
+ */
+typedef struct {
+  uint16_t num_fragments;
+  BT_HDR* fragments[];
+} tBT_ACL_CHAIN;
+
 #define BT_PSM_SDP 0x0001
 #define BT_PSM_RFCOMM 0x0003
 #define BT_PSM_TCS 0x0005
@@ -548,7 +560,9 @@ typedef uint8_t tAMP_KEY_TYPE;
 #define BT_OCTET8_LEN 8
 typedef uint8_t BT_OCTET8[BT_OCTET8_LEN]; /* octet array: size 16 */
 
+#ifdef __cplusplus
 typedef std::array<uint8_t, BT_OCTET8_LEN> Octet8; /* standard array: size 8 */
+#endif
 
 #define AMP_LINK_KEY_LEN 32
 typedef uint8_t
@@ -1365,4 +1365,7 @@ extern void gatt_reset_bgdev_list(bool after_reset);
 // Updates EATT support
 extern void gatt_update_eatt_support(RawAddress& bda);
 
+// Dumps the notification coalescing settings and counters.
+extern void gatt_dump(int fd);
+
 #endif /* GATT_API_H */
@@ -1007,6 +1007,22 @@ extern uint16_t L2CA_FlushChannel(uint16_t lcid, uint16_t num_to_flush);
  ******************************************************************************/
 extern bool L2CA_SetAclPriority(const RawAddress& bd_addr, uint8_t priority);
 
+/*******************************************************************************
+ *
+ * Function         L2CA_SetLinkLatencyTarget
+ *
+ * Description      Sets the longest time the data of an ACL link should wait
+ *                  for the controller when links share the ACL buffers. A
+ *                  link waiting longer is served ahead of the others. A target
+ *                  of 0 removes it.
+ *
+ * Returns          true if a valid link, else false
+ *
+ ******************************************************************************/
+extern bool L2CA_SetLinkLatencyTarget(const RawAddress& bd_addr,
+                                      tBT_TRANSPORT transport,
+                                      uint32_t latency_ms);
+
 /*******************************************************************************
  *
  * Function         L2CA_FlowControl
@@ -1632,4 +1648,16 @@ extern bool L2CA_SubrateRequest(const RawAddress& rem_bda,
                                 uint16_t max_latency, uint16_t cont_num,
                                 uint16_t timeout);
 
+/*******************************************************************************
+ *
+ *  Function        L2CA_Dump
+ *
+ *  Description     Dumps the scheduling weights of the links and channels and
+ *                  their queueing statistics.
+ *
+ *  Return value:   void
+ *
+ ******************************************************************************/
+extern void L2CA_Dump(int fd);
+
 #endif /* L2C_API_H */
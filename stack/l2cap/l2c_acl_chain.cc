@@ -0,0 +1,63 @@
+/******************************************************************************
+ * Copyright (c) 2026 Qualcomm Innovation Center, Inc. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ *
+ *******************************************************************************/
+
+/******************************************************************************
+ *
+ *  This file contains the access to ACL packets received as a chain of
+ *  fragments.
+ *
+ ******************************************************************************/
+
+#include "l2c_acl_chain.h"
+
+#include <string.h>
+
+#include "osi/include/allocator.h"
+
+static bool l2c_acl_is_chained(BT_HDR* p_msg) {
+  return p_msg->event == BT_EVT_TO_BTU_HCI_ACL_CHAINED;
+}
+
+uint8_t* l2c_acl_chain_headers(BT_HDR* p_msg) {
+  if (!l2c_acl_is_chained(p_msg)) return (uint8_t*)(p_msg + 1) + p_msg->offset;
+
+  BT_HDR* p_first = ((tBT_ACL_CHAIN*)p_msg->data)->fragments[0];
+  return p_first->data + p_first->offset;
+}
+
+BT_HDR* l2c_acl_chain_flatten(BT_HDR* p_msg) {
+  if (!l2c_acl_is_chained(p_msg)) return p_msg;
+
+  tBT_ACL_CHAIN* p_chain = (tBT_ACL_CHAIN*)p_msg->data;
+  uint16_t total_len = 0;
+  for (uint16_t i = 0; i < p_chain->num_fragments; i++)
+    total_len += p_chain->fragments[i]->len;
+
+  BT_HDR* p_buf = (BT_HDR*)osi_pool_malloc(BT_HDR_SIZE + total_len);
+  p_buf->event = BT_EVT_TO_BTU_HCI_ACL;
+  p_buf->len = p_msg->len;
+  p_buf->offset = p_msg->offset;
+  p_buf->layer_specific = p_msg->layer_specific;
+
+  uint8_t* p = p_buf->data;
+  for (uint16_t i = 0; i < p_chain->num_fragments; i++) {
+    BT_HDR* p_fragment = p_chain->fragments[i];
+    memcpy(p, p_fragment->data + p_fragment->offset, p_fragment->len);
+    p += p_fragment->len;
+  }
+
+  l2c_acl_chain_free(p_msg);
+  return p_buf;
+}
+
+void l2c_acl_chain_free(BT_HDR* p_msg) {
+  if (l2c_acl_is_chained(p_msg)) {
+    tBT_ACL_CHAIN* p_chain = (tBT_ACL_CHAIN*)p_msg->data;
+    for (uint16_t i = 0; i < p_chain->num_fragments; i++)
+      osi_free(p_chain->fragments[i]);
+  }
+  osi_free(p_msg);
+}
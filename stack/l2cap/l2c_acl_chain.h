@@ -0,0 +1,55 @@
+/******************************************************************************
+ * Copyright (c) 2026 Qualcomm Innovation Center, Inc. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ *
+ *******************************************************************************/
+
+/******************************************************************************
+ *
+ *  Access to the ACL packets that HCI hands up as the chain of fragments they
+ *  were received in (BT_EVT_TO_BTU_HCI_ACL_CHAINED). L2CAP reads the headers
+ *  of such a packet from its first fragment, and copies it into a single
+ *  buffer only once it is about to be given to a channel. A packet dropped
+ *  before that is never copied.
+ *
+ ******************************************************************************/
+
+#ifndef L2C_ACL_CHAIN_H
+#define L2C_ACL_CHAIN_H
+
+#include "bt_types.h"
+
+/*******************************************************************************
+ *
+ * Function         l2c_acl_chain_headers
+ *
+ * Description      Returns the start of the ACL packet |p_msg|, in its first
+ *                  fragment if it is chained. Only the ACL and L2CAP basic
+ *                  headers may then be read from it.
+ *
+ ******************************************************************************/
+extern uint8_t* l2c_acl_chain_headers(BT_HDR* p_msg);
+
+/*******************************************************************************
+ *
+ * Function         l2c_acl_chain_flatten
+ *
+ * Description      Returns the ACL packet |p_msg| in a single buffer. A chained
+ *                  packet is copied into a new buffer, keeping its offset, len
+ *                  and layer_specific, and freed with its fragments. Any other
+ *                  packet is returned as is.
+ *
+ ******************************************************************************/
+extern BT_HDR* l2c_acl_chain_flatten(BT_HDR* p_msg);
+
+/*******************************************************************************
+ *
+ * Function         l2c_acl_chain_free
+ *
+ * Description      Frees the ACL packet |p_msg|, with its fragments if it is
+ *                  chained.
+ *
+ ******************************************************************************/
+extern void l2c_acl_chain_free(BT_HDR* p_msg);
+
+#endif /* L2C_ACL_CHAIN_H */
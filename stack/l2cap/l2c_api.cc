@@ -1770,6 +1770,30 @@ bool L2CA_SetAclPriority(const RawAddress& bd_addr, uint8_t priority) {
   return (l2cu_set_acl_priority(bd_addr, priority, false));
 }
 
+/*******************************************************************************
+ *
+ * Function         L2CA_SetLinkLatencyTarget
+ *
+ * Description      Sets the longest time the data of an ACL link should wait
+ *                  for the controller when links share the ACL buffers.
+ *
+ * Returns          true if a valid link, else false
+ *
+ ******************************************************************************/
+bool L2CA_SetLinkLatencyTarget(const RawAddress& bd_addr,
+                               tBT_TRANSPORT transport, uint32_t latency_ms) {
+  tL2C_LCB* p_lcb = l2cu_find_lcb_by_bd_addr(bd_addr, transport);
+  if (p_lcb == NULL) {
+    L2CAP_TRACE_WARNING("%s: no link for %s", __func__,
+                        bd_addr.ToString().c_str());
+    return false;
+  }
+
+  VLOG(1) << __func__ << " BDA: " << bd_addr << ", latency: " << latency_ms;
+  p_lcb->drr.latency_target_ms = latency_ms;
+  return true;
+}
+
 /*******************************************************************************
  *
  * Function         L2CA_FlowControl
@@ -2874,3 +2898,70 @@ BT_HDR* L2CA_ReadData (uint16_t cid) {
   p_data = (BT_HDR *)fixed_queue_dequeue(p_ccb->rx_buf.rcv_data_q);
   return (p_data);
 }
+
+static void l2c_dump_flow(int fd, const tL2C_DRR_FLOW* p_flow) {
+  const tL2C_DRR_STATS* p_stats = &p_flow->stats;
+  uint64_t mean_wait_ms =
+      p_stats->sent_pkts ? p_stats->total_wait_ms / p_stats->sent_pkts : 0;
+
+  dprintf(fd,
+          "      sent: %u (%llu bytes)  max depth: %u  wait mean/max: %llu/%u "
+          "ms  late: %u\n",
+          p_stats->sent_pkts, (unsigned long long)p_stats->sent_bytes,
+          p_stats->max_depth, (unsigned long long)mean_wait_ms,
+          p_stats->max_wait_ms, p_stats->late_pkts);
+}
+
+/*******************************************************************************
+ *
+ *  Function        L2CA_Dump
+ *
+ *  Description     Dumps the scheduling weights of the links and channels and
+ *                  their queueing statistics.
+ *
+ *  Return value:   void
+ *
+ ******************************************************************************/
+void L2CA_Dump(int fd) {
+  dprintf(fd, "\nL2CAP scheduler:\n");
+#if (L2CAP_ROUND_ROBIN_CHANNEL_SERVICE == TRUE)
+  dprintf(fd, "  channel weights (high/medium/low): %u/%u/%u\n",
+          l2cb.drr_weight[L2CAP_CHNL_PRIORITY_HIGH],
+          l2cb.drr_weight[L2CAP_CHNL_PRIORITY_MEDIUM],
+          l2cb.drr_weight[L2CAP_CHNL_PRIORITY_LOW]);
+#endif
+  dprintf(fd, "  round robin quota: %u (LE: %u)\n", l2cb.round_robin_quota,
+          l2cb.ble_round_robin_quota);
+
+  for (int xx = 0; xx < MAX_L2CAP_LINKS; xx++) {
+    tL2C_LCB* p_lcb = &l2cb.lcb_pool[xx];
+    if (!p_lcb->in_use) continue;
+
+    dprintf(fd,
+            "  link %s  handle: 0x%04x  transport: %s  quota: %u  "
+            "priority: %u  latency target: %u ms\n",
+            p_lcb->remote_bd_addr.ToString().c_str(), p_lcb->handle,
+            p_lcb->transport == BT_TRANSPORT_LE ? "LE" : "BR/EDR",
+            p_lcb->link_xmit_quota, p_lcb->acl_priority,
+            p_lcb->drr.latency_target_ms);
+    l2c_dump_flow(fd, &p_lcb->drr);
+
+#if (L2CAP_NUM_FIXED_CHNLS > 0)
+    for (int yy = 0; yy < L2CAP_NUM_FIXED_CHNLS; yy++) {
+      tL2C_CCB* p_ccb = p_lcb->p_fixed_ccbs[yy];
+      if (p_ccb == NULL) continue;
+      dprintf(fd, "    fixed channel 0x%04x  depth: %zu\n", p_ccb->local_cid,
+              fixed_queue_length(p_ccb->xmit_hold_q));
+      l2c_dump_flow(fd, &p_ccb->drr);
+    }
+#endif
+
+    for (tL2C_CCB* p_ccb = p_lcb->ccb_queue.p_first_ccb; p_ccb;
+         p_ccb = p_ccb->p_next_ccb) {
+      dprintf(fd, "    channel 0x%04x  priority: %u  deficit: %d  depth: %zu\n",
+              p_ccb->local_cid, p_ccb->ccb_priority, p_ccb->drr.deficit,
+              fixed_queue_length(p_ccb->xmit_hold_q));
+      l2c_dump_flow(fd, &p_ccb->drr);
+    }
+  }
+}
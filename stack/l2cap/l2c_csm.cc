@@ -37,6 +37,7 @@
 #include "sdpint.h"
 #include "device/include/interop.h"
 #include "hci/include/btsnoop.h"
+#include "osi/include/time.h"
 
 /******************************************************************************/
 /*            L O C A L    F U N C T I O N     P R O T O T Y P E S            */
@@ -2424,15 +2425,14 @@ void l2c_enqueue_peer_data(tL2C_CCB* p_ccb, BT_HDR* p_buf) {
 
   l2cu_check_channel_congestion(p_ccb);
 
-#if (L2CAP_ROUND_ROBIN_CHANNEL_SERVICE == TRUE)
-  /* if new packet is higher priority than serving ccb and it is not overrun */
-  if ((p_ccb->p_lcb->rr_pri > p_ccb->ccb_priority) &&
-      (p_ccb->p_lcb->rr_serv[p_ccb->ccb_priority].quota > 0)) {
-    /* send out higher priority packet */
-    p_ccb->p_lcb->rr_pri = p_ccb->ccb_priority;
-  }
-#endif
+  /* The buffer waits for its channel, and the link for the round robin */
+  uint64_t now_ms = time_get_os_boottime_ms();
+  l2c_drr_enqueued(&p_ccb->drr, fixed_queue_length(p_ccb->xmit_hold_q),
+                   now_ms);
 
   /* if we are doing a round robin scheduling, set the flag */
-  if (p_ccb->p_lcb->link_xmit_quota == 0) l2cb.check_round_robin = true;
+  if (p_ccb->p_lcb->link_xmit_quota == 0) {
+    l2c_drr_enqueued(&p_ccb->p_lcb->drr, 0, now_ms);
+    l2cb.check_round_robin = true;
+  }
 }
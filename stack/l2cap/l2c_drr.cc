@@ -0,0 +1,113 @@
+/******************************************************************************
+ * Copyright (c) 2026 Qualcomm Innovation Center, Inc. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ *
+ *******************************************************************************/
+
+/******************************************************************************
+ *
+ *  This file contains the weighted deficit round robin used by L2CAP to
+ *  schedule links and channels.
+ *
+ ******************************************************************************/
+
+#include "l2c_drr.h"
+
+#include <string.h>
+
+void l2c_drr_init_flow(tL2C_DRR_FLOW* p_flow, uint32_t quantum) {
+  memset(p_flow, 0, sizeof(tL2C_DRR_FLOW));
+  p_flow->quantum = quantum;
+}
+
+void l2c_drr_enqueued(tL2C_DRR_FLOW* p_flow, uint32_t depth, uint64_t now_ms) {
+  if (p_flow->waiting_since_ms == 0) p_flow->waiting_since_ms = now_ms;
+  if (depth > p_flow->stats.max_depth) p_flow->stats.max_depth = depth;
+}
+
+int l2c_drr_select(tL2C_DRR_FLOW* const flows[], const bool ready[],
+                   int num_flows, int* p_cursor, uint64_t now_ms) {
+  int overdue = -1;
+  uint64_t most_late = 0;
+  bool any_ready = false;
+  int i;
+
+  /* A flow past its latency target goes first, the latest one first */
+  for (i = 0; i < num_flows; i++) {
+    tL2C_DRR_FLOW* p_flow = flows[i];
+    if (!ready[i]) continue;
+
+    any_ready = true;
+    if (p_flow->waiting_since_ms == 0) p_flow->waiting_since_ms = now_ms;
+    if (p_flow->latency_target_ms == 0) continue;
+
+    uint64_t wait = now_ms - p_flow->waiting_since_ms;
+    if (wait < p_flow->latency_target_ms) continue;
+    if (overdue < 0 || wait - p_flow->latency_target_ms > most_late) {
+      overdue = i;
+      most_late = wait - p_flow->latency_target_ms;
+    }
+  }
+
+  if (!any_ready) return -1;
+  if (overdue >= 0) return overdue;
+
+  /* The flow whose turn it is keeps it while it has credit */
+  i = *p_cursor;
+  if (i >= 0 && i < num_flows) {
+    if (ready[i] && flows[i]->deficit > 0) return i;
+    if (!ready[i] && flows[i]->deficit > 0) flows[i]->deficit = 0;
+  } else {
+    i = num_flows - 1;
+  }
+
+  /* Otherwise the turn moves on, giving a quantum to each ready flow it
+   * reaches, until one of them is out of debt */
+  for (int step = 0; step < num_flows * L2C_DRR_MAX_ROUNDS; step++) {
+    i = (i + 1) % num_flows;
+    if (!ready[i]) {
+      if (flows[i]->deficit > 0) flows[i]->deficit = 0;
+      continue;
+    }
+
+    flows[i]->deficit += flows[i]->quantum;
+    if (flows[i]->deficit > 0) {
+      *p_cursor = i;
+      return i;
+    }
+  }
+
+  /* Only flows deep in debt are ready, serve the next one anyway */
+  do {
+    i = (i + 1) % num_flows;
+  } while (!ready[i]);
+  *p_cursor = i;
+  return i;
+}
+
+void l2c_drr_charge(tL2C_DRR_FLOW* p_flow, uint16_t len, uint32_t depth,
+                    uint64_t now_ms) {
+  tL2C_DRR_STATS* p_stats = &p_flow->stats;
+
+  if (p_flow->waiting_since_ms != 0 && now_ms >= p_flow->waiting_since_ms) {
+    uint64_t wait = now_ms - p_flow->waiting_since_ms;
+
+    if (wait > p_stats->max_wait_ms) p_stats->max_wait_ms = (uint32_t)wait;
+    p_stats->total_wait_ms += wait;
+    if (p_flow->latency_target_ms != 0 && wait > p_flow->latency_target_ms)
+      p_stats->late_pkts++;
+  }
+
+  p_flow->deficit -= len;
+  p_stats->sent_pkts++;
+  p_stats->sent_bytes += len;
+
+  if (depth > 0) {
+    /* The next buffer waits from now */
+    p_flow->waiting_since_ms = now_ms;
+  } else {
+    /* An idle flow does not keep its credit */
+    p_flow->waiting_since_ms = 0;
+    if (p_flow->deficit > 0) p_flow->deficit = 0;
+  }
+}
@@ -0,0 +1,100 @@
+/******************************************************************************
+ * Copyright (c) 2026 Qualcomm Innovation Center, Inc. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ *
+ *******************************************************************************/
+
+/******************************************************************************
+ *
+ *  Weighted deficit round robin (DRR) used by L2CAP to share the ACL buffers
+ *  of the controller between links, and the link between its channels.
+ *
+ *  Every flow (a link or a channel) receives a quantum of bytes each time its
+ *  turn comes, and keeps the turn while its deficit is positive. A flow that
+ *  sends a buffer larger than its deficit goes into debt, which is paid back
+ *  from its next quanta, so the bandwidth share follows the quanta whatever
+ *  the packet sizes. A flow with nothing to send loses its unused credit.
+ *
+ *  A flow may also have a latency target: once it has been waiting longer
+ *  than its target it is served ahead of the round, and is charged as usual.
+ *
+ *  The code has no dependency on the rest of the stack so that it can be
+ *  exercised by a simulation.
+ *
+ ******************************************************************************/
+
+#ifndef L2C_DRR_H
+#define L2C_DRR_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/* Queueing statistics of a flow */
+typedef struct {
+  uint32_t max_depth;     /* Highest number of buffers queued */
+  uint32_t sent_pkts;     /* Buffers sent */
+  uint64_t sent_bytes;    /* Bytes sent */
+  uint32_t max_wait_ms;   /* Longest time waiting for service */
+  uint64_t total_wait_ms; /* Sum of the waits, one per buffer sent */
+  uint32_t late_pkts;     /* Buffers sent after the latency target */
+} tL2C_DRR_STATS;
+
+typedef struct {
+  int32_t deficit;            /* Bytes the flow may still send in its turn */
+  uint32_t quantum;           /* Bytes added to the deficit at each turn */
+  uint32_t latency_target_ms; /* Longest wait before preemption, 0 if none */
+  uint64_t waiting_since_ms;  /* Start of the current wait, 0 if not waiting */
+  tL2C_DRR_STATS stats;
+} tL2C_DRR_FLOW;
+
+/* Most rounds scanned by l2c_drr_select() to find a flow out of debt */
+#define L2C_DRR_MAX_ROUNDS 64
+
+/*******************************************************************************
+ *
+ * Function         l2c_drr_init_flow
+ *
+ * Description      Resets the flow and its statistics.
+ *
+ ******************************************************************************/
+extern void l2c_drr_init_flow(tL2C_DRR_FLOW* p_flow, uint32_t quantum);
+
+/*******************************************************************************
+ *
+ * Function         l2c_drr_enqueued
+ *
+ * Description      Notes that the flow has |depth| buffers queued. The wait of
+ *                  the flow starts now unless it was already waiting.
+ *
+ ******************************************************************************/
+extern void l2c_drr_enqueued(tL2C_DRR_FLOW* p_flow, uint32_t depth,
+                             uint64_t now_ms);
+
+/*******************************************************************************
+ *
+ * Function         l2c_drr_select
+ *
+ * Description      Selects the flow to serve among |num_flows| flows, given
+ *                  which ones have data ready. |*p_cursor| is the index of the
+ *                  flow whose turn it is, or -1 to start with the first flow;
+ *                  it is updated when the turn moves. A flow preempting the
+ *                  round for its latency target does not take the turn.
+ *
+ * Returns          Index of the flow to serve, -1 if no flow is ready
+ *
+ ******************************************************************************/
+extern int l2c_drr_select(tL2C_DRR_FLOW* const flows[], const bool ready[],
+                          int num_flows, int* p_cursor, uint64_t now_ms);
+
+/*******************************************************************************
+ *
+ * Function         l2c_drr_charge
+ *
+ * Description      Charges the flow for a buffer of |len| bytes just sent,
+ *                  |depth| being the number of buffers still queued.
+ *
+ ******************************************************************************/
+extern void l2c_drr_charge(tL2C_DRR_FLOW* p_flow, uint16_t len, uint32_t depth,
+                           uint64_t now_ms);
+
+#endif /* L2C_DRR_H */
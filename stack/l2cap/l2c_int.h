@@ -66,6 +66,7 @@
 #include "btm_api.h"
 #include "btm_ble_api.h"
 #include "l2c_api.h"
+#include "l2c_drr.h"
 #include "l2cdefs.h"
 #include "osi/include/alarm.h"
 #include "osi/include/fixed_queue.h"
@@ -449,6 +450,7 @@ typedef struct t_l2c_ccb {
   uint16_t buff_quota;        /* Buffer quota before sending congestion */
 
   tL2CAP_CHNL_PRIORITY ccb_priority;  /* Channel priority */
+  tL2C_DRR_FLOW drr;                  /* Scheduling of the channel in its link */
   tL2CAP_CHNL_DATA_RATE tx_data_rate; /* Channel Tx data rate */
   tL2CAP_CHNL_DATA_RATE rx_data_rate; /* Channel Rx data rate */
 
@@ -510,21 +512,29 @@ typedef struct {
 #define L2CAP_GET_PRIORITY_QUOTA(pri) \
   ((L2CAP_NUM_CHNL_PRIORITY - (pri)) * L2CAP_CHNL_PRIORITY_WEIGHT)
 
-/* CCBs within the same LCB are served in round robin with priority It will make
- * sure that low priority channel (for example, HF signaling on RFCOMM) can be
- * sent to the headset even if higher priority channel (for example, AV media
- * channel) is congested.
+/* CCBs within the same LCB are served in weighted deficit round robin, the
+ * weight of a channel coming from its priority. It will make sure that low
+ * priority channel (for example, HF signaling on RFCOMM) can be sent to the
+ * headset even if higher priority channel (for example, AV media channel) is
+ * congested.
+ *
+ * The default weights are the burst quotas of the priorities, they can be
+ * overridden with "high,medium,low" in the property below.
  */
-
-typedef struct {
-  tL2C_CCB* p_serve_ccb; /* current serving ccb within priority group */
-  tL2C_CCB* p_first_ccb; /* first ccb of priority group */
-  uint8_t num_ccb;       /* number of channels in priority group */
-  uint8_t quota;         /* burst transmission quota */
-} tL2C_RR_SERV;
+#define L2CAP_DRR_WEIGHTS_PROPERTY "persist.vendor.bluetooth.l2cap.drr_weights"
+#define L2CAP_DRR_MAX_WEIGHT 64
 
 #endif /* (L2CAP_ROUND_ROBIN_CHANNEL_SERVICE == TRUE) */
 
+/* Bytes of quantum per unit of weight, about one ACL packet */
+#define L2CAP_DRR_QUANTUM_UNIT 1021
+
+/* Links sharing the round robin quota are served in weighted deficit round
+ * robin too, high priority links with twice the weight of the others.
+ */
+#define L2CAP_DRR_LINK_WEIGHT(acl_priority) \
+  (((acl_priority) == L2CAP_PRIORITY_HIGH) ? 2 : 1)
+
 /* Define a link control block. There is one link control block between
  * this device and any other device (i.e. BD ADDR).
 */
@@ -620,11 +630,9 @@ typedef struct t_l2c_linkcb {
   uint8_t subrate_req_mask;
 
 #if (L2CAP_ROUND_ROBIN_CHANNEL_SERVICE == TRUE)
-  /* each priority group is limited burst transmission */
-  /* round robin service for the same priority channels */
-  tL2C_RR_SERV rr_serv[L2CAP_NUM_CHNL_PRIORITY];
-  uint8_t rr_pri; /* current serving priority group */
+  tL2C_CCB* p_drr_ccb; /* channel whose turn it is, NULL for the first one */
 #endif
+  tL2C_DRR_FLOW drr; /* Scheduling of the link in the round robin quota */
 } tL2C_LCB;
 
 /* Define the L2CAP control structure
@@ -636,6 +644,10 @@ typedef struct {
   uint16_t round_robin_quota;   /* Round-robin link quota */
   uint16_t round_robin_unacked; /* Round-robin unacked */
   bool check_round_robin;       /* Do a round robin check */
+  int drr_link_cursor;          /* Link whose turn it is, -1 for the first */
+#if (L2CAP_ROUND_ROBIN_CHANNEL_SERVICE == TRUE)
+  uint16_t drr_weight[L2CAP_NUM_CHNL_PRIORITY]; /* Channel weight by priority */
+#endif
 
   bool is_cong_cback_context;
 
@@ -43,6 +43,7 @@
 #include "l2cdefs.h"
 #include "log/log.h"
 #include "osi/include/osi.h"
+#include "osi/include/time.h"
 #include "device/include/device_iot_config.h"
 #include "btif/include/btif_av.h"
 
@@ -1055,6 +1056,74 @@ bool l2c_link_check_power_mode(tL2C_LCB* p_lcb) {
 }
 #endif /* L2CAP_WAKE_PARKED_LINK == TRUE) */
 
+/*******************************************************************************
+ *
+ * Function         l2c_link_queue_depth
+ *
+ * Description      This function returns the number of buffers queued on a
+ *                  link, in the link queue and in the queues of its channels.
+ *
+ * Returns          number of buffers
+ *
+ ******************************************************************************/
+static uint32_t l2c_link_queue_depth(tL2C_LCB* p_lcb) {
+  tL2C_CCB* p_ccb;
+  uint32_t depth = list_length(p_lcb->link_xmit_data_q);
+
+  for (p_ccb = p_lcb->ccb_queue.p_first_ccb; p_ccb; p_ccb = p_ccb->p_next_ccb)
+    depth += fixed_queue_length(p_ccb->xmit_hold_q) +
+             fixed_queue_length(p_ccb->fcrb.retrans_q);
+
+#if (L2CAP_NUM_FIXED_CHNLS > 0)
+  for (int xx = 0; xx < L2CAP_NUM_FIXED_CHNLS; xx++) {
+    p_ccb = p_lcb->p_fixed_ccbs[xx];
+    if (p_ccb == NULL) continue;
+    depth += fixed_queue_length(p_ccb->xmit_hold_q) +
+             fixed_queue_length(p_ccb->fcrb.retrans_q);
+  }
+#endif
+
+  return depth;
+}
+
+/*******************************************************************************
+ *
+ * Function         l2c_link_rr_backlog
+ *
+ * Description      This function returns the number of buffers a link sharing
+ *                  the round robin quota could send now. With |single_write|
+ *                  only the buffers of the link queue are counted.
+ *
+ * Returns          number of buffers, 0 if the link cannot send
+ *
+ ******************************************************************************/
+static uint32_t l2c_link_rr_backlog(tL2C_LCB* p_lcb, bool single_write) {
+  uint32_t depth;
+
+  if ((!p_lcb->in_use) || (p_lcb->partial_segment_being_sent) ||
+      (p_lcb->link_state != LST_CONNECTED) || (p_lcb->link_xmit_quota != 0))
+    return 0;
+
+  /* If controller window is full, nothing to do */
+  if (p_lcb->transport == BT_TRANSPORT_LE) {
+    if (l2cb.controller_le_xmit_window == 0 ||
+        l2cb.ble_round_robin_unacked >= l2cb.ble_round_robin_quota)
+      return 0;
+  } else {
+    if (l2cb.controller_xmit_window == 0 ||
+        l2cb.round_robin_unacked >= l2cb.round_robin_quota)
+      return 0;
+  }
+
+  if (single_write)
+    depth = list_length(p_lcb->link_xmit_data_q);
+  else
+    depth = l2c_link_queue_depth(p_lcb);
+
+  if (depth == 0 || L2C_LINK_CHECK_POWER_MODE(p_lcb)) return 0;
+  return depth;
+}
+
 /*******************************************************************************
  *
  * Function         l2c_link_check_send_pkts
@@ -1099,58 +1168,70 @@ void l2c_link_check_send_pkts(tL2C_LCB* p_lcb, tL2C_CCB* p_ccb, BT_HDR* p_buf) {
   ** have at least 1, then do a round-robin for all the LCBs
   */
   if ((p_lcb == NULL) || (p_lcb->link_xmit_quota == 0)) {
-    if (p_lcb == NULL)
-      p_lcb = l2cb.lcb_pool;
-    else if (!single_write)
-      p_lcb++;
-
-    /* Loop through, starting at the next */
-    for (xx = 0; xx < MAX_L2CAP_LINKS; xx++, p_lcb++) {
-      /* Check for wraparound */
-      if (p_lcb == &l2cb.lcb_pool[MAX_L2CAP_LINKS]) p_lcb = &l2cb.lcb_pool[0];
-
-      /* If controller window is full, nothing to do */
-      if (((l2cb.controller_xmit_window == 0 ||
-            (l2cb.round_robin_unacked >= l2cb.round_robin_quota)) &&
-           (p_lcb->transport == BT_TRANSPORT_BR_EDR)) ||
-          (p_lcb->transport == BT_TRANSPORT_LE &&
-           (l2cb.ble_round_robin_unacked >= l2cb.ble_round_robin_quota ||
-            l2cb.controller_le_xmit_window == 0)))
-        continue;
-
-      if ((!p_lcb->in_use) || (p_lcb->partial_segment_being_sent) ||
-          (p_lcb->link_state != LST_CONNECTED) ||
-          (p_lcb->link_xmit_quota != 0) || (L2C_LINK_CHECK_POWER_MODE(p_lcb)))
-        continue;
-
-      /* See if we can send anything from the Link Queue */
+    tL2C_DRR_FLOW* flows[MAX_L2CAP_LINKS];
+    bool ready[MAX_L2CAP_LINKS];
+    bool stalled[MAX_L2CAP_LINKS] = {false};
+    bool drained = false;
+    int sent = 0;
+
+    /* Serve the links in weighted deficit round robin, one buffer at a time
+     * and as many buffers as there are links */
+    while (sent < MAX_L2CAP_LINKS) {
+      uint64_t now_ms = time_get_os_boottime_ms();
+
+      for (xx = 0; xx < MAX_L2CAP_LINKS; xx++) {
+        tL2C_LCB* p_rr_lcb = &l2cb.lcb_pool[xx];
+        uint32_t depth =
+            stalled[xx] ? 0 : l2c_link_rr_backlog(p_rr_lcb, single_write);
+
+        flows[xx] = &p_rr_lcb->drr;
+        ready[xx] = (depth > 0);
+        if (!ready[xx]) continue;
+
+        p_rr_lcb->drr.quantum =
+            L2CAP_DRR_LINK_WEIGHT(p_rr_lcb->acl_priority) *
+            L2CAP_DRR_QUANTUM_UNIT;
+        l2c_drr_enqueued(&p_rr_lcb->drr, depth, now_ms);
+      }
+
+      xx = l2c_drr_select(flows, ready, MAX_L2CAP_LINKS, &l2cb.drr_link_cursor,
+                          now_ms);
+      if (xx < 0) {
+        drained = true;
+        break;
+      }
+      p_lcb = &l2cb.lcb_pool[xx];
+
+      /* See if we can send anything from the Link Queue, else check the
+       * channel queue */
+      tL2C_TX_COMPLETE_CB_INFO cbi;
+      tL2C_TX_COMPLETE_CB_INFO* p_cbi = NULL;
       if (!list_is_empty(p_lcb->link_xmit_data_q)) {
         p_buf = (BT_HDR*)list_front(p_lcb->link_xmit_data_q);
         list_remove(p_lcb->link_xmit_data_q, p_buf);
-        l2c_link_send_to_lower(p_lcb, p_buf, NULL);
-      } else if (single_write) {
-        /* If only doing one write, break out */
-        break;
-      }
-      /* If nothing on the link queue, check the channel queue */
-      else {
-        tL2C_TX_COMPLETE_CB_INFO cbi;
+      } else {
         p_buf = l2cu_get_next_buffer_to_send(p_lcb, &cbi);
-        if (p_buf != NULL) {
-          l2c_link_send_to_lower(p_lcb, p_buf, &cbi);
+        if (p_buf == NULL) {
+          /* Its channels are flow controlled */
+          stalled[xx] = true;
+          continue;
         }
+        p_cbi = &cbi;
       }
+
+      uint16_t len = p_buf->len;
+      l2c_link_send_to_lower(p_lcb, p_buf, p_cbi);
+      l2c_drr_charge(&p_lcb->drr, len, l2c_link_queue_depth(p_lcb), now_ms);
+      sent++;
     }
 
     /* If we finished without using up our quota, no need for a safety check */
-    if ((l2cb.controller_xmit_window > 0) &&
-        (l2cb.round_robin_unacked < l2cb.round_robin_quota) &&
-        (p_lcb->transport == BT_TRANSPORT_BR_EDR))
+    if (drained && (l2cb.controller_xmit_window > 0) &&
+        (l2cb.round_robin_unacked < l2cb.round_robin_quota))
       l2cb.check_round_robin = false;
 
-    if ((l2cb.controller_le_xmit_window > 0) &&
-        (l2cb.ble_round_robin_unacked < l2cb.ble_round_robin_quota) &&
-        (p_lcb->transport == BT_TRANSPORT_LE))
+    if (drained && (l2cb.controller_le_xmit_window > 0) &&
+        (l2cb.ble_round_robin_unacked < l2cb.ble_round_robin_quota))
       l2cb.ble_check_round_robin = false;
   } else /* if this is not round-robin service */
   {
@@ -38,12 +38,14 @@
 #include "device/include/controller.h"
 #include "hci/include/btsnoop.h"
 #include "hcimsgs.h"
+#include "l2c_acl_chain.h"
 #include "l2c_api.h"
 #include "l2c_int.h"
 #include "l2cdefs.h"
 #include "stack_config.h"
 #include "osi/include/log.h"
 #include "osi/include/osi.h"
+#include "osi/include/properties.h"
 #if (OFF_TARGET_TEST_ENABLED == TRUE)
 #include "linux_include/log/log.h"
 #endif
@@ -69,7 +71,7 @@ tL2C_CB l2cb;
  *
  ******************************************************************************/
 void l2c_rcv_acl_data(BT_HDR* p_msg) {
-  uint8_t* p = (uint8_t*)(p_msg + 1) + p_msg->offset;
+  uint8_t* p = l2c_acl_chain_headers(p_msg);
   uint16_t handle, hci_len;
   uint8_t pkt_type;
   tL2C_LCB* p_lcb;
@@ -90,6 +92,11 @@ void l2c_rcv_acl_data(BT_HDR* p_msg) {
     if (p_lcb == NULL) {
       uint8_t cmd_code;
 
+      /* The command code may be past the headers, and a held packet is
+       * processed again later */
+      p_msg = l2c_acl_chain_flatten(p_msg);
+      p = (uint8_t*)(p_msg + 1) + p_msg->offset + 2;
+
       /* There is a slight possibility (specifically with USB) that we get an */
       /* L2CAP connection request before we get the HCI connection complete.  */
       /* So for these types of messages, hold them for up to 2 seconds.       */
@@ -138,7 +145,7 @@ void l2c_rcv_acl_data(BT_HDR* p_msg) {
   } else {
     L2CAP_TRACE_WARNING("L2CAP - expected pkt start or complete, got: %d",
                         pkt_type);
-    osi_free(p_msg);
+    l2c_acl_chain_free(p_msg);
     return;
   }
 
@@ -149,7 +156,7 @@ void l2c_rcv_acl_data(BT_HDR* p_msg) {
   if (hci_len < L2CAP_PKT_OVERHEAD) {
     /* Must receive at least the L2CAP length and CID */
     L2CAP_TRACE_WARNING("L2CAP - got incorrect hci header");
-    osi_free(p_msg);
+    l2c_acl_chain_free(p_msg);
     return;
   }
 
@@ -158,7 +165,7 @@ void l2c_rcv_acl_data(BT_HDR* p_msg) {
   if (l2cap_len == 0) {
     L2CAP_TRACE_WARNING(" %s: received empty L2CAP packet on handle: %d",
         __func__, handle);
-    osi_free(p_msg);
+    l2c_acl_chain_free(p_msg);
     return;
   }
   STREAM_TO_UINT16(rcv_cid, p);
@@ -176,7 +183,7 @@ void l2c_rcv_acl_data(BT_HDR* p_msg) {
     p_ccb = l2cu_find_ccb_by_cid(p_lcb, rcv_cid);
     if (p_ccb == NULL) {
       L2CAP_TRACE_WARNING("L2CAP - unknown CID: 0x%04x", rcv_cid);
-      osi_free(p_msg);
+      l2c_acl_chain_free(p_msg);
       return;
     }
   }
@@ -188,10 +195,15 @@ void l2c_rcv_acl_data(BT_HDR* p_msg) {
     L2CAP_TRACE_WARNING("L2CAP - bad length in pkt. Exp: %d  Act: %d",
                         l2cap_len, p_msg->len);
 
-    osi_free(p_msg);
+    l2c_acl_chain_free(p_msg);
     return;
   }
 
+  /* The channels parse the packet in place, so one still in the fragments it
+   * was received in is copied into a single buffer now */
+  p_msg = l2c_acl_chain_flatten(p_msg);
+  p = (uint8_t*)(p_msg + 1) + p_msg->offset;
+
   /* Send the data through the channel state machine */
   if (rcv_cid == L2CAP_SIGNALLING_CID) {
     process_l2cap_cmd(p_lcb, p, l2cap_len);
@@ -1173,6 +1185,48 @@ void l2c_process_held_packets(bool timed_out) {
   }
 }
 
+#if (L2CAP_ROUND_ROBIN_CHANNEL_SERVICE == TRUE)
+/*******************************************************************************
+ *
+ * Function         l2c_load_drr_weights
+ *
+ * Description      Loads the round robin weights of the channel priorities,
+ *                  given as "high,medium,low" in L2CAP_DRR_WEIGHTS_PROPERTY.
+ *
+ * Returns          void
+ *
+ ******************************************************************************/
+static void l2c_load_drr_weights(void) {
+  char value[PROPERTY_VALUE_MAX] = {0};
+  int weights[L2CAP_NUM_CHNL_PRIORITY];
+  int pri;
+
+  for (pri = 0; pri < L2CAP_NUM_CHNL_PRIORITY; pri++)
+    l2cb.drr_weight[pri] = L2CAP_GET_PRIORITY_QUOTA(pri);
+
+  if (osi_property_get(L2CAP_DRR_WEIGHTS_PROPERTY, value, "") <= 0) return;
+
+  if (sscanf(value, "%d,%d,%d", &weights[L2CAP_CHNL_PRIORITY_HIGH],
+             &weights[L2CAP_CHNL_PRIORITY_MEDIUM],
+             &weights[L2CAP_CHNL_PRIORITY_LOW]) != L2CAP_NUM_CHNL_PRIORITY) {
+    L2CAP_TRACE_WARNING("%s: ignoring malformed weights \"%s\"", __func__,
+                        value);
+    return;
+  }
+
+  for (pri = 0; pri < L2CAP_NUM_CHNL_PRIORITY; pri++) {
+    if (weights[pri] < 1 || weights[pri] > L2CAP_DRR_MAX_WEIGHT) {
+      L2CAP_TRACE_WARNING("%s: ignoring out of range weights \"%s\"",
+                          __func__, value);
+      return;
+    }
+  }
+
+  for (pri = 0; pri < L2CAP_NUM_CHNL_PRIORITY; pri++)
+    l2cb.drr_weight[pri] = weights[pri];
+}
+#endif
+
 /*******************************************************************************
  *
  * Function         l2c_init
@@ -1224,6 +1278,12 @@ void l2c_init(void) {
   /* Set the default idle timeout */
   l2cb.idle_timeout = L2CAP_LINK_INACTIVITY_TOUT;
 
+  /* Scheduling of the links and of their channels */
+  l2cb.drr_link_cursor = -1;
+#if (L2CAP_ROUND_ROBIN_CHANNEL_SERVICE == TRUE)
+  l2c_load_drr_weights();
+#endif
+
 #if defined(L2CAP_INITIAL_TRACE_LEVEL)
   l2cb.l2cap_trace_level = L2CAP_INITIAL_TRACE_LEVEL;
 #else
@@ -1311,21 +1311,9 @@ void l2cu_enqueue_ccb(tL2C_CCB* p_ccb) {
   }
 
 #if (L2CAP_ROUND_ROBIN_CHANNEL_SERVICE == TRUE)
-  /* Adding CCB into round robin service table of its LCB */
-  if (p_ccb->p_lcb != NULL) {
-    /* if this is the first channel in this priority group */
-    if (p_ccb->p_lcb->rr_serv[p_ccb->ccb_priority].num_ccb == 0) {
-      /* Set the first channel to this CCB */
-      p_ccb->p_lcb->rr_serv[p_ccb->ccb_priority].p_first_ccb = p_ccb;
-      /* Set the next serving channel in this group to this CCB */
-      p_ccb->p_lcb->rr_serv[p_ccb->ccb_priority].p_serve_ccb = p_ccb;
-      /* Initialize quota of this priority group based on its priority */
-      p_ccb->p_lcb->rr_serv[p_ccb->ccb_priority].quota =
-          L2CAP_GET_PRIORITY_QUOTA(p_ccb->ccb_priority);
-    }
-    /* increase number of channels in this group */
-    p_ccb->p_lcb->rr_serv[p_ccb->ccb_priority].num_ccb++;
-  }
+  /* The quantum of the channel follows its priority */
+  p_ccb->drr.quantum =
+      l2cb.drr_weight[p_ccb->ccb_priority] * L2CAP_DRR_QUANTUM_UNIT;
 #endif
 }
 
@@ -1357,29 +1345,10 @@ void l2cu_dequeue_ccb(tL2C_CCB* p_ccb) {
   }
 
 #if (L2CAP_ROUND_ROBIN_CHANNEL_SERVICE == TRUE)
-  /* Removing CCB from round robin service table of its LCB */
-  if (p_ccb->p_lcb != NULL) {
-    /* decrease number of channels in this priority group */
-    p_ccb->p_lcb->rr_serv[p_ccb->ccb_priority].num_ccb--;
-
-    /* if it was the last channel in the priority group */
-    if (p_ccb->p_lcb->rr_serv[p_ccb->ccb_priority].num_ccb == 0) {
-      p_ccb->p_lcb->rr_serv[p_ccb->ccb_priority].p_first_ccb = NULL;
-      p_ccb->p_lcb->rr_serv[p_ccb->ccb_priority].p_serve_ccb = NULL;
-    } else {
-      /* if it is the first channel of this group */
-      if (p_ccb->p_lcb->rr_serv[p_ccb->ccb_priority].p_first_ccb == p_ccb) {
-        p_ccb->p_lcb->rr_serv[p_ccb->ccb_priority].p_first_ccb =
-            p_ccb->p_next_ccb;
-      }
-      /* if it is the next serving channel of this group */
-      if (p_ccb->p_lcb->rr_serv[p_ccb->ccb_priority].p_serve_ccb == p_ccb) {
-        /* simply, start serving from the first channel */
-        p_ccb->p_lcb->rr_serv[p_ccb->ccb_priority].p_serve_ccb =
-            p_ccb->p_lcb->rr_serv[p_ccb->ccb_priority].p_first_ccb;
-      }
-    }
-  }
+  /* If it is the channel whose turn it is, the turn goes on from the previous
+   * one */
+  if (p_ccb->p_lcb->p_drr_ccb == p_ccb)
+    p_ccb->p_lcb->p_drr_ccb = p_ccb->p_prev_ccb;
 #endif
 
   if (p_ccb == p_q->p_first_ccb) {
@@ -1427,18 +1396,9 @@ void l2cu_change_pri_ccb(tL2C_CCB* p_ccb, tL2CAP_CHNL_PRIORITY priority) {
 #if (L2CAP_ROUND_ROBIN_CHANNEL_SERVICE == TRUE)
     else {
       /* If CCB is the only guy on the queue, no need to re-enqueue */
-      /* update only round robin service data */
-      p_ccb->p_lcb->rr_serv[p_ccb->ccb_priority].num_ccb = 0;
-      p_ccb->p_lcb->rr_serv[p_ccb->ccb_priority].p_first_ccb = NULL;
-      p_ccb->p_lcb->rr_serv[p_ccb->ccb_priority].p_serve_ccb = NULL;
-
+      /* update only its quantum */
       p_ccb->ccb_priority = priority;
-
-      p_ccb->p_lcb->rr_serv[p_ccb->ccb_priority].p_first_ccb = p_ccb;
-      p_ccb->p_lcb->rr_serv[p_ccb->ccb_priority].p_serve_ccb = p_ccb;
-      p_ccb->p_lcb->rr_serv[p_ccb->ccb_priority].quota =
-          L2CAP_GET_PRIORITY_QUOTA(p_ccb->ccb_priority);
-      p_ccb->p_lcb->rr_serv[p_ccb->ccb_priority].num_ccb = 1;
+      p_ccb->drr.quantum = l2cb.drr_weight[priority] * L2CAP_DRR_QUANTUM_UNIT;
     }
 #endif
   }
@@ -1561,6 +1521,7 @@ tL2C_CCB* l2cu_allocate_ccb(tL2C_LCB* p_lcb, uint16_t cid) {
 
   /* Set priority then insert ccb into LCB queue (if we have an LCB) */
   p_ccb->ccb_priority = L2CAP_CHNL_PRIORITY_LOW;
+  l2c_drr_init_flow(&p_ccb->drr, 0);
 
   if (p_lcb) l2cu_enqueue_ccb(p_ccb);
 
@@ -3404,99 +3365,79 @@ tL2C_CCB* l2cu_find_ccb_by_cid(tL2C_LCB* p_lcb, uint16_t local_cid) {
 
 /******************************************************************************
  *
- * Function         l2cu_get_next_channel_in_rr
+ * Function         l2cu_ccb_ready_to_send
  *
- * Description      get the next channel to send on a link. It also adjusts the
- *                  CCB queue to do a basic priority and round-robin scheduling.
+ * Description      check whether a channel can send a buffer now.
  *
- * Returns          pointer to CCB or NULL
+ * Returns          true if the channel has a buffer it may send
  *
  ******************************************************************************/
-static tL2C_CCB* l2cu_get_next_channel_in_rr(tL2C_LCB* p_lcb) {
-  tL2C_CCB* p_serve_ccb = NULL;
-  tL2C_CCB* p_ccb;
+static bool l2cu_ccb_ready_to_send(tL2C_CCB* p_ccb) {
+  if (p_ccb->chnl_state != CST_OPEN) return false;
 
-  int i, j;
-
-  /* scan all of priority until finding a channel to serve */
-  for (i = 0; (i < L2CAP_NUM_CHNL_PRIORITY) && (!p_serve_ccb); i++) {
-    /* scan all channel within serving priority group until finding a channel to
-     * serve */
-    for (j = 0; (j < p_lcb->rr_serv[p_lcb->rr_pri].num_ccb) && (!p_serve_ccb);
-         j++) {
-      /* scaning from next serving channel */
-      p_ccb = p_lcb->rr_serv[p_lcb->rr_pri].p_serve_ccb;
-
-      if (!p_ccb) {
-        L2CAP_TRACE_ERROR("p_serve_ccb is NULL, rr_pri=%d", p_lcb->rr_pri);
-        return NULL;
-      }
-
-      L2CAP_TRACE_DEBUG("RR scan pri=%d, lcid=0x%04x, q_cout=%d",
-                        p_ccb->ccb_priority, p_ccb->local_cid,
-                        fixed_queue_length(p_ccb->xmit_hold_q));
-
-      /* store the next serving channel */
-      /* this channel is the last channel of its priority group */
-      if ((p_ccb->p_next_ccb == NULL) ||
-          (p_ccb->p_next_ccb->ccb_priority != p_ccb->ccb_priority)) {
-        /* next serving channel is set to the first channel in the group */
-        p_lcb->rr_serv[p_lcb->rr_pri].p_serve_ccb =
-            p_lcb->rr_serv[p_lcb->rr_pri].p_first_ccb;
-      } else {
-        /* next serving channel is set to the next channel in the group */
-        p_lcb->rr_serv[p_lcb->rr_pri].p_serve_ccb = p_ccb->p_next_ccb;
-      }
-
-      if (p_ccb->chnl_state != CST_OPEN) continue;
+  if (p_ccb->p_lcb->transport == BT_TRANSPORT_LE ||
+      p_ccb->peer_cfg.fcr.mode == L2CAP_FCR_ECFC_MODE) {
+    /* Connection oriented channel, without credits it would block the link */
+    return !fixed_queue_is_empty(p_ccb->xmit_hold_q) &&
+           p_ccb->peer_conn_cfg.credits != 0;
+  }
 
-      if (p_ccb->p_lcb->transport == BT_TRANSPORT_LE) {
-        L2CAP_TRACE_DEBUG("%s : Connection oriented channel", __func__);
-        if (fixed_queue_is_empty(p_ccb->xmit_hold_q)) continue;
+  /* eL2CAP option in use */
+  if (p_ccb->peer_cfg.fcr.mode != L2CAP_FCR_BASIC_MODE) {
+    if (p_ccb->fcrb.wait_ack || p_ccb->fcrb.remote_busy) return false;
 
-      } else {
-        /* eL2CAP option in use */
-        if (p_ccb->peer_cfg.fcr.mode != L2CAP_FCR_BASIC_MODE) {
-          if (p_ccb->fcrb.wait_ack || p_ccb->fcrb.remote_busy) continue;
+    if (fixed_queue_is_empty(p_ccb->fcrb.retrans_q)) {
+      if (fixed_queue_is_empty(p_ccb->xmit_hold_q)) return false;
 
-          if (fixed_queue_is_empty(p_ccb->fcrb.retrans_q)) {
-            if (fixed_queue_is_empty(p_ccb->xmit_hold_q)) continue;
+      /* If in eRTM mode, check for window closure */
+      if ((p_ccb->peer_cfg.fcr.mode == L2CAP_FCR_ERTM_MODE) &&
+          (l2c_fcr_is_flow_controlled(p_ccb)))
+        return false;
+    }
+    return true;
+  }
 
-            /* If in eRTM mode, check for window closure */
-            if ((p_ccb->peer_cfg.fcr.mode == L2CAP_FCR_ERTM_MODE) &&
-                (l2c_fcr_is_flow_controlled(p_ccb)))
-              continue;
-          }
-        } else {
-          if (fixed_queue_is_empty(p_ccb->xmit_hold_q)) continue;
-        }
-      }
+  return !fixed_queue_is_empty(p_ccb->xmit_hold_q);
+}
 
-      /* found a channel to serve */
-      p_serve_ccb = p_ccb;
-      /* decrease quota of its priority group */
-      p_lcb->rr_serv[p_lcb->rr_pri].quota--;
-    }
+/******************************************************************************
+ *
+ * Function         l2cu_get_next_channel_in_rr
+ *
+ * Description      get the next channel to send on a link. The channels are
+ *                  served in weighted deficit round robin, so that each one
+ *                  gets a share of the link following its priority, whatever
+ *                  the size of its buffers.
+ *
+ * Returns          pointer to CCB or NULL
+ *
+ ******************************************************************************/
+static tL2C_CCB* l2cu_get_next_channel_in_rr(tL2C_LCB* p_lcb) {
+  tL2C_CCB* ccbs[MAX_L2CAP_CHANNELS];
+  tL2C_DRR_FLOW* flows[MAX_L2CAP_CHANNELS];
+  bool ready[MAX_L2CAP_CHANNELS];
+  int num_ccbs = 0;
+  int cursor = -1;
+  tL2C_CCB* p_ccb;
 
-    /* if there is no more quota of the priority group or no channel to have
-     * data to send */
-    if ((p_lcb->rr_serv[p_lcb->rr_pri].quota == 0) || (!p_serve_ccb)) {
-      /* serve next priority group */
-      p_lcb->rr_pri = (p_lcb->rr_pri + 1) % L2CAP_NUM_CHNL_PRIORITY;
-      /* initialize its quota */
-      p_lcb->rr_serv[p_lcb->rr_pri].quota =
-          L2CAP_GET_PRIORITY_QUOTA(p_lcb->rr_pri);
-    }
+  for (p_ccb = p_lcb->ccb_queue.p_first_ccb;
+       p_ccb && num_ccbs < MAX_L2CAP_CHANNELS; p_ccb = p_ccb->p_next_ccb) {
+    if (p_ccb == p_lcb->p_drr_ccb) cursor = num_ccbs;
+    ccbs[num_ccbs] = p_ccb;
+    flows[num_ccbs] = &p_ccb->drr;
+    ready[num_ccbs] = l2cu_ccb_ready_to_send(p_ccb);
+    num_ccbs++;
   }
 
-  if (p_serve_ccb) {
-    L2CAP_TRACE_DEBUG("RR service pri=%d, quota=%d, lcid=0x%04x",
-                      p_serve_ccb->ccb_priority,
-                      p_lcb->rr_serv[p_serve_ccb->ccb_priority].quota,
-                      p_serve_ccb->local_cid);
-  }
+  int serve = l2c_drr_select(flows, ready, num_ccbs, &cursor,
+                             time_get_os_boottime_ms());
+  if (cursor >= 0) p_lcb->p_drr_ccb = ccbs[cursor];
+  if (serve < 0) return NULL;
 
-  return p_serve_ccb;
+  p_ccb = ccbs[serve];
+  L2CAP_TRACE_DEBUG("DRR service pri=%d, deficit=%d, lcid=0x%04x",
+                    p_ccb->ccb_priority, p_ccb->drr.deficit, p_ccb->local_cid);
+  return p_ccb;
 }
 
 #else  /* (L2CAP_ROUND_ROBIN_CHANNEL_SERVICE == TRUE) */
@@ -3542,6 +3483,23 @@ void l2cu_tx_complete(tL2C_TX_COMPLETE_CB_INFO* p_cbi) {
   if (p_cbi->cb != NULL) p_cbi->cb(p_cbi->local_cid, p_cbi->num_sdu);
 }
 
+/******************************************************************************
+ *
+ * Function         l2cu_charge_ccb
+ *
+ * Description      account a buffer about to be sent on a channel, for its
+ *                  scheduling and its queueing statistics.
+ *
+ * Returns          void
+ *
+ ******************************************************************************/
+static void l2cu_charge_ccb(tL2C_CCB* p_ccb, BT_HDR* p_buf) {
+  uint32_t depth = fixed_queue_length(p_ccb->xmit_hold_q) +
+                   fixed_queue_length(p_ccb->fcrb.retrans_q);
+
+  l2c_drr_charge(&p_ccb->drr, p_buf->len, depth, time_get_os_boottime_ms());
+}
+
 /******************************************************************************
  *
  * Function         l2cu_get_next_buffer_to_send
@@ -3583,6 +3541,7 @@ BT_HDR* l2cu_get_next_buffer_to_send(tL2C_LCB* p_lcb,
 
       p_buf = l2c_fcr_get_next_xmit_sdu_seg(p_ccb, 0);
       if (p_buf != NULL) {
+        l2cu_charge_ccb(p_ccb, p_buf);
         l2cu_check_channel_congestion(p_ccb);
         l2cu_set_acl_hci_header(p_buf, p_ccb);
         return (p_buf);
@@ -3600,6 +3559,7 @@ BT_HDR* l2cu_get_next_buffer_to_send(tL2C_LCB* p_lcb,
         p_cbi->local_cid = p_ccb->local_cid;
         p_cbi->num_sdu = 1;
 
+        l2cu_charge_ccb(p_ccb, p_buf);
         l2cu_check_channel_congestion(p_ccb);
         l2cu_set_acl_hci_header(p_buf, p_ccb);
         return (p_buf);
@@ -3656,6 +3616,7 @@ BT_HDR* l2cu_get_next_buffer_to_send(tL2C_LCB* p_lcb,
       (p_ccb->peer_cfg.fcr.mode != L2CAP_FCR_ERTM_MODE))
     (*p_ccb->p_rcb->api.pL2CA_TxComplete_Cb)(p_ccb->local_cid, 1);
 
+  l2cu_charge_ccb(p_ccb, p_buf);
   l2cu_check_channel_congestion(p_ccb);
 
   l2cu_set_acl_hci_header(p_buf, p_ccb);
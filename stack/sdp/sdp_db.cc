@@ -221,6 +221,83 @@ tSDP_ATTRIBUTE* sdp_db_find_attr_in_rec(tSDP_RECORD* p_rec, uint16_t start_attr,
   return (NULL);
 }
 
+/*******************************************************************************
+ *
+ * Function         sdp_db_build_attr_cache
+ *
+ * Description      This function serializes every attribute of a record into
+ *                  the attribute cache of the record, unless the cache is
+ *                  still valid. Adding or deleting an attribute drops the
+ *                  cache.
+ *
+ * Returns          true if the cache is valid, else false
+ *
+ ******************************************************************************/
+bool sdp_db_build_attr_cache(tSDP_RECORD* p_rec) {
+  uint32_t len = 0;
+  uint16_t xx;
+
+  if (p_rec->attr_cache_valid) return (true);
+
+  for (xx = 0; xx < p_rec->num_attributes; xx++) {
+    p_rec->attr_cache_offset[xx] = (uint16_t)len;
+    len += sdpu_get_attrib_entry_len(&p_rec->attribute[xx]);
+    if (len > SDP_MAX_ATTR_CACHE_LEN) {
+      SDP_TRACE_ERROR("%s: record 0x%x too large to cache", __func__,
+                      p_rec->record_handle);
+      return (false);
+    }
+  }
+  p_rec->attr_cache_offset[xx] = (uint16_t)len;
+
+  for (xx = 0; xx < p_rec->num_attributes; xx++) {
+    sdpu_build_attrib_entry(&p_rec->attr_cache[p_rec->attr_cache_offset[xx]],
+                            &p_rec->attribute[xx]);
+  }
+
+  p_rec->attr_cache_valid = true;
+  return (true);
+}
+
+/*******************************************************************************
+ *
+ * Function         sdp_db_copy_cached_attribs
+ *
+ * Description      This function copies the cached entries of the attributes
+ *                  of a record that match an attribute sequence, in the order
+ *                  the server sends them. The cache of the record must be
+ *                  valid. If p_out is NULL, nothing is copied.
+ *
+ * Returns          Number of bytes of the matching entries
+ *
+ ******************************************************************************/
+uint16_t sdp_db_copy_cached_attribs(tSDP_RECORD* p_rec,
+                                    tSDP_ATTR_SEQ* attr_seq, uint8_t* p_out) {
+  tATT_ENT* p_ent = &attr_seq->attr_entry[0];
+  uint16_t xx, first, last, span;
+  uint16_t len = 0;
+
+  for (xx = 0; xx < attr_seq->num_attr; xx++, p_ent++) {
+    /* The attributes are sorted, so a range of IDs is a run of entries */
+    first = 0;
+    while (first < p_rec->num_attributes &&
+           p_rec->attribute[first].id < p_ent->start)
+      first++;
+    last = first;
+    while (last < p_rec->num_attributes &&
+           p_rec->attribute[last].id <= p_ent->end)
+      last++;
+
+    span = p_rec->attr_cache_offset[last] - p_rec->attr_cache_offset[first];
+    if (p_out != NULL && span != 0) {
+      memcpy(&p_out[len], &p_rec->attr_cache[p_rec->attr_cache_offset[first]],
+             span);
+    }
+    len += span;
+  }
+  return (len);
+}
+
 /*******************************************************************************
  *
  * Function         sdp_compose_proto_list
@@ -483,6 +560,8 @@ bool SDP_AddAttributeToRecord (tSDP_RECORD *p_rec, uint16_t attr_id,
     uint16_t xx, yy;
     tSDP_ATTRIBUTE* p_attr = &p_rec->attribute[0];
 
+    p_rec->attr_cache_valid = false;
+
     /* Found the record. Now, see if the attribute already exists */
     for (xx = 0; xx < p_rec->num_attributes; xx++, p_attr++) {
       /* The attribute exists. replace it */
@@ -1008,6 +1087,8 @@ bool SDP_DeleteAttributeFromRecord (tSDP_RECORD* p_rec, uint16_t attr_id)
   uint8_t *pad_ptr;
   uint32_t len;                        /* Number of bytes in the entry */
 
+  p_rec->attr_cache_valid = false;
+
   /* Found it. Now, find the attribute */
   for (xx = 0; xx < p_rec->num_attributes; xx++, p_attr++) {
     if (p_attr->id == attr_id) {
@@ -35,6 +35,7 @@
 #include "l2c_api.h"
 #include "l2cdefs.h"
 #include "osi/include/osi.h"
+#include "osi/include/properties.h"
 
 #include "btm_api.h"
 #include "btu.h"
@@ -87,6 +88,9 @@ void sdp_init(void) {
   sdp_cb.max_recs_per_search = SDP_MAX_DISC_SERVER_RECS;
 
 #if (SDP_SERVER_ENABLED == TRUE)
+  sdp_cb.attr_cache_enabled =
+      osi_property_get_bool("persist.vendor.btstack.sdp.attr_cache", true);
+
   /* Register with Security Manager for the specific security level */
   if (!BTM_SetSecurityLevel(false, SDP_SERVICE_NAME, BTM_SEC_SERVICE_SDP_SERVER,
                             SDP_SECURITY_LEVEL, SDP_PSM, 0, 0)) {
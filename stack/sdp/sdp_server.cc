@@ -106,6 +106,19 @@ static tSDP_RECORD *sdp_upgrade_mse_record(tSDP_RECORD *p_rec,
 
 static bool check_remote_map_version_104(RawAddress remote_addr);
 
+static bool sdp_record_is_peer_specific(tSDP_RECORD* p_rec);
+
+static bool sdp_prebuild_attr_rsp(tCONN_CB* p_ccb, tSDP_RECORD* p_rec,
+                                  tSDP_ATTR_SEQ* attr_seq);
+
+static bool sdp_prebuild_search_attr_rsp(tCONN_CB* p_ccb,
+                                         tSDP_UUID_SEQ* uid_seq,
+                                         tSDP_ATTR_SEQ* attr_seq);
+
+static void sdp_send_prebuilt_rsp(tCONN_CB* p_ccb, uint8_t rsp_pdu,
+                                  uint16_t trans_num, uint16_t max_list_len,
+                                  bool is_cont);
+
 /******************************************************************************/
 /*                E R R O R   T E X T   S T R I N G S                         */
 /*                                                                            */
@@ -769,10 +782,6 @@ static void process_service_attr_req(tCONN_CB* p_ccb, uint16_t trans_num,
   if(sdpu_is_pbap_0102_enabled()) {
     p_rec = sdp_upgrade_pse_record(p_rec, p_ccb->device_address);
   }
-  /* Free and reallocate buffer */
-  osi_free(p_ccb->rsp_list);
-  p_ccb->rsp_list = (uint8_t*)osi_malloc(max_list_len);
-
   /* Check if this is a continuation request */
   if (p_req + sizeof(uint8_t) > p_req_end) {
       sdpu_build_n_send_error(p_ccb, trans_num, SDP_INVALID_CONT_STATE,
@@ -799,8 +808,14 @@ static void process_service_attr_req(tCONN_CB* p_ccb, uint16_t trans_num,
     }
     is_cont = true;
 
+    /* The rest of a prebuilt list is sent as is */
+    if (p_ccb->prebuilt_rsp_pdu != 0) {
+      sdp_send_prebuilt_rsp(p_ccb, SDP_PDU_SERVICE_ATTR_RSP, trans_num, max_list_len,
+                            is_cont);
+      return;
+    }
+
     /* Initialise for continuation response */
-    p_rsp = &p_ccb->rsp_list[0];
     attr_seq.attr_entry[p_ccb->cont_info.next_attr_index].start =
         p_ccb->cont_info.next_attr_start_id;
   } else {
@@ -810,14 +825,30 @@ static void process_service_attr_req(tCONN_CB* p_ccb, uint16_t trans_num,
     }
 
     p_ccb->cont_offset = 0;
-    p_rsp = &p_ccb->rsp_list[3]; /* Leave space for data elem descr */
 
     /* Reset continuation parameters in p_ccb */
     p_ccb->cont_info.prev_sdp_rec = NULL;
     p_ccb->cont_info.curr_sdp_rec = NULL;
     p_ccb->cont_info.next_attr_index = 0;
     p_ccb->cont_info.attr_offset = 0;
+
+    /* Build the whole list at once if it is the same for every peer */
+    if (sdp_prebuild_attr_rsp(p_ccb, p_rec, &attr_seq_sav)) {
+      p_ccb->prebuilt_rsp_pdu = SDP_PDU_SERVICE_ATTR_RSP;
+      sdp_send_prebuilt_rsp(p_ccb, SDP_PDU_SERVICE_ATTR_RSP, trans_num, max_list_len,
+                            is_cont);
+      return;
+    }
+    p_ccb->prebuilt_rsp_pdu = 0;
   }
+
+  /* Free and reallocate buffer */
+  osi_free(p_ccb->rsp_list);
+  p_ccb->rsp_list = (uint8_t*)osi_malloc(max_list_len);
+
+  /* Leave space for data elem descr in the first response */
+  p_rsp = is_cont ? &p_ccb->rsp_list[0] : &p_ccb->rsp_list[3];
+
   /* Search for attributes that match the list given to us */
   for (xx = p_ccb->cont_info.next_attr_index; xx < attr_seq.num_attr; xx++) {
     p_attr = sdp_db_find_attr_in_rec(p_rec, attr_seq.attr_entry[xx].start,
@@ -1066,10 +1097,6 @@ static void process_service_search_attr_req(tCONN_CB* p_ccb, uint16_t trans_num,
 
   memcpy(&attr_seq_sav, &attr_seq, sizeof(tSDP_ATTR_SEQ));
 
-  /* Free and reallocate buffer */
-  osi_free(p_ccb->rsp_list);
-  p_ccb->rsp_list = (uint8_t*)osi_malloc(max_list_len);
-
   /* Check if this is a continuation request */
   if (p_req + sizeof(uint8_t) > p_req_end) {
       sdpu_build_n_send_error(p_ccb, trans_num, SDP_INVALID_CONT_STATE,
@@ -1096,8 +1123,14 @@ static void process_service_search_attr_req(tCONN_CB* p_ccb, uint16_t trans_num,
     }
     is_cont = true;
 
+    /* The rest of a prebuilt list is sent as is */
+    if (p_ccb->prebuilt_rsp_pdu != 0) {
+      sdp_send_prebuilt_rsp(p_ccb, SDP_PDU_SERVICE_SEARCH_ATTR_RSP, trans_num, max_list_len,
+                            is_cont);
+      return;
+    }
+
     /* Initialise for continuation response */
-    p_rsp = &p_ccb->rsp_list[0];
     attr_seq.attr_entry[p_ccb->cont_info.next_attr_index].start =
         p_ccb->cont_info.next_attr_start_id;
   } else {
@@ -1106,7 +1139,6 @@ static void process_service_search_attr_req(tCONN_CB* p_ccb, uint16_t trans_num,
       return;
     }
     p_ccb->cont_offset = 0;
-    p_rsp = &p_ccb->rsp_list[3]; /* Leave space for data elem descr */
 
     /* Reset continuation parameters in p_ccb */
     p_ccb->cont_info.prev_sdp_rec = NULL;
@@ -1114,7 +1146,24 @@ static void process_service_search_attr_req(tCONN_CB* p_ccb, uint16_t trans_num,
     p_ccb->cont_info.next_attr_index = 0;
     p_ccb->cont_info.last_attr_seq_desc_sent = false;
     p_ccb->cont_info.attr_offset = 0;
+
+    /* Build the whole list at once if it is the same for every peer */
+    if (sdp_prebuild_search_attr_rsp(p_ccb, &uid_seq, &attr_seq_sav)) {
+      p_ccb->prebuilt_rsp_pdu = SDP_PDU_SERVICE_SEARCH_ATTR_RSP;
+      sdp_send_prebuilt_rsp(p_ccb, SDP_PDU_SERVICE_SEARCH_ATTR_RSP, trans_num, max_list_len,
+                            is_cont);
+      return;
+    }
+    p_ccb->prebuilt_rsp_pdu = 0;
   }
+
+  /* Free and reallocate buffer */
+  osi_free(p_ccb->rsp_list);
+  p_ccb->rsp_list = (uint8_t*)osi_malloc(max_list_len);
+
+  /* Leave space for data elem descr in the first response */
+  p_rsp = is_cont ? &p_ccb->rsp_list[0] : &p_ccb->rsp_list[3];
+
   bool is_mse_v14_enabled = sdpu_is_map_0104_enabled();
   bool is_pse_v12_enabled = sdpu_is_pbap_0102_enabled();
   /* Get a list of handles that match the UUIDs given to us */
@@ -1398,6 +1447,230 @@ static void process_service_search_attr_req(tCONN_CB* p_ccb, uint16_t trans_num,
   L2CA_DataWrite(p_ccb->connection_id, p_buf);
 }
 
+/*******************************************************************************
+ *
+ * Function         sdp_record_is_peer_specific
+ *
+ * Description      Checks if some attributes of a record are changed for the
+ *                  peer before they are sent: AVRCP features and version, HFP
+ *                  version, and the PBAP and MAP record upgrades. The
+ *                  attribute cache is not used for these records.
+ *
+ * Returns          bool
+ *
+ ******************************************************************************/
+static bool sdp_record_is_peer_specific(tSDP_RECORD* p_rec) {
+  tSDP_ATTRIBUTE* p_attr = &p_rec->attribute[0];
+  uint16_t xx, uuid;
+
+  for (xx = 0; xx < p_rec->num_attributes; xx++, p_attr++) {
+    if ((p_attr->id == ATTR_ID_SERVICE_CLASS_ID_LIST) && (p_attr->len >= 3)) {
+      uuid = (p_attr->value_ptr[1] << 8) | p_attr->value_ptr[2];
+      if (uuid == UUID_SERVCLASS_AV_REM_CTRL_TARGET ||
+          uuid == UUID_SERVCLASS_PBAP_PSE ||
+          uuid == UUID_SERVCLASS_MESSAGE_ACCESS)
+        return true;
+    } else if ((p_attr->id == ATTR_ID_BT_PROFILE_DESC_LIST) &&
+               (p_attr->len >= SDP_PROFILE_DESC_LENGTH)) {
+      uuid = (p_attr->value_ptr[3] << 8) | p_attr->value_ptr[4];
+      if (uuid == UUID_SERVCLASS_AV_REMOTE_CONTROL ||
+          uuid == UUID_SERVCLASS_HF_HANDSFREE)
+        return true;
+    }
+  }
+  return false;
+}
+
+/*******************************************************************************
+ *
+ * Function         sdp_alloc_prebuilt_list
+ *
+ * Description      Allocates rsp_list for a whole attribute list of seq_len
+ *                  bytes and puts in the sequence header (2 or 3 bytes).
+ *
+ * Returns          Pointer to the start of the sequence data
+ *
+ ******************************************************************************/
+static uint8_t* sdp_alloc_prebuilt_list(tCONN_CB* p_ccb, uint16_t seq_len) {
+  uint8_t* p;
+
+  p_ccb->list_len = seq_len + ((seq_len + 3 > 255) ? 3 : 2);
+  p_ccb->bl_update_len = 0;
+
+  osi_free(p_ccb->rsp_list);
+  p_ccb->rsp_list = (uint8_t*)osi_malloc(p_ccb->list_len);
+
+  p = p_ccb->rsp_list;
+  if (seq_len + 3 > 255) {
+    UINT8_TO_BE_STREAM(p, (DATA_ELE_SEQ_DESC_TYPE << 3) | SIZE_IN_NEXT_WORD);
+    UINT16_TO_BE_STREAM(p, seq_len);
+  } else {
+    UINT8_TO_BE_STREAM(p, (DATA_ELE_SEQ_DESC_TYPE << 3) | SIZE_IN_NEXT_BYTE);
+    UINT8_TO_BE_STREAM(p, seq_len);
+  }
+  return p;
+}
+
+/*******************************************************************************
+ *
+ * Function         sdp_prebuild_attr_rsp
+ *
+ * Description      Builds the whole attribute list of a service attribute
+ *                  response in rsp_list from the attribute cache of the
+ *                  record, so that every response of the transaction is a
+ *                  slice of it.
+ *
+ * Returns          true if the list was built, false if the cache is disabled
+ *                  or the record is not cacheable
+ *
+ ******************************************************************************/
+static bool sdp_prebuild_attr_rsp(tCONN_CB* p_ccb, tSDP_RECORD* p_rec,
+                                  tSDP_ATTR_SEQ* attr_seq) {
+  uint32_t seq_len;
+
+  if (!sdp_cb.attr_cache_enabled) return false;
+
+  if (sdp_record_is_peer_specific(p_rec) || !sdp_db_build_attr_cache(p_rec))
+    return false;
+
+  seq_len = sdp_db_copy_cached_attribs(p_rec, attr_seq, NULL);
+  if (seq_len + 3 > UINT16_MAX) return false;
+
+  sdp_db_copy_cached_attribs(p_rec, attr_seq,
+                             sdp_alloc_prebuilt_list(p_ccb, seq_len));
+  return true;
+}
+
+/*******************************************************************************
+ *
+ * Function         sdp_prebuild_search_attr_rsp
+ *
+ * Description      Builds the whole attribute list of a service search
+ *                  attribute response in rsp_list from the attribute caches
+ *                  of the matching records, so that every response of the
+ *                  transaction is a slice of it.
+ *
+ * Returns          true if the list was built, false if the cache is disabled
+ *                  or a matching record is not cacheable
+ *
+ ******************************************************************************/
+static bool sdp_prebuild_search_attr_rsp(tCONN_CB* p_ccb,
+                                         tSDP_UUID_SEQ* uid_seq,
+                                         tSDP_ATTR_SEQ* attr_seq) {
+  tSDP_RECORD* p_rec;
+  uint32_t seq_len = 0;
+  uint16_t len;
+  uint8_t* p;
+
+  if (!sdp_cb.attr_cache_enabled) return false;
+
+  for (p_rec = sdp_db_service_search(NULL, uid_seq); p_rec;
+       p_rec = sdp_db_service_search(p_rec, uid_seq)) {
+    if (sdp_record_is_peer_specific(p_rec) || !sdp_db_build_attr_cache(p_rec))
+      return false;
+
+    len = sdp_db_copy_cached_attribs(p_rec, attr_seq, NULL);
+    if (len != 0) seq_len += 3 + len;
+  }
+  if (seq_len + 3 > UINT16_MAX) return false;
+
+  /* One sequence per record with matching attributes */
+  p = sdp_alloc_prebuilt_list(p_ccb, seq_len);
+  for (p_rec = sdp_db_service_search(NULL, uid_seq); p_rec;
+       p_rec = sdp_db_service_search(p_rec, uid_seq)) {
+    len = sdp_db_copy_cached_attribs(p_rec, attr_seq, p + 3);
+    if (len == 0) continue;
+
+    UINT8_TO_BE_STREAM(p, (DATA_ELE_SEQ_DESC_TYPE << 3) | SIZE_IN_NEXT_WORD);
+    UINT16_TO_BE_STREAM(p, len);
+    p += len;
+  }
+  return true;
+}
+
+/*******************************************************************************
+ *
+ * Function         sdp_send_prebuilt_rsp
+ *
+ * Description      Sends the next slice of the attribute list prebuilt in
+ *                  rsp_list as a rsp_pdu response, with a continuation state
+ *                  if more is left.
+ *
+ * Returns          void
+ *
+ ******************************************************************************/
+static void sdp_send_prebuilt_rsp(tCONN_CB* p_ccb, uint8_t rsp_pdu,
+                                  uint16_t trans_num, uint16_t max_list_len,
+                                  bool is_cont) {
+  uint8_t *p_rsp, *p_rsp_start, *p_rsp_param_len;
+  uint16_t rsp_param_len, len_to_send, rsp_end, xx;
+
+  /* A continuation must be of the same request and make progress, see
+   * process_service_search_attr_req */
+  if (is_cont && (p_ccb->prebuilt_rsp_pdu != rsp_pdu ||
+                  p_ccb->cont_offset >= p_ccb->list_len)) {
+    sdpu_build_n_send_error(p_ccb, trans_num, SDP_INVALID_CONT_STATE, NULL);
+    return;
+  }
+
+  /* Slice the list where the per-response build ends its responses. It
+   * leaves room for a 3 byte sequence header in the first response, */
+  if (!is_cont && (p_ccb->rsp_list[0] & 0x07) == SIZE_IN_NEXT_BYTE)
+    max_list_len--;
+
+  len_to_send = p_ccb->list_len - p_ccb->cont_offset;
+  if (len_to_send > max_list_len) len_to_send = max_list_len;
+
+  /* and only starts the sequence of a record if its header fits */
+  if (rsp_pdu == SDP_PDU_SERVICE_SEARCH_ATTR_RSP) {
+    rsp_end = p_ccb->cont_offset + len_to_send;
+    xx = ((p_ccb->rsp_list[0] & 0x07) == SIZE_IN_NEXT_WORD) ? 3 : 2;
+    while (xx < rsp_end) {
+      if (rsp_end - xx < 3) {
+        len_to_send = xx - p_ccb->cont_offset;
+        break;
+      }
+      xx += 3 + ((p_ccb->rsp_list[xx + 1] << 8) | p_ccb->rsp_list[xx + 2]);
+    }
+  }
+
+  /* Get a buffer to use to build the response */
+  BT_HDR* p_buf = (BT_HDR*)osi_malloc(SDP_DATA_BUF_SIZE);
+  p_buf->offset = L2CAP_MIN_OFFSET;
+  p_rsp = p_rsp_start = (uint8_t*)(p_buf + 1) + L2CAP_MIN_OFFSET;
+
+  UINT8_TO_BE_STREAM(p_rsp, rsp_pdu);
+  UINT16_TO_BE_STREAM(p_rsp, trans_num);
+
+  /* Skip the parameter length, add it when we know the length */
+  p_rsp_param_len = p_rsp;
+  p_rsp += 2;
+
+  UINT16_TO_BE_STREAM(p_rsp, len_to_send);
+
+  memcpy(p_rsp, &p_ccb->rsp_list[p_ccb->cont_offset], len_to_send);
+  p_rsp += len_to_send;
+
+  p_ccb->cont_offset += len_to_send;
+
+  /* If anything left to send, continuation needed */
+  if (p_ccb->cont_offset < p_ccb->list_len) {
+    UINT8_TO_BE_STREAM(p_rsp, SDP_CONTINUATION_LEN);
+    UINT16_TO_BE_STREAM(p_rsp, p_ccb->cont_offset);
+  } else
+    UINT8_TO_BE_STREAM(p_rsp, 0);
+
+  /* Go back and put the parameter length into the buffer */
+  rsp_param_len = p_rsp - p_rsp_param_len - 2;
+  UINT16_TO_BE_STREAM(p_rsp_param_len, rsp_param_len);
+
+  /* Set the length of the SDP data in the buffer */
+  p_buf->len = p_rsp - p_rsp_start;
+
+  /* Send the buffer through L2CAP */
+  L2CA_DataWrite(p_ccb->connection_id, p_buf);
+}
+
 /*************************************************************************************
 **
 ** Function        is_device_blacklisted_for_pbap
@@ -86,6 +86,10 @@
 #define MAX_ATTR_LEN 256
 #endif
 
+/* Max length of the serialized attribute entries of a record: the values plus
+ * the attribute ID (3 bytes) and the value header (up to 5 bytes) of each */
+#define SDP_MAX_ATTR_CACHE_LEN (SDP_MAX_PAD_LEN + 8 * SDP_MAX_REC_ATTR)
+
 /* Internal UUID sequence representation */
 typedef struct {
   uint16_t len;
@@ -123,6 +127,12 @@ typedef struct {
   uint16_t num_attributes;
   tSDP_ATTRIBUTE attribute[SDP_MAX_REC_ATTR];
   uint8_t attr_pad[SDP_MAX_PAD_LEN];
+
+  /* Attribute entries as sent by the server, built on the first read and
+   * dropped whenever an attribute is added or deleted */
+  bool attr_cache_valid;
+  uint16_t attr_cache_offset[SDP_MAX_REC_ATTR + 1]; /* entry start offsets */
+  uint8_t attr_cache[SDP_MAX_ATTR_CACHE_LEN];
 } tSDP_RECORD;
 
 /* Define the SDP database */
@@ -203,6 +213,8 @@ typedef struct {
 
 #if (SDP_SERVER_ENABLED == TRUE)
   uint16_t cont_offset;     /* Continuation state data in the server response */
+  uint8_t prebuilt_rsp_pdu; /* Response PDU whose whole attribute list is in
+                               rsp_list, 0 if the list is built per response */
   tSDP_CONT_INFO cont_info; /* structure to hold continuation information for
                                the server response */
 #endif                      /* SDP_SERVER_ENABLED == TRUE */
@@ -215,6 +227,7 @@ typedef struct {
   tCONN_CB ccb[SDP_MAX_CONNECTIONS];
 #if (SDP_SERVER_ENABLED == TRUE)
   tSDP_DB server_db;
+  bool attr_cache_enabled; /* Serve attribute lists from the record caches */
 #endif
   tL2CAP_APPL_INFO reg_info;    /* L2CAP Registration info */
   uint16_t max_attr_list_size;  /* Max attribute list size to use   */
@@ -304,6 +317,10 @@ extern tSDP_RECORD* sdp_db_find_record(uint32_t handle);
 extern tSDP_ATTRIBUTE* sdp_db_find_attr_in_rec(tSDP_RECORD* p_rec,
                                                uint16_t start_attr,
                                                uint16_t end_attr);
+extern bool sdp_db_build_attr_cache(tSDP_RECORD* p_rec);
+extern uint16_t sdp_db_copy_cached_attribs(tSDP_RECORD* p_rec,
+                                           tSDP_ATTR_SEQ* attr_seq,
+                                           uint8_t* p_out);
 
 /* Functions provided by sdp_server.cc
  */
@@ -63,4 +63,10 @@ void ECC_PointMult_Bin_NAF(Point* q, Point* p, uint32_t* n, uint32_t keyLength);
 #define ECC_PointMult(q, p, n, keyLength) \
   ECC_PointMult_Bin_NAF(q, p, n, keyLength)
 
+// Constant-time P-256 point multiplications on 64-bit limbs, see
+// p_256_ecc_pp64.cc. |n| is a 256-bit scalar in little endian dwords and is
+// left unmodified; |q| is returned in affine coordinates with z=1.
+void ECC_PointMult_Base_Comb(Point* q, const uint32_t* n);
+void ECC_PointMult_Window(Point* q, const Point* p, const uint32_t* n);
+
 void p_256_init_curve(uint32_t keyLength);
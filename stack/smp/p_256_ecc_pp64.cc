@@ -0,0 +1,535 @@
+/******************************************************************************
+ * Copyright (c) 2026 Qualcomm Innovation Center, Inc. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ *
+ *******************************************************************************/
+
+/*******************************************************************************
+ *
+ *  This file contains the P-256 point multiplications used for LE Secure
+ *  Connections key generation and DHKey computation. Field elements are held
+ *  in four 64-bit limbs in the Montgomery domain (R = 2^256), and points in
+ *  projective coordinates using the complete addition formulas of Renes,
+ *  Costello and Batina, so that neither the field arithmetic nor the point
+ *  arithmetic branches on secret data.
+ *
+ ******************************************************************************/
+#include <string.h>
+#include "p_256_ecc_pp.h"
+
+#define P256_LIMBS 4
+
+typedef uint64_t p256_fe[P256_LIMBS];
+
+typedef struct {
+  p256_fe x;
+  p256_fe y;
+  p256_fe z;
+} p256_point;
+
+// p = 2^256 - 2^224 + 2^192 + 2^96 - 1. As p = -1 mod 2^64, the Montgomery
+// reduction factor -p^-1 mod 2^64 is 1.
+static const p256_fe p256_p = {0xffffffffffffffff, 0x00000000ffffffff, 0,
+                               0xffffffff00000001};
+
+// R^2 mod p, to convert into the Montgomery domain
+static const p256_fe p256_rr = {0x0000000000000003, 0xfffffffbffffffff,
+                                0xfffffffffffffffe, 0x00000004fffffffd};
+
+// 1 and b in the Montgomery domain
+static const p256_fe p256_one = {0x0000000000000001, 0xffffffff00000000,
+                                 0xffffffffffffffff, 0x00000000fffffffe};
+static const p256_fe p256_b = {0xd89cdf6229c4bddf, 0xacf005cd78843090,
+                               0xe5a220abf7212ed6, 0xdc30061d04874834};
+
+// Comb tables for the base point G, in affine coordinates in the Montgomery
+// domain. Entry b of comb_table_lo is the sum of 2^(32t)·G over the bits t
+// set in b, and comb_table_hi holds the same sums multiplied by 2^128. Entry 0
+// is the point at infinity, whose y coordinate is kept as 1.
+static const uint64_t comb_table_lo[16][2][4] = {
+    {{0, 0, 0, 0},
+     {0x0000000000000001, 0xffffffff00000000, 0xffffffffffffffff,
+      0x00000000fffffffe}},
+    {{0x79e730d418a9143c, 0x75ba95fc5fedb601, 0x79fb732b77622510,
+      0x18905f76a53755c6},
+     {0xddf25357ce95560a, 0x8b4ab8e4ba19e45c, 0xd2e88688dd21f325,
+      0x8571ff1825885d85}},
+    {{0x202886024147519a, 0xd0981eac26b372f0, 0xa9d4a7caa785ebc8,
+      0xd953c50ddbdf58e9},
+     {0x9d6361ccfd590f8f, 0x72e9626b44e6c917, 0x7fd9611022eb64cf,
+      0x863ebb7e9eb288f3}},
+    {{0x7856b6235cdb6485, 0x808f0ea22f0a2f97, 0x3e68d9544f7e300b,
+      0x00076055b5ff80a0},
+     {0x7634eb9b838d2010, 0x54014fbb3243708a, 0xe0e47d39842a6606,
+      0x8308776134373ee0}},
+    {{0x4f922fc516a0d2bb, 0x0d5cc16c1a623499, 0x9241cf3a57c62c8b,
+      0x2f5e6961fd1b667f},
+     {0x5c15c70bf5a01797, 0x3d20b44d60956192, 0x04911b37071fdb52,
+      0xf648f9168d6f0f7b}},
+    {{0x9e566847e137bbbc, 0xe434469e8a6a0bec, 0xb1c4276179d73463,
+      0x5abe0285133d0015},
+     {0x92aa837cc04c7dab, 0x573d9f4c43260c07, 0x0c93156278e6cc37,
+      0x94bb725b6b6f7383}},
+    {{0xbbf9b48f720f141c, 0x6199b3cd2df5bc74, 0xdc3f6129411045c4,
+      0xcdd6bbcb2f7dc4ef},
+     {0xcca6700beaf436fd, 0x6f647f6db99326be, 0x0c0fa792014f2522,
+      0xa361bebd4bdae5f6}},
+    {{0x28aa2558597c13c7, 0xc38d635f50b7c3e1, 0x07039aecf3c09d1d,
+      0xba12ca09c4b5292c},
+     {0x9e408fa459f91dfd, 0x3af43b66ceea07fb, 0x1eceb0899d780b29,
+      0x53ebb99d701fef4b}},
+    {{0x4fe7ee31b0e63d34, 0xf4600572a9e54fab, 0xc0493334d5e7b5a4,
+      0x8589fb9206d54831},
+     {0xaa70f5cc6583553a, 0x0879094ae25649e5, 0xcc90450710044652,
+      0xebb0696d02541c4f}},
+    {{0x4616ca15ac1647c5, 0xb8127d47c4cf5799, 0xdc666aa3764dfbac,
+      0xeb2820cbd1b27da3},
+     {0x9406f8d86a87e008, 0xd87dfa9d922378f3, 0x56ed2e4280ccecb2,
+      0x1f28289b55a7da1d}},
+    {{0xabbaa0c03b89da99, 0xa6f2d79eb8284022, 0x27847862b81c05e8,
+      0x337a4b5905e54d63},
+     {0x3c67500d21f7794a, 0x207005b77d6d7f61, 0x0a5a378104cfd6e8,
+      0x0d65e0d5f4c2fbd6}},
+    {{0xd9d09bbeb5275d38, 0x4268a7450be0a358, 0xf0762ff4973eb265,
+      0xc23da24252f4a232},
+     {0x5da1b84f0b94520c, 0x09666763b05bd78e, 0x3a4dcb8694d29ea1,
+      0x19de3b8cc790cff1}},
+    {{0x183a716c26c5fe04, 0x3b28de0b3bba1bdb, 0x7432c586a4cb712c,
+      0xe34dcbd491fccbfd},
+     {0xb408d46baaa58403, 0x9a69748682e97a53, 0x9e39012736aaa8af,
+      0xe7641f447b4e0f7f}},
+    {{0x7d753941df64ba59, 0xd33f10ec0b0242fc, 0x4f06dfc6a1581859,
+      0x4a12df57052a57bf},
+     {0xbfa6338f9439dbd0, 0xd3c24bd4bde53e1f, 0xfd5e4ffa21f1b314,
+      0x6af5aa93bb5bea46}},
+    {{0xda10b69910c91999, 0x0a24b4402a580491, 0x3e0094b4b8cc2090,
+      0x5fe3475a66a44013},
+     {0xb0f8cabdf93e7b4b, 0x292b501a7c23f91a, 0x42e889aecd1e6263,
+      0xb544e308ecfea916}},
+    {{0x6478c6e916ddfdce, 0x2c329166f89179e6, 0x4e8d6e764d4e67e1,
+      0xe0b6b2bda6b0c20b},
+     {0x0d312df2bb7efb57, 0x1aac0dde790c4007, 0xf90336ad679bc944,
+      0x71c023de25a63774}},
+};
+static const uint64_t comb_table_hi[16][2][4] = {
+    {{0, 0, 0, 0},
+     {0x0000000000000001, 0xffffffff00000000, 0xffffffffffffffff,
+      0x00000000fffffffe}},
+    {{0x62a8c244bfe20925, 0x91c19ac38fdce867, 0x5a96a5d5dd387063,
+      0x61d587d421d324f6},
+     {0xe87673a2a37173ea, 0x2384800853778b65, 0x10f8441e05bab43e,
+      0xfa11fe124621efbe}},
+    {{0xd433e50f6d3549cf, 0x6f33696ffacd665e, 0x695bfdacce11fcb4,
+      0x810ee252af7c9860},
+     {0x65450fe17159bb2c, 0xf7dfbebe758b357b, 0x2b057e74d69fea72,
+      0xd485717a92731745}},
+    {{0xd11d47dcfc9877ee, 0xc8b36210801d0002, 0xd002c11754c260b6,
+      0x04c17cd86962f046},
+     {0x6d9bd094b0daddf5, 0xbea2357524ce55c0, 0x663356e672da03b5,
+      0xf7ba4de9fed97474}},
+    {{0x56f8410ef4f8b16a, 0x97241afec47b266a, 0x0a406b8e6d9c87c1,
+      0x803f3e02cd42ab1b},
+     {0x7f0309a804dbec69, 0xa83b85f73bbad05f, 0xc6097273ad8e197f,
+      0xc097440e5067adc1}},
+    {{0x5fe14bfe80ec21fe, 0xf6ce116ac255be82, 0x98bc5a072f4a5d67,
+      0xfad27148db7e63af},
+     {0x90c0b6ac29ab05b3, 0x37a9a83c4e251ae6, 0x0a7dc875c2aade7d,
+      0x77387de39f0e1a84}},
+    {{0x84a9521d927dafc6, 0x52c1fb695c09cd19, 0x9d9581a0f9366dde,
+      0x9abe210ba16d7e64},
+     {0x480af84a48915220, 0xfa73176a4dd816c6, 0xc7d539871681ca5a,
+      0x7881c25787f344b0}},
+    {{0xd75a3e6505058880, 0x7da365ef643943f2, 0x4147861cfab24925,
+      0xc5c4bdb0fdb808ff},
+     {0x73513e34b272b56b, 0xc8327e9511b9043a, 0xfd8ce37df8844969,
+      0x2d56db9446c2b6b5}},
+    {{0xe3417bc035d0b34a, 0x440b386b8327c0a7, 0x8fb7262dac0362d1,
+      0x2c41114ce0cdf943},
+     {0x2ba5cef1ad95a0b1, 0xc09b37a867d54362, 0x26d6cdd201e486c9,
+      0x20477abf42ff9297}},
+    {{0xf4f80824a7bf9b7c, 0x365d23203fbe30d0, 0xbfbe532097cf9ce3,
+      0xe3604700b3055526},
+     {0x4dcb99116cc6c2c7, 0x72683708ba4cbee6, 0xdcded434637ad9ec,
+      0x6542d677a3dee15f}},
+    {{0x231c210e15339848, 0xe87a28e870778c8d, 0x9d1de6616956e170,
+      0x4ac3c9382bb09c0b},
+     {0x19be05516998987d, 0x8b2376c4ae09f4d6, 0x1de0b7651a3f933d,
+      0x380d94c7e39705f4}},
+    {{0xeb54ea74a16bd00a, 0xd839e9adf5c0bcc1, 0x092bb7f11f9bfc06,
+      0x318f97b31163dc4e},
+     {0xecc0c5bec30d7138, 0x44e8df23abc30220, 0x2bb7972fb0223606,
+      0xfa41faa19a84ff4d}},
+    {{0x2e80937cf67d04c3, 0x1e312be289eeb811, 0x56b5d88792594d60,
+      0x0224da14187fbd3d},
+     {0x87abb8630c5fe36f, 0x580f3c604ef51f5f, 0x964fb1bfb3b429ec,
+      0x60838ef042bfff33}},
+    {{0xf0f58f6620c26def, 0x025585ea582b2d1e, 0xfbe7d79b01ce3881,
+      0x28ccea01303f1730},
+     {0xd1dabcd179644ba5, 0x1fc643e806fff0b8, 0xa60a76fc66b3e17b,
+      0xc18baf48a1d013bf}},
+    {{0x396ef794addb7d07, 0x0b4fc74224455500, 0xfaff8eacc78aa3ce,
+      0x14e9ada5e8d4d97d},
+     {0xdaa480a12f7079e2, 0x45baa3cde4b0800e, 0x01765e2d7838157d,
+      0xa0ad4fab8e9d9ae8}},
+    {{0xc9a1dc0e0bfc8ff3, 0x14efd82be936f42f, 0x67016f7ccca381ef,
+      0x1432c1caed8aee96},
+     {0xec68482970b23c26, 0xa64fe8730735b273, 0xe389f6e5eaef0f5a,
+      0xcaef480b5ac8d2c6}},
+};
+
+// returns a*b + c + d, with the high 64 bits in |hi|
+static inline uint64_t mul_add(uint64_t a, uint64_t b, uint64_t c, uint64_t d,
+                               uint64_t* hi) {
+#if defined(__SIZEOF_INT128__)
+  unsigned __int128 t = (unsigned __int128)a * b + c + d;
+  *hi = (uint64_t)(t >> 64);
+  return (uint64_t)t;
+#else
+  uint64_t a0 = (uint32_t)a, a1 = a >> 32;
+  uint64_t b0 = (uint32_t)b, b1 = b >> 32;
+  uint64_t p00 = a0 * b0, p01 = a0 * b1, p10 = a1 * b0, p11 = a1 * b1;
+  uint64_t mid = (p00 >> 32) + (uint32_t)p01 + (uint32_t)p10;
+  uint64_t lo = (mid << 32) | (uint32_t)p00;
+  uint64_t h = p11 + (p01 >> 32) + (p10 >> 32) + (mid >> 32);
+
+  lo += c;
+  h += (lo < c);
+  lo += d;
+  h += (lo < d);
+  *hi = h;
+  return lo;
+#endif
+}
+
+// returns a + b + carry, with the carry out in |carry|
+static inline uint64_t add_carry(uint64_t a, uint64_t b, uint64_t* carry) {
+  uint64_t t = a + *carry;
+  uint64_t c = (t < a);
+  t += b;
+  *carry = c | (t < b);
+  return t;
+}
+
+// returns a - b - borrow, with the borrow out in |borrow|
+static inline uint64_t sub_borrow(uint64_t a, uint64_t b, uint64_t* borrow) {
+  uint64_t t = a - b - *borrow;
+  *borrow = ((~a & b) | (~(a ^ b) & t)) >> 63;
+  return t;
+}
+
+// c = a if mask is all ones, unchanged if mask is 0
+static inline void fe_cmov(p256_fe c, const p256_fe a, uint64_t mask) {
+  for (int i = 0; i < P256_LIMBS; i++) c[i] ^= mask & (c[i] ^ a[i]);
+}
+
+// c=(a+b) mod p, a<p, b<p
+static void fe_add(p256_fe c, const p256_fe a, const p256_fe b) {
+  p256_fe s, d;
+  uint64_t carry = 0, borrow = 0;
+
+  for (int i = 0; i < P256_LIMBS; i++) s[i] = add_carry(a[i], b[i], &carry);
+  for (int i = 0; i < P256_LIMBS; i++)
+    d[i] = sub_borrow(s[i], p256_p[i], &borrow);
+
+  // keep the sum only if it is below p
+  uint64_t keep_sum = 0 - (borrow & (carry ^ 1));
+  fe_cmov(d, s, keep_sum);
+  memcpy(c, d, sizeof(p256_fe));
+}
+
+// c=(a-b) mod p, a<p, b<p
+static void fe_sub(p256_fe c, const p256_fe a, const p256_fe b) {
+  p256_fe d, m;
+  uint64_t borrow = 0, carry = 0;
+
+  for (int i = 0; i < P256_LIMBS; i++) d[i] = sub_borrow(a[i], b[i], &borrow);
+
+  // add p back if a<b
+  for (int i = 0; i < P256_LIMBS; i++) m[i] = p256_p[i] & (0 - borrow);
+  for (int i = 0; i < P256_LIMBS; i++) c[i] = add_carry(d[i], m[i], &carry);
+}
+
+// c=a*b/R mod p, a<2^256, b<p
+static void fe_mul(p256_fe c, const p256_fe a, const p256_fe b) {
+  uint64_t t[2 * P256_LIMBS + 1];
+  uint64_t hi, carry;
+
+  // t=a*b
+  for (int i = 0; i < P256_LIMBS; i++) {
+    hi = 0;
+    for (int j = 0; j < P256_LIMBS; j++)
+      t[i + j] = mul_add(a[j], b[i], i ? t[i + j] : 0, hi, &hi);
+    t[i + P256_LIMBS] = hi;
+  }
+  t[2 * P256_LIMBS] = 0;
+
+  // Montgomery reduction, one limb at a time. With m=t[i], adding
+  // m*p = m*p[3]*2^192 + m*2^96 - m clears t[i], so only the product with
+  // the top limb of p needs a multiplication.
+  for (int i = 0; i < P256_LIMBS; i++) {
+    uint64_t m = t[i];
+    uint64_t lo = mul_add(m, p256_p[3], 0, 0, &hi);
+
+    carry = 0;
+    t[i + 1] = add_carry(t[i + 1], m << 32, &carry);
+    t[i + 2] = add_carry(t[i + 2], m >> 32, &carry);
+    t[i + 3] = add_carry(t[i + 3], lo, &carry);
+    t[i + 4] = add_carry(t[i + 4], hi, &carry);
+    for (int j = i + 5; j <= 2 * P256_LIMBS; j++)
+      t[j] = add_carry(t[j], 0, &carry);
+  }
+
+  // t<2p, subtract p unless that borrows
+  p256_fe d;
+  uint64_t borrow = 0;
+  for (int i = 0; i < P256_LIMBS; i++)
+    d[i] = sub_borrow(t[i + P256_LIMBS], p256_p[i], &borrow);
+  uint64_t keep_t = 0 - (borrow & (t[2 * P256_LIMBS] ^ 1));
+  fe_cmov(d, t + P256_LIMBS, keep_t);
+  memcpy(c, d, sizeof(p256_fe));
+}
+
+static void fe_sqr(p256_fe c, const p256_fe a) { fe_mul(c, a, a); }
+
+// c=a^(p-2)=a^-1 mod p, with c=0 when a=0
+static void fe_inv(p256_fe c, const p256_fe a) {
+  // p-2 in limbs; the exponent is public so the bits can be branched on
+  static const p256_fe p_minus_2 = {0xfffffffffffffffd, 0x00000000ffffffff, 0,
+                                    0xffffffff00000001};
+  p256_fe r;
+
+  memcpy(r, p256_one, sizeof(p256_fe));
+  for (int i = 255; i >= 0; i--) {
+    fe_sqr(r, r);
+    if ((p_minus_2[i / 64] >> (i % 64)) & 1) fe_mul(r, r, a);
+  }
+  memcpy(c, r, sizeof(p256_fe));
+}
+
+// c=a*R mod p, from eight little endian dwords
+static void fe_from_dwords(p256_fe c, const uint32_t* a) {
+  for (int i = 0; i < P256_LIMBS; i++)
+    c[i] = (uint64_t)a[2 * i] | ((uint64_t)a[2 * i + 1] << 32);
+  fe_mul(c, c, p256_rr);
+}
+
+// c=a/R mod p, into eight little endian dwords
+static void fe_to_dwords(uint32_t* c, const p256_fe a) {
+  static const p256_fe one = {1, 0, 0, 0};
+  p256_fe t;
+
+  fe_mul(t, a, one);
+  for (int i = 0; i < P256_LIMBS; i++) {
+    c[2 * i] = (uint32_t)t[i];
+    c[2 * i + 1] = (uint32_t)(t[i] >> 32);
+  }
+}
+
+// r=p+q, for any points p and q including the point at infinity
+// (Renes-Costello-Batina, algorithm 4)
+static void p256_point_add(p256_point* r, const p256_point* p,
+                           const p256_point* q) {
+  p256_fe t0, t1, t2, t3, t4, x3, y3, z3;
+
+  fe_mul(t0, p->x, q->x);
+  fe_mul(t1, p->y, q->y);
+  fe_mul(t2, p->z, q->z);
+  fe_add(t3, p->x, p->y);
+  fe_add(t4, q->x, q->y);
+  fe_mul(t3, t3, t4);
+  fe_add(t4, t0, t1);
+  fe_sub(t3, t3, t4);
+  fe_add(t4, p->y, p->z);
+  fe_add(x3, q->y, q->z);
+  fe_mul(t4, t4, x3);
+  fe_add(x3, t1, t2);
+  fe_sub(t4, t4, x3);
+  fe_add(x3, p->x, p->z);
+  fe_add(y3, q->x, q->z);
+  fe_mul(x3, x3, y3);
+  fe_add(y3, t0, t2);
+  fe_sub(y3, x3, y3);
+  fe_mul(z3, p256_b, t2);
+  fe_sub(x3, y3, z3);
+  fe_add(z3, x3, x3);
+  fe_add(x3, x3, z3);
+  fe_sub(z3, t1, x3);
+  fe_add(x3, t1, x3);
+  fe_mul(y3, p256_b, y3);
+  fe_add(t1, t2, t2);
+  fe_add(t2, t1, t2);
+  fe_sub(y3, y3, t2);
+  fe_sub(y3, y3, t0);
+  fe_add(t1, y3, y3);
+  fe_add(y3, t1, y3);
+  fe_add(t1, t0, t0);
+  fe_add(t0, t1, t0);
+  fe_sub(t0, t0, t2);
+  fe_mul(t1, t4, y3);
+  fe_mul(t2, t0, y3);
+  fe_mul(y3, x3, z3);
+  fe_add(y3, y3, t2);
+  fe_mul(x3, t3, x3);
+  fe_sub(x3, x3, t1);
+  fe_mul(z3, t4, z3);
+  fe_mul(t1, t3, t0);
+  fe_add(z3, z3, t1);
+
+  memcpy(r->x, x3, sizeof(p256_fe));
+  memcpy(r->y, y3, sizeof(p256_fe));
+  memcpy(r->z, z3, sizeof(p256_fe));
+}
+
+// r=2p, for any point p (Renes-Costello-Batina, algorithm 6)
+static void p256_point_double(p256_point* r, const p256_point* p) {
+  p256_fe t0, t1, t2, t3, x3, y3, z3;
+
+  fe_sqr(t0, p->x);
+  fe_sqr(t1, p->y);
+  fe_sqr(t2, p->z);
+  fe_mul(t3, p->x, p->y);
+  fe_add(t3, t3, t3);
+  fe_mul(z3, p->x, p->z);
+  fe_add(z3, z3, z3);
+  fe_mul(y3, p256_b, t2);
+  fe_sub(y3, y3, z3);
+  fe_add(x3, y3, y3);
+  fe_add(y3, x3, y3);
+  fe_sub(x3, t1, y3);
+  fe_add(y3, t1, y3);
+  fe_mul(y3, x3, y3);
+  fe_mul(x3, x3, t3);
+  fe_add(t3, t2, t2);
+  fe_add(t2, t2, t3);
+  fe_mul(z3, p256_b, z3);
+  fe_sub(z3, z3, t2);
+  fe_sub(z3, z3, t0);
+  fe_add(t3, z3, z3);
+  fe_add(z3, z3, t3);
+  fe_add(t3, t0, t0);
+  fe_add(t0, t3, t0);
+  fe_sub(t0, t0, t2);
+  fe_mul(t0, t0, z3);
+  fe_add(y3, y3, t0);
+  fe_mul(t0, p->y, p->z);
+  fe_add(t0, t0, t0);
+  fe_mul(z3, t0, z3);
+  fe_sub(x3, x3, z3);
+  fe_mul(z3, t0, t1);
+  fe_add(z3, z3, z3);
+  fe_add(z3, z3, z3);
+
+  memcpy(r->x, x3, sizeof(p256_fe));
+  memcpy(r->y, y3, sizeof(p256_fe));
+  memcpy(r->z, z3, sizeof(p256_fe));
+}
+
+// all ones if a==b, 0 otherwise, for a and b below 2^32
+static inline uint64_t ct_eq_mask(uint32_t a, uint32_t b) {
+  return 0 - (((uint64_t)(a ^ b) - 1) >> 63);
+}
+
+// r=table[index], reading every entry
+static void p256_select_point(p256_point* r, const p256_point table[16],
+                              uint32_t index) {
+  memset(r, 0, sizeof(p256_point));
+  for (uint32_t i = 0; i < 16; i++) {
+    uint64_t mask = ct_eq_mask(i, index);
+    fe_cmov(r->x, table[i].x, mask);
+    fe_cmov(r->y, table[i].y, mask);
+    fe_cmov(r->z, table[i].z, mask);
+  }
+}
+
+// r=table[index] of an affine comb table, reading every entry
+static void p256_select_comb_point(p256_point* r,
+                                   const uint64_t table[16][2][4],
+                                   uint32_t index) {
+  memset(r, 0, sizeof(p256_point));
+  for (uint32_t i = 0; i < 16; i++) {
+    uint64_t mask = ct_eq_mask(i, index);
+    fe_cmov(r->x, table[i][0], mask);
+    fe_cmov(r->y, table[i][1], mask);
+  }
+
+  // entry 0 is the point at infinity, all others have z=1
+  fe_cmov(r->z, p256_one, ~ct_eq_mask(0, index));
+}
+
+// returns the bit |i| of the scalar |n|
+static inline uint32_t scalar_bit(const uint32_t* n, int i) {
+  return (n[i / DWORD_BITS] >> (i % DWORD_BITS)) & 1;
+}
+
+// converts |r| into the affine point |q| with dword coordinates
+static void p256_point_to_affine(Point* q, const p256_point* r) {
+  p256_fe z_inv, x, y;
+
+  fe_inv(z_inv, r->z);
+  fe_mul(x, r->x, z_inv);
+  fe_mul(y, r->y, z_inv);
+
+  fe_to_dwords(q->x, x);
+  fe_to_dwords(q->y, y);
+  multiprecision_init(q->z, KEY_LENGTH_DWORDS_P256);
+  q->z[0] = 1;
+}
+
+// Comb multiplication of the base point, with two tables of four teeth each
+// spaced 32 bits apart: 31 doublings and 64 additions.
+void ECC_PointMult_Base_Comb(Point* q, const uint32_t* n) {
+  p256_point r, t;
+
+  memset(&r, 0, sizeof(r));
+  memcpy(r.y, p256_one, sizeof(p256_fe));
+
+  for (int i = 31; i >= 0; i--) {
+    if (i != 31) p256_point_double(&r, &r);
+
+    uint32_t lo = scalar_bit(n, i) | (scalar_bit(n, i + 32) << 1) |
+                  (scalar_bit(n, i + 64) << 2) | (scalar_bit(n, i + 96) << 3);
+    uint32_t hi = scalar_bit(n, i + 128) | (scalar_bit(n, i + 160) << 1) |
+                  (scalar_bit(n, i + 192) << 2) |
+                  (scalar_bit(n, i + 224) << 3);
+
+    p256_select_comb_point(&t, comb_table_lo, lo);
+    p256_point_add(&r, &r, &t);
+    p256_select_comb_point(&t, comb_table_hi, hi);
+    p256_point_add(&r, &r, &t);
+  }
+
+  p256_point_to_affine(q, &r);
+  memset(&r, 0, sizeof(r));
+  memset(&t, 0, sizeof(t));
+}
+
+// Fixed 4-bit window multiplication of an arbitrary point: 252 doublings and
+// 64 additions, plus 15 additions to build the window table.
+void ECC_PointMult_Window(Point* q, const Point* p, const uint32_t* n) {
+  p256_point table[16];
+  p256_point r, t;
+
+  memset(&table[0], 0, sizeof(p256_point));
+  memcpy(table[0].y, p256_one, sizeof(p256_fe));
+  fe_from_dwords(table[1].x, p->x);
+  fe_from_dwords(table[1].y, p->y);
+  memcpy(table[1].z, p256_one, sizeof(p256_fe));
+  for (int i = 2; i < 16; i++)
+    p256_point_add(&table[i], &table[i - 1], &table[1]);
+
+  memcpy(&r, &table[0], sizeof(r));
+  for (int i = 63; i >= 0; i--) {
+    if (i != 63) {
+      for (int j = 0; j < 4; j++) p256_point_double(&r, &r);
+    }
+
+    uint32_t window = (n[i / 8] >> ((i % 8) * 4)) & 0x0F;
+    p256_select_point(&t, table, window);
+    p256_point_add(&r, &r, &t);
+  }
+
+  p256_point_to_affine(q, &r);
+  memset(table, 0, sizeof(table));
+  memset(&r, 0, sizeof(r));
+  memset(&t, 0, sizeof(t));
+}
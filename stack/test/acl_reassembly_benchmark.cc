@@ -0,0 +1,124 @@
+/******************************************************************************
+ * Copyright (c) 2026 Qualcomm Innovation Center, Inc. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ *
+ *******************************************************************************/
+
+#include <base/logging.h>
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <string.h>
+#include <vector>
+
+#include "buffer_allocator.h"
+#include "device/include/controller.h"
+#include "hci_internals.h"
+#include "l2c_acl_chain.h"
+#include "osi/include/osi.h"
+#include "packet_fragmenter.h"
+
+using ::benchmark::State;
+
+// Largest ACL payload of a DH5/3-DH5 baseband packet.
+#define DH5_ACL_DATA_SIZE 1021
+#define L2CAP_HEADER_SIZE 4
+#define TEST_HANDLE 0x0042
+
+static const packet_fragmenter_t* fragmenter;
+static const allocator_t* buffer_allocator;
+static size_t reassembled_count;
+
+// Takes the packet as L2CAP does before giving it to a channel.
+static void dispatch_reassembled(BT_HDR* packet) {
+  reassembled_count++;
+  l2c_acl_chain_free(l2c_acl_chain_flatten(packet));
+}
+
+static void transmit_fragment(UNUSED_ATTR BT_HDR* packet,
+                              UNUSED_ATTR bool send_transmit_finished) {}
+
+static void fragmenter_transmit_finished(UNUSED_ATTR BT_HDR* packet,
+                                         UNUSED_ATTR bool all_fragments_sent) {
+}
+
+static const packet_fragmenter_callbacks_t callbacks = {
+    transmit_fragment, dispatch_reassembled, fragmenter_transmit_finished};
+
+// Splits an L2CAP PDU with |sdu_length| octets of payload into ACL packets
+// carrying at most DH5_ACL_DATA_SIZE octets each, as received over HCI.
+static std::vector<std::vector<uint8_t>> make_acl_stream(size_t sdu_length) {
+  std::vector<uint8_t> l2cap(L2CAP_HEADER_SIZE + sdu_length);
+  uint8_t* stream = l2cap.data();
+  UINT16_TO_STREAM(stream, sdu_length);
+  UINT16_TO_STREAM(stream, 0x0040);  // dynamic channel id
+  for (size_t i = 0; i < sdu_length; i++) stream[i] = i;
+
+  std::vector<std::vector<uint8_t>> acl_packets;
+  for (size_t sent = 0; sent < l2cap.size(); sent += DH5_ACL_DATA_SIZE) {
+    size_t length = std::min<size_t>(DH5_ACL_DATA_SIZE, l2cap.size() - sent);
+    std::vector<uint8_t> acl(HCI_ACL_PREAMBLE_SIZE + length);
+    stream = acl.data();
+    UINT16_TO_STREAM(stream, TEST_HANDLE | (sent == 0 ? 0x2000 : 0x1000));
+    UINT16_TO_STREAM(stream, length);
+    memcpy(stream, l2cap.data() + sent, length);
+    acl_packets.push_back(acl);
+  }
+  return acl_packets;
+}
+
+// Wraps |acl| in a BT_HDR the way the HCI HAL callbacks do.
+static BT_HDR* wrap_packet(const std::vector<uint8_t>& acl) {
+  BT_HDR* packet = (BT_HDR*)buffer_allocator->alloc(acl.size() + BT_HDR_SIZE);
+  packet->event = MSG_HC_TO_STACK_HCI_ACL;
+  packet->len = acl.size();
+  packet->offset = 0;
+  packet->layer_specific = 0;
+  memcpy(packet->data, acl.data(), acl.size());
+  return packet;
+}
+
+// Reassembles a stream of L2CAP PDUs of |state.range(0)| octets, in the
+// packet_fragmenter_reassembly_mode_t |state.range(1)|.
+static void BM_Reassemble(State& state) {
+  buffer_allocator = buffer_allocator_get_interface();
+  packet_fragmenter_set_reassembly_mode(
+      static_cast<packet_fragmenter_reassembly_mode_t>(state.range(1)));
+  controller_t controller = {};
+  fragmenter = packet_fragmenter_get_test_interface(&controller,
+                                                    buffer_allocator);
+  fragmenter->init(&callbacks);
+
+  std::vector<std::vector<uint8_t>> acl_packets =
+      make_acl_stream(state.range(0));
+  reassembled_count = 0;
+
+  for (auto _ : state) {
+    for (const auto& acl : acl_packets)
+      fragmenter->reassemble_and_dispatch(wrap_packet(acl));
+  }
+
+  CHECK(reassembled_count == static_cast<size_t>(state.iterations()));
+  fragmenter->cleanup();
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_Reassemble)
+    ->Args({1017, PACKET_FRAGMENTER_REASSEMBLY_COPY})
+    ->Args({1017, PACKET_FRAGMENTER_REASSEMBLY_CHAIN})
+    ->Args({1691, PACKET_FRAGMENTER_REASSEMBLY_COPY})
+    ->Args({1691, PACKET_FRAGMENTER_REASSEMBLY_CHAIN})
+    ->Args({4080, PACKET_FRAGMENTER_REASSEMBLY_COPY})
+    ->Args({4080, PACKET_FRAGMENTER_REASSEMBLY_CHAIN});
+
+int main(int argc, char** argv) {
+  // Disable LOG() output from libchrome
+  logging::LoggingSettings log_settings;
+  log_settings.logging_dest = logging::LoggingDestination::LOG_NONE;
+  CHECK(logging::InitLogging(log_settings)) << "Failed to set up logging";
+  ::benchmark::Initialize(&argc, argv);
+  if (::benchmark::ReportUnrecognizedArguments(argc, argv)) {
+    return 1;
+  }
+  ::benchmark::RunSpecifiedBenchmarks();
+}
@@ -176,3 +176,77 @@ TEST(AdvertiseDataParserTest, RemoveTrailingZerosMalformed) {
 
   EXPECT_TRUE(AdvertiseDataParser::IsValid(glued));
 }
+
+TEST(AdvertiseDataParserTest, IndexGetFieldByType) {
+  // Flags, two 16 bit UUID fields and a second flags field.
+  const std::vector<uint8_t> data0{0x02, 0x01, 0x06, 0x03, 0x03, 0x12,
+                                   0x18, 0x03, 0x03, 0x0F, 0x18, 0x02,
+                                   0x01, 0x04};
+
+  AdvertiseDataFields fields;
+  AdvertiseDataParser::Index(data0.data(), data0.size(), &fields);
+  EXPECT_TRUE(fields.IsValid());
+  EXPECT_EQ(data0.data(), fields.data());
+  EXPECT_EQ(data0.size(), fields.size());
+
+  // The first field of a type is returned, as with GetFieldByType.
+  uint8_t p_length;
+  const uint8_t* data = fields.GetFieldByType(0x01, &p_length);
+  EXPECT_EQ(data0.data() + 2, data);
+  EXPECT_EQ(1, p_length);
+
+  data = fields.GetFieldByType(0x03, &p_length);
+  EXPECT_EQ(data0.data() + 5, data);
+  EXPECT_EQ(2, p_length);
+
+  data = fields.GetFieldByType(0x09, &p_length);
+  EXPECT_EQ(nullptr, data);
+  EXPECT_EQ(0, p_length);
+
+  // Two fields, second field length too long.
+  const std::vector<uint8_t> data1{0x02, 0x02, 0x00, 0x03, 0x00};
+  AdvertiseDataParser::Index(data1.data(), data1.size(), &fields);
+  EXPECT_FALSE(fields.IsValid());
+
+  data = fields.GetFieldByType(0x02, &p_length);
+  EXPECT_EQ(data1.data() + 2, data);
+  EXPECT_EQ(0x01, p_length);
+
+  data = fields.GetFieldByType(0x03, &p_length);
+  EXPECT_EQ(nullptr, data);
+  EXPECT_EQ(0, p_length);
+}
+
+// Checks that Index reports the same validity as IsValid.
+TEST(AdvertiseDataParserTest, IndexIsValid) {
+  const std::vector<std::vector<uint8_t>> samples{
+      {},
+      {0x00},
+      {0x01},
+      {0x03, 0x02, 0x01, 0x02, 0x02, 0x03, 0x01, 0x00},
+      {0x03, 0x02, 0x01, 0x02, 0x02, 0x03, 0x01, 0x00, 0xBA},
+      {0x02, 0x02, 0x00, 0x01},
+      // Traxxas quirk, scan response glued after advertise data
+      {0x02, 0x01, 0x06, 0x11, 0x06, 0x00, 0x00, 0x00, 0x00, 0x00,
+       0x00, 0x64, 0xB1, 0x73, 0x41, 0xE7, 0xF3, 0xC4, 0xB4, 0x80,
+       0x08, 0x14, 0x09, 0x54, 0x51, 0x69, 0x20, 0x42, 0x4C, 0x45,
+       0x05, 0x12, 0x60, 0x00, 0xE8, 0x03, 0x02, 0x0A, 0x00}};
+
+  for (const auto& sample : samples) {
+    AdvertiseDataFields fields;
+    AdvertiseDataParser::Index(sample.data(), sample.size(), &fields);
+    EXPECT_EQ(AdvertiseDataParser::IsValid(sample), fields.IsValid());
+  }
+}
+
+TEST(AdvertiseDataParserTest, TrimTrailingZeros) {
+  const std::vector<uint8_t> data0{0x03, 0x02, 0x01, 0x02, 0x02,
+                                   0x03, 0x01, 0x00, 0x00, 0x00};
+  EXPECT_EQ(7U, AdvertiseDataParser::TrimTrailingZeros(data0.data(),
+                                                       data0.size()));
+
+  // Nothing to trim, the last field length is too long.
+  const std::vector<uint8_t> data1{0x02, 0x02, 0x00, 0x03, 0x00};
+  EXPECT_EQ(data1.size(), AdvertiseDataParser::TrimTrailingZeros(
+                              data1.data(), data1.size()));
+}
@@ -0,0 +1,164 @@
+/******************************************************************************
+ * Copyright (c) 2026 Qualcomm Innovation Center, Inc. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ *
+ *******************************************************************************/
+
+#include <base/logging.h>
+#include <benchmark/benchmark.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "avrc_api.h"
+#include "avrc_int.h"
+#include "osi/include/allocator.h"
+
+using ::benchmark::State;
+
+// Items of the folder paged through, and items asked for by every command.
+#define NUM_ITEMS 10000
+#define ITEMS_PER_CMD 64
+#define ATTRS_PER_ITEM 2
+#define NAME_LEN 40
+
+tAVRC_CB avrc_cb; /*STUB*/
+
+static uint16_t browse_mtu;
+
+/* Below are methods that must be implemented if we don't want to compile the
+ * whole stack. */
+void LogMsg(uint32_t trace_set_mask, const char* fmt_str, ...) {}
+void vnd_LogMsg(uint32_t trace_set_mask, const char* fmt_str, ...) {}
+uint16_t AVCT_GetBrowseMtu(uint8_t handle) { return browse_mtu; }
+
+static tAVRC_ITEM items[NUM_ITEMS];
+static tAVRC_ATTR_ENTRY attrs[NUM_ITEMS][ATTRS_PER_ITEM];
+static uint8_t names[NUM_ITEMS][ATTRS_PER_ITEM + 1][NAME_LEN];
+
+// Builds a folder of media items with a title and an artist each, as the
+// player gives them to btif_rc.
+static void build_folder() {
+  static bool built = false;
+  if (built) return;
+  built = true;
+
+  for (int i = 0; i < NUM_ITEMS; i++) {
+    tAVRC_ITEM_MEDIA* p_media = &items[i].u.media;
+    items[i].item_type = AVRC_ITEM_MEDIA;
+    memcpy(p_media->uid, &i, sizeof(i));
+    p_media->type = AVRC_MEDIA_TYPE_AUDIO;
+    p_media->name.charset_id = AVRC_CHARSET_ID_UTF8;
+    p_media->name.str_len =
+        snprintf((char*)names[i][0], NAME_LEN, "Track %05d of the album", i);
+    p_media->name.p_str = names[i][0];
+    for (int j = 0; j < ATTRS_PER_ITEM; j++) {
+      attrs[i][j].attr_id = AVRC_MEDIA_ATTR_ID_TITLE + j;
+      attrs[i][j].name.charset_id = AVRC_CHARSET_ID_UTF8;
+      attrs[i][j].name.str_len = snprintf((char*)names[i][j + 1], NAME_LEN,
+                                          "Attribute %d of track %05d", j, i);
+      attrs[i][j].name.p_str = names[i][j + 1];
+    }
+    p_media->attr_count = ATTRS_PER_ITEM;
+    p_media->p_attr_list = attrs[i];
+  }
+}
+
+static uint16_t rsp_item_count(BT_HDR* p_pkt) {
+  uint8_t* p = (uint8_t*)(p_pkt + 1) + p_pkt->offset + 6;
+  uint16_t item_count;
+  BE_STREAM_TO_UINT16(item_count, p);
+  return item_count;
+}
+
+// Answers the command for the items start_item onwards the way
+// get_folder_items_list_rsp() did before the item cache: the items are added
+// one at a time until the response is full.
+static BT_HDR* build_rsp_legacy(uint32_t start_item) {
+  tAVRC_RESPONSE rsp;
+  BT_HDR* p_pkt = NULL;
+
+  memset(&rsp, 0, sizeof(rsp));
+  rsp.get_items.pdu = AVRC_PDU_GET_FOLDER_ITEMS;
+  rsp.get_items.opcode = AVRC_OP_BROWSE;
+  rsp.get_items.status = AVRC_STS_NO_ERROR;
+  rsp.get_items.uid_counter = 1;
+  rsp.get_items.item_count = 1;
+  for (uint32_t i = start_item;
+       i < start_item + ITEMS_PER_CMD && i < NUM_ITEMS; i++) {
+    rsp.get_items.p_item_list = &items[i];
+    uint16_t len_before = p_pkt ? p_pkt->len : 0;
+    if (AVRC_BldResponse(0, &rsp, &p_pkt) != AVRC_STS_NO_ERROR ||
+        p_pkt->len == len_before)
+      break;
+  }
+  return p_pkt;
+}
+
+// Pages through the whole folder, every command asking for the items after
+// the last one received, up to the end of the folder known from the Change
+// Path response. Returns the number of responses.
+template <typename F>
+static int page_folder(F build_rsp) {
+  int responses = 0;
+  for (uint32_t start_item = 0; start_item < NUM_ITEMS; responses++) {
+    BT_HDR* p_pkt = build_rsp(start_item);
+    CHECK(p_pkt != NULL);
+    uint16_t item_count = rsp_item_count(p_pkt);
+    CHECK(item_count > 0);
+    benchmark::DoNotOptimize(p_pkt);
+    osi_free(p_pkt);
+    start_item += item_count;
+  }
+  return responses;
+}
+
+static tAVRC_ITEM_CACHE* fill_cache() {
+  tAVRC_ITEM_CACHE* p_cache = AVRC_ItemCacheNew();
+  for (uint32_t i = 0; i < NUM_ITEMS; i++)
+    AVRC_ItemCacheStore(p_cache, AVRC_SCOPE_FILE_SYSTEM, 0, 1, i, &items[i]);
+  return p_cache;
+}
+
+// The items processed are the items of the folder, at the browsing MTU of
+// the argument.
+static void BM_AvrcFolderItemsLegacy(State& state) {
+  build_folder();
+  browse_mtu = state.range(0);
+  int responses = 0;
+  for (auto _ : state) responses = page_folder(build_rsp_legacy);
+  state.counters["responses"] = responses;
+  state.SetItemsProcessed(state.iterations() * NUM_ITEMS);
+}
+BENCHMARK(BM_AvrcFolderItemsLegacy)->Arg(672)->Arg(2048);
+
+// Every response is a slice of the items cached from earlier responses.
+static void BM_AvrcFolderItemsCached(State& state) {
+  build_folder();
+  browse_mtu = state.range(0);
+  tAVRC_ITEM_CACHE* p_cache = fill_cache();
+  int responses = 0;
+  for (auto _ : state) {
+    responses = page_folder([p_cache](uint32_t start_item) {
+      BT_HDR* p_pkt = NULL;
+      uint32_t end_item = start_item + ITEMS_PER_CMD - 1;
+      if (end_item >= NUM_ITEMS) end_item = NUM_ITEMS - 1;
+      AVRC_ItemCacheBldRsp(p_cache, 0, AVRC_SCOPE_FILE_SYSTEM, 0, start_item,
+                           end_item, &p_pkt);
+      return p_pkt;
+    });
+  }
+  AVRC_ItemCacheFree(p_cache);
+  state.counters["responses"] = responses;
+  state.SetItemsProcessed(state.iterations() * NUM_ITEMS);
+}
+BENCHMARK(BM_AvrcFolderItemsCached)->Arg(672)->Arg(2048);
+
+// Cost of caching the items as the player gives them.
+static void BM_AvrcFolderItemsCacheFill(State& state) {
+  build_folder();
+  for (auto _ : state) AVRC_ItemCacheFree(fill_cache());
+  state.SetItemsProcessed(state.iterations() * NUM_ITEMS);
+}
+BENCHMARK(BM_AvrcFolderItemsCacheFill);
+
+BENCHMARK_MAIN();
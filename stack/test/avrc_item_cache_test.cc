@@ -0,0 +1,279 @@
+/******************************************************************************
+ * Copyright (c) 2026 Qualcomm Innovation Center, Inc. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ *
+ *******************************************************************************/
+
+#include <gtest/gtest.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "avrc_api.h"
+#include "avrc_int.h"
+#include "osi/include/allocator.h"
+
+#define NUM_ITEMS 200
+#define MAX_ATTRS 3
+#define NAME_LEN 40
+#define LONG_ATTR_LEN 700
+#define UID_COUNTER 7
+#define ATTR_KEY 3
+// Its attribute is not valid, so the item is never cached
+#define INVALID_ITEM 151
+
+tAVRC_CB avrc_cb; /*STUB*/
+
+static uint16_t browse_mtu;
+
+/* Below are methods that must be implemented if we don't want to compile the
+ * whole stack. */
+void LogMsg(uint32_t trace_set_mask, const char* fmt_str, ...) {}
+void vnd_LogMsg(uint32_t trace_set_mask, const char* fmt_str, ...) {}
+uint16_t AVCT_GetBrowseMtu(uint8_t handle) { return browse_mtu; }
+
+static tAVRC_ITEM items[NUM_ITEMS];
+static tAVRC_ATTR_ENTRY attrs[NUM_ITEMS][MAX_ATTRS];
+static uint8_t names[NUM_ITEMS][MAX_ATTRS + 1][LONG_ATTR_LEN];
+
+// Every fifth item is a folder, the others are media items with up to
+// MAX_ATTRS attributes. Every sixteenth item has an attribute that is too long
+// for a response at the smaller MTUs.
+static void build_folder() {
+  static bool built = false;
+  if (built) return;
+  built = true;
+
+  for (int i = 0; i < NUM_ITEMS; i++) {
+    tAVRC_ITEM* p_item = &items[i];
+    uint16_t name_len = snprintf((char*)names[i][0], NAME_LEN, "Item %d %.*s",
+                                 i, i % 24, "of the folder being paged");
+    if (i % 5 == 0) {
+      tAVRC_ITEM_FOLDER* p_folder = &p_item->u.folder;
+      p_item->item_type = AVRC_ITEM_FOLDER;
+      memcpy(p_folder->uid, &i, sizeof(i));
+      p_folder->type = AVRC_FOLDER_TYPE_ALNUMS;
+      p_folder->playable = true;
+      p_folder->name.charset_id = AVRC_CHARSET_ID_UTF8;
+      p_folder->name.str_len = name_len;
+      p_folder->name.p_str = names[i][0];
+      continue;
+    }
+
+    tAVRC_ITEM_MEDIA* p_media = &p_item->u.media;
+    p_item->item_type = AVRC_ITEM_MEDIA;
+    memcpy(p_media->uid, &i, sizeof(i));
+    p_media->type = AVRC_MEDIA_TYPE_AUDIO;
+    p_media->name.charset_id = AVRC_CHARSET_ID_UTF8;
+    p_media->name.str_len = name_len;
+    p_media->name.p_str = names[i][0];
+    p_media->attr_count = i % (MAX_ATTRS + 1);
+    p_media->p_attr_list = attrs[i];
+    for (int j = 0; j < p_media->attr_count; j++) {
+      tAVRC_ATTR_ENTRY* p_attr = &attrs[i][j];
+      p_attr->attr_id = AVRC_MEDIA_ATTR_ID_TITLE + j;
+      p_attr->name.charset_id = AVRC_CHARSET_ID_UTF8;
+      if (i % 16 == 1 && j == 0) {
+        memset(names[i][j + 1], 'a' + i % 26, LONG_ATTR_LEN);
+        p_attr->name.str_len = LONG_ATTR_LEN;
+      } else {
+        p_attr->name.str_len = snprintf((char*)names[i][j + 1], NAME_LEN,
+                                        "Attribute %d of item %d", j, i);
+      }
+      p_attr->name.p_str = names[i][j + 1];
+    }
+  }
+  attrs[INVALID_ITEM][0].name.p_str = NULL;
+}
+
+// Answers the command for the items start_item to end_item the way
+// get_folder_items_list_rsp() does without the cache: the items are added one
+// at a time until the response is full.
+static BT_HDR* build_rsp_legacy(uint32_t start_item, uint32_t end_item) {
+  tAVRC_RESPONSE rsp;
+  BT_HDR* p_pkt = NULL;
+
+  memset(&rsp, 0, sizeof(rsp));
+  rsp.get_items.pdu = AVRC_PDU_GET_FOLDER_ITEMS;
+  rsp.get_items.opcode = AVRC_OP_BROWSE;
+  rsp.get_items.status = AVRC_STS_NO_ERROR;
+  rsp.get_items.uid_counter = UID_COUNTER;
+  rsp.get_items.item_count = 1;
+  for (uint32_t i = start_item; i <= end_item && i < NUM_ITEMS; i++) {
+    rsp.get_items.p_item_list = &items[i];
+    uint16_t len_before = p_pkt ? p_pkt->len : 0;
+    if (AVRC_BldResponse(0, &rsp, &p_pkt) != AVRC_STS_NO_ERROR ||
+        p_pkt->len == len_before)
+      break;
+  }
+  return p_pkt;
+}
+
+static tAVRC_ITEM_CACHE* fill_cache() {
+  tAVRC_ITEM_CACHE* p_cache = AVRC_ItemCacheNew();
+  for (uint32_t i = 0; i < NUM_ITEMS; i++)
+    AVRC_ItemCacheStore(p_cache, AVRC_SCOPE_FILE_SYSTEM, ATTR_KEY, UID_COUNTER,
+                        i, &items[i]);
+  return p_cache;
+}
+
+static bool build_rsp_cached(tAVRC_ITEM_CACHE* p_cache, uint32_t start_item,
+                             uint32_t end_item, BT_HDR** pp_pkt) {
+  return AVRC_ItemCacheBldRsp(p_cache, 0, AVRC_SCOPE_FILE_SYSTEM, ATTR_KEY,
+                              start_item, end_item, pp_pkt);
+}
+
+static void expect_same_packet(BT_HDR* p_legacy, BT_HDR* p_cached) {
+  ASSERT_NE(p_legacy, nullptr);
+  ASSERT_EQ(p_legacy->len, p_cached->len);
+  ASSERT_EQ(p_legacy->offset, p_cached->offset);
+  ASSERT_EQ(p_legacy->layer_specific, p_cached->layer_specific);
+  ASSERT_EQ(0, memcmp((uint8_t*)(p_legacy + 1) + p_legacy->offset,
+                      (uint8_t*)(p_cached + 1) + p_cached->offset,
+                      p_legacy->len));
+}
+
+// Every response served from the cache is the one the legacy builder gives,
+// whatever the range: from the start of a page, across pages, ending in the
+// middle of one, or ending with an item that doesn't fit.
+TEST(AvrcItemCacheTest, responsesMatchLegacyBuilder) {
+  build_folder();
+  const uint16_t mtus[] = {48, 672, 2048};
+  const uint32_t lengths[] = {1, 2, 10, 33, 64, 200};
+
+  for (uint16_t mtu : mtus) {
+    browse_mtu = mtu;
+    tAVRC_ITEM_CACHE* p_cache = fill_cache();
+    int served = 0;
+
+    for (uint32_t start_item = 0; start_item < NUM_ITEMS; start_item++) {
+      for (uint32_t length : lengths) {
+        uint32_t end_item = start_item + length - 1;
+        BT_HDR* p_cached = NULL;
+        if (!build_rsp_cached(p_cache, start_item, end_item, &p_cached))
+          continue;
+        served++;
+
+        BT_HDR* p_legacy = build_rsp_legacy(start_item, end_item);
+        SCOPED_TRACE(testing::Message() << "mtu " << mtu << " items "
+                                        << start_item << "-" << end_item);
+        expect_same_packet(p_legacy, p_cached);
+        osi_free(p_legacy);
+        osi_free(p_cached);
+      }
+    }
+
+    // No item fits in a response at the smallest MTU
+    if (mtu == 48)
+      EXPECT_EQ(served, 0);
+    else
+      EXPECT_GT(served, 0);
+    AVRC_ItemCacheFree(p_cache);
+  }
+}
+
+// The player is asked for the items when the first one doesn't fit in the
+// response, or when an item that is not cached comes before the response is
+// full.
+TEST(AvrcItemCacheTest, itemsNotServedFallBackToPlayer) {
+  build_folder();
+  browse_mtu = 672;
+  tAVRC_ITEM_CACHE* p_cache = fill_cache();
+  BT_HDR* p_pkt = NULL;
+
+  // Item 17 has an attribute longer than the MTU
+  EXPECT_FALSE(build_rsp_cached(p_cache, 17, 20, &p_pkt));
+  EXPECT_FALSE(build_rsp_cached(p_cache, INVALID_ITEM, INVALID_ITEM, &p_pkt));
+  EXPECT_FALSE(
+      build_rsp_cached(p_cache, INVALID_ITEM - 1, INVALID_ITEM, &p_pkt));
+  EXPECT_FALSE(build_rsp_cached(p_cache, NUM_ITEMS - 1, NUM_ITEMS, &p_pkt));
+
+  // The response ends before an item that doesn't fit
+  ASSERT_TRUE(build_rsp_cached(p_cache, 15, 20, &p_pkt));
+  BT_HDR* p_legacy = build_rsp_legacy(15, 20);
+  expect_same_packet(p_legacy, p_pkt);
+  osi_free(p_legacy);
+  osi_free(p_pkt);
+
+  AVRC_ItemCacheFree(p_cache);
+}
+
+// Items cached for other attributes, another UID counter or before the scope
+// was invalidated are not served.
+TEST(AvrcItemCacheTest, staleItemsNotServed) {
+  build_folder();
+  browse_mtu = 2048;
+  tAVRC_ITEM_CACHE* p_cache = fill_cache();
+  BT_HDR* p_pkt = NULL;
+
+  ASSERT_TRUE(build_rsp_cached(p_cache, 0, 9, &p_pkt));
+  osi_free(p_pkt);
+  EXPECT_FALSE(AVRC_ItemCacheBldRsp(p_cache, 0, AVRC_SCOPE_FILE_SYSTEM,
+                                    ATTR_KEY + 1, 0, 9, &p_pkt));
+  EXPECT_FALSE(AVRC_ItemCacheBldRsp(p_cache, 0, AVRC_SCOPE_SEARCH, ATTR_KEY,
+                                    0, 9, &p_pkt));
+
+  // An item given for a new UID counter drops the others
+  AVRC_ItemCacheStore(p_cache, AVRC_SCOPE_FILE_SYSTEM, ATTR_KEY,
+                      UID_COUNTER + 1, 0, &items[0]);
+  EXPECT_FALSE(build_rsp_cached(p_cache, 0, 9, &p_pkt));
+
+  AVRC_ItemCacheInvalidate(p_cache, AVRC_ITEM_CACHE_ALL_SCOPES);
+  EXPECT_FALSE(build_rsp_cached(p_cache, 0, 0, &p_pkt));
+
+  AVRC_ItemCacheFree(p_cache);
+}
+
+// Items are cached whatever their index in the folder.
+TEST(AvrcItemCacheTest, itemsOfLargeFoldersCached) {
+  build_folder();
+  browse_mtu = 2048;
+  const uint32_t kFirstItem = 100000;
+  tAVRC_ITEM_CACHE* p_cache = AVRC_ItemCacheNew();
+  for (uint32_t i = 0; i < 40; i++)
+    AVRC_ItemCacheStore(p_cache, AVRC_SCOPE_FILE_SYSTEM, ATTR_KEY, UID_COUNTER,
+                        kFirstItem + i, &items[i]);
+
+  BT_HDR* p_pkt = NULL;
+  ASSERT_TRUE(
+      build_rsp_cached(p_cache, kFirstItem + 2, kFirstItem + 39, &p_pkt));
+  BT_HDR* p_legacy = build_rsp_legacy(2, 39);
+  expect_same_packet(p_legacy, p_pkt);
+  osi_free(p_legacy);
+  osi_free(p_pkt);
+
+  AVRC_ItemCacheFree(p_cache);
+}
+
+// When the pages of a scope take all the room of the cache, the least
+// recently used one is dropped for a new one.
+TEST(AvrcItemCacheTest, leastRecentlyUsedPagesDropped) {
+  build_folder();
+  browse_mtu = 2048;
+  // More pages than fit, as every page is larger than its data
+  const uint32_t kPages =
+      AVRC_ITEM_CACHE_MAX_BYTES / AVRC_ITEM_CACHE_PAGE_SIZE + 2;
+  const uint32_t kPageItems = AVRC_ITEM_CACHE_PAGE_ITEMS;
+  tAVRC_ITEM_CACHE* p_cache = AVRC_ItemCacheNew();
+  BT_HDR* p_pkt = NULL;
+
+  for (uint32_t page = 0; page < kPages; page++) {
+    AVRC_ItemCacheStore(p_cache, AVRC_SCOPE_FILE_SYSTEM, ATTR_KEY, UID_COUNTER,
+                        page * kPageItems, &items[2]);
+    // The first page is browsed all along
+    ASSERT_TRUE(build_rsp_cached(p_cache, 0, 0, &p_pkt)) << "page " << page;
+    osi_free(p_pkt);
+  }
+
+  EXPECT_FALSE(build_rsp_cached(p_cache, kPageItems, kPageItems, &p_pkt));
+  uint32_t last_item = (kPages - 1) * kPageItems;
+  ASSERT_TRUE(build_rsp_cached(p_cache, last_item, last_item, &p_pkt));
+  osi_free(p_pkt);
+
+  // A dropped item is cached again when the player gives it again
+  AVRC_ItemCacheStore(p_cache, AVRC_SCOPE_FILE_SYSTEM, ATTR_KEY, UID_COUNTER,
+                      kPageItems, &items[2]);
+  ASSERT_TRUE(build_rsp_cached(p_cache, kPageItems, kPageItems, &p_pkt));
+  osi_free(p_pkt);
+
+  AVRC_ItemCacheFree(p_cache);
+}
@@ -0,0 +1,292 @@
+/******************************************************************************
+ * Copyright (c) 2026 Qualcomm Innovation Center, Inc. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ *
+ *******************************************************************************/
+
+#include <base/logging.h>
+#include <benchmark/benchmark.h>
+#include <stdlib.h>
+#include <atomic>
+#include <list>
+#include <new>
+#include <random>
+#include <vector>
+
+#include "advertise_data_parser.h"
+#include "bt_types.h"
+#include "btm_ble_adv_cache.h"
+#include "hcidefs.h"
+#include "btm_ble_api_types.h"
+
+using ::benchmark::State;
+
+// Number of advertising reports in the replayed scan flood.
+#define FLOOD_REPORTS 10000
+#define LEGACY_ADV_DATA_LEN 31
+#define MANUFACTURER_DATA_TYPE 0xFF
+
+// Counts heap allocations so that the benchmarks can report them per report.
+static std::atomic<size_t> allocation_count(0);
+
+void* operator new(size_t size) {
+  allocation_count++;
+  void* ptr = malloc(size);
+  if (ptr == NULL) throw std::bad_alloc();
+  return ptr;
+}
+
+void operator delete(void* ptr) noexcept { free(ptr); }
+
+typedef struct {
+  bool is_start;  // ADV_IND or ADV_SCAN_IND
+  bool is_scan_resp;
+  uint8_t addr_type;
+  RawAddress bda;
+  uint8_t data_len;
+  uint8_t data[LEGACY_ADV_DATA_LEN];
+} adv_report_t;
+
+// Appends an AD structure of |type| holding |len| octets to |report|.
+static void add_field(adv_report_t* report, uint8_t type, uint8_t len,
+                      std::mt19937& generator) {
+  report->data[report->data_len++] = len + 1;
+  report->data[report->data_len++] = type;
+  for (uint8_t i = 0; i < len; i++)
+    report->data[report->data_len++] = generator();
+}
+
+// Builds the legacy advertising reports of an active scan in a crowded place,
+// |advertisers| devices sending either connectable advertisements followed by
+// a scan response, or non connectable beacons. Reports carry zero padding up
+// to the full legacy advertising data length, as many devices send them.
+static std::vector<adv_report_t> make_scan_flood(size_t advertisers) {
+  std::mt19937 generator(advertisers);
+  std::vector<adv_report_t> flood;
+
+  while (flood.size() < FLOOD_REPORTS) {
+    size_t device = generator() % advertisers;
+    bool connectable = device % 4 != 0;
+
+    adv_report_t report = {};
+    report.is_start = connectable;
+    report.addr_type = BLE_ADDR_RANDOM;
+    report.bda = RawAddress({0xC0, 0x11, 0x22, 0x33, (uint8_t)(device >> 8),
+                             (uint8_t)device});
+    add_field(&report, BTM_BLE_AD_TYPE_FLAG, 1, generator);
+    report.data[2] = BTM_BLE_GEN_DISC_FLAG | BTM_BLE_BREDR_NOT_SPT;
+    add_field(&report, BTM_BLE_AD_TYPE_16SRV_CMPL, 4, generator);
+    add_field(&report, MANUFACTURER_DATA_TYPE, 12, generator);
+    memset(report.data + report.data_len, 0,
+           LEGACY_ADV_DATA_LEN - report.data_len);
+    report.data_len = LEGACY_ADV_DATA_LEN;
+    flood.push_back(report);
+
+    if (!connectable) continue;
+
+    adv_report_t scan_resp = {};
+    scan_resp.is_scan_resp = true;
+    scan_resp.addr_type = report.addr_type;
+    scan_resp.bda = report.bda;
+    add_field(&scan_resp, BTM_BLE_AD_TYPE_NAME_CMPL, 10, generator);
+    add_field(&scan_resp, BTM_BLE_AD_TYPE_APPEARANCE, 2, generator);
+    flood.push_back(scan_resp);
+  }
+  return flood;
+}
+
+// The advertising cache as it was before it kept its data in preallocated
+// storage, kept here as a baseline.
+class LegacyAdvertisingCache {
+ public:
+  const std::vector<uint8_t>& Set(uint8_t addr_type, const RawAddress& addr,
+                                  std::vector<uint8_t> data) {
+    auto it = Find(addr_type, addr);
+    if (it != items.end()) {
+      it->data = std::move(data);
+      return it->data;
+    }
+
+    if (items.size() > cache_max) {
+      items.pop_back();
+    }
+
+    items.emplace_front(addr_type, addr, std::move(data));
+    return items.front().data;
+  }
+
+  const std::vector<uint8_t>& Append(uint8_t addr_type, const RawAddress& addr,
+                                     std::vector<uint8_t> data) {
+    auto it = Find(addr_type, addr);
+    if (it != items.end()) {
+      it->data.insert(it->data.end(), data.begin(), data.end());
+      return it->data;
+    }
+
+    if (items.size() > cache_max) {
+      items.pop_back();
+    }
+
+    items.emplace_front(addr_type, addr, std::move(data));
+    return items.front().data;
+  }
+
+  void Clear(uint8_t addr_type, const RawAddress& addr) {
+    auto it = Find(addr_type, addr);
+    if (it != items.end()) {
+      items.erase(it);
+    }
+  }
+
+ private:
+  struct Item {
+    uint8_t addr_type;
+    RawAddress addr;
+    std::vector<uint8_t> data;
+
+    Item(uint8_t addr_type, const RawAddress& addr, std::vector<uint8_t> data)
+        : addr_type(addr_type), addr(addr), data(data) {}
+  };
+
+  std::list<Item>::iterator Find(uint8_t addr_type, const RawAddress& addr) {
+    for (auto it = items.begin(); it != items.end(); it++) {
+      if (it->addr_type == addr_type && it->addr == addr) {
+        return it;
+      }
+    }
+    return items.end();
+  }
+
+  const size_t cache_max = 7;
+  std::list<Item> items;
+};
+
+// Handles the advertising data of |report| the way
+// btm_ble_process_adv_pkt_cont() did before reports were indexed: copied into
+// vectors and parsed again for every field looked up. Returns the flags.
+static uint8_t process_report_legacy(LegacyAdvertisingCache& cache,
+                                     const adv_report_t& report) {
+  std::vector<uint8_t> tmp(report.data, report.data + report.data_len);
+  AdvertiseDataParser::RemoveTrailingZeros(tmp);
+
+  std::vector<uint8_t> adv_data =
+      report.is_start ? cache.Set(report.addr_type, report.bda, std::move(tmp))
+                      : cache.Append(report.addr_type, report.bda,
+                                     std::move(tmp));
+  if (report.is_start) return 0;  // Waiting for scan response
+
+  uint8_t len, flag = 0;
+  if (AdvertiseDataParser::GetFieldByType(adv_data, BTM_BLE_AD_TYPE_ED, &len) &&
+      !AdvertiseDataParser::IsValid(adv_data))
+    return 0;
+  if (!AdvertiseDataParser::IsValid(adv_data)) return 0;
+  AdvertiseDataParser::GetFieldByType(adv_data, BTM_BLE_AD_TYPE_RSI, &len);
+
+  // btm_ble_update_inq_result()
+  const uint8_t* p_flag =
+      AdvertiseDataParser::GetFieldByType(adv_data, BTM_BLE_AD_TYPE_FLAG, &len);
+  if (p_flag != NULL && len != 0) flag = *p_flag;
+  if (!AdvertiseDataParser::GetFieldByType(adv_data, BTM_BLE_AD_TYPE_APPEARANCE,
+                                           &len))
+    AdvertiseDataParser::GetFieldByType(adv_data, BTM_BLE_AD_TYPE_16SRV_CMPL,
+                                        &len);
+  AdvertiseDataParser::GetFieldByType(adv_data, BTM_CSIP_RSI_TYPE, &len);
+
+  // btm_ble_is_discoverable()
+  p_flag =
+      AdvertiseDataParser::GetFieldByType(adv_data, BTM_BLE_AD_TYPE_FLAG, &len);
+  if (p_flag != NULL && len != 0) flag |= *p_flag;
+
+  cache.Clear(report.addr_type, report.bda);
+  return flag;
+}
+
+// Handles the advertising data of |report| the way
+// btm_ble_process_adv_pkt_cont() does. Returns the flags.
+static uint8_t process_report(AdvertisingCache& cache,
+                              const adv_report_t& report) {
+  size_t pkt_data_len =
+      AdvertiseDataParser::TrimTrailingZeros(report.data, report.data_len);
+
+  size_t adv_data_len;
+  const uint8_t* adv_data =
+      report.is_start ? cache.Set(report.addr_type, report.bda, report.data,
+                                  pkt_data_len, &adv_data_len)
+                      : cache.Append(report.addr_type, report.bda, report.data,
+                                     pkt_data_len, &adv_data_len);
+  if (report.is_start) return 0;  // Waiting for scan response
+
+  AdvertiseDataFields adv_fields;
+  AdvertiseDataParser::Index(adv_data, adv_data_len, &adv_fields);
+
+  uint8_t len, flag = 0;
+  if (adv_fields.GetFieldByType(BTM_BLE_AD_TYPE_ED, &len) &&
+      !adv_fields.IsValid())
+    return 0;
+  if (!adv_fields.IsValid()) return 0;
+  adv_fields.GetFieldByType(BTM_BLE_AD_TYPE_RSI, &len);
+
+  // btm_ble_update_inq_result()
+  const uint8_t* p_flag =
+      adv_fields.GetFieldByType(BTM_BLE_AD_TYPE_FLAG, &len);
+  if (p_flag != NULL && len != 0) flag = *p_flag;
+  if (!adv_fields.GetFieldByType(BTM_BLE_AD_TYPE_APPEARANCE, &len))
+    adv_fields.GetFieldByType(BTM_BLE_AD_TYPE_16SRV_CMPL, &len);
+  adv_fields.GetFieldByType(BTM_CSIP_RSI_TYPE, &len);
+
+  // btm_ble_is_discoverable()
+  p_flag = adv_fields.GetFieldByType(BTM_BLE_AD_TYPE_FLAG, &len);
+  if (p_flag != NULL && len != 0) flag |= *p_flag;
+
+  cache.Clear(report.addr_type, report.bda);
+  return flag;
+}
+
+// Replays a scan flood from |state.range(0)| advertisers.
+static void BM_ProcessAdvReportsLegacy(State& state) {
+  std::vector<adv_report_t> flood = make_scan_flood(state.range(0));
+  LegacyAdvertisingCache cache;
+
+  size_t allocations = allocation_count;
+  for (auto _ : state) {
+    for (const adv_report_t& report : flood)
+      benchmark::DoNotOptimize(process_report_legacy(cache, report));
+  }
+  allocations = allocation_count - allocations;
+
+  state.SetItemsProcessed(state.iterations() * flood.size());
+  state.counters["allocs_per_report"] =
+      (double)allocations / (state.iterations() * flood.size());
+}
+
+static void BM_ProcessAdvReports(State& state) {
+  std::vector<adv_report_t> flood = make_scan_flood(state.range(0));
+  static AdvertisingCache cache;
+
+  size_t allocations = allocation_count;
+  for (auto _ : state) {
+    for (const adv_report_t& report : flood)
+      benchmark::DoNotOptimize(process_report(cache, report));
+  }
+  allocations = allocation_count - allocations;
+
+  CHECK(allocations == 0) << "advertising reports allocated memory";
+  state.SetItemsProcessed(state.iterations() * flood.size());
+  state.counters["allocs_per_report"] =
+      (double)allocations / (state.iterations() * flood.size());
+}
+
+BENCHMARK(BM_ProcessAdvReportsLegacy)->Arg(10)->Arg(200);
+BENCHMARK(BM_ProcessAdvReports)->Arg(10)->Arg(200);
+
+int main(int argc, char** argv) {
+  // Disable LOG() output from libchrome
+  logging::LoggingSettings log_settings;
+  log_settings.logging_dest = logging::LoggingDestination::LOG_NONE;
+  CHECK(logging::InitLogging(log_settings)) << "Failed to set up logging";
+  ::benchmark::Initialize(&argc, argv);
+  if (::benchmark::ReportUnrecognizedArguments(argc, argv)) {
+    return 1;
+  }
+  ::benchmark::RunSpecifiedBenchmarks();
+}
@@ -0,0 +1,201 @@
+/******************************************************************************
+ * Copyright (c) 2026 Qualcomm Innovation Center, Inc. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ *
+ *******************************************************************************/
+
+#include <base/logging.h>
+#include <benchmark/benchmark.h>
+#include <string.h>
+#include <random>
+#include <vector>
+
+#include "btm_int.h"
+#include "device/include/controller.h"
+#include "hcimsgs.h"
+#include "osi/include/allocator.h"
+#include "osi/include/list.h"
+#include "stack/crypto_toolbox/crypto_toolbox.h"
+
+using ::benchmark::State;
+
+// Number of bonded devices with an IRK.
+#define BONDED_DEVICES 200
+// Number of distinct resolvable private addresses seen while scanning.
+#define DISTINCT_RPAS 1000
+// One in |BONDED_RPA_RATIO| of the addresses belongs to a bonded device.
+#define BONDED_RPA_RATIO 10
+// Number of advertising reports in the replayed trace.
+#define TRACE_REPORTS 20000
+
+tBTM_CB btm_cb; /*STUB*/
+
+/* Below are methods that must be implemented if we don't want to compile the
+ * whole stack. */
+void LogMsg(uint32_t trace_set_mask, const char* fmt_str, ...) {}
+void vnd_LogMsg(uint32_t trace_set_mask, const char* fmt_str, ...) {}
+const controller_t* controller_get_interface() { return NULL; }
+tBTM_SEC_DEV_REC* btm_find_dev(const RawAddress& bd_addr) { return NULL; }
+void btm_dev_index_update(tBTM_SEC_DEV_REC* p_dev_rec) {}
+tACL_CONN* btm_bda_to_acl(const RawAddress& bda, tBT_TRANSPORT transport) {
+  return NULL;
+}
+const Octet16& BTM_GetDeviceIDRoot() { return btm_cb.devcb.id_keys.ir; }
+void btsnd_hcic_ble_rand(base::Callback<void(BT_OCTET8)> cb) {}
+void btm_ble_set_random_address(const RawAddress& random_bda) {}
+void btm_ble_refresh_raddr_timer_timeout(void* data) {}
+tBTM_STATUS btm_ble_read_resolving_list_entry(tBTM_SEC_DEV_REC* p_dev_rec) {
+  return BTM_SUCCESS;
+}
+
+extern RawAddress generate_rpa_from_irk_and_rand(const Octet16& irk,
+                                                 BT_OCTET8 random);
+
+static std::vector<RawAddress> distinct_rpas;
+static std::vector<tBTM_SEC_DEV_REC*> rpa_owners;
+
+// Fills the security database with |BONDED_DEVICES| LE devices holding an
+// IRK, and makes up |DISTINCT_RPAS| addresses, a few of them from the IRKs.
+static void populate_dev_db() {
+  std::mt19937 generator(BONDED_DEVICES);
+  btm_cb.sec_dev_rec = list_new(osi_free);
+
+  std::vector<tBTM_SEC_DEV_REC*> bonded;
+  for (size_t i = 0; i < BONDED_DEVICES; i++) {
+    tBTM_SEC_DEV_REC* p_dev_rec =
+        (tBTM_SEC_DEV_REC*)osi_calloc(sizeof(tBTM_SEC_DEV_REC));
+    p_dev_rec->bd_addr = RawAddress({0x00, 0x1B, 0xDC, 0x00, (uint8_t)(i >> 8),
+                                     (uint8_t)i});
+    p_dev_rec->device_type = BT_DEVICE_TYPE_BLE;
+    p_dev_rec->ble.key_type = BTM_LE_KEY_PENC | BTM_LE_KEY_PID;
+    for (uint8_t& octet : p_dev_rec->ble.keys.irk) octet = generator();
+    list_append(btm_cb.sec_dev_rec, p_dev_rec);
+    bonded.push_back(p_dev_rec);
+  }
+  btm_ble_resolve_cache_reset();
+
+  distinct_rpas.clear();
+  rpa_owners.clear();
+  for (size_t i = 0; i < DISTINCT_RPAS; i++) {
+    BT_OCTET8 random;
+    for (uint8_t& octet : random) octet = generator();
+
+    tBTM_SEC_DEV_REC* p_owner = NULL;
+    if (i % BONDED_RPA_RATIO == 0)
+      p_owner = bonded[generator() % BONDED_DEVICES];
+
+    Octet16 irk;
+    if (p_owner != NULL) {
+      irk = p_owner->ble.keys.irk;
+    } else {
+      // Address of a device that was never bonded
+      for (uint8_t& octet : irk) octet = generator();
+    }
+    distinct_rpas.push_back(generate_rpa_from_irk_and_rand(irk, random));
+    rpa_owners.push_back(p_owner);
+  }
+}
+
+static void free_dev_db() {
+  btm_ble_resolve_cache_reset();
+  list_free(btm_cb.sec_dev_rec);
+  btm_cb.sec_dev_rec = NULL;
+}
+
+// The resolution done before addresses were cached: one AES run, with the
+// key schedule expanded, per bonded device.
+static bool match_random_bda_linear(void* data, void* context) {
+  RawAddress* random_bda = (RawAddress*)context;
+  tBTM_SEC_DEV_REC* p_dev_rec = static_cast<tBTM_SEC_DEV_REC*>(data);
+  if (!(p_dev_rec->device_type & BT_DEVICE_TYPE_BLE) ||
+      !(p_dev_rec->ble.key_type & BTM_LE_KEY_PID))
+    return true;
+
+  uint8_t rand[3] = {random_bda->address[2], random_bda->address[1],
+                     random_bda->address[0]};
+  Octet16 x = crypto_toolbox::aes_128(p_dev_rec->ble.keys.irk, rand, 3);
+  return !(x[0] == random_bda->address[5] && x[1] == random_bda->address[4] &&
+           x[2] == random_bda->address[3]);
+}
+
+static tBTM_SEC_DEV_REC* resolve_random_addr_linear(RawAddress random_bda) {
+  list_node_t* n = list_foreach(btm_cb.sec_dev_rec, match_random_bda_linear,
+                                (void*)&random_bda);
+  return n ? static_cast<tBTM_SEC_DEV_REC*>(list_node(n)) : NULL;
+}
+
+// Resolves each of the distinct addresses once.
+static void BM_ResolveLinear(State& state) {
+  populate_dev_db();
+  for (auto _ : state) {
+    for (size_t i = 0; i < distinct_rpas.size(); i++)
+      CHECK(resolve_random_addr_linear(distinct_rpas[i]) == rpa_owners[i]);
+  }
+  free_dev_db();
+  state.SetItemsProcessed(state.iterations() * distinct_rpas.size());
+}
+
+// Resolves each of the distinct addresses once, none of them being cached.
+static void BM_ResolveUncached(State& state) {
+  populate_dev_db();
+  for (auto _ : state) {
+    btm_ble_resolve_cache_reset();
+    for (size_t i = 0; i < distinct_rpas.size(); i++)
+      CHECK(btm_ble_resolve_random_addr(distinct_rpas[i]) == rpa_owners[i]);
+  }
+  free_dev_db();
+  state.SetItemsProcessed(state.iterations() * distinct_rpas.size());
+}
+
+// Builds the advertising reports of a scan, as indices in |distinct_rpas|. A
+// few devices advertise at a high rate and most only show up now and then.
+static std::vector<size_t> make_scan_trace() {
+  std::mt19937 generator(DISTINCT_RPAS);
+  std::vector<double> weights;
+  for (size_t i = 0; i < DISTINCT_RPAS; i++) weights.push_back(1.0 / (i + 1));
+  std::discrete_distribution<size_t> pick(weights.begin(), weights.end());
+  std::vector<size_t> trace;
+  for (size_t i = 0; i < TRACE_REPORTS; i++) trace.push_back(pick(generator));
+  return trace;
+}
+
+static void BM_ResolveScanTrace(State& state) {
+  populate_dev_db();
+  std::vector<size_t> trace = make_scan_trace();
+
+  for (auto _ : state) {
+    for (size_t i : trace)
+      CHECK(btm_ble_resolve_random_addr(distinct_rpas[i]) == rpa_owners[i]);
+  }
+  free_dev_db();
+  state.SetItemsProcessed(state.iterations() * trace.size());
+}
+
+static void BM_ResolveScanTraceLinear(State& state) {
+  populate_dev_db();
+  std::vector<size_t> trace = make_scan_trace();
+
+  for (auto _ : state) {
+    for (size_t i : trace)
+      CHECK(resolve_random_addr_linear(distinct_rpas[i]) == rpa_owners[i]);
+  }
+  free_dev_db();
+  state.SetItemsProcessed(state.iterations() * trace.size());
+}
+
+BENCHMARK(BM_ResolveLinear);
+BENCHMARK(BM_ResolveUncached);
+BENCHMARK(BM_ResolveScanTraceLinear);
+BENCHMARK(BM_ResolveScanTrace);
+
+int main(int argc, char** argv) {
+  // Disable LOG() output from libchrome
+  logging::LoggingSettings log_settings;
+  log_settings.logging_dest = logging::LoggingDestination::LOG_NONE;
+  CHECK(logging::InitLogging(log_settings)) << "Failed to set up logging";
+  ::benchmark::Initialize(&argc, argv);
+  if (::benchmark::ReportUnrecognizedArguments(argc, argv)) {
+    return 1;
+  }
+  ::benchmark::RunSpecifiedBenchmarks();
+}
@@ -0,0 +1,193 @@
+/******************************************************************************
+ * Copyright (c) 2026 Qualcomm Innovation Center, Inc. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ *
+ *******************************************************************************/
+
+#include <base/logging.h>
+#include <benchmark/benchmark.h>
+#include <stdarg.h>
+#include <vector>
+
+#include "btif_storage.h"
+#include "btm_int.h"
+#include "device/include/controller.h"
+#include "osi/include/allocator.h"
+#include "osi/include/list.h"
+
+using ::benchmark::State;
+
+// Number of records with an ACL link up, spread over the record list.
+#define CONNECTED_RECORDS 16
+#define FIRST_HANDLE 0x0001
+
+tBTM_CB btm_cb; /*STUB*/
+
+/* Below are methods that must be implemented if we don't want to compile the
+ * whole stack. */
+void LogMsg(uint32_t trace_set_mask, const char* fmt_str, ...) {}
+void vnd_LogMsg(uint32_t trace_set_mask, const char* fmt_str, ...) {}
+tBTM_INQ_INFO* BTM_InqDbRead(const RawAddress& p_bda) { return NULL; }
+void uint2devclass(uint32_t cod, DEV_CLASS dev_class) {}
+uint16_t BTM_GetHCIConnHandle(const RawAddress& remote_bda,
+                              tBT_TRANSPORT transport) {
+  return BTM_SEC_INVALID_HANDLE;
+}
+bool BTM_IsAclConnectionUp(const RawAddress& remote_bda,
+                           tBT_TRANSPORT transport) {
+  return false;
+}
+void btm_sec_clear_ble_keys(tBTM_SEC_DEV_REC* p_dev_rec) {}
+void btm_ble_resolve_cache_reset(void) {}
+tBTM_STATUS BTM_DeleteStoredLinkKey(const RawAddress* bd_addr,
+                                    tBTM_CMPL_CB* p_cb) {
+  return BTM_SUCCESS;
+}
+bool btm_ble_addr_resolvable(const RawAddress& rpa,
+                             tBTM_SEC_DEV_REC* p_dev_rec) {
+  return false;
+}
+const controller_t* controller_get_interface() { return NULL; }
+bool btm_is_sco_active_by_bdaddr(const RawAddress& remote_bda) {
+  return false;
+}
+bt_status_t btif_storage_get_remote_device_property(
+    const RawAddress* remote_bd_addr, bt_property_t* property) {
+  return BT_STATUS_FAIL;
+}
+
+extern bool is_address_equal(void* data, void* context);
+extern bool is_handle_equal(void* data, void* context);
+
+static std::vector<RawAddress> bonded_addrs;
+static std::vector<uint16_t> connected_handles;
+
+// Public (non resolvable) address of the |index|-th bonded device.
+static RawAddress make_address(size_t index, uint8_t prefix) {
+  return RawAddress({prefix, 0x1B, 0xDC, 0x00, (uint8_t)(index >> 8),
+                     (uint8_t)index});
+}
+
+// Fills the security database with |count| bonded devices the way they are
+// restored from storage at start-up, then brings up a few links.
+static void populate_dev_db(size_t count) {
+  btm_cb.sec_dev_rec = list_new(osi_free);
+  bonded_addrs.clear();
+  connected_handles.clear();
+
+  LinkKey link_key = {};
+  uint32_t trusted_mask[BTM_SEC_SERVICE_ARRAY_SIZE] = {};
+  for (size_t i = 0; i < count; i++) {
+    RawAddress bd_addr = make_address(i, 0x00);
+    CHECK(BTM_SecAddDevice(bd_addr, NULL, NULL, NULL, trusted_mask, &link_key,
+                           BTM_LKEY_TYPE_AUTH_COMB_P_256, BTM_IO_CAP_IO, 0));
+    bonded_addrs.push_back(bd_addr);
+  }
+
+  size_t stride = count / CONNECTED_RECORDS;
+  for (size_t i = 0; i < CONNECTED_RECORDS; i++) {
+    tBTM_SEC_DEV_REC* p_dev_rec = btm_find_dev(bonded_addrs[i * stride]);
+    p_dev_rec->hci_handle = FIRST_HANDLE + i;
+    btm_dev_index_update(p_dev_rec);
+    connected_handles.push_back(p_dev_rec->hci_handle);
+  }
+  CHECK(list_length(btm_cb.sec_dev_rec) == count);
+}
+
+static void free_dev_db() {
+  btm_dev_index_clear();
+  list_free(btm_cb.sec_dev_rec);
+  btm_cb.sec_dev_rec = NULL;
+}
+
+// The lookup done before the device record indices were added.
+static tBTM_SEC_DEV_REC* find_dev_linear(const RawAddress& bd_addr) {
+  list_node_t* n =
+      list_foreach(btm_cb.sec_dev_rec, is_address_equal, (void*)&bd_addr);
+  return n ? static_cast<tBTM_SEC_DEV_REC*>(list_node(n)) : NULL;
+}
+
+static tBTM_SEC_DEV_REC* find_dev_by_handle_linear(uint16_t handle) {
+  list_node_t* n = list_foreach(btm_cb.sec_dev_rec, is_handle_equal, &handle);
+  return n ? static_cast<tBTM_SEC_DEV_REC*>(list_node(n)) : NULL;
+}
+
+static void BM_FindDevLinear(State& state) {
+  populate_dev_db(state.range(0));
+  size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(find_dev_linear(bonded_addrs[i]));
+    if (++i == bonded_addrs.size()) i = 0;
+  }
+  free_dev_db();
+  state.SetItemsProcessed(state.iterations());
+}
+
+static void BM_FindDevIndexed(State& state) {
+  populate_dev_db(state.range(0));
+  size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(btm_find_dev(bonded_addrs[i]));
+    if (++i == bonded_addrs.size()) i = 0;
+  }
+  free_dev_db();
+  state.SetItemsProcessed(state.iterations());
+}
+
+// Lookups of devices without a record, e.g. while handling inquiry results.
+static void BM_FindDevMissLinear(State& state) {
+  populate_dev_db(state.range(0));
+  RawAddress unknown = make_address(0, 0x22);
+  for (auto _ : state) benchmark::DoNotOptimize(find_dev_linear(unknown));
+  free_dev_db();
+  state.SetItemsProcessed(state.iterations());
+}
+
+static void BM_FindDevMissIndexed(State& state) {
+  populate_dev_db(state.range(0));
+  RawAddress unknown = make_address(0, 0x22);
+  for (auto _ : state) benchmark::DoNotOptimize(btm_find_dev(unknown));
+  free_dev_db();
+  state.SetItemsProcessed(state.iterations());
+}
+
+static void BM_FindDevByHandleLinear(State& state) {
+  populate_dev_db(state.range(0));
+  size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(find_dev_by_handle_linear(connected_handles[i]));
+    if (++i == connected_handles.size()) i = 0;
+  }
+  free_dev_db();
+  state.SetItemsProcessed(state.iterations());
+}
+
+static void BM_FindDevByHandleIndexed(State& state) {
+  populate_dev_db(state.range(0));
+  size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(btm_find_dev_by_handle(connected_handles[i]));
+    if (++i == connected_handles.size()) i = 0;
+  }
+  free_dev_db();
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_FindDevLinear)->Arg(50)->Arg(500);
+BENCHMARK(BM_FindDevIndexed)->Arg(50)->Arg(500);
+BENCHMARK(BM_FindDevMissLinear)->Arg(50)->Arg(500);
+BENCHMARK(BM_FindDevMissIndexed)->Arg(50)->Arg(500);
+BENCHMARK(BM_FindDevByHandleLinear)->Arg(50)->Arg(500);
+BENCHMARK(BM_FindDevByHandleIndexed)->Arg(50)->Arg(500);
+
+int main(int argc, char** argv) {
+  // Disable LOG() output from libchrome
+  logging::LoggingSettings log_settings;
+  log_settings.logging_dest = logging::LoggingDestination::LOG_NONE;
+  CHECK(logging::InitLogging(log_settings)) << "Failed to set up logging";
+  ::benchmark::Initialize(&argc, argv);
+  if (::benchmark::ReportUnrecognizedArguments(argc, argv)) {
+    return 1;
+  }
+  ::benchmark::RunSpecifiedBenchmarks();
+}
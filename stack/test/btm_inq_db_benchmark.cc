@@ -0,0 +1,207 @@
+/******************************************************************************
+ * Copyright (c) 2026 Qualcomm Innovation Center, Inc. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ *
+ *******************************************************************************/
+
+#include <base/logging.h>
+#include <benchmark/benchmark.h>
+#include <string.h>
+#include <random>
+#include <vector>
+
+#include "btm_int.h"
+#include "device/include/controller.h"
+#include "hcimsgs.h"
+#include "osi/include/time.h"
+
+using ::benchmark::State;
+
+// Number of advertising reports in the replayed trace.
+#define TRACE_REPORTS 20000
+
+tBTM_CB btm_cb; /*STUB*/
+
+/* Below are methods that must be implemented if we don't want to compile the
+ * whole stack. */
+void LogMsg(uint32_t trace_set_mask, const char* fmt_str, ...) {}
+void vnd_LogMsg(uint32_t trace_set_mask, const char* fmt_str, ...) {}
+const controller_t* controller_get_interface() { return NULL; }
+tBTM_SEC_DEV_REC* btm_find_dev(const RawAddress& bd_addr) { return NULL; }
+bool BTM_UseLeLink(const RawAddress& bd_addr) { return false; }
+tBTM_STATUS BTM_BleObserve(bool start, uint8_t duration,
+                           tBTM_INQ_RESULTS_CB* p_results_cb,
+                           tBTM_CMPL_CB* p_cmpl_cb) {
+  return BTM_SUCCESS;
+}
+bool BTM_IsDeviceUp(void) { return true; }
+tBTM_STATUS BTM_SetDeviceClass(DEV_CLASS dev_class) { return BTM_SUCCESS; }
+uint8_t* BTM_ReadDeviceClass(void) { return NULL; }
+void btm_ble_stop_inquiry(void) {}
+tBTM_STATUS btm_ble_start_inquiry(uint8_t mode, uint8_t duration) {
+  return BTM_SUCCESS;
+}
+tBTM_STATUS btm_ble_read_remote_name(const RawAddress& remote_bda,
+                                     tBTM_CMPL_CB* p_cb) {
+  return BTM_SUCCESS;
+}
+bool btm_ble_cancel_remote_name(const RawAddress& remote_bda) { return true; }
+tBTM_STATUS btm_ble_set_discoverability(uint16_t combined_mode) {
+  return BTM_SUCCESS;
+}
+tBTM_STATUS btm_ble_set_connectability(uint16_t combined_mode) {
+  return BTM_SUCCESS;
+}
+void btm_send_hci_scan_enable(uint8_t enable, uint8_t filter_duplicates) {}
+void btm_clear_all_pending_le_entry(void) {}
+void btm_acl_update_busy_level(tBTM_BLI_EVENT event) {}
+void btm_sec_rmt_name_request_complete(const RawAddress* bd_addr,
+                                       uint8_t* bd_name, uint8_t status) {}
+void btsnd_hcic_inquiry(const LAP inq_lap, uint8_t duration,
+                        uint8_t response_cnt) {}
+void btsnd_hcic_inq_cancel(void) {}
+void btsnd_hcic_per_inq_mode(uint16_t max_period, uint16_t min_period,
+                             const LAP inq_lap, uint8_t duration,
+                             uint8_t response_cnt) {}
+void btsnd_hcic_exit_per_inq(void) {}
+void btsnd_hcic_rmt_name_req(const RawAddress& bd_addr,
+                             uint8_t page_scan_rep_mode,
+                             uint8_t page_scan_mode, uint16_t clock_offset) {}
+void btsnd_hcic_rmt_name_req_cancel(const RawAddress& bd_addr) {}
+void btsnd_hcic_set_event_filter(uint8_t filt_type, uint8_t filt_cond_type,
+                                 uint8_t* filt_cond, uint8_t filt_cond_len) {}
+void btsnd_hcic_read_inq_tx_power(void) {}
+void btsnd_hcic_write_cur_iac_lap(uint8_t num_cur_iac, LAP* const iac_lap) {}
+void btsnd_hcic_write_inqscan_cfg(uint16_t interval, uint16_t window) {}
+void btsnd_hcic_write_pagescan_cfg(uint16_t interval, uint16_t window) {}
+void btsnd_hcic_write_scan_enable(uint8_t flag) {}
+void btsnd_hcic_write_inqscan_type(uint8_t type) {}
+void btsnd_hcic_write_pagescan_type(uint8_t type) {}
+void btsnd_hcic_write_inquiry_mode(uint8_t mode) {}
+void btsnd_hcic_write_ext_inquiry_response(void* buffer, uint8_t fec_req) {}
+
+typedef struct {
+  RawAddress bda;
+  int8_t rssi;
+} adv_report_t;
+
+// Builds a trace of |TRACE_REPORTS| advertising reports from |advertisers|
+// devices. As in a crowded scan, a few beacons advertise at a high rate and
+// most devices only show up now and then.
+static std::vector<adv_report_t> make_adv_trace(size_t advertisers) {
+  std::mt19937 generator(advertisers);
+  std::vector<RawAddress> addresses;
+  std::vector<double> weights;
+  for (size_t i = 0; i < advertisers; i++) {
+    RawAddress bda;
+    for (uint8_t& octet : bda.address) octet = generator();
+    bda.address[0] = (bda.address[0] & 0x3F) | 0x40;  // resolvable private
+    addresses.push_back(bda);
+    weights.push_back(1.0 / (i + 1));
+  }
+
+  std::discrete_distribution<size_t> pick(weights.begin(), weights.end());
+  std::vector<adv_report_t> trace;
+  for (size_t i = 0; i < TRACE_REPORTS; i++) {
+    adv_report_t report = {addresses[pick(generator)],
+                           (int8_t)(-40 - generator() % 60)};
+    trace.push_back(report);
+  }
+  return trace;
+}
+
+// The linear scans used before the inquiry database was indexed, kept here
+// as a baseline. They run over their own table of |legacy_db_size| entries.
+static std::vector<tINQ_DB_ENT> legacy_db;
+
+static tINQ_DB_ENT* legacy_db_find(const RawAddress& p_bda) {
+  for (tINQ_DB_ENT& ent : legacy_db) {
+    if (ent.in_use && ent.inq_info.results.remote_bd_addr == p_bda)
+      return &ent;
+  }
+  return NULL;
+}
+
+static tINQ_DB_ENT* legacy_db_new(const RawAddress& p_bda) {
+  tINQ_DB_ENT* p_old = &legacy_db[0];
+  uint32_t ot = 0xFFFFFFFF;
+  for (tINQ_DB_ENT& ent : legacy_db) {
+    if (!ent.in_use) {
+      p_old = &ent;
+      break;
+    }
+    if (ent.time_of_resp < ot) {
+      p_old = &ent;
+      ot = ent.time_of_resp;
+    }
+  }
+  memset(p_old, 0, sizeof(tINQ_DB_ENT));
+  p_old->inq_info.results.remote_bd_addr = p_bda;
+  p_old->in_use = true;
+  return p_old;
+}
+
+static void replay_adv_trace_legacy(const std::vector<adv_report_t>& trace) {
+  for (const adv_report_t& report : trace) {
+    tINQ_DB_ENT* p_i = legacy_db_find(report.bda);
+    if (p_i == NULL) p_i = legacy_db_new(report.bda);
+    p_i->time_of_resp = time_get_os_boottime_ms();
+    p_i->inq_info.results.rssi = report.rssi;
+  }
+}
+
+// Replays |trace| through the inquiry database the way
+// btm_ble_process_adv_pkt_cont() handles each report.
+static void replay_adv_trace(const std::vector<adv_report_t>& trace) {
+  for (const adv_report_t& report : trace) {
+    tINQ_DB_ENT* p_i = btm_inq_db_find(report.bda);
+    if (p_i == NULL) p_i = btm_inq_db_new(report.bda, false);
+    btm_inq_db_touch(p_i);
+    p_i->inq_info.results.rssi = report.rssi;
+  }
+}
+
+// Replays a trace from |state.range(1)| advertisers into an inquiry database
+// of |state.range(0)| entries.
+static void BM_ReplayAdvReports(State& state) {
+  btm_inq_db_set_size(state.range(0));
+  std::vector<adv_report_t> trace = make_adv_trace(state.range(1));
+
+  for (auto _ : state) replay_adv_trace(trace);
+
+  btm_inq_db_free();
+  state.SetItemsProcessed(state.iterations() * trace.size());
+}
+
+static void BM_ReplayAdvReportsLegacy(State& state) {
+  legacy_db.assign(state.range(0), tINQ_DB_ENT());
+  std::vector<adv_report_t> trace = make_adv_trace(state.range(1));
+
+  for (auto _ : state) replay_adv_trace_legacy(trace);
+
+  legacy_db.clear();
+  state.SetItemsProcessed(state.iterations() * trace.size());
+}
+
+BENCHMARK(BM_ReplayAdvReportsLegacy)
+    ->Args({BTM_INQ_DB_SIZE, 20})
+    ->Args({BTM_INQ_DB_SIZE, 300})
+    ->Args({256, 300})
+    ->Args({1024, 1000});
+BENCHMARK(BM_ReplayAdvReports)
+    ->Args({BTM_INQ_DB_SIZE, 20})
+    ->Args({BTM_INQ_DB_SIZE, 300})
+    ->Args({256, 300})
+    ->Args({1024, 1000});
+
+int main(int argc, char** argv) {
+  // Disable LOG() output from libchrome
+  logging::LoggingSettings log_settings;
+  log_settings.logging_dest = logging::LoggingDestination::LOG_NONE;
+  CHECK(logging::InitLogging(log_settings)) << "Failed to set up logging";
+  ::benchmark::Initialize(&argc, argv);
+  if (::benchmark::ReportUnrecognizedArguments(argc, argv)) {
+    return 1;
+  }
+  ::benchmark::RunSpecifiedBenchmarks();
+}
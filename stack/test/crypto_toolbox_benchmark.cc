@@ -0,0 +1,89 @@
+/******************************************************************************
+ * Copyright (c) 2026 Qualcomm Innovation Center, Inc. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ *
+ *******************************************************************************/
+
+#include <base/logging.h>
+#include <benchmark/benchmark.h>
+#include <vector>
+
+#include "stack/crypto_toolbox/aes.h"
+#include "stack/crypto_toolbox/crypto_toolbox.h"
+
+using ::benchmark::State;
+
+static const Octet16 test_key{0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6,
+                              0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c};
+
+// Selects the block encryption |state.range(0)|, skipping the benchmark if
+// the CPU doesn't support it.
+static bool select_impl(State& state) {
+  if (aes_select_impl(static_cast<aes_impl>(state.range(0))) != 0) {
+    state.SkipWithError("not supported by this CPU");
+    return false;
+  }
+  return true;
+}
+
+// Encrypts single blocks with an expanded key schedule, as RPA resolution
+// does.
+static void BM_AesEncrypt(State& state) {
+  aes_impl selected = aes_selected_impl();
+  if (!select_impl(state)) return;
+
+  aes_context ctx;
+  crypto_toolbox::aes_128_set_key(test_key, &ctx);
+  uint8_t block[N_BLOCK] = {0};
+  for (auto _ : state) {
+    aes_encrypt(block, block, &ctx);
+    benchmark::DoNotOptimize(block);
+  }
+
+  aes_select_impl(selected);
+  state.SetBytesProcessed(state.iterations() * N_BLOCK);
+}
+
+// Signs messages of |state.range(1)| octets, e.g. the attributes hashed for
+// the GATT database hash.
+static void BM_AesCmac(State& state) {
+  aes_impl selected = aes_selected_impl();
+  if (!select_impl(state)) return;
+
+  std::vector<uint8_t> message(state.range(1));
+  for (size_t i = 0; i < message.size(); i++) message[i] = i;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        crypto_toolbox::aes_cmac(test_key, message.data(), message.size()));
+  }
+
+  aes_select_impl(selected);
+  state.SetBytesProcessed(state.iterations() * message.size());
+}
+
+BENCHMARK(BM_AesEncrypt)
+    ->Arg(AES_IMPL_BYTES)
+    ->Arg(AES_IMPL_TABLES)
+    ->Arg(AES_IMPL_AESNI);
+BENCHMARK(BM_AesCmac)
+    ->Args({AES_IMPL_BYTES, 16})
+    ->Args({AES_IMPL_TABLES, 16})
+    ->Args({AES_IMPL_AESNI, 16})
+    ->Args({AES_IMPL_BYTES, 512})
+    ->Args({AES_IMPL_TABLES, 512})
+    ->Args({AES_IMPL_AESNI, 512})
+    ->Args({AES_IMPL_BYTES, 4096})
+    ->Args({AES_IMPL_TABLES, 4096})
+    ->Args({AES_IMPL_AESNI, 4096});
+
+int main(int argc, char** argv) {
+  // Disable LOG() output from libchrome
+  logging::LoggingSettings log_settings;
+  log_settings.logging_dest = logging::LoggingDestination::LOG_NONE;
+  CHECK(logging::InitLogging(log_settings)) << "Failed to set up logging";
+  ::benchmark::Initialize(&argc, argv);
+  if (::benchmark::ReportUnrecognizedArguments(argc, argv)) {
+    return 1;
+  }
+  ::benchmark::RunSpecifiedBenchmarks();
+}
@@ -24,6 +24,7 @@
 
 #include <base/logging.h>
 #include <base/strings/string_number_conversions.h>
+#include <random>
 #include <vector>
 
 using ::testing::ElementsAreArray;
@@ -397,4 +398,83 @@ TEST(CryptoToolboxTest, bt_spec_example_d_12_test) {
   EXPECT_EQ(expected_ltk, ltk);
 }
 
+// FIPS-197 Appendix C, with every block encryption the CPU supports.
+TEST(CryptoToolboxTest, aes_fips_197_known_answer_test) {
+  uint8_t key[32];
+  for (int i = 0; i < 32; i++) key[i] = i;
+  uint8_t plaintext[] = {0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77,
+                         0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff};
+
+  struct {
+    uint8_t key_len;
+    uint8_t ciphertext[16];
+  } vectors[] = {
+      {16,
+       {0x69, 0xc4, 0xe0, 0xd8, 0x6a, 0x7b, 0x04, 0x30, 0xd8, 0xcd, 0xb7, 0x80,
+        0x70, 0xb4, 0xc5, 0x5a}},
+      {24,
+       {0xdd, 0xa9, 0x7c, 0xa4, 0x86, 0x4c, 0xdf, 0xe0, 0x6e, 0xaf, 0x70, 0xa0,
+        0xec, 0x0d, 0x71, 0x91}},
+      {32,
+       {0x8e, 0xa2, 0xb7, 0xca, 0x51, 0x67, 0x45, 0xbf, 0xea, 0xfc, 0x49, 0x90,
+        0x4b, 0x49, 0x60, 0x89}},
+  };
+
+  aes_impl selected = aes_selected_impl();
+  for (aes_impl impl : {AES_IMPL_BYTES, AES_IMPL_TABLES, AES_IMPL_AESNI}) {
+    if (aes_select_impl(impl) != 0) continue;
+
+    for (const auto& vector : vectors) {
+      aes_context ctx;
+      uint8_t output[16];
+      aes_set_key(key, vector.key_len, &ctx);
+      aes_encrypt(plaintext, output, &ctx);
+      EXPECT_THAT(output, ElementsAreArray(vector.ciphertext))
+          << "impl " << impl << " key length " << (int)vector.key_len;
+    }
+  }
+  EXPECT_EQ(0, aes_select_impl(selected));
+}
+
+// Every block encryption gives the same output as the byte oriented one.
+TEST(CryptoToolboxTest, aes_implementations_match_test) {
+  aes_impl selected = aes_selected_impl();
+  std::mt19937 generator(0x5eed);
+  for (int i = 0; i < 1000; i++) {
+    uint8_t key[16], input[16], expected[16], output[16];
+    for (uint8_t& octet : key) octet = generator();
+    for (uint8_t& octet : input) octet = generator();
+
+    aes_context ctx;
+    aes_set_key(key, sizeof(key), &ctx);
+    ASSERT_EQ(0, aes_select_impl(AES_IMPL_BYTES));
+    aes_encrypt(input, expected, &ctx);
+
+    for (aes_impl impl : {AES_IMPL_TABLES, AES_IMPL_AESNI}) {
+      if (aes_select_impl(impl) != 0) continue;
+      aes_encrypt(input, output, &ctx);
+      ASSERT_THAT(output, ElementsAreArray(expected)) << "impl " << impl;
+    }
+  }
+  EXPECT_EQ(0, aes_select_impl(selected));
+}
+
+// A key schedule expanded once gives the same results as the key.
+TEST(CryptoToolboxTest, aes_key_schedule_test) {
+  Octet16 k{0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6,
+            0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c};
+  std::vector<uint8_t> m(100);
+  for (size_t i = 0; i < m.size(); i++) m[i] = i;
+
+  aes_context ctx;
+  aes_128_set_key(k, &ctx);
+
+  Octet16 block{};
+  EXPECT_EQ(aes_128(k, block), aes_128(ctx, block));
+  for (uint16_t len : {0, 16, 40, 64, 100}) {
+    EXPECT_EQ(aes_cmac(k, m.data(), len), aes_cmac(ctx, m.data(), len))
+        << "length " << len;
+  }
+}
+
 }  // namespace crypto_toolbox
@@ -0,0 +1,374 @@
+/******************************************************************************
+ * Copyright (c) 2026 Qualcomm Innovation Center, Inc. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ *
+ *******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <vector>
+
+#include "osi/include/alarm.h"
+#include "stack/crypto_toolbox/crypto_toolbox.h"
+#include "stack/gatt/eatt_int.h"
+#include "stack/gatt/gatt_int.h"
+#include "stack/include/gatt_api.h"
+#include "stack/include/l2cdefs.h"
+#include "stack_config.h"
+
+#include "btif/include/btif_storage.h"
+
+using bluetooth::Uuid;
+
+tGATT_CB gatt_cb;
+uint8_t appl_trace_level = BT_TRACE_LEVEL_NONE; /*STUB*/
+
+/* Below are methods that must be implemented if we don't want to compile the
+ * whole stack. */
+void LogMsg(uint32_t trace_set_mask, const char* fmt_str, ...) {}
+
+static tGATT_REG test_reg;
+tGATT_REG* gatt_get_regcb(tGATT_IF gatt_if) { return &test_reg; }
+tGATT_TCB* gatt_get_tcb_by_idx(uint8_t tcb_idx) {
+  return &gatt_cb.tcb[tcb_idx];
+}
+
+alarm_callback_t last_alarm_cb = nullptr;
+void* last_alarm_data = nullptr;
+static int alarm_set_count = 0;
+void alarm_set_on_mloop(alarm_t* alarm, period_ms_t interval_ms,
+                        alarm_callback_t cb, void* data) {
+  alarm_set_count++;
+  last_alarm_cb = cb;
+  last_alarm_data = data;
+}
+void* alarm_cancel(alarm_t* alarm) {
+  last_alarm_cb = nullptr;
+  last_alarm_data = nullptr;
+  return nullptr;
+}
+
+/* The PDUs built and sent, with the handles of the values in them */
+struct Pdu {
+  uint16_t lcid;
+  uint8_t op_code;
+  std::vector<uint16_t> handles;
+};
+static std::map<BT_HDR*, Pdu> built_pdus;
+static std::vector<Pdu> sent_pdus;
+static uint16_t payload_size = GATT_DEF_BLE_MTU_SIZE;
+static uint8_t cl_supp_feat = 0;
+static std::map<uint16_t, uint16_t> eatt_conn_cids;
+
+static BT_HDR* build_pdu(uint8_t op_code, std::vector<uint16_t> handles) {
+  BT_HDR* p_buf = (BT_HDR*)osi_malloc(sizeof(BT_HDR));
+  built_pdus[p_buf] = {0, op_code, handles};
+  return p_buf;
+}
+BT_HDR* attp_build_sr_msg(tGATT_TCB& tcb, uint16_t lcid, uint8_t op_code,
+                          tGATT_SR_MSG* p_msg) {
+  return build_pdu(op_code, {p_msg->attr_value.handle});
+}
+BT_HDR* attp_build_multi_ntf_cmd(uint16_t payload_size,
+                                 tGATT_MULTI_NOTIF multi_ntf) {
+  return build_pdu(GATT_MULTI_HANDLE_VALUE_NOTIF,
+                   std::vector<uint16_t>(
+                       multi_ntf.handles,
+                       multi_ntf.handles + multi_ntf.num_attr));
+}
+tGATT_STATUS attp_send_sr_msg(tGATT_TCB& tcb, uint16_t lcid, BT_HDR* p_msg) {
+  Pdu pdu = built_pdus[p_msg];
+  pdu.lcid = lcid;
+  sent_pdus.push_back(pdu);
+  built_pdus.erase(p_msg);
+  free(p_msg);
+  return GATT_SUCCESS;
+}
+uint16_t gatt_get_payload_size(tGATT_TCB* p_tcb, uint16_t lcid) {
+  return payload_size;
+}
+uint8_t btif_storage_get_cl_supp_feat(const RawAddress& bda) {
+  return cl_supp_feat;
+}
+bool is_gatt_conn_id_found(uint16_t conn_id) {
+  return eatt_conn_cids.count(conn_id) != 0;
+}
+uint16_t gatt_get_cid_by_conn_id(uint16_t conn_id) {
+  return eatt_conn_cids[conn_id];
+}
+
+static bool service_chg_indication_disable() { return true; }
+const stack_config_t* stack_config_get_interface(void) {
+  static stack_config_t interface = {};
+  interface.get_pts_service_chg_indication_disable =
+      service_chg_indication_disable;
+  return &interface;
+}
+
+/* Each database hash computation is one AES-CMAC of the whole database */
+static int aes_cmac_count = 0;
+namespace crypto_toolbox {
+Octet16 aes_cmac(const Octet16& key, const uint8_t* message, uint16_t length) {
+  Octet16 result{};
+  result[0] = ++aes_cmac_count;
+  return result;
+}
+}  // namespace crypto_toolbox
+
+class GattApiTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    gatt_cb = tGATT_CB();
+    gatt_cb.hdl_list_info = new std::list<tGATT_HDL_LIST_ELEM>();
+    gatt_cb.srv_list_info = new std::list<tGATT_SRV_LIST_ELEM>();
+    gatt_cb.hdl_cfg.app_start_hdl = 0x0028;
+    gatt_cb.tcb[0].in_use = true;
+    gatt_cb.tcb[0].att_lcid = L2CAP_ATT_CID;
+    test_reg = tGATT_REG();
+    aes_cmac_count = 0;
+    alarm_set_count = 0;
+    last_alarm_cb = nullptr;
+    last_alarm_data = nullptr;
+    built_pdus.clear();
+    sent_pdus.clear();
+    payload_size = GATT_DEF_BLE_MTU_SIZE;
+    cl_supp_feat = 0;
+    eatt_conn_cids.clear();
+  }
+
+  void TearDown() override {
+    delete gatt_cb.hdl_list_info;
+    delete gatt_cb.srv_list_info;
+    gatt_cb.hdl_list_info = nullptr;
+    gatt_cb.srv_list_info = nullptr;
+  }
+
+  // Adds a primary service with one readable characteristic
+  void AddService(uint16_t uuid) {
+    btgatt_db_element_t service[2] = {};
+    service[0].type = BTGATT_DB_PRIMARY_SERVICE;
+    service[0].uuid = Uuid::From16Bit(uuid);
+    service[1].type = BTGATT_DB_CHARACTERISTIC;
+    service[1].uuid = Uuid::From16Bit(0x2A00);
+    service[1].properties = GATT_CHAR_PROP_BIT_READ;
+    service[1].permissions = GATT_PERM_READ;
+    ASSERT_EQ(GATTS_AddService(1, service, 2), GATT_SERVICE_STARTED);
+  }
+
+  tGATT_STATUS Notify(uint16_t handle, uint16_t len = 2,
+                      uint16_t conn_id = kConnId) {
+    std::vector<uint8_t> value(len, handle);
+    return GATTS_HandleValueNotification(conn_id, handle, len, value.data());
+  }
+
+  void FireAlarm() {
+    ASSERT_NE(last_alarm_cb, nullptr);
+    alarm_callback_t cb = last_alarm_cb;
+    last_alarm_cb = nullptr;
+    cb(last_alarm_data);
+  }
+
+  static constexpr uint16_t kConnId = GATT_CREATE_CONN_ID(0, 1);
+};
+
+class GattNotifCoalesceTest : public GattApiTest {
+ protected:
+  void SetUp() override {
+    GattApiTest::SetUp();
+    gatt_cb.notif_coalesce_ms = 20;
+    cl_supp_feat = CL_MULTI_NOTIF_SUPPORTED;
+  }
+};
+
+TEST_F(GattApiTest, hashComputedOnceForServiceAdditions) {
+  constexpr int kNumServices = 32;
+  for (int i = 0; i < kNumServices; i++) AddService(0x1810 + i);
+  ASSERT_EQ(gatt_cb.srv_list_info->size(), (size_t)kNumServices);
+
+  // Adding the services didn't compute the hash of any intermediate database
+  EXPECT_EQ(aes_cmac_count, 0);
+
+  Octet16 hash = gatts_get_database_hash();
+  EXPECT_EQ(aes_cmac_count, 1);
+
+  // Reading it again doesn't compute it again
+  EXPECT_EQ(gatts_get_database_hash(), hash);
+  EXPECT_EQ(aes_cmac_count, 1);
+
+  // The next change makes the next read compute it again, once
+  AddService(0x1810 + kNumServices);
+  EXPECT_EQ(aes_cmac_count, 1);
+  EXPECT_NE(gatts_get_database_hash(), hash);
+  gatts_get_database_hash();
+  EXPECT_EQ(aes_cmac_count, 2);
+}
+
+TEST_F(GattApiTest, notificationSentRightAwayWithoutCoalescing) {
+  cl_supp_feat = CL_MULTI_NOTIF_SUPPORTED;
+  EXPECT_EQ(Notify(0x0030), GATT_SUCCESS);
+  EXPECT_EQ(Notify(0x0032), GATT_SUCCESS);
+
+  ASSERT_EQ(sent_pdus.size(), 2u);
+  EXPECT_EQ(sent_pdus[0].op_code, GATT_HANDLE_VALUE_NOTIF);
+  EXPECT_EQ(sent_pdus[0].handles, std::vector<uint16_t>{0x0030});
+  EXPECT_EQ(sent_pdus[1].handles, std::vector<uint16_t>{0x0032});
+  EXPECT_EQ(alarm_set_count, 0);
+}
+
+TEST_F(GattNotifCoalesceTest, mergedIntoMultipleHandleValueNotification) {
+  EXPECT_EQ(Notify(0x0030), GATT_SUCCESS);
+  EXPECT_EQ(Notify(0x0032), GATT_SUCCESS);
+  EXPECT_EQ(Notify(0x0034), GATT_SUCCESS);
+
+  // Held back until the latency budget of the first one runs out
+  EXPECT_TRUE(sent_pdus.empty());
+  EXPECT_EQ(alarm_set_count, 1);
+  FireAlarm();
+
+  ASSERT_EQ(sent_pdus.size(), 1u);
+  EXPECT_EQ(sent_pdus[0].op_code, GATT_MULTI_HANDLE_VALUE_NOTIF);
+  EXPECT_EQ(sent_pdus[0].lcid, L2CAP_ATT_CID);
+  EXPECT_EQ(sent_pdus[0].handles,
+            (std::vector<uint16_t>{0x0030, 0x0032, 0x0034}));
+  EXPECT_EQ(gatt_cb.notif_stats.coalesced, 3u);
+  EXPECT_EQ(gatt_cb.notif_stats.multi_pdus, 1u);
+  EXPECT_EQ(gatt_cb.notif_stats.pdus_saved, 2u);
+  EXPECT_TRUE(gatt_cb.tcb[0].coalesce_q.empty());
+
+  // The next one starts a new budget
+  Notify(0x0036);
+  EXPECT_EQ(alarm_set_count, 2);
+}
+
+TEST_F(GattNotifCoalesceTest, sentBackToBackOnTimerWithoutClientSupport) {
+  cl_supp_feat = 0;
+  Notify(0x0030);
+  Notify(0x0032);
+  EXPECT_TRUE(sent_pdus.empty());
+  FireAlarm();
+
+  ASSERT_EQ(sent_pdus.size(), 2u);
+  EXPECT_EQ(sent_pdus[0].op_code, GATT_HANDLE_VALUE_NOTIF);
+  EXPECT_EQ(sent_pdus[0].handles, std::vector<uint16_t>{0x0030});
+  EXPECT_EQ(sent_pdus[1].op_code, GATT_HANDLE_VALUE_NOTIF);
+  EXPECT_EQ(sent_pdus[1].handles, std::vector<uint16_t>{0x0032});
+  EXPECT_EQ(gatt_cb.notif_stats.bursts, 1u);
+  EXPECT_EQ(gatt_cb.notif_stats.multi_pdus, 0u);
+}
+
+TEST_F(GattNotifCoalesceTest, flushedWhenThePayloadIsFull) {
+  // Opcode, then 4 + 8 bytes per value: two don't fit in 23 bytes
+  Notify(0x0030, 8);
+  EXPECT_TRUE(sent_pdus.empty());
+  Notify(0x0032, 8);
+  ASSERT_EQ(sent_pdus.size(), 1u);
+  EXPECT_EQ(sent_pdus[0].op_code, GATT_HANDLE_VALUE_NOTIF);
+  EXPECT_EQ(sent_pdus[0].handles, std::vector<uint16_t>{0x0030});
+  ASSERT_EQ(gatt_cb.tcb[0].coalesce_q.size(), 1u);
+  EXPECT_EQ(gatt_cb.tcb[0].coalesce_q.front().handle, 0x0032);
+
+  // One that can't share a PDU goes right after the ones before it
+  Notify(0x0034, 19);
+  ASSERT_EQ(sent_pdus.size(), 3u);
+  EXPECT_EQ(sent_pdus[1].handles, std::vector<uint16_t>{0x0032});
+  EXPECT_EQ(sent_pdus[2].handles, std::vector<uint16_t>{0x0034});
+  EXPECT_TRUE(gatt_cb.tcb[0].coalesce_q.empty());
+  EXPECT_EQ(last_alarm_cb, nullptr);
+}
+
+TEST_F(GattNotifCoalesceTest, flushedOnMaxHandles) {
+  payload_size = 512;
+  std::vector<uint16_t> handles;
+  for (int i = 0; i < GATT_MAX_MULTI_HANDLE_NOTIF; i++) {
+    handles.push_back(0x0030 + 2 * i);
+    Notify(handles.back());
+  }
+
+  ASSERT_EQ(sent_pdus.size(), 1u);
+  EXPECT_EQ(sent_pdus[0].op_code, GATT_MULTI_HANDLE_VALUE_NOTIF);
+  EXPECT_EQ(sent_pdus[0].handles, handles);
+  EXPECT_EQ(last_alarm_cb, nullptr);
+}
+
+TEST_F(GattNotifCoalesceTest, indicationDoesNotOvertakeNotifications) {
+  uint8_t value[2] = {0, 1};
+  Notify(0x0030);
+  Notify(0x0032);
+  EXPECT_EQ(GATTS_HandleValueIndication(kConnId, 0x0034, 2, value),
+            GATT_SUCCESS);
+
+  ASSERT_EQ(sent_pdus.size(), 2u);
+  EXPECT_EQ(sent_pdus[0].op_code, GATT_MULTI_HANDLE_VALUE_NOTIF);
+  EXPECT_EQ(sent_pdus[0].handles, (std::vector<uint16_t>{0x0030, 0x0032}));
+  EXPECT_EQ(sent_pdus[1].op_code, GATT_HANDLE_VALUE_IND);
+  EXPECT_EQ(sent_pdus[1].handles, std::vector<uint16_t>{0x0034});
+  EXPECT_EQ(last_alarm_cb, nullptr);
+}
+
+TEST_F(GattNotifCoalesceTest, multiNotificationDoesNotOvertakeNotifications) {
+  uint16_t handles[2] = {0x0040, 0x0042};
+  uint16_t lens[2] = {1, 1};
+  Notify(0x0030);
+  EXPECT_EQ(GATTS_MultiHandleValueNotifications(kConnId, 2, handles, lens,
+                                                {{1}, {2}}),
+            GATT_SUCCESS);
+
+  ASSERT_EQ(sent_pdus.size(), 2u);
+  EXPECT_EQ(sent_pdus[0].op_code, GATT_HANDLE_VALUE_NOTIF);
+  EXPECT_EQ(sent_pdus[0].handles, std::vector<uint16_t>{0x0030});
+  EXPECT_EQ(sent_pdus[1].op_code, GATT_MULTI_HANDLE_VALUE_NOTIF);
+  EXPECT_EQ(sent_pdus[1].handles, (std::vector<uint16_t>{0x0040, 0x0042}));
+}
+
+TEST_F(GattNotifCoalesceTest, notificationsOnAnotherChannelFlushed) {
+  const uint16_t kOtherConnId = GATT_CREATE_CONN_ID(0, 2);
+  gatt_cb.tcb[0].is_eatt_supported = true;
+  test_reg.eatt_support = true;
+  eatt_conn_cids[kConnId] = 0x0040;
+  eatt_conn_cids[kOtherConnId] = 0x0041;
+
+  Notify(0x0030, 2, kConnId);
+  Notify(0x0032, 2, kConnId);
+  EXPECT_TRUE(sent_pdus.empty());
+  Notify(0x0034, 2, kOtherConnId);
+
+  ASSERT_EQ(sent_pdus.size(), 1u);
+  EXPECT_EQ(sent_pdus[0].lcid, 0x0040);
+  EXPECT_EQ(sent_pdus[0].handles, (std::vector<uint16_t>{0x0030, 0x0032}));
+  EXPECT_EQ(gatt_cb.tcb[0].coalesce_lcid, 0x0041);
+
+  FireAlarm();
+  ASSERT_EQ(sent_pdus.size(), 2u);
+  EXPECT_EQ(sent_pdus[1].lcid, 0x0041);
+  EXPECT_EQ(sent_pdus[1].handles, std::vector<uint16_t>{0x0034});
+}
+
+TEST_F(GattNotifCoalesceTest, clearedWhenTheirChannelCloses) {
+  gatt_cb.tcb[0].is_eatt_supported = true;
+  test_reg.eatt_support = true;
+  eatt_conn_cids[kConnId] = 0x0040;
+  Notify(0x0030);
+  Notify(0x0032);
+
+  // Another channel closing leaves them
+  gatt_notif_coalesce_clear(gatt_cb.tcb[0], 0x0041);
+  EXPECT_EQ(gatt_cb.tcb[0].coalesce_q.size(), 2u);
+  EXPECT_NE(last_alarm_cb, nullptr);
+
+  gatt_notif_coalesce_clear(gatt_cb.tcb[0], 0x0040);
+  EXPECT_TRUE(gatt_cb.tcb[0].coalesce_q.empty());
+  EXPECT_EQ(last_alarm_cb, nullptr);
+
+  // Nothing is sent on the closed channel afterwards
+  gatt_notif_coalesce_flush(gatt_cb.tcb[0]);
+  EXPECT_TRUE(sent_pdus.empty());
+
+  // The next ones go on the channel they are sent on
+  eatt_conn_cids[kConnId] = 0x0041;
+  Notify(0x0034);
+  FireAlarm();
+  ASSERT_EQ(sent_pdus.size(), 1u);
+  EXPECT_EQ(sent_pdus[0].lcid, 0x0041);
+  EXPECT_EQ(sent_pdus[0].handles, std::vector<uint16_t>{0x0034});
+}
@@ -0,0 +1,181 @@
+/******************************************************************************
+ * Copyright (c) 2026 Qualcomm Innovation Center, Inc. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ *
+ *******************************************************************************/
+
+#include "device/include/controller.h"
+#include "osi/include/allocator.h"
+#include "stack/btm/btm_int.h"
+#include "stack/gatt/connection_manager.h"
+#include "stack/gatt/eatt_int.h"
+#include "stack/gatt/gatt_int.h"
+#include "stack/include/l2c_api.h"
+#include "stack/include/sdp_api.h"
+
+/** osi/src/allocator.cc */
+void* osi_malloc(size_t size) { return malloc(size); }
+
+/** stack/btm/btm_ble_bgconn.cc */
+bool BTM_BackgroundConnectAddressKnown(const RawAddress& address) {
+  return false;
+}
+bool BTM_GetLeDisconnectStatus(const RawAddress& address) { return false; }
+
+/** stack/btm/btm_dev.cc */
+tBTM_SEC_DEV_REC* btm_find_dev(const RawAddress& bd_addr) { return nullptr; }
+
+/** stack/l2cap/l2c_api.cc */
+bool L2CA_SetFixedChannelTout(const RawAddress& rem_bda, uint16_t fixed_cid,
+                              uint16_t idle_tout) {
+  return false;
+}
+bool L2CA_SetIdleTimeout(uint16_t cid, uint16_t timeout, bool is_global) {
+  return false;
+}
+bool L2CA_SetIdleTimeoutByBdAddr(const RawAddress& bd_addr, uint16_t timeout,
+                                 tBT_TRANSPORT transport) {
+  return false;
+}
+
+/** stack/l2cap/l2c_ble.cc */
+tBTM_STATUS BTM_SetBleDataLength(const RawAddress& bd_addr,
+                                 uint16_t tx_pdu_length) {
+  return BTM_SUCCESS;
+}
+
+/** stack/sdp/sdp_api.cc */
+bool SDP_DeleteRecord(uint32_t handle) { return false; }
+
+/** device/src/controller.cc */
+const controller_t* controller_get_interface() { return nullptr; }
+
+/** stack/gatt/connection_manager.cc */
+namespace connection_manager {
+bool background_connect_add(uint8_t app_id, const RawAddress& address) {
+  return false;
+}
+bool remove_unconditional(const RawAddress& address) { return false; }
+void on_app_deregistered(uint8_t app_id) {}
+}  // namespace connection_manager
+
+/** stack/gatt/att_protocol.cc */
+tGATT_STATUS attp_send_cl_msg(tGATT_TCB& tcb, tGATT_CLCB* p_clcb,
+                              uint16_t lcid, uint8_t op_code,
+                              tGATT_CL_MSG* p_msg) {
+  return GATT_SUCCESS;
+}
+
+/** stack/gatt/eatt_utils.cc */
+tGATT_EBCB* gatt_find_best_eatt_bcb(tGATT_TCB* p_tcb, tGATT_IF gatt_if,
+                                    uint16_t old_cid, bool opportunistic) {
+  return nullptr;
+}
+tGATT_EBCB* gatt_find_eatt_bcb_by_cid(tGATT_TCB* p_tcb, uint16_t lcid) {
+  return nullptr;
+}
+tGATT_EBCB* gatt_find_eatt_bcb_by_srv_trans_id(uint32_t trans_id,
+                                               const RawAddress& bda) {
+  return nullptr;
+}
+tGATT_EBCB* gatt_find_eatt_bcb_by_cl_trans_id(uint32_t trans_id,
+                                              const RawAddress& bda) {
+  return nullptr;
+}
+tGATT_EBCB* gatt_find_eatt_bcb_by_gatt_if(uint8_t gatt_if,
+                                          const RawAddress& bda) {
+  return nullptr;
+}
+void gatt_notif_enq(tGATT_TCB* p_tcb, uint16_t cid, tGATT_VALUE* p_notif) {}
+void gatt_remove_conn(uint16_t conn_id, uint16_t lcid) {}
+void gatt_rsp_enq(tGATT_TCB* p_tcb, uint16_t cid, tGATT_PEND_RSP* p_rsp) {}
+
+/** stack/gatt/gatt_attr.cc */
+void gatt_sr_update_cl_status(tGATT_TCB& tcb, bool chg_unaware) {}
+
+/** stack/gatt/gatt_auth.cc */
+bool gatt_security_check_start(tGATT_CLCB* p_clcb) { return false; }
+
+/** stack/gatt/gatt_cl.cc */
+void gatt_act_discovery(tGATT_CLCB* p_clcb) {}
+void gatt_send_queue_write_cancel(tGATT_TCB& tcb, tGATT_CLCB* p_clcb,
+                                  tGATT_EXEC_FLAG flag) {}
+
+/** stack/gatt/gatt_main.cc */
+bool gatt_act_connect(tGATT_REG* p_reg, const RawAddress& bd_addr,
+                      tBT_TRANSPORT transport, int8_t initiating_phys) {
+  return false;
+}
+bool gatt_disconnect(tGATT_TCB* p_tcb, uint16_t lcid) { return false; }
+void gatt_establish_eatt_connect(tGATT_TCB* p_tcb, uint8_t num_chnls) {}
+tGATT_CH_STATE gatt_get_ch_state(tGATT_TCB* p_tcb) { return GATT_CH_CLOSE; }
+void gatt_init_srv_chg(void) {}
+bool gatt_is_app_holding_link(tGATT_IF gatt_if, tGATT_TCB* p_tcb) {
+  return false;
+}
+void gatt_proc_srv_chg(void) {}
+void gatt_update_app_use_link_flag(tGATT_IF gatt_if, tGATT_TCB* p_tcb,
+                                   bool is_add, bool check_acl_link) {}
+
+/** stack/gatt/gatt_sr.cc */
+uint32_t gatt_sr_enqueue_cmd(tGATT_TCB& tcb, uint16_t lcid, uint8_t op_code,
+                             uint16_t handle) {
+  return 0x0000;
+}
+tGATT_STATUS gatt_sr_process_app_rsp(tGATT_TCB& tcb, tGATT_IF gatt_if,
+                                     uint32_t trans_id, uint8_t op_code,
+                                     tGATT_STATUS status,
+                                     tGATTS_RSP* p_msg) {
+  return GATT_SUCCESS;
+}
+
+/** stack/gatt/gatt_utils.cc */
+uint32_t gatt_add_sdp_record(const bluetooth::Uuid& uuid, uint16_t start_hdl,
+                             uint16_t end_hdl) {
+  return 0;
+}
+void gatt_add_pending_ind(tGATT_TCB* p_tcb, uint16_t lcid,
+                          tGATT_VALUE* p_ind) {}
+bool gatt_auto_connect_dev_remove(tGATT_IF gatt_if, const RawAddress& bd_addr) {
+  return false;
+}
+uint8_t gatt_build_uuid_to_stream_len(const bluetooth::Uuid& uuid) {
+  return 0;
+}
+uint8_t gatt_build_uuid_to_stream(uint8_t** p_dst,
+                                  const bluetooth::Uuid& uuid) {
+  return 0;
+}
+bool gatt_cancel_open(tGATT_IF gatt_if, const RawAddress& bda) { return false; }
+tGATT_CLCB* gatt_clcb_alloc(uint16_t conn_id) { return nullptr; }
+void gatt_clcb_dealloc(tGATT_CLCB* p_clcb) {}
+tGATT_TCB* gatt_find_tcb_by_addr(const RawAddress& bda,
+                                 tBT_TRANSPORT transport) {
+  return nullptr;
+}
+bool gatt_find_the_connected_bda(uint8_t start_idx, RawAddress& bda,
+                                 uint8_t* p_found_idx,
+                                 tBT_TRANSPORT* p_transport) {
+  return false;
+}
+std::list<tGATT_HDL_LIST_ELEM>::iterator gatt_find_hdl_buffer_by_app_id(
+    const bluetooth::Uuid& app_uuid128, bluetooth::Uuid* p_svc_uuid,
+    uint16_t svc_inst) {
+  return gatt_cb.hdl_list_info->end();
+}
+tGATT_HDL_LIST_ELEM* gatt_find_hdl_buffer_by_handle(uint16_t handle) {
+  return nullptr;
+}
+void gatt_free_srvc_db_buffer_app_id(const bluetooth::Uuid& app_id) {}
+uint16_t gatt_get_mtu(const RawAddress& bda, tBT_TRANSPORT transport) {
+  return 0;
+}
+bool gatt_is_clcb_allocated(uint16_t conn_id) { return false; }
+bool gatt_is_pending_mtu_exchange(tGATT_TCB* p_tcb) { return false; }
+void gatt_set_conn_id_waiting_for_mtu_exchange(tGATT_TCB* p_tcb,
+                                               uint16_t conn_id) {}
+void gatt_start_conf_timer(tGATT_TCB* p_tcb, uint16_t lcid) {}
+void gatt_sr_send_req_callback(uint16_t conn_id, uint32_t trans_id,
+                               uint8_t op_code, tGATTS_DATA* p_req_data) {}
+void gatt_sr_update_cback_cnt(tGATT_TCB& p_tcb, tGATT_IF gatt_if, bool is_inc,
+                              bool is_reset_first) {}
@@ -0,0 +1,158 @@
+/******************************************************************************
+ * Copyright (c) 2026 Qualcomm Innovation Center, Inc. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ *
+ *******************************************************************************/
+
+#include <base/logging.h>
+#include <benchmark/benchmark.h>
+#include <list>
+#include <vector>
+
+#include "gatt_int.h"
+#include "l2c_api.h"
+#include "osi/include/allocator.h"
+
+using ::benchmark::State;
+using bluetooth::Uuid;
+
+// Characteristics of every service, each with a value and a CCC descriptor.
+#define CHARS_PER_SERVICE 10
+#define HANDLES_PER_SERVICE (1 + 3 * CHARS_PER_SERVICE)
+
+tGATT_CB gatt_cb; /*STUB*/
+
+/* Below are methods that must be implemented if we don't want to compile the
+ * whole stack. */
+void LogMsg(uint32_t trace_set_mask, const char* fmt_str, ...) {}
+uint32_t gatt_sr_enqueue_cmd(tGATT_TCB& tcb, uint16_t lcid, uint8_t op_code,
+                             uint16_t handle) {
+  return 1;
+}
+void gatt_sr_update_cback_cnt(tGATT_TCB& tcb, tGATT_IF gatt_if, bool is_inc,
+                              bool is_reset_first) {}
+void gatt_sr_send_req_callback(uint16_t conn_id, uint32_t trans_id,
+                               uint8_t op_code, tGATTS_DATA* p_data) {}
+/* The database only uses 16 bit UUIDs */
+uint8_t gatt_build_uuid_to_stream_len(const Uuid& uuid) {
+  return Uuid::kNumBytes16;
+}
+uint8_t gatt_build_uuid_to_stream(uint8_t** p_dst, const Uuid& uuid) {
+  UINT16_TO_STREAM(*p_dst, uuid.As16Bit());
+  return Uuid::kNumBytes16;
+}
+
+static std::list<tGATT_SVC_DB> service_dbs;
+static std::vector<uint16_t> value_handles;
+static tGATT_TCB tcb;
+
+// Builds a server database of |num_services| services, in the order they are
+// started by GATTS_AddService().
+static void build_server_database(int num_services) {
+  if (gatt_cb.srv_list_info == nullptr)
+    gatt_cb.srv_list_info = new std::list<tGATT_SRV_LIST_ELEM>();
+  gatt_cb.srv_list_info->clear();
+  service_dbs.clear();
+  value_handles.clear();
+
+  uint16_t s_hdl = GATT_APP_START_HANDLE;
+  for (int i = 0; i < num_services; i++) {
+    service_dbs.emplace_back();
+    tGATT_SVC_DB& db = service_dbs.back();
+    gatts_init_service_db(db, Uuid::From16Bit(0x1800 + i), true, s_hdl,
+                          HANDLES_PER_SERVICE);
+    for (int c = 0; c < CHARS_PER_SERVICE; c++) {
+      value_handles.push_back(gatts_add_characteristic(
+          db, GATT_PERM_READ | GATT_PERM_WRITE,
+          GATT_CHAR_PROP_BIT_READ | GATT_CHAR_PROP_BIT_NOTIFY,
+          Uuid::From16Bit(0x2a00 + c)));
+      gatts_add_char_descr(db, GATT_PERM_READ | GATT_PERM_WRITE,
+                           Uuid::From16Bit(GATT_UUID_CHAR_CLIENT_CONFIG));
+    }
+
+    gatt_cb.srv_list_info->emplace_back();
+    tGATT_SRV_LIST_ELEM& elem = gatt_cb.srv_list_info->back();
+    elem.p_db = &db;
+    elem.s_hdl = s_hdl;
+    elem.e_hdl = s_hdl + HANDLES_PER_SERVICE - 1;
+    elem.type = GATT_UUID_PRI_SERVICE;
+    elem.is_primary = true;
+    s_hdl += HANDLES_PER_SERVICE;
+  }
+  gatt_sr_update_srv_index();
+}
+
+// Serves Read Requests for characteristic values spread over the whole
+// database, as in a notify/read loop with many centrals; the items processed
+// are requests.
+static void BM_GattsReadRequest(State& state) {
+  build_server_database(state.range(0));
+
+  uint8_t value[GATT_MAX_ATTR_LEN];
+  size_t next = 0;
+  for (auto _ : state) {
+    uint16_t handle = value_handles[next];
+    next = (next + 7) % value_handles.size();
+
+    auto it = gatt_sr_find_i_rcb_by_handle(handle);
+    if (it == gatt_cb.srv_list_info->end()) {
+      state.SkipWithError("handle not found");
+      break;
+    }
+
+    uint16_t len = 0;
+    gatts_read_attr_perm_check(it->p_db, false, handle, GATT_SEC_FLAG_ENCRYPTED,
+                               16);
+    benchmark::DoNotOptimize(gatts_read_attr_value_by_handle(
+        tcb, L2CAP_ATT_CID, it->p_db, GATT_REQ_READ, handle, 0, value, &len,
+        GATT_DEF_BLE_MTU_SIZE, GATT_SEC_FLAG_ENCRYPTED, 16, 1));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_GattsReadRequest)->Arg(8)->Arg(64)->Arg(256);
+
+// Discovers all characteristics with Read By Type Requests over the whole
+// handle range, walking the services as gatts_process_read_by_type_req()
+// does; the items processed are requests.
+static void BM_GattsDiscoverCharacteristics(State& state) {
+  build_server_database(state.range(0));
+
+  Uuid type = Uuid::From16Bit(GATT_UUID_CHAR_DECLARE);
+  size_t msg_len = sizeof(BT_HDR) + GATT_DEF_BLE_MTU_SIZE + L2CAP_MIN_OFFSET;
+  BT_HDR* p_msg = (BT_HDR*)osi_malloc(msg_len);
+  int64_t requests = 0;
+
+  for (auto _ : state) {
+    uint16_t s_hdl = 1;
+    while (s_hdl != 0) {
+      memset(p_msg, 0, msg_len);
+      p_msg->len = 2;
+      uint16_t buf_len = GATT_DEF_BLE_MTU_SIZE - 2;
+      uint16_t err_hdl = 0;
+      tGATT_STATUS reason = GATT_NOT_FOUND;
+
+      for (auto it = gatt_sr_find_first_srv(s_hdl);
+           it != gatt_cb.srv_list_info->end(); it++) {
+        tGATT_STATUS ret = gatts_db_read_attr_value_by_type(
+            tcb, L2CAP_ATT_CID, it->p_db, GATT_REQ_READ_BY_TYPE, p_msg, s_hdl,
+            0xffff, type, &buf_len, GATT_SEC_FLAG_ENCRYPTED, 16, 0, &err_hdl);
+        if (ret != GATT_NOT_FOUND) reason = ret;
+        if (ret != GATT_SUCCESS && ret != GATT_NOT_FOUND) break;
+      }
+      requests++;
+      if (reason == GATT_NOT_FOUND) break;
+
+      // Continue after the last declaration of the response
+      uint8_t* p = (uint8_t*)(p_msg + 1) + L2CAP_MIN_OFFSET + p_msg->len -
+                   p_msg->offset;
+      uint16_t last_handle;
+      STREAM_TO_UINT16(last_handle, p);
+      s_hdl = last_handle + 1;
+    }
+  }
+  osi_free(p_msg);
+  state.SetItemsProcessed(requests);
+}
+BENCHMARK(BM_GattsDiscoverCharacteristics)->Arg(8)->Arg(64)->Arg(256);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,171 @@
+/******************************************************************************
+ * Copyright (c) 2026 Qualcomm Innovation Center, Inc. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ *
+ *******************************************************************************/
+
+#include <base/logging.h>
+#include <benchmark/benchmark.h>
+
+#include "stack/sdp/sdp_server.cc"
+
+using ::benchmark::State;
+
+// Vendor attributes added to the record to make it about 550 bytes long.
+#define NUM_VENDOR_ATTRS 8
+#define VENDOR_ATTR_LEN 36
+
+tSDP_CB sdp_cb;                                 /*STUB*/
+uint8_t appl_trace_level = BT_TRACE_LEVEL_NONE; /*STUB*/
+
+static uint16_t last_cont_offset;
+
+/* Below are methods that must be implemented if we don't want to compile the
+ * whole stack. */
+void LogMsg(uint32_t trace_set_mask, const char* fmt_str, ...) {}
+void vnd_LogMsg(uint32_t trace_set_mask, const char* fmt_str, ...) {}
+void sdp_disc_connected(tCONN_CB* p_ccb) {}
+void sdp_conn_timer_timeout(void* data) {}
+uint16_t L2CA_ConnectReq(uint16_t psm, const RawAddress& p_bd_addr) {
+  return 0;
+}
+// Keeps the continuation offset of the response, 0 if it is the last one
+uint8_t L2CA_DataWrite(uint16_t cid, BT_HDR* p_data) {
+  uint8_t* p = (uint8_t*)(p_data + 1) + p_data->offset + p_data->len;
+  last_cont_offset = (p[-3] == SDP_CONTINUATION_LEN) ? (p[-2] << 8) | p[-1]
+                                                      : 0;
+  osi_free(p_data);
+  return L2CAP_DW_SUCCESS;
+}
+bool SDP_FindProfileVersionInRec(tSDP_DISC_REC* p_rec, uint16_t profile_uuid,
+                                 uint16_t* p_version) {
+  return false;
+}
+bool btif_config_get_uint16(const char* section, const char* key,
+                            uint16_t* value) {
+  return false;
+}
+bool btif_config_set_uint16(const std::string& section, const std::string& key,
+                            uint16_t value) {
+  return false;
+}
+void btif_config_save(void) {}
+
+static tSDP_RECORD* p_rec;
+static uint8_t req[32];
+static uint16_t req_len;
+
+// Builds an OBEX service record with long names and vendor attributes, which
+// takes many responses to read at small MTUs, and the request for all its
+// attributes.
+static void build_record() {
+  if (p_rec != nullptr) return;
+
+  uint32_t handle = SDP_CreateRecord();
+  uint16_t service = UUID_SERVCLASS_OBEX_OBJECT_PUSH;
+  SDP_AddServiceClassIdList(handle, 1, &service);
+
+  tSDP_PROTOCOL_ELEM proto[3] = {};
+  proto[0].protocol_uuid = UUID_PROTOCOL_L2CAP;
+  proto[1].protocol_uuid = UUID_PROTOCOL_RFCOMM;
+  proto[1].num_params = 1;
+  proto[1].params[0] = 12;
+  proto[2].protocol_uuid = UUID_PROTOCOL_OBEX;
+  SDP_AddProtocolList(handle, 3, proto);
+  SDP_AddProfileDescriptorList(handle, UUID_SERVCLASS_OBEX_OBJECT_PUSH, 0x0102);
+
+  const char name[] = "Object Push server of a benchmark device";
+  const char description[] = "Receives vCards, vCalendars and other objects";
+  SDP_AddAttribute(handle, ATTR_ID_SERVICE_NAME, TEXT_STR_DESC_TYPE,
+                   sizeof(name), (uint8_t*)name);
+  SDP_AddAttribute(handle, ATTR_ID_SERVICE_DESCRIPTION, TEXT_STR_DESC_TYPE,
+                   sizeof(description), (uint8_t*)description);
+
+  uint8_t value[VENDOR_ATTR_LEN];
+  for (int i = 0; i < NUM_VENDOR_ATTRS; i++) {
+    memset(value, i, sizeof(value));
+    SDP_AddAttribute(handle, 0x0400 + i, TEXT_STR_DESC_TYPE, sizeof(value),
+                     value);
+  }
+
+  p_rec = sdp_db_find_record(handle);
+  CHECK(p_rec != nullptr);
+
+  uint8_t* p = req;
+  UINT32_TO_BE_STREAM(p, handle);
+  UINT16_TO_BE_STREAM(p, 0xFFFF);
+  UINT8_TO_BE_STREAM(p, (DATA_ELE_SEQ_DESC_TYPE << 3) | SIZE_IN_NEXT_BYTE);
+  UINT8_TO_BE_STREAM(p, 5);
+  UINT8_TO_BE_STREAM(p, (UINT_DESC_TYPE << 3) | SIZE_FOUR_BYTES);
+  UINT32_TO_BE_STREAM(p, 0x0000FFFF);
+  req_len = p - req;
+}
+
+// Reads the whole record through process_service_attr_req(), the way a client
+// does at the MTU given. Returns the number of responses.
+static int read_record(tCONN_CB* p_ccb, uint16_t mtu) {
+  uint8_t* p;
+  int responses = 0;
+
+  p_ccb->rem_mtu_size = mtu;
+  last_cont_offset = 0;
+  do {
+    p = &req[req_len];
+    if (responses == 0) {
+      UINT8_TO_BE_STREAM(p, 0);
+    } else {
+      UINT8_TO_BE_STREAM(p, SDP_CONTINUATION_LEN);
+      UINT16_TO_BE_STREAM(p, last_cont_offset);
+    }
+    process_service_attr_req(p_ccb, 1, p - req, req, p);
+    responses++;
+  } while (last_cont_offset != 0);
+  return responses;
+}
+
+// The items processed are full record reads, at the MTU of the argument, with
+// every response built from the record.
+static void BM_SdpReadRecordRebuild(State& state) {
+  build_record();
+  tCONN_CB ccb = {};
+  int responses = 0;
+  sdp_cb.attr_cache_enabled = false;
+  for (auto _ : state) responses = read_record(&ccb, state.range(0));
+  osi_free(ccb.rsp_list);
+  state.counters["responses"] = responses;
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SdpReadRecordRebuild)->Arg(48)->Arg(672);
+
+// Same with the responses sliced from the list copied from the attribute
+// cache.
+static void BM_SdpReadRecordCached(State& state) {
+  build_record();
+  tCONN_CB ccb = {};
+  int responses = 0;
+  sdp_cb.attr_cache_enabled = true;
+  for (auto _ : state) responses = read_record(&ccb, state.range(0));
+  osi_free(ccb.rsp_list);
+  state.counters["responses"] = responses;
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SdpReadRecordCached)->Arg(48)->Arg(672);
+
+// Same as above with the cache dropped before every read, as after a change
+// of the record.
+static void BM_SdpReadRecordColdCache(State& state) {
+  build_record();
+  tCONN_CB ccb = {};
+  int responses = 0;
+  sdp_cb.attr_cache_enabled = true;
+  for (auto _ : state) {
+    p_rec->attr_cache_valid = false;
+    responses = read_record(&ccb, state.range(0));
+  }
+  osi_free(ccb.rsp_list);
+  state.counters["responses"] = responses;
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SdpReadRecordColdCache)->Arg(48)->Arg(672);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,329 @@
+/******************************************************************************
+ * Copyright (c) 2026 Qualcomm Innovation Center, Inc. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ *
+ *******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "stack/sdp/sdp_server.cc"
+
+#define LONG_ATTR_LEN 300
+#define NUM_VENDOR_ATTRS 8
+#define VENDOR_ATTR_LEN 36
+#define MAX_RSPS 200
+
+tSDP_CB sdp_cb;                                 /*STUB*/
+uint8_t appl_trace_level = BT_TRACE_LEVEL_NONE; /*STUB*/
+
+typedef std::vector<uint8_t> Pdu;
+
+static std::vector<Pdu> rsps;
+static bool prebuilt;
+
+/* Below are methods that must be implemented if we don't want to compile the
+ * whole stack. */
+void LogMsg(uint32_t trace_set_mask, const char* fmt_str, ...) {}
+void vnd_LogMsg(uint32_t trace_set_mask, const char* fmt_str, ...) {}
+void sdp_disc_connected(tCONN_CB* p_ccb) {}
+void sdp_conn_timer_timeout(void* data) {}
+uint16_t L2CA_ConnectReq(uint16_t psm, const RawAddress& p_bd_addr) {
+  return 0;
+}
+uint8_t L2CA_DataWrite(uint16_t cid, BT_HDR* p_data) {
+  uint8_t* p = (uint8_t*)(p_data + 1) + p_data->offset;
+  rsps.push_back(Pdu(p, p + p_data->len));
+  osi_free(p_data);
+  return L2CAP_DW_SUCCESS;
+}
+bool SDP_FindProfileVersionInRec(tSDP_DISC_REC* p_rec, uint16_t profile_uuid,
+                                 uint16_t* p_version) {
+  return false;
+}
+bool btif_config_get_uint16(const char* section, const char* key,
+                            uint16_t* value) {
+  return false;
+}
+bool btif_config_set_uint16(const std::string& section, const std::string& key,
+                            uint16_t value) {
+  return false;
+}
+void btif_config_save(void) {}
+
+static uint32_t obex_handle, spp_handle, pnp_handle;
+
+static void add_vendor_attrs(uint32_t handle, int count) {
+  uint8_t value[VENDOR_ATTR_LEN];
+  for (int i = 0; i < count; i++) {
+    memset(value, 'A' + i, sizeof(value));
+    SDP_AddAttribute(handle, 0x0400 + i, TEXT_STR_DESC_TYPE, sizeof(value),
+                     value);
+  }
+}
+
+// Builds three records with the L2CAP UUID: a long OBEX record that takes
+// many responses to read at small MTUs, a short serial port record whose
+// attribute list has a 2 byte header, and a PnP record without a name.
+static void build_db() {
+  if (obex_handle != 0) return;
+
+  tSDP_PROTOCOL_ELEM proto[3] = {};
+  proto[0].protocol_uuid = UUID_PROTOCOL_L2CAP;
+  proto[1].protocol_uuid = UUID_PROTOCOL_RFCOMM;
+  proto[1].num_params = 1;
+  proto[1].params[0] = 12;
+  proto[2].protocol_uuid = UUID_PROTOCOL_OBEX;
+
+  obex_handle = SDP_CreateRecord();
+  uint16_t service = UUID_SERVCLASS_OBEX_OBJECT_PUSH;
+  SDP_AddServiceClassIdList(obex_handle, 1, &service);
+  SDP_AddProtocolList(obex_handle, 3, proto);
+  SDP_AddProfileDescriptorList(obex_handle, service, 0x0102);
+  const char name[] = "Object Push server of a test device";
+  SDP_AddAttribute(obex_handle, ATTR_ID_SERVICE_NAME, TEXT_STR_DESC_TYPE,
+                   sizeof(name), (uint8_t*)name);
+  uint8_t description[LONG_ATTR_LEN];
+  memset(description, 'd', sizeof(description));
+  SDP_AddAttribute(obex_handle, ATTR_ID_SERVICE_DESCRIPTION,
+                   TEXT_STR_DESC_TYPE, sizeof(description), description);
+  add_vendor_attrs(obex_handle, NUM_VENDOR_ATTRS);
+
+  spp_handle = SDP_CreateRecord();
+  service = UUID_SERVCLASS_SERIAL_PORT;
+  SDP_AddServiceClassIdList(spp_handle, 1, &service);
+  proto[1].params[0] = 3;
+  SDP_AddProtocolList(spp_handle, 2, proto);
+  const char spp_name[] = "Serial port";
+  SDP_AddAttribute(spp_handle, ATTR_ID_SERVICE_NAME, TEXT_STR_DESC_TYPE,
+                   sizeof(spp_name), (uint8_t*)spp_name);
+  add_vendor_attrs(spp_handle, 1);
+
+  pnp_handle = SDP_CreateRecord();
+  service = UUID_SERVCLASS_PNP_INFORMATION;
+  SDP_AddServiceClassIdList(pnp_handle, 1, &service);
+  proto[0].num_params = 1;
+  proto[0].params[0] = SDP_PSM;
+  SDP_AddProtocolList(pnp_handle, 1, proto);
+  uint16_t vendor = 0x000A;
+  uint8_t value[2] = {(uint8_t)(vendor >> 8), (uint8_t)vendor};
+  SDP_AddAttribute(pnp_handle, ATTR_ID_VENDOR_ID, UINT_DESC_TYPE, 2, value);
+}
+
+static void add_uint16(Pdu& pdu, uint16_t value) {
+  pdu.push_back(value >> 8);
+  pdu.push_back(value & 0xFF);
+}
+
+// An attribute ID, or a range of IDs
+struct AttrId {
+  AttrId(uint16_t id) : start(id), end(id) {}
+  AttrId(uint16_t start, uint16_t end) : start(start), end(end) {}
+  uint16_t start, end;
+};
+
+static Pdu attr_list(const std::vector<AttrId>& ids) {
+  Pdu list;
+  for (const AttrId& id : ids) {
+    if (id.start != id.end) {
+      list.push_back((UINT_DESC_TYPE << 3) | SIZE_FOUR_BYTES);
+      add_uint16(list, id.start);
+      add_uint16(list, id.end);
+    } else {
+      list.push_back((UINT_DESC_TYPE << 3) | SIZE_TWO_BYTES);
+      add_uint16(list, id.start);
+    }
+  }
+  list.insert(list.begin(),
+              {(DATA_ELE_SEQ_DESC_TYPE << 3) | SIZE_IN_NEXT_BYTE,
+               (uint8_t)list.size()});
+  return list;
+}
+
+static Pdu attr_req(uint32_t handle, uint16_t max_count, const Pdu& attrs) {
+  Pdu params;
+  add_uint16(params, handle >> 16);
+  add_uint16(params, handle & 0xFFFF);
+  add_uint16(params, max_count);
+  params.insert(params.end(), attrs.begin(), attrs.end());
+  return params;
+}
+
+static Pdu search_attr_req(uint16_t uuid, uint16_t max_count,
+                           const Pdu& attrs) {
+  Pdu params = {(DATA_ELE_SEQ_DESC_TYPE << 3) | SIZE_IN_NEXT_BYTE, 3,
+                (UUID_DESC_TYPE << 3) | SIZE_TWO_BYTES};
+  add_uint16(params, uuid);
+  add_uint16(params, max_count);
+  params.insert(params.end(), attrs.begin(), attrs.end());
+  return params;
+}
+
+// Sends the request with the continuation state cont_state, an empty one
+// being the first request of a transaction.
+static void send_req(tCONN_CB* p_ccb, uint8_t pdu_id, const Pdu& params,
+                     const Pdu& cont_state) {
+  Pdu req = params;
+  if (cont_state.empty())
+    req.push_back(0);
+  else
+    req.insert(req.end(), cont_state.begin(), cont_state.end());
+
+  uint8_t* p_req = req.data();
+  uint8_t* p_req_end = p_req + req.size();
+  if (pdu_id == SDP_PDU_SERVICE_ATTR_REQ)
+    process_service_attr_req(p_ccb, 1, req.size(), p_req, p_req_end);
+  else
+    process_service_search_attr_req(p_ccb, 1, req.size(), p_req, p_req_end);
+}
+
+// Continuation state of a response, empty if it is the last one or an error
+static Pdu rsp_cont_state(const Pdu& rsp) {
+  if (rsp.empty() || rsp[0] == SDP_PDU_ERROR_RESPONSE) return Pdu();
+  size_t count = (rsp[5] << 8) | rsp[6];
+  Pdu cont_state(rsp.begin() + 7 + count, rsp.end());
+  if (cont_state.size() <= 1) return Pdu();
+  return cont_state;
+}
+
+// Reads everything the request asks for, the way a client does, and returns
+// the responses. If bad_cont_offset is set, the second request of the
+// transaction has this continuation offset.
+static std::vector<Pdu> transaction(bool cached, uint16_t mtu, uint8_t pdu_id,
+                                    const Pdu& params,
+                                    int bad_cont_offset = -1) {
+  tCONN_CB ccb;
+  memset(&ccb, 0, sizeof(ccb));
+  ccb.rem_mtu_size = mtu;
+  sdp_cb.attr_cache_enabled = cached;
+  rsps.clear();
+
+  Pdu cont_state;
+  do {
+    if (bad_cont_offset >= 0 && rsps.size() == 1) {
+      cont_state[1] = bad_cont_offset >> 8;
+      cont_state[2] = bad_cont_offset & 0xFF;
+    }
+    send_req(&ccb, pdu_id, params, cont_state);
+    cont_state = rsp_cont_state(rsps.back());
+  } while (!cont_state.empty() && rsps.size() < MAX_RSPS);
+
+  prebuilt = (ccb.prebuilt_rsp_pdu != 0);
+  osi_free(ccb.rsp_list);
+  return rsps;
+}
+
+static void expect_same_rsps(uint16_t mtu, uint8_t pdu_id, const Pdu& params,
+                             int bad_cont_offset = -1) {
+  std::vector<Pdu> legacy =
+      transaction(false, mtu, pdu_id, params, bad_cont_offset);
+  std::vector<Pdu> cached =
+      transaction(true, mtu, pdu_id, params, bad_cont_offset);
+  ASSERT_TRUE(prebuilt);
+
+  ASSERT_LT(legacy.size(), (size_t)MAX_RSPS);
+  ASSERT_EQ(legacy.size(), cached.size());
+  for (size_t i = 0; i < legacy.size(); i++) {
+    SCOPED_TRACE(testing::Message() << "response " << i);
+    ASSERT_EQ(legacy[i], cached[i]);
+  }
+}
+
+static const std::vector<std::vector<AttrId>> attr_lists = {
+    {{0x0000, 0xFFFF}},
+    {ATTR_ID_SERVICE_RECORD_HDL},
+    {ATTR_ID_SERVICE_CLASS_ID_LIST, ATTR_ID_PROTOCOL_DESC_LIST,
+     ATTR_ID_SERVICE_NAME},
+    {{0x0100, 0x0101}, ATTR_ID_BT_PROFILE_DESC_LIST, {0x0402, 0x0404}},
+    {{0x0400, 0x0403}, ATTR_ID_VENDOR_ID, ATTR_ID_SERVICE_DESCRIPTION},
+    {ATTR_ID_SERVICE_DESCRIPTION, ATTR_ID_VENDOR_ID},
+    {0x0200},
+};
+
+static const uint16_t mtus[] = {48, 672};
+
+static const uint16_t max_counts[] = {7,   8,   9,   10,  11,  16,    37,
+                                      100, 254, 255, 256, 301, 0xFFFF};
+
+// The service attribute responses served from the attribute cache are the
+// ones built for every response, whatever the MTU and the maximum attribute
+// byte count.
+TEST(SdpServerTest, attrRspsMatchLegacyBuilder) {
+  build_db();
+
+  for (uint32_t handle : {obex_handle, spp_handle, pnp_handle}) {
+    for (size_t list = 0; list < attr_lists.size(); list++) {
+      for (uint16_t mtu : mtus) {
+        for (uint16_t max_count : max_counts) {
+          SCOPED_TRACE(testing::Message()
+                       << "handle " << handle << " attribute list " << list
+                       << " mtu " << mtu << " max count " << max_count);
+          expect_same_rsps(mtu, SDP_PDU_SERVICE_ATTR_REQ,
+                           attr_req(handle, max_count, attr_list(attr_lists[list])));
+        }
+      }
+    }
+  }
+}
+
+// Same for the service search attribute responses, across the records
+// matching the UUID.
+TEST(SdpServerTest, searchAttrRspsMatchLegacyBuilder) {
+  build_db();
+
+  for (uint16_t uuid : {UUID_PROTOCOL_L2CAP, UUID_PROTOCOL_RFCOMM,
+                        UUID_SERVCLASS_PNP_INFORMATION, UUID_PROTOCOL_BNEP}) {
+    for (size_t list = 0; list < attr_lists.size(); list++) {
+      for (uint16_t mtu : mtus) {
+        for (uint16_t max_count : max_counts) {
+          SCOPED_TRACE(testing::Message()
+                       << "uuid " << uuid << " attribute list " << list
+                       << " mtu " << mtu << " max count " << max_count);
+          expect_same_rsps(mtu, SDP_PDU_SERVICE_SEARCH_ATTR_REQ,
+                           search_attr_req(uuid, max_count, attr_list(attr_lists[list])));
+        }
+      }
+    }
+  }
+}
+
+// A continuation with an offset other than the one sent is rejected, and the
+// transaction ends there.
+TEST(SdpServerTest, badContinuationRejected) {
+  build_db();
+  Pdu attrs = attr_list({{0x0000, 0xFFFF}});
+
+  for (int offset : {0, 1, 36, 0xFFFF}) {
+    SCOPED_TRACE(testing::Message() << "offset " << offset);
+    expect_same_rsps(48, SDP_PDU_SERVICE_ATTR_REQ,
+                     attr_req(obex_handle, 37, attrs), offset);
+    expect_same_rsps(48, SDP_PDU_SERVICE_SEARCH_ATTR_REQ,
+                     search_attr_req(UUID_PROTOCOL_L2CAP, 37, attrs), offset);
+
+    std::vector<Pdu> cached = transaction(
+        true, 48, SDP_PDU_SERVICE_SEARCH_ATTR_REQ,
+        search_attr_req(UUID_PROTOCOL_L2CAP, 37, attrs), offset);
+    ASSERT_EQ(cached.size(), 2u);
+    EXPECT_EQ(cached[1][0], SDP_PDU_ERROR_RESPONSE);
+  }
+}
+
+// A record changed between transactions is served as changed.
+TEST(SdpServerTest, changedRecordServedAsChanged) {
+  build_db();
+  Pdu params = attr_req(spp_handle, 0xFFFF, attr_list({{0x0000, 0xFFFF}}));
+
+  std::vector<Pdu> before = transaction(true, 672, SDP_PDU_SERVICE_ATTR_REQ,
+                                        params);
+  const char name[] = "Serial port renamed";
+  SDP_AddAttribute(spp_handle, ATTR_ID_SERVICE_NAME, TEXT_STR_DESC_TYPE,
+                   sizeof(name), (uint8_t*)name);
+  std::vector<Pdu> after = transaction(true, 672, SDP_PDU_SERVICE_ATTR_REQ,
+                                       params);
+  EXPECT_NE(before, after);
+  expect_same_rsps(672, SDP_PDU_SERVICE_ATTR_REQ, params);
+
+  SDP_DeleteAttribute(spp_handle, ATTR_ID_SERVICE_NAME);
+  expect_same_rsps(672, SDP_PDU_SERVICE_ATTR_REQ, params);
+}
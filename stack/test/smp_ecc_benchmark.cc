@@ -0,0 +1,87 @@
+/******************************************************************************
+ * Copyright (c) 2026 Qualcomm Innovation Center, Inc. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ *
+ *******************************************************************************/
+
+#include <benchmark/benchmark.h>
+#include <string.h>
+#include <random>
+
+#include "stack/smp/p_256_ecc_pp.h"
+
+using ::benchmark::State;
+
+// Generates a random private key below the order of P-256.
+static void random_private_key(uint32_t* key) {
+  static std::mt19937 generator(0x5eed);
+  for (int i = 0; i < KEY_LENGTH_DWORDS_P256; i++) key[i] = generator();
+  key[KEY_LENGTH_DWORDS_P256 - 1] &= 0x7FFFFFFF;
+}
+
+// Public key generation, as done by smp_process_private_key().
+static void BM_PublicKey(State& state) {
+  uint32_t private_key[KEY_LENGTH_DWORDS_P256];
+  random_private_key(private_key);
+  for (auto _ : state) {
+    Point public_key;
+    ECC_PointMult_Base_Comb(&public_key, private_key);
+    benchmark::DoNotOptimize(public_key);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+static void BM_PublicKeyBinNaf(State& state) {
+  p_256_init_curve(KEY_LENGTH_DWORDS_P256);
+  uint32_t private_key[KEY_LENGTH_DWORDS_P256];
+  random_private_key(private_key);
+  for (auto _ : state) {
+    uint32_t n[KEY_LENGTH_DWORDS_P256];
+    memcpy(n, private_key, sizeof(n));
+    Point g = curve_p256.G, public_key;
+    ECC_PointMult_Bin_NAF(&public_key, &g, n, KEY_LENGTH_DWORDS_P256);
+    benchmark::DoNotOptimize(public_key);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+// DHKey computation from a peer public key, as done by smp_compute_dhkey().
+static void BM_DhKey(State& state) {
+  uint32_t private_key[KEY_LENGTH_DWORDS_P256];
+  uint32_t peer_key[KEY_LENGTH_DWORDS_P256];
+  random_private_key(private_key);
+  random_private_key(peer_key);
+  Point peer_public_key;
+  ECC_PointMult_Base_Comb(&peer_public_key, peer_key);
+  for (auto _ : state) {
+    Point dhkey;
+    ECC_PointMult_Window(&dhkey, &peer_public_key, private_key);
+    benchmark::DoNotOptimize(dhkey);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+static void BM_DhKeyBinNaf(State& state) {
+  p_256_init_curve(KEY_LENGTH_DWORDS_P256);
+  uint32_t private_key[KEY_LENGTH_DWORDS_P256];
+  uint32_t peer_key[KEY_LENGTH_DWORDS_P256];
+  random_private_key(private_key);
+  random_private_key(peer_key);
+  Point peer_public_key;
+  ECC_PointMult_Base_Comb(&peer_public_key, peer_key);
+  for (auto _ : state) {
+    uint32_t n[KEY_LENGTH_DWORDS_P256];
+    memcpy(n, private_key, sizeof(n));
+    Point p = peer_public_key, dhkey;
+    ECC_PointMult_Bin_NAF(&dhkey, &p, n, KEY_LENGTH_DWORDS_P256);
+    benchmark::DoNotOptimize(dhkey);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_PublicKey);
+BENCHMARK(BM_PublicKeyBinNaf);
+BENCHMARK(BM_DhKey);
+BENCHMARK(BM_DhKeyBinNaf);
+
+BENCHMARK_MAIN();
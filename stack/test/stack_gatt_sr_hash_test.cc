@@ -83,3 +83,104 @@ TEST(GattDatabaseTest, matchExampleInBtSpecV52) {
 
   ASSERT_EQ(result_hash, expected_hash);
 }
+
+// The hash input of each service is cached, the hash must still match the
+// spec example when it is computed after every service addition.
+TEST(GattDatabaseTest, matchExampleInBtSpecV52Incremental) {
+  tGATT_SVC_DB local_db[4];
+  for (int i=0; i<4; i++) local_db[i] = tGATT_SVC_DB();
+  std::list<tGATT_SRV_LIST_ELEM> srv_list_info;
+
+  // 0x1800
+  add_item_to_list(srv_list_info, &local_db[0], true);
+  gatts_init_service_db(local_db[0], Uuid::From16Bit(0x1800), true, 0x0001, 5);
+  gatts_add_characteristic(local_db[0],
+    GATT_PERM_READ | GATT_PERM_WRITE,
+    GATT_CHAR_PROP_BIT_READ | GATT_CHAR_PROP_BIT_WRITE,
+    Uuid::From16Bit(0x2A00));
+  gatts_add_characteristic(local_db[0], GATT_PERM_READ, GATT_CHAR_PROP_BIT_READ,
+    Uuid::From16Bit(0x2A01));
+  Octet16 first_hash = gatts_calculate_database_hash(&srv_list_info);
+  // 0x1801
+  add_item_to_list(srv_list_info, &local_db[1], true);
+  gatts_init_service_db(local_db[1], Uuid::From16Bit(0x1801), true, 0x0006, 8);
+  gatts_add_characteristic(local_db[1], 0, GATT_CHAR_PROP_BIT_INDICATE,
+    Uuid::From16Bit(0x2A05));
+  gatts_add_char_descr(local_db[1], GATT_CHAR_PROP_BIT_READ, Uuid::From16Bit(0x2902));
+  gatts_add_characteristic(local_db[1],
+    GATT_PERM_READ | GATT_PERM_WRITE,
+    GATT_CHAR_PROP_BIT_READ | GATT_CHAR_PROP_BIT_WRITE,
+    Uuid::From16Bit(0x2B29));
+  gatts_add_characteristic(local_db[1], GATT_PERM_READ, GATT_CHAR_PROP_BIT_READ,
+    Uuid::From16Bit(0x2B2A));
+  Octet16 second_hash = gatts_calculate_database_hash(&srv_list_info);
+  ASSERT_NE(first_hash, second_hash);
+  // 0x1808
+  add_item_to_list(srv_list_info, &local_db[2], true);
+  gatts_init_service_db(local_db[2], Uuid::From16Bit(0x1808), true, 0x000E, 6);
+  gatts_add_included_service(local_db[2], 0x0014, 0x0016, Uuid::From16Bit(0x180F));
+  gatts_add_characteristic(local_db[2], GATT_PERM_READ,
+    GATT_CHAR_PROP_BIT_READ | GATT_CHAR_PROP_BIT_INDICATE | GATT_CHAR_PROP_BIT_EXT_PROP,
+    Uuid::From16Bit(0x2A18));
+  gatts_add_char_descr(local_db[2], 0x0000, Uuid::From16Bit(0x2902));
+  gatts_add_char_ext_prop_descr(local_db[2], 0x0000);
+  gatts_calculate_database_hash(&srv_list_info);
+  // 0x180F
+  add_item_to_list(srv_list_info, &local_db[3], false);
+  gatts_init_service_db(local_db[3], Uuid::From16Bit(0x180F), false, 0x0014, 3);
+  gatts_add_characteristic(local_db[3], GATT_PERM_READ,  GATT_CHAR_PROP_BIT_READ,
+    Uuid::From16Bit(0x2A19));
+
+  Octet16 expected_hash{0xF1, 0xCA, 0x2D, 0x48, 0xEC, 0xF5, 0x8B, 0xAC,
+                        0x8A, 0x88, 0x30, 0xBB, 0xB9, 0xFB, 0xA9, 0x90};
+  std::reverse(expected_hash.begin(), expected_hash.end());
+
+  ASSERT_EQ(gatts_calculate_database_hash(&srv_list_info), expected_hash);
+
+  // Removing services gives back the hash of the remaining ones
+  srv_list_info.erase(std::next(srv_list_info.begin()), srv_list_info.end());
+  ASSERT_EQ(gatts_calculate_database_hash(&srv_list_info), first_hash);
+}
+
+// Adding services only marks the database hash out of date, so however many
+// services are added, the hash is computed once, when it is read.
+TEST(GattDatabaseTest, hashComputedOnceForServiceAdditions) {
+  constexpr int kNumServices = 32;
+  tGATT_SVC_DB local_db[kNumServices];
+  std::list<tGATT_SRV_LIST_ELEM> srv_list_info;
+  gatt_cb = tGATT_CB();
+  gatt_cb.srv_list_info = &srv_list_info;
+
+  for (int i = 0; i < kNumServices; i++) {
+    local_db[i] = tGATT_SVC_DB();
+    add_item_to_list(srv_list_info, &local_db[i], true);
+    gatts_init_service_db(local_db[i], Uuid::From16Bit(0x1800 + i), true,
+                          0x0001 + 3 * i, 3);
+    gatts_add_characteristic(local_db[i], GATT_PERM_READ,
+                             GATT_CHAR_PROP_BIT_READ, Uuid::From16Bit(0x2A00));
+    // As GATTS_AddService() does once the service is in the database
+    gatts_invalidate_database_hash();
+  }
+
+  // No service was hashed while they were added
+  for (const tGATT_SRV_LIST_ELEM& srv : srv_list_info)
+    ASSERT_TRUE(srv.hash_info.empty());
+
+  Octet16 hash = gatts_get_database_hash();
+  for (const tGATT_SRV_LIST_ELEM& srv : srv_list_info)
+    ASSERT_FALSE(srv.hash_info.empty());
+
+  // Reading the hash again doesn't compute it again
+  srv_list_info.front().hash_info.clear();
+  ASSERT_EQ(gatts_get_database_hash(), hash);
+  ASSERT_TRUE(srv_list_info.front().hash_info.empty());
+
+  ASSERT_EQ(gatts_calculate_database_hash(&srv_list_info), hash);
+
+  // The next change makes the next read compute it again
+  srv_list_info.pop_back();
+  gatts_invalidate_database_hash();
+  ASSERT_NE(gatts_get_database_hash(), hash);
+
+  gatt_cb.srv_list_info = nullptr;
+}
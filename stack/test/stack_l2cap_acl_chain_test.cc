@@ -0,0 +1,109 @@
+/******************************************************************************
+ * Copyright (c) 2026 Qualcomm Innovation Center, Inc. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ *
+ *******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <string.h>
+#include <algorithm>
+#include <vector>
+
+#include "osi/include/allocator.h"
+#include "stack/l2cap/l2c_acl_chain.h"
+
+namespace {
+
+BT_HDR* make_buffer(uint16_t event, const std::vector<uint8_t>& data,
+                    uint16_t offset) {
+  BT_HDR* p_buf = (BT_HDR*)osi_malloc(BT_HDR_SIZE + data.size());
+  p_buf->event = event;
+  p_buf->len = data.size() - offset;
+  p_buf->offset = offset;
+  p_buf->layer_specific = 0;
+  memcpy(p_buf->data, data.data(), data.size());
+  return p_buf;
+}
+
+// Chains |packet| as received in fragments of at most |fragment_len| octets
+// of it, the continuation ones behind their own ACL preamble.
+BT_HDR* make_chained_packet(const std::vector<uint8_t>& packet,
+                            size_t fragment_len) {
+  std::vector<BT_HDR*> fragments;
+  for (size_t sent = 0; sent < packet.size(); sent += fragment_len) {
+    size_t len = std::min(fragment_len, packet.size() - sent);
+    std::vector<uint8_t> data(sent == 0 ? 0 : 4, 0xee);
+    data.insert(data.end(), packet.begin() + sent,
+                packet.begin() + sent + len);
+    fragments.push_back(
+        make_buffer(BT_EVT_TO_BTU_HCI_ACL, data, sent == 0 ? 0 : 4));
+  }
+
+  BT_HDR* p_msg = (BT_HDR*)osi_malloc(BT_HDR_SIZE + sizeof(tBT_ACL_CHAIN) +
+                                      fragments.size() * sizeof(BT_HDR*));
+  p_msg->event = BT_EVT_TO_BTU_HCI_ACL_CHAINED;
+  p_msg->len = packet.size();
+  p_msg->offset = 0;
+  p_msg->layer_specific = 0;
+  tBT_ACL_CHAIN* p_chain = (tBT_ACL_CHAIN*)p_msg->data;
+  p_chain->num_fragments = fragments.size();
+  for (size_t i = 0; i < fragments.size(); i++)
+    p_chain->fragments[i] = fragments[i];
+  return p_msg;
+}
+
+// An ACL packet with an L2CAP PDU of |payload_len| octets on CID 0x0040.
+std::vector<uint8_t> make_acl_packet(uint16_t payload_len) {
+  std::vector<uint8_t> packet = {0x42, 0x20};
+  uint16_t acl_len = payload_len + 4;
+  packet.push_back(acl_len & 0xff);
+  packet.push_back(acl_len >> 8);
+  packet.push_back(payload_len & 0xff);
+  packet.push_back(payload_len >> 8);
+  packet.push_back(0x40);
+  packet.push_back(0x00);
+  for (uint16_t i = 0; i < payload_len; i++) packet.push_back(i);
+  return packet;
+}
+
+}  // namespace
+
+TEST(L2capAclChainTest, flatPacketUsedAsIs) {
+  std::vector<uint8_t> packet = make_acl_packet(20);
+  BT_HDR* p_msg = make_buffer(BT_EVT_TO_BTU_HCI_ACL, packet, 0);
+
+  EXPECT_EQ(l2c_acl_chain_headers(p_msg), p_msg->data);
+  EXPECT_EQ(l2c_acl_chain_flatten(p_msg), p_msg);
+  l2c_acl_chain_free(p_msg);
+}
+
+TEST(L2capAclChainTest, headersReadFromFirstFragment) {
+  std::vector<uint8_t> packet = make_acl_packet(2000);
+  BT_HDR* p_msg = make_chained_packet(packet, 1021);
+
+  uint8_t* p = l2c_acl_chain_headers(p_msg);
+  EXPECT_EQ(p, ((tBT_ACL_CHAIN*)p_msg->data)->fragments[0]->data);
+  EXPECT_EQ(0, memcmp(p, packet.data(), 8));
+  l2c_acl_chain_free(p_msg);
+}
+
+TEST(L2capAclChainTest, chainedPacketFlattened) {
+  std::vector<uint8_t> packet = make_acl_packet(4000);
+  BT_HDR* p_msg = make_chained_packet(packet, 1021);
+
+  // As L2CAP leaves it once past the headers
+  p_msg->offset = 8;
+  p_msg->len = 4000;
+  p_msg->layer_specific = 3;
+
+  BT_HDR* p_buf = l2c_acl_chain_flatten(p_msg);
+  EXPECT_EQ(p_buf->event, BT_EVT_TO_BTU_HCI_ACL);
+  EXPECT_EQ(p_buf->offset, 8);
+  EXPECT_EQ(p_buf->len, 4000);
+  EXPECT_EQ(p_buf->layer_specific, 3);
+  EXPECT_EQ(0, memcmp(p_buf->data, packet.data(), packet.size()));
+
+  EXPECT_EQ(l2c_acl_chain_flatten(p_buf), p_buf);
+  l2c_acl_chain_free(p_buf);
+}
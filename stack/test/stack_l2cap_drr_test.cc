@@ -0,0 +1,225 @@
+/******************************************************************************
+ * Copyright (c) 2026 Qualcomm Innovation Center, Inc. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause-Clear
+ *
+ *******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <deque>
+#include <vector>
+
+#include "stack/l2cap/l2c_drr.h"
+
+namespace {
+
+// A flow of the simulation: either always backlogged, or sending one buffer
+// every |period_ms| from |start_ms| on.
+struct SimFlow {
+  tL2C_DRR_FLOW drr;
+  uint16_t pkt_len;
+  uint32_t period_ms;
+  uint64_t start_ms;
+  std::deque<uint16_t> queue;
+};
+
+// Simulates a link draining |bytes_per_ms| bytes every millisecond, the
+// scheduler choosing the flow of each buffer. Time is simulated, so every run
+// is deterministic.
+class DrrSimulation {
+ public:
+  explicit DrrSimulation(int bytes_per_ms) : bytes_per_ms_(bytes_per_ms) {}
+
+  int AddSaturatedFlow(uint32_t quantum, uint16_t pkt_len,
+                       uint64_t start_ms = 0) {
+    return AddFlow(quantum, pkt_len, 0, start_ms);
+  }
+
+  int AddPeriodicFlow(uint32_t quantum, uint16_t pkt_len, uint32_t period_ms,
+                      uint32_t latency_target_ms) {
+    int index = AddFlow(quantum, pkt_len, period_ms, 0);
+    flows_[index].drr.latency_target_ms = latency_target_ms;
+    return index;
+  }
+
+  void Run(uint64_t duration_ms) {
+    uint64_t end_ms = now_ms_ + duration_ms;
+    while (now_ms_ < end_ms) Step();
+  }
+
+  const tL2C_DRR_STATS& stats(int index) const {
+    return flows_[index].drr.stats;
+  }
+  const std::vector<int>& served() const { return served_; }
+  uint64_t now_ms() const { return now_ms_; }
+
+ private:
+  static constexpr size_t kSaturatedDepth = 32;
+
+  int AddFlow(uint32_t quantum, uint16_t pkt_len, uint32_t period_ms,
+              uint64_t start_ms) {
+    flows_.emplace_back();
+    SimFlow& flow = flows_.back();
+    l2c_drr_init_flow(&flow.drr, quantum);
+    flow.pkt_len = pkt_len;
+    flow.period_ms = period_ms;
+    flow.start_ms = start_ms;
+    return flows_.size() - 1;
+  }
+
+  void Step() {
+    for (SimFlow& flow : flows_) {
+      if (now_ms_ < flow.start_ms) continue;
+      if (flow.period_ms == 0) {
+        while (flow.queue.size() < kSaturatedDepth) Enqueue(flow);
+      } else if ((now_ms_ - flow.start_ms) % flow.period_ms == 0) {
+        Enqueue(flow);
+      }
+    }
+
+    budget_ += bytes_per_ms_;
+    while (budget_ > 0) {
+      std::vector<tL2C_DRR_FLOW*> drr_flows;
+      bool ready[16];
+      for (size_t i = 0; i < flows_.size(); i++) {
+        drr_flows.push_back(&flows_[i].drr);
+        ready[i] = !flows_[i].queue.empty();
+      }
+
+      int index = l2c_drr_select(drr_flows.data(), ready, flows_.size(),
+                                 &cursor_, now_ms_);
+      if (index < 0) {
+        budget_ = 0;
+        break;
+      }
+
+      SimFlow& flow = flows_[index];
+      uint16_t len = flow.queue.front();
+      flow.queue.pop_front();
+      l2c_drr_charge(&flow.drr, len, flow.queue.size(), now_ms_);
+      served_.push_back(index);
+      budget_ -= len;
+    }
+    now_ms_++;
+  }
+
+  void Enqueue(SimFlow& flow) {
+    flow.queue.push_back(flow.pkt_len);
+    l2c_drr_enqueued(&flow.drr, flow.queue.size(), now_ms_);
+  }
+
+  int bytes_per_ms_;
+  int budget_ = 0;
+  int cursor_ = -1;
+  // Starts at 1 since a wait starting at 0 means no wait
+  uint64_t now_ms_ = 1;
+  std::deque<SimFlow> flows_;
+  std::vector<int> served_;
+};
+
+}  // namespace
+
+TEST(L2capDrrTest, bandwidthFollowsQuanta) {
+  DrrSimulation sim(10000);
+  int high = sim.AddSaturatedFlow(3000, 1000);
+  int medium = sim.AddSaturatedFlow(2000, 1000);
+  int low = sim.AddSaturatedFlow(1000, 1000);
+  sim.Run(1000);
+
+  double total = sim.stats(high).sent_bytes + sim.stats(medium).sent_bytes +
+                 sim.stats(low).sent_bytes;
+  EXPECT_NEAR(sim.stats(high).sent_bytes / total, 3.0 / 6, 0.01);
+  EXPECT_NEAR(sim.stats(medium).sent_bytes / total, 2.0 / 6, 0.01);
+  EXPECT_NEAR(sim.stats(low).sent_bytes / total, 1.0 / 6, 0.01);
+}
+
+// Packet round robin would give the flow of large packets ten times the
+// bandwidth of the other one.
+TEST(L2capDrrTest, bandwidthDoesNotDependOnPacketSize) {
+  DrrSimulation sim(5000);
+  int large = sim.AddSaturatedFlow(1021, 1021);
+  int small = sim.AddSaturatedFlow(1021, 100);
+  sim.Run(1000);
+
+  double ratio = (double)sim.stats(large).sent_bytes /
+                 sim.stats(small).sent_bytes;
+  EXPECT_NEAR(ratio, 1.0, 0.02);
+}
+
+TEST(L2capDrrTest, idleFlowDoesNotAccumulateCredit) {
+  DrrSimulation sim(2000);
+  int busy = sim.AddSaturatedFlow(1000, 100);
+  int late = sim.AddSaturatedFlow(1000, 100, 500);
+  sim.Run(1000);
+
+  // Once the second flow starts, it never sends more than one quantum in a row
+  const std::vector<int>& served = sim.served();
+  int run = 0, longest_run = 0;
+  for (int index : served) {
+    run = (index == late) ? run + 1 : 0;
+    if (run > longest_run) longest_run = run;
+  }
+  EXPECT_LE(longest_run * 100, 1000);
+  EXPECT_GT(sim.stats(busy).sent_bytes, sim.stats(late).sent_bytes);
+}
+
+TEST(L2capDrrTest, lowWeightFlowIsNotStarved) {
+  DrrSimulation sim(1000);
+  sim.AddSaturatedFlow(15 * 1021, 1021);
+  int low = sim.AddSaturatedFlow(1021, 1021);
+  sim.Run(2000);
+
+  // One round is 16 buffers of about 1 ms each
+  EXPECT_GT(sim.stats(low).sent_pkts, 0u);
+  EXPECT_LE(sim.stats(low).max_wait_ms, 17u);
+}
+
+TEST(L2capDrrTest, latencyTargetBoundsWait) {
+  DrrSimulation without_target(1000);
+  without_target.AddSaturatedFlow(15 * 1021, 1021);
+  without_target.AddSaturatedFlow(15 * 1021, 1021);
+  int audio = without_target.AddPeriodicFlow(1021, 200, 20, 0);
+  without_target.Run(2000);
+  EXPECT_GT(without_target.stats(audio).max_wait_ms, 10u);
+
+  DrrSimulation with_target(1000);
+  with_target.AddSaturatedFlow(15 * 1021, 1021);
+  with_target.AddSaturatedFlow(15 * 1021, 1021);
+  audio = with_target.AddPeriodicFlow(1021, 200, 20, 5);
+  with_target.Run(2000);
+  // Served at most one buffer of the other flows after the target
+  EXPECT_GE(with_target.stats(audio).sent_pkts, 99u);
+  EXPECT_LE(with_target.stats(audio).max_wait_ms, 6u);
+  EXPECT_LT(with_target.stats(audio).late_pkts,
+            with_target.stats(audio).sent_pkts / 10);
+}
+
+TEST(L2capDrrTest, queueStatistics) {
+  DrrSimulation sim(1000);
+  int bulk = sim.AddSaturatedFlow(1021, 500);
+  int periodic = sim.AddPeriodicFlow(1021, 100, 10, 0);
+  sim.Run(100);
+
+  EXPECT_EQ(sim.stats(bulk).max_depth, 32u);
+  EXPECT_EQ(sim.stats(periodic).max_depth, 1u);
+  EXPECT_EQ(sim.stats(periodic).sent_pkts, 10u);
+  EXPECT_EQ(sim.stats(periodic).sent_bytes, 1000u);
+  EXPECT_EQ(sim.stats(bulk).sent_bytes + sim.stats(periodic).sent_bytes,
+            sim.stats(bulk).sent_pkts * 500u + 1000u);
+  EXPECT_LE(sim.stats(periodic).total_wait_ms,
+            sim.stats(periodic).sent_pkts * sim.stats(periodic).max_wait_ms);
+}
+
+TEST(L2capDrrTest, isDeterministic) {
+  std::vector<int> served[2];
+  for (auto& order : served) {
+    DrrSimulation sim(3000);
+    sim.AddSaturatedFlow(3000, 700);
+    sim.AddSaturatedFlow(1000, 300);
+    sim.AddPeriodicFlow(1000, 200, 7, 3);
+    sim.Run(500);
+    order = sim.served();
+  }
+  EXPECT_FALSE(served[0].empty());
+  EXPECT_EQ(served[0], served[1]);
+}
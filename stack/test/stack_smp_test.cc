@@ -16,6 +16,8 @@
  *
  ******************************************************************************/
 #include <stdarg.h>
+#include <string.h>
+#include <random>
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
@@ -23,6 +25,7 @@
 #include "bt_trace.h"
 #include "hcidefs.h"
 #include "stack/include/smp_api.h"
+#include "stack/smp/p_256_ecc_pp.h"
 #include "stack/smp/smp_int.h"
 
 /*
@@ -207,4 +210,87 @@ TEST_F(SmpCalculateConfirmTest, test_smp_calculate_comfirm_as_master) {
   dump_uint128_reverse(output, confirm_str);
   ASSERT_THAT(confirm_str, StrEq(expected_confirm_str));
 }
+
+// Parse a 256-bit value given MSB first into little endian dwords
+static void hex_to_dwords(const char* hex, uint32_t* out) {
+  for (int i = 0; i < KEY_LENGTH_DWORDS_P256; i++) {
+    char dword[9] = {0};
+    memcpy(dword, hex + (KEY_LENGTH_DWORDS_P256 - 1 - i) * 8, 8);
+    out[i] = strtoul(dword, nullptr, 16);
+  }
+}
+
+// Generate a random scalar below the order of P-256
+static void random_scalar(std::mt19937* generator, uint32_t* n) {
+  for (int i = 0; i < KEY_LENGTH_DWORDS_P256; i++) n[i] = (*generator)();
+  n[KEY_LENGTH_DWORDS_P256 - 1] &= 0x7FFFFFFF;
+}
+
+// Test the base point multiplication with the debug key pair of the
+// Bluetooth Core Specification, Vol 3, Part H, 2.3.5.6.1
+TEST(SmpEccTest, test_base_point_mult_debug_key) {
+  uint32_t private_key[KEY_LENGTH_DWORDS_P256];
+  uint32_t expected_x[KEY_LENGTH_DWORDS_P256];
+  uint32_t expected_y[KEY_LENGTH_DWORDS_P256];
+  hex_to_dwords(
+      "3f49f6d4a3c55f3874c9b3e3d2103f504aff607beb40b7995899b8a6cd3c1abd",
+      private_key);
+  hex_to_dwords(
+      "20b003d2f297be2c5e2c83a7e9f9a5b9eff49111acf4fddbcc0301480e359de6",
+      expected_x);
+  hex_to_dwords(
+      "dc809c49652aeb6d63329abf5a52155c766345c28fed3024741c8ed01589d28b",
+      expected_y);
+
+  Point public_key;
+  ECC_PointMult_Base_Comb(&public_key, private_key);
+  EXPECT_THAT(public_key.x, ElementsAreArray(expected_x));
+  EXPECT_THAT(public_key.y, ElementsAreArray(expected_y));
+}
+
+// Test the 64-bit point multiplications against ECC_PointMult_Bin_NAF
+TEST(SmpEccTest, test_point_mult_matches_bin_naf) {
+  p_256_init_curve(KEY_LENGTH_DWORDS_P256);
+  std::mt19937 generator(0x5eed);
+
+  for (int i = 0; i < 20; i++) {
+    uint32_t n[KEY_LENGTH_DWORDS_P256], naf_n[KEY_LENGTH_DWORDS_P256];
+    random_scalar(&generator, n);
+
+    // ECC_PointMult_Bin_NAF consumes the scalar and sets the z of its input
+    Point g = curve_p256.G, expected, actual;
+    memcpy(naf_n, n, sizeof(n));
+    ECC_PointMult_Bin_NAF(&expected, &g, naf_n, KEY_LENGTH_DWORDS_P256);
+    ECC_PointMult_Base_Comb(&actual, n);
+    EXPECT_THAT(actual.x, ElementsAreArray(expected.x));
+    EXPECT_THAT(actual.y, ElementsAreArray(expected.y));
+
+    Point p = expected;
+    random_scalar(&generator, n);
+    memcpy(naf_n, n, sizeof(n));
+    ECC_PointMult_Bin_NAF(&expected, &p, naf_n, KEY_LENGTH_DWORDS_P256);
+    ECC_PointMult_Window(&actual, &p, n);
+    EXPECT_THAT(actual.x, ElementsAreArray(expected.x));
+    EXPECT_THAT(actual.y, ElementsAreArray(expected.y));
+  }
+}
+
+// Test that both sides of an ECDH exchange compute the same DHKey
+TEST(SmpEccTest, test_dhkey_agreement) {
+  std::mt19937 generator(0xd4);
+  uint32_t a[KEY_LENGTH_DWORDS_P256], b[KEY_LENGTH_DWORDS_P256];
+  random_scalar(&generator, a);
+  random_scalar(&generator, b);
+
+  Point public_a, public_b, dhkey_a, dhkey_b;
+  ECC_PointMult_Base_Comb(&public_a, a);
+  ECC_PointMult_Base_Comb(&public_b, b);
+  ASSERT_TRUE(ECC_ValidatePoint(public_a));
+  ASSERT_TRUE(ECC_ValidatePoint(public_b));
+
+  ECC_PointMult_Window(&dhkey_a, &public_b, a);
+  ECC_PointMult_Window(&dhkey_b, &public_a, b);
+  EXPECT_THAT(dhkey_a.x, ElementsAreArray(dhkey_b.x));
+  EXPECT_THAT(dhkey_a.y, ElementsAreArray(dhkey_b.y));
+}
 }  // namespace testing
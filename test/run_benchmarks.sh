@@ -9,6 +9,22 @@
 
 known_benchmarks=(
   bluetooth_benchmark_thread_performance
+  bluetooth_benchmark_alarm_performance_qti
+  bluetooth_benchmark_buffer_pool_qti
+  bluetooth_benchmark_acl_reassembly_qti
+  bluetooth_benchmark_btm_dev_qti
+  bluetooth_benchmark_btm_inq_db_qti
+  bluetooth_benchmark_ble_adv_report_qti
+  bluetooth_benchmark_btm_ble_addr_qti
+  bluetooth_benchmark_crypto_toolbox_qti
+  bluetooth_benchmark_smp_ecc_qti
+  bluetooth_benchmark_sbc_encoder_qti
+  bluetooth_benchmark_osi_config_qti
+  bluetooth_benchmark_gatt_sr_qti
+  bluetooth_benchmark_osi_crc_qti
+  bluetooth_benchmark_btsnoop_qti
+  bluetooth_benchmark_sdp_server_qti
+  bluetooth_benchmark_avrc_folder_items_qti
 )
 
 usage() {
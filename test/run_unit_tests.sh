@@ -15,9 +15,14 @@ known_tests=(
   net_test_stack_multi_adv_qti
   net_test_stack_ad_parser_qti
   net_test_stack_smp_qti
+  net_test_stack_l2cap_qti
+  net_test_stack_avrc_qti
+  net_test_stack_sdp_qti
+  net_test_stack_gatt_qti
   net_test_types_qti
   net_test_btu_message_loop_qti
   net_test_osi_qti
+  net_test_sbc_encoder_qti
   performance_test
 )
 